@@ -104,6 +104,24 @@ public:
 		return out;
 	}
 
+	/// Compute the GJK support. The cone has a flat base and its angle should be less than PI.
+	ANKI_USE_RESULT Vec4 computeSupport(const Vec4& dir) const
+	{
+		check();
+		ANKI_ASSERT(m_angle < PI);
+
+		// The support is either the origin or a point on the circle of the base
+		const Vec4 baseCenter = m_origin + m_dir * m_length;
+		const F32 baseRadius = m_length * tan(m_angle / 2.0f);
+		const Vec4 perpendicular = dir - m_dir * dir.dot(m_dir);
+		const F32 perpendicularLengthSq = perpendicular.getLengthSquared();
+		const Vec4 basePoint = (perpendicularLengthSq > EPSILON * EPSILON)
+								   ? baseCenter + perpendicular * (baseRadius / sqrt(perpendicularLengthSq))
+								   : baseCenter;
+
+		return (basePoint.dot(dir) >= m_origin.dot(dir)) ? basePoint : m_origin;
+	}
+
 private:
 	Vec4 m_origin
 #if ANKI_ENABLE_ASSERTIONS
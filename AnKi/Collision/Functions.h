@@ -9,6 +9,7 @@
 #include <AnKi/Collision/Plane.h>
 #include <AnKi/Collision/Ray.h>
 #include <AnKi/Collision/Aabb.h>
+#include <AnKi/Util/WeakArray.h>
 
 namespace anki {
 
@@ -190,6 +191,23 @@ Bool testCollision(const Plane& plane, const Ray& ray, Vec4& intersection);
 Bool testCollision(const Plane& plane, const Vec4& vector, Vec4& intersection);
 Bool testCollision(const Sphere& sphere, const Ray& ray, Array<Vec4, 2>& intersectionPoints, U& intersectionPointCount);
 
+// Batched testCollision functions. They test one shape against many and they give the same results as calling
+// testCollision for each one but they test 4 shapes at a time with SIMD.
+
+/// Test an AABB against many.
+/// @param[out] results One for each of the aabbs. True if they collide.
+void testCollision(const Aabb& aabb, ConstWeakArray<Aabb> aabbs, WeakArray<Bool> results);
+
+/// @copydoc testCollision(const Aabb&, ConstWeakArray<Aabb>, WeakArray<Bool>)
+void testCollision(const Sphere& sphere, ConstWeakArray<Aabb> aabbs, WeakArray<Bool> results);
+
+/// @copydoc testCollision(const Aabb&, ConstWeakArray<Aabb>, WeakArray<Bool>)
+void testCollision(const Obb& obb, ConstWeakArray<Aabb> aabbs, WeakArray<Bool> results);
+
+/// Test a cone against many spheres.
+/// @param[out] results One for each of the spheres. True if they collide.
+void testCollision(const Cone& cone, ConstWeakArray<Sphere> spheres, WeakArray<Bool> results);
+
 // Intersect a ray against an AABB. The ray is inside the AABB. The function returns the distance 'a' where the
 // intersection point is rayOrigin + rayDir * a
 // https://community.arm.com/graphics/b/blog/posts/reflections-based-on-local-cubemaps-in-unity
@@ -25,6 +25,82 @@ static Bool testCollisionGjk(const T& a, const Y& b)
 	return gjkIntersection(&a, callbackA, &b, callbackB);
 }
 
+/// Separating axis test of two boxes. The axes of the boxes are the columns of the rotations. See "Real-Time Collision
+/// Detection" 4.4.1.
+static Bool testCollisionBoxes(const Vec4& centerA, const Mat3x4& rotationA, const Vec4& extendA, const Vec4& centerB,
+							   const Mat3x4& rotationB, const Vec4& extendB)
+{
+	// The rotation of B in the space of A. Add an epsilon to the absolute values to counteract the cross products that
+	// are close to zero when two edges are parallel
+	Array2d<F32, 3, 3> r;
+	Array2d<F32, 3, 3> absR;
+	for(U32 i = 0; i < 3; ++i)
+	{
+		const Vec3 axisA = rotationA.getColumn(i);
+		for(U32 j = 0; j < 3; ++j)
+		{
+			r[i][j] = axisA.dot(rotationB.getColumn(j));
+			absR[i][j] = absolute(r[i][j]) + EPSILON;
+		}
+	}
+
+	// The translation in the space of A
+	const Vec4 tWorld = centerB - centerA;
+	Array<F32, 3> t;
+	for(U32 i = 0; i < 3; ++i)
+	{
+		t[i] = tWorld.xyz().dot(rotationA.getColumn(i));
+	}
+
+	// The axes of A
+	for(U32 i = 0; i < 3; ++i)
+	{
+		const F32 ra = extendA[i];
+		const F32 rb = extendB[0] * absR[i][0] + extendB[1] * absR[i][1] + extendB[2] * absR[i][2];
+		if(absolute(t[i]) > ra + rb)
+		{
+			return false;
+		}
+	}
+
+	// The axes of B
+	for(U32 j = 0; j < 3; ++j)
+	{
+		const F32 ra = extendA[0] * absR[0][j] + extendA[1] * absR[1][j] + extendA[2] * absR[2][j];
+		const F32 rb = extendB[j];
+		if(absolute(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j]) > ra + rb)
+		{
+			return false;
+		}
+	}
+
+	// The cross products of the axes
+	for(U32 i = 0; i < 3; ++i)
+	{
+		const U32 i1 = (i + 1) % 3;
+		const U32 i2 = (i + 2) % 3;
+		for(U32 j = 0; j < 3; ++j)
+		{
+			const U32 j1 = (j + 1) % 3;
+			const U32 j2 = (j + 2) % 3;
+			const F32 ra = extendA[i1] * absR[i2][j] + extendA[i2] * absR[i1][j];
+			const F32 rb = extendB[j1] * absR[i][j2] + extendB[j2] * absR[i][j1];
+			if(absolute(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/// Test the bounding sphere of a shape against a cone. It's used to skip the GJK when they are far apart.
+static Bool testCollisionConeBoundingSphere(const Vec4& center, F32 radius, const Cone& cone)
+{
+	return testCollision(Sphere(center, radius), cone);
+}
+
 Bool testCollision(const Aabb& a, const Aabb& b)
 {
 #if ANKI_SIMD_SSE
@@ -102,7 +178,10 @@ Bool testCollision(const Aabb& aabb, const Sphere& s)
 
 Bool testCollision(const Aabb& aabb, const Obb& obb)
 {
-	return testCollisionGjk(aabb, obb);
+	const Vec4 center = (aabb.getMin() + aabb.getMax()) * 0.5f;
+	const Vec4 extend = (aabb.getMax() - aabb.getMin()) * 0.5f;
+	return testCollisionBoxes(center, Mat3x4::getIdentity(), extend, obb.getCenter(), obb.getRotation(),
+							  obb.getExtend());
 }
 
 Bool testCollision(const Aabb& aabb, const ConvexHullShape& hull)
@@ -163,8 +242,14 @@ Bool testCollision(const Aabb& aabb, const LineSegment& ls)
 
 Bool testCollision(const Aabb& aabb, const Cone& cone)
 {
-	ANKI_ASSERT(!"TODO");
-	return false;
+	const Vec4 center = (aabb.getMin() + aabb.getMax()) * 0.5f;
+	const F32 radius = ((aabb.getMax() - aabb.getMin()) * 0.5f).getLength();
+	if(!testCollisionConeBoundingSphere(center, radius, cone))
+	{
+		return false;
+	}
+
+	return testCollisionGjk(aabb, cone);
 }
 
 Bool testCollision(const Sphere& a, const Sphere& b)
@@ -175,7 +260,19 @@ Bool testCollision(const Sphere& a, const Sphere& b)
 
 Bool testCollision(const Sphere& sphere, const Obb& obb)
 {
-	return testCollisionGjk(sphere, obb);
+	// The squared distance of the center of the sphere to the box. Every axis adds the part that is outside the box
+	const Vec4 d = sphere.getCenter() - obb.getCenter();
+	F32 distSq = 0.0f;
+	for(U32 i = 0; i < 3; ++i)
+	{
+		const F32 outside = absolute(d.xyz().dot(obb.getRotation().getColumn(i))) - obb.getExtend()[i];
+		if(outside > 0.0f)
+		{
+			distSq += outside * outside;
+		}
+	}
+
+	return distSq <= sphere.getRadius() * sphere.getRadius();
 }
 
 Bool testCollision(const Sphere& sphere, const ConvexHullShape& hull)
@@ -215,7 +312,8 @@ Bool testCollision(const Sphere& sphere, const Cone& cone)
 	const Vec4 V = sphere.getCenter() - cone.getOrigin();
 	const F32 VlenSq = V.dot(V);
 	const F32 V1len = V.dot(cone.getDirection());
-	const F32 distanceClosestPoint = cos(coneAngle) * sqrt(VlenSq - V1len * V1len) - V1len * sin(coneAngle);
+	const F32 distanceClosestPoint =
+		cos(coneAngle) * sqrt(max(VlenSq - V1len * V1len, 0.0f)) - V1len * sin(coneAngle);
 
 	const Bool angleCull = distanceClosestPoint > sphere.getRadius();
 	const Bool frontCull = V1len > sphere.getRadius() + cone.getLength();
@@ -225,7 +323,8 @@ Bool testCollision(const Sphere& sphere, const Cone& cone)
 
 Bool testCollision(const Obb& a, const Obb& b)
 {
-	return testCollisionGjk(a, b);
+	return testCollisionBoxes(a.getCenter(), a.getRotation(), a.getExtend(), b.getCenter(), b.getRotation(),
+							  b.getExtend());
 }
 
 Bool testCollision(const Obb& obb, const ConvexHullShape& hull)
@@ -296,8 +395,12 @@ Bool testCollision(const Obb& obb, const LineSegment& ls)
 
 Bool testCollision(const Obb& obb, const Cone& cone)
 {
-	ANKI_ASSERT(!"TODO");
-	return false;
+	if(!testCollisionConeBoundingSphere(obb.getCenter(), obb.getExtend().getLength(), cone))
+	{
+		return false;
+	}
+
+	return testCollisionGjk(obb, cone);
 }
 
 Bool testCollision(const ConvexHullShape& a, const ConvexHullShape& b)
@@ -313,8 +416,7 @@ Bool testCollision(const ConvexHullShape& hull, const LineSegment& ls)
 
 Bool testCollision(const ConvexHullShape& hull, const Cone& cone)
 {
-	ANKI_ASSERT(!"TODO");
-	return false;
+	return testCollisionGjk(hull, cone);
 }
 
 Bool testCollision(const LineSegment& a, const LineSegment& b)
@@ -325,8 +427,7 @@ Bool testCollision(const LineSegment& a, const LineSegment& b)
 
 Bool testCollision(const Cone& a, const Cone& b)
 {
-	ANKI_ASSERT(!"TODO");
-	return false;
+	return testCollisionGjk(a, b);
 }
 
 Bool testCollision(const Plane& plane, const Ray& ray, Vec4& intersection)
@@ -0,0 +1,267 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Collision/Functions.h>
+#include <AnKi/Collision/Obb.h>
+#include <AnKi/Collision/Cone.h>
+#include <AnKi/Collision/Sphere.h>
+
+namespace anki {
+
+#if ANKI_SIMD_SSE
+/// Holds one component of 4 shapes.
+using SimdLanes = __m128;
+
+/// Transpose 4 vectors so every register holds one component of all of them.
+static void transpose(const Vec4& a, const Vec4& b, const Vec4& c, const Vec4& d, SimdLanes& x, SimdLanes& y,
+					  SimdLanes& z)
+{
+	SimdLanes r0 = a.getSimd();
+	SimdLanes r1 = b.getSimd();
+	SimdLanes r2 = c.getSimd();
+	SimdLanes r3 = d.getSimd();
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	x = r0;
+	y = r1;
+	z = r2;
+}
+
+static SimdLanes absolute(SimdLanes x)
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+}
+
+/// Write the results of 4 shapes.
+static void storeResults(SimdLanes collides, Bool* results)
+{
+	const I32 mask = _mm_movemask_ps(collides);
+	results[0] = (mask & 1) != 0;
+	results[1] = (mask & 2) != 0;
+	results[2] = (mask & 4) != 0;
+	results[3] = (mask & 8) != 0;
+}
+#endif
+
+void testCollision(const Aabb& aabb, ConstWeakArray<Aabb> aabbs, WeakArray<Bool> results)
+{
+	ANKI_ASSERT(results.getSize() >= aabbs.getSize());
+	U32 i = 0;
+
+#if ANKI_SIMD_SSE
+	const SimdLanes aMinX = _mm_set1_ps(aabb.getMin().x());
+	const SimdLanes aMinY = _mm_set1_ps(aabb.getMin().y());
+	const SimdLanes aMinZ = _mm_set1_ps(aabb.getMin().z());
+	const SimdLanes aMaxX = _mm_set1_ps(aabb.getMax().x());
+	const SimdLanes aMaxY = _mm_set1_ps(aabb.getMax().y());
+	const SimdLanes aMaxZ = _mm_set1_ps(aabb.getMax().z());
+
+	for(; i + 4 <= aabbs.getSize(); i += 4)
+	{
+		SimdLanes minX, minY, minZ, maxX, maxY, maxZ;
+		transpose(aabbs[i].getMin(), aabbs[i + 1].getMin(), aabbs[i + 2].getMin(), aabbs[i + 3].getMin(), minX, minY,
+				  minZ);
+		transpose(aabbs[i].getMax(), aabbs[i + 1].getMax(), aabbs[i + 2].getMax(), aabbs[i + 3].getMax(), maxX, maxY,
+				  maxZ);
+
+		// Separated if separated in any direction
+		SimdLanes separated = _mm_or_ps(_mm_cmpgt_ps(aMinX, maxX), _mm_cmpgt_ps(minX, aMaxX));
+		separated = _mm_or_ps(separated, _mm_or_ps(_mm_cmpgt_ps(aMinY, maxY), _mm_cmpgt_ps(minY, aMaxY)));
+		separated = _mm_or_ps(separated, _mm_or_ps(_mm_cmpgt_ps(aMinZ, maxZ), _mm_cmpgt_ps(minZ, aMaxZ)));
+
+		storeResults(_mm_xor_ps(separated, _mm_castsi128_ps(_mm_set1_epi32(-1))), &results[i]);
+	}
+#endif
+
+	for(; i < aabbs.getSize(); ++i)
+	{
+		results[i] = testCollision(aabb, aabbs[i]);
+	}
+}
+
+void testCollision(const Sphere& sphere, ConstWeakArray<Aabb> aabbs, WeakArray<Bool> results)
+{
+	ANKI_ASSERT(results.getSize() >= aabbs.getSize());
+	U32 i = 0;
+
+#if ANKI_SIMD_SSE
+	const SimdLanes centerX = _mm_set1_ps(sphere.getCenter().x());
+	const SimdLanes centerY = _mm_set1_ps(sphere.getCenter().y());
+	const SimdLanes centerZ = _mm_set1_ps(sphere.getCenter().z());
+	const SimdLanes radiusSq = _mm_set1_ps(sphere.getRadius() * sphere.getRadius());
+
+	for(; i + 4 <= aabbs.getSize(); i += 4)
+	{
+		SimdLanes minX, minY, minZ, maxX, maxY, maxZ;
+		transpose(aabbs[i].getMin(), aabbs[i + 1].getMin(), aabbs[i + 2].getMin(), aabbs[i + 3].getMin(), minX, minY,
+				  minZ);
+		transpose(aabbs[i].getMax(), aabbs[i + 1].getMax(), aabbs[i + 2].getMax(), aabbs[i + 3].getMax(), maxX, maxY,
+				  maxZ);
+
+		// The distance of the center to the closest point of the box
+		const SimdLanes dx = _mm_sub_ps(centerX, _mm_min_ps(_mm_max_ps(centerX, minX), maxX));
+		const SimdLanes dy = _mm_sub_ps(centerY, _mm_min_ps(_mm_max_ps(centerY, minY), maxY));
+		const SimdLanes dz = _mm_sub_ps(centerZ, _mm_min_ps(_mm_max_ps(centerZ, minZ), maxZ));
+		const SimdLanes distSq =
+			_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+		storeResults(_mm_cmple_ps(distSq, radiusSq), &results[i]);
+	}
+#endif
+
+	for(; i < aabbs.getSize(); ++i)
+	{
+		results[i] = testCollision(sphere, aabbs[i]);
+	}
+}
+
+void testCollision(const Obb& obb, ConstWeakArray<Aabb> aabbs, WeakArray<Bool> results)
+{
+	ANKI_ASSERT(results.getSize() >= aabbs.getSize());
+	U32 i = 0;
+
+#if ANKI_SIMD_SSE
+	// It's the separating axis test of testCollision(const Aabb&, const Obb&) for 4 AABBs. The AABB is the A box so
+	// the rotation of the OBB in the space of A is the same for all of them
+	const Mat3x4& r = obb.getRotation();
+	const Vec4& extendB = obb.getExtend();
+	Array2d<F32, 3, 3> absR;
+	Array<F32, 3> rbAxesA;
+	for(U32 k = 0; k < 3; ++k)
+	{
+		for(U32 j = 0; j < 3; ++j)
+		{
+			absR[k][j] = anki::absolute(r(k, j)) + EPSILON;
+		}
+
+		rbAxesA[k] = extendB[0] * absR[k][0] + extendB[1] * absR[k][1] + extendB[2] * absR[k][2];
+	}
+
+	const SimdLanes half = _mm_set1_ps(0.5f);
+	const Array<SimdLanes, 3> centerB = {{_mm_set1_ps(obb.getCenter().x()), _mm_set1_ps(obb.getCenter().y()),
+										   _mm_set1_ps(obb.getCenter().z())}};
+
+	for(; i + 4 <= aabbs.getSize(); i += 4)
+	{
+		Array<SimdLanes, 3> min, max;
+		transpose(aabbs[i].getMin(), aabbs[i + 1].getMin(), aabbs[i + 2].getMin(), aabbs[i + 3].getMin(), min[0],
+				  min[1], min[2]);
+		transpose(aabbs[i].getMax(), aabbs[i + 1].getMax(), aabbs[i + 2].getMax(), aabbs[i + 3].getMax(), max[0],
+				  max[1], max[2]);
+
+		Array<SimdLanes, 3> extendA, t;
+		for(U32 k = 0; k < 3; ++k)
+		{
+			extendA[k] = _mm_mul_ps(_mm_sub_ps(max[k], min[k]), half);
+			t[k] = _mm_sub_ps(centerB[k], _mm_mul_ps(_mm_add_ps(max[k], min[k]), half));
+		}
+
+		SimdLanes separated = _mm_setzero_ps();
+
+		// The axes of A
+		for(U32 k = 0; k < 3; ++k)
+		{
+			const SimdLanes ra = extendA[k];
+			const SimdLanes rb = _mm_set1_ps(rbAxesA[k]);
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(absolute(t[k]), _mm_add_ps(ra, rb)));
+		}
+
+		// The axes of B
+		for(U32 j = 0; j < 3; ++j)
+		{
+			SimdLanes ra = _mm_mul_ps(extendA[0], _mm_set1_ps(absR[0][j]));
+			ra = _mm_add_ps(ra, _mm_mul_ps(extendA[1], _mm_set1_ps(absR[1][j])));
+			ra = _mm_add_ps(ra, _mm_mul_ps(extendA[2], _mm_set1_ps(absR[2][j])));
+			const SimdLanes rb = _mm_set1_ps(extendB[j]);
+
+			SimdLanes dist = _mm_mul_ps(t[0], _mm_set1_ps(r(0, j)));
+			dist = _mm_add_ps(dist, _mm_mul_ps(t[1], _mm_set1_ps(r(1, j))));
+			dist = _mm_add_ps(dist, _mm_mul_ps(t[2], _mm_set1_ps(r(2, j))));
+
+			separated = _mm_or_ps(separated, _mm_cmpgt_ps(absolute(dist), _mm_add_ps(ra, rb)));
+		}
+
+		// The cross products of the axes
+		for(U32 k = 0; k < 3; ++k)
+		{
+			const U32 k1 = (k + 1) % 3;
+			const U32 k2 = (k + 2) % 3;
+			for(U32 j = 0; j < 3; ++j)
+			{
+				const U32 j1 = (j + 1) % 3;
+				const U32 j2 = (j + 2) % 3;
+				const SimdLanes ra = _mm_add_ps(_mm_mul_ps(extendA[k1], _mm_set1_ps(absR[k2][j])),
+												_mm_mul_ps(extendA[k2], _mm_set1_ps(absR[k1][j])));
+				const SimdLanes rb = _mm_set1_ps(extendB[j1] * absR[k][j2] + extendB[j2] * absR[k][j1]);
+				const SimdLanes dist =
+					_mm_sub_ps(_mm_mul_ps(t[k2], _mm_set1_ps(r(k1, j))), _mm_mul_ps(t[k1], _mm_set1_ps(r(k2, j))));
+
+				separated = _mm_or_ps(separated, _mm_cmpgt_ps(absolute(dist), _mm_add_ps(ra, rb)));
+			}
+		}
+
+		storeResults(_mm_xor_ps(separated, _mm_castsi128_ps(_mm_set1_epi32(-1))), &results[i]);
+	}
+#endif
+
+	for(; i < aabbs.getSize(); ++i)
+	{
+		results[i] = testCollision(obb, aabbs[i]);
+	}
+}
+
+void testCollision(const Cone& cone, ConstWeakArray<Sphere> spheres, WeakArray<Bool> results)
+{
+	ANKI_ASSERT(results.getSize() >= spheres.getSize());
+	U32 i = 0;
+
+#if ANKI_SIMD_SSE
+	// It's testCollision(const Sphere&, const Cone&) for 4 spheres
+	const F32 coneAngle = cone.getAngle() / 2.0f;
+	const SimdLanes cosAngle = _mm_set1_ps(cos(coneAngle));
+	const SimdLanes sinAngle = _mm_set1_ps(sin(coneAngle));
+	const SimdLanes length = _mm_set1_ps(cone.getLength());
+	const Array<SimdLanes, 3> origin = {{_mm_set1_ps(cone.getOrigin().x()), _mm_set1_ps(cone.getOrigin().y()),
+										  _mm_set1_ps(cone.getOrigin().z())}};
+	const Array<SimdLanes, 3> dir = {{_mm_set1_ps(cone.getDirection().x()), _mm_set1_ps(cone.getDirection().y()),
+									   _mm_set1_ps(cone.getDirection().z())}};
+
+	for(; i + 4 <= spheres.getSize(); i += 4)
+	{
+		Array<SimdLanes, 3> center;
+		transpose(spheres[i].getCenter(), spheres[i + 1].getCenter(), spheres[i + 2].getCenter(),
+				  spheres[i + 3].getCenter(), center[0], center[1], center[2]);
+		const SimdLanes radius = _mm_setr_ps(spheres[i].getRadius(), spheres[i + 1].getRadius(),
+											 spheres[i + 2].getRadius(), spheres[i + 3].getRadius());
+
+		SimdLanes vLenSq = _mm_setzero_ps();
+		SimdLanes v1Len = _mm_setzero_ps();
+		for(U32 k = 0; k < 3; ++k)
+		{
+			const SimdLanes v = _mm_sub_ps(center[k], origin[k]);
+			vLenSq = _mm_add_ps(vLenSq, _mm_mul_ps(v, v));
+			v1Len = _mm_add_ps(v1Len, _mm_mul_ps(v, dir[k]));
+		}
+
+		const SimdLanes perpendicularLen =
+			_mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(vLenSq, _mm_mul_ps(v1Len, v1Len)), _mm_setzero_ps()));
+		const SimdLanes distanceClosestPoint =
+			_mm_sub_ps(_mm_mul_ps(cosAngle, perpendicularLen), _mm_mul_ps(v1Len, sinAngle));
+
+		const SimdLanes angleCull = _mm_cmpgt_ps(distanceClosestPoint, radius);
+		const SimdLanes frontCull = _mm_cmpgt_ps(v1Len, _mm_add_ps(radius, length));
+		const SimdLanes backCull = _mm_cmplt_ps(v1Len, _mm_sub_ps(_mm_setzero_ps(), radius));
+		const SimdLanes culled = _mm_or_ps(_mm_or_ps(angleCull, frontCull), backCull);
+
+		storeResults(_mm_xor_ps(culled, _mm_castsi128_ps(_mm_set1_epi32(-1))), &results[i]);
+	}
+#endif
+
+	for(; i < spheres.getSize(); ++i)
+	{
+		results[i] = testCollision(spheres[i], cone);
+	}
+}
+
+} // end namespace anki
@@ -12,6 +12,7 @@
 #include <AnKi/Util/ThreadHive.h>
 #include <AnKi/Util/Tracer.h>
 #include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/AllocationSiteProfiler.h>
 #include <AnKi/Core/CoreTracer.h>
 #include <AnKi/Core/DeveloperConsole.h>
 #include <AnKi/Core/StatsUi.h>
@@ -46,15 +47,13 @@ void* App::MemStats::allocCallback(void* userData, void* ptr, PtrSize size, PtrS
 {
 	ANKI_ASSERT(userData);
 
-	static const PtrSize MAX_ALIGNMENT = 64;
-
-	struct alignas(MAX_ALIGNMENT) Header
+	/// It's right before the returned memory.
+	class Header
 	{
+	public:
 		PtrSize m_allocatedSize;
-		Array<U8, MAX_ALIGNMENT - sizeof(PtrSize)> _m_padding;
+		PtrSize m_offset; ///< The offset of the returned memory from the start of the real allocation.
 	};
-	static_assert(sizeof(Header) == MAX_ALIGNMENT, "See file");
-	static_assert(alignof(Header) == MAX_ALIGNMENT, "See file");
 
 	void* out = nullptr;
 
@@ -62,18 +61,20 @@ void* App::MemStats::allocCallback(void* userData, void* ptr, PtrSize size, PtrS
 	{
 		// Need to allocate
 		ANKI_ASSERT(size > 0);
-		ANKI_ASSERT(alignment > 0 && alignment <= MAX_ALIGNMENT);
+		ANKI_ASSERT(alignment > 0);
 
-		const PtrSize newAlignment = MAX_ALIGNMENT;
-		const PtrSize newSize = sizeof(Header) + size;
+		const PtrSize offset = getAlignedRoundUp(alignment, sizeof(Header));
+		const PtrSize newSize = offset + size;
 
 		// Allocate
 		MemStats* self = static_cast<MemStats*>(userData);
-		Header* allocation = static_cast<Header*>(
-			self->m_originalAllocCallback(self->m_originalUserData, nullptr, newSize, newAlignment));
-		allocation->m_allocatedSize = size;
-		++allocation;
-		out = static_cast<void*>(allocation);
+		U8* mem = static_cast<U8*>(
+			self->m_originalAllocCallback(self->m_originalUserData, nullptr, newSize, max(alignment, alignof(Header))));
+		out = mem + offset;
+
+		Header& header = *(static_cast<Header*>(out) - 1);
+		header.m_allocatedSize = size;
+		header.m_offset = offset;
 
 		// Update stats
 		self->m_allocatedMem.fetchAdd(size);
@@ -85,16 +86,15 @@ void* App::MemStats::allocCallback(void* userData, void* ptr, PtrSize size, PtrS
 
 		MemStats* self = static_cast<MemStats*>(userData);
 
-		Header* allocation = static_cast<Header*>(ptr);
-		--allocation;
-		ANKI_ASSERT(allocation->m_allocatedSize > 0);
+		const Header& header = *(static_cast<Header*>(ptr) - 1);
+		ANKI_ASSERT(header.m_allocatedSize > 0);
 
 		// Update stats
 		self->m_freeCount.fetchAdd(1);
-		self->m_allocatedMem.fetchSub(allocation->m_allocatedSize);
+		self->m_allocatedMem.fetchSub(header.m_allocatedSize);
 
 		// Free
-		self->m_originalAllocCallback(self->m_originalUserData, allocation, 0, 0);
+		self->m_originalAllocCallback(self->m_originalUserData, static_cast<U8*>(ptr) - header.m_offset, 0, 0);
 	}
 
 	return out;
@@ -111,6 +111,17 @@ App::~App()
 
 void App::cleanup()
 {
+	if(m_allocSiteProfiler)
+	{
+		BaseMemoryPool::visitNamedPools([this](BaseMemoryPool& pool) {
+			m_allocSiteProfiler->stopSampling(pool);
+		});
+
+		m_allocSiteProfiler->logHotspots(10);
+		m_heapAlloc.deleteInstance(m_allocSiteProfiler);
+		m_allocSiteProfiler = nullptr;
+	}
+
 	m_statsUi.reset(nullptr);
 	m_console.reset(nullptr);
 
@@ -287,7 +298,9 @@ Error App::initInternal(const ConfigSet& config_, AllocAlignedCallback allocCb,
 	//
 	m_physics = m_heapAlloc.newInstance<PhysicsWorld>();
 
-	ANKI_CHECK(m_physics->init(m_allocCb, m_allocCbData));
+	ANKI_CHECK(m_physics->init(m_allocCb, m_allocCbData, m_threadHive));
+	m_physics->setMaxSubSteps(config.getNumberU32("physics_maxSubSteps"));
+	m_physics->setFixedTimeStep(config.getNumberF64("physics_fixedTimeStep"));
 
 	//
 	// Resource FS
@@ -335,7 +348,7 @@ Error App::initInternal(const ConfigSet& config_, AllocAlignedCallback allocCb,
 	// Script
 	//
 	m_script = m_heapAlloc.newInstance<ScriptManager>();
-	ANKI_CHECK(m_script->init(m_allocCb, m_allocCbData));
+	ANKI_CHECK(m_script->init(m_allocCb, m_allocCbData, m_threadHive->getThreadCount()));
 
 	//
 	// Scene
@@ -355,6 +368,19 @@ Error App::initInternal(const ConfigSet& config_, AllocAlignedCallback allocCb,
 	ANKI_CHECK(m_ui->newInstance<StatsUi>(m_statsUi));
 	ANKI_CHECK(m_ui->newInstance<DeveloperConsole>(m_console, m_allocCb, m_allocCbData, m_script));
 
+	const U32 allocSiteSamplePeriod = config.getNumberU32("core_allocationSiteSamplePeriod");
+	if(allocSiteSamplePeriod)
+	{
+		ANKI_CORE_LOGI("Sampling 1 every %u allocations of the named memory pools", allocSiteSamplePeriod);
+
+		// The profiler can't allocate from a pool that is sampled so give it an unnamed one
+		m_allocSiteProfiler =
+			m_heapAlloc.newInstance<AllocationSiteProfiler>(HeapAllocator<U8>(m_allocCb, m_allocCbData));
+		BaseMemoryPool::visitNamedPools([&](BaseMemoryPool& pool) {
+			m_allocSiteProfiler->startSampling(pool, allocSiteSamplePeriod);
+		});
+	}
+
 	ANKI_CORE_LOGI("Application initialized");
 
 	return Error::NONE;
@@ -465,6 +491,8 @@ Error App::mainLoop()
 				HighRezTimer::sleep(m_timerTick - frameTime);
 			}
 
+			gatherMemoryPoolStats();
+
 			// Stats
 			if(m_displayStats)
 			{
@@ -497,6 +525,14 @@ Error App::mainLoop()
 				statsUi.setVkCommandBufferCount(grStats.m_commandBufferCount);
 
 				statsUi.setDrawableCount(rqueue.countAllRenderables());
+
+				statsUi.setMemoryPoolCount(min(m_memPoolStatsCount, StatsUi::MAX_MEMORY_POOLS));
+				for(U32 i = 0; i < min(m_memPoolStatsCount, StatsUi::MAX_MEMORY_POOLS); ++i)
+				{
+					const MemoryPoolFrameStats& poolStats = m_memPoolStats[i];
+					statsUi.setMemoryPool(i, &poolStats.m_name[0], poolStats.m_liveBytes,
+										  poolStats.m_frameAllocationCount);
+				}
 			}
 
 #if ANKI_ENABLE_TRACE
@@ -519,6 +555,107 @@ Error App::mainLoop()
 	return Error::NONE;
 }
 
+#if ANKI_ENABLE_TRACE
+/// The tracer counters of a memory pool name. The tracer keeps the pointers to the names so they are static.
+class MemoryPoolTracerCounters
+{
+public:
+	Array<char, 64> m_liveBytesName;
+	Array<char, 64> m_frameAllocationsName;
+	TracerCounterId m_liveBytes;
+	TracerCounterId m_frameAllocations;
+};
+
+static Array<MemoryPoolTracerCounters, 16> g_memPoolTracerCounters;
+static U32 g_memPoolTracerCounterCount = 0;
+
+/// Find or register the tracer counters of a pool name. Returns nullptr if there is no space.
+static const MemoryPoolTracerCounters* getMemoryPoolTracerCounters(CString poolName)
+{
+	Array<char, 64> liveBytesName;
+	snprintf(&liveBytesName[0], liveBytesName.getSize(), "MEMORY_POOL_%s_LIVE_BYTES", poolName.cstr());
+
+	for(U32 i = 0; i < g_memPoolTracerCounterCount; ++i)
+	{
+		if(strcmp(&g_memPoolTracerCounters[i].m_liveBytesName[0], &liveBytesName[0]) == 0)
+		{
+			return &g_memPoolTracerCounters[i];
+		}
+	}
+
+	if(g_memPoolTracerCounterCount == g_memPoolTracerCounters.getSize())
+	{
+		return nullptr;
+	}
+
+	MemoryPoolTracerCounters& counters = g_memPoolTracerCounters[g_memPoolTracerCounterCount++];
+	counters.m_liveBytesName = liveBytesName;
+	snprintf(&counters.m_frameAllocationsName[0], counters.m_frameAllocationsName.getSize(),
+			 "MEMORY_POOL_%s_FRAME_ALLOCATIONS", poolName.cstr());
+	counters.m_liveBytes = Tracer::registerCounter(&counters.m_liveBytesName[0]);
+	counters.m_frameAllocations = Tracer::registerCounter(&counters.m_frameAllocationsName[0]);
+	return &counters;
+}
+#endif
+
+void App::gatherMemoryPoolStats()
+{
+	// Keep the names and the totals of the previous frame to find the allocations of this frame
+	Array<U64, MAX_MEMORY_POOL_STATS> prevTotalAllocationCounts;
+	for(U32 i = 0; i < m_memPoolStatsCount; ++i)
+	{
+		prevTotalAllocationCounts[i] = m_memPoolStats[i].m_totalAllocationCount;
+		m_memPoolStats[i].m_liveBytes = 0;
+		m_memPoolStats[i].m_totalAllocationCount = 0;
+	}
+
+	BaseMemoryPool::visitNamedPools([&](BaseMemoryPool& pool) {
+		// Don't allocate in here, the list of the pools is locked
+		const CString name = pool.getName();
+		const PtrSize maxNameLength = m_memPoolStats[0].m_name.getSize() - 1;
+
+		U32 idx = 0;
+		while(idx < m_memPoolStatsCount && strncmp(&m_memPoolStats[idx].m_name[0], name.cstr(), maxNameLength) != 0)
+		{
+			++idx;
+		}
+
+		if(idx == m_memPoolStatsCount)
+		{
+			if(m_memPoolStatsCount == MAX_MEMORY_POOL_STATS)
+			{
+				return;
+			}
+
+			++m_memPoolStatsCount;
+			snprintf(&m_memPoolStats[idx].m_name[0], maxNameLength + 1, "%s", name.cstr());
+			prevTotalAllocationCounts[idx] = 0;
+		}
+
+		const MemoryPoolStats stats = pool.getStats();
+		m_memPoolStats[idx].m_liveBytes += stats.m_liveBytes;
+		m_memPoolStats[idx].m_totalAllocationCount += stats.m_totalAllocationCount;
+	});
+
+	for(U32 i = 0; i < m_memPoolStatsCount; ++i)
+	{
+		// The total might go down if some pool got destroyed
+		MemoryPoolFrameStats& poolStats = m_memPoolStats[i];
+		poolStats.m_frameAllocationCount = (poolStats.m_totalAllocationCount > prevTotalAllocationCounts[i])
+											   ? poolStats.m_totalAllocationCount - prevTotalAllocationCounts[i]
+											   : 0;
+
+#if ANKI_ENABLE_TRACE
+		const MemoryPoolTracerCounters* counters = getMemoryPoolTracerCounters(&poolStats.m_name[0]);
+		if(counters)
+		{
+			TracerSingleton::get().incrementCounter(counters->m_liveBytes, poolStats.m_liveBytes);
+			TracerSingleton::get().incrementCounter(counters->m_frameAllocations, poolStats.m_frameAllocationCount);
+		}
+#endif
+	}
+}
+
 void App::injectUiElements(DynamicArrayAuto<UiQueueElement>& newUiElementArr, RenderQueue& rqueue)
 {
 	const U32 originalCount = rqueue.m_uis.getSize();
@@ -32,6 +32,7 @@ class UiManager;
 class UiQueueElement;
 class RenderQueue;
 class MaliHwCounters;
+class AllocationSiteProfiler;
 
 /// The core class of the engine.
 class App
@@ -193,6 +194,8 @@ private:
 	Second m_timerTick;
 	U64 m_resourceCompletedAsyncTaskCount = 0;
 
+	/// Tracks the memory that goes through the allocation callback. The HeapMemoryPools pass their small allocations
+	/// in chunks.
 	class MemStats
 	{
 	public:
@@ -206,6 +209,22 @@ private:
 		static void* allocCallback(void* userData, void* ptr, PtrSize size, PtrSize alignment);
 	} m_memStats;
 
+	/// The stats of the named memory pools. The pools with the same name are merged.
+	class MemoryPoolFrameStats
+	{
+	public:
+		Array<char, 32> m_name = {};
+		PtrSize m_liveBytes = 0;
+		U64 m_totalAllocationCount = 0;
+		U64 m_frameAllocationCount = 0;
+	};
+
+	static constexpr U32 MAX_MEMORY_POOL_STATS = 16;
+	Array<MemoryPoolFrameStats, MAX_MEMORY_POOL_STATS> m_memPoolStats;
+	U32 m_memPoolStatsCount = 0;
+
+	AllocationSiteProfiler* m_allocSiteProfiler = nullptr;
+
 	void initMemoryCallbacks(AllocAlignedCallback allocCb, void* allocCbUserData);
 
 	ANKI_USE_RESULT Error initInternal(const ConfigSet& config, AllocAlignedCallback allocCb, void* allocCbUserData);
@@ -217,6 +236,9 @@ private:
 	void injectUiElements(DynamicArrayAuto<UiQueueElement>& elements, RenderQueue& rqueue);
 
 	void setSignalHandlers();
+
+	/// Gather the stats of the named memory pools and compute the allocations of the last frame.
+	void gatherMemoryPoolStats();
 };
 
 } // end namespace anki
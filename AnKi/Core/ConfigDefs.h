@@ -16,4 +16,6 @@ ANKI_CONFIG_OPTION(core_targetFps, 60u, 30u, MAX_U32, "Target FPS")
 ANKI_CONFIG_OPTION(core_mainThreadCount, max(2u, getCpuCoresCount() / 2u), 2u, 1024u)
 ANKI_CONFIG_OPTION(core_displayStats, 0, 0, 1)
 ANKI_CONFIG_OPTION(core_clearCaches, 0, 0, 1)
+ANKI_CONFIG_OPTION(core_allocationSiteSamplePeriod, 0u, 0u, MAX_U32,
+				   "Sample the allocations of the named memory pools to find the hotspots. 0 to disable")
 ANKI_CONFIG_OPTION(window_fullscreen, 0, 0, 1)
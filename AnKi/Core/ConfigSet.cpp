@@ -7,6 +7,7 @@
 #include <AnKi/Util/Xml.h>
 #include <AnKi/Util/Logger.h>
 #include <AnKi/Util/File.h>
+#include <AnKi/Util/StringTable.h>
 
 // Used by the config options
 #include <AnKi/Util/System.h>
@@ -26,7 +27,7 @@ public:
 		STRING
 	};
 
-	String m_name;
+	StringId m_name;
 	String m_helpMsg;
 
 	String m_str;
@@ -44,7 +45,7 @@ public:
 	Option(const Option&) = delete; // Non-copyable
 
 	Option(Option&& b)
-		: m_name(std::move(b.m_name))
+		: m_name(b.m_name)
 		, m_helpMsg(std::move(b.m_helpMsg))
 		, m_str(std::move(b.m_str))
 		, m_float(b.m_float)
@@ -74,6 +75,7 @@ ConfigSet::ConfigSet()
 #include <AnKi/Renderer/ConfigDefs.h>
 #include <AnKi/Scene/ConfigDefs.h>
 #include <AnKi/Gr/ConfigDefs.h>
+#include <AnKi/Physics/ConfigDefs.h>
 #undef ANKI_CONFIG_OPTION
 }
 
@@ -81,7 +83,6 @@ ConfigSet::~ConfigSet()
 {
 	for(Option& o : m_options)
 	{
-		o.m_name.destroy(m_alloc);
 		o.m_str.destroy(m_alloc);
 		o.m_helpMsg.destroy(m_alloc);
 	}
@@ -96,7 +97,7 @@ ConfigSet& ConfigSet::operator=(const ConfigSet& b)
 	for(const Option& o : b.m_options)
 	{
 		Option newO;
-		newO.m_name.create(m_alloc, o.m_name.toCString());
+		newO.m_name = o.m_name;
 		if(o.m_type == Option::STRING)
 		{
 			newO.m_str.create(m_alloc, o.m_str.toCString());
@@ -117,9 +118,15 @@ ConfigSet& ConfigSet::operator=(const ConfigSet& b)
 
 ConfigSet::Option* ConfigSet::tryFind(CString optionName)
 {
+	const StringId optionNameId = StringId::tryFind(optionName);
+	if(!optionNameId)
+	{
+		return nullptr;
+	}
+
 	for(List<Option>::Iterator it = m_options.getBegin(); it != m_options.getEnd(); ++it)
 	{
-		if((*it).m_name == optionName)
+		if((*it).m_name == optionNameId)
 		{
 			return &(*it);
 		}
@@ -130,9 +137,15 @@ ConfigSet::Option* ConfigSet::tryFind(CString optionName)
 
 const ConfigSet::Option* ConfigSet::tryFind(CString optionName) const
 {
+	const StringId optionNameId = StringId::tryFind(optionName);
+	if(!optionNameId)
+	{
+		return nullptr;
+	}
+
 	for(List<Option>::ConstIterator it = m_options.getBegin(); it != m_options.getEnd(); ++it)
 	{
-		if((*it).m_name == optionName)
+		if((*it).m_name == optionNameId)
 		{
 			return &(*it);
 		}
@@ -146,7 +159,7 @@ void ConfigSet::newOption(CString optionName, CString value, CString helpMsg)
 	ANKI_ASSERT(!tryFind(optionName));
 
 	Option o;
-	o.m_name.create(m_alloc, optionName);
+	o.m_name = StringId(optionName);
 	o.m_str.create(m_alloc, value);
 	o.m_type = Option::STRING;
 	if(!helpMsg.isEmpty())
@@ -163,7 +176,7 @@ void ConfigSet::newOptionInternal(CString optionName, F64 value, F64 minValue, F
 	ANKI_ASSERT(value >= minValue && value <= maxValue && minValue <= maxValue);
 
 	Option o;
-	o.m_name.create(m_alloc, optionName);
+	o.m_name = StringId(optionName);
 	o.m_float = value;
 	o.m_minFloat = minValue;
 	o.m_maxFloat = maxValue;
@@ -182,7 +195,7 @@ void ConfigSet::newOptionInternal(CString optionName, U64 value, U64 minValue, U
 	ANKI_ASSERT(value >= minValue && value <= maxValue && minValue <= maxValue);
 
 	Option o;
-	o.m_name.create(m_alloc, optionName);
+	o.m_name = StringId(optionName);
 	o.m_unsigned = value;
 	o.m_minUnsigned = minValue;
 	o.m_maxUnsigned = maxValue;
@@ -324,12 +337,12 @@ Error ConfigSet::loadFromFile(CString filename)
 		{
 			if(option.m_type == Option::FLOAT)
 			{
-				ANKI_CORE_LOGW("Missing option for \"%s\". Will use the default value: %f", &option.m_name[0],
+				ANKI_CORE_LOGW("Missing option for \"%s\". Will use the default value: %f", option.m_name.cstr(),
 							   option.m_float);
 			}
 			else if(option.m_type == Option::UNSIGNED)
 			{
-				ANKI_CORE_LOGW("Missing option for \"%s\". Will use the default value: %" PRIu64, &option.m_name[0],
+				ANKI_CORE_LOGW("Missing option for \"%s\". Will use the default value: %" PRIu64, option.m_name.cstr(),
 							   option.m_unsigned);
 			}
 			else
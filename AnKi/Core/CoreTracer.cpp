@@ -45,10 +45,18 @@ public:
 	}
 };
 
+/// A TracerCounter with an interned name.
+class CoreTracer::Counter
+{
+public:
+	StringId m_name;
+	U64 m_value;
+};
+
 class CoreTracer::PerFrameCounters : public IntrusiveListEnabled<PerFrameCounters>
 {
 public:
-	DynamicArrayAuto<TracerCounter> m_counters;
+	DynamicArrayAuto<Counter> m_counters;
 	U64 m_frame;
 
 	PerFrameCounters(GenericMemoryPoolAllocator<U8>& alloc)
@@ -95,10 +103,6 @@ CoreTracer::~CoreTracer()
 		m_alloc.deleteInstance(item);
 	}
 
-	for(String& s : m_counterNames)
-	{
-		s.destroy(m_alloc);
-	}
 	m_counterNames.destroy(m_alloc);
 
 	// Destroy the tracer
@@ -205,36 +209,45 @@ Error CoreTracer::writeEvents(ThreadWorkItem& item)
 
 void CoreTracer::gatherCounters(ThreadWorkItem& item)
 {
+	// Intern the names so the rest compares integers. The names are a few and they are the same every frame
+	DynamicArrayAuto<Counter> counters(m_alloc);
+	counters.create(item.m_counters.getSize());
+	for(U32 i = 0; i < item.m_counters.getSize(); ++i)
+	{
+		counters[i].m_name = StringId(item.m_counters[i].m_name);
+		counters[i].m_value = item.m_counters[i].m_value;
+	}
+
 	// Sort
-	std::sort(item.m_counters.getBegin(), item.m_counters.getEnd(), [](const TracerCounter& a, const TracerCounter& b) {
+	std::sort(counters.getBegin(), counters.getEnd(), [](const Counter& a, const Counter& b) {
 		return a.m_name < b.m_name;
 	});
 
 	// Merge same
-	DynamicArrayAuto<TracerCounter> mergedCounters(m_alloc);
-	for(U32 i = 0; i < item.m_counters.getSize(); ++i)
+	DynamicArrayAuto<Counter> mergedCounters(m_alloc);
+	for(U32 i = 0; i < counters.getSize(); ++i)
 	{
-		if(mergedCounters.getSize() == 0 || mergedCounters.getBack().m_name != item.m_counters[i].m_name)
+		if(mergedCounters.getSize() == 0 || mergedCounters.getBack().m_name != counters[i].m_name)
 		{
 			// New
-			mergedCounters.emplaceBack(item.m_counters[i]);
+			mergedCounters.emplaceBack(counters[i]);
 		}
 		else
 		{
 			// Merge
-			mergedCounters.getBack().m_value += item.m_counters[i].m_value;
+			mergedCounters.getBack().m_value += counters[i].m_value;
 		}
 	}
-	ANKI_ASSERT(mergedCounters.getSize() > 0 && mergedCounters.getSize() <= item.m_counters.getSize());
+	ANKI_ASSERT(mergedCounters.getSize() > 0 && mergedCounters.getSize() <= counters.getSize());
 
 	// Add missing counter names
 	Bool addedCounterName = false;
 	for(U32 i = 0; i < mergedCounters.getSize(); ++i)
 	{
-		const TracerCounter& counter = mergedCounters[i];
+		const Counter& counter = mergedCounters[i];
 
 		Bool found = false;
-		for(const String& name : m_counterNames)
+		for(StringId name : m_counterNames)
 		{
 			if(name == counter.m_name)
 			{
@@ -245,14 +258,17 @@ void CoreTracer::gatherCounters(ThreadWorkItem& item)
 
 		if(!found)
 		{
-			m_counterNames.emplaceBack(m_alloc, m_alloc, counter.m_name);
+			m_counterNames.emplaceBack(m_alloc, counter.m_name);
 			addedCounterName = true;
 		}
 	}
 
 	if(addedCounterName)
 	{
-		std::sort(m_counterNames.getBegin(), m_counterNames.getEnd());
+		// Sort them alphabetically for the CSV
+		std::sort(m_counterNames.getBegin(), m_counterNames.getEnd(), [](StringId a, StringId b) {
+			return a.toCString() < b.toCString();
+		});
 	}
 
 	// Get a per-frame structure
@@ -269,10 +285,10 @@ void CoreTracer::gatherCounters(ThreadWorkItem& item)
 		// Merge counters to existing frame
 		PerFrameCounters& frame = m_frameCounters.getBack();
 		ANKI_ASSERT(frame.m_frame == item.m_frame);
-		for(const TracerCounter& newCounter : mergedCounters)
+		for(const Counter& newCounter : mergedCounters)
 		{
 			Bool found = false;
-			for(TracerCounter& existingCounter : frame.m_counters)
+			for(Counter& existingCounter : frame.m_counters)
 			{
 				if(newCounter.m_name == existingCounter.m_name)
 				{
@@ -354,7 +370,7 @@ Error CoreTracer::writeCountersForReal()
 		{
 			// Find value
 			U64 value = 0;
-			for(const TracerCounter& counter : frame.m_counters)
+			for(const Counter& counter : frame.m_counters)
 			{
 				if(counter.m_name == m_counterNames[j])
 				{
@@ -10,6 +10,7 @@
 #include <AnKi/Util/Allocator.h>
 #include <AnKi/Util/List.h>
 #include <AnKi/Util/File.h>
+#include <AnKi/Util/StringTable.h>
 
 namespace anki {
 
@@ -32,6 +33,7 @@ public:
 
 private:
 	class ThreadWorkItem;
+	class Counter;
 	class PerFrameCounters;
 
 	GenericMemoryPoolAllocator<U8> m_alloc;
@@ -40,7 +42,7 @@ private:
 	ConditionVariable m_cvar;
 	Mutex m_mtx;
 
-	DynamicArray<String> m_counterNames;
+	DynamicArray<StringId> m_counterNames;
 	IntrusiveList<PerFrameCounters> m_frameCounters;
 
 	IntrusiveList<ThreadWorkItem> m_workItems; ///< Items for the thread to process.
@@ -104,6 +104,16 @@ void StatsUi::build(CanvasPtr canvas)
 		labelBytes(m_vkCpuMem, "Vulkan CPU");
 		labelBytes(m_vkGpuMem, "Vulkan GPU");
 
+		ImGui::Text("----");
+		ImGui::Text("Memory pools (live, allocs/frame):");
+		for(U32 i = 0; i < m_memPoolCount; ++i)
+		{
+			const MemoryPoolInfo& info = m_memPools[i];
+			labelBytes(info.m_liveBytes, &info.m_name[0]);
+			ImGui::SameLine();
+			ImGui::Text("%" PRIu64, info.m_frameAllocationCount);
+		}
+
 		ImGui::Text("----");
 		ImGui::Text("Vulkan:");
 		labelUint(m_vkCmdbCount, "Cmd buffers");
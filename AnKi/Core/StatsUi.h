@@ -108,6 +108,23 @@ public:
 		m_drawableCount = v;
 	}
 
+	/// The max number of memory pools that can be shown.
+	static constexpr U32 MAX_MEMORY_POOLS = 16;
+
+	void setMemoryPoolCount(U32 count)
+	{
+		ANKI_ASSERT(count <= MAX_MEMORY_POOLS);
+		m_memPoolCount = count;
+	}
+
+	void setMemoryPool(U32 idx, CString name, PtrSize liveBytes, U64 frameAllocationCount)
+	{
+		MemoryPoolInfo& info = m_memPools[idx];
+		snprintf(&info.m_name[0], info.m_name.getSize(), "%s", name.cstr());
+		info.m_liveBytes = liveBytes;
+		info.m_frameAllocationCount = frameAllocationCount;
+	}
+
 private:
 	static constexpr U32 BUFFERED_FRAMES = 16;
 
@@ -159,6 +176,18 @@ private:
 	PtrSize m_vkCpuMem = 0;
 	PtrSize m_vkGpuMem = 0;
 
+	// Memory pools
+	class MemoryPoolInfo
+	{
+	public:
+		Array<char, 32> m_name = {};
+		PtrSize m_liveBytes = 0;
+		U64 m_frameAllocationCount = 0;
+	};
+
+	Array<MemoryPoolInfo, MAX_MEMORY_POOLS> m_memPools;
+	U32 m_memPoolCount = 0;
+
 	// Vulkan
 	U32 m_vkCmdbCount = 0;
 
@@ -367,6 +367,7 @@ inline void CommandBufferImpl::dispatchCompute(U32 groupCountX, U32 groupCountY,
 
 				VkDescriptorSet dsHandle = dset.getHandle();
 
+				ANKI_TRACE_INC_COUNTER(GR_DESCRIPTOR_SET_BINDS, 1);
 				ANKI_CMD(vkCmdBindDescriptorSets(m_handle, VK_PIPELINE_BIND_POINT_COMPUTE,
 												 m_computeProg->getPipelineLayout().getHandle(), i, 1, &dsHandle,
 												 dynamicOffsetCount, &dynamicOffsets[0]),
@@ -430,6 +431,7 @@ inline void CommandBufferImpl::traceRaysInternal(BufferPtr& sbtBuffer, PtrSize s
 
 				VkDescriptorSet dsHandle = dset.getHandle();
 
+				ANKI_TRACE_INC_COUNTER(GR_DESCRIPTOR_SET_BINDS, 1);
 				ANKI_CMD(vkCmdBindDescriptorSets(m_handle, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR,
 												 sprog.getPipelineLayout().getHandle(), i, 1, &dsHandle,
 												 dynamicOffsetCount, &dynamicOffsets[0]),
@@ -634,6 +636,7 @@ inline void CommandBufferImpl::drawcallCommon()
 
 	if(stateDirty)
 	{
+		ANKI_TRACE_INC_COUNTER(GR_PIPELINE_BINDS, 1);
 		ANKI_CMD(vkCmdBindPipeline(m_handle, VK_PIPELINE_BIND_POINT_GRAPHICS, ppline.getHandle()), ANY_OTHER_COMMAND);
 	}
 
@@ -663,6 +666,7 @@ inline void CommandBufferImpl::drawcallCommon()
 
 				VkDescriptorSet dsHandle = dset.getHandle();
 
+				ANKI_TRACE_INC_COUNTER(GR_DESCRIPTOR_SET_BINDS, 1);
 				ANKI_CMD(vkCmdBindDescriptorSets(m_handle, VK_PIPELINE_BIND_POINT_GRAPHICS,
 												 m_graphicsProg->getPipelineLayout().getHandle(), i, 1, &dsHandle,
 												 dynamicOffsetCount, &dynamicOffsets[0]),
@@ -848,6 +852,7 @@ inline void CommandBufferImpl::bindShaderProgram(ShaderProgramPtr& prog)
 		m_rtProg = nullptr; // See above
 
 		// Bind the pipeline now
+		ANKI_TRACE_INC_COUNTER(GR_PIPELINE_BINDS, 1);
 		ANKI_CMD(vkCmdBindPipeline(m_handle, VK_PIPELINE_BIND_POINT_COMPUTE, impl.getComputePipelineHandle()),
 				 ANY_OTHER_COMMAND);
 	}
@@ -859,6 +864,7 @@ inline void CommandBufferImpl::bindShaderProgram(ShaderProgramPtr& prog)
 		m_rtProg = &impl;
 
 		// Bind now
+		ANKI_TRACE_INC_COUNTER(GR_PIPELINE_BINDS, 1);
 		ANKI_CMD(
 			vkCmdBindPipeline(m_handle, VK_PIPELINE_BIND_POINT_RAY_TRACING_KHR, impl.getRayTracingPipelineHandle()),
 			ANY_OTHER_COMMAND);
@@ -7,7 +7,7 @@
 #include <AnKi/Gr/Buffer.h>
 #include <AnKi/Gr/Vulkan/BufferImpl.h>
 #include <AnKi/Util/List.h>
-#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/FlatHashMap.h>
 #include <AnKi/Util/Tracer.h>
 #include <algorithm>
 
@@ -297,7 +297,7 @@ public:
 	U32 m_lastPoolFreeDSCount = 0;
 
 	IntrusiveList<DS> m_list; ///< At the left of the list are the least used sets.
-	HashMap<U64, DS*> m_hashmap;
+	FlatHashMap<U64, DS*> m_hashmap;
 
 	DSThreadAllocator(const DSLayoutCacheEntry* layout, ThreadId tid)
 		: m_layoutEntry(layout)
@@ -318,8 +318,13 @@ public:
 		out = tryFindSet(hash);
 		if(out == nullptr)
 		{
+			ANKI_TRACE_INC_COUNTER(VK_DESCRIPTOR_SET_CACHE_MISS, 1);
 			ANKI_CHECK(newSet(hash, bindings, tmpAlloc, out));
 		}
+		else
+		{
+			ANKI_TRACE_INC_COUNTER(VK_DESCRIPTOR_SET_CACHE_HIT, 1);
+		}
 
 		return Error::NONE;
 	}
@@ -646,6 +651,7 @@ void DSThreadAllocator::writeSet(const Array<AnyBindingExtended, MAX_BINDINGS_PE
 	}
 
 	// Write
+	ANKI_TRACE_INC_COUNTER(VK_DESCRIPTOR_SET_WRITES, writeInfos.getSize());
 	vkUpdateDescriptorSets(m_layoutEntry->m_factory->m_dev, writeInfos.getSize(),
 						   (writeInfos.getSize() > 0) ? &writeInfos[0] : nullptr, 0, nullptr);
 }
@@ -1080,6 +1086,7 @@ Error DescriptorSetFactory::newDescriptorSet(ThreadId tid, StackAllocator<U8>& t
 		}
 		else
 		{
+			ANKI_TRACE_INC_COUNTER(VK_DESCRIPTOR_SET_BINDLESS_BINDS, 1);
 			set = m_bindless->getDescriptorSet();
 		}
 	}
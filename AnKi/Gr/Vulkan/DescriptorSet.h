@@ -300,8 +300,12 @@ public:
 	/// Forget all the rest of the bindings and bind the whole bindless descriptor set.
 	void bindBindlessDescriptorSet()
 	{
-		m_bindlessDSetBound = true;
-		m_bindlessDSetDirty = true;
+		// Binding it again is a NOP. This way materials can bind it per draw without causing a rebind
+		if(!m_bindlessDSetBound)
+		{
+			m_bindlessDSetBound = true;
+			m_bindlessDSetDirty = true;
+		}
 	}
 
 private:
@@ -325,7 +329,12 @@ private:
 
 	void unbindBindlessDSet()
 	{
-		m_bindlessDSetBound = false;
+		if(m_bindlessDSetBound)
+		{
+			m_bindlessDSetBound = false;
+			// The bindless set replaced the previous set so the hash is meaningless now. Force a rebind
+			m_lastHash = 0;
+		}
 	}
 
 	AnyBinding& getBindingToPopulate(U32 bindingIdx, U32 arrayIdx)
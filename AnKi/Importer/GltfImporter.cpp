@@ -7,6 +7,9 @@
 #include <AnKi/Util/System.h>
 #include <AnKi/Util/ThreadHive.h>
 #include <AnKi/Util/StringList.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/Filesystem.h>
+#include <cinttypes>
 
 #if ANKI_COMPILER_GCC_COMPATIBLE
 #	pragma GCC diagnostic push
@@ -137,6 +140,10 @@ static ANKI_USE_RESULT Error getNodeTransform(const cgltf_node& node, Transform&
 
 const char* GltfImporter::XML_HEADER = R"(<?xml version="1.0" encoding="UTF-8" ?>)";
 
+const char* GltfImporter::CACHE_FILENAME = "GltfImporterCache.txt";
+
+const U32 GltfImporter::MESH_IMPORTER_VERSION = 1;
+
 GltfImporter::GltfImporter(GenericMemoryPoolAllocator<U8> alloc)
 	: m_alloc(alloc)
 {
@@ -160,8 +167,33 @@ Error GltfImporter::init(const GltfImporterInitInfo& initInfo)
 	m_rpath.create(initInfo.m_rpath);
 	m_texrpath.create(initInfo.m_texrpath);
 	m_optimizeMeshes = initInfo.m_optimizeMeshes;
+	m_quantizeMeshes = initInfo.m_quantizeMeshes;
+	m_compressMeshes = initInfo.m_compressMeshes;
+	m_incrementalImport = initInfo.m_incrementalImport;
+	m_importTextures = initInfo.m_importTextures;
 	m_comment.create(initInfo.m_comment);
 
+	if(m_importTextures)
+	{
+		if(initInfo.m_tempDirectory.isEmpty())
+		{
+			ANKI_IMPORTER_LOGE("Importing textures requires a temp directory");
+			return Error::USER_DATA;
+		}
+
+		m_tempDir.create(initInfo.m_tempDirectory);
+
+		if(!initInfo.m_compressonatorPath.isEmpty())
+		{
+			m_compressonatorPath.create(initInfo.m_compressonatorPath);
+		}
+
+		if(!initInfo.m_astcencPath.isEmpty())
+		{
+			m_astcencPath.create(initInfo.m_astcencPath);
+		}
+	}
+
 	m_lightIntensityScale = max(initInfo.m_lightIntensityScale, EPSILON);
 
 	m_lodCount = clamp(initInfo.m_lodCount, 1u, 3u);
@@ -180,6 +212,7 @@ Error GltfImporter::init(const GltfImporterInitInfo& initInfo)
 
 	ANKI_IMPORTER_LOGI("Having %u LODs with LOD factor %f", m_lodCount, m_lodFactor);
 
+	const Second parseStartTime = HighRezTimer::getCurrentTime();
 	cgltf_options options = {};
 	cgltf_result res = cgltf_parse_file(&options, m_inputFname.cstr(), &m_gltf);
 	if(res != cgltf_result_success)
@@ -195,24 +228,23 @@ Error GltfImporter::init(const GltfImporterInitInfo& initInfo)
 		return Error::FUNCTION_FAILED;
 	}
 
-	if(initInfo.m_threadCount > 0)
-	{
-		const U32 threadCount = min(getCpuCoresCount(), initInfo.m_threadCount);
-		m_hive = m_alloc.newInstance<ThreadHive>(threadCount, m_alloc, true);
-	}
+	recordStage(GltfImporterStage::PARSE, parseStartTime, 1, 0);
+
+	const U32 threadCount = max(1u, min(getCpuCoresCount(), initInfo.m_threadCount));
+	m_hive = m_alloc.newInstance<ThreadHive>(threadCount, m_alloc, true);
 
 	return Error::NONE;
 }
 
 Error GltfImporter::writeAll()
 {
-	populateNodePtrToIdx();
+	const Second startTime = HighRezTimer::getCurrentTime();
 
-	for(const cgltf_animation* anim = m_gltf->animations; anim < m_gltf->animations + m_gltf->animations_count; ++anim)
-	{
-		ANKI_CHECK(writeAnimation(*anim));
-	}
+	populateNodePtrToIdx();
+	ANKI_CHECK(loadCache());
 
+	// Write the scene and gather the resources that the nodes use
+	const Second sceneStartTime = HighRezTimer::getCurrentTime();
 	StringAuto sceneFname(m_alloc);
 	sceneFname.sprintf("%sScene.lua", m_outDir.cstr());
 	ANKI_CHECK(m_sceneFile.open(sceneFname.toCString(), FileOpenFlag::WRITE));
@@ -229,18 +261,19 @@ Error GltfImporter::writeAll()
 		}
 	}
 
-	if(m_hive)
-	{
-		m_hive->waitAllTasks();
-	}
-
-	// Check error
 	if(err)
 	{
 		ANKI_IMPORTER_LOGE("Error happened in main thread");
 		return err;
 	}
 
+	m_sceneFile.close();
+	recordStage(GltfImporterStage::SCENE, sceneStartTime, 1, 0);
+
+	// Write the resources
+	submitTasks();
+	m_hive->waitAllTasks();
+
 	const Error threadErr = m_errorInThread.load();
 	if(threadErr)
 	{
@@ -248,7 +281,299 @@ Error GltfImporter::writeAll()
 		return threadErr;
 	}
 
-	return err;
+	// Remember the inputs only if everything went well
+	ANKI_CHECK(storeCache());
+
+	printTimingReport(HighRezTimer::getCurrentTime() - startTime);
+
+	return Error::NONE;
+}
+
+void GltfImporter::submitTasks()
+{
+	// Only the mesh work has dependencies and submitMeshTasks() submits it. Every other resource is a single task
+	class TaskArg
+	{
+	public:
+		GltfImporter* m_importer;
+		const void* m_resource;
+		RayTypeBit m_rayTypes;
+	};
+
+	const U32 taskCount = m_uniqueImages.getSize() + m_uniqueMeshes.getSize() * 2 + m_uniqueMaterials.getSize()
+						  + m_uniqueSkins.getSize() + U32(m_gltf->animations_count);
+	if(taskCount == 0)
+	{
+		return;
+	}
+
+	TaskArg* args = static_cast<TaskArg*>(m_hive->allocateScratchMemory(sizeof(TaskArg) * taskCount, alignof(TaskArg)));
+	DynamicArrayAuto<ThreadHiveTask> tasks(m_alloc);
+	tasks.create(taskCount);
+	U32 taskIdx = 0;
+
+	auto newTask = [&](ThreadHiveTaskCallback callback, const void* resource, RayTypeBit rayTypes = RayTypeBit::NONE) {
+		args[taskIdx].m_importer = this;
+		args[taskIdx].m_resource = resource;
+		args[taskIdx].m_rayTypes = rayTypes;
+		tasks[taskIdx].m_callback = callback;
+		tasks[taskIdx].m_argument = &args[taskIdx];
+		++taskIdx;
+	};
+
+	// The slow ones first
+	for(const cgltf_image* image : m_uniqueImages)
+	{
+		newTask(
+			[](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
+				const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+				const Second startTime = HighRezTimer::getCurrentTime();
+				Bool skipped = false;
+				const cgltf_image& image = *static_cast<const cgltf_image*>(arg.m_resource);
+				const Error err = arg.m_importer->writeTexture(image, skipped);
+				if(err)
+				{
+					arg.m_importer->m_errorInThread.store(err._getCode());
+				}
+
+				arg.m_importer->recordStage(GltfImporterStage::TEXTURES, startTime, !skipped, skipped);
+			},
+			image);
+	}
+
+	for(const cgltf_mesh* mesh : m_uniqueMeshes)
+	{
+		newTask(
+			[](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
+				const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+				arg.m_importer->submitMeshTasks(*static_cast<const cgltf_mesh*>(arg.m_resource));
+			},
+			mesh);
+	}
+
+	for(U32 i = 0; i < m_uniqueMaterials.getSize(); ++i)
+	{
+		newTask(
+			[](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
+				const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+				const Second startTime = HighRezTimer::getCurrentTime();
+				Bool skipped = false;
+				const Error err = arg.m_importer->writeMaterial(*static_cast<const cgltf_material*>(arg.m_resource),
+																arg.m_rayTypes, skipped);
+				if(err)
+				{
+					arg.m_importer->m_errorInThread.store(err._getCode());
+				}
+
+				arg.m_importer->recordStage(GltfImporterStage::MATERIALS, startTime, !skipped, skipped);
+			},
+			m_uniqueMaterials[i], m_uniqueMaterialRayTypes[i]);
+	}
+
+	for(const cgltf_mesh* mesh : m_uniqueMeshes)
+	{
+		newTask(
+			[](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
+				const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+				const Second startTime = HighRezTimer::getCurrentTime();
+				const Error err = arg.m_importer->writeModel(*static_cast<const cgltf_mesh*>(arg.m_resource));
+				if(err)
+				{
+					arg.m_importer->m_errorInThread.store(err._getCode());
+				}
+
+				arg.m_importer->recordStage(GltfImporterStage::MODELS, startTime, 1, 0);
+			},
+			mesh);
+	}
+
+	for(const cgltf_skin* skin : m_uniqueSkins)
+	{
+		newTask(
+			[](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
+				const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+				const Second startTime = HighRezTimer::getCurrentTime();
+				const Error err = arg.m_importer->writeSkeleton(*static_cast<const cgltf_skin*>(arg.m_resource));
+				if(err)
+				{
+					arg.m_importer->m_errorInThread.store(err._getCode());
+				}
+
+				arg.m_importer->recordStage(GltfImporterStage::SKELETONS, startTime, 1, 0);
+			},
+			skin);
+	}
+
+	for(const cgltf_animation* anim = m_gltf->animations; anim < m_gltf->animations + m_gltf->animations_count; ++anim)
+	{
+		newTask(
+			[](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
+				const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+				const Second startTime = HighRezTimer::getCurrentTime();
+				const Error err = arg.m_importer->writeAnimation(*static_cast<const cgltf_animation*>(arg.m_resource));
+				if(err)
+				{
+					arg.m_importer->m_errorInThread.store(err._getCode());
+				}
+
+				arg.m_importer->recordStage(GltfImporterStage::ANIMATIONS, startTime, 1, 0);
+			},
+			anim);
+	}
+
+	ANKI_ASSERT(taskIdx == taskCount);
+	m_hive->submitTasks(&tasks[0], taskCount);
+}
+
+void GltfImporter::recordStage(GltfImporterStage stage, Second startTime, U32 writtenCount, U32 skippedCount)
+{
+	StageStats& stats = m_stageStats[stage];
+	stats.m_timeUs.fetchAdd(U64((HighRezTimer::getCurrentTime() - startTime) * 1000000.0));
+	stats.m_writtenCount.fetchAdd(writtenCount);
+	stats.m_skippedCount.fetchAdd(skippedCount);
+}
+
+void GltfImporter::printTimingReport(Second totalTime) const
+{
+	static const Array<const char*, U32(GltfImporterStage::COUNT)> stageNames = {
+		"Parse", "Scene", "Textures", "Mesh primitives", "Mesh LODs", "Materials", "Models", "Skeletons", "Animations"};
+
+	ANKI_IMPORTER_LOGI("Import took %fsec using %u threads. The time of the stages is the sum of all threads:",
+					   totalTime, m_hive->getThreadCount());
+	for(GltfImporterStage stage = GltfImporterStage::FIRST; stage < GltfImporterStage::COUNT; ++stage)
+	{
+		const StageStats& stats = m_stageStats[stage];
+		ANKI_IMPORTER_LOGI("\t%-16s %8.3fsec, %u processed, %u up to date", stageNames[stage],
+						   F64(stats.m_timeUs.getNonAtomically()) / 1000000.0, stats.m_writtenCount.getNonAtomically(),
+						   stats.m_skippedCount.getNonAtomically());
+	}
+}
+
+Error GltfImporter::loadCache()
+{
+	StringAuto fname(m_alloc);
+	fname.sprintf("%s%s", m_outDir.cstr(), CACHE_FILENAME);
+	if(!m_incrementalImport || !fileExists(fname))
+	{
+		return Error::NONE;
+	}
+
+	File file;
+	ANKI_CHECK(file.open(fname, FileOpenFlag::READ));
+	StringAuto txt(m_alloc);
+	ANKI_CHECK(file.readAllText(txt));
+
+	// Every line is "<hash of the inputs> <output filename>"
+	StringListAuto lines(m_alloc);
+	lines.splitString(txt, '\n');
+	for(const String& line : lines)
+	{
+		const PtrSize space = line.find(" ");
+		if(space == String::NPOS || space == 0 || space + 1 >= line.getLength())
+		{
+			ANKI_IMPORTER_LOGW("Ignoring corrupted cache %s", fname.cstr());
+			m_prevInputHashes.destroy();
+			break;
+		}
+
+		StringAuto hashStr(m_alloc);
+		hashStr.create(line.getBegin(), line.getBegin() + space);
+		U64 inputHash;
+		if(hashStr.toNumber(inputHash))
+		{
+			ANKI_IMPORTER_LOGW("Ignoring corrupted cache %s", fname.cstr());
+			m_prevInputHashes.destroy();
+			break;
+		}
+
+		m_prevInputHashes.emplace(CString(line.getBegin() + space + 1).computeHash(), inputHash);
+	}
+
+	return Error::NONE;
+}
+
+Error GltfImporter::storeCache()
+{
+	StringAuto fname(m_alloc);
+	fname.sprintf("%s%s", m_outDir.cstr(), CACHE_FILENAME);
+
+	File file;
+	ANKI_CHECK(file.open(fname, FileOpenFlag::WRITE));
+	for(const String& line : m_newCacheLines)
+	{
+		ANKI_CHECK(file.writeText("%s\n", line.cstr()));
+	}
+
+	return Error::NONE;
+}
+
+Bool GltfImporter::outputIsUpToDate(CString outFilename, U64 inputHash)
+{
+	Bool upToDate = false;
+	auto it = m_prevInputHashes.find(outFilename.computeHash());
+	if(it != m_prevInputHashes.getEnd() && *it == inputHash && fileExists(outFilename))
+	{
+		upToDate = true;
+	}
+
+	LockGuard<Mutex> lock(m_cacheMtx);
+	m_newCacheLines.pushBackSprintf("%" PRIu64 " %s", inputHash, outFilename.cstr());
+
+	return upToDate;
+}
+
+U64 GltfImporter::appendAccessorHash(const cgltf_accessor* accessor, U64 hash)
+{
+	if(accessor == nullptr)
+	{
+		return hash;
+	}
+
+	const Array<U64, 4> desc = {U64(accessor->component_type), U64(accessor->type), U64(accessor->count),
+								U64(accessor->normalized)};
+	hash = appendHash(&desc[0], sizeof(desc), hash);
+
+	if(accessor->buffer_view && accessor->buffer_view->buffer->data && accessor->count > 0)
+	{
+		const U8* base = static_cast<const U8*>(accessor->buffer_view->buffer->data) + accessor->offset
+						 + accessor->buffer_view->offset;
+		const PtrSize stride = (accessor->buffer_view->stride) ? accessor->buffer_view->stride : accessor->stride;
+		const PtrSize size =
+			min<PtrSize>(stride * accessor->count, accessor->buffer_view->size - accessor->offset);
+		hash = appendHash(base, size, hash);
+	}
+
+	return hash;
+}
+
+U64 GltfImporter::appendStringHash(CString str, U64 hash)
+{
+	return (str.isEmpty()) ? hash : appendHash(str.cstr(), str.getLength(), hash);
+}
+
+U64 GltfImporter::appendExtrasHash(const cgltf_extras& extras, U64 hash) const
+{
+	ANKI_ASSERT(extras.end_offset >= extras.start_offset);
+	const PtrSize size = extras.end_offset - extras.start_offset;
+	return (size > 0) ? appendHash(m_gltf->json + extras.start_offset, size, hash) : hash;
+}
+
+Error GltfImporter::appendFileHash(CString filename, U64& hash)
+{
+	File file;
+	ANKI_CHECK(file.open(filename, FileOpenFlag::READ | FileOpenFlag::BINARY));
+
+	Array<U8, 16 * 1024> buff;
+	PtrSize bytesLeft = file.getSize();
+	while(bytesLeft > 0)
+	{
+		const PtrSize size = min<PtrSize>(bytesLeft, sizeof(buff));
+		ANKI_CHECK(file.read(&buff[0], size));
+		hash = appendHash(&buff[0], size, hash);
+		bytesLeft -= size;
+	}
+
+	return Error::NONE;
 }
 
 Error GltfImporter::getExtras(const cgltf_extras& extras, HashMapAuto<CString, StringAuto>& out)
@@ -363,6 +688,41 @@ StringAuto GltfImporter::getNodeName(const cgltf_node& node)
 	return out;
 }
 
+void GltfImporter::gatherModelResources(const cgltf_node& node, RayTypeBit rayTypes)
+{
+	addUniqueResource(node.mesh, m_uniqueMeshes);
+
+	for(U32 i = 0; i < node.mesh->primitives_count; ++i)
+	{
+		const cgltf_material& mtl = *node.mesh->primitives[i].material;
+		const U32 mtlIdx = addUniqueResource(&mtl, m_uniqueMaterials);
+		if(mtlIdx == m_uniqueMaterialRayTypes.getSize())
+		{
+			m_uniqueMaterialRayTypes.emplaceBack(RayTypeBit::NONE);
+		}
+		m_uniqueMaterialRayTypes[mtlIdx] |= rayTypes;
+
+		if(m_importTextures)
+		{
+			const Array<const cgltf_texture_view*, 4> views = {&mtl.pbr_metallic_roughness.base_color_texture,
+															   &mtl.pbr_metallic_roughness.metallic_roughness_texture,
+															   &mtl.normal_texture, &mtl.emissive_texture};
+			for(const cgltf_texture_view* view : views)
+			{
+				if(view->texture && view->texture->image)
+				{
+					addUniqueResource(view->texture->image, m_uniqueImages);
+				}
+			}
+		}
+	}
+
+	if(node.skin)
+	{
+		addUniqueResource(node.skin, m_uniqueSkins);
+	}
+}
+
 Error GltfImporter::parseArrayOfNumbers(CString str, DynamicArrayAuto<F64>& out, const U32* expectedArraySize)
 {
 	StringListAuto list(m_alloc);
@@ -590,27 +950,8 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 		}
 		else
 		{
-			// Model node
-
-			// Async because it's slow
-			struct Ctx
-			{
-				GltfImporter* m_importer;
-				const cgltf_mesh* m_mesh;
-				Array<const cgltf_material*, 128> m_materials;
-				U32 m_materialCount = 0;
-				const cgltf_skin* m_skin;
-				RayTypeBit m_rayTypes;
-			};
-			Ctx* ctx = m_alloc.newInstance<Ctx>();
-			ctx->m_importer = this;
-			ctx->m_mesh = node.mesh;
-			for(U32 i = 0; i < node.mesh->primitives_count; ++i)
-			{
-				ctx->m_materials[ctx->m_materialCount++] = node.mesh->primitives[i].material;
-			}
-			ctx->m_skin = node.skin;
-			ctx->m_rayTypes = (skipRt) ? RayTypeBit::NONE : RayTypeBit::ALL;
+			// Model node. The resources are written later
+			gatherModelResources(node, (skipRt) ? RayTypeBit::NONE : RayTypeBit::ALL);
 
 			HashMapAuto<CString, StringAuto>::Iterator it2;
 			const Bool selfCollision = (it2 = extras.find("collision_mesh")) != extras.getEnd() && *it2 == "self";
@@ -625,67 +966,20 @@ Error GltfImporter::visitNode(const cgltf_node& node, const Transform& parentTrf
 				maxLod = 2;
 			}
 
-			// Thread task
-			auto callback = [](void* userData, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* signalSemaphore) {
-				Ctx& self = *static_cast<Ctx*>(userData);
-
-				// LOD 0
-				Error err = self.m_importer->writeMesh(*self.m_mesh, CString(), self.m_importer->computeLodFactor(0));
-
-				// LOD 1
-				if(!err && self.m_importer->m_lodCount > 1 && !self.m_importer->skipMeshLod(*self.m_mesh, 1))
-				{
-					StringAuto name(self.m_importer->m_alloc);
-					name.sprintf("%s_lod1", self.m_mesh->name);
-					err = self.m_importer->writeMesh(*self.m_mesh, name, self.m_importer->computeLodFactor(1));
-				}
-
-				// LOD 2
-				if(!err && self.m_importer->m_lodCount > 2 && !self.m_importer->skipMeshLod(*self.m_mesh, 2))
-				{
-					StringAuto name(self.m_importer->m_alloc);
-					name.sprintf("%s_lod2", self.m_mesh->name);
-					err = self.m_importer->writeMesh(*self.m_mesh, name, self.m_importer->computeLodFactor(2));
-				}
-
-				for(U32 i = 0; i < self.m_materialCount && !err; ++i)
-				{
-					err = self.m_importer->writeMaterial(*self.m_materials[i], self.m_rayTypes);
-				}
-
-				if(!err)
-				{
-					err = self.m_importer->writeModel(*self.m_mesh);
-				}
-
-				if(!err && self.m_skin)
-				{
-					err = self.m_importer->writeSkeleton(*self.m_skin);
-				}
-
-				if(err)
-				{
-					self.m_importer->m_errorInThread.store(err._getCode());
-				}
-
-				self.m_importer->m_alloc.deleteInstance(&self);
-			};
-
-			if(m_hive)
-			{
-				m_hive->submitTask(callback, ctx);
-			}
-			else
-			{
-				callback(ctx, 0, *m_hive, nullptr);
-			}
-
 			ANKI_CHECK(writeModelNode(node, parentExtras));
 
 			Transform localTrf;
 			ANKI_CHECK(getNodeTransform(node, localTrf));
 			ANKI_CHECK(writeTransform(parentTrf.combineTransformations(localTrf)));
 
+			// Models with a static collision mesh don't move so the renderer can cache things for them
+			const Bool isStatic =
+				selfCollision || ((it2 = extras.find("static")) != extras.getEnd() && *it2 == "true");
+			if(isStatic)
+			{
+				ANKI_CHECK(m_sceneFile.writeText("node:getSceneNodeBase():getSpatialComponent():setStatic(true)\n"));
+			}
+
 			if(selfCollision)
 			{
 				ANKI_CHECK(m_sceneFile.writeText("node2 = scene:newStaticCollisionNode(\"%s_cl\")\n",
@@ -10,6 +10,7 @@
 #include <AnKi/Util/StringList.h>
 #include <AnKi/Util/File.h>
 #include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/Thread.h>
 #include <AnKi/Resource/Common.h>
 #include <AnKi/Math.h>
 #include <Cgltf/cgltf.h>
@@ -28,14 +29,42 @@ public:
 	CString m_rpath;
 	CString m_texrpath;
 	Bool m_optimizeMeshes = true;
+	Bool m_quantizeMeshes = true; ///< Store the positions in 16bit normalized integers.
+	Bool m_compressMeshes = false; ///< Encode the mesh buffers with meshoptimizer's codecs.
 	F32 m_lodFactor = 1.0f;
 	U32 m_lodCount = 1;
 	F32 m_lightIntensityScale = 1.0f;
 	U32 m_threadCount = MAX_U32;
 	CString m_comment;
+	Bool m_incrementalImport = true; ///< Skip the outputs whose inputs didn't change since the last import.
+	Bool m_importTextures = false; ///< Convert the images that the materials use to AnKi images.
+	CString m_tempDirectory; ///< Needed to import the textures.
+	CString m_compressonatorPath; ///< Optional. See ImageImporterConfig.
+	CString m_astcencPath; ///< Optional. See ImageImporterConfig.
 };
 
-/// Import GLTF and spit AnKi scenes.
+/// The stages of the import. Used in the timing report.
+/// @memberof GltfImporter
+enum class GltfImporterStage : U8
+{
+	PARSE,
+	SCENE,
+	TEXTURES,
+	MESH_PRIMITIVES,
+	MESH_LODS,
+	MATERIALS,
+	MODELS,
+	SKELETONS,
+	ANIMATIONS,
+
+	COUNT,
+	FIRST = 0
+};
+ANKI_ENUM_ALLOW_NUMERIC_OPERATIONS(GltfImporterStage)
+
+/// Import GLTF and spit AnKi scenes. The resources are written by a graph of tasks that run in a ThreadHive. The
+/// importer remembers the hashes of the inputs of the meshes, materials and textures in a file in the output directory
+/// and the next import skips them if their inputs are the same.
 class GltfImporter
 {
 public:
@@ -57,8 +86,25 @@ private:
 		}
 	};
 
+	/// The work of a mesh. Defined in GltfImporterMesh.cpp.
+	class MeshCtx;
+
+	/// Per stage statistics.
+	class StageStats
+	{
+	public:
+		Atomic<U64> m_timeUs = {0}; ///< The time the stage took in all threads.
+		Atomic<U32> m_writtenCount = {0};
+		Atomic<U32> m_skippedCount = {0};
+	};
+
 	// Data
 	static const char* XML_HEADER;
+	static const char* CACHE_FILENAME;
+
+	/// Part of the input hashes of the meshes. Bump it when the importer writes different meshes for the same inputs
+	/// and the same MESH_MAGIC, like when the meshlet building changes.
+	static const U32 MESH_IMPORTER_VERSION;
 
 	GenericMemoryPoolAllocator<U8> m_alloc;
 
@@ -77,13 +123,36 @@ private:
 
 	Atomic<I32> m_errorInThread{0};
 
+	Array<StageStats, U32(GltfImporterStage::COUNT)> m_stageStats;
+
+	/// Maps the meshes, materials, skins and images that the nodes use to an index in the arrays bellow. Many nodes
+	/// might use the same resource but it's imported once.
+	HashMapAuto<const void*, U32, PtrHasher> m_uniqueResourceIndices{m_alloc};
+	DynamicArrayAuto<const cgltf_mesh*> m_uniqueMeshes{m_alloc};
+	DynamicArrayAuto<const cgltf_material*> m_uniqueMaterials{m_alloc};
+	DynamicArrayAuto<RayTypeBit> m_uniqueMaterialRayTypes{m_alloc}; ///< The ray types of all the nodes of a material.
+	DynamicArrayAuto<const cgltf_skin*> m_uniqueSkins{m_alloc};
+	DynamicArrayAuto<const cgltf_image*> m_uniqueImages{m_alloc};
+
+	/// Maps the hash of the filename of an output to the hash of its inputs of the previous import.
+	HashMapAuto<U64, U64> m_prevInputHashes{m_alloc};
+	StringListAuto m_newCacheLines{m_alloc}; ///< The lines of the cache file of this import.
+	Mutex m_cacheMtx;
+
 	HashMapAuto<const void*, U32, PtrHasher> m_nodePtrToIdx{m_alloc}; ///< Need an index for the unnamed nodes.
 
 	F32 m_lodFactor = 1.0f;
 	U32 m_lodCount = 1;
 	F32 m_lightIntensityScale = 1.0f;
 	Bool m_optimizeMeshes = false;
+	Bool m_quantizeMeshes = false;
+	Bool m_compressMeshes = false;
+	Bool m_incrementalImport = false;
+	Bool m_importTextures = false;
 	StringAuto m_comment{m_alloc};
+	StringAuto m_tempDir{m_alloc};
+	StringAuto m_compressonatorPath{m_alloc};
+	StringAuto m_astcencPath{m_alloc};
 
 	/// Don't generate LODs for meshes with less vertices than this number.
 	U32 m_skipLodVertexCountThreshold = 256;
@@ -95,6 +164,40 @@ private:
 	void populateNodePtrToIdx();
 	void populateNodePtrToIdxInternal(const cgltf_node& node, U32& idx);
 	StringAuto getNodeName(const cgltf_node& node);
+	void gatherModelResources(const cgltf_node& node, RayTypeBit rayTypes);
+
+	template<typename T>
+	U32 addUniqueResource(const T* ptr, DynamicArrayAuto<const T*>& resources)
+	{
+		ANKI_ASSERT(ptr);
+		auto it = m_uniqueResourceIndices.find(ptr);
+		if(it != m_uniqueResourceIndices.getEnd())
+		{
+			return *it;
+		}
+
+		resources.emplaceBack(ptr);
+		m_uniqueResourceIndices.emplace(ptr, resources.getSize() - 1);
+		return resources.getSize() - 1;
+	}
+
+	// Incremental import
+	ANKI_USE_RESULT Error loadCache();
+	ANKI_USE_RESULT Error storeCache();
+
+	/// Check if an output can be skipped because its inputs didn't change. It also remembers the new hash.
+	Bool outputIsUpToDate(CString outFilename, U64 inputHash);
+
+	static U64 appendAccessorHash(const cgltf_accessor* accessor, U64 hash);
+	static U64 appendStringHash(CString str, U64 hash);
+	U64 appendExtrasHash(const cgltf_extras& extras, U64 hash) const;
+	ANKI_USE_RESULT static Error appendFileHash(CString filename, U64& hash);
+
+	// Tasks
+	void submitTasks();
+	void submitMeshTasks(const cgltf_mesh& mesh);
+	void recordStage(GltfImporterStage stage, Second startTime, U32 writtenCount, U32 skippedCount);
+	void printTimingReport(Second totalTime) const;
 
 	template<typename T, typename TFunc>
 	static void visitAccessor(const cgltf_accessor& accessor, TFunc func);
@@ -147,9 +250,26 @@ private:
 		return out;
 	}
 
+	StringAuto computeMeshResourceFilename(const cgltf_mesh& mesh, U32 lod) const
+	{
+		StringAuto out(m_alloc);
+		if(lod == 0)
+		{
+			out.sprintf("%s%s.ankimesh", m_outDir.cstr(), mesh.name);
+		}
+		else
+		{
+			out.sprintf("%s%s_lod%u.ankimesh", m_outDir.cstr(), mesh.name, lod);
+		}
+
+		return out;
+	}
+
 	// Resources
-	ANKI_USE_RESULT Error writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32 decimateFactor);
-	ANKI_USE_RESULT Error writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayTypes);
+	ANKI_USE_RESULT Error loadMeshPrimitive(MeshCtx& ctx, U32 primitiveIdx);
+	ANKI_USE_RESULT Error writeMeshLod(MeshCtx& ctx, U32 lod);
+	ANKI_USE_RESULT Error writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayTypes, Bool& skipped);
+	ANKI_USE_RESULT Error writeTexture(const cgltf_image& image, Bool& skipped);
 	ANKI_USE_RESULT Error writeModel(const cgltf_mesh& mesh);
 	ANKI_USE_RESULT Error writeAnimation(const cgltf_animation& anim);
 	ANKI_USE_RESULT Error writeSkeleton(const cgltf_skin& skin);
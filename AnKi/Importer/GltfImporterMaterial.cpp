@@ -4,7 +4,9 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Importer/GltfImporter.h>
+#include <AnKi/Importer/ImageImporter.h>
 #include <AnKi/Resource/ImageLoader.h>
+#include <AnKi/Util/Filesystem.h>
 
 namespace anki {
 
@@ -96,11 +98,11 @@ static Error identifyMetallicRoughnessTexture(CString fname, F32& constantMetali
 	return Error::NONE;
 }
 
-Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayTypes)
+Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayTypes, Bool& skipped)
 {
+	skipped = false;
 	StringAuto fname(m_alloc);
 	fname.sprintf("%s%s.ankimtl", m_outDir.cstr(), mtl.name);
-	ANKI_IMPORTER_LOGI("Importing material %s", fname.cstr());
 
 	if(!mtl.has_pbr_metallic_roughness)
 	{
@@ -108,6 +110,43 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 		return Error::USER_DATA;
 	}
 
+	// Hash the inputs. The metallic/roughness texture is read to find if it's constant so hash its contents as well
+	{
+		U64 inputHash = computeHash(MATERIAL_TEMPLATE, strlen(MATERIAL_TEMPLATE));
+		inputHash = appendStringHash(RT_MATERIAL_TEMPLATE, inputHash);
+		inputHash = appendStringHash(m_texrpath, inputHash);
+		inputHash = appendHash(&usedRayTypes, sizeof(usedRayTypes), inputHash);
+
+		const cgltf_pbr_metallic_roughness& pbr = mtl.pbr_metallic_roughness;
+		const Array<F32, 9> factors = {pbr.base_color_factor[0], pbr.base_color_factor[1], pbr.base_color_factor[2],
+									   pbr.base_color_factor[3], pbr.metallic_factor,	  pbr.roughness_factor,
+									   mtl.emissive_factor[0],	  mtl.emissive_factor[1],  mtl.emissive_factor[2]};
+		inputHash = appendHash(&factors[0], sizeof(factors), inputHash);
+
+		const Array<const cgltf_texture_view*, 4> views = {&pbr.base_color_texture, &pbr.metallic_roughness_texture,
+														   &mtl.normal_texture, &mtl.emissive_texture};
+		for(const cgltf_texture_view* view : views)
+		{
+			inputHash = appendStringHash((view->texture) ? getTextureUri(*view) : "none", inputHash);
+		}
+
+		inputHash = appendExtrasHash(mtl.extras, inputHash);
+
+		if(pbr.metallic_roughness_texture.texture)
+		{
+			ANKI_CHECK(appendFileHash(getTextureUri(pbr.metallic_roughness_texture), inputHash));
+		}
+
+		if(outputIsUpToDate(fname, inputHash))
+		{
+			ANKI_IMPORTER_LOGV("Material is up to date %s", fname.cstr());
+			skipped = true;
+			return Error::NONE;
+		}
+	}
+
+	ANKI_IMPORTER_LOGI("Importing material %s", fname.cstr());
+
 	HashMapAuto<CString, StringAuto> extras(m_alloc);
 	ANKI_CHECK(getExtras(mtl.extras, extras));
 
@@ -128,7 +167,8 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 		uri.sprintf("%s%s", m_texrpath.cstr(), getTextureUri(mtl.pbr_metallic_roughness.base_color_texture).cstr());
 
 		xml.replaceAll("%diff%",
-					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"u_diffTex\" value=\"%s\"/>", uri.cstr()));
+					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"m_diffTex\" bindlessTexture=\"%s\"/>",
+												   uri.cstr()));
 		xml.replaceAll("%diffTexMutator%", "1");
 	}
 	else
@@ -190,7 +230,8 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 					getTextureUri(mtl.pbr_metallic_roughness.metallic_roughness_texture).cstr());
 
 		xml.replaceAll("%roughness%",
-					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"u_roughnessTex\" value=\"%s\"/>", uri.cstr()));
+					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"m_roughnessTex\" bindlessTexture=\"%s\"/>",
+												   uri.cstr()));
 
 		xml.replaceAll("%roughnessTexMutator%", "1");
 	}
@@ -214,7 +255,8 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 					getTextureUri(mtl.pbr_metallic_roughness.metallic_roughness_texture).cstr());
 
 		xml.replaceAll("%metallic%",
-					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"u_metallicTex\" value=\"%s\"/>", uri.cstr()));
+					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"m_metallicTex\" bindlessTexture=\"%s\"/>",
+												   uri.cstr()));
 
 		xml.replaceAll("%metalTexMutator%", "1");
 	}
@@ -237,7 +279,8 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 		uri.sprintf("%s%s", m_texrpath.cstr(), getTextureUri(mtl.normal_texture).cstr());
 
 		xml.replaceAll("%normal%",
-					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"u_normalTex\" value=\"%s\"/>", uri.cstr()));
+					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"m_normalTex\" bindlessTexture=\"%s\"/>",
+												   uri.cstr()));
 
 		xml.replaceAll("%normalTexMutator%", "1");
 	}
@@ -254,7 +297,8 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 		uri.sprintf("%s%s", m_texrpath.cstr(), getTextureUri(mtl.emissive_texture).cstr());
 
 		xml.replaceAll("%emission%",
-					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"u_emissiveTex\" value=\"%s\"/>", uri.cstr()));
+					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"m_emissiveTex\" bindlessTexture=\"%s\"/>",
+												   uri.cstr()));
 
 		xml.replaceAll("%emissiveTexMutator%", "1");
 	}
@@ -293,7 +337,7 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 		uri.sprintf("%s%s", m_texrpath.cstr(), it->cstr());
 
 		xml.replaceAll("%height%",
-					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"u_heightTex\" value=\"%s\" \"/>\n"
+					   StringAuto{m_alloc}.sprintf("<input shaderVar=\"m_heightTex\" bindlessTexture=\"%s\"/>\n"
 												   "\t\t<input shaderVar=\"m_heightmapScale\" value=\"0.05\"/>",
 												   uri.cstr()));
 
@@ -320,4 +364,79 @@ Error GltfImporter::writeMaterial(const cgltf_material& mtl, RayTypeBit usedRayT
 	return Error::NONE;
 }
 
+Error GltfImporter::writeTexture(const cgltf_image& image, Bool& skipped)
+{
+	skipped = false;
+	if(image.uri == nullptr)
+	{
+		ANKI_IMPORTER_LOGE("Only images in separate files are supported");
+		return Error::USER_DATA;
+	}
+
+	// The URI is relative to the glTF file
+	StringAuto inFname(m_alloc);
+	{
+		StringAuto gltfDir(m_alloc);
+		getParentFilepath(m_inputFname, gltfDir);
+		inFname.sprintf((gltfDir.isEmpty()) ? "%s%s" : "%s/%s", gltfDir.cstr(), image.uri);
+	}
+
+	// The materials point to texrpath + the URI with the extension replaced so mirror that in the output directory
+	StringAuto outFname(m_alloc);
+	{
+		StringAuto ext(m_alloc);
+		getFilepathExtension(image.uri, ext);
+		const CString uri = image.uri;
+		const U32 uriLengthNoExt = (ext.isEmpty()) ? uri.getLength() : (uri.getLength() - ext.getLength() - 1);
+
+		StringAuto uriNoExt(m_alloc);
+		uriNoExt.create(uri.cstr(), uri.cstr() + uriLengthNoExt);
+		outFname.sprintf("%s%s.ankitex", m_outDir.cstr(), uriNoExt.cstr());
+	}
+
+	ImageImporterConfig config;
+	config.m_allocator = m_alloc;
+	const CString inFnameCstr = inFname;
+	config.m_inputFilenames = ConstWeakArray<CString>(&inFnameCstr, 1);
+	config.m_outFilename = outFname;
+	config.m_noAlpha = false;
+	config.m_tempDirectory = m_tempDir;
+	config.m_compressonatorPath = m_compressonatorPath;
+	config.m_astcencPath = m_astcencPath;
+
+	// Hash the inputs
+	U64 inputHash = computeHash(IMAGE_MAGIC, 8);
+	const Array<U32, 7> options = {U32(config.m_type),
+								   U32(config.m_compressions),
+								   config.m_minMipmapDimension,
+								   config.m_mipmapCount,
+								   config.m_noAlpha,
+								   config.m_astcBlockSize.x(),
+								   config.m_astcBlockSize.y()};
+	inputHash = appendHash(&options[0], sizeof(options), inputHash);
+	ANKI_CHECK(appendFileHash(inFname, inputHash));
+
+	if(outputIsUpToDate(outFname, inputHash))
+	{
+		ANKI_IMPORTER_LOGV("Texture is up to date %s", outFname.cstr());
+		skipped = true;
+		return Error::NONE;
+	}
+
+	ANKI_IMPORTER_LOGI("Importing texture %s", outFname.cstr());
+
+	// Create the directory of the texture. Other threads might race to create it
+	StringAuto outDir(m_alloc);
+	getParentFilepath(outFname, outDir);
+	if(!outDir.isEmpty() && !directoryExists(outDir) && createDirectory(outDir) && !directoryExists(outDir))
+	{
+		ANKI_IMPORTER_LOGE("Failed to create directory %s", outDir.cstr());
+		return Error::FUNCTION_FAILED;
+	}
+
+	ANKI_CHECK(importImage(config));
+
+	return Error::NONE;
+}
+
 } // end namespace anki
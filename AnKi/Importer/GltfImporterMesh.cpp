@@ -5,6 +5,8 @@
 
 #include <AnKi/Importer/GltfImporter.h>
 #include <AnKi/Util/StringList.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/HighRezTimer.h>
 #include <AnKi/Collision/Plane.h>
 #include <AnKi/Collision/Functions.h>
 #include <AnKi/Resource/MeshBinary.h>
@@ -105,6 +107,22 @@ static Error alignBufferInFile(PtrSize bufferSize, File& file)
 	return Error::NONE;
 }
 
+/// Copy or encode a vertex buffer to the memory that will be written to the file.
+static void storeVertexBufferForFile(const void* verts, U32 vertCount, U32 vertSize, Bool compress,
+									 DynamicArrayAuto<U8, PtrSize>& out)
+{
+	if(compress)
+	{
+		out.create(meshopt_encodeVertexBufferBound(vertCount, vertSize));
+		out.resize(meshopt_encodeVertexBuffer(&out[0], out.getSize(), verts, vertCount, vertSize));
+	}
+	else
+	{
+		out.create(PtrSize(vertCount) * vertSize);
+		memcpy(&out[0], verts, out.getSize());
+	}
+}
+
 class TempVertex
 {
 public:
@@ -129,6 +147,7 @@ class SubMesh
 public:
 	DynamicArrayAuto<TempVertex> m_verts;
 	DynamicArrayAuto<U32> m_indices;
+	DynamicArrayAuto<MeshBinaryMeshlet> m_meshlets; ///< The first index of the meshlets is relative to the submesh.
 
 	Vec3 m_aabbMin = Vec3(MAX_F32);
 	Vec3 m_aabbMax = Vec3(MIN_F32);
@@ -136,9 +155,12 @@ public:
 	U32 m_firstIdx = MAX_U32;
 	U32 m_idxCount = MAX_U32;
 
+	Bool m_hasBoneWeights = false;
+
 	SubMesh(GenericMemoryPoolAllocator<U8>& alloc)
 		: m_verts(alloc)
 		, m_indices(alloc)
+		, m_meshlets(alloc)
 	{
 	}
 };
@@ -212,6 +234,50 @@ static void optimizeSubmesh(SubMesh& submesh, GenericMemoryPoolAllocator<U8> all
 	}
 }
 
+/// Split a submesh into meshlets and re-order its triangles so the triangles of each meshlet are contiguous.
+static void buildSubmeshMeshlets(SubMesh& submesh, GenericMemoryPoolAllocator<U8> alloc)
+{
+	constexpr U32 maxVertices = 64;
+	constexpr U32 maxTriangles = 124;
+
+	DynamicArrayAuto<meshopt_Meshlet> meshlets(alloc);
+	meshlets.create(U32(meshopt_buildMeshletsBound(submesh.m_indices.getSize(), maxVertices, maxTriangles)));
+	meshlets.resize(U32(meshopt_buildMeshlets(&meshlets[0], &submesh.m_indices[0], submesh.m_indices.getSize(),
+											  submesh.m_verts.getSize(), maxVertices, maxTriangles)));
+
+	DynamicArrayAuto<U32> newIndices(alloc);
+	newIndices.create(submesh.m_indices.getSize());
+	submesh.m_meshlets.create(meshlets.getSize());
+	U32 idxCount = 0;
+	for(U32 i = 0; i < meshlets.getSize(); ++i)
+	{
+		const meshopt_Meshlet& in = meshlets[i];
+		MeshBinaryMeshlet& out = submesh.m_meshlets[i];
+
+		out.m_firstIndex = idxCount;
+		for(U32 tri = 0; tri < in.triangle_count; ++tri)
+		{
+			for(U32 c = 0; c < 3; ++c)
+			{
+				newIndices[idxCount++] = in.vertices[in.indices[tri][c]];
+			}
+		}
+		out.m_indexCount = idxCount - out.m_firstIndex;
+
+		const meshopt_Bounds bounds = meshopt_computeClusterBounds(
+			&newIndices[out.m_firstIndex], out.m_indexCount, &submesh.m_verts[0].m_position.x(),
+			submesh.m_verts.getSize(), sizeof(TempVertex));
+		out.m_sphereCenter = Vec3(bounds.center[0], bounds.center[1], bounds.center[2]);
+		out.m_sphereRadius = bounds.radius;
+		out.m_coneApex = Vec3(bounds.cone_apex[0], bounds.cone_apex[1], bounds.cone_apex[2]);
+		out.m_coneAxis = Vec3(bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]);
+		out.m_coneCutoff = bounds.cone_cutoff;
+	}
+
+	ANKI_ASSERT(idxCount == submesh.m_indices.getSize());
+	submesh.m_indices = std::move(newIndices);
+}
+
 /// Decimate a submesh using meshoptimizer.
 static void decimateSubmesh(F32 factor, SubMesh& submesh, GenericMemoryPoolAllocator<U8> alloc)
 {
@@ -271,280 +337,442 @@ U32 GltfImporter::getMeshTotalVertexCount(const cgltf_mesh& mesh)
 	return totalVertexCount;
 }
 
-Error GltfImporter::writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32 decimateFactor)
+class GltfImporter::MeshCtx
 {
-	StringAuto fname(m_alloc);
-	fname.sprintf("%s%s.ankimesh", m_outDir.cstr(), (nameOverride.isEmpty()) ? mesh.name : nameOverride.cstr());
-	ANKI_IMPORTER_LOGI("Importing mesh (%s, decimate factor %f): %s", (m_optimizeMeshes) ? "optimze" : "WON'T optimize",
-					   decimateFactor, fname.cstr());
+public:
+	GltfImporter* m_importer = nullptr;
+	const cgltf_mesh* m_mesh = nullptr;
+	DynamicArrayAuto<SubMesh> m_primitives; ///< The primitives after parsing and optimizing. Shared by the LODs.
+	Array<U32, 3> m_lodsToWrite = {};
+	Atomic<U32> m_pendingLodTasks = {0}; ///< The last LOD task deletes the context.
+	Bool m_reindex = false;
+
+	MeshCtx(GenericMemoryPoolAllocator<U8> alloc)
+		: m_primitives(alloc)
+	{
+	}
+};
 
-	ListAuto<SubMesh> submeshes(m_alloc);
-	U32 totalIndexCount = 0;
-	U32 totalVertexCount = 0;
-	Vec3 aabbMin(MAX_F32);
-	Vec3 aabbMax(MIN_F32);
-	F32 maxUvDistance = MIN_F32;
-	F32 minUvDistance = MAX_F32;
-	Bool hasBoneWeights = false;
+void GltfImporter::submitMeshTasks(const cgltf_mesh& mesh)
+{
+	const Second startTime = HighRezTimer::getCurrentTime();
 
-	// Iterate primitives. Every primitive is a submesh
-	for(const cgltf_primitive* primitive = mesh.primitives; primitive < mesh.primitives + mesh.primitives_count;
-		++primitive)
+	U32 lodCount = 1;
+	for(U32 lod = 1; lod < m_lodCount; ++lod)
 	{
-		if(primitive->type != cgltf_primitive_type_triangles)
+		if(!skipMeshLod(mesh, lod))
 		{
-			ANKI_IMPORTER_LOGE("Expecting triangles got %d", primitive->type);
-			return Error::USER_DATA;
+			lodCount = lod + 1;
 		}
+	}
 
-		SubMesh& submesh = *submeshes.emplaceBack(m_alloc);
+	// The decimation needs re-indexed primitives. All LODs share the primitives so re-index LOD 0 as well. It doesn't
+	// change the geometry
+	const Bool reindex = m_optimizeMeshes || lodCount > 1;
 
-		U minVertCount = MAX_U;
-		U maxVertCount = MIN_U;
+	// Hash the inputs
+	U64 meshHash = computeHash(MESH_MAGIC, 8);
+	meshHash = appendHash(&MESH_IMPORTER_VERSION, sizeof(MESH_IMPORTER_VERSION), meshHash);
+	const Array<F32, 6> options = {F32(m_optimizeMeshes), F32(m_quantizeMeshes), F32(m_compressMeshes), F32(reindex),
+								   m_normalsMergeAngle, F32(m_skipLodVertexCountThreshold)};
+	meshHash = appendHash(&options[0], sizeof(options), meshHash);
+	for(const cgltf_primitive* primitive = mesh.primitives; primitive < mesh.primitives + mesh.primitives_count;
+		++primitive)
+	{
+		meshHash = appendHash(&primitive->type, sizeof(primitive->type), meshHash);
 		for(const cgltf_attribute* attrib = primitive->attributes;
 			attrib < primitive->attributes + primitive->attributes_count; ++attrib)
 		{
-			minVertCount = min(minVertCount, U(attrib->data->count));
-			maxVertCount = max(maxVertCount, U(attrib->data->count));
+			meshHash = appendStringHash(attrib->name, meshHash);
+			meshHash = appendAccessorHash(attrib->data, meshHash);
 		}
 
-		if(maxVertCount == 0 || minVertCount != maxVertCount)
+		meshHash = appendAccessorHash(primitive->indices, meshHash);
+	}
+
+	MeshCtx* ctx = m_alloc.newInstance<MeshCtx>(m_alloc);
+	ctx->m_importer = this;
+	ctx->m_mesh = &mesh;
+	ctx->m_reindex = reindex;
+	U32 lodsToWriteCount = 0;
+	for(U32 lod = 0; lod < lodCount; ++lod)
+	{
+		const F32 decimateFactor = computeLodFactor(lod);
+		const U64 lodHash = appendHash(&decimateFactor, sizeof(decimateFactor), meshHash);
+		if(outputIsUpToDate(computeMeshResourceFilename(mesh, lod), lodHash))
 		{
-			ANKI_IMPORTER_LOGE("Wrong number of vertices");
-			return Error::USER_DATA;
+			recordStage(GltfImporterStage::MESH_LODS, HighRezTimer::getCurrentTime(), 0, 1);
+		}
+		else
+		{
+			ctx->m_lodsToWrite[lodsToWriteCount++] = lod;
 		}
+	}
 
-		U32 vertCount = U32(primitive->attributes[0].data->count);
-		submesh.m_verts.create(vertCount);
+	if(lodsToWriteCount == 0)
+	{
+		m_alloc.deleteInstance(ctx);
+		recordStage(GltfImporterStage::MESH_PRIMITIVES, startTime, 0, U32(mesh.primitives_count));
+		return;
+	}
 
-		//
-		// Gather positions + normals + UVs
-		//
-		for(const cgltf_attribute* attrib = primitive->attributes;
-			attrib < primitive->attributes + primitive->attributes_count; ++attrib)
-		{
-			if(attrib->type == cgltf_attribute_type_position)
-			{
-				U32 count = 0;
-				ANKI_CHECK(checkAttribute<Vec3>(*attrib));
-				visitAccessor<Vec3>(*attrib->data, [&](const Vec3& pos) {
-					submesh.m_aabbMin = submesh.m_aabbMin.min(pos);
-					submesh.m_aabbMax = submesh.m_aabbMax.max(pos);
-					submesh.m_verts[count++].m_position = pos;
-				});
-			}
-			else if(attrib->type == cgltf_attribute_type_normal)
-			{
-				U32 count = 0;
-				ANKI_CHECK(checkAttribute<Vec3>(*attrib));
-				visitAccessor<Vec3>(*attrib->data, [&](const Vec3& normal) {
-					submesh.m_verts[count++].m_normal = normal;
-				});
-			}
-			else if(attrib->type == cgltf_attribute_type_texcoord && CString(attrib->name) == "TEXCOORD_0")
-			{
-				U32 count = 0;
-				ANKI_CHECK(checkAttribute<Vec2>(*attrib));
-				visitAccessor<Vec2>(*attrib->data, [&](const Vec2& uv) {
-					maxUvDistance = max(maxUvDistance, max(uv.x(), uv.y()));
-					minUvDistance = min(minUvDistance, min(uv.x(), uv.y()));
-					submesh.m_verts[count++].m_uv = uv;
-				});
-			}
-			else if(attrib->type == cgltf_attribute_type_joints)
+	recordStage(GltfImporterStage::MESH_PRIMITIVES, startTime, 0, 0);
+
+	ctx->m_primitives.create(U32(mesh.primitives_count), SubMesh(m_alloc));
+	ctx->m_pendingLodTasks.setNonAtomically(lodsToWriteCount);
+
+	// Parse and optimize the primitives in parallel and then write the LODs
+	class TaskArg
+	{
+	public:
+		MeshCtx* m_ctx;
+		U32 m_idx;
+	};
+
+	const U32 taskCount = U32(mesh.primitives_count) + lodsToWriteCount;
+	TaskArg* args = static_cast<TaskArg*>(m_hive->allocateScratchMemory(sizeof(TaskArg) * taskCount, alignof(TaskArg)));
+	DynamicArrayAuto<ThreadHiveTask> tasks(m_alloc);
+	tasks.create(taskCount);
+	ThreadHiveSemaphore* primitivesDone = m_hive->newSemaphore(U32(mesh.primitives_count));
+
+	for(U32 i = 0; i < mesh.primitives_count; ++i)
+	{
+		args[i].m_ctx = ctx;
+		args[i].m_idx = i;
+
+		tasks[i].m_callback = [](void* userData, U32 threadId, ThreadHive& hive,
+								 ThreadHiveSemaphore* signalSemaphore) {
+			const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+			GltfImporter& self = *arg.m_ctx->m_importer;
+			const Second taskStartTime = HighRezTimer::getCurrentTime();
+
+			const Error err = self.loadMeshPrimitive(*arg.m_ctx, arg.m_idx);
+			if(err)
 			{
-				U32 count = 0;
-				ANKI_CHECK(checkAttribute<U16Vec4>(*attrib));
-				visitAccessor<U16Vec4>(*attrib->data, [&](const U16Vec4& x) {
-					submesh.m_verts[count++].m_boneIds = x;
-				});
-				hasBoneWeights = true;
+				self.m_errorInThread.store(err._getCode());
 			}
-			else if(attrib->type == cgltf_attribute_type_weights)
+
+			self.recordStage(GltfImporterStage::MESH_PRIMITIVES, taskStartTime, 1, 0);
+		};
+		tasks[i].m_argument = &args[i];
+		tasks[i].m_signalSemaphore = primitivesDone;
+	}
+
+	for(U32 i = U32(mesh.primitives_count); i < taskCount; ++i)
+	{
+		args[i].m_ctx = ctx;
+		args[i].m_idx = ctx->m_lodsToWrite[i - mesh.primitives_count];
+
+		tasks[i].m_callback = [](void* userData, U32 threadId, ThreadHive& hive,
+								 ThreadHiveSemaphore* signalSemaphore) {
+			const TaskArg& arg = *static_cast<const TaskArg*>(userData);
+			MeshCtx& ctx = *arg.m_ctx;
+			GltfImporter& self = *ctx.m_importer;
+			const Second taskStartTime = HighRezTimer::getCurrentTime();
+
+			// Skip if a primitive failed
+			if(!self.m_errorInThread.load())
 			{
-				U32 count = 0;
-				ANKI_CHECK(checkAttribute<Vec4>(*attrib));
-				visitAccessor<Vec4>(*attrib->data, [&](const Vec4& bw) {
-					submesh.m_verts[count++].m_boneWeights = bw;
-				});
+				const Error err = self.writeMeshLod(ctx, arg.m_idx);
+				if(err)
+				{
+					self.m_errorInThread.store(err._getCode());
+				}
+
+				self.recordStage(GltfImporterStage::MESH_LODS, taskStartTime, 1, 0);
 			}
-			else
+
+			if(ctx.m_pendingLodTasks.fetchSub(1) == 1)
 			{
-				ANKI_IMPORTER_LOGW("Ignoring attribute: %s", attrib->name);
+				self.m_alloc.deleteInstance(&ctx);
 			}
-		}
+		};
+		tasks[i].m_argument = &args[i];
+		tasks[i].m_waitSemaphore = primitivesDone;
+	}
 
-		aabbMin = aabbMin.min(submesh.m_aabbMin);
-		// Bump aabbMax a bit
-		submesh.m_aabbMax += EPSILON * 10.0f;
-		aabbMax = aabbMax.max(submesh.m_aabbMax);
+	m_hive->submitTasks(&tasks[0], taskCount);
+}
 
-		//
-		// Fix normals. If normal A and normal B have the same position then try to merge them
-		//
-		for(U32 v = 0; v < vertCount; ++v)
-		{
-			const Vec3& pos = submesh.m_verts[v].m_position;
-			Vec3& normal = submesh.m_verts[v].m_normal;
+Error GltfImporter::loadMeshPrimitive(MeshCtx& ctx, U32 primitiveIdx)
+{
+	const cgltf_primitive* primitive = &ctx.m_mesh->primitives[primitiveIdx];
+	SubMesh& submesh = ctx.m_primitives[primitiveIdx];
 
-			for(U32 prevV = 0; prevV < v; ++prevV)
-			{
-				const Vec3& otherPos = submesh.m_verts[prevV].m_position;
+	if(primitive->type != cgltf_primitive_type_triangles)
+	{
+		ANKI_IMPORTER_LOGE("Expecting triangles got %d", primitive->type);
+		return Error::USER_DATA;
+	}
 
-				// Check the positions dist
-				const F32 posDist = (otherPos - pos).getLengthSquared();
-				if(posDist > EPSILON * EPSILON)
-				{
-					continue;
-				}
+	U minVertCount = MAX_U;
+	U maxVertCount = MIN_U;
+	for(const cgltf_attribute* attrib = primitive->attributes;
+		attrib < primitive->attributes + primitive->attributes_count; ++attrib)
+	{
+		minVertCount = min(minVertCount, U(attrib->data->count));
+		maxVertCount = max(maxVertCount, U(attrib->data->count));
+	}
 
-				// Check angle of the normals
-				Vec3& otherNormal = submesh.m_verts[prevV].m_normal;
-				const F32 ang = acos(clamp(otherNormal.dot(normal), -1.0f, 1.0f));
-				if(ang > m_normalsMergeAngle)
-				{
-					continue;
-				}
+	if(maxVertCount == 0 || minVertCount != maxVertCount)
+	{
+		ANKI_IMPORTER_LOGE("Wrong number of vertices");
+		return Error::USER_DATA;
+	}
 
-				// Merge normals
-				const Vec3 newNormal = (otherNormal + normal).getNormalized();
-				normal = newNormal;
-				otherNormal = newNormal;
-			}
+	U32 vertCount = U32(primitive->attributes[0].data->count);
+	submesh.m_verts.create(vertCount);
+
+	//
+	// Gather positions + normals + UVs
+	//
+	for(const cgltf_attribute* attrib = primitive->attributes;
+		attrib < primitive->attributes + primitive->attributes_count; ++attrib)
+	{
+		if(attrib->type == cgltf_attribute_type_position)
+		{
+			U32 count = 0;
+			ANKI_CHECK(checkAttribute<Vec3>(*attrib));
+			visitAccessor<Vec3>(*attrib->data, [&](const Vec3& pos) {
+				submesh.m_aabbMin = submesh.m_aabbMin.min(pos);
+				submesh.m_aabbMax = submesh.m_aabbMax.max(pos);
+				submesh.m_verts[count++].m_position = pos;
+			});
+		}
+		else if(attrib->type == cgltf_attribute_type_normal)
+		{
+			U32 count = 0;
+			ANKI_CHECK(checkAttribute<Vec3>(*attrib));
+			visitAccessor<Vec3>(*attrib->data, [&](const Vec3& normal) {
+				submesh.m_verts[count++].m_normal = normal;
+			});
+		}
+		else if(attrib->type == cgltf_attribute_type_texcoord && CString(attrib->name) == "TEXCOORD_0")
+		{
+			U32 count = 0;
+			ANKI_CHECK(checkAttribute<Vec2>(*attrib));
+			visitAccessor<Vec2>(*attrib->data, [&](const Vec2& uv) {
+				submesh.m_verts[count++].m_uv = uv;
+			});
+		}
+		else if(attrib->type == cgltf_attribute_type_joints)
+		{
+			U32 count = 0;
+			ANKI_CHECK(checkAttribute<U16Vec4>(*attrib));
+			visitAccessor<U16Vec4>(*attrib->data, [&](const U16Vec4& x) {
+				submesh.m_verts[count++].m_boneIds = x;
+			});
+			submesh.m_hasBoneWeights = true;
+		}
+		else if(attrib->type == cgltf_attribute_type_weights)
+		{
+			U32 count = 0;
+			ANKI_CHECK(checkAttribute<Vec4>(*attrib));
+			visitAccessor<Vec4>(*attrib->data, [&](const Vec4& bw) {
+				submesh.m_verts[count++].m_boneWeights = bw;
+			});
 		}
+		else
+		{
+			ANKI_IMPORTER_LOGW("Ignoring attribute: %s", attrib->name);
+		}
+	}
+
+	// Bump aabbMax a bit
+	submesh.m_aabbMax += EPSILON * 10.0f;
 
-		//
-		// Load indices
-		//
+	//
+	// Fix normals. If normal A and normal B have the same position then try to merge them
+	//
+	for(U32 v = 0; v < vertCount; ++v)
+	{
+		const Vec3& pos = submesh.m_verts[v].m_position;
+		Vec3& normal = submesh.m_verts[v].m_normal;
+
+		for(U32 prevV = 0; prevV < v; ++prevV)
 		{
-			ANKI_ASSERT(primitive->indices);
-			if(primitive->indices->count == 0 || (primitive->indices->count % 3) != 0)
+			const Vec3& otherPos = submesh.m_verts[prevV].m_position;
+
+			// Check the positions dist
+			const F32 posDist = (otherPos - pos).getLengthSquared();
+			if(posDist > EPSILON * EPSILON)
 			{
-				ANKI_IMPORTER_LOGE("Incorect index count: %lu", primitive->indices->count);
-				return Error::USER_DATA;
+				continue;
 			}
-			submesh.m_indices.create(U32(primitive->indices->count));
-			const U8* base = static_cast<const U8*>(primitive->indices->buffer_view->buffer->data)
-							 + primitive->indices->offset + primitive->indices->buffer_view->offset;
-			for(U32 i = 0; i < primitive->indices->count; ++i)
-			{
-				U32 idx;
-				if(primitive->indices->component_type == cgltf_component_type_r_32u)
-				{
-					idx = *reinterpret_cast<const U32*>(base + sizeof(U32) * i);
-				}
-				else if(primitive->indices->component_type == cgltf_component_type_r_16u)
-				{
-					idx = *reinterpret_cast<const U16*>(base + sizeof(U16) * i);
-				}
-				else
-				{
-					ANKI_ASSERT(0);
-					idx = 0;
-				}
 
-				submesh.m_indices[i] = idx;
+			// Check angle of the normals
+			Vec3& otherNormal = submesh.m_verts[prevV].m_normal;
+			const F32 ang = acos(clamp(otherNormal.dot(normal), -1.0f, 1.0f));
+			if(ang > m_normalsMergeAngle)
+			{
+				continue;
 			}
+
+			// Merge normals
+			const Vec3 newNormal = (otherNormal + normal).getNormalized();
+			normal = newNormal;
+			otherNormal = newNormal;
 		}
+	}
 
-		// Re-index meshes now and
-		// - before the tanget calculation because that will create many unique verts
-		// - after normal fix because that will create verts with same attributes
-		if(m_optimizeMeshes || decimateFactor < 1.0f)
+	//
+	// Load indices
+	//
+	{
+		ANKI_ASSERT(primitive->indices);
+		if(primitive->indices->count == 0 || (primitive->indices->count % 3) != 0)
 		{
-			reindexSubmesh(submesh, m_alloc);
-			vertCount = submesh.m_verts.getSize();
+			ANKI_IMPORTER_LOGE("Incorect index count: %lu", primitive->indices->count);
+			return Error::USER_DATA;
 		}
-
-		//
-		// Compute tangent
-		//
+		submesh.m_indices.create(U32(primitive->indices->count));
+		const U8* base = static_cast<const U8*>(primitive->indices->buffer_view->buffer->data)
+						 + primitive->indices->offset + primitive->indices->buffer_view->offset;
+		for(U32 i = 0; i < primitive->indices->count; ++i)
 		{
-			DynamicArrayAuto<Vec3> bitangents(m_alloc);
-			bitangents.create(vertCount, Vec3(0.0f));
-
-			for(U32 i = 0; i < submesh.m_indices.getSize(); i += 3)
+			U32 idx;
+			if(primitive->indices->component_type == cgltf_component_type_r_32u)
+			{
+				idx = *reinterpret_cast<const U32*>(base + sizeof(U32) * i);
+			}
+			else if(primitive->indices->component_type == cgltf_component_type_r_16u)
 			{
-				const U32 i0 = submesh.m_indices[i + 0];
-				const U32 i1 = submesh.m_indices[i + 1];
-				const U32 i2 = submesh.m_indices[i + 2];
+				idx = *reinterpret_cast<const U16*>(base + sizeof(U16) * i);
+			}
+			else
+			{
+				ANKI_ASSERT(0);
+				idx = 0;
+			}
 
-				const Vec3& v0 = submesh.m_verts[i0].m_position;
-				const Vec3& v1 = submesh.m_verts[i1].m_position;
-				const Vec3& v2 = submesh.m_verts[i2].m_position;
-				const Vec3 edge01 = v1 - v0;
-				const Vec3 edge02 = v2 - v0;
+			submesh.m_indices[i] = idx;
+		}
+	}
 
-				const Vec2 uvedge01 = submesh.m_verts[i1].m_uv - submesh.m_verts[i0].m_uv;
-				const Vec2 uvedge02 = submesh.m_verts[i2].m_uv - submesh.m_verts[i0].m_uv;
+	// Re-index meshes now and
+	// - before the tanget calculation because that will create many unique verts
+	// - after normal fix because that will create verts with same attributes
+	if(ctx.m_reindex)
+	{
+		reindexSubmesh(submesh, m_alloc);
+		vertCount = submesh.m_verts.getSize();
+	}
 
-				F32 det = (uvedge01.y() * uvedge02.x()) - (uvedge01.x() * uvedge02.y());
-				det = (isZero(det)) ? 0.0001f : (1.0f / det);
+	//
+	// Compute tangent
+	//
+	{
+		DynamicArrayAuto<Vec3> bitangents(m_alloc);
+		bitangents.create(vertCount, Vec3(0.0f));
 
-				Vec3 t = (edge02 * uvedge01.y() - edge01 * uvedge02.y()) * det;
-				Vec3 b = (edge02 * uvedge01.x() - edge01 * uvedge02.x()) * det;
+		for(U32 i = 0; i < submesh.m_indices.getSize(); i += 3)
+		{
+			const U32 i0 = submesh.m_indices[i + 0];
+			const U32 i1 = submesh.m_indices[i + 1];
+			const U32 i2 = submesh.m_indices[i + 2];
 
-				if(t.getLengthSquared() < EPSILON)
-				{
-					t = Vec3(1.0f, 0.0f, 0.0f); // Something random
-				}
-				else
-				{
-					t.normalize();
-				}
+			const Vec3& v0 = submesh.m_verts[i0].m_position;
+			const Vec3& v1 = submesh.m_verts[i1].m_position;
+			const Vec3& v2 = submesh.m_verts[i2].m_position;
+			const Vec3 edge01 = v1 - v0;
+			const Vec3 edge02 = v2 - v0;
 
-				if(b.getLengthSquared() < EPSILON)
-				{
-					b = Vec3(0.0f, 1.0f, 0.0f); // Something random
-				}
-				else
-				{
-					b.normalize();
-				}
+			const Vec2 uvedge01 = submesh.m_verts[i1].m_uv - submesh.m_verts[i0].m_uv;
+			const Vec2 uvedge02 = submesh.m_verts[i2].m_uv - submesh.m_verts[i0].m_uv;
 
-				submesh.m_verts[i0].m_tangent += Vec4(t, 0.0f);
-				submesh.m_verts[i1].m_tangent += Vec4(t, 0.0f);
-				submesh.m_verts[i2].m_tangent += Vec4(t, 0.0f);
+			F32 det = (uvedge01.y() * uvedge02.x()) - (uvedge01.x() * uvedge02.y());
+			det = (isZero(det)) ? 0.0001f : (1.0f / det);
 
-				bitangents[i0] += b;
-				bitangents[i1] += b;
-				bitangents[i2] += b;
-			}
+			Vec3 t = (edge02 * uvedge01.y() - edge01 * uvedge02.y()) * det;
+			Vec3 b = (edge02 * uvedge01.x() - edge01 * uvedge02.x()) * det;
 
-			for(U32 i = 0; i < vertCount; ++i)
+			if(t.getLengthSquared() < EPSILON)
 			{
-				Vec3 t = Vec3(submesh.m_verts[i].m_tangent.xyz());
-				const Vec3& n = submesh.m_verts[i].m_normal;
-				Vec3& b = bitangents[i];
+				t = Vec3(1.0f, 0.0f, 0.0f); // Something random
+			}
+			else
+			{
+				t.normalize();
+			}
 
-				if(t.getLengthSquared() < EPSILON)
-				{
-					t = Vec3(1.0f, 0.0f, 0.0f); // Something random
-				}
-				else
-				{
-					t.normalize();
-				}
+			if(b.getLengthSquared() < EPSILON)
+			{
+				b = Vec3(0.0f, 1.0f, 0.0f); // Something random
+			}
+			else
+			{
+				b.normalize();
+			}
 
-				if(b.getLengthSquared() < EPSILON)
-				{
-					b = Vec3(0.0f, 1.0f, 0.0f); // Something random
-				}
-				else
-				{
-					b.normalize();
-				}
+			submesh.m_verts[i0].m_tangent += Vec4(t, 0.0f);
+			submesh.m_verts[i1].m_tangent += Vec4(t, 0.0f);
+			submesh.m_verts[i2].m_tangent += Vec4(t, 0.0f);
 
-				const F32 w = ((n.cross(t)).dot(b) < 0.0f) ? 1.0f : -1.0f;
-				submesh.m_verts[i].m_tangent = Vec4(t, w);
-			}
+			bitangents[i0] += b;
+			bitangents[i1] += b;
+			bitangents[i2] += b;
 		}
 
-		// Optimize
-		if(m_optimizeMeshes)
+		for(U32 i = 0; i < vertCount; ++i)
 		{
-			optimizeSubmesh(submesh, m_alloc);
+			Vec3 t = Vec3(submesh.m_verts[i].m_tangent.xyz());
+			const Vec3& n = submesh.m_verts[i].m_normal;
+			Vec3& b = bitangents[i];
+
+			if(t.getLengthSquared() < EPSILON)
+			{
+				t = Vec3(1.0f, 0.0f, 0.0f); // Something random
+			}
+			else
+			{
+				t.normalize();
+			}
+
+			if(b.getLengthSquared() < EPSILON)
+			{
+				b = Vec3(0.0f, 1.0f, 0.0f); // Something random
+			}
+			else
+			{
+				b.normalize();
+			}
+
+			const F32 w = ((n.cross(t)).dot(b) < 0.0f) ? 1.0f : -1.0f;
+			submesh.m_verts[i].m_tangent = Vec4(t, w);
 		}
+	}
+
+	// Optimize
+	if(m_optimizeMeshes)
+	{
+		optimizeSubmesh(submesh, m_alloc);
+	}
+
+	return Error::NONE;
+}
+
+Error GltfImporter::writeMeshLod(MeshCtx& ctx, U32 lod)
+{
+	const F32 decimateFactor = computeLodFactor(lod);
+	const StringAuto fname = computeMeshResourceFilename(*ctx.m_mesh, lod);
+	ANKI_IMPORTER_LOGI("Importing mesh (%s, decimate factor %f): %s", (m_optimizeMeshes) ? "optimze" : "WON'T optimize",
+					   decimateFactor, fname.cstr());
+
+	ListAuto<SubMesh> submeshes(m_alloc);
+	U32 totalIndexCount = 0;
+	U32 totalVertexCount = 0;
+	Vec3 aabbMin(MAX_F32);
+	Vec3 aabbMax(MIN_F32);
+	Bool hasBoneWeights = false;
+
+	for(const SubMesh& primitive : ctx.m_primitives)
+	{
+		aabbMin = aabbMin.min(primitive.m_aabbMin);
+		aabbMax = aabbMax.max(primitive.m_aabbMax);
+		hasBoneWeights = hasBoneWeights || primitive.m_hasBoneWeights;
+
+		// Copy because the other LODs use the primitives as well
+		SubMesh& submesh = *submeshes.emplaceBack(primitive);
 
 		// Simplify
 		if(decimateFactor < 1.0f)
@@ -560,6 +788,8 @@ Error GltfImporter::writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32
 		}
 		else
 		{
+			buildSubmeshMeshlets(submesh, m_alloc);
+
 			// Finalize
 			submesh.m_firstIdx = totalIndexCount;
 			submesh.m_idxCount = submesh.m_indices.getSize();
@@ -628,9 +858,19 @@ Error GltfImporter::writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32
 		// Positions
 		MeshBinaryVertexAttribute& posa = header.m_vertexAttributes[VertexAttributeId::POSITION];
 		posa.m_bufferBinding = 0;
-		posa.m_format = Format::R32G32B32_SFLOAT;
 		posa.m_relativeOffset = 0;
-		posa.m_scale = 1.0f;
+		if(m_quantizeMeshes)
+		{
+			// Normalized to the bounding box. Use the same scale for all axis
+			const Vec3 extent = aabbMax - aabbMin;
+			posa.m_format = Format::R16G16B16A16_UNORM;
+			posa.m_scale = max(extent.x(), max(extent.y(), extent.z()));
+		}
+		else
+		{
+			posa.m_format = Format::R32G32B32_SFLOAT;
+			posa.m_scale = 1.0f;
+		}
 
 		// Normals
 		MeshBinaryVertexAttribute& na = header.m_vertexAttributes[VertexAttributeId::NORMAL];
@@ -649,7 +889,7 @@ Error GltfImporter::writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32
 		// UVs
 		MeshBinaryVertexAttribute& uva = header.m_vertexAttributes[VertexAttributeId::UV0];
 		uva.m_bufferBinding = 1;
-		uva.m_format = Format::R32G32_SFLOAT;
+		uva.m_format = Format::R16G16_SFLOAT;
 		uva.m_relativeOffset = sizeof(U32) * 2;
 		uva.m_scale = 1.0f;
 
@@ -673,7 +913,7 @@ Error GltfImporter::writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32
 	// Arange the attributes into vert buffers
 	{
 		// First buff has positions
-		header.m_vertexBuffers[0].m_vertexStride = sizeof(Vec3);
+		header.m_vertexBuffers[0].m_vertexStride = (m_quantizeMeshes) ? sizeof(U16Vec4) : sizeof(Vec3);
 		++header.m_vertexBufferCount;
 
 		// 2nd buff has normal + tangent + texcoords
@@ -688,132 +928,213 @@ Error GltfImporter::writeMesh(const cgltf_mesh& mesh, CString nameOverride, F32
 		}
 	}
 
-	// Write some other header stuff
+	// Gather the indices
+	DynamicArrayAuto<U8, PtrSize> indexBuffer(m_alloc);
 	{
-		memcpy(&header.m_magic[0], MESH_MAGIC, 8);
-		header.m_flags = MeshBinaryFlag::NONE;
-		if(convex)
+		DynamicArrayAuto<U32> indices(m_alloc);
+		indices.create(totalIndexCount);
+		U32 idxCount = 0;
+		U32 vertCount = 0;
+		for(const SubMesh& submesh : submeshes)
 		{
-			header.m_flags |= MeshBinaryFlag::CONVEX;
-		}
-		header.m_indexType = IndexType::U16;
-		header.m_totalIndexCount = totalIndexCount;
-		header.m_totalVertexCount = totalVertexCount;
-		header.m_subMeshCount = U32(submeshes.getSize());
-		header.m_aabbMin = aabbMin;
-		header.m_aabbMax = aabbMax;
-	}
-
-	// Open file
-	File file;
-	ANKI_CHECK(file.open(fname.toCString(), FileOpenFlag::WRITE | FileOpenFlag::BINARY));
+			for(U32 i = 0; i < submesh.m_indices.getSize(); ++i)
+			{
+				const U32 idx = submesh.m_indices[i] + vertCount;
+				if(idx > MAX_U16)
+				{
+					ANKI_IMPORTER_LOGE("Only supports 16bit indices for now");
+					return Error::USER_DATA;
+				}
 
-	// Write header
-	ANKI_CHECK(file.write(&header, sizeof(header)));
+				indices[idxCount++] = idx;
+			}
 
-	// Write sub meshes
-	for(const SubMesh& in : submeshes)
-	{
-		MeshBinarySubMesh out;
-		out.m_firstIndex = in.m_firstIdx;
-		out.m_indexCount = in.m_idxCount;
-		out.m_aabbMin = in.m_aabbMin;
-		out.m_aabbMax = in.m_aabbMax;
+			vertCount += submesh.m_verts.getSize();
+		}
 
-		ANKI_CHECK(file.write(&out, sizeof(out)));
+		if(m_compressMeshes)
+		{
+			indexBuffer.create(meshopt_encodeIndexBufferBound(totalIndexCount, totalVertexCount));
+			indexBuffer.resize(
+				meshopt_encodeIndexBuffer(&indexBuffer[0], indexBuffer.getSize(), &indices[0], totalIndexCount));
+		}
+		else
+		{
+			indexBuffer.create(PtrSize(totalIndexCount) * sizeof(U16));
+			for(U32 i = 0; i < totalIndexCount; ++i)
+			{
+				const U16 idx = U16(indices[i]);
+				memcpy(&indexBuffer[PtrSize(i) * sizeof(U16)], &idx, sizeof(idx));
+			}
+		}
 	}
 
-	// Write indices
-	U32 vertCount = 0;
-	for(const SubMesh& submesh : submeshes)
+	// Gather the position vert buffer
+	DynamicArrayAuto<U8, PtrSize> positionBuffer(m_alloc);
+	if(m_quantizeMeshes)
 	{
-		DynamicArrayAuto<U16> indices(m_alloc);
-		indices.create(submesh.m_indices.getSize());
-		for(U32 i = 0; i < indices.getSize(); ++i)
+		const F32 scale = F32(MAX_U16) / header.m_vertexAttributes[VertexAttributeId::POSITION].m_scale;
+		DynamicArrayAuto<U16Vec4> positions(m_alloc);
+		positions.create(totalVertexCount);
+		U32 v = 0;
+		for(const SubMesh& submesh : submeshes)
 		{
-			const U32 idx = submesh.m_indices[i] + vertCount;
-			if(idx > MAX_U16)
+			for(const TempVertex& vert : submesh.m_verts)
 			{
-				ANKI_IMPORTER_LOGE("Only supports 16bit indices for now");
-				return Error::USER_DATA;
+				const Vec3 normalized = ((vert.m_position - aabbMin) * scale).max(Vec3(0.0f)).min(Vec3(F32(MAX_U16)));
+				positions[v++] = U16Vec4(U16(round(normalized.x())), U16(round(normalized.y())),
+										 U16(round(normalized.z())), 0);
 			}
-
-			indices[i] = U16(idx);
 		}
 
-		ANKI_CHECK(file.write(&indices[0], indices.getSizeInBytes()));
-		vertCount += submesh.m_verts.getSize();
+		storeVertexBufferForFile(&positions[0], totalVertexCount, sizeof(U16Vec4), m_compressMeshes, positionBuffer);
 	}
-
-	ANKI_CHECK(alignBufferInFile(header.m_totalIndexCount * sizeof(U16), file));
-
-	// Write position vert buffer
-	for(const SubMesh& submesh : submeshes)
+	else
 	{
 		DynamicArrayAuto<Vec3> positions(m_alloc);
-		positions.create(submesh.m_verts.getSize());
-		for(U32 v = 0; v < submesh.m_verts.getSize(); ++v)
+		positions.create(totalVertexCount);
+		U32 v = 0;
+		for(const SubMesh& submesh : submeshes)
 		{
-			positions[v] = submesh.m_verts[v].m_position;
+			for(const TempVertex& vert : submesh.m_verts)
+			{
+				positions[v++] = vert.m_position;
+			}
 		}
-		ANKI_CHECK(file.write(&positions[0], positions.getSizeInBytes()));
-	}
 
-	ANKI_CHECK(alignBufferInFile(header.m_totalVertexCount * sizeof(Vec3), file));
+		storeVertexBufferForFile(&positions[0], totalVertexCount, sizeof(Vec3), m_compressMeshes, positionBuffer);
+	}
 
-	// Write the 2nd vert buffer
-	for(const SubMesh& submesh : submeshes)
+	// Gather the 2nd vert buffer
+	DynamicArrayAuto<U8, PtrSize> mainBuffer(m_alloc);
 	{
 		DynamicArrayAuto<MainVertex> verts(m_alloc);
-		verts.create(submesh.m_verts.getSize());
-
-		for(U32 i = 0; i < verts.getSize(); ++i)
+		verts.create(totalVertexCount);
+		U32 v = 0;
+		for(const SubMesh& submesh : submeshes)
 		{
-			const Vec3& normal = submesh.m_verts[i].m_normal;
-			const Vec4& tangent = submesh.m_verts[i].m_tangent;
-			const Vec2& uv = submesh.m_verts[i].m_uv;
-
-			verts[i].m_normal = packColorToR10G10B10A2SNorm(normal.x(), normal.y(), normal.z(), 0.0f);
-			verts[i].m_tangent = packColorToR10G10B10A2SNorm(tangent.x(), tangent.y(), tangent.z(), tangent.w());
-			verts[i].m_uv0 = uv;
+			for(const TempVertex& vert : submesh.m_verts)
+			{
+				const Vec3& normal = vert.m_normal;
+				const Vec4& tangent = vert.m_tangent;
+				const Vec2& uv = vert.m_uv;
+
+				verts[v].m_normal = packColorToR10G10B10A2SNorm(normal.x(), normal.y(), normal.z(), 0.0f);
+				verts[v].m_tangent = packColorToR10G10B10A2SNorm(tangent.x(), tangent.y(), tangent.z(), tangent.w());
+				verts[v].m_uv0 = packHalf2x16(uv.x(), uv.y());
+				++v;
+			}
 		}
 
-		ANKI_CHECK(file.write(&verts[0], verts.getSizeInBytes()));
+		storeVertexBufferForFile(&verts[0], totalVertexCount, sizeof(MainVertex), m_compressMeshes, mainBuffer);
 	}
 
-	ANKI_CHECK(alignBufferInFile(header.m_totalVertexCount * sizeof(MainVertex), file));
-
-	// Write 3rd vert buffer
+	// Gather the 3rd vert buffer
+	DynamicArrayAuto<U8, PtrSize> boneBuffer(m_alloc);
 	if(hasBoneWeights)
 	{
+		DynamicArrayAuto<BoneInfoVertex> verts(m_alloc);
+		verts.create(totalVertexCount);
+		U32 v = 0;
 		for(const SubMesh& submesh : submeshes)
 		{
-			DynamicArrayAuto<BoneInfoVertex> verts(m_alloc);
-			verts.create(submesh.m_verts.getSize());
-
-			for(U32 i = 0; i < verts.getSize(); ++i)
+			for(const TempVertex& tempVert : submesh.m_verts)
 			{
 				BoneInfoVertex vert;
 
 				for(U32 c = 0; c < 4; ++c)
 				{
-					if(submesh.m_verts[i].m_boneIds[c] > 0XFF)
+					if(tempVert.m_boneIds[c] > 0XFF)
 					{
 						ANKI_IMPORTER_LOGE("Only 256 bones are supported");
 						return Error::USER_DATA;
 					}
 
-					vert.m_boneIndices[c] = U8(submesh.m_verts[i].m_boneIds[c]);
-					vert.m_boneWeights[c] = U8(submesh.m_verts[i].m_boneWeights[c] * F32(MAX_U8));
+					vert.m_boneIndices[c] = U8(tempVert.m_boneIds[c]);
+					vert.m_boneWeights[c] = U8(tempVert.m_boneWeights[c] * F32(MAX_U8));
 				}
 
-				verts[i] = vert;
+				verts[v++] = vert;
+			}
+		}
+
+		storeVertexBufferForFile(&verts[0], totalVertexCount, sizeof(BoneInfoVertex), m_compressMeshes, boneBuffer);
+	}
+
+	const Array<const DynamicArrayAuto<U8, PtrSize>*, 3> vertBuffers = {&positionBuffer, &mainBuffer, &boneBuffer};
+
+	// Write some other header stuff
+	{
+		memcpy(&header.m_magic[0], MESH_MAGIC, 8);
+		header.m_flags = MeshBinaryFlag::NONE;
+		if(convex)
+		{
+			header.m_flags |= MeshBinaryFlag::CONVEX;
+		}
+		header.m_indexType = IndexType::U16;
+		header.m_totalIndexCount = totalIndexCount;
+		header.m_totalVertexCount = totalVertexCount;
+		header.m_subMeshCount = U32(submeshes.getSize());
+		header.m_aabbMin = aabbMin;
+		header.m_aabbMax = aabbMax;
+
+		for(const SubMesh& submesh : submeshes)
+		{
+			header.m_meshletCount += submesh.m_meshlets.getSize();
+		}
+
+		if(m_compressMeshes)
+		{
+			header.m_flags |= MeshBinaryFlag::COMPRESSED;
+			header.m_compressedIndexBufferSize = U32(indexBuffer.getSize());
+			for(U32 i = 0; i < header.m_vertexBufferCount; ++i)
+			{
+				header.m_compressedVertexBufferSizes[i] = U32(vertBuffers[i]->getSize());
 			}
+		}
+	}
+
+	// Open file
+	File file;
+	ANKI_CHECK(file.open(fname.toCString(), FileOpenFlag::WRITE | FileOpenFlag::BINARY));
 
-			ANKI_CHECK(file.write(&verts[0], verts.getSizeInBytes()));
+	// Write header
+	ANKI_CHECK(file.write(&header, sizeof(header)));
+
+	// Write sub meshes
+	for(const SubMesh& in : submeshes)
+	{
+		MeshBinarySubMesh out;
+		out.m_firstIndex = in.m_firstIdx;
+		out.m_indexCount = in.m_idxCount;
+		out.m_aabbMin = in.m_aabbMin;
+		out.m_aabbMax = in.m_aabbMax;
+
+		ANKI_CHECK(file.write(&out, sizeof(out)));
+	}
+
+	// Write the meshlets. Enlarge the spheres a bit since the quantized positions move a little
+	const F32 sphereRadiusBias =
+		(m_quantizeMeshes) ? header.m_vertexAttributes[VertexAttributeId::POSITION].m_scale / F32(MAX_U16) : 0.0f;
+	for(const SubMesh& submesh : submeshes)
+	{
+		for(MeshBinaryMeshlet meshlet : submesh.m_meshlets)
+		{
+			meshlet.m_firstIndex += submesh.m_firstIdx;
+			meshlet.m_sphereRadius += sphereRadiusBias;
+			ANKI_CHECK(file.write(&meshlet, sizeof(meshlet)));
 		}
+	}
 
-		ANKI_CHECK(alignBufferInFile(header.m_totalVertexCount * sizeof(BoneInfoVertex), file));
+	// Write indices
+	ANKI_CHECK(file.write(&indexBuffer[0], indexBuffer.getSizeInBytes()));
+	ANKI_CHECK(alignBufferInFile(indexBuffer.getSizeInBytes(), file));
+
+	// Write the vert buffers
+	for(U32 i = 0; i < header.m_vertexBufferCount; ++i)
+	{
+		ANKI_CHECK(file.write(&(*vertBuffers[i])[0], vertBuffers[i]->getSizeInBytes()));
+		ANKI_CHECK(alignBufferInFile(vertBuffers[i]->getSizeInBytes(), file));
 	}
 
 	return Error::NONE;
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <AnKi/Util/Functions.h>
+#include <AnKi/Util/F16.h>
 #include <cmath>
 #include <cstdlib>
 
@@ -242,6 +243,12 @@ inline U32 packColorToR10G10B10A2SNorm(F32 r, F32 g, F32 b, F32 a)
 	return out.m_packed;
 }
 
+/// Pack 2 floats to halfs the same way GLSL's packHalf2x16 does. The x goes to the least significant bits.
+inline U32 packHalf2x16(F32 x, F32 y)
+{
+	return U32(F16(x).toU16()) | (U32(F16(y).toU16()) << 16u);
+}
+
 /// Compute the abs triangle area.
 template<typename TVec>
 inline F32 computeTriangleArea(const TVec& a, const TVec& b, const TVec& c)
@@ -0,0 +1,7 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+ANKI_CONFIG_OPTION(physics_maxSubSteps, 4, 1, 64, "Max number of fixed steps the physics world does per frame")
+ANKI_CONFIG_OPTION(physics_fixedTimeStep, 1.0 / 60.0, 1.0 / 1000.0, 1.0, "The time step of the physics simulation")
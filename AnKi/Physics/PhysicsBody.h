@@ -37,7 +37,9 @@ public:
 	void setTransform(const Transform& trf)
 	{
 		m_trf = trf;
-		m_body->setWorldTransform(toBt(trf));
+		const btTransform btTrf = toBt(trf);
+		m_body->setWorldTransform(btTrf);
+		m_body->setInterpolationWorldTransform(btTrf); // Don't interpolate from the old transform
 	}
 
 	void applyForce(const Vec3& force, const Vec3& relPos)
@@ -10,19 +10,10 @@ namespace anki {
 
 PhysicsFilteredObject::~PhysicsFilteredObject()
 {
-	for(PhysicsTriggerFilteredPair* pair : m_triggerFilteredPairs)
+	if(m_triggerPairCount.load() > 0)
 	{
-		if(pair == nullptr)
-		{
-			continue;
-		}
-
-		pair->m_filteredObject = nullptr;
-
-		if(pair->shouldDelete())
-		{
-			getAllocator().deleteInstance(pair);
-		}
+		// Died while inside some triggers
+		getWorld().forgetTriggerPairs(this);
 	}
 }
 
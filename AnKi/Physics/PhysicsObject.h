@@ -117,30 +117,12 @@ public:
 	virtual Bool needsCollision(const PhysicsFilteredObject& a, const PhysicsFilteredObject& b) = 0;
 };
 
-/// A pair of a trigger and a filtered object.
-class PhysicsTriggerFilteredPair
-{
-public:
-	PhysicsFilteredObject* m_filteredObject = nullptr;
-	PhysicsTrigger* m_trigger = nullptr;
-	U64 m_frame = 0;
-
-	Bool isAlive() const
-	{
-		return m_filteredObject && m_trigger;
-	}
-
-	Bool shouldDelete() const
-	{
-		return m_filteredObject == nullptr && m_trigger == nullptr;
-	}
-};
-
 /// A PhysicsObject that takes part into collision detection. Has functionality to filter the broad phase detection.
 class PhysicsFilteredObject : public PhysicsObject
 {
 public:
 	ANKI_PHYSICS_OBJECT_FRIENDS
+	friend class PhysicsTrigger;
 
 	PhysicsFilteredObject(PhysicsObjectType type, PhysicsWorld* world)
 		: PhysicsObject(type, world)
@@ -197,8 +179,8 @@ private:
 
 	PhysicsBroadPhaseFilterCallback* m_filter = nullptr;
 
-	static constexpr U32 MAX_TRIGGER_FILTERED_PAIRS = 4;
-	Array<PhysicsTriggerFilteredPair*, MAX_TRIGGER_FILTERED_PAIRS> m_triggerFilteredPairs = {};
+	/// The number of triggers it's inside. The triggers update it in parallel.
+	Atomic<U32> m_triggerPairCount = {0};
 };
 /// @}
 
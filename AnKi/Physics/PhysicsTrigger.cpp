@@ -30,18 +30,7 @@ PhysicsTrigger::PhysicsTrigger(PhysicsWorld* world, PhysicsCollisionShapePtr sha
 
 PhysicsTrigger::~PhysicsTrigger()
 {
-	for(PhysicsTriggerFilteredPair* pair : m_pairs)
-	{
-		ANKI_ASSERT(pair);
-
-		pair->m_trigger = nullptr;
-
-		if(pair->shouldDelete())
-		{
-			getAllocator().deleteInstance(pair);
-		}
-	}
-
+	// Don't touch the filtered objects, some of them might be already dead if they were deleted in the same frame
 	m_pairs.destroy(getAllocator());
 
 	m_ghostShape.destroy();
@@ -63,71 +52,78 @@ void PhysicsTrigger::processContacts()
 
 	if(m_contactCallback == nullptr)
 	{
-		m_pairs.destroy(getAllocator());
+		clearPairs();
 		return;
 	}
 
-	// Gather the new pairs
-	DynamicArrayAuto<PhysicsTriggerFilteredPair*> newPairs(getWorld().getTempAllocator());
-	newPairs.resizeStorage(m_ghostShape->getOverlappingPairs().size());
-	for(U32 i = 0; i < U32(m_ghostShape->getOverlappingPairs().size()); ++i)
+	// Find the objects that entered or are still inside
+	const btBroadphaseProxy* triggerProxy = m_ghostShape->getBroadphaseHandle();
+	const btAlignedObjectArray<btCollisionObject*>& overlappingObjs = m_ghostShape->getOverlappingPairs();
+	for(I32 i = 0; i < overlappingObjs.size(); ++i)
 	{
-		btCollisionObject* bobj = m_ghostShape->getOverlappingPairs()[i];
+		btCollisionObject* bobj = overlappingObjs[i];
 		ANKI_ASSERT(bobj);
+
+		// The broadphase removes the pairs that stopped overlapping lazily so test the bounding volumes again
+		const btBroadphaseProxy* proxy = bobj->getBroadphaseHandle();
+		if(!TestAabbAgainstAabb2(triggerProxy->m_aabbMin, triggerProxy->m_aabbMax, proxy->m_aabbMin, proxy->m_aabbMax))
+		{
+			continue;
+		}
 		PhysicsObject* aobj = static_cast<PhysicsObject*>(bobj->getUserPointer());
 		ANKI_ASSERT(aobj);
 		PhysicsFilteredObject* obj = dcast<PhysicsFilteredObject*>(aobj);
 
-		Bool isNew;
-		PhysicsTriggerFilteredPair* pair = getWorld().getOrCreatePhysicsTriggerFilteredPair(this, obj, isNew);
-		if(pair)
+		auto it = m_pairs.find(ptrToNumber(obj));
+		if(it == m_pairs.getEnd())
+		{
+			m_pairs.emplace(getAllocator(), ptrToNumber(obj), obj, m_processContactsFrame);
+			obj->m_triggerPairCount.fetchAdd(1);
+			m_contactCallback->onTriggerEnter(*this, *obj);
+		}
+		else
 		{
-			ANKI_ASSERT(pair->isAlive());
-			newPairs.emplaceBack(pair);
-
-			if(isNew)
-			{
-				m_contactCallback->onTriggerEnter(*this, *obj);
-			}
-			else
-			{
-				m_contactCallback->onTriggerInside(*this, *obj);
-			}
-
-			pair->m_frame = m_processContactsFrame;
+			ANKI_ASSERT(it->m_filteredObject == obj);
+			it->m_frame = m_processContactsFrame;
+			m_contactCallback->onTriggerInside(*this, *obj);
 		}
 	}
 
-	// Remove stale pairs
-	for(U32 i = 0; i < m_pairs.getSize(); ++i)
+	// The pairs that were not found this frame exited. Erase them after the iteration
+	DynamicArrayAuto<U64> exitedKeys(getWorld().getTempAllocator());
+	for(const Pair& pair : m_pairs)
 	{
-		PhysicsTriggerFilteredPair* pair = m_pairs[i];
-		ANKI_ASSERT(pair->m_trigger == this);
-
-		if(pair->m_filteredObject == nullptr)
-		{
-			// Filtered object died while inside the tigger, destroy the pair
-			getAllocator().deleteInstance(pair);
-		}
-		else if(pair->m_frame == m_processContactsFrame)
+		if(pair.m_frame != m_processContactsFrame)
 		{
-			// Was updated this frame so don't touch it
-		}
-		else
-		{
-			// Was updated in some previous frame, notify and brake the link to the pair
-			ANKI_ASSERT(pair->isAlive());
-			ANKI_ASSERT(pair->m_frame < m_processContactsFrame);
-			m_contactCallback->onTriggerExit(*this, *pair->m_filteredObject);
-			pair->m_trigger = nullptr;
+			ANKI_ASSERT(pair.m_frame < m_processContactsFrame);
+			exitedKeys.emplaceBack(ptrToNumber(pair.m_filteredObject));
+			pair.m_filteredObject->m_triggerPairCount.fetchSub(1);
+			m_contactCallback->onTriggerExit(*this, *pair.m_filteredObject);
 		}
 	}
 
-	// Store the new contacts
-	m_pairs.resize(getAllocator(), newPairs.getSize());
-	if(m_pairs.getSize())
+	for(U64 key : exitedKeys)
+	{
+		m_pairs.erase(getAllocator(), m_pairs.find(key));
+	}
+}
+
+void PhysicsTrigger::clearPairs()
+{
+	for(const Pair& pair : m_pairs)
+	{
+		pair.m_filteredObject->m_triggerPairCount.fetchSub(1);
+	}
+
+	m_pairs.destroy(getAllocator());
+}
+
+void PhysicsTrigger::forgetPair(const PhysicsFilteredObject* filtered)
+{
+	auto it = m_pairs.find(ptrToNumber(filtered));
+	if(it != m_pairs.getEnd())
 	{
-		memcpy(&m_pairs[0], &newPairs[0], m_pairs.getSizeInBytes());
+		m_pairs.erase(getAllocator(), it);
 	}
 }
 
@@ -37,6 +37,7 @@ public:
 };
 
 /// A trigger that uses a PhysicsShape and its purpose is to collect collision events.
+/// @note The triggers are processed in parallel so the callbacks of different triggers may run at the same time.
 class PhysicsTrigger : public PhysicsFilteredObject
 {
 	ANKI_PHYSICS_OBJECT(PhysicsObjectType::TRIGGER)
@@ -58,10 +59,34 @@ public:
 	}
 
 private:
+	/// A filtered object that is inside the trigger.
+	class Pair
+	{
+	public:
+		PhysicsFilteredObject* m_filteredObject;
+		U64 m_frame; ///< The last frame the object was found inside. If it's not the current the object exited.
+
+		Pair(PhysicsFilteredObject* filteredObject, U64 frame)
+			: m_filteredObject(filteredObject)
+			, m_frame(frame)
+		{
+		}
+	};
+
+	/// The pairs are keyed by the address of the filtered object. Hash it since the low bits of addresses are zero.
+	class PairHasher
+	{
+	public:
+		U64 operator()(const U64 a) const
+		{
+			return computeHash(&a, sizeof(a));
+		}
+	};
+
 	PhysicsCollisionShapePtr m_shape;
 	ClassWrapper<btGhostObject> m_ghostShape;
 
-	DynamicArray<PhysicsTriggerFilteredPair*> m_pairs;
+	HashMap<U64, Pair, PairHasher> m_pairs;
 
 	PhysicsTriggerProcessContactCallback* m_contactCallback = nullptr;
 
@@ -76,6 +101,12 @@ private:
 	void unregisterFromWorld() override;
 
 	void processContacts();
+
+	/// Remove all the pairs without calling the callbacks.
+	void clearPairs();
+
+	/// Remove the pair of an object that died without calling the callbacks.
+	void forgetPair(const PhysicsFilteredObject* filtered);
 };
 /// @}
 
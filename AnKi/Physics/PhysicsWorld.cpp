@@ -9,6 +9,8 @@
 #include <AnKi/Physics/PhysicsTrigger.h>
 #include <AnKi/Physics/PhysicsPlayerController.h>
 #include <AnKi/Util/Rtti.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/Tracer.h>
 #include <BulletCollision/Gimpact/btGImpactCollisionAlgorithm.h>
 
 namespace anki {
@@ -139,6 +141,266 @@ public:
 	}
 };
 
+/// Checks the material of the objects that PhysicsWorld::query() finds.
+static Bool queryNeedsCollision(const btBroadphaseProxy* proxy, PhysicsMaterialBit materialMask)
+{
+	ANKI_ASSERT(proxy);
+
+	const btCollisionObject* cobj = static_cast<const btCollisionObject*>(proxy->m_clientObject);
+	ANKI_ASSERT(cobj);
+
+	const PhysicsObject* pobj = static_cast<const PhysicsObject*>(cobj->getUserPointer());
+	if(pobj == nullptr)
+	{
+		// It's the object of an overlap query
+		return false;
+	}
+
+	const PhysicsFilteredObject* fobj = dcast<const PhysicsFilteredObject*>(pobj);
+	return !!(fobj->getMaterialGroup() & materialMask);
+}
+
+static PhysicsFilteredObject* toPhysicsFilteredObject(const btCollisionObject* cobj)
+{
+	ANKI_ASSERT(cobj && cobj->getUserPointer());
+	return &dcast<PhysicsFilteredObject&>(*static_cast<PhysicsObject*>(cobj->getUserPointer()));
+}
+
+class QueryRayCallback : public btCollisionWorld::ClosestRayResultCallback
+{
+public:
+	PhysicsMaterialBit m_materialMask;
+
+	QueryRayCallback(const btVector3& from, const btVector3& to, PhysicsMaterialBit materialMask)
+		: ClosestRayResultCallback(from, to)
+		, m_materialMask(materialMask)
+	{
+	}
+
+	Bool needsCollision(btBroadphaseProxy* proxy) const override
+	{
+		return queryNeedsCollision(proxy, m_materialMask);
+	}
+};
+
+class QuerySweepCallback : public btCollisionWorld::ClosestConvexResultCallback
+{
+public:
+	PhysicsMaterialBit m_materialMask;
+
+	QuerySweepCallback(const btVector3& from, const btVector3& to, PhysicsMaterialBit materialMask)
+		: ClosestConvexResultCallback(from, to)
+		, m_materialMask(materialMask)
+	{
+	}
+
+	Bool needsCollision(btBroadphaseProxy* proxy) const override
+	{
+		return queryNeedsCollision(proxy, m_materialMask);
+	}
+};
+
+class QueryOverlapCallback : public btCollisionWorld::ContactResultCallback
+{
+public:
+	const btCollisionObject* m_queryObject;
+	PhysicsMaterialBit m_materialMask;
+	PhysicsWorldQueryResult* m_result;
+
+	QueryOverlapCallback(const btCollisionObject* queryObject, PhysicsMaterialBit materialMask,
+						 PhysicsWorldQueryResult* result)
+		: m_queryObject(queryObject)
+		, m_materialMask(materialMask)
+		, m_result(result)
+	{
+	}
+
+	Bool needsCollision(btBroadphaseProxy* proxy) const override
+	{
+		// Stop at the 1st overlap
+		return m_result->m_object == nullptr && queryNeedsCollision(proxy, m_materialMask);
+	}
+
+	btScalar addSingleResult(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0,
+							 int index0, const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) override
+	{
+		(void)partId0;
+		(void)index0;
+		(void)partId1;
+		(void)index1;
+
+		if(m_result->m_object == nullptr)
+		{
+			const Bool swapped = colObj0Wrap->getCollisionObject() != m_queryObject;
+			const btCollisionObject* other =
+				(swapped) ? colObj0Wrap->getCollisionObject() : colObj1Wrap->getCollisionObject();
+			m_result->m_object = toPhysicsFilteredObject(other);
+			m_result->m_worldPosition = toAnki((swapped) ? cp.getPositionWorldOnA() : cp.getPositionWorldOnB());
+			m_result->m_worldNormal = toAnki((swapped) ? -cp.m_normalWorldOnB : cp.m_normalWorldOnB);
+			m_result->m_hitFraction = 0.0f;
+		}
+
+		return 0.0f;
+	}
+};
+
+/// The context of PhysicsWorld::query() when it runs in many threads.
+class PhysicsWorld::QueryCtx
+{
+public:
+	static constexpr U32 QUERIES_PER_BLOCK = 64;
+
+	const PhysicsWorld* m_world = nullptr;
+	ConstWeakArray<PhysicsWorldQuery> m_queries;
+	WeakArray<PhysicsWorldQueryResult> m_results;
+	U32 m_blockCount = 0;
+	Atomic<U32> m_crntBlock = {0};
+	Atomic<U32> m_doneBlockCount = {0};
+};
+
+/// The context of the parallel PhysicsWorld::processTriggerContacts().
+class PhysicsWorld::TriggerCtx
+{
+public:
+	static constexpr U32 TRIGGERS_PER_BLOCK = 16;
+
+	WeakArray<PhysicsTrigger*> m_triggers;
+	U32 m_blockCount = 0;
+	Atomic<U32> m_crntBlock = {0};
+};
+
+/// Runs Bullet's parallel loops in the threads of the ThreadHive. The calling thread runs the 1st part of the loop and
+/// the hive threads the rest.
+class PhysicsWorld::MyTaskScheduler : public btITaskScheduler
+{
+public:
+	HeapAllocator<U8> m_alloc; ///< The allocator it was allocated with. It may outlive the world that created it.
+	ThreadHive* m_hive;
+
+	MyTaskScheduler(HeapAllocator<U8> alloc, ThreadHive* hive)
+		: btITaskScheduler("AnKi")
+		, m_alloc(alloc)
+		, m_hive(hive)
+	{
+	}
+
+	int getMaxNumThreads() const override
+	{
+		return (m_hive) ? I32(m_hive->getThreadCount() + 1) : 1;
+	}
+
+	int getNumThreads() const override
+	{
+		return getMaxNumThreads();
+	}
+
+	void setNumThreads(int numThreads) override
+	{
+		// The threads are owned by the hive
+		(void)numThreads;
+	}
+
+	void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+	{
+		ParallelCtx ctx;
+		ctx.m_forBody = &body;
+		run(iBegin, iEnd, grainSize, ctx);
+	}
+
+	btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+	{
+		ParallelCtx ctx;
+		ctx.m_sumBody = &body;
+		const U32 partCount = run(iBegin, iEnd, grainSize, ctx);
+
+		// Add in a fixed order to keep it deterministic
+		btScalar sum = 0.0f;
+		for(U32 i = 0; i < partCount; ++i)
+		{
+			sum += ctx.m_sums[i];
+		}
+		return sum;
+	}
+
+private:
+	static constexpr U32 MAX_PARTS = ThreadHive::MAX_THREADS + 1;
+
+	Atomic<Bool> m_running = {false}; ///< True while the hive runs a loop.
+
+	class ParallelCtx
+	{
+	public:
+		const btIParallelForBody* m_forBody = nullptr;
+		const btIParallelSumBody* m_sumBody = nullptr;
+		Array<I32, MAX_PARTS + 1> m_partBounds;
+		Array<btScalar, MAX_PARTS> m_sums;
+
+		void runPart(U32 part)
+		{
+			const I32 begin = m_partBounds[part];
+			const I32 end = m_partBounds[part + 1];
+			if(m_forBody)
+			{
+				m_forBody->forLoop(begin, end);
+			}
+			else
+			{
+				m_sums[part] = m_sumBody->sumLoop(begin, end);
+			}
+		}
+	};
+
+	class PartTask
+	{
+	public:
+		ParallelCtx* m_ctx;
+		U32 m_part;
+	};
+
+	/// @return The number of parts the loop was split to.
+	U32 run(I32 iBegin, I32 iEnd, I32 grainSize, ParallelCtx& ctx)
+	{
+		const I32 count = iEnd - iBegin;
+		const I32 partCount = (m_running.load() || count <= 0)
+								  ? 1
+								  : clamp((count + grainSize - 1) / max(grainSize, 1), 1, getNumThreads());
+		ANKI_ASSERT(partCount <= I32(MAX_PARTS));
+
+		for(I32 i = 0; i <= partCount; ++i)
+		{
+			ctx.m_partBounds[i] = iBegin + I32(I64(count) * i / partCount);
+		}
+
+		if(partCount == 1)
+		{
+			// Too small or nested in another parallel loop, run it here
+			ctx.runPart(0);
+			return 1;
+		}
+
+		m_running.store(true);
+
+		Array<PartTask, MAX_PARTS> parts;
+		Array<ThreadHiveTask, MAX_PARTS> tasks;
+		for(I32 i = 1; i < partCount; ++i)
+		{
+			parts[i] = {&ctx, U32(i)};
+			tasks[i - 1] = ANKI_THREAD_HIVE_TASK({ self->m_ctx->runPart(self->m_part); }, &parts[i], nullptr, nullptr);
+		}
+		m_hive->submitTasks(&tasks[0], U32(partCount - 1));
+
+		ctx.runPart(0);
+		m_hive->waitAllTasks();
+
+		m_running.store(false);
+		return U32(partCount);
+	}
+};
+
+PhysicsWorld::MyTaskScheduler* PhysicsWorld::m_taskScheduler = nullptr;
+U32 PhysicsWorld::m_taskSchedulerRefcount = 0;
+Mutex PhysicsWorld::m_taskSchedulerMtx;
+
 PhysicsWorld::PhysicsWorld()
 {
 }
@@ -151,19 +413,32 @@ PhysicsWorld::~PhysicsWorld()
 
 	m_world.destroy();
 	m_solver.destroy();
+	m_solverPool.destroy();
 	m_dispatcher.destroy();
 	m_collisionConfig.destroy();
 	m_broadphase.destroy();
 	m_gpc.destroy();
 	m_alloc.deleteInstance(m_filterCallback);
 
+	{
+		LockGuard<Mutex> lock(m_taskSchedulerMtx);
+		ANKI_ASSERT(m_taskSchedulerRefcount > 0);
+		if(--m_taskSchedulerRefcount == 0)
+		{
+			btSetTaskScheduler(nullptr);
+			HeapAllocator<U8> alloc = m_taskScheduler->m_alloc;
+			alloc.deleteInstance(m_taskScheduler);
+			m_taskScheduler = nullptr;
+		}
+	}
+
 	g_alloc = nullptr;
 }
 
-Error PhysicsWorld::init(AllocAlignedCallback allocCb, void* allocCbData)
+Error PhysicsWorld::init(AllocAlignedCallback allocCb, void* allocCbData, ThreadHive* hive)
 {
-	m_alloc = HeapAllocator<U8>(allocCb, allocCbData);
-	m_tmpAlloc = StackAllocator<U8>(allocCb, allocCbData, 1_KB, 2.0f);
+	m_alloc = HeapAllocator<U8>(allocCb, allocCbData, "Physics");
+	m_tmpAlloc = StackAllocator<U8>(allocCb, allocCbData, 1_KB, 2.0f, 0, true, ANKI_SAFE_ALIGNMENT, "PhysicsTmp");
 
 	// Set allocators
 	g_alloc = &m_alloc;
@@ -181,9 +456,24 @@ Error PhysicsWorld::init(AllocAlignedCallback allocCb, void* allocCbData)
 	m_dispatcher.init(m_collisionConfig.get());
 	btGImpactCollisionAlgorithm::registerAlgorithm(m_dispatcher.get());
 
+	m_hive = hive;
+
+	// The multithreaded world works the same as the regular one if there are no threads
+	U32 maxThreadCount;
+	{
+		LockGuard<Mutex> lock(m_taskSchedulerMtx);
+		if(m_taskSchedulerRefcount++ == 0)
+		{
+			m_taskScheduler = m_alloc.newInstance<MyTaskScheduler>(m_alloc, hive);
+			btSetTaskScheduler(m_taskScheduler);
+		}
+		maxThreadCount = U32(m_taskScheduler->getMaxNumThreads());
+	}
+
+	m_solverPool.init(maxThreadCount);
 	m_solver.init();
 
-	m_world.init(m_dispatcher.get(), m_broadphase.get(), m_solver.get(), m_collisionConfig.get());
+	m_world.init(m_dispatcher.get(), m_broadphase.get(), m_solverPool.get(), m_solver.get(), m_collisionConfig.get());
 	m_world->setGravity(btVector3(0.0f, -9.8f, 0.0f));
 
 	return Error::NONE;
@@ -249,15 +539,15 @@ Error PhysicsWorld::update(Second dt)
 		playerController.moveToPositionForReal();
 	}
 
-	// Update world
-	m_world->stepSimulation(F32(dt), 1, 1.0f / 60.0f);
-
-	// Process trigger contacts
-	for(PhysicsObject& trigger : m_objectLists[PhysicsObjectType::TRIGGER])
+	// Update world. Bullet will interpolate the transforms it passes to the motion states of the bodies
 	{
-		static_cast<PhysicsTrigger&>(trigger).processContacts();
+		ANKI_TRACE_SCOPED_EVENT(PHYSICS_STEP);
+		m_world->stepSimulation(F32(dt), I32(m_maxSubSteps), F32(m_fixedTimeStep));
 	}
 
+	// Process trigger contacts
+	processTriggerContacts();
+
 	// Reset the pool
 	m_tmpAlloc.getMemoryPool().reset();
 
@@ -289,58 +579,193 @@ void PhysicsWorld::rayCast(WeakArray<PhysicsWorldRayCastCallback*> rayCasts) con
 	}
 }
 
-PhysicsTriggerFilteredPair* PhysicsWorld::getOrCreatePhysicsTriggerFilteredPair(PhysicsTrigger* trigger,
-																				PhysicsFilteredObject* filtered,
-																				Bool& isNew)
+void PhysicsWorld::query(ConstWeakArray<PhysicsWorldQuery> queries, WeakArray<PhysicsWorldQueryResult> results) const
+{
+	ANKI_ASSERT(queries.getSize() == results.getSize());
+	const U32 blockCount = (queries.getSize() + QueryCtx::QUERIES_PER_BLOCK - 1) / QueryCtx::QUERIES_PER_BLOCK;
+
+	if(m_hive == nullptr || blockCount <= 1)
+	{
+		for(U32 i = 0; i < queries.getSize(); ++i)
+		{
+			runQuery(queries[i], results[i]);
+		}
+		return;
+	}
+
+	QueryCtx* ctx = ::new(m_hive->allocateScratchMemory(sizeof(QueryCtx), alignof(QueryCtx))) QueryCtx();
+	ctx->m_world = this;
+	ctx->m_queries = queries;
+	ctx->m_results = results;
+	ctx->m_blockCount = blockCount;
+
+	const U32 helperCount = min(blockCount - 1, m_hive->getThreadCount());
+	Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+	for(U32 i = 0; i < helperCount; ++i)
+	{
+		tasks[i] = ANKI_THREAD_HIVE_TASK({ PhysicsWorld::runQueryTasks(*self); }, ctx, nullptr, nullptr);
+	}
+	m_hive->submitTasks(&tasks[0], helperCount);
+
+	// Help and then wait for the blocks that the other threads took. Don't wait for the tasks since this might run in a
+	// ThreadHive task
+	runQueryTasks(*ctx);
+	while(ctx->m_doneBlockCount.load(AtomicMemoryOrder::ACQUIRE) < blockCount)
+	{
+		std::this_thread::yield();
+	}
+}
+
+void PhysicsWorld::runQueryTasks(QueryCtx& ctx)
+{
+	U32 blockIdx;
+	while((blockIdx = ctx.m_crntBlock.fetchAdd(1)) < ctx.m_blockCount)
+	{
+		const U32 begin = blockIdx * QueryCtx::QUERIES_PER_BLOCK;
+		const U32 end = min(ctx.m_queries.getSize(), begin + QueryCtx::QUERIES_PER_BLOCK);
+		for(U32 i = begin; i < end; ++i)
+		{
+			ctx.m_world->runQuery(ctx.m_queries[i], ctx.m_results[i]);
+		}
+
+		ctx.m_doneBlockCount.fetchAdd(1, AtomicMemoryOrder::RELEASE);
+	}
+}
+
+void PhysicsWorld::runQuery(const PhysicsWorldQuery& query, PhysicsWorldQueryResult& result) const
 {
-	ANKI_ASSERT(trigger && filtered);
+	result = PhysicsWorldQueryResult();
+	const btVector3 from = toBt(query.m_from);
+	const btVector3 to = toBt(query.m_to);
 
-	U32 emptySlot = MAX_U32;
-	for(U32 i = 0; i < filtered->m_triggerFilteredPairs.getSize(); ++i)
+	switch(query.m_type)
+	{
+	case PhysicsWorldQueryType::RAY:
+	{
+		QueryRayCallback callback(from, to, query.m_materialMask);
+		m_world->rayTest(from, to, callback);
+		if(callback.hasHit())
+		{
+			result.m_object = toPhysicsFilteredObject(callback.m_collisionObject);
+			result.m_worldPosition = toAnki(callback.m_hitPointWorld);
+			result.m_worldNormal = toAnki(callback.m_hitNormalWorld);
+			result.m_hitFraction = callback.m_closestHitFraction;
+		}
+		break;
+	}
+	case PhysicsWorldQueryType::SPHERE_SWEEP:
+	case PhysicsWorldQueryType::CONVEX_SWEEP:
 	{
-		PhysicsTriggerFilteredPair* pair = filtered->m_triggerFilteredPairs[i];
+		btSphereShape sphere(query.m_radius);
+		const btCollisionShape* shape;
+		if(query.m_type == PhysicsWorldQueryType::SPHERE_SWEEP)
+		{
+			shape = &sphere;
+		}
+		else
+		{
+			ANKI_ASSERT(query.m_shape);
+			shape = query.m_shape->getBtShape();
+			ANKI_ASSERT(shape->isConvex());
+		}
 
-		if(pair && pair->m_trigger == trigger)
+		QuerySweepCallback callback(from, to, query.m_materialMask);
+		m_world->convexSweepTest(static_cast<const btConvexShape*>(shape),
+								 btTransform(btMatrix3x3::getIdentity(), from),
+								 btTransform(btMatrix3x3::getIdentity(), to), callback);
+		if(callback.hasHit())
 		{
-			// Found it
-			ANKI_ASSERT(pair->m_filteredObject == filtered);
-			isNew = false;
-			return pair;
+			result.m_object = toPhysicsFilteredObject(callback.m_hitCollisionObject);
+			result.m_worldPosition = toAnki(callback.m_hitPointWorld);
+			result.m_worldNormal = toAnki(callback.m_hitNormalWorld);
+			result.m_hitFraction = callback.m_closestHitFraction;
 		}
-		else if(pair == nullptr)
+		break;
+	}
+	case PhysicsWorldQueryType::SPHERE_OVERLAP:
+	case PhysicsWorldQueryType::SHAPE_OVERLAP:
+	{
+		btSphereShape sphere(query.m_radius);
+		btCollisionObject obj;
+		if(query.m_type == PhysicsWorldQueryType::SPHERE_OVERLAP)
 		{
-			// Empty slot, save it for later
-			emptySlot = i;
+			obj.setCollisionShape(&sphere);
 		}
-		else if(pair && pair->m_trigger == nullptr)
+		else
 		{
-			// Pair exists but it's invalid, repurpose it
-			ANKI_ASSERT(pair->m_filteredObject == filtered);
-			emptySlot = i;
+			ANKI_ASSERT(query.m_shape);
+			obj.setCollisionShape(query.m_shape->getBtShape());
 		}
+		obj.setWorldTransform(btTransform(btMatrix3x3::getIdentity(), from));
+
+		QueryOverlapCallback callback(&obj, query.m_materialMask, &result);
+		// contactTest() is not const but it doesn't change the world
+		const_cast<btDiscreteDynamicsWorldMt&>(*m_world).contactTest(&obj, callback);
+		break;
 	}
+	default:
+		ANKI_ASSERT(0);
+	}
+}
 
-	if(emptySlot == MAX_U32)
+void PhysicsWorld::forgetTriggerPairs(const PhysicsFilteredObject* filtered)
+{
+	LockGuard<Mutex> lock(m_markedMtx);
+	for(PhysicsObject& trigger : m_objectLists[PhysicsObjectType::TRIGGER])
 	{
-		ANKI_PHYS_LOGW("Contact ignored. Too many active contacts for the filtered object");
-		return nullptr;
+		static_cast<PhysicsTrigger&>(trigger).forgetPair(filtered);
 	}
+}
 
-	// Not found, create a new one
-	isNew = true;
+void PhysicsWorld::processTriggerContacts()
+{
+	ANKI_TRACE_SCOPED_EVENT(PHYSICS_TRIGGERS);
 
-	PhysicsTriggerFilteredPair* newPair;
-	if(filtered->m_triggerFilteredPairs[emptySlot] == nullptr)
+	DynamicArrayAuto<PhysicsTrigger*> triggers(m_tmpAlloc);
+	for(PhysicsObject& trigger : m_objectLists[PhysicsObjectType::TRIGGER])
 	{
-		filtered->m_triggerFilteredPairs[emptySlot] = m_alloc.newInstance<PhysicsTriggerFilteredPair>();
+		triggers.emplaceBack(static_cast<PhysicsTrigger*>(&trigger));
 	}
-	newPair = filtered->m_triggerFilteredPairs[emptySlot];
 
-	newPair->m_filteredObject = filtered;
-	newPair->m_trigger = trigger;
-	newPair->m_frame = 0;
+	const U32 blockCount = (triggers.getSize() + TriggerCtx::TRIGGERS_PER_BLOCK - 1) / TriggerCtx::TRIGGERS_PER_BLOCK;
+	if(m_hive == nullptr || blockCount <= 1)
+	{
+		for(PhysicsTrigger* trigger : triggers)
+		{
+			trigger->processContacts();
+		}
+		return;
+	}
 
-	return newPair;
+	// Every trigger has its own pairs so they can be processed in parallel
+	TriggerCtx ctx;
+	ctx.m_triggers = WeakArray<PhysicsTrigger*>(triggers);
+	ctx.m_blockCount = blockCount;
+
+	const U32 helperCount = min(blockCount - 1, m_hive->getThreadCount());
+	Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+	for(U32 i = 0; i < helperCount; ++i)
+	{
+		tasks[i] = ANKI_THREAD_HIVE_TASK({ PhysicsWorld::runTriggerTasks(*self); }, &ctx, nullptr, nullptr);
+	}
+	m_hive->submitTasks(&tasks[0], helperCount);
+
+	runTriggerTasks(ctx);
+	m_hive->waitAllTasks();
+}
+
+void PhysicsWorld::runTriggerTasks(TriggerCtx& ctx)
+{
+	U32 blockIdx;
+	while((blockIdx = ctx.m_crntBlock.fetchAdd(1)) < ctx.m_blockCount)
+	{
+		const U32 begin = blockIdx * TriggerCtx::TRIGGERS_PER_BLOCK;
+		const U32 end = min(ctx.m_triggers.getSize(), begin + TriggerCtx::TRIGGERS_PER_BLOCK);
+		for(U32 i = begin; i < end; ++i)
+		{
+			ctx.m_triggers[i]->processContacts();
+		}
+	}
 }
 
 } // end namespace anki
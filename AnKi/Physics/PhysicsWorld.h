@@ -13,6 +13,9 @@
 
 namespace anki {
 
+// Forward
+class ThreadHive;
+
 /// @addtogroup physics
 /// @{
 
@@ -36,6 +39,41 @@ public:
 	virtual void processResult(PhysicsFilteredObject& obj, const Vec3& worldNormal, const Vec3& worldPosition) = 0;
 };
 
+/// The type of a PhysicsWorldQuery.
+enum class PhysicsWorldQueryType : U8
+{
+	RAY,
+	SPHERE_SWEEP,
+	CONVEX_SWEEP, ///< Sweep a convex PhysicsCollisionShape.
+	SPHERE_OVERLAP,
+	SHAPE_OVERLAP,
+
+	COUNT
+};
+
+/// A query of PhysicsWorld::query().
+class PhysicsWorldQuery
+{
+public:
+	Vec3 m_from = Vec3(0.0f); ///< Where the ray or the sweep starts. The position of the overlap shapes.
+	Vec3 m_to = Vec3(0.0f); ///< Where the ray or the sweep ends. Ignored by the overlaps.
+	PhysicsCollisionShape* m_shape = nullptr; ///< The shape of CONVEX_SWEEP and SHAPE_OVERLAP. It's not rotated.
+	F32 m_radius = 0.0f; ///< The radius of SPHERE_SWEEP and SPHERE_OVERLAP.
+	PhysicsMaterialBit m_materialMask = PhysicsMaterialBit::ALL; ///< Materials to check.
+	PhysicsWorldQueryType m_type = PhysicsWorldQueryType::RAY;
+};
+
+/// The result of a PhysicsWorldQuery.
+class PhysicsWorldQueryResult
+{
+public:
+	/// The closest object that was hit or one of the overlapping objects. nullptr if there was no hit.
+	PhysicsFilteredObject* m_object = nullptr;
+	Vec3 m_worldPosition = Vec3(0.0f);
+	Vec3 m_worldNormal = Vec3(0.0f);
+	F32 m_hitFraction = 1.0f; ///< Where between PhysicsWorldQuery::m_from and m_to the hit is.
+};
+
 /// The master container for all physics related stuff.
 class PhysicsWorld
 {
@@ -43,7 +81,9 @@ public:
 	PhysicsWorld();
 	~PhysicsWorld();
 
-	ANKI_USE_RESULT Error init(AllocAlignedCallback allocCb, void* allocCbData);
+	/// Initialize.
+	/// @param hive If not nullptr the simulation will use its threads. Can be nullptr.
+	ANKI_USE_RESULT Error init(AllocAlignedCallback allocCb, void* allocCbData, ThreadHive* hive);
 
 	template<typename T, typename... TArgs>
 	PhysicsPtr<T> newInstance(TArgs&&... args)
@@ -61,9 +101,34 @@ public:
 		return PhysicsPtr<T>(obj);
 	}
 
-	/// Do the update.
+	/// Do the update. The world is stepped in fixed time steps and the transforms of the bodies are interpolated
+	/// between the last two steps.
+	/// @note It uses the ThreadHive so it shouldn't be called while the hive runs other tasks.
 	Error update(Second dt);
 
+	/// The max number of fixed steps per update(). If the update() is called with a big dt the world will fall behind.
+	void setMaxSubSteps(U32 maxSubSteps)
+	{
+		ANKI_ASSERT(maxSubSteps > 0);
+		m_maxSubSteps = maxSubSteps;
+	}
+
+	U32 getMaxSubSteps() const
+	{
+		return m_maxSubSteps;
+	}
+
+	void setFixedTimeStep(Second timeStep)
+	{
+		ANKI_ASSERT(timeStep > 0.0);
+		m_fixedTimeStep = timeStep;
+	}
+
+	Second getFixedTimeStep() const
+	{
+		return m_fixedTimeStep;
+	}
+
 	HeapAllocator<U8> getAllocator() const
 	{
 		return m_alloc;
@@ -86,6 +151,12 @@ public:
 
 	void rayCast(WeakArray<PhysicsWorldRayCastCallback*> rayCasts) const;
 
+	/// Run many queries at once. The queries are split in blocks that the threads of the ThreadHive can steal.
+	/// @param[out] results One result per query.
+	/// @note It's thread-safe but it shouldn't run in parallel with update(). It uses the scratch memory of the hive so
+	///       someone should call ThreadHive::waitAllTasks() later on.
+	void query(ConstWeakArray<PhysicsWorldQuery> queries, WeakArray<PhysicsWorldQueryResult> results) const;
+
 	void rayCast(PhysicsWorldRayCastCallback& raycast) const
 	{
 		PhysicsWorldRayCastCallback* ptr = &raycast;
@@ -110,12 +181,15 @@ public:
 
 	ANKI_INTERNAL void destroyObject(PhysicsObject* obj);
 
-	ANKI_INTERNAL PhysicsTriggerFilteredPair*
-	getOrCreatePhysicsTriggerFilteredPair(PhysicsTrigger* trigger, PhysicsFilteredObject* filtered, Bool& isNew);
+	/// Remove a filtered object that died from the triggers it was inside.
+	ANKI_INTERNAL void forgetTriggerPairs(const PhysicsFilteredObject* filtered);
 
 private:
 	class MyOverlapFilterCallback;
 	class MyRaycastCallback;
+	class MyTaskScheduler;
+	class QueryCtx;
+	class TriggerCtx;
 
 	HeapAllocator<U8> m_alloc;
 	StackAllocator<U8> m_tmpAlloc;
@@ -125,9 +199,20 @@ private:
 	MyOverlapFilterCallback* m_filterCallback = nullptr;
 
 	ClassWrapper<btDefaultCollisionConfiguration> m_collisionConfig;
-	ClassWrapper<btCollisionDispatcher> m_dispatcher;
-	ClassWrapper<btSequentialImpulseConstraintSolver> m_solver;
-	ClassWrapper<btDiscreteDynamicsWorld> m_world;
+	ClassWrapper<btCollisionDispatcherMt> m_dispatcher;
+	ClassWrapper<btConstraintSolverPoolMt> m_solverPool; ///< Solves the small islands, one solver per thread.
+	ClassWrapper<btSequentialImpulseConstraintSolverMt> m_solver; ///< Solves the big islands using all threads.
+	ClassWrapper<btDiscreteDynamicsWorldMt> m_world;
+	ThreadHive* m_hive = nullptr;
+
+	/// Bullet's task scheduler is process-global so all the worlds share one. The first world installs it (with its
+	/// ThreadHive) and the last one that goes away uninstalls it.
+	static MyTaskScheduler* m_taskScheduler;
+	static U32 m_taskSchedulerRefcount;
+	static Mutex m_taskSchedulerMtx;
+
+	U32 m_maxSubSteps = 4;
+	Second m_fixedTimeStep = 1.0 / 60.0;
 
 	Array<IntrusiveList<PhysicsObject>, U(PhysicsObjectType::COUNT)> m_objectLists;
 	IntrusiveList<PhysicsObject> m_markedForCreation;
@@ -139,6 +224,117 @@ private:
 #endif
 
 	void destroyMarkedForDeletion();
+
+	void processTriggerContacts();
+
+	static void runTriggerTasks(TriggerCtx& ctx);
+
+	void runQuery(const PhysicsWorldQuery& query, PhysicsWorldQueryResult& result) const;
+
+	static void runQueryTasks(QueryCtx& ctx);
+};
+
+/// A fixed size list of queries and their results. It's what the scripts use to batch their queries.
+class PhysicsWorldQueryBatch
+{
+public:
+	static constexpr U32 MAX_QUERIES = 64;
+
+	/// Add a ray.
+	/// @return The index of the query or MAX_U32 if the batch is full.
+	U32 addRay(const Vec3& from, const Vec3& to)
+	{
+		PhysicsWorldQuery q;
+		q.m_type = PhysicsWorldQueryType::RAY;
+		q.m_from = from;
+		q.m_to = to;
+		return addQuery(q);
+	}
+
+	/// Add a sphere sweep.
+	/// @return The index of the query or MAX_U32 if the batch is full.
+	U32 addSphereSweep(const Vec3& from, const Vec3& to, F32 radius)
+	{
+		PhysicsWorldQuery q;
+		q.m_type = PhysicsWorldQueryType::SPHERE_SWEEP;
+		q.m_from = from;
+		q.m_to = to;
+		q.m_radius = radius;
+		return addQuery(q);
+	}
+
+	/// Add a sphere overlap.
+	/// @return The index of the query or MAX_U32 if the batch is full.
+	U32 addSphereOverlap(const Vec3& center, F32 radius)
+	{
+		PhysicsWorldQuery q;
+		q.m_type = PhysicsWorldQueryType::SPHERE_OVERLAP;
+		q.m_from = center;
+		q.m_radius = radius;
+		return addQuery(q);
+	}
+
+	/// Add any query.
+	/// @return The index of the query or MAX_U32 if the batch is full.
+	U32 addQuery(const PhysicsWorldQuery& q)
+	{
+		if(m_queryCount == MAX_QUERIES)
+		{
+			return MAX_U32;
+		}
+
+		m_queries[m_queryCount] = q;
+		return m_queryCount++;
+	}
+
+	/// Run the queries and keep the results.
+	void run(const PhysicsWorld& world)
+	{
+		world.query(ConstWeakArray<PhysicsWorldQuery>(&m_queries[0], m_queryCount),
+					WeakArray<PhysicsWorldQueryResult>(&m_results[0], m_queryCount));
+	}
+
+	/// Remove the queries.
+	void reset()
+	{
+		m_queryCount = 0;
+	}
+
+	U32 getQueryCount() const
+	{
+		return m_queryCount;
+	}
+
+	const PhysicsWorldQueryResult& getResult(U32 idx) const
+	{
+		ANKI_ASSERT(idx < m_queryCount);
+		return m_results[idx];
+	}
+
+	Bool isHit(U32 idx) const
+	{
+		return getResult(idx).m_object != nullptr;
+	}
+
+	Vec3 getHitPosition(U32 idx) const
+	{
+		return getResult(idx).m_worldPosition;
+	}
+
+	Vec3 getHitNormal(U32 idx) const
+	{
+		return getResult(idx).m_worldNormal;
+	}
+
+	F32 getHitFraction(U32 idx) const
+	{
+		return getResult(idx).m_hitFraction;
+	}
+
+private:
+	Array<PhysicsWorldQuery, MAX_QUERIES> m_queries;
+	Array<PhysicsWorldQueryResult, MAX_QUERIES> m_results;
+	U32 m_queryCount = 0;
 };
 /// @}
 
@@ -31,6 +31,7 @@ ANKI_CONFIG_OPTION(r_shadowMappingTileCountPerRowOrColumn, 16, 1, 256)
 ANKI_CONFIG_OPTION(r_shadowMappingScratchTileCountX, 4 * (MAX_SHADOW_CASCADES2 + 2), 1u, 256u,
 				   "Number of tiles of the scratch buffer in X")
 ANKI_CONFIG_OPTION(r_shadowMappingScratchTileCountY, 4, 1, 256, "Number of tiles of the scratch buffer in Y")
+ANKI_CONFIG_OPTION(r_shadowMappingStaticCache, 1, 0, 1, "Cache the depth of the static shadow casters")
 
 ANKI_CONFIG_OPTION(r_probeReflectionResolution, 128, 4, 2048)
 ANKI_CONFIG_OPTION(r_probeReflectionIrradianceResolution, 16, 4, 2048)
@@ -49,6 +50,8 @@ ANKI_CONFIG_OPTION(r_motionBlurSamples, 32, 1, 2048)
 
 ANKI_CONFIG_OPTION(r_dbgEnabled, 0, 0, 1)
 
+ANKI_CONFIG_OPTION(r_gpuScene, 0, 0, 1, "Keep a copy of the renderables in GPU memory")
+
 ANKI_CONFIG_OPTION(r_avgObjectsPerCluster, 16, 16, 256)
 
 ANKI_CONFIG_OPTION(r_bloomThreshold, 2.5, 0.0, 256.0)
@@ -26,6 +26,10 @@ public:
 	U32 m_cachedRenderElementCount = 0;
 	U8 m_minLod = 0;
 	U8 m_maxLod = 0;
+
+	// The previous drawcall
+	RenderQueueDrawCallback m_prevCallback = nullptr;
+	U64 m_prevMergeKey = 0;
 };
 
 /// Check if the drawcalls can be merged.
@@ -73,11 +77,21 @@ void RenderableDrawer::drawRange(Pass pass, const Mat4& viewMat, const Mat4& vie
 
 void RenderableDrawer::flushDrawcall(DrawContext& ctx)
 {
+	const RenderableQueueElement& firstEl = ctx.m_cachedRenderElements[0];
+
+	// Inform the callback about the state of the previous drawcall so it can skip setting the same state again
+	ctx.m_queueCtx.m_previousKeyValid =
+		ctx.m_prevCallback == firstEl.m_callback && firstEl.m_mergeKey != 0 && ctx.m_prevMergeKey == firstEl.m_mergeKey;
+	ctx.m_queueCtx.m_previousKey = ctx.m_queueCtx.m_key;
+
 	ctx.m_queueCtx.m_key.setLod(ctx.m_cachedRenderElementLods[0]);
 	ctx.m_queueCtx.m_key.setInstanceCount(ctx.m_cachedRenderElementCount);
 
-	ctx.m_cachedRenderElements[0].m_callback(
-		ctx.m_queueCtx, ConstWeakArray<void*>(const_cast<void**>(&ctx.m_userData[0]), ctx.m_cachedRenderElementCount));
+	firstEl.m_callback(ctx.m_queueCtx,
+					   ConstWeakArray<void*>(const_cast<void**>(&ctx.m_userData[0]), ctx.m_cachedRenderElementCount));
+
+	ctx.m_prevCallback = firstEl.m_callback;
+	ctx.m_prevMergeKey = firstEl.m_mergeKey;
 
 	// Rendered something, reset the cached transforms
 	if(ctx.m_cachedRenderElementCount > 1)
@@ -0,0 +1,133 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Renderer/GpuScene.h>
+#include <AnKi/Renderer/Renderer.h>
+#include <AnKi/Renderer/RenderQueue.h>
+#include <AnKi/Core/ConfigSet.h>
+#include <AnKi/Util/Tracer.h>
+#include <AnKi/Shaders/Include/GpuSceneTypes.h>
+
+namespace anki {
+
+GpuScene::~GpuScene()
+{
+}
+
+Error GpuScene::init(const ConfigSet& config)
+{
+	m_enabled = config.getBool("r_gpuScene");
+	if(!m_enabled)
+	{
+		return Error::NONE;
+	}
+
+	ANKI_R_LOGI("Initializing GPU scene");
+
+	ANKI_CHECK(getResourceManager().loadResource("Shaders/GpuSceneUpdate.ankiprog", m_updateProg));
+	const ShaderProgramResourceVariant* variant;
+	m_updateProg->getOrCreateVariant(variant);
+	m_updateGrProg = variant->getProgram();
+
+	return Error::NONE;
+}
+
+void GpuScene::allocateInstancesBuffer(RenderingContext& ctx)
+{
+	const GpuSceneQueueElement& gpuScene = ctx.m_renderQueue->m_gpuScene;
+
+	// Grow and keep the old buffer around to copy its contents to the new one
+	const PtrSize instancesSize = gpuScene.m_instances.getSizeInBytes();
+	m_runCtx.m_oldInstancesBuff.reset(nullptr);
+	if(!m_instancesBuff || m_instancesBuff->getSize() < instancesSize)
+	{
+		const PtrSize newSize = max(instancesSize, (m_instancesBuff) ? m_instancesBuff->getSize() * 2 : 0);
+		m_runCtx.m_oldInstancesBuff = m_instancesBuff;
+		m_instancesBuff = getGrManager().newBuffer(
+			BufferInitInfo(newSize, BufferUsageBit::ALL_STORAGE | BufferUsageBit::ALL_TRANSFER, BufferMapAccessBit::NONE,
+						   "GpuSceneInstances"));
+	}
+}
+
+void GpuScene::populateRenderGraph(RenderingContext& ctx)
+{
+	m_runCtx.m_instancesBuffHandle = {};
+
+	const GpuSceneQueueElement& gpuScene = ctx.m_renderQueue->m_gpuScene;
+	if(!m_enabled || gpuScene.m_instances.getSize() == 0)
+	{
+		return;
+	}
+
+	ANKI_TRACE_INC_COUNTER(R_GPU_SCENE_INSTANCES, gpuScene.m_instances.getSize());
+	ANKI_TRACE_INC_COUNTER(R_GPU_SCENE_UPLOADED_INSTANCES, gpuScene.m_dirtyInstances.getSize());
+
+	allocateInstancesBuffer(ctx);
+
+	RenderGraphDescription& rgraph = ctx.m_renderGraphDescr;
+	m_runCtx.m_instancesBuffHandle = rgraph.importBuffer(m_instancesBuff, BufferUsageBit::NONE);
+
+	// The buffer grew, copy the old contents
+	if(m_runCtx.m_oldInstancesBuff)
+	{
+		m_runCtx.m_oldInstancesBuffHandle = rgraph.importBuffer(m_runCtx.m_oldInstancesBuff, BufferUsageBit::NONE);
+
+		ComputeRenderPassDescription& rpass = rgraph.newComputeRenderPass("GPU scene grow");
+
+		rpass.setWork([this](RenderPassWorkContext& rgraphCtx) {
+			runGrow(rgraphCtx);
+		});
+
+		rpass.newDependency({m_runCtx.m_oldInstancesBuffHandle, BufferUsageBit::TRANSFER_SOURCE});
+		rpass.newDependency({m_runCtx.m_instancesBuffHandle, BufferUsageBit::TRANSFER_DESTINATION});
+	}
+
+	// Upload the instances that changed. The new instances are already in the dirty list
+	if(gpuScene.m_dirtyInstances.getSize())
+	{
+		ComputeRenderPassDescription& rpass = rgraph.newComputeRenderPass("GPU scene upd");
+
+		rpass.setWork([this, &ctx](RenderPassWorkContext& rgraphCtx) {
+			runUpdate(ctx, rgraphCtx);
+		});
+
+		rpass.newDependency({m_runCtx.m_instancesBuffHandle, BufferUsageBit::STORAGE_COMPUTE_WRITE});
+	}
+}
+
+void GpuScene::runGrow(RenderPassWorkContext& rgraphCtx)
+{
+	rgraphCtx.m_commandBuffer->copyBufferToBuffer(m_runCtx.m_oldInstancesBuff, 0, m_instancesBuff, 0,
+												  m_runCtx.m_oldInstancesBuff->getSize());
+}
+
+void GpuScene::runUpdate(const RenderingContext& ctx, RenderPassWorkContext& rgraphCtx)
+{
+	CommandBufferPtr& cmdb = rgraphCtx.m_commandBuffer;
+	const GpuSceneQueueElement& gpuScene = ctx.m_renderQueue->m_gpuScene;
+	const U32 updateCount = gpuScene.m_dirtyInstances.getSize();
+	ANKI_ASSERT(updateCount > 0);
+
+	cmdb->bindShaderProgram(m_updateGrProg);
+
+	GpuSceneUpdateUniforms* unis = allocateAndBindUniforms<GpuSceneUpdateUniforms*>(sizeof(*unis), cmdb, 0, 0);
+	unis->m_updateCount = updateCount;
+
+	U32* indices = allocateAndBindStorage<U32*>(updateCount * sizeof(U32), cmdb, 0, 1);
+	memcpy(indices, &gpuScene.m_dirtyInstances[0], updateCount * sizeof(U32));
+
+	GpuSceneInstance* updates =
+		allocateAndBindStorage<GpuSceneInstance*>(updateCount * sizeof(GpuSceneInstance), cmdb, 0, 2);
+	for(U32 i = 0; i < updateCount; ++i)
+	{
+		updates[i] = gpuScene.m_instances[gpuScene.m_dirtyInstances[i]];
+	}
+
+	rgraphCtx.bindStorageBuffer(0, 3, m_runCtx.m_instancesBuffHandle);
+
+	cmdb->dispatchCompute((updateCount + GPU_SCENE_UPDATE_WORKGROUP_SIZE - 1) / GPU_SCENE_UPDATE_WORKGROUP_SIZE, 1, 1);
+}
+
+} // end namespace anki
@@ -0,0 +1,66 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Renderer/RendererObject.h>
+
+namespace anki {
+
+/// @addtogroup renderer
+/// @{
+
+/// Keeps a persistent copy of the renderable instances in GPU memory and uploads only the instances that changed.
+class GpuScene : public RendererObject
+{
+public:
+	GpuScene(Renderer* r)
+		: RendererObject(r)
+	{
+	}
+
+	~GpuScene();
+
+	ANKI_USE_RESULT Error init(const ConfigSet& config);
+
+	/// Upload the instances that changed.
+	void populateRenderGraph(RenderingContext& ctx);
+
+	Bool getEnabled() const
+	{
+		return m_enabled;
+	}
+
+	/// Get it to set a dependency. It holds the GpuSceneInstance structures. It's invalid if there are no instances.
+	BufferHandle getInstancesBufferHandle() const
+	{
+		return m_runCtx.m_instancesBuffHandle;
+	}
+
+private:
+	ShaderProgramResourcePtr m_updateProg;
+	ShaderProgramPtr m_updateGrProg;
+
+	BufferPtr m_instancesBuff;
+
+	Bool m_enabled = false;
+
+	class
+	{
+	public:
+		BufferHandle m_instancesBuffHandle;
+
+		BufferPtr m_oldInstancesBuff; ///< Set if the instance buffer grew this frame.
+		BufferHandle m_oldInstancesBuffHandle;
+	} m_runCtx;
+
+	void allocateInstancesBuffer(RenderingContext& ctx);
+
+	void runGrow(RenderPassWorkContext& rgraphCtx);
+	void runUpdate(const RenderingContext& ctx, RenderPassWorkContext& rgraphCtx);
+};
+/// @}
+
+} // end namespace anki
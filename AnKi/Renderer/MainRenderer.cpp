@@ -35,7 +35,8 @@ Error MainRenderer::init(ThreadHive* hive, ResourceManager* resources, GrManager
 	ANKI_R_LOGI("Initializing main renderer");
 
 	m_alloc = HeapAllocator<U8>(allocCb, allocCbUserData, "MainRenderer");
-	m_frameAlloc = StackAllocator<U8>(allocCb, allocCbUserData, 1024 * 1024 * 10, 1.0f);
+	m_frameAlloc = StackAllocator<U8>(allocCb, allocCbUserData, 1024 * 1024 * 10, 1.0f, 0, true, ANKI_SAFE_ALIGNMENT,
+									  "RendererFrame");
 
 	// Init renderer and manipulate the width/height
 	m_swapchainResolution.x() = config.getNumberU32("width");
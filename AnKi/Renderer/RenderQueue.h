@@ -10,6 +10,7 @@
 #include <AnKi/Ui/Canvas.h>
 #include <AnKi/Shaders/Include/ClusteredShadingTypes.h>
 #include <AnKi/Shaders/Include/ModelTypes.h>
+#include <AnKi/Shaders/Include/GpuSceneTypes.h>
 
 namespace anki {
 
@@ -45,6 +46,12 @@ public:
 	StackAllocator<U8> m_frameAllocator;
 	Bool m_debugDraw; ///< If true the drawcall should be drawing some kind of debug mesh.
 	BitSet<U(RenderQueueDebugDrawFlag::COUNT), U32> m_debugDrawFlags = {false};
+
+	/// The key the previous drawcall ended up using. It's valid only if m_previousKeyValid is true and that happens if
+	/// the previous drawcall came from the same callback and had the same merge key. The callback can use it to skip
+	/// state that is already set (like the vertex and index buffers).
+	RenderingKey m_previousKey;
+	Bool m_previousKeyValid = false;
 };
 
 /// Draw callback for drawing.
@@ -58,7 +65,8 @@ public:
 	const void* m_userData;
 
 	/// Elements with the same m_mergeKey and same m_callback may be merged and the m_callback will be called once.
-	/// Unless m_mergeKey is zero.
+	/// Unless m_mergeKey is zero. The upper bits of the key should identify the program and material and the lower
+	/// the geometry because the visibility uses them to sort by state.
 	U64 m_mergeKey;
 
 	F32 m_distanceFromCamera; ///< Don't set this. Visibility will.
@@ -371,6 +379,19 @@ public:
 static_assert(std::is_trivially_destructible<RayTracingInstanceQueueElement>::value == true,
 			  "Should be trivially destructible");
 
+/// The changes of the persistent GPU scene.
+class GpuSceneQueueElement final
+{
+public:
+	/// All the instances. It points to scene memory that stays valid until the next scene update.
+	ConstWeakArray<GpuSceneInstance> m_instances;
+
+	/// Indices to m_instances that changed since the last frame.
+	ConstWeakArray<U32> m_dirtyInstances;
+};
+
+static_assert(std::is_trivially_destructible<GpuSceneQueueElement>::value == true, "Should be trivially destructible");
+
 /// The render queue. This is what the renderer is fed to render.
 class RenderQueue : public RenderingMatrices
 {
@@ -389,6 +410,7 @@ public:
 	WeakArray<UiQueueElement> m_uis;
 	WeakArray<GenericGpuComputeJobQueueElement> m_genericGpuComputeJobs;
 	WeakArray<RayTracingInstanceQueueElement> m_rayTracingInstances;
+	GpuSceneQueueElement m_gpuScene; ///< Only the main camera's queue has that.
 
 	/// Contains the ray tracing elements. The rest of the members are unused. It's separate to avoid multithreading
 	/// bugs.
@@ -397,6 +419,18 @@ public:
 	/// Applies only if the RenderQueue holds shadow casters. It's the max timesamp of all shadow casters
 	Timestamp m_shadowRenderablesLastUpdateTimestamp = 0;
 
+	/// Applies only if the RenderQueue holds shadow casters. It's the max timestamp of the static shadow casters and the
+	/// light.
+	Timestamp m_staticShadowRenderablesLastUpdateTimestamp = 0;
+
+	/// Applies only if the RenderQueue holds shadow casters. It identifies the set of static shadow casters. It changes
+	/// when a static caster is added or removed.
+	U64 m_staticShadowRenderablesHash = 0;
+
+	/// Applies only if the RenderQueue holds shadow casters. The first m_staticShadowRenderableCount elements of
+	/// m_renderables are static shadow casters (see SpatialComponent::setStatic).
+	U32 m_staticShadowRenderableCount = 0;
+
 	F32 m_cameraNear;
 	F32 m_cameraFar;
 	F32 m_cameraFovX;
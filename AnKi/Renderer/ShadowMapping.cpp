@@ -29,6 +29,7 @@ class ShadowMapping::Scratch::LightToRenderToScratchInfo
 public:
 	UVec4 m_viewport;
 	RenderQueue* m_renderQueue;
+	U32 m_firstRenderableElement;
 	U32 m_drawcallCount;
 	U32 m_renderQueueElementsLod;
 };
@@ -38,12 +39,32 @@ class ShadowMapping::Atlas::ResolveWorkItem
 public:
 	Vec4 m_uvInBounds; ///< Bounds used to avoid blurring neighbour tiles.
 	Vec4 m_uvIn; ///< UV + size that point to the scratch buffer.
+	Vec4 m_staticCacheUv; ///< UV + size that point to the whole face in the static cache.
 	UVec4 m_viewportOut; ///< Viewport in the atlas RT.
 	Bool m_blur;
+	Bool m_staticCache;
+};
+
+class ShadowMapping::StaticCache::Entry
+{
+public:
+	U64 m_lightUuid = 0;
+	U32 m_faceIdx = MAX_U32;
+	U64 m_renderablesHash = 0; ///< The hash of the static casters when they were cached.
+	Timestamp m_timestamp = 0; ///< The timestamp of the static casters when they were cached.
+	UVec4 m_viewport = UVec4(0u); ///< Viewport in the static cache RT. Same as the atlas.
+};
+
+class ShadowMapping::StaticCache::CopyWorkItem
+{
+public:
+	UVec2 m_scratchOffset;
+	UVec2 m_staticCacheOffset;
 };
 
 ShadowMapping::~ShadowMapping()
 {
+	m_staticCache.m_entries.destroy(getAllocator());
 }
 
 Error ShadowMapping::init(const ConfigSet& config)
@@ -130,10 +151,47 @@ Error ShadowMapping::initAtlas(const ConfigSet& cfg)
 	return Error::NONE;
 }
 
+Error ShadowMapping::initStaticCache(const ConfigSet& cfg)
+{
+	m_staticCache.m_enabled = cfg.getBool("r_shadowMappingStaticCache");
+	if(!m_staticCache.m_enabled)
+	{
+		return Error::NONE;
+	}
+
+	// Entries
+	m_staticCache.m_entries.create(getAllocator(), m_atlas.m_tileCountBothAxis * m_atlas.m_tileCountBothAxis);
+
+	// Program
+	ANKI_CHECK(getResourceManager().loadResource("Shaders/ShadowmappingStaticCacheCopy.ankiprog",
+												 m_staticCache.m_copyProg));
+	const ShaderProgramResourceVariant* variant;
+	m_staticCache.m_copyProg->getOrCreateVariant(variant);
+	m_staticCache.m_copyGrProg = variant->getProgram();
+
+	return Error::NONE;
+}
+
+void ShadowMapping::createStaticCacheTexture()
+{
+	ANKI_ASSERT(m_staticCache.m_enabled && !m_staticCache.m_tex);
+	ANKI_R_LOGI("Creating the static shadow caster cache");
+
+	const U32 size = m_atlas.m_tileResolution * m_atlas.m_tileCountBothAxis;
+	TextureInitInfo texinit = m_r->create2DRenderTargetInitInfo(
+		size, size, Format::R32_SFLOAT, TextureUsageBit::SAMPLED_COMPUTE | TextureUsageBit::IMAGE_COMPUTE_WRITE,
+		"SM static cache");
+	texinit.m_initialUsage = TextureUsageBit::SAMPLED_COMPUTE;
+	ClearValue clearVal;
+	clearVal.m_colorf[0] = 1.0f;
+	m_staticCache.m_tex = m_r->createAndClearRenderTarget(texinit, clearVal);
+}
+
 Error ShadowMapping::initInternal(const ConfigSet& cfg)
 {
 	ANKI_CHECK(initScratch(cfg));
 	ANKI_CHECK(initAtlas(cfg));
+	ANKI_CHECK(initStaticCache(cfg));
 
 	m_lodDistances[0] = cfg.getNumberF32("lod0MaxDistance");
 	m_lodDistances[1] = cfg.getNumberF32("lod1MaxDistance");
@@ -165,7 +223,11 @@ void ShadowMapping::runAtlas(RenderPassWorkContext& rgraphCtx)
 		uni.m_uvMin = workItem.m_uvInBounds.xy();
 		uni.m_uvMax = workItem.m_uvInBounds.xy() + workItem.m_uvInBounds.zw();
 
+		uni.m_staticCacheUvScale = workItem.m_staticCacheUv.zw();
+		uni.m_staticCacheUvTranslation = workItem.m_staticCacheUv.xy();
+
 		uni.m_blur = workItem.m_blur;
+		uni.m_staticCache = workItem.m_staticCache;
 	}
 
 	cmdb->bindShaderProgram(m_atlas.m_resolveGrProg);
@@ -174,6 +236,15 @@ void ShadowMapping::runAtlas(RenderPassWorkContext& rgraphCtx)
 	cmdb->bindSampler(0, 1, m_r->getSamplers().m_trilinearClamp);
 	rgraphCtx.bindTexture(0, 2, m_scratch.m_rt, TextureSubresourceInfo(DepthStencilAspectBit::DEPTH));
 	rgraphCtx.bindImage(0, 3, m_atlas.m_rt);
+	if(m_staticCache.m_tex)
+	{
+		rgraphCtx.bindColorTexture(0, 4, m_staticCache.m_rt);
+	}
+	else
+	{
+		// Bind something, it won't be sampled
+		rgraphCtx.bindTexture(0, 4, m_scratch.m_rt, TextureSubresourceInfo(DepthStencilAspectBit::DEPTH));
+	}
 
 	constexpr U32 workgroupSize = 8;
 	ANKI_ASSERT(m_atlas.m_tileResolution >= workgroupSize && (m_atlas.m_tileResolution % workgroupSize) == 0);
@@ -182,9 +253,36 @@ void ShadowMapping::runAtlas(RenderPassWorkContext& rgraphCtx)
 						  m_atlas.m_resolveWorkItems.getSize());
 }
 
+void ShadowMapping::runStaticCacheCopy(RenderPassWorkContext& rgraphCtx)
+{
+	ANKI_ASSERT(m_staticCache.m_copyWorkItems.getSize());
+	ANKI_TRACE_SCOPED_EVENT(R_SM);
+
+	CommandBufferPtr& cmdb = rgraphCtx.m_commandBuffer;
+
+	ShadowMappingStaticCacheCopyUniforms* uniforms = allocateAndBindStorage<ShadowMappingStaticCacheCopyUniforms*>(
+		m_staticCache.m_copyWorkItems.getSize() * sizeof(ShadowMappingStaticCacheCopyUniforms), cmdb, 0, 0);
+	for(U32 i = 0; i < m_staticCache.m_copyWorkItems.getSize(); ++i)
+	{
+		uniforms[i].m_inOffset = IVec2(m_staticCache.m_copyWorkItems[i].m_scratchOffset);
+		uniforms[i].m_outOffset = IVec2(m_staticCache.m_copyWorkItems[i].m_staticCacheOffset);
+	}
+
+	cmdb->bindShaderProgram(m_staticCache.m_copyGrProg);
+
+	cmdb->bindSampler(0, 1, m_r->getSamplers().m_nearestNearestClamp);
+	rgraphCtx.bindTexture(0, 2, m_scratch.m_rt, TextureSubresourceInfo(DepthStencilAspectBit::DEPTH));
+	rgraphCtx.bindImage(0, 3, m_staticCache.m_rt);
+
+	constexpr U32 workgroupSize = 8;
+	ANKI_ASSERT(m_scratch.m_tileResolution >= workgroupSize && (m_scratch.m_tileResolution % workgroupSize) == 0);
+
+	cmdb->dispatchCompute(m_scratch.m_tileResolution / workgroupSize, m_scratch.m_tileResolution / workgroupSize,
+						  m_staticCache.m_copyWorkItems.getSize());
+}
+
 void ShadowMapping::runShadowMapping(RenderPassWorkContext& rgraphCtx)
 {
-	ANKI_ASSERT(m_scratch.m_workItems.getSize());
 	ANKI_TRACE_SCOPED_EVENT(R_SM);
 
 	CommandBufferPtr& cmdb = rgraphCtx.m_commandBuffer;
@@ -222,7 +320,12 @@ void ShadowMapping::populateRenderGraph(RenderingContext& ctx)
 
 	// Build the render graph
 	RenderGraphDescription& rgraph = ctx.m_renderGraphDescr;
-	if(m_scratch.m_workItems.getSize())
+	if(m_staticCache.m_tex)
+	{
+		m_staticCache.m_rt = rgraph.importRenderTarget(m_staticCache.m_tex, TextureUsageBit::SAMPLED_COMPUTE);
+	}
+
+	if(m_atlas.m_resolveWorkItems.getSize())
 	{
 		// Will have to create render passes
 
@@ -247,6 +350,20 @@ void ShadowMapping::populateRenderGraph(RenderingContext& ctx)
 			pass.newDependency({m_scratch.m_rt, TextureUsageBit::ALL_FRAMEBUFFER_ATTACHMENT, subresource});
 		}
 
+		// Static cache pass
+		if(m_staticCache.m_copyWorkItems.getSize())
+		{
+			ComputeRenderPassDescription& pass = rgraph.newComputeRenderPass("SM static cache");
+
+			pass.setWork([this](RenderPassWorkContext& rgraphCtx) {
+				runStaticCacheCopy(rgraphCtx);
+			});
+
+			pass.newDependency({m_scratch.m_rt, TextureUsageBit::SAMPLED_COMPUTE,
+								TextureSubresourceInfo(DepthStencilAspectBit::DEPTH)});
+			pass.newDependency({m_staticCache.m_rt, TextureUsageBit::IMAGE_COMPUTE_WRITE});
+		}
+
 		// Atlas pass
 		{
 			ComputeRenderPassDescription& pass = rgraph.newComputeRenderPass("SM atlas");
@@ -259,6 +376,10 @@ void ShadowMapping::populateRenderGraph(RenderingContext& ctx)
 			pass.newDependency({m_scratch.m_rt, TextureUsageBit::SAMPLED_COMPUTE,
 								TextureSubresourceInfo(DepthStencilAspectBit::DEPTH)});
 			pass.newDependency({m_atlas.m_rt, TextureUsageBit::IMAGE_COMPUTE_WRITE});
+			if(m_staticCache.m_tex)
+			{
+				pass.newDependency({m_staticCache.m_rt, TextureUsageBit::SAMPLED_COMPUTE});
+			}
 		}
 	}
 	else
@@ -388,6 +509,8 @@ TileAllocatorResult ShadowMapping::allocateTilesAndScratchTiles(U64 lightUuid, U
 	{
 		if(subResults[i] == TileAllocatorResult::CACHED)
 		{
+			ANKI_TRACE_INC_COUNTER(R_SHADOW_CACHED_FACES, 1);
+			ANKI_TRACE_INC_COUNTER(R_SHADOW_SAVED_DRAWCALLS, drawcallsCount[i]);
 			continue;
 		}
 
@@ -435,6 +558,7 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 	DynamicArrayAuto<Scratch::LightToRenderToScratchInfo> lightsToRender(ctx.m_tempAllocator);
 	U32 drawcallCount = 0;
 	DynamicArrayAuto<Atlas::ResolveWorkItem> atlasWorkItems(ctx.m_tempAllocator);
+	DynamicArrayAuto<StaticCache::CopyWorkItem> staticCacheCopyWorkItems(ctx.m_tempAllocator);
 
 	// First thing, allocate an empty tile for empty faces of point lights
 	UVec4 emptyTileViewport;
@@ -520,9 +644,10 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 
 					// Push work
 					newScratchAndAtlasResloveRenderWorkItems(
-						atlasViewports[activeCascades], scratchViewports[activeCascades], blurAtlass[activeCascades],
+						light.m_uuid, U32(cascade), lods[activeCascades], atlasViewports[activeCascades],
+						scratchViewports[activeCascades], blurAtlass[activeCascades],
 						light.m_shadowRenderQueues[cascade], renderQueueElementsLods[activeCascades], lightsToRender,
-						atlasWorkItems, drawcallCount);
+						atlasWorkItems, staticCacheCopyWorkItems, drawcallCount);
 
 					++activeCascades;
 				}
@@ -618,8 +743,9 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 					if(subResults[numOfFacesThatHaveDrawcalls] != TileAllocatorResult::CACHED)
 					{
 						newScratchAndAtlasResloveRenderWorkItems(
-							atlasViewport, scratchViewport, blurAtlas, light.m_shadowRenderQueues[face],
-							renderQueueElementsLod, lightsToRender, atlasWorkItems, drawcallCount);
+							light.m_uuid, U32(face), lod, atlasViewport, scratchViewport, blurAtlas,
+							light.m_shadowRenderQueues[face], renderQueueElementsLod, lightsToRender, atlasWorkItems,
+							staticCacheCopyWorkItems, drawcallCount);
 					}
 
 					++numOfFacesThatHaveDrawcalls;
@@ -679,9 +805,10 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 
 			if(subResult != TileAllocatorResult::CACHED)
 			{
-				newScratchAndAtlasResloveRenderWorkItems(atlasViewport, scratchViewport, blurAtlas,
-														 light.m_shadowRenderQueue, renderQueueElementsLod,
-														 lightsToRender, atlasWorkItems, drawcallCount);
+				newScratchAndAtlasResloveRenderWorkItems(light.m_uuid, faceIdx, lod, atlasViewport, scratchViewport,
+														 blurAtlas, light.m_shadowRenderQueue, renderQueueElementsLod,
+														 lightsToRender, atlasWorkItems, staticCacheCopyWorkItems,
+														 drawcallCount);
 			}
 		}
 		else
@@ -692,15 +819,16 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 	}
 
 	// Split the work that will happen in the scratch buffer
-	if(lightsToRender.getSize())
+	if(atlasWorkItems.getSize())
 	{
 		DynamicArrayAuto<Scratch::WorkItem> workItems(ctx.m_tempAllocator);
 		Scratch::LightToRenderToScratchInfo* lightToRender = lightsToRender.getBegin();
-		U32 lightToRenderDrawcallCount = lightToRender->m_drawcallCount;
+		U32 lightToRenderDrawcallCount = (lightsToRender.getSize()) ? lightToRender->m_drawcallCount : 0;
 		const Scratch::LightToRenderToScratchInfo* lightToRenderEnd = lightsToRender.getEnd();
 
-		const U32 threadCount = computeNumberOfSecondLevelCommandBuffers(drawcallCount);
-		threadCountForScratchPass = threadCount;
+		// If there is nothing to draw (all casters are in the static cache) the scratch pass will only clear
+		const U32 threadCount = (drawcallCount) ? computeNumberOfSecondLevelCommandBuffers(drawcallCount) : 0;
+		threadCountForScratchPass = max(threadCount, 1u);
 		for(U32 taskId = 0; taskId < threadCount; ++taskId)
 		{
 			U32 start, end;
@@ -718,7 +846,8 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 				Scratch::WorkItem workItem;
 				workItem.m_viewport = lightToRender->m_viewport;
 				workItem.m_renderQueue = lightToRender->m_renderQueue;
-				workItem.m_firstRenderableElement = lightToRender->m_drawcallCount - lightToRenderDrawcallCount;
+				workItem.m_firstRenderableElement = lightToRender->m_firstRenderableElement
+													+ lightToRender->m_drawcallCount - lightToRenderDrawcallCount;
 				workItem.m_renderableElementCount = workItemDrawcallCount;
 				workItem.m_threadPoolTaskIdx = taskId;
 				workItem.m_renderQueueElementsLod = lightToRender->m_renderQueueElementsLod;
@@ -749,38 +878,147 @@ void ShadowMapping::processLights(RenderingContext& ctx, U32& threadCountForScra
 			U32 itemSize;
 			U32 itemStorageSize;
 			workItems.moveAndReset(items, itemSize, itemStorageSize);
-
-			ANKI_ASSERT(items && itemSize && itemStorageSize);
 			m_scratch.m_workItems = WeakArray<Scratch::WorkItem>(items, itemSize);
 
 			Atlas::ResolveWorkItem* atlasItems;
 			atlasWorkItems.moveAndReset(atlasItems, itemSize, itemStorageSize);
 			ANKI_ASSERT(atlasItems && itemSize && itemStorageSize);
 			m_atlas.m_resolveWorkItems = WeakArray<Atlas::ResolveWorkItem>(atlasItems, itemSize);
+
+			StaticCache::CopyWorkItem* copyItems;
+			staticCacheCopyWorkItems.moveAndReset(copyItems, itemSize, itemStorageSize);
+			m_staticCache.m_copyWorkItems = WeakArray<StaticCache::CopyWorkItem>(copyItems, itemSize);
 		}
 	}
 	else
 	{
+		ANKI_ASSERT(staticCacheCopyWorkItems.getSize() == 0);
 		m_scratch.m_workItems = WeakArray<Scratch::WorkItem>();
 		m_atlas.m_resolveWorkItems = WeakArray<Atlas::ResolveWorkItem>();
+		m_staticCache.m_copyWorkItems = WeakArray<StaticCache::CopyWorkItem>();
+	}
+}
+
+Bool ShadowMapping::updateStaticCache(U64 lightUuid, U32 faceIdx, U32 lod, const UVec4& atlasViewport,
+									  RenderQueue* lightRenderQueue, U32 renderQueueElementsLod,
+									  DynamicArrayAuto<Scratch::LightToRenderToScratchInfo>& scratchWorkItems,
+									  DynamicArrayAuto<StaticCache::CopyWorkItem>& copyWorkItems, U32& drawcallCount)
+{
+	ANKI_ASSERT(m_staticCache.m_enabled);
+	const U32 staticRenderableCount = lightRenderQueue->m_staticShadowRenderableCount;
+	const U64 staticHash = lightRenderQueue->m_staticShadowRenderablesHash;
+	const Timestamp staticTimestamp = lightRenderQueue->m_staticShadowRenderablesLastUpdateTimestamp;
+	ANKI_ASSERT(staticRenderableCount > 0);
+
+	if(ANKI_UNLIKELY(!m_staticCache.m_tex))
+	{
+		createStaticCacheTexture();
+	}
+
+	// The atlas and the static cache have the same layout. Use the 1st tile of the viewport to find the entry
+	const U32 tileX = atlasViewport[0] / m_atlas.m_tileResolution;
+	const U32 tileY = atlasViewport[1] / m_atlas.m_tileResolution;
+	StaticCache::Entry& entry = m_staticCache.m_entries[tileY * m_atlas.m_tileCountBothAxis + tileX];
+
+	if(entry.m_lightUuid == lightUuid && entry.m_faceIdx == faceIdx && entry.m_viewport == atlasViewport
+	   && entry.m_renderablesHash == staticHash && entry.m_timestamp >= staticTimestamp)
+	{
+		// Cached, only the dynamic casters will be drawn
+		ANKI_TRACE_INC_COUNTER(R_SHADOW_STATIC_CACHE_HITS, 1);
+		ANKI_TRACE_INC_COUNTER(R_SHADOW_SAVED_DRAWCALLS, staticRenderableCount);
+		return true;
+	}
+
+	// Not cached, need an additional scratch tile to render the static casters
+	Array<U32, 4> tileRanges;
+	const TileAllocatorResult res = m_scratch.m_tileAlloc.allocate(
+		m_r->getGlobalTimestamp(), lightRenderQueue->m_shadowRenderablesLastUpdateTimestamp, lightUuid, faceIdx,
+		staticRenderableCount, lod, tileRanges);
+	if(res == TileAllocatorResult::ALLOCATION_FAILED)
+	{
+		// Not a big deal, all casters will be drawn in the same tile this frame
+		return false;
+	}
+
+	const UVec4 scratchViewport = UVec4(tileRanges) * m_scratch.m_tileResolution;
+	ANKI_ASSERT(scratchViewport.zw() == atlasViewport.zw());
+	m_scratch.m_maxViewportWidth = max(m_scratch.m_maxViewportWidth, scratchViewport[0] + scratchViewport[2]);
+	m_scratch.m_maxViewportHeight = max(m_scratch.m_maxViewportHeight, scratchViewport[1] + scratchViewport[3]);
+
+	// Draw the static casters
+	Scratch::LightToRenderToScratchInfo toRender;
+	toRender.m_renderQueue = lightRenderQueue;
+	toRender.m_viewport = scratchViewport;
+	toRender.m_firstRenderableElement = 0;
+	toRender.m_drawcallCount = staticRenderableCount;
+	toRender.m_renderQueueElementsLod = renderQueueElementsLod;
+	scratchWorkItems.emplaceBack(toRender);
+	drawcallCount += staticRenderableCount;
+
+	// Copy them to the cache. One work item per scratch tile
+	const U32 tilesX = scratchViewport[2] / m_scratch.m_tileResolution;
+	const U32 tilesY = scratchViewport[3] / m_scratch.m_tileResolution;
+	for(U32 x = 0; x < tilesX; ++x)
+	{
+		for(U32 y = 0; y < tilesY; ++y)
+		{
+			StaticCache::CopyWorkItem& item = *copyWorkItems.emplaceBack();
+			item.m_scratchOffset = scratchViewport.xy() + UVec2(x, y) * m_scratch.m_tileResolution;
+			item.m_staticCacheOffset = atlasViewport.xy() + UVec2(x, y) * m_scratch.m_tileResolution;
+		}
 	}
+
+	// Invalidate all the entries that overlap with the new one
+	for(StaticCache::Entry& other : m_staticCache.m_entries)
+	{
+		const UVec4& a = other.m_viewport;
+		const UVec4& b = atlasViewport;
+		if(a[0] < b[0] + b[2] && b[0] < a[0] + a[2] && a[1] < b[1] + b[3] && b[1] < a[1] + a[3])
+		{
+			other = StaticCache::Entry();
+		}
+	}
+
+	entry.m_lightUuid = lightUuid;
+	entry.m_faceIdx = faceIdx;
+	entry.m_renderablesHash = staticHash;
+	entry.m_timestamp = staticTimestamp;
+	entry.m_viewport = atlasViewport;
+
+	ANKI_TRACE_INC_COUNTER(R_SHADOW_STATIC_CACHE_UPDATES, 1);
+	return true;
 }
 
 void ShadowMapping::newScratchAndAtlasResloveRenderWorkItems(
-	const UVec4& atlasViewport, const UVec4& scratchVewport, Bool blurAtlas, RenderQueue* lightRenderQueue,
-	U32 renderQueueElementsLod, DynamicArrayAuto<Scratch::LightToRenderToScratchInfo>& scratchWorkItem,
-	DynamicArrayAuto<Atlas::ResolveWorkItem>& atlasResolveWorkItem, U32& drawcallCount) const
+	U64 lightUuid, U32 faceIdx, U32 lod, const UVec4& atlasViewport, const UVec4& scratchVewport, Bool blurAtlas,
+	RenderQueue* lightRenderQueue, U32 renderQueueElementsLod,
+	DynamicArrayAuto<Scratch::LightToRenderToScratchInfo>& scratchWorkItem,
+	DynamicArrayAuto<Atlas::ResolveWorkItem>& atlasResolveWorkItem,
+	DynamicArrayAuto<StaticCache::CopyWorkItem>& copyWorkItems, U32& drawcallCount)
 {
-	// Scratch work item
+	// Static casters
+	const Bool useStaticCache = m_staticCache.m_enabled && lightRenderQueue->m_staticShadowRenderableCount > 0
+								&& updateStaticCache(lightUuid, faceIdx, lod, atlasViewport, lightRenderQueue,
+													 renderQueueElementsLod, scratchWorkItem, copyWorkItems,
+													 drawcallCount);
+
+	// Scratch work item. If there is a static cache draw only the dynamic casters
 	{
-		Scratch::LightToRenderToScratchInfo toRender;
-		toRender.m_renderQueue = lightRenderQueue;
-		toRender.m_viewport = scratchVewport;
-		toRender.m_drawcallCount = lightRenderQueue->m_renderables.getSize();
-		toRender.m_renderQueueElementsLod = renderQueueElementsLod;
+		const U32 firstRenderable = (useStaticCache) ? lightRenderQueue->m_staticShadowRenderableCount : 0;
+		const U32 renderableCount = lightRenderQueue->m_renderables.getSize() - firstRenderable;
 
-		scratchWorkItem.emplaceBack(toRender);
-		drawcallCount += lightRenderQueue->m_renderables.getSize();
+		if(renderableCount)
+		{
+			Scratch::LightToRenderToScratchInfo toRender;
+			toRender.m_renderQueue = lightRenderQueue;
+			toRender.m_viewport = scratchVewport;
+			toRender.m_firstRenderableElement = firstRenderable;
+			toRender.m_drawcallCount = renderableCount;
+			toRender.m_renderQueueElementsLod = renderQueueElementsLod;
+
+			scratchWorkItem.emplaceBack(toRender);
+			drawcallCount += renderableCount;
+		}
 	}
 
 	// Atlas resolve work items
@@ -810,7 +1048,11 @@ void ShadowMapping::newScratchAndAtlasResloveRenderWorkItems(
 			atlasItem.m_viewportOut[2] = atlasViewport[2] / tilesX;
 			atlasItem.m_viewportOut[3] = atlasViewport[3] / tilesY;
 
+			const F32 atlasSize = F32(m_atlas.m_tileCountBothAxis * m_atlas.m_tileResolution);
+			atlasItem.m_staticCacheUv = Vec4(atlasViewport) / atlasSize;
+
 			atlasItem.m_blur = blurAtlas;
+			atlasItem.m_staticCache = useStaticCache;
 
 			atlasResolveWorkItem.emplaceBack(atlasItem);
 		}
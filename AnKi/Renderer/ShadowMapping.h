@@ -95,6 +95,44 @@ private:
 	void runShadowMapping(RenderPassWorkContext& rgraphCtx);
 	/// @}
 
+	/// @name Static cache stuff
+	/// @{
+
+	/// Holds the depth of the static shadow casters. That way when something moves only the dynamic casters need to be
+	/// re-rendered. It has the same layout as the atlas.
+	class StaticCache
+	{
+	public:
+		class Entry;
+		class CopyWorkItem;
+
+		TexturePtr m_tex; ///< Same size as the atlas. Created when the first static caster shows up.
+		RenderTargetHandle m_rt;
+
+		DynamicArray<Entry> m_entries; ///< One per atlas tile. It's the face that is cached at that tile.
+
+		ShaderProgramResourcePtr m_copyProg;
+		ShaderProgramPtr m_copyGrProg;
+
+		WeakArray<CopyWorkItem> m_copyWorkItems;
+
+		Bool m_enabled = false;
+	} m_staticCache;
+
+	ANKI_USE_RESULT Error initStaticCache(const ConfigSet& cfg);
+
+	void createStaticCacheTexture();
+
+	void runStaticCacheCopy(RenderPassWorkContext& rgraphCtx);
+
+	/// Find if the static casters of a light face are already cached. If not try to schedule an update of the cache.
+	/// @return True if the static casters are or will be in the cache this frame.
+	Bool updateStaticCache(U64 lightUuid, U32 faceIdx, U32 lod, const UVec4& atlasViewport,
+						   RenderQueue* lightRenderQueue, U32 renderQueueElementsLod,
+						   DynamicArrayAuto<Scratch::LightToRenderToScratchInfo>& scratchWorkItems,
+						   DynamicArrayAuto<StaticCache::CopyWorkItem>& copyWorkItems, U32& drawcallCount);
+	/// @}
+
 	/// @name Misc & common
 	/// @{
 
@@ -116,9 +154,11 @@ private:
 
 	/// Add new work to render to scratch buffer and atlas buffer.
 	void newScratchAndAtlasResloveRenderWorkItems(
-		const UVec4& atlasViewport, const UVec4& scratchVewport, Bool blurAtlas, RenderQueue* lightRenderQueue,
-		U32 renderQueueElementsLod, DynamicArrayAuto<Scratch::LightToRenderToScratchInfo>& scratchWorkItem,
-		DynamicArrayAuto<Atlas::ResolveWorkItem>& atlasResolveWorkItem, U32& drawcallCount) const;
+		U64 lightUuid, U32 faceIdx, U32 lod, const UVec4& atlasViewport, const UVec4& scratchVewport, Bool blurAtlas,
+		RenderQueue* lightRenderQueue, U32 renderQueueElementsLod,
+		DynamicArrayAuto<Scratch::LightToRenderToScratchInfo>& scratchWorkItem,
+		DynamicArrayAuto<Atlas::ResolveWorkItem>& atlasResolveWorkItem,
+		DynamicArrayAuto<StaticCache::CopyWorkItem>& copyWorkItems, U32& drawcallCount);
 
 	/// Iterate lights and create work items.
 	void processLights(RenderingContext& ctx, U32& threadCountForScratchPass);
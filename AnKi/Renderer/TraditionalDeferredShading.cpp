@@ -54,7 +54,7 @@ Error TraditionalDeferredLightShading::init()
 }
 
 void TraditionalDeferredLightShading::bindVertexIndexBuffers(MeshResourcePtr& mesh, CommandBufferPtr& cmdb,
-															 U32& indexCount)
+															 U32& indexCount, Mat4& positionDequantization)
 {
 	// Attrib
 	U32 bufferBinding;
@@ -76,6 +76,9 @@ void TraditionalDeferredLightShading::bindVertexIndexBuffers(MeshResourcePtr& me
 	mesh->getIndexBufferInfo(buff, offset, indexCount, idxType);
 
 	cmdb->bindIndexBuffer(buff, offset, idxType);
+
+	const Vec4& dequantization = mesh->getPositionDequantization();
+	positionDequantization = Mat4(dequantization.xyz1(), Mat3::getIdentity(), dequantization.w());
 }
 
 void TraditionalDeferredLightShading::drawLights(TraditionalDeferredLightShadingDrawInfo& info)
@@ -127,7 +130,8 @@ void TraditionalDeferredLightShading::drawLights(TraditionalDeferredLightShading
 
 	// Do point lights
 	U32 indexCount;
-	bindVertexIndexBuffers(m_plightMesh, cmdb, indexCount);
+	Mat4 positionDequantization;
+	bindVertexIndexBuffers(m_plightMesh, cmdb, indexCount, positionDequantization);
 	cmdb->bindShaderProgram(m_plightGrProg[info.m_computeSpecular]);
 
 	for(const PointLightQueueElement& plightEl : info.m_pointLights)
@@ -138,7 +142,7 @@ void TraditionalDeferredLightShading::drawLights(TraditionalDeferredLightShading
 
 		Mat4 modelM(plightEl.m_worldPosition.xyz1(), Mat3::getIdentity(), plightEl.m_radius);
 
-		vert->m_mvp = info.m_viewProjectionMatrix * modelM;
+		vert->m_mvp = info.m_viewProjectionMatrix * modelM * positionDequantization;
 
 		DeferredPointLightUniforms* light =
 			allocateAndBindUniforms<DeferredPointLightUniforms*>(sizeof(DeferredPointLightUniforms), cmdb, 0, 1);
@@ -158,7 +162,7 @@ void TraditionalDeferredLightShading::drawLights(TraditionalDeferredLightShading
 	}
 
 	// Do spot lights
-	bindVertexIndexBuffers(m_slightMesh, cmdb, indexCount);
+	bindVertexIndexBuffers(m_slightMesh, cmdb, indexCount, positionDequantization);
 	cmdb->bindShaderProgram(m_slightGrProg[info.m_computeSpecular]);
 
 	for(const SpotLightQueueElement& splightEl : info.m_spotLights)
@@ -174,7 +178,7 @@ void TraditionalDeferredLightShading::drawLights(TraditionalDeferredLightShading
 		scaleM(1, 1) = scaleM(0, 0);
 		scaleM(2, 2) = splightEl.m_distance;
 
-		modelM = modelM * scaleM;
+		modelM = modelM * scaleM * positionDequantization;
 
 		// Update vertex uniforms
 		DeferredVertexUniforms* vert =
@@ -59,7 +59,9 @@ private:
 	MeshResourcePtr m_slightMesh;
 	/// @}
 
-	static void bindVertexIndexBuffers(MeshResourcePtr& mesh, CommandBufferPtr& cmdb, U32& indexCount);
+	/// @param[out] positionDequantization Brings the (maybe quantized) positions to the space of the mesh.
+	static void bindVertexIndexBuffers(MeshResourcePtr& mesh, CommandBufferPtr& cmdb, U32& indexCount,
+									   Mat4& positionDequantization);
 };
 /// @}
 } // end namespace anki
@@ -34,6 +34,7 @@ static const Array<BuiltinVarInfo, U(BuiltinMaterialVariableId::COUNT)> BUILTIN_
 	 {"m_ankiRotationMatrix", ShaderVariableDataType::MAT3, true},
 	 {"m_ankiCameraRotationMatrix", ShaderVariableDataType::MAT3, false},
 	 {"m_ankiCameraPosition", ShaderVariableDataType::VEC3, false},
+	 {"m_ankiPositionDequantization", ShaderVariableDataType::VEC4, false},
 	 {"u_ankiGlobalSampler", ShaderVariableDataType::SAMPLER, false}}};
 
 static ANKI_USE_RESULT Error checkBuiltin(CString name, ShaderVariableDataType dataType, Bool instanced,
@@ -188,10 +189,6 @@ MaterialResource::~MaterialResource()
 		}
 	}
 
-	for(MaterialVariable& var : m_vars)
-	{
-		var.m_name.destroy(getAllocator());
-	}
 	m_vars.destroy(getAllocator());
 
 	m_nonBuiltinsMutation.destroy(getAllocator());
@@ -690,7 +687,7 @@ Error MaterialResource::createVars()
 			}
 
 			MaterialVariable& in = *m_vars.emplaceBack(getAllocator());
-			in.m_name.create(getAllocator(), name);
+			in.m_name = StringId(name);
 			in.m_index = m_vars.getSize() - 1;
 			in.m_indexInBinary = U32(&var - block.m_variables.getBegin());
 			in.m_constant = false;
@@ -730,7 +727,7 @@ Error MaterialResource::createVars()
 		}
 
 		MaterialVariable& in = *m_vars.emplaceBack(getAllocator());
-		in.m_name.create(getAllocator(), o.m_name.getBegin());
+		in.m_name = StringId(o.m_name.getBegin());
 		in.m_index = m_vars.getSize() - 1;
 		in.m_indexInBinary = U32(&o - binary.m_opaques.getBegin());
 		in.m_constant = false;
@@ -739,7 +736,7 @@ Error MaterialResource::createVars()
 		in.m_opaqueBinding = o.m_binding;
 
 		// Check if it's builtin
-		ANKI_CHECK(checkBuiltin(in.m_name, in.m_dataType, false, in.m_builtin));
+		ANKI_CHECK(checkBuiltin(in.m_name.toCString(), in.m_dataType, false, in.m_builtin));
 	}
 
 	if(descriptorSet != maxDescriptorSet)
@@ -754,7 +751,7 @@ Error MaterialResource::createVars()
 	for(const ShaderProgramResourceConstant& c : m_prog->getConstants())
 	{
 		MaterialVariable& in = *m_vars.emplaceBack(getAllocator());
-		in.m_name.create(getAllocator(), c.m_name);
+		in.m_name = StringId(c.m_name.toCString());
 		in.m_index = m_vars.getSize() - 1;
 		in.m_constant = true;
 		in.m_instanced = false;
@@ -822,6 +819,26 @@ Error MaterialResource::parseInputs(XmlElement inputsEl, Bool async)
 				return Error::USER_DATA;
 			}
 
+			// An U32 that has a bindlessTexture instead of a value is an index to the bindless texture set
+			CString bindlessTexFname;
+			Bool bindlessTex;
+			ANKI_CHECK(inputEl.getAttributeTextOptional("bindlessTexture", bindlessTexFname, bindlessTex));
+			if(bindlessTex)
+			{
+				if(foundVar->getDataType() != ShaderVariableDataType::U32)
+				{
+					ANKI_RESOURCE_LOGE("Only U32 variables can hold bindless textures: %s", varName.cstr());
+					return Error::USER_DATA;
+				}
+
+				ANKI_CHECK(getManager().loadResource(bindlessTexFname, foundVar->m_image, async));
+				foundVar->m_U32 = foundVar->m_image->getTextureView()->getOrCreateBindlessTextureIndex();
+				m_bindlessTextures = true;
+
+				ANKI_CHECK(inputEl.getNextSiblingElement("input", inputEl));
+				continue;
+			}
+
 			switch(foundVar->getDataType())
 			{
 #define ANKI_SVDT_MACRO(capital, type, baseType, rowCount, columnCount) \
@@ -988,7 +1005,7 @@ void MaterialResource::initVariant(const ShaderProgramResourceVariant& progVaria
 		{
 			for(const ShaderProgramResourceConstant& c : m_prog->getConstants())
 			{
-				if(c.m_name == var.m_name)
+				if(c.m_name.toCString() == var.m_name.toCString())
 				{
 					variant.m_activeVars.set(var.m_index, progVariant.isConstantActive(c));
 					break;
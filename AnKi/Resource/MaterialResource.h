@@ -36,6 +36,7 @@ enum class BuiltinMaterialVariableId : U8
 	ROTATION_MATRIX,
 	CAMERA_ROTATION_MATRIX,
 	CAMERA_POSITION,
+	POSITION_DEQUANTIZATION, ///< See MeshResource::getPositionDequantization().
 	GLOBAL_SAMPLER,
 
 	COUNT,
@@ -80,7 +81,7 @@ public:
 
 	MaterialVariable& operator=(MaterialVariable&& b)
 	{
-		m_name = std::move(b.m_name);
+		m_name = b.m_name;
 		m_index = b.m_index;
 		m_indexInBinary = b.m_indexInBinary;
 		m_indexInBinary2ndElement = b.m_indexInBinary2ndElement;
@@ -103,7 +104,7 @@ public:
 
 	CString getName() const
 	{
-		return m_name;
+		return m_name.toCString();
 	}
 
 	template<typename T>
@@ -115,6 +116,12 @@ public:
 			   && m_dataType <= ShaderVariableDataType::TEXTURE_LAST;
 	}
 
+	/// It's an U32 that holds the index of a texture in the bindless descriptor set.
+	Bool isBindlessTexture() const
+	{
+		return m_dataType == ShaderVariableDataType::U32 && m_image.isCreated();
+	}
+
 	Bool isSampler() const
 	{
 		return m_dataType == ShaderVariableDataType::SAMPLER;
@@ -154,7 +161,7 @@ public:
 	}
 
 protected:
-	String m_name;
+	StringId m_name;
 	U32 m_index = MAX_U32;
 	U32 m_indexInBinary = MAX_U32;
 	U32 m_indexInBinary2ndElement = MAX_U32; ///< To calculate the stride.
@@ -203,7 +210,7 @@ protected:
 template<>
 inline const ImageResourcePtr& MaterialVariable::getValue() const
 {
-	ANKI_ASSERT(isTexture());
+	ANKI_ASSERT(isTexture() || isBindlessTexture());
 	ANKI_ASSERT(m_builtin == BuiltinMaterialVariableId::NONE);
 	return m_image;
 }
@@ -291,7 +298,7 @@ private:
 ///		</mutation>]
 ///
 ///		[<inputs>
-///			<input shaderVar="name to shaderProg var" value="values"/> (1)
+///			<input shaderVar="name to shaderProg var" value="values" | bindlessTexture="filename"/> (1) (2)
 ///		</inputs>]
 /// </material>
 ///
@@ -309,6 +316,9 @@ private:
 /// @endcode
 ///
 /// (1): Only for non-builtins.
+/// (2): If the shader var is an U32 and it has a bindlessTexture instead of a value then the var will hold the index of
+///      the texture in the bindless descriptor set. The shader should declare that set using ANKI_BINDLESS_SET at the
+///      set that follows the material's set.
 class MaterialResource : public ResourceObject
 {
 public:
@@ -355,6 +365,19 @@ public:
 		return m_descriptorSetIdx;
 	}
 
+	/// Some variables are indices to the bindless textures. If that's the case the bindless descriptor set should be
+	/// bound to getBindlessDescriptorSetIndex().
+	Bool usesBindlessTextures() const
+	{
+		return m_bindlessTextures;
+	}
+
+	U32 getBindlessDescriptorSetIndex() const
+	{
+		ANKI_ASSERT(usesBindlessTextures());
+		return getDescriptorSetIndex() + 1;
+	}
+
 	U32 getBoneTransformsStorageBlockBinding() const
 	{
 		ANKI_ASSERT(supportsSkinning());
@@ -426,6 +449,7 @@ private:
 
 	Bool m_shadow = true;
 	Bool m_forwardShading = false;
+	Bool m_bindlessTextures = false;
 	U8 m_lodCount = 1;
 	U8 m_descriptorSetIdx = MAX_U8; ///< The material set.
 	U32 m_perDrawUboIdx = MAX_U32; ///< The b_perDraw UBO inside the binary.
@@ -468,9 +492,15 @@ private:
 
 	const MaterialVariable* tryFindVariableInternal(CString name) const
 	{
+		const StringId nameId = StringId::tryFind(name);
+		if(!nameId)
+		{
+			return nullptr;
+		}
+
 		for(const MaterialVariable& v : m_vars)
 		{
-			if(v.m_name == name)
+			if(v.m_name == nameId)
 			{
 				return &v;
 			}
@@ -15,7 +15,11 @@ namespace anki {
 /// @addtogroup resource
 /// @{
 
-static constexpr const char* MESH_MAGIC = "ANKIMES5";
+static constexpr const char* MESH_MAGIC = "ANKIMES7";
+
+/// The previous versions of the format. Their header is the same minus some members at the end of MeshBinaryHeader.
+static constexpr const char* MESH_MAGIC_V6 = "ANKIMES6";
+static constexpr const char* MESH_MAGIC_V5 = "ANKIMES5";
 
 constexpr U32 MESH_BINARY_BUFFER_ALIGNMENT = 16;
 
@@ -24,8 +28,9 @@ enum class MeshBinaryFlag : U32
 	NONE = 0,
 	QUAD = 1 << 0,
 	CONVEX = 1 << 1,
+	COMPRESSED = 1 << 2, ///< The index and vertex buffers are encoded with meshoptimizer's codecs.
 
-	ALL = QUAD | CONVEX,
+	ALL = QUAD | CONVEX | COMPRESSED,
 };
 ANKI_ENUM_ALLOW_NUMERIC_OPERATIONS(MeshBinaryFlag)
 
@@ -66,6 +71,8 @@ public:
 	Format m_format;
 
 	U32 m_relativeOffset;
+
+	/// R16G16B16A16_UNORM positions are MeshBinaryHeader::m_aabbMin plus the value times the scale.
 	F32 m_scale;
 
 	template<typename TSerializer, typename TClass>
@@ -125,8 +132,56 @@ public:
 	}
 };
 
-/// The 1st things that appears in a mesh binary. @note The index and vertex buffers are aligned to
-/// MESH_BINARY_BUFFER_ALIGNMENT bytes.
+/// A cluster of triangles. The triangles of a meshlet are contiguous in the index buffer and the meshlets cover the
+/// whole index buffer in order.
+class MeshBinaryMeshlet
+{
+public:
+	U32 m_firstIndex;
+	U32 m_indexCount;
+
+	/// Bounding sphere center.
+	Vec3 m_sphereCenter;
+
+	/// Bounding sphere radius.
+	F32 m_sphereRadius;
+
+	/// The apex of the cone of the triangle normals.
+	Vec3 m_coneApex;
+
+	/// The axis of the cone of the triangle normals.
+	Vec3 m_coneAxis;
+
+	/// The cosine of half the cone angle. It's 1.0 if the cone can't be used for culling.
+	F32 m_coneCutoff;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_firstIndex", offsetof(MeshBinaryMeshlet, m_firstIndex), self.m_firstIndex);
+		s.doValue("m_indexCount", offsetof(MeshBinaryMeshlet, m_indexCount), self.m_indexCount);
+		s.doValue("m_sphereCenter", offsetof(MeshBinaryMeshlet, m_sphereCenter), self.m_sphereCenter);
+		s.doValue("m_sphereRadius", offsetof(MeshBinaryMeshlet, m_sphereRadius), self.m_sphereRadius);
+		s.doValue("m_coneApex", offsetof(MeshBinaryMeshlet, m_coneApex), self.m_coneApex);
+		s.doValue("m_coneAxis", offsetof(MeshBinaryMeshlet, m_coneAxis), self.m_coneAxis);
+		s.doValue("m_coneCutoff", offsetof(MeshBinaryMeshlet, m_coneCutoff), self.m_coneCutoff);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, MeshBinaryMeshlet&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const MeshBinaryMeshlet&>(serializer, *this);
+	}
+};
+
+/// The 1st things that appears in a mesh binary. It's followed by the sub meshes, the meshlets, the index buffer and
+/// the vertex buffers. @note The index and vertex buffers are aligned to MESH_BINARY_BUFFER_ALIGNMENT bytes.
 class MeshBinaryHeader
 {
 public:
@@ -147,6 +202,15 @@ public:
 	/// Bounding box max.
 	Vec3 m_aabbMax;
 
+	/// The size of the index buffer in the file if it's MeshBinaryFlag::COMPRESSED.
+	U32 m_compressedIndexBufferSize;
+
+	/// The size of the vertex buffers in the file if it's MeshBinaryFlag::COMPRESSED.
+	Array<U32, U32(VertexAttributeId::COUNT)> m_compressedVertexBufferSizes;
+
+	/// The number of MeshBinaryMeshlet that follow the sub meshes. It might be zero.
+	U32 m_meshletCount;
+
 	template<typename TSerializer, typename TClass>
 	static void serializeCommon(TSerializer& s, TClass self)
 	{
@@ -164,6 +228,11 @@ public:
 		s.doValue("m_subMeshCount", offsetof(MeshBinaryHeader, m_subMeshCount), self.m_subMeshCount);
 		s.doValue("m_aabbMin", offsetof(MeshBinaryHeader, m_aabbMin), self.m_aabbMin);
 		s.doValue("m_aabbMax", offsetof(MeshBinaryHeader, m_aabbMax), self.m_aabbMax);
+		s.doValue("m_compressedIndexBufferSize", offsetof(MeshBinaryHeader, m_compressedIndexBufferSize),
+				  self.m_compressedIndexBufferSize);
+		s.doArray("m_compressedVertexBufferSizes", offsetof(MeshBinaryHeader, m_compressedVertexBufferSizes),
+				  &self.m_compressedVertexBufferSizes[0], self.m_compressedVertexBufferSizes.getSize());
+		s.doValue("m_meshletCount", offsetof(MeshBinaryHeader, m_meshletCount), self.m_meshletCount);
 	}
 
 	template<typename TDeserializer>
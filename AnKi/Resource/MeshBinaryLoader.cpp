@@ -5,6 +5,7 @@
 
 #include <AnKi/Resource/MeshBinaryLoader.h>
 #include <AnKi/Resource/ResourceManager.h>
+#include <MeshOptimizer/meshoptimizer.h>
 
 namespace anki {
 
@@ -13,9 +14,15 @@ MeshBinaryLoader::MeshBinaryLoader(ResourceManager* manager)
 {
 }
 
+MeshBinaryLoader::MeshBinaryLoader(ResourceManager* manager, GenericMemoryPoolAllocator<U8> alloc)
+	: MeshBinaryLoader(&manager->getFilesystem(), alloc)
+{
+}
+
 MeshBinaryLoader::~MeshBinaryLoader()
 {
 	m_subMeshes.destroy(m_alloc);
+	m_meshlets.destroy(m_alloc);
 }
 
 Error MeshBinaryLoader::load(const ResourceFilename& filename)
@@ -23,9 +30,10 @@ Error MeshBinaryLoader::load(const ResourceFilename& filename)
 	auto& alloc = m_alloc;
 
 	// Load header
-	ANKI_CHECK(m_manager->getFilesystem().openFile(filename, m_file));
-	ANKI_CHECK(m_file->read(&m_header, sizeof(m_header)));
+	ANKI_CHECK(m_fs->openFile(filename, m_file));
+	ANKI_CHECK(readHeader());
 	ANKI_CHECK(checkHeader());
+	computeStoredVertexLayout();
 
 	// Read submesh info
 	{
@@ -46,7 +54,7 @@ Error MeshBinaryLoader::load(const ResourceFilename& filename)
 
 			for(U d = 0; d < 3; ++d)
 			{
-				if(sm.m_aabbMin[i] >= sm.m_aabbMax[i])
+				if(sm.m_aabbMin[d] >= sm.m_aabbMax[d])
 				{
 					ANKI_RESOURCE_LOGE("Wrong bounding box");
 					return Error::USER_DATA;
@@ -63,6 +71,82 @@ Error MeshBinaryLoader::load(const ResourceFilename& filename)
 		}
 	}
 
+	// Read the meshlets
+	if(m_header.m_meshletCount > 0)
+	{
+		m_meshlets.create(alloc, m_header.m_meshletCount);
+		ANKI_CHECK(m_file->read(&m_meshlets[0], m_meshlets.getSizeInBytes()));
+
+		// Checks. They should cover the index buffer in order without crossing the sub mesh boundaries
+		U32 idxSum = 0;
+		U32 subMeshIdx = 0;
+		for(const MeshBinaryMeshlet& meshlet : m_meshlets)
+		{
+			while(subMeshIdx < m_subMeshes.getSize()
+				  && idxSum >= m_subMeshes[subMeshIdx].m_firstIndex + m_subMeshes[subMeshIdx].m_indexCount)
+			{
+				++subMeshIdx;
+			}
+
+			if(meshlet.m_firstIndex != idxSum || meshlet.m_indexCount == 0 || (meshlet.m_indexCount % 3) != 0
+			   || subMeshIdx == m_subMeshes.getSize()
+			   || meshlet.m_firstIndex + meshlet.m_indexCount
+					  > m_subMeshes[subMeshIdx].m_firstIndex + m_subMeshes[subMeshIdx].m_indexCount)
+			{
+				ANKI_RESOURCE_LOGE("Incorrect meshlet info");
+				return Error::USER_DATA;
+			}
+
+			idxSum += meshlet.m_indexCount;
+		}
+
+		if(idxSum != m_header.m_totalIndexCount)
+		{
+			ANKI_RESOURCE_LOGE("Incorrect meshlet info");
+			return Error::USER_DATA;
+		}
+	}
+
+	return Error::NONE;
+}
+
+Error MeshBinaryLoader::readHeader()
+{
+	// The older versions have the same header minus some members at the end
+	constexpr PtrSize v5HeaderSize = offsetof(MeshBinaryHeader, m_compressedIndexBufferSize);
+	constexpr PtrSize v6HeaderSize = offsetof(MeshBinaryHeader, m_meshletCount);
+	memset(&m_header, 0, sizeof(m_header));
+	ANKI_CHECK(m_file->read(&m_header, v5HeaderSize));
+
+	if(memcmp(&m_header.m_magic[0], MESH_MAGIC, 8) == 0)
+	{
+		m_headerSize = sizeof(m_header);
+	}
+	else if(memcmp(&m_header.m_magic[0], MESH_MAGIC_V6, 8) == 0)
+	{
+		m_headerSize = v6HeaderSize;
+	}
+	else if(memcmp(&m_header.m_magic[0], MESH_MAGIC_V5, 8) == 0)
+	{
+		m_headerSize = v5HeaderSize;
+
+		if(!!(m_header.m_flags & MeshBinaryFlag::COMPRESSED))
+		{
+			ANKI_RESOURCE_LOGE("Compression is not supported in this version");
+			return Error::USER_DATA;
+		}
+	}
+	else
+	{
+		ANKI_RESOURCE_LOGE("Wrong magic word");
+		return Error::USER_DATA;
+	}
+
+	if(m_headerSize > v5HeaderSize)
+	{
+		ANKI_CHECK(m_file->read(reinterpret_cast<U8*>(&m_header) + v5HeaderSize, m_headerSize - v5HeaderSize));
+	}
+
 	return Error::NONE;
 }
 
@@ -108,8 +192,16 @@ Error MeshBinaryLoader::checkFormat(VertexAttributeId type, ConstWeakArray<Forma
 		return Error::USER_DATA;
 	}
 
-	// Scale should be 1.0 for now
-	if(attrib.m_scale != 1.0f)
+	// Only the quantized positions have a scale
+	if(attrib.m_format == Format::R16G16B16A16_UNORM)
+	{
+		if(!(attrib.m_scale > 0.0f))
+		{
+			ANKI_RESOURCE_LOGE("Vertex attribute %u should have a positive scale", U32(type));
+			return Error::USER_DATA;
+		}
+	}
+	else if(attrib.m_scale != 1.0f)
 	{
 		ANKI_RESOURCE_LOGE("Vertex attribute %u should have 1.0 scale", U32(type));
 		return Error::USER_DATA;
@@ -122,13 +214,6 @@ Error MeshBinaryLoader::checkHeader() const
 {
 	const MeshBinaryHeader& h = m_header;
 
-	// Header
-	if(memcmp(&h.m_magic[0], MESH_MAGIC, 8) != 0)
-	{
-		ANKI_RESOURCE_LOGE("Wrong magic word");
-		return Error::USER_DATA;
-	}
-
 	// Flags
 	if((h.m_flags & ~MeshBinaryFlag::ALL) != MeshBinaryFlag::NONE)
 	{
@@ -137,10 +222,12 @@ Error MeshBinaryLoader::checkHeader() const
 	}
 
 	// Attributes
-	ANKI_CHECK(checkFormat(VertexAttributeId::POSITION, Array<Format, 1>{{Format::R32G32B32_SFLOAT}}, 0, 0));
+	ANKI_CHECK(checkFormat(VertexAttributeId::POSITION,
+						   Array<Format, 2>{{Format::R32G32B32_SFLOAT, Format::R16G16B16A16_UNORM}}, 0, 0));
 	ANKI_CHECK(checkFormat(VertexAttributeId::NORMAL, Array<Format, 1>{{Format::A2B10G10R10_SNORM_PACK32}}, 1, 0));
 	ANKI_CHECK(checkFormat(VertexAttributeId::TANGENT, Array<Format, 1>{{Format::A2B10G10R10_SNORM_PACK32}}, 1, 4));
-	ANKI_CHECK(checkFormat(VertexAttributeId::UV0, Array<Format, 1>{{Format::R32G32_SFLOAT}}, 1, 8));
+	ANKI_CHECK(
+		checkFormat(VertexAttributeId::UV0, Array<Format, 2>{{Format::R32G32_SFLOAT, Format::R16G16_SFLOAT}}, 1, 8));
 	ANKI_CHECK(checkFormat(VertexAttributeId::UV1, Array<Format, 1>{{Format::NONE}}, 1, 0));
 	ANKI_CHECK(
 		checkFormat(VertexAttributeId::BONE_INDICES, Array<Format, 2>{{Format::NONE, Format::R8G8B8A8_UINT}}, 2, 0));
@@ -154,7 +241,11 @@ Error MeshBinaryLoader::checkHeader() const
 		return Error::USER_DATA;
 	}
 
-	if(m_header.m_vertexBuffers[0].m_vertexStride != sizeof(Vec3) || m_header.m_vertexBuffers[1].m_vertexStride != 16
+	const U32 positionStride =
+		(h.m_vertexAttributes[VertexAttributeId::POSITION].m_format == Format::R32G32B32_SFLOAT) ? sizeof(Vec3) : 8;
+	const U32 mainStride = (h.m_vertexAttributes[VertexAttributeId::UV0].m_format == Format::R32G32_SFLOAT) ? 16 : 12;
+	if(m_header.m_vertexBuffers[0].m_vertexStride != positionStride
+	   || m_header.m_vertexBuffers[1].m_vertexStride != mainStride
 	   || (hasBoneInfo() && m_header.m_vertexBuffers[2].m_vertexStride != 8))
 	{
 		ANKI_RESOURCE_LOGE("Some of the vertex buffers have incorrect vertex stride");
@@ -200,15 +291,32 @@ Error MeshBinaryLoader::checkHeader() const
 		}
 	}
 
+	// Compression. The index codec only works with triangles
+	if(isCompressed())
+	{
+		Bool sizesOk = h.m_compressedIndexBufferSize > 0;
+		for(U32 i = 0; i < h.m_vertexBufferCount; ++i)
+		{
+			sizesOk = sizesOk && h.m_compressedVertexBufferSizes[i] > 0;
+		}
+
+		if(!sizesOk || !!(h.m_flags & MeshBinaryFlag::QUAD))
+		{
+			ANKI_RESOURCE_LOGE("Wrong compressed buffers");
+			return Error::USER_DATA;
+		}
+	}
+
 	// Check the file size
-	PtrSize totalSize = sizeof(m_header);
+	PtrSize totalSize = m_headerSize;
 
 	totalSize += sizeof(MeshBinarySubMesh) * m_header.m_subMeshCount;
-	totalSize += getAlignedIndexBufferSize();
+	totalSize += sizeof(MeshBinaryMeshlet) * m_header.m_meshletCount;
+	totalSize += getAlignedIndexBufferSizeInFile();
 
 	for(U32 i = 0; i < m_header.m_vertexBufferCount; ++i)
 	{
-		totalSize += getAlignedVertexBufferSize(i);
+		totalSize += getAlignedVertexBufferSizeInFile(i);
 	}
 
 	if(totalSize != m_file->getSize())
@@ -220,15 +328,88 @@ Error MeshBinaryLoader::checkHeader() const
 	return Error::NONE;
 }
 
+void MeshBinaryLoader::computeStoredVertexLayout()
+{
+	for(U32 i = 0; i < m_header.m_vertexBufferCount; ++i)
+	{
+		m_storedVertexBuffers[i] = m_header.m_vertexBuffers[i];
+	}
+
+	for(VertexAttributeId attrib = VertexAttributeId::FIRST; attrib < VertexAttributeId::COUNT; ++attrib)
+	{
+		m_storedVertexAttributes[attrib] = m_header.m_vertexAttributes[attrib];
+	}
+
+	if(m_dequantizePositions)
+	{
+		MeshBinaryVertexAttribute& pos = m_storedVertexAttributes[VertexAttributeId::POSITION];
+		pos.m_format = Format::R32G32B32_SFLOAT;
+		pos.m_scale = 1.0f;
+		m_storedVertexBuffers[pos.m_bufferBinding].m_vertexStride = sizeof(Vec3);
+	}
+
+	MeshBinaryVertexAttribute& uv = m_storedVertexAttributes[VertexAttributeId::UV0];
+	uv.m_format = Format::R16G16_SFLOAT;
+	m_storedVertexBuffers[uv.m_bufferBinding].m_vertexStride = sizeof(MainVertex);
+}
+
 Error MeshBinaryLoader::storeIndexBuffer(void* ptr, PtrSize size)
 {
 	ANKI_ASSERT(ptr);
 	ANKI_ASSERT(isLoaded());
 	ANKI_ASSERT(size == getIndexBufferSize());
 
-	const PtrSize seek = sizeof(m_header) + m_subMeshes.getSizeInBytes();
+	const PtrSize seek = getIndexBufferOffsetInFile();
 	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::BEGINNING));
-	ANKI_CHECK(m_file->read(ptr, size));
+
+	if(!isCompressed())
+	{
+		ANKI_CHECK(m_file->read(ptr, size));
+	}
+	else
+	{
+		DynamicArrayAuto<U8, PtrSize> encoded(m_alloc);
+		encoded.create(m_header.m_compressedIndexBufferSize);
+		ANKI_CHECK(m_file->read(&encoded[0], encoded.getSizeInBytes()));
+
+		const PtrSize indexSize = (m_header.m_indexType == IndexType::U16) ? 2 : 4;
+		if(meshopt_decodeIndexBuffer(ptr, m_header.m_totalIndexCount, indexSize, &encoded[0], encoded.getSize()) != 0)
+		{
+			ANKI_RESOURCE_LOGE("Failed to decode the index buffer");
+			return Error::USER_DATA;
+		}
+	}
+
+	return Error::NONE;
+}
+
+Error MeshBinaryLoader::readVertexBuffer(U32 bufferIdx, void* ptr)
+{
+	PtrSize seek = getIndexBufferOffsetInFile() + getAlignedIndexBufferSizeInFile();
+	for(U32 i = 0; i < bufferIdx; ++i)
+	{
+		seek += getAlignedVertexBufferSizeInFile(i);
+	}
+
+	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::BEGINNING));
+
+	if(!isCompressed())
+	{
+		ANKI_CHECK(m_file->read(ptr, getVertexBufferSize(bufferIdx)));
+	}
+	else
+	{
+		DynamicArrayAuto<U8, PtrSize> encoded(m_alloc);
+		encoded.create(m_header.m_compressedVertexBufferSizes[bufferIdx]);
+		ANKI_CHECK(m_file->read(&encoded[0], encoded.getSizeInBytes()));
+
+		const U32 stride = m_header.m_vertexBuffers[bufferIdx].m_vertexStride;
+		if(meshopt_decodeVertexBuffer(ptr, m_header.m_totalVertexCount, stride, &encoded[0], encoded.getSize()) != 0)
+		{
+			ANKI_RESOURCE_LOGE("Failed to decode vertex buffer %u", bufferIdx);
+			return Error::USER_DATA;
+		}
+	}
 
 	return Error::NONE;
 }
@@ -238,16 +419,41 @@ Error MeshBinaryLoader::storeVertexBuffer(U32 bufferIdx, void* ptr, PtrSize size
 	ANKI_ASSERT(ptr);
 	ANKI_ASSERT(isLoaded());
 	ANKI_ASSERT(bufferIdx < m_header.m_vertexBufferCount);
-	ANKI_ASSERT(size == getVertexBufferSize(bufferIdx));
+	ANKI_ASSERT(size == getStoredVertexBufferSize(bufferIdx));
 
-	PtrSize seek = sizeof(m_header) + m_subMeshes.getSizeInBytes() + getAlignedIndexBufferSize();
-	for(U32 i = 0; i < bufferIdx; ++i)
+	if(m_header.m_vertexBuffers[bufferIdx].m_vertexStride == m_storedVertexBuffers[bufferIdx].m_vertexStride)
 	{
-		seek += getAlignedVertexBufferSize(i);
+		// Same layout, read it in place
+		return readVertexBuffer(bufferIdx, ptr);
 	}
 
-	ANKI_CHECK(m_file->seek(seek, FileSeekOrigin::BEGINNING));
-	ANKI_CHECK(m_file->read(ptr, size));
+	DynamicArrayAuto<U8, PtrSize> staging(m_alloc);
+	staging.create(getVertexBufferSize(bufferIdx));
+	ANKI_CHECK(readVertexBuffer(bufferIdx, &staging[0]));
+
+	const U32 vertCount = m_header.m_totalVertexCount;
+	if(bufferIdx == m_header.m_vertexAttributes[VertexAttributeId::POSITION].m_bufferBinding)
+	{
+		ANKI_ASSERT(m_dequantizePositions);
+		dequantizePositions(reinterpret_cast<const U16Vec4*>(&staging[0]), static_cast<Vec3*>(ptr));
+	}
+	else
+	{
+		// Convert the F32 UVs to halfs
+		ANKI_ASSERT(m_header.m_vertexAttributes[VertexAttributeId::UV0].m_format == Format::R32G32_SFLOAT);
+		ANKI_ASSERT(m_header.m_vertexBuffers[bufferIdx].m_vertexStride == 16);
+		MainVertex* out = static_cast<MainVertex*>(ptr);
+
+		for(U32 v = 0; v < vertCount; ++v)
+		{
+			const U8* in = &staging[PtrSize(v) * 16];
+			Vec2 uv;
+			memcpy(&out[v].m_normal, in, sizeof(U32));
+			memcpy(&out[v].m_tangent, in + 4, sizeof(U32));
+			memcpy(&uv, in + 8, sizeof(Vec2));
+			out[v].m_uv0 = packHalf2x16(uv.x(), uv.y());
+		}
+	}
 
 	return Error::NONE;
 }
@@ -277,11 +483,33 @@ Error MeshBinaryLoader::storeIndicesAndPosition(DynamicArrayAuto<U32>& indices,
 	{
 		positions.resize(m_header.m_totalVertexCount);
 		const MeshBinaryVertexAttribute& attrib = m_header.m_vertexAttributes[VertexAttributeId::POSITION];
-		ANKI_ASSERT(attrib.m_format == Format::R32G32B32_SFLOAT);
-		ANKI_CHECK(storeVertexBuffer(attrib.m_bufferBinding, &positions[0], positions.getSizeInBytes()));
+
+		if(attrib.m_format == Format::R32G32B32_SFLOAT)
+		{
+			ANKI_CHECK(readVertexBuffer(attrib.m_bufferBinding, &positions[0]));
+		}
+		else
+		{
+			DynamicArrayAuto<U16Vec4> staging(m_alloc);
+			staging.create(m_header.m_totalVertexCount);
+			ANKI_CHECK(readVertexBuffer(attrib.m_bufferBinding, &staging[0]));
+			dequantizePositions(&staging[0], &positions[0]);
+		}
 	}
 
 	return Error::NONE;
 }
 
+void MeshBinaryLoader::dequantizePositions(const U16Vec4* in, Vec3* out) const
+{
+	const MeshBinaryVertexAttribute& attrib = m_header.m_vertexAttributes[VertexAttributeId::POSITION];
+	ANKI_ASSERT(attrib.m_format == Format::R16G16B16A16_UNORM);
+	const F32 scale = attrib.m_scale / F32(MAX_U16);
+
+	for(U32 v = 0; v < m_header.m_totalVertexCount; ++v)
+	{
+		out[v] = m_header.m_aabbMin + Vec3(in[v].xyz()) * scale;
+	}
+}
+
 } // end namespace anki
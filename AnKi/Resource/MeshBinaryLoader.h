@@ -9,33 +9,52 @@
 #include <AnKi/Resource/ResourceFilesystem.h>
 #include <AnKi/Resource/MeshBinary.h>
 #include <AnKi/Util/WeakArray.h>
+#include <AnKi/Shaders/Include/ModelTypes.h>
 
 namespace anki {
 
 /// @addtogroup resource
 /// @{
 
-/// This class loads the mesh binary file. It only supports a subset of combinations of vertex formats and buffers.
+/// This class loads the mesh binary file. It only supports a subset of combinations of vertex formats and buffers. The
+/// buffers it stores have the same layout no matter the version or the compression of the file, with the exception of
+/// the positions: The UVs are converted to R16G16_SFLOAT and the positions stay in the format of the file
+/// (R32G32B32_SFLOAT or the quantized R16G16B16A16_UNORM) unless setDequantizePositions() is called.
 class MeshBinaryLoader
 {
 public:
 	MeshBinaryLoader(ResourceManager* manager);
 
-	MeshBinaryLoader(ResourceManager* manager, GenericMemoryPoolAllocator<U8> alloc)
-		: m_manager(manager)
+	MeshBinaryLoader(ResourceManager* manager, GenericMemoryPoolAllocator<U8> alloc);
+
+	/// Use a filesystem directly. Useful for tools and tests that don't have a ResourceManager.
+	MeshBinaryLoader(ResourceFilesystem* fs, GenericMemoryPoolAllocator<U8> alloc)
+		: m_fs(fs)
 		, m_alloc(alloc)
 	{
 	}
 
 	~MeshBinaryLoader();
 
+	/// Store the quantized positions as R32G32B32_SFLOAT. Useful when the consumer can't dequantize them.
+	/// @note Call it before load().
+	void setDequantizePositions(Bool dequantize)
+	{
+		ANKI_ASSERT(!isLoaded());
+		m_dequantizePositions = dequantize;
+	}
+
 	ANKI_USE_RESULT Error load(const ResourceFilename& filename);
 
+	/// @note It might decode the buffer so prefer calling it from the async loader.
 	ANKI_USE_RESULT Error storeIndexBuffer(void* ptr, PtrSize size);
 
+	/// Store a vertex buffer using the layout of getStoredVertexBuffer() and getStoredVertexAttribute().
+	/// @note It might decode and convert the buffer so prefer calling it from the async loader.
 	ANKI_USE_RESULT Error storeVertexBuffer(U32 bufferIdx, void* ptr, PtrSize size);
 
-	/// Instead of calling storeIndexBuffer and storeVertexBuffer use this method to get those buffers into the CPU.
+	/// Instead of calling storeIndexBuffer and storeVertexBuffer use this method to get those buffers into the CPU. The
+	/// positions are always dequantized.
 	ANKI_USE_RESULT Error storeIndicesAndPosition(DynamicArrayAuto<U32>& indices, DynamicArrayAuto<Vec3>& positions);
 
 	const MeshBinaryHeader& getHeader() const
@@ -55,30 +74,76 @@ public:
 		return ConstWeakArray<MeshBinarySubMesh>(m_subMeshes);
 	}
 
+	/// @note It's empty for files without meshlets.
+	ConstWeakArray<MeshBinaryMeshlet> getMeshlets() const
+	{
+		return ConstWeakArray<MeshBinaryMeshlet>(m_meshlets);
+	}
+
+	/// The vertex buffer as storeVertexBuffer() writes it.
+	const MeshBinaryVertexBuffer& getStoredVertexBuffer(U32 bufferIdx) const
+	{
+		ANKI_ASSERT(isLoaded());
+		ANKI_ASSERT(bufferIdx < m_header.m_vertexBufferCount);
+		return m_storedVertexBuffers[bufferIdx];
+	}
+
+	/// The vertex attribute as storeVertexBuffer() writes it.
+	const MeshBinaryVertexAttribute& getStoredVertexAttribute(VertexAttributeId attrib) const
+	{
+		ANKI_ASSERT(isLoaded());
+		return m_storedVertexAttributes[attrib];
+	}
+
+	/// The size of the vertex buffer as storeVertexBuffer() writes it.
+	PtrSize getStoredVertexBufferSize(U32 bufferIdx) const
+	{
+		return PtrSize(m_header.m_totalVertexCount) * PtrSize(getStoredVertexBuffer(bufferIdx).m_vertexStride);
+	}
+
 private:
-	ResourceManager* m_manager;
+	ResourceFilesystem* m_fs;
 	GenericMemoryPoolAllocator<U8> m_alloc;
 	ResourceFilePtr m_file;
 
 	MeshBinaryHeader m_header;
+	PtrSize m_headerSize = 0; ///< The size of the header in the file. Older versions have a smaller header.
 
 	DynamicArray<MeshBinarySubMesh> m_subMeshes;
+	DynamicArray<MeshBinaryMeshlet> m_meshlets;
+
+	Array<MeshBinaryVertexBuffer, U32(VertexAttributeId::COUNT)> m_storedVertexBuffers;
+	Array<MeshBinaryVertexAttribute, U32(VertexAttributeId::COUNT)> m_storedVertexAttributes;
+
+	Bool m_dequantizePositions = false;
 
 	Bool isLoaded() const
 	{
 		return m_file.get() != nullptr;
 	}
 
+	Bool isCompressed() const
+	{
+		return !!(m_header.m_flags & MeshBinaryFlag::COMPRESSED);
+	}
+
 	PtrSize getIndexBufferSize() const
 	{
 		ANKI_ASSERT(isLoaded());
 		return PtrSize(m_header.m_totalIndexCount) * ((m_header.m_indexType == IndexType::U16) ? 2 : 4);
 	}
 
-	PtrSize getAlignedIndexBufferSize() const
+	PtrSize getIndexBufferOffsetInFile() const
+	{
+		return m_headerSize + sizeof(MeshBinarySubMesh) * m_header.m_subMeshCount
+			   + sizeof(MeshBinaryMeshlet) * m_header.m_meshletCount;
+	}
+
+	PtrSize getAlignedIndexBufferSizeInFile() const
 	{
 		ANKI_ASSERT(isLoaded());
-		return getAlignedRoundUp(MESH_BINARY_BUFFER_ALIGNMENT, getIndexBufferSize());
+		const PtrSize size = (isCompressed()) ? m_header.m_compressedIndexBufferSize : getIndexBufferSize();
+		return getAlignedRoundUp(MESH_BINARY_BUFFER_ALIGNMENT, size);
 	}
 
 	PtrSize getVertexBufferSize(U32 bufferIdx) const
@@ -88,16 +153,28 @@ private:
 		return PtrSize(m_header.m_totalVertexCount) * PtrSize(m_header.m_vertexBuffers[bufferIdx].m_vertexStride);
 	}
 
-	PtrSize getAlignedVertexBufferSize(U32 bufferIdx) const
+	PtrSize getAlignedVertexBufferSizeInFile(U32 bufferIdx) const
 	{
 		ANKI_ASSERT(isLoaded());
 		ANKI_ASSERT(bufferIdx < m_header.m_vertexBufferCount);
-		return getAlignedRoundUp(MESH_BINARY_BUFFER_ALIGNMENT, getVertexBufferSize(bufferIdx));
+		const PtrSize size =
+			(isCompressed()) ? m_header.m_compressedVertexBufferSizes[bufferIdx] : getVertexBufferSize(bufferIdx);
+		return getAlignedRoundUp(MESH_BINARY_BUFFER_ALIGNMENT, size);
 	}
 
+	ANKI_USE_RESULT Error readHeader();
+
 	ANKI_USE_RESULT Error checkHeader() const;
 	ANKI_USE_RESULT Error checkFormat(VertexAttributeId type, ConstWeakArray<Format> supportedFormats,
 									  U32 vertexBufferIdx, U32 relativeOffset) const;
+
+	void computeStoredVertexLayout();
+
+	/// Read a vertex buffer with the layout of the file.
+	ANKI_USE_RESULT Error readVertexBuffer(U32 bufferIdx, void* ptr);
+
+	/// Convert the quantized positions of the file to R32G32B32_SFLOAT.
+	void dequantizePositions(const U16Vec4* in, Vec3* out) const;
 };
 /// @}
 
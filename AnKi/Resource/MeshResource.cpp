@@ -48,6 +48,76 @@ public:
 	}
 };
 
+U32 cullMeshlets(ConstWeakArray<Meshlet> meshlets, ConstWeakArray<Plane> planes, const Vec4& cameraPos,
+				 WeakArray<U32> visibleMeshlets)
+{
+	ANKI_ASSERT(visibleMeshlets.getSize() >= meshlets.getSize());
+	ANKI_ASSERT(cameraPos.w() == 0.0f);
+
+	U32 visibleCount = 0;
+	for(U32 i = 0; i < meshlets.getSize(); ++i)
+	{
+		const Meshlet& meshlet = meshlets[i];
+		const Vec4 center = meshlet.m_sphere.xyz0();
+		const F32 radius = meshlet.m_sphere.w();
+
+		// Frustum
+		Bool visible = true;
+		for(const Plane& plane : planes)
+		{
+			visible = visible && plane.getNormal().dot(center) - plane.getOffset() >= -radius;
+		}
+
+		// Backface. All triangles face away if the direction from the camera to the apex is inside the cone
+		const Vec4 dir = meshlet.m_coneApex - cameraPos;
+		const Vec4 axis = meshlet.m_coneAxisCutoff.xyz0();
+		visible = visible && dir.dot(axis) <= meshlet.m_coneAxisCutoff.w() * dir.getLength();
+
+		// Write it anyway to avoid the branch
+		visibleMeshlets[visibleCount] = i;
+		visibleCount += U32(visible);
+	}
+
+	return visibleCount;
+}
+
+void unpackMeshlets(ConstWeakArray<MeshBinaryMeshlet> meshlets, ConstWeakArray<MeshBinarySubMesh> subMeshes,
+					WeakArray<Meshlet> outMeshlets, WeakArray<UVec2> outSubMeshMeshlets)
+{
+	ANKI_ASSERT(outMeshlets.getSize() == meshlets.getSize());
+	ANKI_ASSERT(outSubMeshMeshlets.getSize() == subMeshes.getSize());
+
+	for(UVec2& range : outSubMeshMeshlets)
+	{
+		range = UVec2(0u);
+	}
+
+	// MeshBinaryLoader checked that the meshlets are in the same order as the sub meshes
+	U32 subMeshIdx = 0;
+	for(U32 i = 0; i < meshlets.getSize(); ++i)
+	{
+		const MeshBinaryMeshlet& in = meshlets[i];
+		Meshlet& out = outMeshlets[i];
+		out.m_sphere = Vec4(in.m_sphereCenter, in.m_sphereRadius);
+		out.m_coneApex = Vec4(in.m_coneApex, 0.0f);
+		out.m_coneAxisCutoff = Vec4(in.m_coneAxis, in.m_coneCutoff);
+		out.m_firstIndex = in.m_firstIndex;
+		out.m_indexCount = in.m_indexCount;
+
+		while(in.m_firstIndex >= subMeshes[subMeshIdx].m_firstIndex + subMeshes[subMeshIdx].m_indexCount)
+		{
+			++subMeshIdx;
+		}
+
+		UVec2& range = outSubMeshMeshlets[subMeshIdx];
+		if(range.y() == 0)
+		{
+			range.x() = i;
+		}
+		++range.y();
+	}
+}
+
 MeshResource::MeshResource(ResourceManager* manager)
 	: ResourceObject(manager)
 {
@@ -57,6 +127,7 @@ MeshResource::MeshResource(ResourceManager* manager)
 MeshResource::~MeshResource()
 {
 	m_subMeshes.destroy(getAllocator());
+	m_meshlets.destroy(getAllocator());
 	m_vertexBufferInfos.destroy(getAllocator());
 
 	if(m_vertexBuffersOffset != MAX_PTR_SIZE)
@@ -73,7 +144,10 @@ MeshResource::~MeshResource()
 
 Bool MeshResource::isCompatible(const MeshResource& other) const
 {
-	return hasBoneWeights() == other.hasBoneWeights() && getSubMeshCount() == other.getSubMeshCount();
+	// The LODs share the vertex formats
+	return hasBoneWeights() == other.hasBoneWeights() && getSubMeshCount() == other.getSubMeshCount()
+		   && m_attributes[VertexAttributeId::POSITION].m_format
+				  == other.m_attributes[VertexAttributeId::POSITION].m_format;
 }
 
 Error MeshResource::load(const ResourceFilename& filename, Bool async)
@@ -98,8 +172,9 @@ Error MeshResource::load(const ResourceFilename& filename, Bool async)
 		ctx = &localCtx;
 	}
 
-	// Open file
+	// Open file. The BLAS is built from the positions so it needs them in a format it can consume
 	MeshBinaryLoader& loader = ctx->m_loader;
+	loader.setDequantizePositions(rayTracingEnabled);
 	ANKI_CHECK(loader.load(filename));
 	const MeshBinaryHeader& header = loader.getHeader();
 
@@ -111,10 +186,30 @@ Error MeshResource::load(const ResourceFilename& filename, Bool async)
 	{
 		m_subMeshes[i].m_firstIndex = loader.getSubMeshes()[i].m_firstIndex;
 		m_subMeshes[i].m_indexCount = loader.getSubMeshes()[i].m_indexCount;
+		m_subMeshes[i].m_firstMeshlet = 0;
+		m_subMeshes[i].m_meshletCount = 0;
 		m_subMeshes[i].m_aabb.setMin(loader.getSubMeshes()[i].m_aabbMin);
 		m_subMeshes[i].m_aabb.setMax(loader.getSubMeshes()[i].m_aabbMax);
 	}
 
+	//
+	// Meshlets
+	//
+	if(loader.getMeshlets().getSize() > 0)
+	{
+		m_meshlets.create(getAllocator(), loader.getMeshlets().getSize());
+		DynamicArrayAuto<UVec2> subMeshMeshlets(getTempAllocator());
+		subMeshMeshlets.create(m_subMeshes.getSize());
+		unpackMeshlets(loader.getMeshlets(), loader.getSubMeshes(), WeakArray<Meshlet>(m_meshlets),
+					   WeakArray<UVec2>(subMeshMeshlets));
+
+		for(U32 i = 0; i < m_subMeshes.getSize(); ++i)
+		{
+			m_subMeshes[i].m_firstMeshlet = subMeshMeshlets[i].x();
+			m_subMeshes[i].m_meshletCount = subMeshMeshlets[i].y();
+		}
+	}
+
 	//
 	// Index stuff
 	//
@@ -137,7 +232,7 @@ Error MeshResource::load(const ResourceFilename& filename, Bool async)
 		alignRoundUp(MESH_BINARY_BUFFER_ALIGNMENT, m_vertexBuffersSize);
 
 		m_vertexBufferInfos[i].m_offset = m_vertexBuffersSize;
-		m_vertexBufferInfos[i].m_stride = header.m_vertexBuffers[i].m_vertexStride;
+		m_vertexBufferInfos[i].m_stride = loader.getStoredVertexBuffer(i).m_vertexStride;
 
 		m_vertexBuffersSize += m_vertexCount * m_vertexBufferInfos[i].m_stride;
 	}
@@ -153,17 +248,28 @@ Error MeshResource::load(const ResourceFilename& filename, Bool async)
 	for(VertexAttributeId attrib = VertexAttributeId::FIRST; attrib < VertexAttributeId::COUNT; ++attrib)
 	{
 		AttribInfo& out = m_attributes[attrib];
-		const MeshBinaryVertexAttribute& in = header.m_vertexAttributes[attrib];
+		const MeshBinaryVertexAttribute& in = loader.getStoredVertexAttribute(attrib);
 
 		if(!!in.m_format)
 		{
 			out.m_format = in.m_format;
 			out.m_relativeOffset = in.m_relativeOffset;
 			out.m_buffIdx = U8(in.m_bufferBinding);
-			ANKI_ASSERT(in.m_scale == 1.0f && "Not supported ATM");
+			ANKI_ASSERT((in.m_scale == 1.0f || attrib == VertexAttributeId::POSITION) && "Not supported ATM");
 		}
 	}
 
+	const MeshBinaryVertexAttribute& positions = loader.getStoredVertexAttribute(VertexAttributeId::POSITION);
+	if(positions.m_format == Format::R16G16B16A16_UNORM)
+	{
+		m_positionDequantization = Vec4(header.m_aabbMin, positions.m_scale);
+	}
+	else
+	{
+		ANKI_ASSERT(positions.m_format == Format::R32G32B32_SFLOAT);
+		m_positionDequantization = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+	}
+
 	// Other
 	m_aabb.setMin(header.m_aabbMin);
 	m_aabb.setMax(header.m_aabbMax);
@@ -209,6 +315,7 @@ Error MeshResource::load(const ResourceFilename& filename, Bool async)
 		PtrSize offset;
 		PtrSize stride;
 		getVertexBufferInfo(bufferIdx, buffer, offset, stride);
+		ANKI_ASSERT(format == Format::R32G32B32_SFLOAT);
 
 		inf.m_bottomLevel.m_positionBuffer = buffer;
 		inf.m_bottomLevel.m_positionBufferOffset = offset;
@@ -9,16 +9,50 @@
 #include <AnKi/Math.h>
 #include <AnKi/Gr.h>
 #include <AnKi/Collision/Aabb.h>
+#include <AnKi/Collision/Plane.h>
 #include <AnKi/Shaders/Include/ModelTypes.h>
 
 namespace anki {
 
 // Forward
 class MeshBinaryLoader;
+class MeshBinaryMeshlet;
+class MeshBinarySubMesh;
 
 /// @addtogroup resource
 /// @{
 
+/// A cluster of triangles of a sub mesh. Its triangles are contiguous in the index buffer.
+/// @memberof MeshResource
+class Meshlet
+{
+public:
+	Vec4 m_sphere; ///< The xyz is the center and the w the radius of the bounding sphere.
+	Vec4 m_coneApex; ///< The apex of the cone of the triangle normals. The w is zero.
+	Vec4 m_coneAxisCutoff; ///< The xyz is the axis of the cone of the triangle normals and the w the cutoff.
+	U32 m_firstIndex;
+	U32 m_indexCount;
+};
+
+/// Cull meshlets against a frustum and reject the ones whose triangles face away from the camera.
+/// @param meshlets The meshlets to test. See MeshResource::getMeshlets().
+/// @param planes The frustum planes in the space of the mesh. See extractClipPlanes().
+/// @param cameraPos The position of the camera in the space of the mesh. The w should be zero.
+/// @param[out] visibleMeshlets The indices of the visible meshlets. It should be as big as the meshlets.
+/// @return The number of visible meshlets.
+U32 cullMeshlets(ConstWeakArray<Meshlet> meshlets, ConstWeakArray<Plane> planes, const Vec4& cameraPos,
+				 WeakArray<U32> visibleMeshlets);
+
+/// Convert the meshlets of a mesh binary to Meshlet and find the meshlets of each sub mesh. MeshResource::load() uses
+/// it.
+/// @param meshlets The meshlets of the binary. See MeshBinaryLoader::getMeshlets().
+/// @param subMeshes The sub meshes of the binary. See MeshBinaryLoader::getSubMeshes().
+/// @param[out] outMeshlets The converted meshlets. It should be as big as the meshlets.
+/// @param[out] outSubMeshMeshlets The first meshlet (x) and the meshlet count (y) of each sub mesh. It should be as
+///                                big as the sub meshes.
+void unpackMeshlets(ConstWeakArray<MeshBinaryMeshlet> meshlets, ConstWeakArray<MeshBinarySubMesh> subMeshes,
+					WeakArray<Meshlet> outMeshlets, WeakArray<UVec2> outSubMeshMeshlets);
+
 /// Mesh Resource. It contains the geometry packed in GPU buffers.
 class MeshResource : public ResourceObject
 {
@@ -54,6 +88,16 @@ public:
 		return m_subMeshes.getSize();
 	}
 
+	/// Get the meshlets of a submesh. The indices of the meshlets are relative to the whole index buffer.
+	/// @note It's empty if the mesh was imported without meshlets.
+	/// @note Nothing draws per meshlet yet. The visibility and the draw path still use whole sub meshes.
+	ConstWeakArray<Meshlet> getMeshlets(U32 subMeshId) const
+	{
+		const SubMesh& sm = m_subMeshes[subMeshId];
+		return (sm.m_meshletCount) ? ConstWeakArray<Meshlet>(&m_meshlets[sm.m_firstMeshlet], sm.m_meshletCount)
+								   : ConstWeakArray<Meshlet>();
+	}
+
 	/// Get all info around vertex indices.
 	void getIndexBufferInfo(BufferPtr& buff, PtrSize& buffOffset, U32& indexCount, IndexType& indexType) const
 	{
@@ -93,6 +137,13 @@ public:
 		return !!m_attributes[attrib].m_format;
 	}
 
+	/// Get the values that bring the (maybe quantized) positions of the vertex buffer to the space of the mesh:
+	/// position = xyz + vertexBufferPosition * w. It's (0, 0, 0, 1) if the positions are not quantized.
+	const Vec4& getPositionDequantization() const
+	{
+		return m_positionDequantization;
+	}
+
 	/// Return true if it has bone weights.
 	Bool hasBoneWeights() const
 	{
@@ -131,6 +182,8 @@ private:
 	public:
 		U32 m_firstIndex;
 		U32 m_indexCount;
+		U32 m_firstMeshlet;
+		U32 m_meshletCount;
 		Aabb m_aabb;
 	};
 
@@ -150,6 +203,7 @@ private:
 	};
 
 	DynamicArray<SubMesh> m_subMeshes;
+	DynamicArray<Meshlet> m_meshlets;
 	DynamicArray<VertBuffInfo> m_vertexBufferInfos;
 	Array<AttribInfo, U(VertexAttributeId::COUNT)> m_attributes;
 
@@ -164,6 +218,7 @@ private:
 	IndexType m_indexType;
 
 	Aabb m_aabb;
+	Vec4 m_positionDequantization = Vec4(0.0f, 0.0f, 0.0f, 1.0f);
 
 	// RT
 	AccelerationStructurePtr m_blas;
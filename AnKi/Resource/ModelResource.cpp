@@ -87,6 +87,8 @@ void ModelPatch::getRenderingInfo(const RenderingKey& key, ModelRenderingInfo& i
 	inf.m_firstIndex = m_indexBufferInfos[meshLod].m_firstIndex;
 	inf.m_indexType = m_indexType;
 
+	inf.m_positionDequantization = m_meshes[meshLod]->getPositionDequantization();
+
 	// Get program
 	{
 		RenderingKey mtlKey = key;
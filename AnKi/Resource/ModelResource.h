@@ -75,6 +75,8 @@ public:
 	U32 m_firstIndex;
 	U32 m_indexCount;
 
+	Vec4 m_positionDequantization; ///< See MeshResource::getPositionDequantization().
+
 	U32 m_boneTransformsBinding;
 	U32 m_prevFrameBoneTransformsBinding;
 };
@@ -125,6 +127,19 @@ public:
 		return m_mtl->getSupportedRayTracingTypes();
 	}
 
+	U32 getLodCount() const
+	{
+		return m_meshLodCount;
+	}
+
+	/// Get the index range of a LOD. Useful for indirect drawing.
+	void getIndexRange(U32 lod, U32& firstIndex, U32& indexCount) const
+	{
+		lod = min<U32>(lod, m_meshLodCount - 1);
+		firstIndex = m_indexBufferInfos[lod].m_firstIndex;
+		indexCount = m_indexBufferInfos[lod].m_indexCount;
+	}
+
 private:
 #if ANKI_ENABLE_ASSERTIONS
 	ModelResource* m_model = nullptr;
@@ -43,9 +43,10 @@ Error ResourceManager::init(ResourceManagerInitInfo& init)
 	m_physics = init.m_physics;
 	m_fs = init.m_resourceFs;
 	m_vertexMem = init.m_vertexMemory;
-	m_alloc = ResourceAllocator<U8>(init.m_allocCallback, init.m_allocCallbackData);
+	m_alloc = ResourceAllocator<U8>(init.m_allocCallback, init.m_allocCallbackData, "Resource");
 
-	m_tmpAlloc = TempResourceAllocator<U8>(init.m_allocCallback, init.m_allocCallbackData, 10_MB);
+	m_tmpAlloc = TempResourceAllocator<U8>(init.m_allocCallback, init.m_allocCallbackData, 10_MB, 2.0, 0, true,
+											 ANKI_SAFE_ALIGNMENT, "ResourceTmp");
 
 	m_cacheDir.create(m_alloc, init.m_cacheDir);
 
@@ -6,7 +6,8 @@
 #pragma once
 
 #include <AnKi/Resource/TransferGpuAllocator.h>
-#include <AnKi/Util/List.h>
+#include <AnKi/Util/FlatHashMap.h>
+#include <AnKi/Util/StringTable.h>
 #include <AnKi/Util/Functions.h>
 #include <AnKi/Util/String.h>
 
@@ -43,20 +44,27 @@ protected:
 
 	Type* findLoadedResource(const CString& filename)
 	{
-		auto it = find(filename);
-		return (it != m_ptrs.end()) ? *it : nullptr;
+		// If the filename is not interned then no resource has it
+		const StringId filenameId = StringId::tryFind(filename);
+		if(!filenameId)
+		{
+			return nullptr;
+		}
+
+		auto it = m_ptrs.find(filenameId);
+		return (it != m_ptrs.getEnd()) ? *it : nullptr;
 	}
 
 	void registerResource(Type* ptr)
 	{
-		ANKI_ASSERT(find(ptr->getFilename()) == m_ptrs.getEnd());
-		m_ptrs.pushBack(m_alloc, ptr);
+		ANKI_ASSERT(m_ptrs.find(ptr->getFilenameId()) == m_ptrs.getEnd());
+		m_ptrs.emplace(m_alloc, ptr->getFilenameId(), ptr);
 	}
 
 	void unregisterResource(Type* ptr)
 	{
-		auto it = find(ptr->getFilename());
-		ANKI_ASSERT(it != m_ptrs.end());
+		auto it = m_ptrs.find(ptr->getFilenameId());
+		ANKI_ASSERT(it != m_ptrs.getEnd());
 		m_ptrs.erase(m_alloc, it);
 	}
 
@@ -66,25 +74,8 @@ protected:
 	}
 
 private:
-	using Container = List<Type*>;
-
 	ResourceAllocator<U8> m_alloc;
-	Container m_ptrs;
-
-	typename Container::Iterator find(const CString& filename)
-	{
-		typename Container::Iterator it;
-
-		for(it = m_ptrs.getBegin(); it != m_ptrs.getEnd(); ++it)
-		{
-			if((*it)->getFilename() == filename)
-			{
-				break;
-			}
-		}
-
-		return it;
-	}
+	FlatHashMap<StringId, Type*> m_ptrs; ///< The key is the filename.
 };
 
 class ResourceManagerInitInfo
@@ -17,7 +17,6 @@ ResourceObject::ResourceObject(ResourceManager* manager)
 
 ResourceObject::~ResourceObject()
 {
-	m_fname.destroy(getAllocator());
 }
 
 ResourceAllocator<U8> ResourceObject::getAllocator() const
@@ -9,6 +9,7 @@
 #include <AnKi/Resource/ResourceFilesystem.h>
 #include <AnKi/Util/Atomic.h>
 #include <AnKi/Util/String.h>
+#include <AnKi/Util/StringTable.h>
 
 namespace anki {
 
@@ -53,12 +54,19 @@ public:
 		return m_fname.toCString();
 	}
 
+	/// Get the interned filename. Comparing it is cheaper than comparing the filename.
+	StringId getFilenameId() const
+	{
+		ANKI_ASSERT(!m_fname.isEmpty());
+		return m_fname;
+	}
+
 	// Internals:
 
 	ANKI_INTERNAL void setFilename(const CString& fname)
 	{
 		ANKI_ASSERT(m_fname.isEmpty());
-		m_fname.create(getAllocator(), fname);
+		m_fname = StringId(fname);
 	}
 
 	ANKI_INTERNAL void setUuid(U64 uuid)
@@ -83,7 +91,7 @@ public:
 private:
 	ResourceManager* m_manager;
 	Atomic<I32> m_refcount;
-	String m_fname; ///< Unique resource name.
+	StringId m_fname; ///< Unique resource name.
 	U64 m_uuid = 0;
 };
 /// @}
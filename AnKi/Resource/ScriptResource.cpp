@@ -4,6 +4,7 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Resource/ScriptResource.h>
+#include <AnKi/Script/LuaBinder.h>
 #include <AnKi/Util/File.h>
 
 namespace anki {
@@ -11,6 +12,7 @@ namespace anki {
 ScriptResource::~ScriptResource()
 {
 	m_source.destroy(getAllocator());
+	m_bytecode.destroy(getAllocator());
 }
 
 Error ScriptResource::load(const ResourceFilename& filename, Bool async)
@@ -22,6 +24,15 @@ Error ScriptResource::load(const ResourceFilename& filename, Bool async)
 	ANKI_CHECK(file->readAllText(src));
 	m_source.create(getAllocator(), src);
 
+	// Compile it once here so the environments won't have to parse it
+	DynamicArrayAuto<U8> bytecode(getTempAllocator());
+	StringAuto chunkName(getTempAllocator());
+	chunkName.sprintf("@%s", filename.cstr());
+	ANKI_CHECK(LuaBinder::compileString(getAllocator(), m_source.toCString(), chunkName.toCString(), bytecode));
+
+	m_bytecode.create(getAllocator(), bytecode.getSize());
+	memcpy(&m_bytecode[0], &bytecode[0], bytecode.getSize());
+
 	return Error::NONE;
 }
 
@@ -6,6 +6,8 @@
 #pragma once
 
 #include <AnKi/Resource/ResourceObject.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/WeakArray.h>
 
 namespace anki {
 
@@ -30,8 +32,15 @@ public:
 		return m_source.toCString();
 	}
 
+	/// The source compiled once to be evaluated by many ScriptEnvironments.
+	ConstWeakArray<U8> getBytecode() const
+	{
+		return m_bytecode;
+	}
+
 private:
 	String m_source;
+	DynamicArray<U8> m_bytecode;
 };
 /// @}
 
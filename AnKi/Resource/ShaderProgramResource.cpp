@@ -39,11 +39,9 @@ ShaderProgramResource::~ShaderProgramResource()
 	m_consts.destroy(getAllocator());
 	m_constBinaryMapping.destroy(getAllocator());
 
-	for(auto it : m_variants)
-	{
-		ShaderProgramResourceVariant* variant = &(*it);
+	m_variants.iterate([&](U64, ShaderProgramResourceVariant* variant) {
 		getAllocator().deleteInstance(variant);
-	}
+	});
 	m_variants.destroy(getAllocator());
 }
 
@@ -66,7 +64,8 @@ Error ShaderProgramResource::load(const ResourceFilename& filename, Bool async)
 		{
 			m_mutators[i].m_name = binary.m_mutators[i].m_name.getBegin();
 			ANKI_ASSERT(m_mutators[i].m_name.getLength() > 0);
-			m_mutators[i].m_values = binary.m_mutators[i].m_values;
+			m_mutators[i].m_values = ConstWeakArray<MutatorValue>(binary.m_mutators[i].m_values.getBegin(),
+																  binary.m_mutators[i].m_values.getSize());
 		}
 	}
 
@@ -226,37 +225,12 @@ void ShaderProgramResource::getOrCreateVariant(const ShaderProgramResourceVarian
 			appendHash(info.m_constantValues.getBegin(), m_consts.getSize() * sizeof(info.m_constantValues[0]), hash);
 	}
 
-	// Check if the variant is in the cache
-	{
-		RLockGuard<RWMutex> lock(m_mtx);
-
-		auto it = m_variants.find(hash);
-		variant = (it != m_variants.getEnd()) ? *it : nullptr;
-
-		if(variant != nullptr)
-		{
-			// Done
-			return;
-		}
-	}
-
-	// Create the variant
-	WLockGuard<RWMutex> lock(m_mtx);
-
-	// Check again
-	auto it = m_variants.find(hash);
-	variant = (it != m_variants.getEnd()) ? *it : nullptr;
-	if(variant != nullptr)
-	{
-		// Done
-		return;
-	}
-
-	// Create
-	ShaderProgramResourceVariant* v = getAllocator().newInstance<ShaderProgramResourceVariant>();
-	initVariant(info, *v);
-	m_variants.emplace(getAllocator(), hash, v);
-	variant = v;
+	// Find it in the cache or create it. Only the threads that want variants of the same shard wait for the creation
+	variant = m_variants.getOrCreate(getAllocator(), hash, [&]() {
+		ShaderProgramResourceVariant* v = getAllocator().newInstance<ShaderProgramResourceVariant>();
+		initVariant(info, *v);
+		return v;
+	});
 }
 
 void ShaderProgramResource::initVariant(const ShaderProgramResourceVariantInitInfo& info,
@@ -383,7 +357,9 @@ void ShaderProgramResource::initVariant(const ShaderProgramResourceVariantInitIn
 
 			ShaderInitInfo inf(cprogName);
 			inf.m_shaderType = shaderType;
-			inf.m_binary = binary.m_codeBlocks[binaryVariant->m_codeBlockIndices[shaderType]].m_binary;
+			const ShaderProgramBinaryCodeBlock& codeBlock =
+				binary.m_codeBlocks[binaryVariant->m_codeBlockIndices[shaderType]];
+			inf.m_binary = ConstWeakArray<U8>(codeBlock.m_binary.getBegin(), codeBlock.m_binary.getSize());
 			inf.m_constValues.setArray((constValueCount) ? constValues.getBegin() : nullptr, constValueCount);
 			ShaderPtr shader = getManager().getGrManager().newShader(inf);
 
@@ -11,7 +11,7 @@
 #include <AnKi/Gr/ShaderProgram.h>
 #include <AnKi/Util/BitSet.h>
 #include <AnKi/Util/String.h>
-#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/ShardedHashMap.h>
 #include <AnKi/Util/WeakArray.h>
 #include <AnKi/Math.h>
 
@@ -267,8 +267,7 @@ private:
 
 	DynamicArray<ConstMapping> m_constBinaryMapping;
 
-	mutable HashMap<U64, ShaderProgramResourceVariant*> m_variants;
-	mutable RWMutex m_mtx;
+	mutable ShardedHashMap<U64, ShaderProgramResourceVariant*> m_variants;
 
 	ShaderTypeBit m_shaderStages = ShaderTypeBit::NONE;
 
@@ -307,7 +307,7 @@ Error ShaderProgramResourceSystem::createRayTracingPrograms(CString cacheDir, co
 
 				ShaderInitInfo inf(progName);
 				inf.m_shaderType = shaderType;
-				inf.m_binary = codeBlock.m_binary;
+				inf.m_binary = ConstWeakArray<U8>(codeBlock.m_binary.getBegin(), codeBlock.m_binary.getSize());
 				shader->m_shader = m_gr->newShader(inf);
 				shader->m_hash = codeBlock.m_hash;
 
@@ -424,7 +424,8 @@ Error ShaderProgramResourceSystem::createRayTracingPrograms(CString cacheDir, co
 			ShaderProgramBinaryMutation dummyMutation;
 			if(binary.m_mutations.getSize() > 1)
 			{
-				mutations = binary.m_mutations;
+				mutations = ConstWeakArray<ShaderProgramBinaryMutation>(binary.m_mutations.getBegin(),
+																		binary.m_mutations.getSize());
 			}
 			else
 			{
@@ -471,7 +472,8 @@ Error ShaderProgramResourceSystem::createRayTracingPrograms(CString cacheDir, co
 			ShaderProgramBinaryMutation dummyMutation;
 			if(binary.m_mutations.getSize() > 1)
 			{
-				mutations = binary.m_mutations;
+				mutations = ConstWeakArray<ShaderProgramBinaryMutation>(binary.m_mutations.getBegin(),
+																		binary.m_mutations.getSize());
 			}
 			else
 			{
@@ -511,7 +513,8 @@ Error ShaderProgramResourceSystem::createRayTracingPrograms(CString cacheDir, co
 			ShaderProgramBinaryMutation dummyMutation;
 			if(binary.m_mutations.getSize() > 1)
 			{
-				mutations = binary.m_mutations;
+				mutations = ConstWeakArray<ShaderProgramBinaryMutation>(binary.m_mutations.getBegin(),
+																		binary.m_mutations.getSize());
 			}
 			else
 			{
@@ -17,6 +17,10 @@ SkeletonResource::~SkeletonResource()
 	}
 
 	m_bones.destroy(getAllocator());
+	m_sortedBoneIndices.destroy(getAllocator());
+	m_sortedBoneParents.destroy(getAllocator());
+	m_sortedBoneTransforms.destroy(getAllocator());
+	m_sortedBoneVertexTransforms.destroy(getAllocator());
 }
 
 Error SkeletonResource::load(const ResourceFilename& filename, Bool async)
@@ -37,6 +41,12 @@ Error SkeletonResource::load(const ResourceFilename& filename, Bool async)
 	ANKI_CHECK(boneEl.getSiblingElementsCount(boneCount));
 	++boneCount;
 
+	if(boneCount > MAX_BONES_PER_SKELETON)
+	{
+		ANKI_RESOURCE_LOGE("Skeleton cannot have more than %u bones", MAX_BONES_PER_SKELETON);
+		return Error::USER_DATA;
+	}
+
 	m_bones.create(getAllocator(), boneCount);
 
 	StringListAuto boneParents(getAllocator());
@@ -122,6 +132,41 @@ Error SkeletonResource::load(const ResourceFilename& filename, Bool async)
 		++it;
 	}
 
+	if(m_rootBoneIdx == MAX_U32)
+	{
+		ANKI_RESOURCE_LOGE("Skeleton doesn't have a root bone");
+		return Error::USER_DATA;
+	}
+
+	// Sort the bones breadth first. The parents will be before their children
+	m_sortedBoneIndices.create(getAllocator(), m_bones.getSize());
+	m_sortedBoneParents.create(getAllocator(), m_bones.getSize());
+	m_sortedBoneTransforms.create(getAllocator(), m_bones.getSize());
+	m_sortedBoneVertexTransforms.create(getAllocator(), m_bones.getSize());
+
+	DynamicArrayAuto<U32> bonePositions(getAllocator(), m_bones.getSize(), MAX_U32);
+	m_sortedBoneIndices[0] = m_rootBoneIdx;
+	U32 sortedCount = 1;
+	for(U32 pos = 0; pos < sortedCount; ++pos)
+	{
+		const Bone& bone = m_bones[m_sortedBoneIndices[pos]];
+		bonePositions[bone.m_idx] = pos;
+		m_sortedBoneParents[pos] = (bone.m_parent) ? bonePositions[bone.m_parent->m_idx] : MAX_U32;
+		m_sortedBoneTransforms[pos] = Mat3x4(bone.m_transform);
+		m_sortedBoneVertexTransforms[pos] = Mat3x4(bone.m_vertTrf);
+
+		for(const Bone* child : bone.getChildren())
+		{
+			m_sortedBoneIndices[sortedCount++] = child->m_idx;
+		}
+	}
+
+	if(sortedCount != m_bones.getSize())
+	{
+		ANKI_RESOURCE_LOGE("Skeleton has bones that are not connected to the root");
+		return Error::USER_DATA;
+	}
+
 	return Error::NONE;
 }
 
@@ -15,6 +15,7 @@ namespace anki {
 /// @{
 
 const U32 MAX_CHILDREN_PER_BONE = 8;
+const U32 MAX_BONES_PER_SKELETON = 128;
 
 /// Skeleton bone
 class Bone
@@ -128,9 +129,44 @@ public:
 		return m_bones[m_rootBoneIdx];
 	}
 
+	/// @name Sorted bones
+	/// The bones sorted so the parents are before their children. The hierarchy can be updated with a single loop
+	/// over these arrays.
+	/// @{
+
+	/// The index of the bone for each position.
+	ConstWeakArray<U32> getSortedBoneIndices() const
+	{
+		return m_sortedBoneIndices;
+	}
+
+	/// The position of the parent for each position. The root has MAX_U32.
+	ConstWeakArray<U32> getSortedBoneParents() const
+	{
+		return m_sortedBoneParents;
+	}
+
+	/// See Bone::getTransform().
+	ConstWeakArray<Mat3x4> getSortedBoneTransforms() const
+	{
+		return m_sortedBoneTransforms;
+	}
+
+	/// See Bone::getVertexTransform().
+	ConstWeakArray<Mat3x4> getSortedBoneVertexTransforms() const
+	{
+		return m_sortedBoneVertexTransforms;
+	}
+	/// @}
+
 private:
 	DynamicArray<Bone> m_bones;
 	U32 m_rootBoneIdx = MAX_U32;
+
+	DynamicArray<U32> m_sortedBoneIndices;
+	DynamicArray<U32> m_sortedBoneParents;
+	DynamicArray<Mat3x4> m_sortedBoneTransforms;
+	DynamicArray<Mat3x4> m_sortedBoneVertexTransforms;
 };
 /// @}
 
@@ -37,7 +37,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(CameraNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(CameraNode::MoveFeedbackComponent, "MoveComponent", "FrustumComponent")
 
 CameraNode::CameraNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
@@ -12,7 +12,7 @@
 
 namespace anki {
 
-ANKI_SCENE_COMPONENT_STATICS(BodyComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(BodyComponent, "JointComponent", "")
 
 BodyComponent::BodyComponent(SceneNode* node)
 	: SceneComponent(node, getStaticClassId())
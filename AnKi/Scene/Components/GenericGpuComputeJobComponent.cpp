@@ -7,6 +7,6 @@
 
 namespace anki {
 
-ANKI_SCENE_COMPONENT_STATICS(GenericGpuComputeJobComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(GenericGpuComputeJobComponent, "SpatialComponent", "RenderComponent")
 
 } // end namespace anki
@@ -61,6 +61,11 @@ Error LightComponent::update(SceneNode& node, Second prevTime, Second crntTime,
 	{
 		node.getSceneGraph().getOctree().getActualSceneBounds(m_dir.m_sceneMin, m_dir.m_sceneMax);
 	}
+	else
+	{
+		// Nothing to do until some property changes
+		setActive(false);
+	}
 
 	return Error::NONE;
 }
@@ -40,7 +40,7 @@ public:
 	{
 		ANKI_ASSERT(type >= LightComponentType::FIRST && type < LightComponentType::COUNT);
 		m_type = type;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	LightComponentType getLightComponentType() const
@@ -51,7 +51,7 @@ public:
 	void setWorldTransform(const Transform& trf)
 	{
 		m_worldtransform = trf;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	const Transform& getWorldTransform() const
@@ -72,7 +72,7 @@ public:
 	void setRadius(F32 x)
 	{
 		m_point.m_radius = x;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	F32 getRadius() const
@@ -83,7 +83,7 @@ public:
 	void setDistance(F32 x)
 	{
 		m_spot.m_distance = x;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	F32 getDistance() const
@@ -95,7 +95,7 @@ public:
 	{
 		m_spot.m_innerAngleCos = cos(ang / 2.0f);
 		m_spot.m_innerAngle = ang;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	F32 getInnerAngleCos() const
@@ -112,7 +112,7 @@ public:
 	{
 		m_spot.m_outerAngleCos = cos(ang / 2.0f);
 		m_spot.m_outerAngle = ang;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	F32 getOuterAngle() const
@@ -222,6 +222,12 @@ private:
 	U8 m_shadow : 1;
 	U8 m_markedForUpdate : 1;
 
+	void markForUpdate()
+	{
+		m_markedForUpdate = true;
+		setActive(true);
+	}
+
 	void draw(RenderQueueDrawContext& ctx) const;
 };
 /// @}
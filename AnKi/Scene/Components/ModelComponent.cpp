@@ -40,7 +40,13 @@ Error ModelComponent::loadModelResource(CString filename)
 		Array<U64, 2> toHash;
 		toHash[0] = i;
 		toHash[1] = m_model->getUuid();
-		m_modelPatchMergeKeys[i] = computeHash(&toHash[0], sizeof(toHash));
+		const U64 geometryHash = computeHash(&toHash[0], sizeof(toHash));
+
+		// The upper bits identify the material so patches that share programs end up next to each other when sorting
+		const U64 materialUuid = m_model->getModelPatches()[i].getMaterial()->getUuid();
+		const U64 materialHash = computeHash(&materialUuid, sizeof(materialUuid));
+
+		m_modelPatchMergeKeys[i] = (materialHash << 40u) | (geometryHash & ((U64(1) << 40u) - 1u));
 	}
 
 	return Error::NONE;
@@ -4,7 +4,7 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Scene/Components/MoveComponent.h>
-#include <AnKi/Scene/SceneNode.h>
+#include <AnKi/Scene/SceneGraph.h>
 
 namespace anki {
 
@@ -12,78 +12,33 @@ ANKI_SCENE_COMPONENT_STATICS(MoveComponent)
 
 MoveComponent::MoveComponent(SceneNode* node)
 	: SceneComponent(node, getStaticClassId())
-	, m_ignoreLocalTransform(false)
-	, m_ignoreParentTransform(false)
+	, m_transforms(&node->getSceneGraph().getTransformHierarchy())
 {
-	markForUpdate();
+	m_transformIdx = m_transforms->newTransform(this);
+	updateParentTransform();
 }
 
 MoveComponent::~MoveComponent()
 {
+	m_transforms->deleteTransform(m_transformIdx);
 }
 
 Error MoveComponent::update(SceneNode& node, Second prevTime, Second crntTime, Bool& updated)
 {
-	updated = updateWorldTransform(node);
+	updated = m_transforms->getUpdatedThisFrame(m_transformIdx);
+
+	// Sleep until the SceneGraph wakes it up because the hierarchy changed the transform again
+	setActive(false);
 	return Error::NONE;
 }
 
-Bool MoveComponent::updateWorldTransform(SceneNode& node)
+void MoveComponent::updateParentTransform()
 {
-	m_prevWTrf = m_wtrf;
-	const Bool dirty = m_markedForUpdate;
-
-	// If dirty then update world transform
-	if(dirty)
-	{
-		const SceneNode* parent = node.getParent();
-
-		if(parent)
-		{
-			const MoveComponent* parentMove = parent->tryGetFirstComponentOfType<MoveComponent>();
-
-			if(parentMove == nullptr)
-			{
-				// Parent not movable
-				m_wtrf = m_ltrf;
-			}
-			else if(m_ignoreParentTransform)
-			{
-				m_wtrf = m_ltrf;
-			}
-			else if(m_ignoreLocalTransform)
-			{
-				m_wtrf = parentMove->getWorldTransform();
-			}
-			else
-			{
-				m_wtrf = parentMove->getWorldTransform().combineTransformations(m_ltrf);
-			}
-		}
-		else
-		{
-			// No parent
-
-			m_wtrf = m_ltrf;
-		}
-
-		// Now it's a good time to cleanse parent
-		m_markedForUpdate = false;
-	}
-
-	// If this is dirty then make children dirty as well. Don't walk the whole tree because you will re-walk it later
-	if(dirty)
-	{
-		const Error err = node.visitChildrenMaxDepth(1, [](SceneNode& childNode) -> Error {
-			childNode.iterateComponentsOfType<MoveComponent>([](MoveComponent& mov) {
-				mov.markForUpdate();
-			});
-			return Error::NONE;
-		});
-		(void)err;
-	}
+	const SceneNode* parent = getSceneNode().getParent();
+	const MoveComponent* parentMove = (parent) ? parent->tryGetFirstComponentOfType<MoveComponent>() : nullptr;
 
-	return dirty;
+	// If the parent is not movable the transform has no parent
+	m_transforms->setParent(m_transformIdx, (parentMove) ? parentMove->m_transformIdx : MAX_U32);
 }
 
 } // end namespace anki
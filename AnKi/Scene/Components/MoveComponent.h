@@ -6,6 +6,7 @@
 #pragma once
 
 #include <AnKi/Scene/Components/SceneComponent.h>
+#include <AnKi/Scene/TransformHierarchy.h>
 #include <AnKi/Util/BitMask.h>
 #include <AnKi/Util/Enum.h>
 #include <AnKi/Math.h>
@@ -15,10 +16,11 @@ namespace anki {
 /// @addtogroup scene
 /// @{
 
-/// Interface for movable scene nodes.
+/// Interface for movable scene nodes. The transforms live in the TransformHierarchy of the scene.
 class MoveComponent : public SceneComponent
 {
 	ANKI_SCENE_COMPONENT(MoveComponent)
+	friend class SceneNode;
 
 public:
 	MoveComponent(SceneNode* node);
@@ -28,140 +30,122 @@ public:
 	/// Get the parent's world transform.
 	void setIgnoreLocalTransform(Bool ignore)
 	{
-		m_ignoreLocalTransform = ignore;
+		m_transforms->setIgnoreLocalTransform(m_transformIdx, ignore);
 	}
 
 	/// Ignore parent nodes's transform.
 	void setIgnoreParentTransform(Bool ignore)
 	{
-		m_ignoreParentTransform = ignore;
+		m_transforms->setIgnoreParentTransform(m_transformIdx, ignore);
 	}
 
 	const Transform& getLocalTransform() const
 	{
-		return m_ltrf;
+		return m_transforms->getLocalTransform(m_transformIdx);
 	}
 
 	void setLocalTransform(const Transform& x)
 	{
-		m_ltrf = x;
-		markForUpdate();
+		getLocalTransformForUpdate() = x;
 	}
 
 	void setLocalOrigin(const Vec4& x)
 	{
-		m_ltrf.setOrigin(x);
-		markForUpdate();
+		getLocalTransformForUpdate().setOrigin(x);
 	}
 
 	const Vec4& getLocalOrigin() const
 	{
-		return m_ltrf.getOrigin();
+		return getLocalTransform().getOrigin();
 	}
 
 	void setLocalRotation(const Mat3x4& x)
 	{
-		m_ltrf.setRotation(x);
-		markForUpdate();
+		getLocalTransformForUpdate().setRotation(x);
 	}
 
 	const Mat3x4& getLocalRotation() const
 	{
-		return m_ltrf.getRotation();
+		return getLocalTransform().getRotation();
 	}
 
 	void setLocalScale(F32 x)
 	{
-		m_ltrf.setScale(x);
-		markForUpdate();
+		getLocalTransformForUpdate().setScale(x);
 	}
 
 	F32 getLocalScale() const
 	{
-		return m_ltrf.getScale();
+		return getLocalTransform().getScale();
 	}
 
 	const Transform& getWorldTransform() const
 	{
-		return m_wtrf;
+		return m_transforms->getWorldTransform(m_transformIdx);
 	}
 
 	const Transform& getPreviousWorldTransform() const
 	{
-		return m_prevWTrf;
+		return m_transforms->getPreviousWorldTransform(m_transformIdx);
 	}
 
+	/// The world transform is already computed by the TransformHierarchy. This only reports if it changed.
 	ANKI_USE_RESULT Error update(SceneNode& node, Second prevTime, Second crntTime, Bool& updated) override;
 
 	/// @name Mess with the local transform
 	/// @{
 	void rotateLocalX(F32 angleRad)
 	{
-		m_ltrf.getRotation().rotateXAxis(angleRad);
-		markForUpdate();
+		getLocalTransformForUpdate().getRotation().rotateXAxis(angleRad);
 	}
 	void rotateLocalY(F32 angleRad)
 	{
-		m_ltrf.getRotation().rotateYAxis(angleRad);
-		markForUpdate();
+		getLocalTransformForUpdate().getRotation().rotateYAxis(angleRad);
 	}
 	void rotateLocalZ(F32 angleRad)
 	{
-		m_ltrf.getRotation().rotateZAxis(angleRad);
-		markForUpdate();
+		getLocalTransformForUpdate().getRotation().rotateZAxis(angleRad);
 	}
 	void moveLocalX(F32 distance)
 	{
-		Vec3 x_axis = m_ltrf.getRotation().getColumn(0);
-		m_ltrf.getOrigin() += Vec4(x_axis, 0.0) * distance;
-		markForUpdate();
+		Transform& ltrf = getLocalTransformForUpdate();
+		Vec3 x_axis = ltrf.getRotation().getColumn(0);
+		ltrf.getOrigin() += Vec4(x_axis, 0.0) * distance;
 	}
 	void moveLocalY(F32 distance)
 	{
-		Vec3 y_axis = m_ltrf.getRotation().getColumn(1);
-		m_ltrf.getOrigin() += Vec4(y_axis, 0.0) * distance;
-		markForUpdate();
+		Transform& ltrf = getLocalTransformForUpdate();
+		Vec3 y_axis = ltrf.getRotation().getColumn(1);
+		ltrf.getOrigin() += Vec4(y_axis, 0.0) * distance;
 	}
 	void moveLocalZ(F32 distance)
 	{
-		Vec3 z_axis = m_ltrf.getRotation().getColumn(2);
-		m_ltrf.getOrigin() += Vec4(z_axis, 0.0) * distance;
-		markForUpdate();
+		Transform& ltrf = getLocalTransformForUpdate();
+		Vec3 z_axis = ltrf.getRotation().getColumn(2);
+		ltrf.getOrigin() += Vec4(z_axis, 0.0) * distance;
 	}
 	void scale(F32 s)
 	{
-		m_ltrf.getScale() *= s;
-		markForUpdate();
+		getLocalTransformForUpdate().getScale() *= s;
 	}
 
 	void lookAtPoint(const Vec4& point)
 	{
-		m_ltrf.lookAt(point, Vec4(0.0f, 1.0f, 0.0f, 0.0f));
-		markForUpdate();
+		getLocalTransformForUpdate().lookAt(point, Vec4(0.0f, 1.0f, 0.0f, 0.0f));
 	}
 	/// @}
 
 private:
-	/// The transformation in local space
-	Transform m_ltrf = Transform::getIdentity();
+	TransformHierarchy* m_transforms;
+	U32 m_transformIdx;
 
-	/// The transformation in world space (local combined with parent's transformation)
-	Transform m_wtrf = Transform::getIdentity();
-
-	/// Keep the previous transformation for checking if it moved
-	Transform m_prevWTrf = Transform::getIdentity();
-
-	Bool m_markedForUpdate : 1;
-	Bool m_ignoreLocalTransform : 1;
-	Bool m_ignoreParentTransform : 1;
-
-	void markForUpdate()
+	Transform& getLocalTransformForUpdate()
 	{
-		m_markedForUpdate = true;
+		return m_transforms->getLocalTransformForUpdate(m_transformIdx);
 	}
 
-	/// Called every frame. It updates the @a m_wtrf if @a shouldUpdateWTrf is true. Then it moves to the children.
-	Bool updateWorldTransform(SceneNode& node);
+	/// Make the parent of the transform the transform of the parent node. Called when the hierarchy changes.
+	void updateParentTransform();
 };
 /// @}
 
@@ -86,45 +86,6 @@ public:
 	}
 };
 
-/// Simple particle for simple simulation
-class ParticleEmitterComponent::SimpleParticle : public ParticleEmitterComponent::ParticleBase
-{
-public:
-	Vec3 m_velocity = Vec3(0.0f);
-	Vec3 m_acceleration = Vec3(0.0f);
-
-	void kill()
-	{
-		killCommon();
-	}
-
-	void revive(const ParticleEmitterProperties& props, const Transform& trf, Second prevUpdateTime, Second crntTime)
-	{
-		reviveCommon(props, trf, prevUpdateTime, crntTime);
-		m_velocity = Vec3(0.0f);
-
-		m_acceleration = getRandom(props.m_particle.m_minGravity, props.m_particle.m_maxGravity);
-
-		// Set the initial position
-		m_crntPosition = getRandom(props.m_particle.m_minStartingPosition, props.m_particle.m_maxStartingPosition);
-		m_crntPosition += trf.getOrigin().xyz();
-	}
-
-	void simulate(Second prevUpdateTime, Second crntTime)
-	{
-		simulateCommon(prevUpdateTime, crntTime);
-
-		const F32 dt = F32(crntTime - prevUpdateTime);
-
-		const Vec3 xp = m_crntPosition;
-		const Vec3 xc = m_acceleration * (dt * dt) + m_velocity * dt + xp;
-
-		m_crntPosition = xc;
-
-		m_velocity += m_acceleration * dt;
-	}
-};
-
 /// Particle for bullet simulations
 class ParticleEmitterComponent::PhysicsParticle : public ParticleEmitterComponent::ParticleBase
 {
@@ -204,7 +165,6 @@ ParticleEmitterComponent::ParticleEmitterComponent(SceneNode* node)
 
 ParticleEmitterComponent::~ParticleEmitterComponent()
 {
-	m_simpleParticles.destroy(m_node->getAllocator());
 	m_physicsParticles.destroy(m_node->getAllocator());
 }
 
@@ -222,7 +182,7 @@ Error ParticleEmitterComponent::loadParticleEmitterResource(CString filename)
 	m_props = m_particleEmitterResource->getProperties();
 
 	// Cleanup
-	m_simpleParticles.destroy(m_node->getAllocator());
+	m_simpleSimulation.init(m_node->getAllocator(), 0);
 	m_physicsParticles.destroy(m_node->getAllocator());
 
 	// Init particles
@@ -244,7 +204,7 @@ Error ParticleEmitterComponent::loadParticleEmitterResource(CString filename)
 	}
 	else
 	{
-		m_simpleParticles.create(m_node->getAllocator(), m_props.m_maxNumOfParticles);
+		m_simpleSimulation.init(m_node->getAllocator(), m_props.m_maxNumOfParticles);
 	}
 
 	m_vertBuffSize = m_props.m_maxNumOfParticles * VERTEX_SIZE;
@@ -264,7 +224,7 @@ Error ParticleEmitterComponent::update(SceneNode& node, Second prevTime, Second
 
 	if(m_simulationType == SimulationType::SIMPLE)
 	{
-		simulate(prevTime, crntTime, WeakArray<SimpleParticle>(m_simpleParticles));
+		simulateSimple(prevTime, crntTime);
 	}
 	else
 	{
@@ -379,6 +339,42 @@ void ParticleEmitterComponent::simulate(Second prevUpdateTime, Second crntTime,
 	}
 }
 
+void ParticleEmitterComponent::simulateSimple(Second prevUpdateTime, Second crntTime)
+{
+	F32* verts = reinterpret_cast<F32*>(m_node->getFrameAllocator().allocate(m_vertBuffSize));
+	static_assert(VERTEX_SIZE == ParticleSimulation::VERTEX_FLOAT_COUNT * sizeof(F32), "Wrong vertex layout");
+
+	// The emitters with many particles will be split into tasks
+	Vec3 aabbMin, aabbMax;
+	F32 maxParticleSize;
+	m_simpleSimulation.simulate(F32(crntTime - prevUpdateTime), verts, aabbMin, aabbMax, maxParticleSize,
+								&m_node->getSceneGraph().getThreadHive());
+	m_aliveParticleCount = m_simpleSimulation.getAliveParticleCount();
+
+	if(m_aliveParticleCount != 0)
+	{
+		ANKI_ASSERT(maxParticleSize > 0.0f);
+		m_worldBoundingVolume = Aabb(aabbMin - maxParticleSize, aabbMax + maxParticleSize);
+		m_verts = verts;
+	}
+	else
+	{
+		m_worldBoundingVolume = Aabb(Vec3(0.0f), Vec3(0.001f));
+		m_verts = nullptr;
+	}
+
+	// Emit new particles
+	if(m_timeLeftForNextEmission <= 0.0)
+	{
+		m_simpleSimulation.emit(m_props, m_transform, m_props.m_particlesPerEmission);
+		m_timeLeftForNextEmission = m_props.m_emissionPeriod;
+	}
+	else
+	{
+		m_timeLeftForNextEmission -= crntTime - prevUpdateTime;
+	}
+}
+
 void ParticleEmitterComponent::draw(RenderQueueDrawContext& ctx) const
 {
 	// Early exit
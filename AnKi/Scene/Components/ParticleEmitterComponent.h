@@ -6,6 +6,7 @@
 #pragma once
 
 #include <AnKi/Scene/Components/SceneComponent.h>
+#include <AnKi/Scene/ParticleSimulation.h>
 #include <AnKi/Resource/ParticleEmitterResource.h>
 #include <AnKi/Collision/Aabb.h>
 #include <AnKi/Util/WeakArray.h>
@@ -61,7 +62,6 @@ public:
 
 private:
 	class ParticleBase;
-	class SimpleParticle;
 	class PhysicsParticle;
 
 	enum class SimulationType : U8
@@ -78,7 +78,7 @@ private:
 	ParticleEmitterProperties m_props;
 
 	ParticleEmitterResourcePtr m_particleEmitterResource;
-	DynamicArray<SimpleParticle> m_simpleParticles;
+	ParticleSimulation m_simpleSimulation;
 	DynamicArray<PhysicsParticle> m_physicsParticles;
 	Second m_timeLeftForNextEmission = 0.0;
 	U32 m_aliveParticleCount = 0;
@@ -96,6 +96,8 @@ private:
 	template<typename TParticle>
 	void simulate(Second prevUpdateTime, Second crntTime, WeakArray<TParticle> particles);
 
+	void simulateSimple(Second prevUpdateTime, Second crntTime);
+
 	void draw(RenderQueueDrawContext& ctx) const;
 };
 /// @}
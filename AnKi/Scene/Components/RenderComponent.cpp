@@ -15,7 +15,7 @@ ANKI_SCENE_COMPONENT_STATICS(RenderComponent)
 
 void RenderComponent::allocateAndSetupUniforms(const MaterialResourcePtr& mtl, const RenderQueueDrawContext& ctx,
 											   ConstWeakArray<Mat4> transforms, ConstWeakArray<Mat4> prevTransforms,
-											   StagingGpuMemoryPool& alloc)
+											   StagingGpuMemoryPool& alloc, const Vec4& positionDequantization)
 {
 	ANKI_ASSERT(transforms.getSize() <= MAX_INSTANCE_COUNT);
 	ANKI_ASSERT(prevTransforms.getSize() == transforms.getSize());
@@ -50,6 +50,12 @@ void RenderComponent::allocateAndSetupUniforms(const MaterialResourcePtr& mtl, c
 											   token1.m_offset, token1.m_range);
 	}
 
+	// The textures are referenced through the bindless set. Binding it again for the next draws is a NOP
+	if(mtl->usesBindlessTextures())
+	{
+		ctx.m_commandBuffer->bindAllBindless(mtl->getBindlessDescriptorSetIndex());
+	}
+
 	// Iterate variables
 	for(const MaterialVariable& mvar : mtl->getVariables())
 	{
@@ -60,6 +66,18 @@ void RenderComponent::allocateAndSetupUniforms(const MaterialResourcePtr& mtl, c
 
 		switch(mvar.getDataType())
 		{
+		case ShaderVariableDataType::U32:
+		{
+			const U32 val = mvar.getValue<U32>();
+			variant.writeShaderBlockMemory(mvar, &val, 1, perDrawUniformsBegin, perDrawUniformsEnd);
+
+			if(mvar.isBindlessTexture())
+			{
+				// Keep the texture alive while the command buffer is in flight
+				ctx.m_commandBuffer->addReference(mvar.getValue<ImageResourcePtr>()->getTextureView());
+			}
+			break;
+		}
 		case ShaderVariableDataType::F32:
 		{
 			const F32 val = mvar.getValue<F32>();
@@ -96,8 +114,24 @@ void RenderComponent::allocateAndSetupUniforms(const MaterialResourcePtr& mtl, c
 		}
 		case ShaderVariableDataType::VEC4:
 		{
-			const Vec4 val = mvar.getValue<Vec4>();
-			variant.writeShaderBlockMemory(mvar, &val, 1, perDrawUniformsBegin, perDrawUniformsEnd);
+			switch(mvar.getBuiltin())
+			{
+			case BuiltinMaterialVariableId::NONE:
+			{
+				const Vec4 val = mvar.getValue<Vec4>();
+				variant.writeShaderBlockMemory(mvar, &val, 1, perDrawUniformsBegin, perDrawUniformsEnd);
+				break;
+			}
+			case BuiltinMaterialVariableId::POSITION_DEQUANTIZATION:
+			{
+				variant.writeShaderBlockMemory(mvar, &positionDequantization, 1, perDrawUniformsBegin,
+											   perDrawUniformsEnd);
+				break;
+			}
+			default:
+				ANKI_ASSERT(0);
+			}
+
 			break;
 		}
 		case ShaderVariableDataType::MAT3:
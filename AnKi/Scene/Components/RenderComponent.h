@@ -101,9 +101,11 @@ public:
 	}
 
 	/// Helper function.
+	/// @param positionDequantization See MeshResource::getPositionDequantization().
 	static void allocateAndSetupUniforms(const MaterialResourcePtr& mtl, const RenderQueueDrawContext& ctx,
 										 ConstWeakArray<Mat4> transforms, ConstWeakArray<Mat4> prevTransforms,
-										 StagingGpuMemoryPool& alloc);
+										 StagingGpuMemoryPool& alloc,
+										 const Vec4& positionDequantization = Vec4(0.0f, 0.0f, 0.0f, 1.0f));
 
 private:
 	RenderQueueDrawCallback m_callback = nullptr;
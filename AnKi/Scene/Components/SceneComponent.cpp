@@ -4,15 +4,16 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Scene/Components/SceneComponent.h>
+#include <AnKi/Scene/SceneGraph.h>
 
 namespace anki {
 
-constexpr U32 MAX_SCENE_COMPONENT_CLASSES = 64;
 static_assert(MAX_SCENE_COMPONENT_CLASSES < 128, "It can oly be 7 bits because of SceneComponent::m_classId");
 static SceneComponentRtti* g_rttis[MAX_SCENE_COMPONENT_CLASSES] = {};
 static U32 g_rttiCount = 0;
 
-SceneComponentRtti::SceneComponentRtti(const char* name, U32 size, U32 alignment, Constructor constructor)
+SceneComponentRtti::SceneComponentRtti(const char* name, U32 size, U32 alignment, Constructor constructor,
+									   const char* updateAfter, const char* updateBefore)
 {
 	if(g_rttiCount >= MAX_SCENE_COMPONENT_CLASSES)
 	{
@@ -25,6 +26,8 @@ SceneComponentRtti::SceneComponentRtti(const char* name, U32 size, U32 alignment
 	m_className = name;
 	m_classSize = size;
 	m_classAlignment = alignment;
+	m_updateAfter = updateAfter;
+	m_updateBefore = updateBefore;
 	m_classId = MAX_U8;
 
 	g_rttis[g_rttiCount++] = this;
@@ -42,12 +45,22 @@ SceneComponentRtti::SceneComponentRtti(const char* name, U32 size, U32 alignment
 }
 
 SceneComponent::SceneComponent(SceneNode* node, U8 classId, Bool isFeedbackComponent)
-	: m_classId(classId & 0x7F)
+	: m_node(node)
+	, m_classId(classId & 0x7F)
 	, m_feedbackComponent(isFeedbackComponent)
 {
 	ANKI_ASSERT(classId < g_rttiCount);
 }
 
+void SceneComponent::setActive(Bool active)
+{
+	// Components that don't live in a pool are always updated by their owners
+	if(m_poolIndex != MAX_U32)
+	{
+		m_node->getSceneGraph().setComponentActive(*this, active);
+	}
+}
+
 const SceneComponentRtti& SceneComponent::findClassRtti(CString className)
 {
 	for(U32 i = 0; i < g_rttiCount; ++i)
@@ -71,4 +84,9 @@ const SceneComponentRtti& SceneComponent::findClassRtti(U8 classId)
 	return *g_rttis[classId];
 }
 
+U32 SceneComponent::getClassCount()
+{
+	return g_rttiCount;
+}
+
 } // namespace anki
@@ -14,6 +14,9 @@ namespace anki {
 /// @addtogroup scene
 /// @{
 
+/// The max number of scene component classes.
+constexpr U32 MAX_SCENE_COMPONENT_CLASSES = 64;
+
 /// Scene component class info.
 class SceneComponentRtti
 {
@@ -25,8 +28,11 @@ public:
 	U32 m_classSize;
 	U32 m_classAlignment;
 	Constructor m_constructorCallback;
+	const char* m_updateAfter; ///< Space separated names of the classes that should be updated before this one.
+	const char* m_updateBefore; ///< Space separated names of the classes that should be updated after this one.
 
-	SceneComponentRtti(const char* name, U32 size, U32 alignment, Constructor constructor);
+	SceneComponentRtti(const char* name, U32 size, U32 alignment, Constructor constructor, const char* updateAfter = "",
+					   const char* updateBefore = "");
 };
 
 /// Define a scene component.
@@ -50,9 +56,19 @@ private:
 	SceneComponentRtti className::_m_rtti(ANKI_STRINGIZE(className), sizeof(className), alignof(className), \
 										  className::_construct);
 
+/// Define the statics of a scene component and its place in the update order of the component classes.
+/// @param updateAfter Space separated names of the classes that should be updated before this one.
+/// @param updateBefore Space separated names of the classes that should be updated after this one.
+#define ANKI_SCENE_COMPONENT_STATICS_ORDERED(className, updateAfter, updateBefore) \
+	SceneComponentRtti className::_m_rtti(ANKI_STRINGIZE(className), sizeof(className), alignof(className), \
+										  className::_construct, updateAfter, updateBefore);
+
 /// Scene node component
 class SceneComponent
 {
+	friend class SceneNode;
+	friend class SceneGraph;
+
 public:
 	/// Construct the scene component.
 	SceneComponent(SceneNode* node, U8 classId, Bool isFeedbackComponent = false);
@@ -76,6 +92,26 @@ public:
 		return m_feedbackComponent;
 	}
 
+	/// Get the node that owns this component.
+	SceneNode& getSceneNode()
+	{
+		ANKI_ASSERT(m_node);
+		return *m_node;
+	}
+
+	/// Get the node that owns this component.
+	const SceneNode& getSceneNode() const
+	{
+		ANKI_ASSERT(m_node);
+		return *m_node;
+	}
+
+	/// The index of the component inside its class' SceneComponentPool. It doesn't change during its lifetime.
+	U32 getPoolIndex() const
+	{
+		return m_poolIndex;
+	}
+
 	/// Do some updating
 	/// @param node The owner node of this component.
 	/// @param prevTime Previous update time.
@@ -87,6 +123,13 @@ public:
 		return Error::NONE;
 	}
 
+	/// Wake up the component or put it to sleep. The SceneGraph doesn't call update() on sleeping components.
+	/// Components start awake. Feedback components are put to sleep after every update and they are woken when a
+	/// component that comes before them in their node gets updated. The rest put themselves to sleep when they have no
+	/// work.
+	/// @note It's thread-safe.
+	void setActive(Bool active);
+
 	/// Don't call it.
 	void setTimestamp(Timestamp timestamp)
 	{
@@ -99,8 +142,15 @@ public:
 
 	static const SceneComponentRtti& findClassRtti(U8 classId);
 
+	/// Get the number of the registered component classes.
+	static U32 getClassCount();
+
 private:
 	Timestamp m_timestamp = 1; ///< Indicates when an update happened
+	Timestamp m_updatedTimestamp = 0; ///< The last frame update() changed something. Written by the SceneGraph.
+	Timestamp m_wokenUpTimestamp = 0; ///< The last frame a feedback component was woken up. Written by the SceneNode.
+	SceneNode* m_node;
+	U32 m_poolIndex = MAX_U32;
 	U8 m_classId : 7; ///< Cache the type ID.
 	U8 m_feedbackComponent : 1;
 };
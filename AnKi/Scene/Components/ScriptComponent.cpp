@@ -39,8 +39,8 @@ Error ScriptComponent::loadScriptResource(CString fname)
 	m_env = m_node->getAllocator().newInstance<ScriptEnvironment>();
 	ANKI_CHECK(m_env->init(&m_node->getSceneGraph().getScriptManager()));
 
-	// Exec the script
-	ANKI_CHECK(m_env->evalString(m_script->getSource()));
+	// Exec the script. It's already compiled
+	ANKI_CHECK(m_env->evalBytecode(m_script->getBytecode()));
 
 	return Error::NONE;
 }
@@ -54,10 +54,12 @@ Error ScriptComponent::update(SceneNode& node, Second prevTime, Second crntTime,
 		return Error::NONE;
 	}
 
+	// The VM is shared with other environments
+	LockGuard<Mutex> lock(m_env->getLuaStateMutex());
 	lua_State* lua = &m_env->getLuaState();
 
 	// Push function name
-	lua_getglobal(lua, "update");
+	m_env->pushGlobal("update");
 
 	// Push args
 	LuaBinder::pushVariableToTheStack(lua, &node);
@@ -68,6 +70,7 @@ Error ScriptComponent::update(SceneNode& node, Second prevTime, Second crntTime,
 	if(lua_pcall(lua, 3, 1, 0) != 0)
 	{
 		ANKI_SCENE_LOGE("Error running ScriptComponent's \"update\": %s", lua_tostring(lua, -1));
+		lua_pop(lua, 1);
 		return Error::USER_DATA;
 	}
 
@@ -6,14 +6,18 @@
 #include <AnKi/Scene/Components/SkinComponent.h>
 #include <AnKi/Scene/SceneNode.h>
 #include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Scene/SkinPoseCache.h>
 #include <AnKi/Resource/SkeletonResource.h>
 #include <AnKi/Resource/AnimationResource.h>
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Util/BitSet.h>
+#include <AnKi/Util/Tracer.h>
 
 namespace anki {
 
-ANKI_SCENE_COMPONENT_STATICS(SkinComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(SkinComponent, "ModelComponent", "")
+
+static_assert(SkinComponent::MAX_ANIMATION_TRACKS == SkinPoseKey::MAX_TRACKS, "Wrong constant");
 
 SkinComponent::SkinComponent(SceneNode* node)
 	: SceneComponent(node, getStaticClassId())
@@ -26,6 +30,11 @@ SkinComponent::~SkinComponent()
 	m_boneTrfs[0].destroy(m_node->getAllocator());
 	m_boneTrfs[1].destroy(m_node->getAllocator());
 	m_animationTrfs.destroy(m_node->getAllocator());
+
+	for(Track& track : m_tracks)
+	{
+		track.m_channelBones.destroy(m_node->getAllocator());
+	}
 }
 
 Error SkinComponent::loadSkeletonResource(CString fname)
@@ -36,6 +45,13 @@ Error SkinComponent::loadSkeletonResource(CString fname)
 	m_boneTrfs[1].destroy(m_node->getAllocator());
 	m_animationTrfs.destroy(m_node->getAllocator());
 
+	// The tracks reference the bones of the old skeleton
+	for(Track& track : m_tracks)
+	{
+		track.m_anim.reset(nullptr);
+		track.m_channelBones.destroy(m_node->getAllocator());
+	}
+
 	m_boneTrfs[0].create(m_node->getAllocator(), m_skeleton->getBones().getSize(), Mat4::getIdentity());
 	m_boneTrfs[1].create(m_node->getAllocator(), m_skeleton->getBones().getSize(), Mat4::getIdentity());
 	m_animationTrfs.create(m_node->getAllocator(), m_skeleton->getBones().getSize(),
@@ -46,8 +62,25 @@ Error SkinComponent::loadSkeletonResource(CString fname)
 
 void SkinComponent::playAnimation(U32 track, AnimationResourcePtr anim, const AnimationPlayInfo& info)
 {
+	ANKI_ASSERT(m_skeleton.isCreated() && "Load the skeleton first");
 	const Second animDuration = anim->getDuration();
 
+	// Find the bones of the channels once
+	DynamicArray<U32>& channelBones = m_tracks[track].m_channelBones;
+	channelBones.destroy(m_node->getAllocator());
+	channelBones.create(m_node->getAllocator(), anim->getChannels().getSize());
+	for(U32 i = 0; i < channelBones.getSize(); ++i)
+	{
+		const AnimationChannel& channel = anim->getChannels()[i];
+		const Bone* bone = m_skeleton->tryFindBone(channel.m_name.toCString());
+		if(!bone)
+		{
+			ANKI_SCENE_LOGW("Animation is referencing unknown bone \"%s\"", &channel.m_name[0]);
+		}
+
+		channelBones[i] = (bone) ? bone->getIndex() : MAX_U32;
+	}
+
 	m_tracks[track].m_anim = anim;
 	m_tracks[track].m_absoluteStartTime = m_absoluteTime + info.m_startTime;
 	m_tracks[track].m_relativeTimePassed = 0.0;
@@ -62,6 +95,8 @@ void SkinComponent::playAnimation(U32 track, AnimationResourcePtr anim, const An
 		m_tracks[track].m_blendOutTime = 0.0; // Irrelevant
 	}
 	m_tracks[track].m_repeatTimes = info.m_repeatTimes;
+
+	setActive(true);
 }
 
 Error SkinComponent::update(SceneNode& node, Second prevTime, Second crntTime, Bool& updated)
@@ -76,13 +111,17 @@ Error SkinComponent::update(SceneNode& node, Second prevTime, Second crntTime, B
 
 	const Second dt = crntTime - prevTime;
 
-	Vec4 minExtend(MAX_F32, MAX_F32, MAX_F32, 0.0f);
-	Vec4 maxExtend(MIN_F32, MIN_F32, MIN_F32, 0.0f);
+	// Advance the tracks and gather everything the pose depends on
+	SkinPoseKey poseKey;
+	poseKey.m_skeleton = m_skeleton.get();
+	Array<Second, MAX_ANIMATION_TRACKS> animTimes;
+	Bool tracksPending = false;
 
-	BitSet<128> bonesAnimated(false);
-
-	for(Track& track : m_tracks)
+	for(U32 t = 0; t < MAX_ANIMATION_TRACKS; ++t)
 	{
+		Track& track = m_tracks[t];
+		animTimes[t] = -1.0;
+
 		if(!track.m_anim.isCreated())
 		{
 			continue;
@@ -91,11 +130,11 @@ Error SkinComponent::update(SceneNode& node, Second prevTime, Second crntTime, B
 		if(track.m_absoluteStartTime > m_absoluteTime)
 		{
 			// Hasn't started yet
+			tracksPending = true;
 			continue;
 		}
 
-		const Second clipDuration = track.m_anim->getDuration();
-		const Second animationDuration = track.m_repeatTimes * clipDuration;
+		const Second animationDuration = track.m_repeatTimes * track.m_anim->getDuration();
 
 		if(track.m_repeatTimes > 0.0 && track.m_relativeTimePassed > animationDuration)
 		{
@@ -104,21 +143,90 @@ Error SkinComponent::update(SceneNode& node, Second prevTime, Second crntTime, B
 		}
 
 		updated = true;
+		tracksPending = true;
 
-		const Second animTime = track.m_relativeTimePassed;
+		animTimes[t] = track.m_relativeTimePassed;
 		track.m_relativeTimePassed += dt;
 
+		SkinPoseKey::Track& trackKey = poseKey.m_tracks[poseKey.m_trackCount++];
+		trackKey.m_animation = track.m_anim.get();
+		trackKey.m_time = animTimes[t];
+		trackKey.m_blendInTime = track.m_blendInTime;
+		trackKey.m_blendOutTime = track.m_blendOutTime;
+		trackKey.m_duration = animationDuration;
+	}
+
+	// Always update the 1st time
+	updated = updated || (m_absoluteTime == 0.0);
+
+	if(updated)
+	{
+		m_prevBoneTrfs = m_crntBoneTrfs;
+		m_crntBoneTrfs = m_crntBoneTrfs ^ 1;
+
+		// Skins that play the same animations at the same time have the same pose. Compute it once per frame
+		SkinPoseCache& poseCache = m_node->getSceneGraph().getSkinPoseCache();
+		SkinPose pose;
+		Bool storePose;
+		if(poseCache.tryGetPose(poseKey, pose, storePose))
+		{
+			ANKI_ASSERT(pose.m_boneTransforms.getSize() == m_boneTrfs[m_crntBoneTrfs].getSize());
+			memcpy(&m_boneTrfs[m_crntBoneTrfs][0], &pose.m_boneTransforms[0],
+				   pose.m_boneTransforms.getSize() * sizeof(Mat4));
+			m_boneBoundingVolume = pose.m_boneBoundingVolume;
+			ANKI_TRACE_INC_COUNTER(SCENE_SKIN_POSES_SHARED, 1);
+		}
+		else
+		{
+			BitSet<128> bonesAnimated(false);
+			sampleTracks(animTimes, bonesAnimated);
+			computeBoneTransforms(bonesAnimated);
+
+			if(storePose)
+			{
+				pose.m_boneTransforms = m_boneTrfs[m_crntBoneTrfs];
+				pose.m_boneBoundingVolume = m_boneBoundingVolume;
+				poseCache.storePose(poseKey, pose);
+			}
+		}
+	}
+	else
+	{
+		m_prevBoneTrfs = m_crntBoneTrfs;
+	}
+
+	m_absoluteTime += dt;
+
+	// Sleep when there is nothing to animate and the previous bone transforms caught up. playAnimation() wakes it up
+	if(!updated && !tracksPending)
+	{
+		setActive(false);
+	}
+
+	return Error::NONE;
+}
+
+void SkinComponent::sampleTracks(ConstWeakArray<Second> animTimes, BitSet<128>& bonesAnimated)
+{
+	for(U32 t = 0; t < MAX_ANIMATION_TRACKS; ++t)
+	{
+		const Track& track = m_tracks[t];
+		const Second animTime = animTimes[t];
+		if(animTime < 0.0)
+		{
+			continue;
+		}
+
+		const Second animationDuration = track.m_repeatTimes * track.m_anim->getDuration();
+
 		// Iterate the animation channels and interpolate
 		for(U32 i = 0; i < track.m_anim->getChannels().getSize(); ++i)
 		{
-			const AnimationChannel& channel = track.m_anim->getChannels()[i];
-			const Bone* bone = m_skeleton->tryFindBone(channel.m_name.toCString());
-			if(!bone)
+			const U32 boneIdx = track.m_channelBones[i];
+			if(boneIdx == MAX_U32)
 			{
-				ANKI_SCENE_LOGW("Animation is referencing unknown bone \"%s\"", &channel.m_name[0]);
 				continue;
 			}
-			const U32 boneIdx = bone->getIndex();
 
 			// Interpolate
 			Vec3 position;
@@ -166,58 +274,55 @@ Error SkinComponent::update(SceneNode& node, Second prevTime, Second crntTime, B
 			m_animationTrfs[boneIdx] = {position, rotation, scale};
 		}
 	}
+}
 
-	// Always update the 1st time
-	updated = updated || (m_absoluteTime == 0.0);
-
-	if(updated)
-	{
-		m_prevBoneTrfs = m_crntBoneTrfs;
-		m_crntBoneTrfs = m_crntBoneTrfs ^ 1;
+void SkinComponent::computeBoneTransforms(const BitSet<128>& bonesAnimated)
+{
+	const ConstWeakArray<U32> boneIndices = m_skeleton->getSortedBoneIndices();
+	const ConstWeakArray<U32> boneParents = m_skeleton->getSortedBoneParents();
+	const ConstWeakArray<Mat3x4> boneLocalTrfs = m_skeleton->getSortedBoneTransforms();
+	const ConstWeakArray<Mat3x4> boneVertTrfs = m_skeleton->getSortedBoneVertexTransforms();
+	const U32 boneCount = boneIndices.getSize();
+	DynamicArray<Mat4>& boneTrfs = m_boneTrfs[m_crntBoneTrfs];
 
-		// Walk the bone hierarchy to add additional transforms
-		visitBones(m_skeleton->getRootBone(), Mat4::getIdentity(), bonesAnimated, minExtend, maxExtend);
+	Vec4 minExtend(MAX_F32, MAX_F32, MAX_F32, 0.0f);
+	Vec4 maxExtend(MIN_F32, MIN_F32, MIN_F32, 0.0f);
 
-		const Vec4 E(EPSILON, EPSILON, EPSILON, 0.0f);
-		m_boneBoundingVolume.setMin(minExtend - E);
-		m_boneBoundingVolume.setMax(maxExtend + E);
-	}
-	else
+	// The bones are sorted so the parents are computed before their children. No recursion
+	Array<Mat3x4, MAX_BONES_PER_SKELETON> worldTrfs;
+	for(U32 pos = 0; pos < boneCount; ++pos)
 	{
-		m_prevBoneTrfs = m_crntBoneTrfs;
-	}
+		const U32 boneIdx = boneIndices[pos];
 
-	m_absoluteTime += dt;
+		Mat3x4 localTrf;
+		if(bonesAnimated.get(boneIdx))
+		{
+			const Trf& t = m_animationTrfs[boneIdx];
+			localTrf = Mat3x4(t.m_translation, t.m_rotation, t.m_scale);
+		}
+		else
+		{
+			localTrf = boneLocalTrfs[pos];
+		}
 
-	return Error::NONE;
-}
+		const U32 parentPos = boneParents[pos];
+		worldTrfs[pos] = (parentPos != MAX_U32) ? worldTrfs[parentPos].combineTransformations(localTrf) : localTrf;
 
-void SkinComponent::visitBones(const Bone& bone, const Mat4& parentTrf, const BitSet<128>& bonesAnimated,
-							   Vec4& minExtend, Vec4& maxExtend)
-{
-	Mat4 outMat;
+		const Mat3x4 boneTrf = worldTrfs[pos].combineTransformations(boneVertTrfs[pos]);
+		boneTrfs[boneIdx].setRows(boneTrf.getRow(0), boneTrf.getRow(1), boneTrf.getRow(2),
+								  Vec4(0.0f, 0.0f, 0.0f, 1.0f));
 
-	if(bonesAnimated.get(bone.getIndex()))
-	{
-		const Trf& t = m_animationTrfs[bone.getIndex()];
-		outMat = parentTrf * Mat4(t.m_translation.xyz1(), Mat3(t.m_rotation), t.m_scale);
+		// Update volume
+		const Vec4 bonePos = worldTrfs[pos].getTranslationPart().xyz0();
+		minExtend = minExtend.min(bonePos);
+		maxExtend = maxExtend.max(bonePos);
 	}
-	else
-	{
-		outMat = parentTrf * bone.getTransform();
-	}
-
-	m_boneTrfs[m_crntBoneTrfs][bone.getIndex()] = outMat * bone.getVertexTransform();
 
-	// Update volume
-	const Vec4 bonePos = outMat * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
-	minExtend = minExtend.min(bonePos.xyz0());
-	maxExtend = maxExtend.max(bonePos.xyz0());
+	const Vec4 E(EPSILON, EPSILON, EPSILON, 0.0f);
+	m_boneBoundingVolume.setMin(minExtend - E);
+	m_boneBoundingVolume.setMax(maxExtend + E);
 
-	for(const Bone* child : bone.getChildren())
-	{
-		visitBones(*child, outMat, bonesAnimated, minExtend, maxExtend);
-	}
+	ANKI_TRACE_INC_COUNTER(SCENE_SKIN_BONES_EVALUATED, boneCount);
 }
 
 } // end namespace anki
@@ -83,6 +83,7 @@ private:
 	{
 	public:
 		AnimationResourcePtr m_anim;
+		DynamicArray<U32> m_channelBones; ///< The bone of each channel of the animation or MAX_U32.
 		Second m_absoluteStartTime = 0.0;
 		Second m_relativeTimePassed = 0.0;
 		Second m_blendInTime = 0.0;
@@ -108,8 +109,9 @@ private:
 	U8 m_crntBoneTrfs = 0;
 	U8 m_prevBoneTrfs = 1;
 
-	void visitBones(const Bone& bone, const Mat4& parentTrf, const BitSet<128, U8>& bonesAnimated, Vec4& minExtend,
-					Vec4& maxExtend);
+	void sampleTracks(ConstWeakArray<Second> animTimes, BitSet<128, U8>& bonesAnimated);
+
+	void computeBoneTransforms(const BitSet<128, U8>& bonesAnimated);
 };
 /// @}
 
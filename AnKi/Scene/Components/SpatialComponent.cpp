@@ -9,7 +9,7 @@
 
 namespace anki {
 
-ANKI_SCENE_COMPONENT_STATICS(SpatialComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(SpatialComponent, "MoveComponent FrustumComponent", "RenderComponent")
 
 SpatialComponent::SpatialComponent(SceneNode* node)
 	: SceneComponent(node, getStaticClassId())
@@ -18,6 +18,7 @@ SpatialComponent::SpatialComponent(SceneNode* node)
 	, m_placed(false)
 	, m_updateOctreeBounds(true)
 	, m_alwaysVisible(false)
+	, m_static(false)
 {
 	ANKI_ASSERT(node);
 	m_octreeInfo.m_userData = this;
@@ -52,7 +53,7 @@ void SpatialComponent::setConvexHullWorldSpace(const ConvexHullShape& hull)
 	}
 
 	m_collisionObjectType = hull.CLASS_TYPE;
-	m_markedForUpdate = true;
+	markForUpdate();
 }
 
 Error SpatialComponent::update(SceneNode& node, Second prevTime, Second crntTime, Bool& updated)
@@ -94,7 +95,8 @@ Error SpatialComponent::update(SceneNode& node, Second prevTime, Second crntTime
 		m_placed = true;
 	}
 
-	m_octreeInfo.reset();
+	// Nothing to do until the shape changes again. The Octree resets the visited state of the placeables
+	setActive(false);
 
 	return Error::NONE;
 }
@@ -31,21 +31,21 @@ public:
 	{
 		m_obb = obb;
 		m_collisionObjectType = obb.CLASS_TYPE;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	void setAabbWorldSpace(const Aabb& aabb)
 	{
 		m_aabb = aabb;
 		m_collisionObjectType = aabb.CLASS_TYPE;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	void setSphereWorldSpace(const Sphere& sphere)
 	{
 		m_sphere = sphere;
 		m_collisionObjectType = sphere.CLASS_TYPE;
-		m_markedForUpdate = true;
+		markForUpdate();
 	}
 
 	void setConvexHullWorldSpace(const ConvexHullShape& hull);
@@ -110,6 +110,18 @@ public:
 		return m_alwaysVisible;
 	}
 
+	/// Mark it as static. Static nodes are not expected to move or change and the renderer can cache things for them
+	/// (eg shadow casters).
+	void setStatic(Bool isStatic)
+	{
+		m_static = isStatic;
+	}
+
+	Bool getStatic() const
+	{
+		return m_static;
+	}
+
 	ANKI_USE_RESULT Error update(SceneNode& node, Second prevTime, Second crntTime, Bool& updated) override;
 
 private:
@@ -137,6 +149,14 @@ private:
 	Bool m_placed : 1;
 	Bool m_updateOctreeBounds : 1;
 	Bool m_alwaysVisible : 1;
+	Bool m_static : 1;
+
+	/// Re-place it in the next update. It also wakes up the component.
+	void markForUpdate()
+	{
+		m_markedForUpdate = true;
+		setActive(true);
+	}
 };
 /// @}
 
@@ -35,7 +35,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(DecalNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(DecalNode::MoveFeedbackComponent, "MoveComponent", "DecalComponent")
 
 /// Decal feedback component.
 class DecalNode::ShapeFeedbackComponent : public SceneComponent
@@ -63,7 +63,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(DecalNode::ShapeFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(DecalNode::ShapeFeedbackComponent, "DecalComponent", "SpatialComponent")
 
 DecalNode::DecalNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
@@ -13,6 +13,8 @@ namespace anki {
 AnimationEvent::AnimationEvent(EventManager* manager)
 	: Event(manager)
 {
+	// It only sets the local transform of its node
+	m_parallelUpdate = true;
 }
 
 Error AnimationEvent::init(const AnimationResourcePtr& anim, SceneNode* movableSceneNode)
@@ -22,7 +24,7 @@ Error AnimationEvent::init(const AnimationResourcePtr& anim, SceneNode* movableS
 
 	Event::init(m_anim->getStartingTime(), m_anim->getDuration());
 	m_reanimate = true;
-	m_associatedNodes.emplaceBack(getAllocator(), movableSceneNode);
+	addAssociatedSceneNode(movableSceneNode);
 
 	return Error::NONE;
 }
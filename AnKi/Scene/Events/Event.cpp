@@ -18,6 +18,7 @@ Event::Event(EventManager* manager)
 Event::~Event()
 {
 	m_associatedNodes.destroy(getAllocator());
+	m_associatedNodeHandles.destroy(getAllocator());
 }
 
 void Event::init(Second startTime, Second duration)
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include <AnKi/Scene/Common.h>
+#include <AnKi/Scene/SceneNode.h>
 #include <AnKi/Util/List.h>
 #include <AnKi/Util/WeakArray.h>
 
@@ -85,6 +85,7 @@ public:
 	{
 		ANKI_ASSERT(node);
 		m_associatedNodes.emplaceBack(getAllocator(), node);
+		m_associatedNodeHandles.emplaceBack(getAllocator(), node->getHandle());
 	}
 
 	/// This method should be implemented by the derived classes
@@ -111,7 +112,12 @@ protected:
 	Bool m_markedForDeletion = false;
 	Bool m_reanimate = false;
 
+	/// Set it to true if the event touches only its associated node and it's safe to update it in parallel with the
+	/// events of other nodes. Events with none or many associated nodes are always updated serially.
+	Bool m_parallelUpdate = false;
+
 	DynamicArray<SceneNode*> m_associatedNodes;
+	DynamicArray<SceneNodeHandle> m_associatedNodeHandles; ///< Used to check if the nodes are still alive.
 
 	/// @param startTime The time the event will start. If it's < 0 then start the event now.
 	/// @param duration The duration of the event.
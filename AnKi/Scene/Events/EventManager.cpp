@@ -6,9 +6,29 @@
 #include <AnKi/Scene/Events/EventManager.h>
 #include <AnKi/Scene/Events/Event.h>
 #include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/Tracer.h>
 
 namespace anki {
 
+/// Each thread will get a few partitions to balance the load.
+constexpr U32 PARTITIONS_PER_THREAD = 4;
+
+/// Update serially if there are less events than that.
+constexpr U32 MIN_EVENTS_FOR_PARALLEL_UPDATE = 64;
+
+class EventManager::UpdateCtx
+{
+public:
+	EventManager* m_manager = nullptr;
+	ConstWeakArray<Event*> m_events; ///< Sorted by partition.
+	ConstWeakArray<U32> m_partitionOffsets; ///< Where each partition starts in m_events. Has an extra element.
+	Second m_prevUpdateTime = 0.0;
+	Second m_crntTime = 0.0;
+	Atomic<U32> m_crntPartition = {0};
+	Atomic<U32> m_error = {0};
+};
+
 EventManager::EventManager()
 {
 }
@@ -21,7 +41,7 @@ EventManager::~EventManager()
 		event->setMarkedForDeletion();
 	}
 
-	deleteEventsMarkedForDeletion(false);
+	deleteEventsMarkedForDeletion();
 }
 
 Error EventManager::init(SceneGraph* scene)
@@ -43,64 +63,167 @@ SceneFrameAllocator<U8> EventManager::getFrameAllocator() const
 
 Error EventManager::updateAllEvents(Second prevUpdateTime, Second crntTime)
 {
-	Error err = Error::NONE;
+	ANKI_TRACE_SCOPED_EVENT(SCENE_EVENTS_UPDATE);
+
+	SceneFrameAllocator<U8> frameAlloc = getFrameAllocator();
+	ThreadHive& hive = m_scene->getThreadHive();
+	const U32 partitionCount = hive.getThreadCount() * PARTITIONS_PER_THREAD;
 
+	// Gather the events. The events of deleted nodes were removed in markEventsOfNodesMarkedForDeletion(). Skip the
+	// events of nodes that got marked for deletion since then, they will be removed before their nodes get deleted
+	DynamicArrayAuto<Event*> parallelEvents(frameAlloc);
+	DynamicArrayAuto<Event*> serialEvents(frameAlloc);
 	for(Event& event : m_events)
 	{
-		// If event or the node's event is marked for deletion then dont do anything else for that event
-		if(event.getMarkedForDeletion())
+		ANKI_ASSERT(!event.getMarkedForDeletion());
+
+		Bool nodesAlive = true;
+		for(SceneNodeHandle handle : event.m_associatedNodeHandles)
+		{
+			if(!m_scene->isNodeHandleValid(handle))
+			{
+				nodesAlive = false;
+				break;
+			}
+		}
+
+		if(!nodesAlive)
 		{
 			continue;
 		}
+		else if(event.m_parallelUpdate && event.m_associatedNodeHandles.getSize() == 1)
+		{
+			parallelEvents.emplaceBack(&event);
+		}
+		else
+		{
+			serialEvents.emplaceBack(&event);
+		}
+	}
 
-		// Check if the associated scene nodes are marked for deletion
-		Bool skip = false;
-		for(SceneNode* node : event.m_associatedNodes)
+	Error err = Error::NONE;
+
+	if(parallelEvents.getSize() < MIN_EVENTS_FOR_PARALLEL_UPDATE || hive.getThreadCount() <= 1)
+	{
+		// Not worth it, update them serially in the order they were created
+		for(Event* event : parallelEvents)
 		{
-			if(node->getMarkedForDeletion())
+			if(updateEvent(*event, prevUpdateTime, crntTime))
 			{
-				skip = true;
-				break;
+				err = Error::FUNCTION_FAILED;
 			}
 		}
+	}
+	else
+	{
+		// Sort the events by partition. It's a stable sort so the events of the same node keep their order
+		DynamicArrayAuto<U32> partitionOffsets(frameAlloc, partitionCount + 1, 0);
+		for(Event* event : parallelEvents)
+		{
+			++partitionOffsets[event->m_associatedNodeHandles[0].getSlot() % partitionCount + 1];
+		}
 
-		if(skip)
+		for(U32 i = 1; i <= partitionCount; ++i)
 		{
-			continue;
+			partitionOffsets[i] += partitionOffsets[i - 1];
 		}
 
-		// Audjust starting time
-		if(event.m_startTime < 0.0)
+		DynamicArrayAuto<U32> partitionCounts(frameAlloc, partitionCount, 0);
+		DynamicArrayAuto<Event*> sortedEvents(frameAlloc, parallelEvents.getSize());
+		for(Event* event : parallelEvents)
 		{
-			event.m_startTime = crntTime;
+			const U32 partition = event->m_associatedNodeHandles[0].getSlot() % partitionCount;
+			sortedEvents[partitionOffsets[partition] + partitionCounts[partition]++] = event;
 		}
 
-		// Check if dead
-		if(!event.isDead(crntTime))
+		UpdateCtx ctx;
+		ctx.m_manager = this;
+		ctx.m_events = sortedEvents;
+		ctx.m_partitionOffsets = partitionOffsets;
+		ctx.m_prevUpdateTime = prevUpdateTime;
+		ctx.m_crntTime = crntTime;
+
+		const U32 threadCount = hive.getThreadCount();
+		Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+		for(U32 i = 0; i < threadCount; ++i)
 		{
-			// If not dead update it
+			tasks[i] = ANKI_THREAD_HIVE_TASK({ EventManager::updatePartitions(*self); }, &ctx, nullptr, nullptr);
+		}
 
-			if(event.getStartTime() <= crntTime)
-			{
-				err = event.update(prevUpdateTime, crntTime);
-			}
+		hive.submitTasks(&tasks[0], threadCount);
+		hive.waitAllTasks();
+
+		if(ctx.m_error.load())
+		{
+			err = Error::FUNCTION_FAILED;
 		}
-		else
+	}
+
+	// The events that might touch more than one node go last
+	for(Event* event : serialEvents)
+	{
+		if(updateEvent(*event, prevUpdateTime, crntTime))
 		{
-			// Dead
+			err = Error::FUNCTION_FAILED;
+		}
+	}
 
-			if(event.getReanimate())
+	ANKI_TRACE_INC_COUNTER(SCENE_EVENTS_UPDATED, parallelEvents.getSize() + serialEvents.getSize());
+
+	return err;
+}
+
+void EventManager::updatePartitions(UpdateCtx& ctx)
+{
+	const U32 partitionCount = ctx.m_partitionOffsets.getSize() - 1;
+	U32 partition;
+	while((partition = ctx.m_crntPartition.fetchAdd(1)) < partitionCount)
+	{
+		for(U32 i = ctx.m_partitionOffsets[partition]; i < ctx.m_partitionOffsets[partition + 1]; ++i)
+		{
+			if(ctx.m_manager->updateEvent(*ctx.m_events[i], ctx.m_prevUpdateTime, ctx.m_crntTime))
 			{
-				event.m_startTime = prevUpdateTime;
-				err = event.update(prevUpdateTime, crntTime);
+				ctx.m_error.store(1);
 			}
-			else
+		}
+	}
+}
+
+Error EventManager::updateEvent(Event& event, Second prevUpdateTime, Second crntTime)
+{
+	Error err = Error::NONE;
+
+	// Audjust starting time
+	if(event.m_startTime < 0.0)
+	{
+		event.m_startTime = crntTime;
+	}
+
+	// Check if dead
+	if(!event.isDead(crntTime))
+	{
+		// If not dead update it
+
+		if(event.getStartTime() <= crntTime)
+		{
+			err = event.update(prevUpdateTime, crntTime);
+		}
+	}
+	else
+	{
+		// Dead
+
+		if(event.getReanimate())
+		{
+			event.m_startTime = prevUpdateTime;
+			err = event.update(prevUpdateTime, crntTime);
+		}
+		else
+		{
+			err = event.onKilled(prevUpdateTime, crntTime);
+			if(err || !event.getReanimate())
 			{
-				err = event.onKilled(prevUpdateTime, crntTime);
-				if(err || !event.getReanimate())
-				{
-					event.setMarkedForDeletion();
-				}
+				event.setMarkedForDeletion();
 			}
 		}
 	}
@@ -122,34 +245,31 @@ void EventManager::markEventForDeletion(Event* event)
 	m_eventsMarkedForDeletion.pushBack(event);
 }
 
-void EventManager::deleteEventsMarkedForDeletion(Bool fullCleanup)
+void EventManager::markEventsOfNodesMarkedForDeletion()
 {
-	SceneAllocator<U8> alloc = getAllocator();
-
-	// Mark events with to-be-deleted nodes as also to be deleted
-	if(fullCleanup)
+	auto it = m_events.getBegin();
+	auto end = m_events.getEnd();
+	while(it != end)
 	{
-		// Gather in an array because we can't call setMarkedForDeletion while iterating m_events
-		DynamicArrayAuto<Event*> markedForDeletion(getFrameAllocator());
-		for(Event& event : m_events)
+		// Move to the next before the event is removed from the list
+		Event& event = *it;
+		++it;
+
+		for(SceneNode* node : event.m_associatedNodes)
 		{
-			for(SceneNode* node : event.m_associatedNodes)
+			if(node->getMarkedForDeletion())
 			{
-				if(node->getMarkedForDeletion())
-				{
-					markedForDeletion.emplaceBack(&event);
-					break;
-				}
+				event.setMarkedForDeletion();
+				break;
 			}
 		}
-
-		for(Event* event : markedForDeletion)
-		{
-			event->setMarkedForDeletion();
-		}
 	}
+}
+
+void EventManager::deleteEventsMarkedForDeletion()
+{
+	SceneAllocator<U8> alloc = getAllocator();
 
-	// Gather events for deletion
 	while(!m_eventsMarkedForDeletion.isEmpty())
 	{
 		Event* event = &m_eventsMarkedForDeletion.getFront();
@@ -55,21 +55,33 @@ public:
 		return err;
 	}
 
-	/// Update
+	/// Update all events. The events that are associated with a single node are partitioned by their node and the
+	/// partitions are updated in parallel. The events of the same node are updated in creation order. The rest of the
+	/// events are updated serially after that.
 	ANKI_USE_RESULT Error updateAllEvents(Second prevUpdateTime, Second crntTime);
 
+	/// Mark for deletion the events that are associated with nodes that are marked for deletion. Call it before the
+	/// nodes are deleted.
+	void markEventsOfNodesMarkedForDeletion();
+
 	/// Delete events that pending deletion
-	void deleteEventsMarkedForDeletion(Bool fullCleanup);
+	void deleteEventsMarkedForDeletion();
 
 	/// @note It's thread-safe against itself.
 	void markEventForDeletion(Event* event);
 
 private:
+	class UpdateCtx;
+
 	SceneGraph* m_scene = nullptr;
 
 	IntrusiveList<Event> m_events;
 	IntrusiveList<Event> m_eventsMarkedForDeletion;
 	Mutex m_mtx;
+
+	ANKI_USE_RESULT Error updateEvent(Event& event, Second prevUpdateTime, Second crntTime);
+
+	static void updatePartitions(UpdateCtx& ctx);
 };
 /// @}
 
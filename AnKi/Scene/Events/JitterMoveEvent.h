@@ -21,6 +21,8 @@ public:
 	JitterMoveEvent(EventManager* manager)
 		: Event(manager)
 	{
+		// It only sets the local transform of its node
+		m_parallelUpdate = true;
 	}
 
 	ANKI_USE_RESULT Error init(Second startTime, Second duration, SceneNode* movableSceneNode);
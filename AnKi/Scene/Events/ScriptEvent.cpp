@@ -39,8 +39,8 @@ Error ScriptEvent::init(Second startTime, Second duration, CString script)
 		// It's a file
 		ANKI_CHECK(getSceneGraph().getResourceManager().loadResource(script, m_scriptRsrc));
 
-		// Exec the script
-		ANKI_CHECK(m_env.evalString(m_scriptRsrc->getSource()));
+		// Exec the script. It's already compiled
+		ANKI_CHECK(m_env.evalBytecode(m_scriptRsrc->getBytecode()));
 	}
 	else
 	{
@@ -56,10 +56,12 @@ Error ScriptEvent::init(Second startTime, Second duration, CString script)
 
 Error ScriptEvent::update(Second prevUpdateTime, Second crntTime)
 {
+	// The VM is shared with other environments
+	LockGuard<Mutex> lock(m_env.getLuaStateMutex());
 	lua_State* lua = &m_env.getLuaState();
 
 	// Push function name
-	lua_getglobal(lua, "update");
+	m_env.pushGlobal("update");
 
 	// Push args
 	LuaBinder::pushVariableToTheStack(lua, static_cast<Event*>(this));
@@ -70,6 +72,7 @@ Error ScriptEvent::update(Second prevUpdateTime, Second crntTime)
 	if(lua_pcall(lua, 3, 1, 0) != 0)
 	{
 		ANKI_SCENE_LOGE("Error running ScriptEvent's \"update\": %s", lua_tostring(lua, -1));
+		lua_pop(lua, 1);
 		return Error::USER_DATA;
 	}
 
@@ -95,10 +98,12 @@ Error ScriptEvent::update(Second prevUpdateTime, Second crntTime)
 
 Error ScriptEvent::onKilled(Second prevUpdateTime, Second crntTime)
 {
+	// The VM is shared with other environments
+	LockGuard<Mutex> lock(m_env.getLuaStateMutex());
 	lua_State* lua = &m_env.getLuaState();
 
 	// Push function name
-	lua_getglobal(lua, "onKilled");
+	m_env.pushGlobal("onKilled");
 
 	// Push args
 	LuaBinder::pushVariableToTheStack(lua, static_cast<Event*>(this));
@@ -109,6 +114,7 @@ Error ScriptEvent::onKilled(Second prevUpdateTime, Second crntTime)
 	if(lua_pcall(lua, 3, 1, 0) != 0)
 	{
 		ANKI_SCENE_LOGE("Error running ScriptEvent's \"onKilled\": %s", lua_tostring(lua, -1));
+		lua_pop(lua, 1);
 		return Error::USER_DATA;
 	}
 
@@ -34,7 +34,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(FogDensityNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(FogDensityNode::MoveFeedbackComponent, "MoveComponent", "FogDensityComponent")
 
 class FogDensityNode::DensityShapeFeedbackComponent : public SceneComponent
 {
@@ -60,7 +60,8 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(FogDensityNode::DensityShapeFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(FogDensityNode::DensityShapeFeedbackComponent, "FogDensityComponent",
+									 "SpatialComponent")
 
 FogDensityNode::FogDensityNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
@@ -43,7 +43,8 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(GlobalIlluminationProbeNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(GlobalIlluminationProbeNode::MoveFeedbackComponent, "MoveComponent",
+									 "GlobalIlluminationProbeComponent")
 
 /// Feedback component
 class GlobalIlluminationProbeNode::ShapeFeedbackComponent : public SceneComponent
@@ -74,11 +75,16 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(GlobalIlluminationProbeNode::ShapeFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(GlobalIlluminationProbeNode::ShapeFeedbackComponent,
+									 "GlobalIlluminationProbeComponent",
+									 "FrustumComponent SpatialComponent")
 
 GlobalIlluminationProbeNode::GlobalIlluminationProbeNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
 {
+	// It has to check if the probe is marked for rendering every frame
+	setNeedsFrameUpdate(true);
+
 	// Move component first
 	newComponent<MoveComponent>();
 
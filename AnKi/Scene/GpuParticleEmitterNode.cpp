@@ -38,7 +38,8 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(GpuParticleEmitterNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(GpuParticleEmitterNode::MoveFeedbackComponent, "MoveComponent",
+									 "GpuParticleEmitterComponent")
 
 /// Feedback component
 class GpuParticleEmitterNode::ShapeFeedbackComponent : public SceneComponent
@@ -66,11 +67,15 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(GpuParticleEmitterNode::ShapeFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(GpuParticleEmitterNode::ShapeFeedbackComponent, "GpuParticleEmitterComponent",
+									 "SpatialComponent")
 
 GpuParticleEmitterNode::GpuParticleEmitterNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
 {
+	// It has to check the properties of its components every frame
+	setNeedsFrameUpdate(true);
+
 	// Create the components
 	newComponent<MoveComponent>();
 	newComponent<MoveFeedbackComponent>();
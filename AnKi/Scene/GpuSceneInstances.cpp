@@ -0,0 +1,132 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/GpuSceneInstances.h>
+#include <AnKi/Renderer/RenderQueue.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+
+GpuSceneInstances::~GpuSceneInstances()
+{
+	m_instances.destroy(m_alloc);
+	m_instanceDirty.destroy(m_alloc);
+	m_freeInstances.destroy(m_alloc);
+	m_dirtyInstances.destroy(m_alloc);
+	m_drawBucketGroupIndices.destroy(m_alloc);
+}
+
+U32 GpuSceneInstances::newInstance(U64 drawBucketKey)
+{
+	LockGuard<Mutex> lock(m_mtx);
+
+	// Find or create the bucket group
+	U32 groupIdx;
+	auto it = m_drawBucketGroupIndices.find(drawBucketKey);
+	if(it != m_drawBucketGroupIndices.getEnd())
+	{
+		groupIdx = *it;
+	}
+	else
+	{
+		groupIdx = m_drawBucketGroupCount++;
+		m_drawBucketGroupIndices.emplace(m_alloc, drawBucketKey, groupIdx);
+	}
+
+	// Allocate the instance
+	U32 instanceIdx;
+	if(m_freeInstances.getSize())
+	{
+		instanceIdx = m_freeInstances.getBack();
+		m_freeInstances.popBack(m_alloc);
+	}
+	else
+	{
+		instanceIdx = m_instances.getSize();
+		m_instances.emplaceBack(m_alloc);
+		m_instanceDirty.emplaceBack(m_alloc, false);
+	}
+
+	GpuSceneInstance& instance = m_instances[instanceIdx];
+	zeroMemory(instance);
+	instance.m_drawBucket = groupIdx * MAX_LOD_COUNT;
+	instance.m_lodCount = 1;
+	markDirty(instanceIdx);
+
+	return instanceIdx;
+}
+
+void GpuSceneInstances::deleteInstance(U32 instanceIdx)
+{
+	LockGuard<Mutex> lock(m_mtx);
+
+	GpuSceneInstance& instance = m_instances[instanceIdx];
+	ANKI_ASSERT(instance.m_drawBucket != GPU_SCENE_INVALID_DRAW_BUCKET);
+
+	// Invalidate it because the GPU will still see it
+	instance.m_drawBucket = GPU_SCENE_INVALID_DRAW_BUCKET;
+	markDirty(instanceIdx);
+
+	m_freeInstances.emplaceBack(m_alloc, instanceIdx);
+}
+
+void GpuSceneInstances::updateInstance(U32 instanceIdx, const GpuSceneInstance& data)
+{
+	LockGuard<Mutex> lock(m_mtx);
+
+	GpuSceneInstance& instance = m_instances[instanceIdx];
+	ANKI_ASSERT(instance.m_drawBucket != GPU_SCENE_INVALID_DRAW_BUCKET);
+	ANKI_ASSERT(data.m_lodCount > 0 && data.m_lodCount <= MAX_LOD_COUNT);
+
+	const U32 drawBucket = instance.m_drawBucket;
+	instance = data;
+	instance.m_drawBucket = drawBucket;
+	markDirty(instanceIdx);
+}
+
+void GpuSceneInstances::markDirty(U32 instanceIdx)
+{
+	if(!m_instanceDirty[instanceIdx])
+	{
+		m_instanceDirty[instanceIdx] = true;
+
+		if(m_dirtyInstanceCount == m_dirtyInstances.getSize())
+		{
+			m_dirtyInstances.emplaceBack(m_alloc, instanceIdx);
+		}
+		else
+		{
+			m_dirtyInstances[m_dirtyInstanceCount] = instanceIdx;
+		}
+
+		++m_dirtyInstanceCount;
+	}
+}
+
+void GpuSceneInstances::flush(SceneFrameAllocator<U8> frameAlloc, GpuSceneQueueElement& el)
+{
+	ANKI_TRACE_INC_COUNTER(SCENE_GPU_SCENE_DIRTY_INSTANCES, m_dirtyInstanceCount);
+
+	el.m_instances = ConstWeakArray<GpuSceneInstance>(m_instances);
+
+	if(m_dirtyInstanceCount)
+	{
+		U32* dirty = frameAlloc.newArray<U32>(m_dirtyInstanceCount);
+		memcpy(dirty, &m_dirtyInstances[0], m_dirtyInstanceCount * sizeof(U32));
+		el.m_dirtyInstances = ConstWeakArray<U32>(dirty, m_dirtyInstanceCount);
+
+		for(U32 i = 0; i < m_dirtyInstanceCount; ++i)
+		{
+			m_instanceDirty[m_dirtyInstances[i]] = false;
+		}
+		m_dirtyInstanceCount = 0;
+	}
+	else
+	{
+		el.m_dirtyInstances = ConstWeakArray<U32>();
+	}
+}
+
+} // end namespace anki
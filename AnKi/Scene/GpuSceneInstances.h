@@ -0,0 +1,84 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/Thread.h>
+#include <AnKi/Shaders/Include/GpuSceneTypes.h>
+
+namespace anki {
+
+// Forward
+class GpuSceneQueueElement;
+
+/// @addtogroup scene
+/// @{
+
+/// The CPU side of the persistent GPU scene. It holds a copy of every renderable instance and it tracks the instances
+/// that changed since the last frame so the renderer can upload only those.
+class GpuSceneInstances
+{
+public:
+	GpuSceneInstances(SceneAllocator<U8> alloc)
+		: m_alloc(alloc)
+	{
+	}
+
+	GpuSceneInstances(const GpuSceneInstances&) = delete; // Non-copyable
+
+	~GpuSceneInstances();
+
+	GpuSceneInstances& operator=(const GpuSceneInstances&) = delete; // Non-copyable
+
+	/// Allocate a new instance.
+	/// @param drawBucketKey Instances with the same key share the same program and geometry.
+	/// @return The index of the new instance.
+	/// @note It's thread-safe.
+	U32 newInstance(U64 drawBucketKey);
+
+	/// Free an instance.
+	/// @note It's thread-safe.
+	void deleteInstance(U32 instanceIdx);
+
+	/// Update an instance. The GpuSceneInstance::m_drawBucket of the data is ignored.
+	/// @note It's thread-safe.
+	void updateInstance(U32 instanceIdx, const GpuSceneInstance& data);
+
+	/// Hand the changes of this frame to the renderer and start tracking from scratch.
+	/// @note It's not thread-safe.
+	void flush(SceneFrameAllocator<U8> frameAlloc, GpuSceneQueueElement& el);
+
+	U32 getInstanceCount() const
+	{
+		return m_instances.getSize();
+	}
+
+	U32 getDirtyInstanceCount() const
+	{
+		return m_dirtyInstanceCount;
+	}
+
+private:
+	SceneAllocator<U8> m_alloc;
+
+	DynamicArray<GpuSceneInstance> m_instances;
+	DynamicArray<Bool> m_instanceDirty;
+	DynamicArray<U32> m_freeInstances;
+	DynamicArray<U32> m_dirtyInstances; ///< It only grows to avoid re-allocations every frame.
+	U32 m_dirtyInstanceCount = 0;
+
+	HashMap<U64, U32> m_drawBucketGroupIndices; ///< Draw bucket key to draw bucket group index.
+	U32 m_drawBucketGroupCount = 0;
+
+	Mutex m_mtx;
+
+	void markDirty(U32 instanceIdx);
+};
+/// @}
+
+} // end namespace anki
@@ -39,7 +39,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(LightNode::OnMovedFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(LightNode::OnMovedFeedbackComponent, "MoveComponent", "LightComponent")
 
 /// Feedback component.
 class LightNode::OnLightShapeUpdatedFeedbackComponent : public SceneComponent
@@ -67,7 +67,9 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(LightNode::OnLightShapeUpdatedFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(LightNode::OnLightShapeUpdatedFeedbackComponent,
+									 "LightComponent LensFlareComponent",
+									 "FrustumComponent SpatialComponent")
 
 LightNode::LightNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
@@ -113,6 +115,9 @@ void LightNode::onMoveUpdateCommon(const MoveComponent& move)
 PointLightNode::PointLightNode(SceneGraph* scene, CString name)
 	: LightNode(scene, name)
 {
+	// It has to check the shadow properties every frame
+	setNeedsFrameUpdate(true);
+
 	newComponent<MoveComponent>();
 	newComponent<OnMovedFeedbackComponent>();
 
@@ -224,11 +229,15 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(SpotLightNode::OnFrustumUpdatedFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(SpotLightNode::OnFrustumUpdatedFeedbackComponent, "FrustumComponent",
+									 "SpatialComponent")
 
 SpotLightNode::SpotLightNode(SceneGraph* scene, CString name)
 	: LightNode(scene, name)
 {
+	// It has to check the shadow properties every frame
+	setNeedsFrameUpdate(true);
+
 	newComponent<MoveComponent>();
 	newComponent<OnMovedFeedbackComponent>();
 
@@ -304,7 +313,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(DirectionalLightNode::FeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(DirectionalLightNode::FeedbackComponent, "MoveComponent", "LightComponent")
 
 DirectionalLightNode::DirectionalLightNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
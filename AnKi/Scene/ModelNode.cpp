@@ -6,6 +6,7 @@
 #include <AnKi/Scene/ModelNode.h>
 #include <AnKi/Scene/SceneGraph.h>
 #include <AnKi/Scene/DebugDrawer.h>
+#include <AnKi/Scene/GpuSceneInstances.h>
 #include <AnKi/Scene/Components/MoveComponent.h>
 #include <AnKi/Scene/Components/SkinComponent.h>
 #include <AnKi/Scene/Components/SpatialComponent.h>
@@ -15,6 +16,7 @@
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Resource/SkeletonResource.h>
 #include <AnKi/Physics/PhysicsWorld.h>
+#include <AnKi/Util/Tracer.h>
 
 namespace anki {
 
@@ -37,12 +39,14 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(ModelNode::FeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(ModelNode::FeedbackComponent, "MoveComponent SkinComponent",
+									 "SpatialComponent RenderComponent")
 
 class ModelNode::RenderProxy
 {
 public:
 	ModelNode* m_node = nullptr;
+	U32 m_gpuSceneInstanceIdx = MAX_U32;
 };
 
 ModelNode::ModelNode(SceneGraph* scene, CString name)
@@ -59,6 +63,16 @@ ModelNode::ModelNode(SceneGraph* scene, CString name)
 
 ModelNode::~ModelNode()
 {
+	GpuSceneInstances* gpuScene = getSceneGraph().getGpuSceneInstances();
+	for(RenderProxy& proxy : m_renderProxies)
+	{
+		if(proxy.m_gpuSceneInstanceIdx != MAX_U32)
+		{
+			ANKI_ASSERT(gpuScene);
+			gpuScene->deleteInstance(proxy.m_gpuSceneInstanceIdx);
+		}
+	}
+
 	m_renderProxies.destroy(getAllocator());
 }
 
@@ -116,6 +130,13 @@ void ModelNode::feedbackUpdate()
 		const Aabb aabbWorld = m_aabbLocal.getTransformed(movec.getWorldTransform());
 		getFirstComponentOfType<SpatialComponent>().setAabbWorldSpace(aabbWorld);
 	}
+
+	// GPU scene update
+	if(getSceneGraph().getGpuSceneInstances() && (updateSpatial || m_gpuScenePrevTransformStale))
+	{
+		m_gpuScenePrevTransformStale = movec.getTimestamp() == globTimestamp;
+		updateGpuSceneInstances();
+	}
 }
 
 Error ModelNode::frameUpdate(Second prevUpdateTime, Second crntTime)
@@ -151,6 +172,10 @@ Error ModelNode::frameUpdate(Second prevUpdateTime, Second crntTime)
 
 	// Now you can init the render components
 	initRenderComponents();
+	if(getSceneGraph().getGpuSceneInstances())
+	{
+		updateGpuSceneInstances();
+	}
 
 	return Error::NONE;
 }
@@ -188,6 +213,52 @@ void ModelNode::initRenderComponents()
 		}
 
 		m_renderProxies[patchIdx].m_node = this;
+
+		// Re-allocate the GPU scene instance since the draw bucket might have changed
+		GpuSceneInstances* gpuScene = getSceneGraph().getGpuSceneInstances();
+		if(gpuScene)
+		{
+			if(m_renderProxies[patchIdx].m_gpuSceneInstanceIdx != MAX_U32)
+			{
+				gpuScene->deleteInstance(m_renderProxies[patchIdx].m_gpuSceneInstanceIdx);
+			}
+			m_renderProxies[patchIdx].m_gpuSceneInstanceIdx =
+				gpuScene->newInstance(modelc.getRenderMergeKeys()[patchIdx]);
+		}
+	}
+}
+
+void ModelNode::updateGpuSceneInstances()
+{
+	const ModelComponent& modelc = getFirstComponentOfType<ModelComponent>();
+	const MoveComponent& movec = getFirstComponentOfType<MoveComponent>();
+	const Aabb& aabbWorld = getFirstComponentOfType<SpatialComponent>().getAabbWorldSpace();
+
+	GpuSceneInstance instance;
+	zeroMemory(instance);
+	instance.m_worldTransform = Mat3x4(movec.getWorldTransform());
+	instance.m_previousWorldTransform = Mat3x4(movec.getPreviousWorldTransform());
+	instance.m_aabbMin = aabbWorld.getMin().xyz();
+	instance.m_aabbMax = aabbWorld.getMax().xyz();
+
+	GpuSceneInstances& gpuScene = *getSceneGraph().getGpuSceneInstances();
+	for(U32 patchIdx = 0; patchIdx < m_renderProxies.getSize(); ++patchIdx)
+	{
+		const RenderProxy& proxy = m_renderProxies[patchIdx];
+		if(proxy.m_gpuSceneInstanceIdx == MAX_U32)
+		{
+			// Not initialized yet
+			continue;
+		}
+
+		const ModelPatch& patch = modelc.getModelResource()->getModelPatches()[patchIdx];
+		instance.m_lodCount = patch.getLodCount();
+		for(U32 lod = 0; lod < instance.m_lodCount; ++lod)
+		{
+			patch.getIndexRange(lod, instance.m_firstIndices[lod], instance.m_indexCounts[lod]);
+		}
+
+		gpuScene.updateInstance(proxy.m_gpuSceneInstanceIdx, instance);
 	}
 }
 
@@ -263,27 +334,40 @@ void ModelNode::draw(RenderQueueDrawContext& ctx, ConstWeakArray<void*> userData
 		RenderComponent::allocateAndSetupUniforms(
 			modelc.getModelResource()->getModelPatches()[modelPatchIdx].getMaterial(), ctx,
 			ConstWeakArray<Mat4>(&trfs[0], instanceCount), ConstWeakArray<Mat4>(&prevTrfs[0], instanceCount),
-			*ctx.m_stagingGpuAllocator);
+			*ctx.m_stagingGpuAllocator, modelInf.m_positionDequantization);
 
-		// Set attributes
-		for(U i = 0; i < modelInf.m_vertexAttributeCount; ++i)
+		// The same merge key means the same model patch. If the previous drawcall used the same LOD and skinning the
+		// geometry is already bound
+		const Bool geometryBound = ctx.m_previousKeyValid && ctx.m_previousKey.getLod() == ctx.m_key.getLod()
+								   && ctx.m_previousKey.isSkinned() == ctx.m_key.isSkinned();
+
+		if(!geometryBound)
 		{
-			const ModelVertexAttribute& attrib = modelInf.m_vertexAttributes[i];
-			ANKI_ASSERT(attrib.m_format != Format::NONE);
-			cmdb->setVertexAttribute(U32(attrib.m_location), attrib.m_bufferBinding, attrib.m_format,
-									 attrib.m_relativeOffset);
-		}
+			// Set attributes
+			for(U i = 0; i < modelInf.m_vertexAttributeCount; ++i)
+			{
+				const ModelVertexAttribute& attrib = modelInf.m_vertexAttributes[i];
+				ANKI_ASSERT(attrib.m_format != Format::NONE);
+				cmdb->setVertexAttribute(U32(attrib.m_location), attrib.m_bufferBinding, attrib.m_format,
+										 attrib.m_relativeOffset);
+			}
+
+			// Set vertex buffers
+			for(U32 i = 0; i < modelInf.m_vertexBufferBindingCount; ++i)
+			{
+				const ModelVertexBufferBinding& binding = modelInf.m_vertexBufferBindings[i];
+				cmdb->bindVertexBuffer(i, binding.m_buffer, binding.m_offset, binding.m_stride,
+									   VertexStepRate::VERTEX);
+			}
 
-		// Set vertex buffers
-		for(U32 i = 0; i < modelInf.m_vertexBufferBindingCount; ++i)
+			// Index buffer
+			cmdb->bindIndexBuffer(modelInf.m_indexBuffer, modelInf.m_indexBufferOffset, IndexType::U16);
+		}
+		else
 		{
-			const ModelVertexBufferBinding& binding = modelInf.m_vertexBufferBindings[i];
-			cmdb->bindVertexBuffer(i, binding.m_buffer, binding.m_offset, binding.m_stride, VertexStepRate::VERTEX);
+			ANKI_TRACE_INC_COUNTER(SCENE_SKIPPED_GEOMETRY_BINDS, 1);
 		}
 
-		// Index buffer
-		cmdb->bindIndexBuffer(modelInf.m_indexBuffer, modelInf.m_indexBufferOffset, IndexType::U16);
-
 		// Draw
 		cmdb->drawElements(PrimitiveTopology::TRIANGLES, modelInf.m_indexCount, instanceCount, modelInf.m_firstIndex, 0,
 						   0);
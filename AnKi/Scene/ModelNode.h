@@ -36,6 +36,7 @@ private:
 	DynamicArray<RenderProxy> m_renderProxies; ///< The size matches the number of render components.
 
 	Bool m_deferredRenderComponentUpdate = false;
+	Bool m_gpuScenePrevTransformStale = false; ///< The previous transform in the GPU scene needs one more update.
 
 	void feedbackUpdate();
 
@@ -44,6 +45,8 @@ private:
 	void setupRayTracingInstanceQueueElement(U32 lod, U32 modelPatchIdx, RayTracingInstanceQueueElement& el) const;
 
 	void initRenderComponents();
+
+	void updateGpuSceneInstances();
 };
 /// @}
 
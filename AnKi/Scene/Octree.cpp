@@ -59,6 +59,7 @@ Octree::~Octree()
 	ANKI_ASSERT(m_placeableCount == 0);
 	cleanupInternal();
 	ANKI_ASSERT(m_rootLeaf == nullptr);
+	m_visitedPlaceables.destroy(m_alloc);
 }
 
 void Octree::init(const Vec3& sceneAabbMin, const Vec3& sceneAabbMax, U32 maxDepth)
@@ -92,6 +93,7 @@ void Octree::place(const Aabb& volume, OctreePlaceable* placeable, Bool updateAc
 	// And re-place it
 	placeRecursive(volume, placeable, m_rootLeaf, 0);
 	++m_placeableCount;
+	growVisitedPlaceables();
 
 	// Update the actual scene bounds
 	if(updateActualSceneBounds)
@@ -123,6 +125,7 @@ void Octree::placeAlwaysVisible(OctreePlaceable* placeable)
 	m_rootLeaf->m_placeables.pushBack(newPlaceableNode(placeable));
 
 	++m_placeableCount;
+	growVisitedPlaceables();
 }
 
 void Octree::remove(OctreePlaceable& placeable)
@@ -312,6 +315,8 @@ void Octree::computeChildAabb(LeafMask child, const Vec3& parentAabbMin, const V
 
 void Octree::removeInternal(OctreePlaceable& placeable)
 {
+	ANKI_ASSERT(placeable.m_visitedMask.load() == 0 && "Removing a placeable before resetVisitedPlaceables()");
+
 	const Bool isPlaced = !placeable.m_leafs.isEmpty();
 	if(isPlaced)
 	{
@@ -359,7 +364,7 @@ void Octree::gatherVisibleRecursive(const Plane frustumPlanes[6], U32 testId,
 	// Add the placeables that belong to that leaf
 	for(PlaceableNode& placeableNode : leaf->m_placeables)
 	{
-		if(!placeableNode.m_placeable->alreadyVisited(testId))
+		if(!alreadyVisited(*placeableNode.m_placeable, testId))
 		{
 			ANKI_ASSERT(placeableNode.m_placeable->m_userData);
 			out.emplaceBack(placeableNode.m_placeable->m_userData);
@@ -425,6 +430,43 @@ void Octree::cleanupRecursive(Leaf* leaf, Bool& canDeleteLeafUponReturn)
 	}
 }
 
+Bool Octree::alreadyVisited(OctreePlaceable& placeable, U32 testId)
+{
+	ANKI_ASSERT(testId < 64);
+	const U64 testMask = U64(1u) << U64(testId);
+	const U64 prev = placeable.m_visitedMask.fetchOr(testMask);
+
+	if(prev == 0)
+	{
+		// First visit since the last reset, remember it
+		const U32 idx = m_visitedPlaceableCount.fetchAdd(1);
+		ANKI_ASSERT(idx < m_visitedPlaceables.getSize());
+		m_visitedPlaceables[idx] = &placeable;
+	}
+
+	return !!(testMask & prev);
+}
+
+void Octree::resetVisitedPlaceables()
+{
+	const U32 count = m_visitedPlaceableCount.load();
+	for(U32 i = 0; i < count; ++i)
+	{
+		m_visitedPlaceables[i]->reset();
+	}
+
+	m_visitedPlaceableCount.setNonAtomically(0);
+}
+
+void Octree::growVisitedPlaceables()
+{
+	ANKI_ASSERT(m_visitedPlaceableCount.load() == 0 && "Can't place while visibility tests are running");
+	if(m_visitedPlaceables.getSize() < m_placeableCount)
+	{
+		m_visitedPlaceables.resize(m_alloc, max<U32>(64, m_placeableCount * 2));
+	}
+}
+
 void Octree::cleanupInternal()
 {
 	if(m_rootLeaf)
@@ -520,7 +562,7 @@ void Octree::gatherVisibleParallelTask(U32 threadId, ThreadHive& hive, ThreadHiv
 
 		for(PlaceableNode& placeableNode : leaf->m_placeables)
 		{
-			if(!placeableNode.m_placeable->alreadyVisited(testId))
+			if(!alreadyVisited(*placeableNode.m_placeable, testId))
 			{
 				ANKI_ASSERT(placeableNode.m_placeable->m_userData);
 				out.emplaceBack(placeableNode.m_placeable->m_userData);
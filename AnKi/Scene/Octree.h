@@ -98,6 +98,11 @@ public:
 		walkTreeInternal(*m_rootLeaf, testId, testFunc, newPlaceableFunc);
 	}
 
+	/// Reset the visited state of all the placeables that were visited since the last call. Call it when all the
+	/// visibility tests of the frame are done. It only touches the visited placeables so the rest don't need to be
+	/// reset every frame.
+	void resetVisitedPlaceables();
+
 	/// Debug draw.
 	void debugDraw(OctreeDebugDrawer& drawer) const
 	{
@@ -210,6 +215,11 @@ private:
 	Leaf* m_rootLeaf = nullptr;
 	U32 m_placeableCount = 0;
 
+	/// The placeables that got visited by some test since the last resetVisitedPlaceables(). A placeable goes there
+	/// once so it's never bigger than m_placeableCount.
+	DynamicArray<OctreePlaceable*> m_visitedPlaceables;
+	Atomic<U32> m_visitedPlaceableCount = {0};
+
 	/// Compute the min of the scene bounds based on what is placed inside the octree.
 	Vec3 m_actualSceneAabbMin = Vec3(MAX_F32);
 	Vec3 m_actualSceneAabbMax = Vec3(MIN_F32);
@@ -260,9 +270,15 @@ private:
 	/// Remove a placeable from the tree.
 	void removeInternal(OctreePlaceable& placeable);
 
-	static void gatherVisibleRecursive(const Plane frustumPlanes[6], U32 testId,
-									   OctreeNodeVisibilityTestCallback testCallback, void* testCallbackUserData,
-									   Leaf* leaf, DynamicArrayAuto<void*>& out);
+	void gatherVisibleRecursive(const Plane frustumPlanes[6], U32 testId, OctreeNodeVisibilityTestCallback testCallback,
+								void* testCallbackUserData, Leaf* leaf, DynamicArrayAuto<void*>& out);
+
+	/// Check if a placeable was already visited by a test and mark it as visited.
+	/// @note It's thread-safe.
+	Bool alreadyVisited(OctreePlaceable& placeable, U32 testId);
+
+	/// Make sure m_visitedPlaceables can hold all the placeables.
+	void growVisitedPlaceables();
 
 	/// ThreadHive callback.
 	static void gatherVisibleTaskCallback(void* ud, U32 threadId, ThreadHive& hive, ThreadHiveSemaphore* sem);
@@ -305,16 +321,6 @@ public:
 private:
 	Atomic<U64> m_visitedMask = {0u};
 	IntrusiveList<Octree::LeafNode> m_leafs; ///< A list of leafs this placeable belongs.
-
-	/// Check if already visited.
-	/// @note It's thread-safe.
-	Bool alreadyVisited(U32 testId)
-	{
-		ANKI_ASSERT(testId < 64);
-		const U64 testMask = U64(1u) << U64(testId);
-		const U64 prev = m_visitedMask.fetchOr(testMask);
-		return !!(testMask & prev);
-	}
 };
 
 template<typename TTestAabbFunc, typename TNewPlaceableFunc>
@@ -323,7 +329,7 @@ inline void Octree::walkTreeInternal(Leaf& leaf, U32 testId, TTestAabbFunc testF
 	// Visit the placeables that belong to that leaf
 	for(PlaceableNode& placeableNode : leaf.m_placeables)
 	{
-		if(!placeableNode.m_placeable->alreadyVisited(testId))
+		if(!alreadyVisited(*placeableNode.m_placeable, testId))
 		{
 			ANKI_ASSERT(placeableNode.m_placeable->m_userData);
 			newPlaceableFunc(placeableNode.m_placeable->m_userData);
@@ -36,7 +36,8 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(ParticleEmitterNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(ParticleEmitterNode::MoveFeedbackComponent, "MoveComponent",
+									 "ParticleEmitterComponent")
 
 /// Feedback component
 class ParticleEmitterNode::ShapeFeedbackComponent : public SceneComponent
@@ -58,11 +59,15 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(ParticleEmitterNode::ShapeFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(ParticleEmitterNode::ShapeFeedbackComponent, "ParticleEmitterComponent",
+									 "SpatialComponent")
 
 ParticleEmitterNode::ParticleEmitterNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
 {
+	// It has to check the properties of its components every frame
+	setNeedsFrameUpdate(true);
+
 	// Components
 	newComponent<MoveComponent>();
 
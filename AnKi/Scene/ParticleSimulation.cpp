@@ -0,0 +1,366 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/ParticleSimulation.h>
+#include <AnKi/Resource/ParticleEmitterResource.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+
+class ParticleSimulation::SimulateCtx
+{
+public:
+	ParticleSimulation* m_simulation = nullptr;
+	F32* m_verts = nullptr;
+	F32 m_dt = 0.0f;
+	U32 m_blockCount = 0;
+	Atomic<U32> m_crntBlock = {0};
+	Atomic<U32> m_doneBlockCount = {0};
+};
+
+static Vec3 getRandom(const Vec3& min, const Vec3& max)
+{
+	Vec3 out;
+	out.x() = mix(min.x(), max.x(), getRandomRange(0.0f, 1.0f));
+	out.y() = mix(min.y(), max.y(), getRandomRange(0.0f, 1.0f));
+	out.z() = mix(min.z(), max.z(), getRandomRange(0.0f, 1.0f));
+	return out;
+}
+
+ParticleSimulation::~ParticleSimulation()
+{
+	if(m_memory)
+	{
+		m_alloc.getMemoryPool().free(m_memory);
+	}
+
+	m_blocks.destroy(m_alloc);
+}
+
+void ParticleSimulation::init(SceneAllocator<U8> alloc, U32 maxParticleCount)
+{
+	if(m_memory)
+	{
+		m_alloc.getMemoryPool().free(m_memory);
+		m_memory = nullptr;
+	}
+	m_blocks.destroy(m_alloc);
+
+	m_alloc = alloc;
+	m_maxParticleCount = maxParticleCount;
+	m_aliveParticleCount = 0;
+
+	if(maxParticleCount == 0)
+	{
+		return;
+	}
+
+	// Keep all streams aligned for the SIMD loads
+	const U32 streamSize = getAlignedRoundUp(4u, maxParticleCount);
+	m_memory = static_cast<F32*>(
+		m_alloc.getMemoryPool().allocate(PtrSize(streamSize) * U32(Stream::COUNT) * sizeof(F32), 16));
+	for(U32 i = 0; i < U32(Stream::COUNT); ++i)
+	{
+		m_streams[i] = m_memory + PtrSize(streamSize) * i;
+	}
+
+	m_blocks.create(m_alloc, (maxParticleCount + PARTICLES_PER_BLOCK - 1) / PARTICLES_PER_BLOCK);
+}
+
+void ParticleSimulation::emit(const ParticleEmitterProperties& props, const Transform& emitterTrf, U32 count)
+{
+	count = min(count, m_maxParticleCount - m_aliveParticleCount);
+
+	for(U32 i = m_aliveParticleCount; i < m_aliveParticleCount + count; ++i)
+	{
+		const F32 life = max(F32(getRandomRange(props.m_particle.m_minLife, props.m_particle.m_maxLife)), EPSILON);
+		getStream(Stream::AGE)[i] = 0.0f;
+		getStream(Stream::INV_LIFE)[i] = 1.0f / life;
+
+		const F32 initialSize = getRandomRange(props.m_particle.m_minInitialSize, props.m_particle.m_maxInitialSize);
+		const F32 finalSize = getRandomRange(props.m_particle.m_minFinalSize, props.m_particle.m_maxFinalSize);
+		getStream(Stream::INITIAL_SIZE)[i] = initialSize;
+		getStream(Stream::SIZE_DELTA)[i] = finalSize - initialSize;
+
+		const F32 initialAlpha =
+			getRandomRange(props.m_particle.m_minInitialAlpha, props.m_particle.m_maxInitialAlpha);
+		const F32 finalAlpha = getRandomRange(props.m_particle.m_minFinalAlpha, props.m_particle.m_maxFinalAlpha);
+		getStream(Stream::INITIAL_ALPHA)[i] = initialAlpha;
+		getStream(Stream::ALPHA_DELTA)[i] = finalAlpha - initialAlpha;
+
+		const Vec3 acceleration = getRandom(props.m_particle.m_minGravity, props.m_particle.m_maxGravity);
+		const Vec3 position =
+			getRandom(props.m_particle.m_minStartingPosition, props.m_particle.m_maxStartingPosition)
+			+ emitterTrf.getOrigin().xyz();
+		for(U32 c = 0; c < 3; ++c)
+		{
+			getStream(Stream(U32(Stream::POSITION_X) + c))[i] = position[c];
+			getStream(Stream(U32(Stream::VELOCITY_X) + c))[i] = 0.0f;
+			getStream(Stream(U32(Stream::ACCELERATION_X) + c))[i] = acceleration[c];
+		}
+	}
+
+	m_aliveParticleCount += count;
+}
+
+void ParticleSimulation::simulate(F32 dt, F32* verts, Vec3& aabbMin, Vec3& aabbMax, F32& maxParticleSize,
+								  ThreadHive* hive)
+{
+	ANKI_ASSERT(verts);
+	ANKI_TRACE_SCOPED_EVENT(SCENE_PARTICLES_SIMULATE);
+
+	aabbMin = Vec3(MAX_F32);
+	aabbMax = Vec3(MIN_F32);
+	maxParticleSize = MIN_F32;
+
+	const U32 blockCount = (m_aliveParticleCount + PARTICLES_PER_BLOCK - 1) / PARTICLES_PER_BLOCK;
+	if(blockCount == 0)
+	{
+		return;
+	}
+
+	ANKI_TRACE_INC_COUNTER(SCENE_PARTICLES_SIMULATED, m_aliveParticleCount);
+
+	const U32 helperCount = (hive) ? min(hive->getThreadCount(), blockCount - 1) : 0;
+	if(helperCount == 0)
+	{
+		for(U32 i = 0; i < blockCount; ++i)
+		{
+			simulateBlock(i, dt, verts);
+		}
+	}
+	else
+	{
+		// The context lives in the scratch memory of the hive because the helper tasks might start after this function
+		// returns. They will find no blocks to process but they'll still touch the context
+		SimulateCtx* ctx = ::new(hive->allocateScratchMemory(sizeof(SimulateCtx), alignof(SimulateCtx))) SimulateCtx();
+		ctx->m_simulation = this;
+		ctx->m_verts = verts;
+		ctx->m_dt = dt;
+		ctx->m_blockCount = blockCount;
+
+		Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+		for(U32 i = 0; i < helperCount; ++i)
+		{
+			tasks[i] = ANKI_THREAD_HIVE_TASK({ ParticleSimulation::runSimulateTasks(*self); }, ctx, nullptr, nullptr);
+		}
+		hive->submitTasks(&tasks[0], helperCount);
+
+		// Help and then wait for the blocks that the other threads took. Don't wait for the tasks since this might run
+		// in a ThreadHive task
+		runSimulateTasks(*ctx);
+		while(ctx->m_doneBlockCount.load(AtomicMemoryOrder::ACQUIRE) < blockCount)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	// Reduce the results of the blocks and remove the dead particles
+	Vec4 min4(MAX_F32);
+	Vec4 max4(MIN_F32);
+	for(U32 i = 0; i < blockCount; ++i)
+	{
+		const Block& block = m_blocks[i];
+		min4 = min4.min(block.m_aabbMin);
+		max4 = max4.max(block.m_aabbMax);
+		maxParticleSize = max(maxParticleSize, block.m_maxParticleSize);
+
+		if(block.m_deadParticleCount == 0)
+		{
+			continue;
+		}
+
+		const F32* ages = getStream(Stream::AGE);
+		const F32* invLifes = getStream(Stream::INV_LIFE);
+		U32 idx = i * PARTICLES_PER_BLOCK;
+		const U32 end = (i + 1) * PARTICLES_PER_BLOCK;
+		while(idx < min(end, m_aliveParticleCount))
+		{
+			if(ages[idx] * invLifes[idx] > 1.0f)
+			{
+				// Don't advance, a different particle is in idx now
+				killParticle(idx, verts);
+			}
+			else
+			{
+				++idx;
+			}
+		}
+	}
+
+	aabbMin = min4.xyz();
+	aabbMax = max4.xyz();
+}
+
+void ParticleSimulation::runSimulateTasks(SimulateCtx& ctx)
+{
+	U32 blockIdx;
+	while((blockIdx = ctx.m_crntBlock.fetchAdd(1)) < ctx.m_blockCount)
+	{
+		ctx.m_simulation->simulateBlock(blockIdx, ctx.m_dt, ctx.m_verts);
+		ctx.m_doneBlockCount.fetchAdd(1, AtomicMemoryOrder::RELEASE);
+	}
+}
+
+void ParticleSimulation::simulateBlock(U32 blockIdx, F32 dt, F32* verts)
+{
+	const U32 begin = blockIdx * PARTICLES_PER_BLOCK;
+	const U32 end = min(m_aliveParticleCount, begin + PARTICLES_PER_BLOCK);
+	ANKI_ASSERT(begin < end);
+
+	Array<F32*, 3> positions = {getStream(Stream::POSITION_X), getStream(Stream::POSITION_Y),
+								getStream(Stream::POSITION_Z)};
+	Array<F32*, 3> velocities = {getStream(Stream::VELOCITY_X), getStream(Stream::VELOCITY_Y),
+								 getStream(Stream::VELOCITY_Z)};
+	Array<const F32*, 3> accelerations = {getStream(Stream::ACCELERATION_X), getStream(Stream::ACCELERATION_Y),
+										  getStream(Stream::ACCELERATION_Z)};
+	F32* ages = getStream(Stream::AGE);
+	const F32* invLifes = getStream(Stream::INV_LIFE);
+	const F32* initialSizes = getStream(Stream::INITIAL_SIZE);
+	const F32* sizeDeltas = getStream(Stream::SIZE_DELTA);
+	const F32* initialAlphas = getStream(Stream::INITIAL_ALPHA);
+	const F32* alphaDeltas = getStream(Stream::ALPHA_DELTA);
+
+	const F32 dt2 = dt * dt;
+	Vec3 aabbMin(MAX_F32);
+	Vec3 aabbMax(MIN_F32);
+	F32 maxParticleSize = MIN_F32;
+	U32 deadParticleCount = 0;
+	U32 idx = begin;
+
+#if ANKI_SIMD_SSE
+	{
+		const __m128 dt4 = _mm_set1_ps(dt);
+		const __m128 dt24 = _mm_set1_ps(dt2);
+		const __m128 zero4 = _mm_setzero_ps();
+		const __m128 one4 = _mm_set1_ps(1.0f);
+		const __m128 maxF4 = _mm_set1_ps(MAX_F32);
+		const __m128 minF4 = _mm_set1_ps(MIN_F32);
+		Array<__m128, 3> aabbMin4 = {maxF4, maxF4, maxF4};
+		Array<__m128, 3> aabbMax4 = {minF4, minF4, minF4};
+		__m128 maxSize4 = minF4;
+
+		// The streams are aligned and the begin of the block is a multiple of 4 so it's safe to use aligned loads
+		const U32 end4 = begin + ((end - begin) & ~3u);
+		for(; idx < end4; idx += 4)
+		{
+			const __m128 age = _mm_add_ps(_mm_load_ps(ages + idx), dt4);
+			_mm_store_ps(ages + idx, age);
+
+			const __m128 lifeFactor = _mm_mul_ps(age, _mm_load_ps(invLifes + idx));
+			const __m128 alive = _mm_cmple_ps(lifeFactor, one4);
+			deadParticleCount += 4 - U32(__builtin_popcount(_mm_movemask_ps(alive)));
+
+			alignas(16) Array<F32, 4 * VERTEX_FLOAT_COUNT> vertComponents;
+			for(U32 c = 0; c < 3; ++c)
+			{
+				const __m128 a = _mm_load_ps(accelerations[c] + idx);
+				const __m128 v = _mm_load_ps(velocities[c] + idx);
+				__m128 p = _mm_load_ps(positions[c] + idx);
+
+				p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, dt24), _mm_mul_ps(v, dt4)), p);
+				_mm_store_ps(positions[c] + idx, p);
+				_mm_store_ps(velocities[c] + idx, _mm_add_ps(v, _mm_mul_ps(a, dt4)));
+				_mm_store_ps(&vertComponents[c * 4], p);
+
+				// Only the alive contribute to the AABB
+				aabbMin4[c] = _mm_min_ps(aabbMin4[c], _mm_or_ps(_mm_and_ps(alive, p), _mm_andnot_ps(alive, maxF4)));
+				aabbMax4[c] = _mm_max_ps(aabbMax4[c], _mm_or_ps(_mm_and_ps(alive, p), _mm_andnot_ps(alive, minF4)));
+			}
+
+			const __m128 size =
+				_mm_add_ps(_mm_load_ps(initialSizes + idx), _mm_mul_ps(_mm_load_ps(sizeDeltas + idx), lifeFactor));
+			const __m128 alpha =
+				_mm_add_ps(_mm_load_ps(initialAlphas + idx), _mm_mul_ps(_mm_load_ps(alphaDeltas + idx), lifeFactor));
+			_mm_store_ps(&vertComponents[3 * 4], size);
+			_mm_store_ps(&vertComponents[4 * 4], _mm_min_ps(_mm_max_ps(alpha, zero4), one4));
+			maxSize4 = _mm_max_ps(maxSize4, _mm_or_ps(_mm_and_ps(alive, size), _mm_andnot_ps(alive, minF4)));
+
+			// Transpose to the vertex layout
+			for(U32 i = 0; i < 4; ++i)
+			{
+				F32* vert = verts + PtrSize(idx + i) * VERTEX_FLOAT_COUNT;
+				for(U32 c = 0; c < VERTEX_FLOAT_COUNT; ++c)
+				{
+					vert[c] = vertComponents[c * 4 + i];
+				}
+			}
+		}
+
+		alignas(16) Array<F32, 4> lanes;
+		for(U32 c = 0; c < 3; ++c)
+		{
+			_mm_store_ps(&lanes[0], aabbMin4[c]);
+			aabbMin[c] = min(min(lanes[0], lanes[1]), min(lanes[2], lanes[3]));
+			_mm_store_ps(&lanes[0], aabbMax4[c]);
+			aabbMax[c] = max(max(lanes[0], lanes[1]), max(lanes[2], lanes[3]));
+		}
+		_mm_store_ps(&lanes[0], maxSize4);
+		maxParticleSize = max(max(lanes[0], lanes[1]), max(lanes[2], lanes[3]));
+	}
+#endif
+
+	// The rest or everything if there is no SIMD
+	for(; idx < end; ++idx)
+	{
+		ages[idx] += dt;
+		const F32 lifeFactor = ages[idx] * invLifes[idx];
+		const Bool alive = lifeFactor <= 1.0f;
+		deadParticleCount += !alive;
+
+		F32* vert = verts + PtrSize(idx) * VERTEX_FLOAT_COUNT;
+		for(U32 c = 0; c < 3; ++c)
+		{
+			const F32 a = accelerations[c][idx];
+			const F32 v = velocities[c][idx];
+			const F32 p = a * dt2 + v * dt + positions[c][idx];
+			positions[c][idx] = p;
+			velocities[c][idx] = v + a * dt;
+			vert[c] = p;
+
+			if(alive)
+			{
+				aabbMin[c] = min(aabbMin[c], p);
+				aabbMax[c] = max(aabbMax[c], p);
+			}
+		}
+
+		const F32 size = initialSizes[idx] + sizeDeltas[idx] * lifeFactor;
+		vert[3] = size;
+		vert[4] = clamp(initialAlphas[idx] + alphaDeltas[idx] * lifeFactor, 0.0f, 1.0f);
+
+		if(alive)
+		{
+			maxParticleSize = max(maxParticleSize, size);
+		}
+	}
+
+	Block& block = m_blocks[blockIdx];
+	block.m_aabbMin = aabbMin.xyz0();
+	block.m_aabbMax = aabbMax.xyz0();
+	block.m_maxParticleSize = maxParticleSize;
+	block.m_deadParticleCount = deadParticleCount;
+}
+
+void ParticleSimulation::killParticle(U32 idx, F32* verts)
+{
+	ANKI_ASSERT(idx < m_aliveParticleCount);
+	const U32 lastIdx = --m_aliveParticleCount;
+	if(idx == lastIdx)
+	{
+		return;
+	}
+
+	for(F32* stream : m_streams)
+	{
+		stream[idx] = stream[lastIdx];
+	}
+
+	memcpy(verts + PtrSize(idx) * VERTEX_FLOAT_COUNT, verts + PtrSize(lastIdx) * VERTEX_FLOAT_COUNT,
+		   VERTEX_FLOAT_COUNT * sizeof(F32));
+}
+
+} // end namespace anki
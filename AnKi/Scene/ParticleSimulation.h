@@ -0,0 +1,126 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Math.h>
+#include <AnKi/Util/DynamicArray.h>
+
+namespace anki {
+
+// Forward
+class ThreadHive;
+class ParticleEmitterProperties;
+
+/// @addtogroup scene
+/// @{
+
+/// The CPU simulation of simple (non physics) particles. The particles are stored as structure of arrays and the alive
+/// particles are always packed at the front so the simulation is a few tight loops that are vectorized. Big
+/// simulations are split in blocks that the ThreadHive threads can steal.
+class ParticleSimulation
+{
+public:
+	/// The number of floats per particle written to the vertex buffer: position, size and alpha.
+	static constexpr U32 VERTEX_FLOAT_COUNT = 5;
+
+	/// The particles of a block are processed by a single thread.
+	static constexpr U32 PARTICLES_PER_BLOCK = 8 * 1024;
+
+	ParticleSimulation() = default;
+
+	ParticleSimulation(const ParticleSimulation&) = delete; // Non-copyable
+
+	~ParticleSimulation();
+
+	ParticleSimulation& operator=(const ParticleSimulation&) = delete; // Non-copyable
+
+	/// Allocate the storage. It can be called again to resize the storage, the particles will be killed.
+	void init(SceneAllocator<U8> alloc, U32 maxParticleCount);
+
+	/// Revive some dead particles.
+	/// @param emitterTrf The transform of the emitter. The starting position of the particles is relative to that.
+	void emit(const ParticleEmitterProperties& props, const Transform& emitterTrf, U32 count);
+
+	/// Age and integrate the alive particles, kill the ones that died and write the vertices of the rest.
+	/// @param dt The time since the last simulate().
+	/// @param[out] verts Where to write the vertices. It should have space for getMaxParticleCount() vertices. On
+	///                   return the first getAliveParticleCount() vertices are valid.
+	/// @param[out] aabbMin The min of the positions of the alive particles.
+	/// @param[out] aabbMax The max of the positions of the alive particles.
+	/// @param[out] maxParticleSize The size of the biggest alive particle.
+	/// @param hive If not nullptr big simulations will be split into tasks. It's safe to call it from a ThreadHive task
+	///             since it doesn't wait for the tasks. It uses the scratch memory of the hive so someone should call
+	///             ThreadHive::waitAllTasks() later on.
+	void simulate(F32 dt, F32* verts, Vec3& aabbMin, Vec3& aabbMax, F32& maxParticleSize, ThreadHive* hive);
+
+	U32 getAliveParticleCount() const
+	{
+		return m_aliveParticleCount;
+	}
+
+	U32 getMaxParticleCount() const
+	{
+		return m_maxParticleCount;
+	}
+
+private:
+	/// The particle properties. Each is an array.
+	enum class Stream : U8
+	{
+		POSITION_X,
+		POSITION_Y,
+		POSITION_Z,
+		VELOCITY_X,
+		VELOCITY_Y,
+		VELOCITY_Z,
+		ACCELERATION_X,
+		ACCELERATION_Y,
+		ACCELERATION_Z,
+		AGE,
+		INV_LIFE, ///< One over the life time of the particle.
+		INITIAL_SIZE,
+		SIZE_DELTA, ///< Final minus initial size.
+		INITIAL_ALPHA,
+		ALPHA_DELTA, ///< Final minus initial alpha.
+
+		COUNT
+	};
+
+	/// The results of a block.
+	class Block
+	{
+	public:
+		Vec4 m_aabbMin;
+		Vec4 m_aabbMax;
+		F32 m_maxParticleSize;
+		U32 m_deadParticleCount;
+	};
+
+	class SimulateCtx;
+
+	SceneAllocator<U8> m_alloc;
+	F32* m_memory = nullptr;
+	Array<F32*, U32(Stream::COUNT)> m_streams = {};
+	DynamicArray<Block> m_blocks;
+	U32 m_maxParticleCount = 0;
+	U32 m_aliveParticleCount = 0;
+
+	F32* getStream(Stream stream)
+	{
+		return m_streams[U32(stream)];
+	}
+
+	void simulateBlock(U32 blockIdx, F32 dt, F32* verts);
+
+	/// Kill a particle by moving the last alive particle in its place.
+	void killParticle(U32 idx, F32* verts);
+
+	static void runSimulateTasks(SimulateCtx& ctx);
+};
+/// @}
+
+} // end namespace anki
@@ -61,7 +61,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(PlayerNode::FeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(PlayerNode::FeedbackComponent, "PlayerControllerComponent", "MoveComponent")
 
 /// Feedback component.
 class PlayerNode::FeedbackComponent2 final : public SceneComponent
@@ -116,7 +116,7 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(PlayerNode::FeedbackComponent2)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(PlayerNode::FeedbackComponent2, "MoveComponent", "")
 
 PlayerNode::PlayerNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
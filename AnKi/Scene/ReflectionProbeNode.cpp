@@ -45,7 +45,8 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(ReflectionProbeNode::MoveFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(ReflectionProbeNode::MoveFeedbackComponent, "MoveComponent",
+									 "FrustumComponent ReflectionProbeComponent")
 
 /// Feedback component
 class ReflectionProbeNode::ShapeFeedbackComponent : public SceneComponent
@@ -73,11 +74,15 @@ public:
 	}
 };
 
-ANKI_SCENE_COMPONENT_STATICS(ReflectionProbeNode::ShapeFeedbackComponent)
+ANKI_SCENE_COMPONENT_STATICS_ORDERED(ReflectionProbeNode::ShapeFeedbackComponent, "ReflectionProbeComponent",
+									 "SpatialComponent")
 
 ReflectionProbeNode::ReflectionProbeNode(SceneGraph* scene, CString name)
 	: SceneNode(scene, name)
 {
+	// It has to check if the probe is marked for rendering every frame
+	setNeedsFrameUpdate(true);
+
 	// Move component first
 	newComponent<MoveComponent>();
 
@@ -0,0 +1,137 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/SceneComponentPool.h>
+#include <AnKi/Scene/Components/SceneComponent.h>
+
+namespace anki {
+
+SceneComponentPool::~SceneComponentPool()
+{
+	ANKI_ASSERT(m_componentCount.load() == 0 && "Forgot to delete some components");
+
+	const U32 chunkCount = m_chunkCount.load();
+	for(U32 chunkIdx = 0; chunkIdx < chunkCount; ++chunkIdx)
+	{
+		m_alloc.getMemoryPool().free(getChunk(chunkIdx).m_memory);
+	}
+
+	for(U32 page = 0; page < (chunkCount + CHUNKS_PER_PAGE - 1) / CHUNKS_PER_PAGE; ++page)
+	{
+		m_alloc.deleteArray(m_chunkPages[page], CHUNKS_PER_PAGE);
+	}
+
+	m_chunksWithFreeSlots.destroy(m_alloc);
+}
+
+void SceneComponentPool::init(SceneAllocator<U8> alloc, const SceneComponentRtti& rtti)
+{
+	ANKI_ASSERT(m_componentSize == 0 && "Already initialized");
+	m_alloc = alloc;
+	m_componentAlignment = rtti.m_classAlignment;
+	m_componentSize = getAlignedRoundUp(rtti.m_classAlignment, rtti.m_classSize);
+}
+
+void* SceneComponentPool::allocate(U32& poolIndex)
+{
+	ANKI_ASSERT(m_componentSize > 0);
+	LockGuard<SpinLock> lock(m_lock);
+
+	if(m_chunksWithFreeSlots.getSize() == 0)
+	{
+		const U32 chunkIdx = m_chunkCount.load();
+		ANKI_ASSERT(chunkIdx < CHUNKS_PER_PAGE * MAX_CHUNK_PAGES && "Too many components of the same class");
+
+		Chunk*& page = m_chunkPages[chunkIdx / CHUNKS_PER_PAGE];
+		if(page == nullptr)
+		{
+			page = m_alloc.newArray<Chunk>(CHUNKS_PER_PAGE);
+		}
+
+		page[chunkIdx % CHUNKS_PER_PAGE].m_memory = static_cast<U8*>(
+			m_alloc.getMemoryPool().allocate(PtrSize(m_componentSize) * COMPONENTS_PER_CHUNK, m_componentAlignment));
+		m_chunksWithFreeSlots.emplaceBack(m_alloc, chunkIdx);
+
+		// Publish the chunk after it's ready
+		m_chunkCount.store(chunkIdx + 1);
+	}
+
+	const U32 chunkIdx = m_chunksWithFreeSlots.getBack();
+	Chunk& chunk = getChunk(chunkIdx);
+	const U64 aliveMask = chunk.m_aliveMask.load();
+	ANKI_ASSERT(aliveMask != MAX_U64);
+
+	const U32 slot = U32(__builtin_ctzll(~aliveMask));
+	const U64 bit = U64(1) << U64(slot);
+	chunk.m_activeMask.fetchOr(bit);
+	chunk.m_aliveMask.store(aliveMask | bit);
+
+	if((aliveMask | bit) == MAX_U64)
+	{
+		// Chunk is full
+		m_chunksWithFreeSlots.popBack(m_alloc);
+	}
+
+	m_componentCount.fetchAdd(1);
+	poolIndex = chunkIdx * COMPONENTS_PER_CHUNK + slot;
+	return chunk.m_memory + PtrSize(slot) * m_componentSize;
+}
+
+void SceneComponentPool::free(void* ptr, U32 poolIndex)
+{
+	ANKI_ASSERT(ptr);
+	LockGuard<SpinLock> lock(m_lock);
+
+	const U32 chunkIdx = poolIndex / COMPONENTS_PER_CHUNK;
+	const U64 bit = U64(1) << U64(poolIndex % COMPONENTS_PER_CHUNK);
+	Chunk& chunk = getChunk(chunkIdx);
+	const U64 aliveMask = chunk.m_aliveMask.load();
+	ANKI_ASSERT(chunk.m_memory + PtrSize(poolIndex % COMPONENTS_PER_CHUNK) * m_componentSize == ptr);
+	ANKI_ASSERT(aliveMask & bit);
+	(void)ptr;
+
+	if(aliveMask == MAX_U64)
+	{
+		// Was full, now it has a free slot
+		m_chunksWithFreeSlots.emplaceBack(m_alloc, chunkIdx);
+	}
+
+	chunk.m_activeMask.fetchAnd(~bit);
+	chunk.m_aliveMask.store(aliveMask & ~bit);
+	m_componentCount.fetchSub(1);
+}
+
+Bool SceneComponentPool::setComponentActive(U32 poolIndex, Bool active)
+{
+	// Only the word of the chunk is touched so the threads that update different chunks don't contend
+	const U64 bit = U64(1) << U64(poolIndex % COMPONENTS_PER_CHUNK);
+	Chunk& chunk = getChunk(poolIndex / COMPONENTS_PER_CHUNK);
+	ANKI_ASSERT(chunk.m_aliveMask.load() & bit);
+
+	const U64 oldMask = (active) ? chunk.m_activeMask.fetchOr(bit) : chunk.m_activeMask.fetchAnd(~bit);
+	return !!(oldMask & bit) != active;
+}
+
+SceneComponent& SceneComponentPool::getComponent(U32 poolIndex)
+{
+	const U32 slot = poolIndex % COMPONENTS_PER_CHUNK;
+	Chunk& chunk = getChunk(poolIndex / COMPONENTS_PER_CHUNK);
+	ANKI_ASSERT(chunk.m_aliveMask.load() & (U64(1) << U64(slot)));
+	return *reinterpret_cast<SceneComponent*>(chunk.m_memory + PtrSize(slot) * m_componentSize);
+}
+
+U32 SceneComponentPool::getActiveComponentCount() const
+{
+	U32 count = 0;
+	const U32 chunkCount = m_chunkCount.load();
+	for(U32 chunkIdx = 0; chunkIdx < chunkCount; ++chunkIdx)
+	{
+		count += U32(__builtin_popcountll(getChunk(chunkIdx).m_activeMask.load()));
+	}
+
+	return count;
+}
+
+} // end namespace anki
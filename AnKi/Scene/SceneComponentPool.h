@@ -0,0 +1,140 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/Thread.h>
+
+namespace anki {
+
+// Forward
+class SceneComponent;
+class SceneComponentRtti;
+
+/// @addtogroup scene
+/// @{
+
+/// Holds all the components of a single class. The components live in fixed size chunks so their addresses never change
+/// and components of the same class are close in memory. Freed slots are re-used. The pool also tracks which components
+/// are active (have work to do) so the idle ones can be skipped.
+class SceneComponentPool
+{
+public:
+	static constexpr U32 COMPONENTS_PER_CHUNK = 64;
+
+	SceneComponentPool() = default;
+
+	SceneComponentPool(const SceneComponentPool&) = delete; // Non-copyable
+
+	~SceneComponentPool();
+
+	SceneComponentPool& operator=(const SceneComponentPool&) = delete; // Non-copyable
+
+	void init(SceneAllocator<U8> alloc, const SceneComponentRtti& rtti);
+
+	/// Allocate memory for a new component. The new component starts active.
+	/// @param[out] poolIndex The index of the component inside the pool. It doesn't change during its lifetime.
+	/// @note It's thread-safe.
+	void* allocate(U32& poolIndex);
+
+	/// Free the memory of a component. The component should already be destructed.
+	/// @note It's thread-safe.
+	void free(void* ptr, U32 poolIndex);
+
+	/// Get a component using its pool index.
+	/// @note It's thread-safe.
+	SceneComponent& getComponent(U32 poolIndex);
+
+	/// Mark a component as active or inactive.
+	/// @return True if the state changed.
+	/// @note It's thread-safe.
+	Bool setComponentActive(U32 poolIndex, Bool active);
+
+	/// Iterate the components of a chunk.
+	/// @note It's thread-safe but the components that get allocated or freed while iterating might not be visited.
+	template<typename TFunc>
+	void iterateChunk(U32 chunkIdx, TFunc func)
+	{
+		iterateChunkInternal(chunkIdx, false, func);
+	}
+
+	/// Iterate the active components of a chunk.
+	/// @note It's thread-safe but the components that change state while iterating might not be visited.
+	template<typename TFunc>
+	void iterateActiveChunk(U32 chunkIdx, TFunc func)
+	{
+		iterateChunkInternal(chunkIdx, true, func);
+	}
+
+	/// Get the number of chunks. Use it with iterateChunk().
+	U32 getChunkCount() const
+	{
+		return m_chunkCount.load();
+	}
+
+	/// Get the number of live components.
+	U32 getComponentCount() const
+	{
+		return m_componentCount.load();
+	}
+
+	/// Get the number of live and active components. It counts the active masks so don't call it often.
+	U32 getActiveComponentCount() const;
+
+private:
+	static constexpr U32 CHUNKS_PER_PAGE = 128;
+	static constexpr U32 MAX_CHUNK_PAGES = 256;
+
+	class Chunk
+	{
+	public:
+		U8* m_memory = nullptr;
+		Atomic<U64> m_aliveMask = {0}; ///< One bit per slot. Changed only with the lock held.
+		Atomic<U64> m_activeMask = {0}; ///< One bit per slot. A subset of m_aliveMask. Changed without the lock.
+	};
+
+	static_assert(COMPONENTS_PER_CHUNK == sizeof(U64) * 8, "See Chunk::m_aliveMask");
+
+	SceneAllocator<U8> m_alloc;
+
+	/// The chunks live in pages that never move so they can be accessed without the lock.
+	Array<Chunk*, MAX_CHUNK_PAGES> m_chunkPages = {};
+	DynamicArray<U32> m_chunksWithFreeSlots; ///< A stack of chunk indices.
+	U32 m_componentSize = 0; ///< The size of the component class aligned to its alignment.
+	U32 m_componentAlignment = 0;
+	Atomic<U32> m_chunkCount = {0};
+	Atomic<U32> m_componentCount = {0};
+	SpinLock m_lock; ///< Protects the allocation and the freeing of chunks and slots.
+
+	Chunk& getChunk(U32 chunkIdx)
+	{
+		ANKI_ASSERT(chunkIdx < m_chunkCount.load());
+		return m_chunkPages[chunkIdx / CHUNKS_PER_PAGE][chunkIdx % CHUNKS_PER_PAGE];
+	}
+
+	const Chunk& getChunk(U32 chunkIdx) const
+	{
+		ANKI_ASSERT(chunkIdx < m_chunkCount.load());
+		return m_chunkPages[chunkIdx / CHUNKS_PER_PAGE][chunkIdx % CHUNKS_PER_PAGE];
+	}
+
+	template<typename TFunc>
+	void iterateChunkInternal(U32 chunkIdx, Bool activeOnly, TFunc func)
+	{
+		const Chunk& chunk = getChunk(chunkIdx);
+		U64 mask = (activeOnly) ? chunk.m_activeMask.load() : chunk.m_aliveMask.load();
+		while(mask)
+		{
+			const U32 slot = U32(__builtin_ctzll(mask));
+			mask &= mask - 1;
+			func(*reinterpret_cast<SceneComponent*>(chunk.m_memory + PtrSize(slot) * m_componentSize));
+		}
+	}
+};
+/// @}
+
+} // end namespace anki
@@ -8,31 +8,68 @@
 #include <AnKi/Scene/PhysicsDebugNode.h>
 #include <AnKi/Scene/ModelNode.h>
 #include <AnKi/Scene/Octree.h>
+#include <AnKi/Scene/GpuSceneInstances.h>
+#include <AnKi/Scene/TransformHierarchy.h>
+#include <AnKi/Scene/SkinPoseCache.h>
 #include <AnKi/Scene/Components/FrustumComponent.h>
+#include <AnKi/Scene/Components/MoveComponent.h>
 #include <AnKi/Physics/PhysicsWorld.h>
 #include <AnKi/Resource/ResourceManager.h>
 #include <AnKi/Renderer/MainRenderer.h>
+#include <AnKi/Renderer/RenderQueue.h>
 #include <AnKi/Core/ConfigSet.h>
 #include <AnKi/Util/ThreadHive.h>
 #include <AnKi/Util/Tracer.h>
 #include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/StringList.h>
 
 namespace anki {
 
-const U NODE_UPDATE_BATCH = 10;
+const U32 NODE_UPDATE_BATCH = 10;
 
 class SceneGraph::UpdateSceneNodesCtx
 {
 public:
 	SceneGraph* m_scene = nullptr;
 
-	IntrusiveList<SceneNode>::Iterator m_crntNode;
-	SpinLock m_crntNodeLock;
+	Atomic<U32> m_crntNode = {0};
 
 	Second m_prevUpdateTime;
 	Second m_crntTime;
 };
 
+class SceneGraph::UpdateComponentsCtx
+{
+public:
+	class DeferredComponent
+	{
+	public:
+		SceneComponent* m_component;
+		U32 m_depth; ///< How deep is the node in the hierarchy.
+	};
+
+	SceneGraph* m_scene = nullptr;
+	SceneComponentPool* m_pool = nullptr;
+	U32 m_chunkCount = 0;
+	Atomic<U32> m_crntChunk = {0};
+
+	/// The components of nodes with parents. They will be updated after their parents.
+	DynamicArrayAuto<DeferredComponent> m_deferredComponents;
+	SpinLock m_deferredComponentsLock;
+	Atomic<U32> m_crntDeferredComponent = {0};
+	U32 m_deferredComponentsEnd = 0; ///< The end of the hierarchy level that is being updated.
+
+	Atomic<U32> m_error = {0};
+
+	Second m_prevUpdateTime;
+	Second m_crntTime;
+
+	UpdateComponentsCtx(SceneFrameAllocator<U8> alloc)
+		: m_deferredComponents(alloc)
+	{
+	}
+};
+
 SceneGraph::SceneGraph()
 {
 }
@@ -51,6 +88,30 @@ SceneGraph::~SceneGraph()
 	{
 		m_alloc.deleteInstance(m_octree);
 	}
+
+	if(m_gpuSceneInstances)
+	{
+		m_alloc.deleteInstance(m_gpuSceneInstances);
+	}
+
+	if(m_transformHierarchy)
+	{
+		m_alloc.deleteInstance(m_transformHierarchy);
+	}
+
+	if(m_skinPoseCache)
+	{
+		m_alloc.deleteInstance(m_skinPoseCache);
+	}
+
+	m_frameUpdateNodes.destroy(m_alloc);
+	m_activeNodes.destroy(m_alloc);
+
+	for(U32 i = 0; i < m_nodeHandleChunkCount; ++i)
+	{
+		m_alloc.deleteArray(m_nodeHandleGenerations[i], NODE_HANDLES_PER_CHUNK);
+	}
+	m_freeNodeHandleSlots.destroy(m_alloc);
 }
 
 Error SceneGraph::init(AllocAlignedCallback allocCb, void* allocCbData, ThreadHive* threadHive,
@@ -66,8 +127,15 @@ Error SceneGraph::init(AllocAlignedCallback allocCb, void* allocCbData, ThreadHi
 	m_scriptManager = scriptManager;
 	m_uiManager = uiManager;
 
-	m_alloc = SceneAllocator<U8>(allocCb, allocCbData);
-	m_frameAlloc = SceneFrameAllocator<U8>(allocCb, allocCbData, 1 * 1024 * 1024);
+	m_alloc = SceneAllocator<U8>(allocCb, allocCbData, "Scene");
+	m_frameAlloc = SceneFrameAllocator<U8>(allocCb, allocCbData, 1 * 1024 * 1024, 2.0, 0, true, ANKI_SAFE_ALIGNMENT,
+										   "SceneFrame");
+
+	for(U32 classId = 0; classId < SceneComponent::getClassCount(); ++classId)
+	{
+		m_componentPools[classId].init(m_alloc, SceneComponent::findClassRtti(U8(classId)));
+	}
+	ANKI_CHECK(computeComponentUpdateOrder());
 
 	// Limits & stuff
 	m_config.m_earlyZDistance = config.getNumberF32("scene_earlyZDistance");
@@ -85,6 +153,15 @@ Error SceneGraph::init(AllocAlignedCallback allocCb, void* allocCbData, ThreadHi
 	m_octree = m_alloc.newInstance<Octree>(m_alloc);
 	m_octree->init(m_sceneMin, m_sceneMax, config.getNumberU32("scene_octreeMaxDepth"));
 
+	if(config.getBool("r_gpuScene"))
+	{
+		m_gpuSceneInstances = m_alloc.newInstance<GpuSceneInstances>(m_alloc);
+	}
+
+	m_transformHierarchy = m_alloc.newInstance<TransformHierarchy>(m_alloc);
+
+	m_skinPoseCache = m_alloc.newInstance<SkinPoseCache>(m_alloc);
+
 	// Init the default main camera
 	ANKI_CHECK(newSceneNode<PerspectiveCameraNode>("mainCamera", m_defaultMainCam));
 	m_defaultMainCam->getFirstComponentOfType<FrustumComponent>().setPerspective(0.1f, 1000.0f, toRad(60.0f),
@@ -144,6 +221,55 @@ void SceneGraph::unregisterNode(SceneNode* node)
 	}
 }
 
+SceneNodeHandle SceneGraph::newNodeHandle()
+{
+	LockGuard<SpinLock> lock(m_nodeHandlesLock);
+
+	if(m_freeNodeHandleSlots.getSize() == 0)
+	{
+		if(ANKI_UNLIKELY(m_nodeHandleChunkCount == MAX_NODE_HANDLE_CHUNKS))
+		{
+			ANKI_SCENE_LOGF("Reached the max number of scene nodes");
+		}
+
+		Atomic<U32>* generations = m_alloc.newArray<Atomic<U32>>(NODE_HANDLES_PER_CHUNK);
+		for(U32 i = 0; i < NODE_HANDLES_PER_CHUNK; ++i)
+		{
+			generations[i].setNonAtomically(0);
+		}
+		m_nodeHandleGenerations[m_nodeHandleChunkCount] = generations;
+
+		// Push them in reverse to use the 1st slot of the chunk first
+		for(U32 i = NODE_HANDLES_PER_CHUNK; i > 0; --i)
+		{
+			m_freeNodeHandleSlots.emplaceBack(m_alloc, m_nodeHandleChunkCount * NODE_HANDLES_PER_CHUNK + i - 1);
+		}
+
+		++m_nodeHandleChunkCount;
+	}
+
+	SceneNodeHandle handle;
+	handle.m_slot = m_freeNodeHandleSlots.getBack();
+	m_freeNodeHandleSlots.popBack(m_alloc);
+	handle.m_generation =
+		m_nodeHandleGenerations[handle.m_slot / NODE_HANDLES_PER_CHUNK][handle.m_slot % NODE_HANDLES_PER_CHUNK].load();
+
+	return handle;
+}
+
+void SceneGraph::deleteNodeHandle(SceneNodeHandle handle)
+{
+	LockGuard<SpinLock> lock(m_nodeHandlesLock);
+
+	// If the node wasn't marked for deletion (eg. a failed init) the handle is still valid
+	if(isNodeHandleValid(handle))
+	{
+		invalidateNodeHandle(handle);
+	}
+
+	m_freeNodeHandleSlots.emplaceBack(m_alloc, handle.m_slot);
+}
+
 SceneNode& SceneGraph::findSceneNode(const CString& name)
 {
 	SceneNode* node = tryFindSceneNode(name);
@@ -161,6 +287,13 @@ void SceneGraph::deleteNodesMarkedForDeletion()
 {
 	/// Delete all nodes pending deletion. At this point all scene threads
 	/// should have finished their tasks
+
+	// The events of the nodes shouldn't outlive them
+	if(m_objectsMarkedForDeletionCount.load() > 0)
+	{
+		m_events.markEventsOfNodesMarkedForDeletion();
+	}
+
 	while(m_objectsMarkedForDeletionCount.load() > 0)
 	{
 		Bool found = false;
@@ -202,9 +335,8 @@ Error SceneGraph::update(Second prevUpdateTime, Second crntTime)
 	// Delete stuff
 	{
 		ANKI_TRACE_SCOPED_EVENT(SCENE_MARKED_FOR_DELETION);
-		const Bool fullCleanup = m_objectsMarkedForDeletionCount.load() != 0;
-		m_events.deleteEventsMarkedForDeletion(fullCleanup);
 		deleteNodesMarkedForDeletion();
+		m_events.deleteEventsMarkedForDeletion();
 	}
 
 	// Update
@@ -219,29 +351,78 @@ Error SceneGraph::update(Second prevUpdateTime, Second crntTime)
 		ANKI_TRACE_SCOPED_EVENT(SCENE_NODES_UPDATE);
 		ANKI_CHECK(m_events.updateAllEvents(prevUpdateTime, crntTime));
 
-		// Then the rest
-		Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+		// Update the components, one class at a time
+		m_activeNodeCount = 0;
+		m_skinPoseCache->newFrame();
+
+		for(U32 i = 0; i < SceneComponent::getClassCount(); ++i)
+		{
+			const U8 classId = m_componentUpdateOrder[i];
+			if(classId == MoveComponent::getStaticClassId())
+			{
+				// The move components only report the world transforms that the hierarchy computes. Wake up the ones
+				// that got updated
+				m_transformHierarchy->update(m_threadHive);
+				m_transformHierarchy->iterateUpdatedTransforms([](U32 idx, void* userData) {
+					static_cast<MoveComponent*>(userData)->setActive(true);
+				});
+			}
+
+			ANKI_CHECK(updateComponentsOfClass(classId, prevUpdateTime, crntTime));
+		}
+
+		// Then the nodes that have something to update
+		{
+			LockGuard<SpinLock> lock(m_frameUpdateNodesLock);
+			for(SceneNode* node : m_frameUpdateNodes)
+			{
+				markNodeActive(*node);
+			}
+		}
+
 		UpdateSceneNodesCtx updateCtx;
 		updateCtx.m_scene = this;
-		updateCtx.m_crntNode = m_nodes.getBegin();
 		updateCtx.m_prevUpdateTime = prevUpdateTime;
 		updateCtx.m_crntTime = crntTime;
 
-		for(U i = 0; i < m_threadHive->getThreadCount(); i++)
+		const U32 threadCount =
+			min(m_threadHive->getThreadCount(), (m_activeNodeCount + NODE_UPDATE_BATCH - 1) / NODE_UPDATE_BATCH);
+		if(threadCount <= 1)
 		{
-			tasks[i] = ANKI_THREAD_HIVE_TASK(
-				{
-					if(self->m_scene->updateNodes(*self))
+			ANKI_CHECK(updateNodes(updateCtx));
+		}
+		else
+		{
+			Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+			for(U32 i = 0; i < threadCount; i++)
+			{
+				tasks[i] = ANKI_THREAD_HIVE_TASK(
 					{
-						ANKI_SCENE_LOGF("Will not recover");
-					}
-				},
-				&updateCtx, nullptr, nullptr);
+						if(self->m_scene->updateNodes(*self))
+						{
+							ANKI_SCENE_LOGF("Will not recover");
+						}
+					},
+					&updateCtx, nullptr, nullptr);
+			}
+
+			m_threadHive->submitTasks(&tasks[0], threadCount);
+			m_threadHive->waitAllTasks();
 		}
+	}
 
-		m_threadHive->submitTasks(&tasks[0], m_threadHive->getThreadCount());
-		m_threadHive->waitAllTasks();
+	// Stats
+	m_stats.m_nodeCount = m_nodesCount;
+	m_stats.m_activeNodeCount = m_activeNodeCount;
+	m_stats.m_componentCount = 0;
+	m_stats.m_activeComponentCount = 0;
+	for(U32 i = 0; i < SceneComponent::getClassCount(); ++i)
+	{
+		m_stats.m_componentCount += m_componentPools[i].getComponentCount();
+		m_stats.m_activeComponentCount += m_componentPools[i].getActiveComponentCount();
 	}
+	ANKI_TRACE_INC_COUNTER(SCENE_NODES_ACTIVE, m_stats.m_activeNodeCount);
+	ANKI_TRACE_INC_COUNTER(SCENE_COMPONENTS_ACTIVE, m_stats.m_activeComponentCount);
 
 	m_stats.m_updateTime = HighRezTimer::getCurrentTime() - m_stats.m_updateTime;
 	return Error::NONE;
@@ -251,6 +432,11 @@ void SceneGraph::doVisibilityTests(RenderQueue& rqueue)
 {
 	m_stats.m_visibilityTestsTime = HighRezTimer::getCurrentTime();
 	doVisibilityTests(*m_mainCam, *this, rqueue);
+	m_octree->resetVisitedPlaceables();
+	if(m_gpuSceneInstances)
+	{
+		m_gpuSceneInstances->flush(m_frameAlloc, rqueue.m_gpuScene);
+	}
 	m_stats.m_visibilityTestsTime = HighRezTimer::getCurrentTime() - m_stats.m_visibilityTestsTime;
 }
 
@@ -258,109 +444,362 @@ Error SceneGraph::updateNode(Second prevTime, Second crntTime, SceneNode& node)
 {
 	ANKI_TRACE_INC_COUNTER(SCENE_NODES_UPDATED, 1);
 
-	Error err = Error::NONE;
+	// The components are already updated
+	if(node.anyComponentUpdatedThisFrame(nullptr))
+	{
+		node.setComponentMaxTimestamp(node.getSceneGraph().m_timestamp);
+	}
+	else
+	{
+		// No components or nothing updated, don't change the timestamp
+	}
 
-	// Components update
-	Timestamp componentTimestamp = 0;
-	Bool atLeastOneComponentUpdated = false;
-	err = node.iterateComponents([&](SceneComponent& comp, Bool isFeedbackComponent) -> Error {
-		Bool updated = false;
-		Error e = Error::NONE;
-		if(!atLeastOneComponentUpdated && isFeedbackComponent)
-		{
-			// Skip feedback component if prior components didn't got updated
-		}
-		else
+	return node.frameUpdate(prevTime, crntTime);
+}
+
+Error SceneGraph::computeComponentUpdateOrder()
+{
+	const U32 classCount = SceneComponent::getClassCount();
+
+	// Gather the dependencies. For each class a mask of the classes that should be updated before it
+	Array<U64, MAX_SCENE_COMPONENT_CLASSES> dependencies = {};
+	auto addDependencies = [&](const SceneComponentRtti& rtti, CString classNames, Bool classNamesBefore) -> Error {
+		if(classNames.isEmpty())
 		{
-			e = comp.update(node, prevTime, crntTime, updated);
+			return Error::NONE;
 		}
 
-		if(updated)
+		StringListAuto names(m_frameAlloc);
+		names.splitString(classNames, ' ');
+		for(const String& name : names)
 		{
-			ANKI_TRACE_INC_COUNTER(SCENE_COMPONENTS_UPDATED, 1);
-			comp.setTimestamp(node.getSceneGraph().m_timestamp);
-			componentTimestamp = max(componentTimestamp, node.getSceneGraph().m_timestamp);
-			ANKI_ASSERT(componentTimestamp > 0);
-			atLeastOneComponentUpdated = true;
+			U32 otherClassId = 0;
+			while(otherClassId < classCount
+				  && name.toCString() != SceneComponent::findClassRtti(U8(otherClassId)).m_className)
+			{
+				++otherClassId;
+			}
+
+			if(otherClassId == classCount)
+			{
+				ANKI_SCENE_LOGE("Scene component %s declares an update order against an unknown class: %s",
+								rtti.m_className, name.cstr());
+				return Error::USER_DATA;
+			}
+
+			if(classNamesBefore)
+			{
+				dependencies[rtti.m_classId] |= U64(1) << U64(otherClassId);
+			}
+			else
+			{
+				dependencies[otherClassId] |= U64(1) << U64(rtti.m_classId);
+			}
 		}
 
-		return e;
-	});
+		return Error::NONE;
+	};
 
-	// Update children
-	if(!err)
+	for(U32 classId = 0; classId < classCount; ++classId)
 	{
-		err = node.visitChildrenMaxDepth(0, [&](SceneNode& child) -> Error {
-			return updateNode(prevTime, crntTime, child);
-		});
+		const SceneComponentRtti& rtti = SceneComponent::findClassRtti(U8(classId));
+		ANKI_CHECK(addDependencies(rtti, rtti.m_updateAfter, true));
+		ANKI_CHECK(addDependencies(rtti, rtti.m_updateBefore, false));
 	}
 
-	// Frame update
-	if(!err)
+	// Topological sort
+	U64 doneMask = 0;
+	U32 orderCount = 0;
+	while(orderCount < classCount)
 	{
-		if(componentTimestamp != 0)
+		// Find the classes that have all their dependencies done
+		U32 newOrderCount = orderCount;
+		for(U32 classId = 0; classId < classCount; ++classId)
 		{
-			node.setComponentMaxTimestamp(componentTimestamp);
+			const U64 classMask = U64(1) << U64(classId);
+			if(!(doneMask & classMask) && (dependencies[classId] & ~doneMask) == 0)
+			{
+				m_componentUpdateOrder[newOrderCount++] = U8(classId);
+			}
 		}
-		else
+
+		if(newOrderCount == orderCount)
 		{
-			// No components or nothing updated, don't change the timestamp
+			for(U32 classId = 0; classId < classCount; ++classId)
+			{
+				if(!(doneMask & (U64(1) << U64(classId))))
+				{
+					ANKI_SCENE_LOGE("Scene component %s is part of an update order cycle",
+									SceneComponent::findClassRtti(U8(classId)).m_className);
+				}
+			}
+
+			return Error::USER_DATA;
 		}
 
-		err = node.frameUpdate(prevTime, crntTime);
+		for(U32 i = orderCount; i < newOrderCount; ++i)
+		{
+			doneMask |= U64(1) << U64(m_componentUpdateOrder[i]);
+		}
+		orderCount = newOrderCount;
 	}
 
-	return err;
+	return Error::NONE;
 }
 
-Error SceneGraph::updateNodes(UpdateSceneNodesCtx& ctx) const
+Error SceneGraph::updateComponentsOfClass(U8 classId, Second prevTime, Second crntTime)
 {
-	ANKI_TRACE_SCOPED_EVENT(SCENE_NODES_UPDATE);
+	SceneComponentPool& pool = m_componentPools[classId];
+	if(pool.getComponentCount() == 0)
+	{
+		return Error::NONE;
+	}
 
-	IntrusiveList<SceneNode>::ConstIterator end = m_nodes.getEnd();
+	UpdateComponentsCtx ctx(m_frameAlloc);
+	ctx.m_scene = this;
+	ctx.m_pool = &pool;
+	ctx.m_chunkCount = pool.getChunkCount();
+	ctx.m_prevUpdateTime = prevTime;
+	ctx.m_crntTime = crntTime;
 
-	Bool quit = false;
-	Error err = Error::NONE;
-	while(!quit && !err)
+	// Update the components of the root nodes
+	const U32 threadCount = min(m_threadHive->getThreadCount(), ctx.m_chunkCount);
+	if(threadCount <= 1)
 	{
-		// Fetch a batch of scene nodes that don't have parent
-		Array<SceneNode*, NODE_UPDATE_BATCH> batch;
-		U batchSize = 0;
+		ANKI_CHECK(updateComponents(ctx));
+	}
+	else
+	{
+		Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+		for(U32 i = 0; i < threadCount; ++i)
+		{
+			tasks[i] = ANKI_THREAD_HIVE_TASK(
+				{
+					if(self->m_scene->updateComponents(*self))
+					{
+						self->m_error.store(1);
+					}
+				},
+				&ctx, nullptr, nullptr);
+		}
 
+		m_threadHive->submitTasks(&tasks[0], threadCount);
+		m_threadHive->waitAllTasks();
+
+		if(ctx.m_error.load())
 		{
-			LockGuard<SpinLock> lock(ctx.m_crntNodeLock);
+			return Error::FUNCTION_FAILED;
+		}
+	}
+
+	// Update the rest from the top of the hierarchy to the bottom. The components of the same depth don't depend on
+	// each other so update them in parallel, one depth at a time
+	const U32 deferredCount = ctx.m_deferredComponents.getSize();
+	if(deferredCount)
+	{
+		std::sort(ctx.m_deferredComponents.getBegin(), ctx.m_deferredComponents.getEnd(),
+				  [](const UpdateComponentsCtx::DeferredComponent& a, const UpdateComponentsCtx::DeferredComponent& b) {
+					  return a.m_depth < b.m_depth;
+				  });
 
-			while(1)
+		U32 depthBegin = 0;
+		while(depthBegin < deferredCount)
+		{
+			U32 depthEnd = depthBegin + 1;
+			while(depthEnd < deferredCount
+				  && ctx.m_deferredComponents[depthEnd].m_depth == ctx.m_deferredComponents[depthBegin].m_depth)
 			{
-				if(batchSize == batch.getSize())
+				++depthEnd;
+			}
+
+			ctx.m_crntDeferredComponent.setNonAtomically(depthBegin);
+			ctx.m_deferredComponentsEnd = depthEnd;
+
+			const U32 depthThreadCount = min(m_threadHive->getThreadCount(),
+											 (depthEnd - depthBegin + NODE_UPDATE_BATCH - 1) / NODE_UPDATE_BATCH);
+			if(depthThreadCount <= 1)
+			{
+				ANKI_CHECK(updateDeferredComponents(ctx));
+			}
+			else
+			{
+				Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+				for(U32 i = 0; i < depthThreadCount; ++i)
 				{
-					break;
+					tasks[i] = ANKI_THREAD_HIVE_TASK(
+						{
+							if(self->m_scene->updateDeferredComponents(*self))
+							{
+								self->m_error.store(1);
+							}
+						},
+						&ctx, nullptr, nullptr);
 				}
 
-				if(ctx.m_crntNode == end)
+				m_threadHive->submitTasks(&tasks[0], depthThreadCount);
+				m_threadHive->waitAllTasks();
+
+				if(ctx.m_error.load())
 				{
-					quit = true;
-					break;
+					return Error::FUNCTION_FAILED;
 				}
+			}
 
-				SceneNode& node = *ctx.m_crntNode;
-				if(node.getParent() == nullptr)
+			depthBegin = depthEnd;
+		}
+	}
+
+	return Error::NONE;
+}
+
+Error SceneGraph::updateComponents(UpdateComponentsCtx& ctx)
+{
+	ANKI_TRACE_SCOPED_EVENT(SCENE_COMPONENTS_UPDATE);
+
+	Error err = Error::NONE;
+	U32 chunkIdx;
+	while(!err && (chunkIdx = ctx.m_crntChunk.fetchAdd(1)) < ctx.m_chunkCount)
+	{
+		ctx.m_pool->iterateActiveChunk(chunkIdx, [&](SceneComponent& comp) {
+			if(err)
+			{
+				return;
+			}
+
+			const SceneNode* parent = comp.getSceneNode().getParent();
+			if(parent == nullptr)
+			{
+				err = updateComponent(comp, ctx.m_prevUpdateTime, ctx.m_crntTime);
+			}
+			else
+			{
+				UpdateComponentsCtx::DeferredComponent deferred;
+				deferred.m_component = &comp;
+				deferred.m_depth = 1;
+				while((parent = parent->getParent()) != nullptr)
 				{
-					batch[batchSize++] = &node;
+					++deferred.m_depth;
 				}
 
-				++ctx.m_crntNode;
+				LockGuard<SpinLock> lock(ctx.m_deferredComponentsLock);
+				ctx.m_deferredComponents.emplaceBack(deferred);
 			}
+		});
+	}
+
+	return err;
+}
+
+Error SceneGraph::updateDeferredComponents(UpdateComponentsCtx& ctx)
+{
+	ANKI_TRACE_SCOPED_EVENT(SCENE_COMPONENTS_UPDATE);
+
+	Error err = Error::NONE;
+	U32 begin;
+	while(!err && (begin = ctx.m_crntDeferredComponent.fetchAdd(NODE_UPDATE_BATCH)) < ctx.m_deferredComponentsEnd)
+	{
+		const U32 end = min(ctx.m_deferredComponentsEnd, begin + NODE_UPDATE_BATCH);
+		for(U32 i = begin; i < end && !err; ++i)
+		{
+			err = updateComponent(*ctx.m_deferredComponents[i].m_component, ctx.m_prevUpdateTime, ctx.m_crntTime);
 		}
+	}
+
+	return err;
+}
+
+Error SceneGraph::updateComponent(SceneComponent& comp, Second prevTime, Second crntTime)
+{
+	SceneNode& node = comp.getSceneNode();
+
+	if(comp.isFeedbackComponent())
+	{
+		// Feedback components sleep until the node wakes them up again
+		comp.setActive(false);
+	}
+
+	Bool updated = false;
+	Error err = Error::NONE;
+	if(comp.isFeedbackComponent() && !node.anyComponentUpdatedThisFrame(&comp)
+	   && comp.m_wokenUpTimestamp + 1 < m_timestamp)
+	{
+		// Skip feedback component if prior components didn't got updated. Unless they got updated after the component
+		// ran in the previous frame and woke it up
+	}
+	else
+	{
+		err = comp.update(node, prevTime, crntTime, updated);
+	}
+
+	if(updated)
+	{
+		ANKI_TRACE_INC_COUNTER(SCENE_COMPONENTS_UPDATED, 1);
+		comp.setTimestamp(m_timestamp);
+		comp.m_updatedTimestamp = m_timestamp;
 
-		// Process nodes
-		for(U i = 0; i < batchSize && !err; ++i)
+		node.wakeUpFeedbackComponents(comp);
+		markNodeActive(node);
+	}
+
+	return err;
+}
+
+Error SceneGraph::updateNodes(UpdateSceneNodesCtx& ctx) const
+{
+	ANKI_TRACE_SCOPED_EVENT(SCENE_NODES_UPDATE);
+
+	Error err = Error::NONE;
+	U32 begin;
+	while(!err && (begin = ctx.m_crntNode.fetchAdd(NODE_UPDATE_BATCH)) < m_activeNodeCount)
+	{
+		const U32 end = min(m_activeNodeCount, begin + NODE_UPDATE_BATCH);
+		for(U32 i = begin; i < end && !err; ++i)
 		{
-			err = updateNode(ctx.m_prevUpdateTime, ctx.m_crntTime, *batch[i]);
+			err = updateNode(ctx.m_prevUpdateTime, ctx.m_crntTime, *m_activeNodes[i]);
 		}
 	}
 
 	return err;
 }
 
+void SceneGraph::addFrameUpdateNode(SceneNode& node)
+{
+	LockGuard<SpinLock> lock(m_frameUpdateNodesLock);
+	if(node.m_frameUpdateNodeIdx == MAX_U32)
+	{
+		node.m_frameUpdateNodeIdx = m_frameUpdateNodes.getSize();
+		m_frameUpdateNodes.emplaceBack(m_alloc, &node);
+	}
+}
+
+void SceneGraph::removeFrameUpdateNode(SceneNode& node)
+{
+	LockGuard<SpinLock> lock(m_frameUpdateNodesLock);
+	if(node.m_frameUpdateNodeIdx != MAX_U32)
+	{
+		// Swap with the last
+		SceneNode* last = m_frameUpdateNodes.getBack();
+		m_frameUpdateNodes[node.m_frameUpdateNodeIdx] = last;
+		last->m_frameUpdateNodeIdx = node.m_frameUpdateNodeIdx;
+		m_frameUpdateNodes.popBack(m_alloc);
+		node.m_frameUpdateNodeIdx = MAX_U32;
+	}
+}
+
+void SceneGraph::markNodeActive(SceneNode& node)
+{
+	if(node.m_activeTimestamp.exchange(m_timestamp) == m_timestamp)
+	{
+		// Already active
+		return;
+	}
+
+	LockGuard<SpinLock> lock(m_activeNodesLock);
+	if(m_activeNodeCount == m_activeNodes.getSize())
+	{
+		m_activeNodes.resize(m_alloc, max<U32>(64, m_activeNodes.getSize() * 2));
+	}
+	m_activeNodes[m_activeNodeCount++] = &node;
+}
+
 } // end namespace anki
@@ -7,9 +7,10 @@
 
 #include <AnKi/Scene/Common.h>
 #include <AnKi/Scene/SceneNode.h>
+#include <AnKi/Scene/SceneComponentPool.h>
 #include <AnKi/Scene/DebugDrawer.h>
 #include <AnKi/Math.h>
-#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/FlatHashMap.h>
 #include <AnKi/Core/App.h>
 #include <AnKi/Scene/Events/EventManager.h>
 #include <AnKi/Resource/Common.h>
@@ -24,6 +25,9 @@ class ConfigSet;
 class PerspectiveCameraNode;
 class Octree;
 class UiManager;
+class GpuSceneInstances;
+class TransformHierarchy;
+class SkinPoseCache;
 
 /// @addtogroup scene
 /// @{
@@ -35,6 +39,10 @@ public:
 	Second m_updateTime ANKI_DEBUG_CODE(= 0.0);
 	Second m_visibilityTestsTime ANKI_DEBUG_CODE(= 0.0);
 	Second m_physicsUpdate ANKI_DEBUG_CODE(= 0.0);
+	U32 m_nodeCount = 0;
+	U32 m_activeNodeCount = 0; ///< The nodes that had something to update in the last frame.
+	U32 m_componentCount = 0;
+	U32 m_activeComponentCount = 0; ///< The components that were awake in the last frame.
 };
 
 /// SceneGraph limits.
@@ -53,6 +61,7 @@ public:
 class SceneGraph
 {
 	friend class SceneNode;
+	friend class SceneComponent;
 	friend class UpdateSceneNodesTask;
 
 public:
@@ -229,6 +238,34 @@ public:
 		return *m_octree;
 	}
 
+	/// Get the CPU side of the GPU scene. It's nullptr if the r_gpuScene option is off.
+	GpuSceneInstances* getGpuSceneInstances()
+	{
+		return m_gpuSceneInstances;
+	}
+
+	/// Check if the node of a handle is alive and not marked for deletion.
+	/// @note It's thread-safe.
+	Bool isNodeHandleValid(SceneNodeHandle handle) const
+	{
+		ANKI_ASSERT(handle.m_slot != MAX_U32);
+		const Atomic<U32>& generation =
+			m_nodeHandleGenerations[handle.m_slot / NODE_HANDLES_PER_CHUNK][handle.m_slot % NODE_HANDLES_PER_CHUNK];
+		return generation.load() == handle.m_generation;
+	}
+
+	TransformHierarchy& getTransformHierarchy()
+	{
+		ANKI_ASSERT(m_transformHierarchy);
+		return *m_transformHierarchy;
+	}
+
+	SkinPoseCache& getSkinPoseCache()
+	{
+		ANKI_ASSERT(m_skinPoseCache);
+		return *m_skinPoseCache;
+	}
+
 	const DebugDrawer2& getDebugDrawer() const
 	{
 		return m_debugDrawer;
@@ -236,6 +273,7 @@ public:
 
 private:
 	class UpdateSceneNodesCtx;
+	class UpdateComponentsCtx;
 
 	const Timestamp* m_globalTimestamp = nullptr;
 	Timestamp m_timestamp = 0; ///< Cached timestamp
@@ -254,7 +292,9 @@ private:
 
 	IntrusiveList<SceneNode> m_nodes;
 	U32 m_nodesCount = 0;
-	HashMap<CString, SceneNode*> m_nodesDict;
+	/// The keys point to the names of the nodes. Don't intern the names since the nodes and their names come and go at
+	/// runtime.
+	FlatHashMap<CString, SceneNode*> m_nodesDict;
 
 	SceneNode* m_mainCam = nullptr;
 	Timestamp m_activeCameraChangeTimestamp = 0;
@@ -264,6 +304,11 @@ private:
 
 	Octree* m_octree = nullptr;
 
+	GpuSceneInstances* m_gpuSceneInstances = nullptr;
+
+	TransformHierarchy* m_transformHierarchy = nullptr;
+	SkinPoseCache* m_skinPoseCache = nullptr;
+
 	Vec3 m_sceneMin = Vec3(-1000.0f, -200.0f, -1000.0f);
 	Vec3 m_sceneMax = Vec3(1000.0f, 200.0f, 1000.0f);
 
@@ -276,6 +321,36 @@ private:
 
 	DebugDrawer2 m_debugDrawer;
 
+	/// @name Scene components
+	/// @{
+	Array<SceneComponentPool, MAX_SCENE_COMPONENT_CLASSES> m_componentPools;
+
+	Array<U8, MAX_SCENE_COMPONENT_CLASSES> m_componentUpdateOrder = {}; ///< The class IDs in the order of update.
+	/// @}
+
+	/// @name Node handles
+	/// @{
+	static constexpr U32 NODE_HANDLES_PER_CHUNK = 256;
+	static constexpr U32 MAX_NODE_HANDLE_CHUNKS = 4 * 1024;
+
+	/// The current generation of each slot. Fixed size to keep the chunk addresses stable without locking.
+	Array<Atomic<U32>*, MAX_NODE_HANDLE_CHUNKS> m_nodeHandleGenerations = {};
+	U32 m_nodeHandleChunkCount = 0;
+	DynamicArray<U32> m_freeNodeHandleSlots;
+	SpinLock m_nodeHandlesLock;
+	/// @}
+
+	/// @name Active nodes
+	/// @{
+	DynamicArray<SceneNode*> m_frameUpdateNodes; ///< Nodes that need SceneNode::frameUpdate() every frame.
+	SpinLock m_frameUpdateNodesLock;
+
+	/// The nodes that have something to update this frame. Only the first m_activeNodeCount are valid.
+	DynamicArray<SceneNode*> m_activeNodes;
+	U32 m_activeNodeCount = 0;
+	SpinLock m_activeNodesLock;
+	/// @}
+
 	/// Put a node in the appropriate containers
 	ANKI_USE_RESULT Error registerNode(SceneNode* node);
 	void unregisterNode(SceneNode* node);
@@ -283,9 +358,61 @@ private:
 	/// Delete the nodes that are marked for deletion
 	void deleteNodesMarkedForDeletion();
 
+	/// @note It's thread-safe.
+	SceneNodeHandle newNodeHandle();
+
+	/// Invalidate all the copies of a handle.
+	/// @note It's thread-safe.
+	void invalidateNodeHandle(SceneNodeHandle handle)
+	{
+		m_nodeHandleGenerations[handle.m_slot / NODE_HANDLES_PER_CHUNK][handle.m_slot % NODE_HANDLES_PER_CHUNK]
+			.fetchAdd(1);
+	}
+
+	/// Invalidate the handle and free its slot.
+	/// @note It's thread-safe.
+	void deleteNodeHandle(SceneNodeHandle handle);
+
 	ANKI_USE_RESULT Error updateNodes(UpdateSceneNodesCtx& ctx) const;
 	ANKI_USE_RESULT static Error updateNode(Second prevTime, Second crntTime, SceneNode& node);
 
+	SceneComponentPool& getComponentPool(U8 classId)
+	{
+		ANKI_ASSERT(classId < SceneComponent::getClassCount());
+		return m_componentPools[classId];
+	}
+
+	/// Sort the component classes using the update order they declare in their SceneComponentRtti. It fails if the
+	/// declarations form a cycle or name a class that doesn't exist.
+	ANKI_USE_RESULT Error computeComponentUpdateOrder();
+
+	/// Update all the components of a class. Components of nodes without parents are updated in parallel and the rest
+	/// are updated later from the parents to the children.
+	ANKI_USE_RESULT Error updateComponentsOfClass(U8 classId, Second prevTime, Second crntTime);
+
+	ANKI_USE_RESULT Error updateComponents(UpdateComponentsCtx& ctx);
+
+	/// Update some of the deferred components of the UpdateComponentsCtx. They all belong to the same hierarchy level.
+	ANKI_USE_RESULT Error updateDeferredComponents(UpdateComponentsCtx& ctx);
+
+	ANKI_USE_RESULT Error updateComponent(SceneComponent& comp, Second prevTime, Second crntTime);
+
+	/// @note It's thread-safe.
+	void setComponentActive(SceneComponent& comp, Bool active)
+	{
+		getComponentPool(comp.getClassId()).setComponentActive(comp.getPoolIndex(), active);
+	}
+
+	/// @note It's thread-safe.
+	void addFrameUpdateNode(SceneNode& node);
+
+	/// @note It's thread-safe.
+	void removeFrameUpdateNode(SceneNode& node);
+
+	/// Add a node to the nodes that will be updated this frame. It does nothing if it's already added.
+	/// @note It's thread-safe.
+	void markNodeActive(SceneNode& node);
+
 	/// Do visibility tests.
 	static void doVisibilityTests(SceneNode& frustumable, SceneGraph& scene, RenderQueue& rqueue);
 };
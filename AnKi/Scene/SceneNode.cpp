@@ -5,12 +5,14 @@
 
 #include <AnKi/Scene/SceneNode.h>
 #include <AnKi/Scene/SceneGraph.h>
+#include <AnKi/Scene/Components/MoveComponent.h>
 
 namespace anki {
 
 SceneNode::SceneNode(SceneGraph* scene, CString name)
 	: m_scene(scene)
 	, m_uuid(scene->getNewUuid())
+	, m_handle(scene->newNodeHandle())
 {
 	if(name)
 	{
@@ -22,12 +24,18 @@ SceneNode::~SceneNode()
 {
 	auto alloc = getAllocator();
 
+	setNeedsFrameUpdate(false);
+	m_scene->deleteNodeHandle(m_handle);
+
 	auto it = m_components.getBegin();
 	auto end = m_components.getEnd();
 	for(; it != end; ++it)
 	{
 		SceneComponent* comp = *it;
-		alloc.deleteInstance(comp);
+		const U8 classId = comp->getClassId();
+		const U32 poolIndex = comp->getPoolIndex();
+		comp->~SceneComponent();
+		m_scene->getComponentPool(classId).free(comp, poolIndex);
 	}
 
 	Base::destroy(alloc);
@@ -41,6 +49,7 @@ void SceneNode::setMarkedForDeletion()
 	if(!getMarkedForDeletion())
 	{
 		m_markedForDeletion = true;
+		m_scene->invalidateNodeHandle(m_handle);
 		m_scene->increaseObjectsMarkedForDeletion();
 	}
 
@@ -52,6 +61,20 @@ void SceneNode::setMarkedForDeletion()
 	(void)err;
 }
 
+void SceneNode::addChild(SceneNode* obj)
+{
+	Base::addChild(getAllocator(), obj);
+
+	// The depth of the child and its children changed. Update their transforms from the top to the bottom
+	const Error err = obj->visitThisAndChildren([](SceneNode& node) -> Error {
+		node.iterateComponentsOfType<MoveComponent>([](MoveComponent& movec) {
+			movec.updateParentTransform();
+		});
+		return Error::NONE;
+	});
+	(void)err;
+}
+
 Timestamp SceneNode::getGlobalTimestamp() const
 {
 	return m_scene->getGlobalTimestamp();
@@ -69,9 +92,69 @@ SceneFrameAllocator<U8> SceneNode::getFrameAllocator() const
 	return m_scene->getFrameAllocator();
 }
 
+void* SceneNode::allocateComponentMemory(U8 classId, U32& poolIndex)
+{
+	return m_scene->getComponentPool(classId).allocate(poolIndex);
+}
+
+void SceneNode::addComponent(SceneComponent* comp)
+{
+	ANKI_ASSERT(comp);
+	m_components.emplaceBack(getAllocator(), comp);
+}
+
 ResourceManager& SceneNode::getResourceManager()
 {
 	return m_scene->getResourceManager();
 }
 
+void SceneNode::setNeedsFrameUpdate(Bool needs)
+{
+	if(needs)
+	{
+		m_scene->addFrameUpdateNode(*this);
+	}
+	else
+	{
+		m_scene->removeFrameUpdateNode(*this);
+	}
+}
+
+Bool SceneNode::anyComponentUpdatedThisFrame(const SceneComponent* stopAt) const
+{
+	const Timestamp crntTimestamp = m_scene->getGlobalTimestamp();
+	for(const ComponentsArrayElement& el : m_components)
+	{
+		const SceneComponent* comp = el;
+		if(comp == stopAt)
+		{
+			break;
+		}
+		else if(comp->m_updatedTimestamp == crntTimestamp)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void SceneNode::wakeUpFeedbackComponents(const SceneComponent& comp)
+{
+	const Timestamp crntTimestamp = m_scene->getGlobalTimestamp();
+	Bool after = false;
+	for(ComponentsArrayElement& el : m_components)
+	{
+		if(after && el.isFeedbackComponent())
+		{
+			// Remember when it was woken up. If its class was already updated this frame it will run in the next one
+			el->m_wokenUpTimestamp = crntTimestamp;
+			el->setActive(true);
+		}
+		else if(el == &comp)
+		{
+			after = true;
+		}
+	}
+}
+
 } // end namespace anki
@@ -20,9 +20,29 @@ class ResourceManager;
 /// @addtogroup scene
 /// @{
 
+/// A weak reference to a SceneNode. It's a slot and a generation. The generation of the slot changes as soon as the
+/// node gets marked for deletion so checking a handle doesn't touch the node's memory.
+/// See SceneGraph::isNodeHandleValid.
+class SceneNodeHandle
+{
+	friend class SceneGraph;
+
+public:
+	U32 getSlot() const
+	{
+		return m_slot;
+	}
+
+private:
+	U32 m_slot = MAX_U32;
+	U32 m_generation = 0;
+};
+
 /// Interface class backbone of scene
 class SceneNode : public Hierarchy<SceneNode>, public IntrusiveListEnabled<SceneNode>
 {
+	friend class SceneGraph;
+
 public:
 	using Base = Hierarchy<SceneNode>;
 
@@ -66,6 +86,11 @@ public:
 		return m_markedForDeletion;
 	}
 
+	SceneNodeHandle getHandle() const
+	{
+		return m_handle;
+	}
+
 	void setMarkedForDeletion();
 
 	Timestamp getGlobalTimestamp() const;
@@ -85,12 +110,10 @@ public:
 
 	SceneFrameAllocator<U8> getFrameAllocator() const;
 
-	void addChild(SceneNode* obj)
-	{
-		Base::addChild(getAllocator(), obj);
-	}
+	void addChild(SceneNode* obj);
 
-	/// This is called by the scenegraph every frame after all component updates. By default it does nothing.
+	/// This is called by the scenegraph after all component updates on the frames that some of the node's components
+	/// got updated. Nodes that want it every frame should call setNeedsFrameUpdate(). By default it does nothing.
 	/// @param prevUpdateTime Timestamp of the previous update
 	/// @param crntTime Timestamp of this update
 	virtual ANKI_USE_RESULT Error frameUpdate(Second prevUpdateTime, Second crntTime)
@@ -278,17 +301,25 @@ public:
 	}
 
 protected:
-	/// Create and append a component to the components container. The SceneNode has the ownership.
+	/// Create and append a component to the components container. The SceneNode has the ownership. The memory of the
+	/// component comes from the SceneComponentPool of its class.
 	template<typename TComponent>
 	TComponent* newComponent()
 	{
-		TComponent* comp = getAllocator().newInstance<TComponent>(this);
-		m_components.emplaceBack(getAllocator(), comp);
+		U32 poolIndex;
+		void* mem = allocateComponentMemory(TComponent::getStaticClassId(), poolIndex);
+		TComponent* comp = ::new(mem) TComponent(this);
+		comp->m_poolIndex = poolIndex;
+		addComponent(comp);
 		return comp;
 	}
 
 	ResourceManager& getResourceManager();
 
+	/// Nodes that need frameUpdate() every frame, even if none of their components got updated, should set that.
+	/// @note It's thread-safe.
+	void setNeedsFrameUpdate(Bool needs);
+
 private:
 	/// This class packs a pointer to a SceneComponent and its type at the same 64bit value. Used to avoid cache misses
 	/// when iterating the m_components.
@@ -366,12 +397,27 @@ private:
 	SceneGraph* m_scene = nullptr;
 	U64 m_uuid;
 	String m_name; ///< A unique name.
+	SceneNodeHandle m_handle;
 
 	DynamicArray<ComponentsArrayElement> m_components;
 
 	Timestamp m_maxComponentTimestamp = 0;
 
+	Atomic<Timestamp> m_activeTimestamp = {0}; ///< The last frame the node had something to update.
+	U32 m_frameUpdateNodeIdx = MAX_U32; ///< Where the node is in SceneGraph::m_frameUpdateNodes.
+
 	Bool m_markedForDeletion = false;
+
+	void* allocateComponentMemory(U8 classId, U32& poolIndex);
+
+	void addComponent(SceneComponent* comp);
+
+	/// Check if any of the components that come before @a stopAt got updated this frame.
+	/// @param stopAt If it's nullptr check all components.
+	Bool anyComponentUpdatedThisFrame(const SceneComponent* stopAt) const;
+
+	/// Wake up the feedback components that come after @a comp because they have to react to its update.
+	void wakeUpFeedbackComponents(const SceneComponent& comp);
 };
 /// @}
 
@@ -0,0 +1,95 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/SkinPoseCache.h>
+#include <AnKi/Util/Hash.h>
+
+namespace anki {
+
+constexpr U32 INITIAL_SKIN_POSE_CACHE_SIZE = 64;
+
+SkinPoseCache::~SkinPoseCache()
+{
+	m_entries.destroy(m_alloc);
+}
+
+void SkinPoseCache::newFrame()
+{
+	++m_frame;
+	m_entryCount = 0;
+}
+
+Bool SkinPoseCache::tryGetPose(const SkinPoseKey& key, SkinPose& pose, Bool& storePose)
+{
+	const U64 hash = computeHash(&key, sizeof(key));
+	LockGuard<SpinLock> lock(m_lock);
+
+	if((m_entryCount + 1) * 2 > m_entries.getSize())
+	{
+		grow();
+	}
+
+	Entry& entry = findEntry(key, hash);
+	if(entry.m_frame != m_frame)
+	{
+		// Not found, the caller will compute it
+		entry.m_key = key;
+		entry.m_frame = m_frame;
+		entry.m_poseStored = false;
+		++m_entryCount;
+		storePose = true;
+		return false;
+	}
+
+	// Found. It might not be stored yet if some other thread is still computing it
+	storePose = false;
+	if(entry.m_poseStored)
+	{
+		pose = entry.m_pose;
+	}
+
+	return entry.m_poseStored;
+}
+
+void SkinPoseCache::storePose(const SkinPoseKey& key, const SkinPose& pose)
+{
+	const U64 hash = computeHash(&key, sizeof(key));
+	LockGuard<SpinLock> lock(m_lock);
+
+	Entry& entry = findEntry(key, hash);
+	ANKI_ASSERT(entry.m_frame == m_frame && !entry.m_poseStored && "Should have called tryGetPose()");
+	entry.m_pose = pose;
+	entry.m_poseStored = true;
+}
+
+SkinPoseCache::Entry& SkinPoseCache::findEntry(const SkinPoseKey& key, U64 hash)
+{
+	const U32 mask = m_entries.getSize() - 1;
+	U32 idx = U32(hash) & mask;
+	while(m_entries[idx].m_frame == m_frame && !(m_entries[idx].m_key == key))
+	{
+		idx = (idx + 1) & mask;
+	}
+
+	return m_entries[idx];
+}
+
+void SkinPoseCache::grow()
+{
+	DynamicArray<Entry> oldEntries = std::move(m_entries);
+	m_entries.create(m_alloc, max(INITIAL_SKIN_POSE_CACHE_SIZE, oldEntries.getSize() * 2));
+
+	for(const Entry& oldEntry : oldEntries)
+	{
+		if(oldEntry.m_frame == m_frame)
+		{
+			findEntry(oldEntry.m_key, computeHash(&oldEntry.m_key, sizeof(oldEntry.m_key))) = oldEntry;
+		}
+	}
+
+	oldEntries.destroy(m_alloc);
+}
+
+} // end namespace anki
@@ -0,0 +1,116 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Collision/Aabb.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Thread.h>
+
+namespace anki {
+
+/// @addtogroup scene
+/// @{
+
+/// Everything that the bone transforms of a SkinComponent depend on. Two skins with the same key have the same pose.
+/// @memberof SkinPoseCache
+class SkinPoseKey
+{
+public:
+	static constexpr U32 MAX_TRACKS = 4;
+
+	class Track
+	{
+	public:
+		const void* m_animation;
+		Second m_time;
+		Second m_blendInTime;
+		Second m_blendOutTime;
+		Second m_duration;
+	};
+
+	const void* m_skeleton;
+	Array<Track, MAX_TRACKS> m_tracks;
+	U32 m_trackCount;
+	U32 m_padding; ///< The key is hashed and compared as raw memory so avoid implicit padding.
+
+	SkinPoseKey()
+	{
+		zeroMemory(*this);
+	}
+
+	Bool operator==(const SkinPoseKey& b) const
+	{
+		return memcmp(this, &b, sizeof(*this)) == 0;
+	}
+};
+
+static_assert(sizeof(SkinPoseKey) == sizeof(void*) * 2 + sizeof(SkinPoseKey::Track) * SkinPoseKey::MAX_TRACKS,
+			  "Shouldn't have implicit padding");
+
+/// The output of the skinning.
+/// @memberof SkinPoseCache
+class SkinPose
+{
+public:
+	ConstWeakArray<Mat4> m_boneTransforms;
+	Aabb m_boneBoundingVolume;
+};
+
+/// Remembers the poses that were computed in the current frame so instances that play the same animations at the same
+/// time compute their pose once.
+class SkinPoseCache
+{
+public:
+	SkinPoseCache(SceneAllocator<U8> alloc)
+		: m_alloc(alloc)
+	{
+	}
+
+	SkinPoseCache(const SkinPoseCache&) = delete; // Non-copyable
+
+	~SkinPoseCache();
+
+	SkinPoseCache& operator=(const SkinPoseCache&) = delete; // Non-copyable
+
+	/// Forget the poses of the previous frame.
+	void newFrame();
+
+	/// Find a pose that was computed this frame.
+	/// @param[out] pose The pose if it's found.
+	/// @param[out] storePose If true the pose wasn't found and the caller should compute it and call storePose().
+	/// @return True if the pose was found.
+	/// @note It's thread-safe.
+	Bool tryGetPose(const SkinPoseKey& key, SkinPose& pose, Bool& storePose);
+
+	/// Store a pose. The memory of the bone transforms should stay valid until the end of the frame.
+	/// @note It's thread-safe.
+	void storePose(const SkinPoseKey& key, const SkinPose& pose);
+
+private:
+	class Entry
+	{
+	public:
+		SkinPoseKey m_key;
+		SkinPose m_pose;
+		U64 m_frame = 0; ///< The entry is empty if it's not from this frame.
+		Bool m_poseStored = false;
+	};
+
+	SceneAllocator<U8> m_alloc;
+	DynamicArray<Entry> m_entries; ///< Open addressing with linear probing. The size is a power of 2.
+	U32 m_entryCount = 0;
+	U64 m_frame = 1;
+	SpinLock m_lock;
+
+	Entry& findEntry(const SkinPoseKey& key, U64 hash);
+
+	void grow();
+};
+/// @}
+
+} // end namespace anki
@@ -0,0 +1,244 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Scene/TransformHierarchy.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/Tracer.h>
+
+namespace anki {
+
+/// Levels with less transforms than that are updated serially.
+constexpr U32 TRANSFORMS_PER_UPDATE_TASK = 1024;
+
+class TransformHierarchy::UpdateCtx
+{
+public:
+	TransformHierarchy* m_self = nullptr;
+	ConstWeakArray<U32> m_level;
+	Atomic<U32> m_crntTransform = {0};
+};
+
+TransformHierarchy::~TransformHierarchy()
+{
+	for(U32 i = 0; i < m_chunkCount; ++i)
+	{
+		m_alloc.deleteInstance(m_chunks[i]);
+	}
+
+	for(DynamicArray<U32>& level : m_levels)
+	{
+		level.destroy(m_alloc);
+	}
+	m_levels.destroy(m_alloc);
+	m_freeTransforms.destroy(m_alloc);
+}
+
+U32 TransformHierarchy::newTransform(void* userData)
+{
+	LockGuard<Mutex> lock(m_mtx);
+
+	if(m_freeTransforms.getSize() == 0)
+	{
+		if(ANKI_UNLIKELY(m_chunkCount == MAX_CHUNKS))
+		{
+			ANKI_SCENE_LOGF("Reached the max number of transforms");
+		}
+
+		m_chunks[m_chunkCount] = m_alloc.newInstance<Chunk>();
+
+		// Push them in reverse to allocate the 1st transform of the chunk first
+		for(U32 i = TRANSFORMS_PER_CHUNK; i > 0; --i)
+		{
+			m_freeTransforms.emplaceBack(m_alloc, m_chunkCount * TRANSFORMS_PER_CHUNK + i - 1);
+		}
+
+		++m_chunkCount;
+	}
+
+	const U32 idx = m_freeTransforms.getBack();
+	m_freeTransforms.popBack(m_alloc);
+
+	Chunk& chunk = *m_chunks[idx / TRANSFORMS_PER_CHUNK];
+	const U32 slot = idx % TRANSFORMS_PER_CHUNK;
+	chunk.m_aliveMask |= getMask(idx);
+	chunk.m_localTransforms[slot] = Transform::getIdentity();
+	chunk.m_worldTransforms[slot] = Transform::getIdentity();
+	chunk.m_prevWorldTransforms[slot] = Transform::getIdentity();
+	chunk.m_userData[slot] = userData;
+	chunk.m_parents[slot] = MAX_U32;
+	chunk.m_flags[slot] = 0;
+	chunk.m_dirtyMask.fetchOr(getMask(idx));
+	chunk.m_updatedMask.fetchAnd(~getMask(idx));
+
+	addToLevel(idx, 0);
+	++m_transformCount;
+
+	return idx;
+}
+
+void TransformHierarchy::deleteTransform(U32 idx)
+{
+	LockGuard<Mutex> lock(m_mtx);
+
+	removeFromLevel(idx);
+
+	Chunk& chunk = getChunk(idx);
+	chunk.m_aliveMask &= ~getMask(idx);
+	chunk.m_dirtyMask.fetchAnd(~getMask(idx));
+	chunk.m_updatedMask.fetchAnd(~getMask(idx));
+
+	m_freeTransforms.emplaceBack(m_alloc, idx);
+	ANKI_ASSERT(m_transformCount > 0);
+	--m_transformCount;
+}
+
+void TransformHierarchy::setParent(U32 idx, U32 parentIdx)
+{
+	ANKI_ASSERT(idx != parentIdx);
+	LockGuard<Mutex> lock(m_mtx);
+
+	Chunk& chunk = getChunk(idx);
+	const U32 slot = idx % TRANSFORMS_PER_CHUNK;
+	const U32 depth = (parentIdx != MAX_U32) ? getChunk(parentIdx).m_depths[parentIdx % TRANSFORMS_PER_CHUNK] + 1 : 0;
+
+	chunk.m_parents[slot] = parentIdx;
+	chunk.m_dirtyMask.fetchOr(getMask(idx));
+
+	if(depth != chunk.m_depths[slot])
+	{
+		removeFromLevel(idx);
+		addToLevel(idx, depth);
+	}
+}
+
+void TransformHierarchy::addToLevel(U32 idx, U32 depth)
+{
+	if(ANKI_UNLIKELY(depth > MAX_DEPTH))
+	{
+		ANKI_SCENE_LOGF("The transform hierarchy is too deep");
+	}
+
+	while(depth >= m_levels.getSize())
+	{
+		m_levels.emplaceBack(m_alloc);
+	}
+
+	Chunk& chunk = getChunk(idx);
+	const U32 slot = idx % TRANSFORMS_PER_CHUNK;
+	chunk.m_depths[slot] = U8(depth);
+	chunk.m_levelPositions[slot] = m_levels[depth].getSize();
+	m_levels[depth].emplaceBack(m_alloc, idx);
+}
+
+void TransformHierarchy::removeFromLevel(U32 idx)
+{
+	const Chunk& chunk = getChunk(idx);
+	const U32 slot = idx % TRANSFORMS_PER_CHUNK;
+	DynamicArray<U32>& level = m_levels[chunk.m_depths[slot]];
+	const U32 pos = chunk.m_levelPositions[slot];
+	ANKI_ASSERT(level[pos] == idx);
+
+	// Swap with the last
+	const U32 lastIdx = level.getBack();
+	level[pos] = lastIdx;
+	getChunk(lastIdx).m_levelPositions[lastIdx % TRANSFORMS_PER_CHUNK] = pos;
+	level.popBack(m_alloc);
+}
+
+void TransformHierarchy::update(ThreadHive* hive)
+{
+	ANKI_TRACE_SCOPED_EVENT(SCENE_TRANSFORMS_UPDATE);
+
+	// The transforms that changed in the previous frame have a stale previous transform
+	for(U32 i = 0; i < m_chunkCount; ++i)
+	{
+		Chunk& chunk = *m_chunks[i];
+		U64 updatedMask = chunk.m_updatedMask.exchange(0);
+		while(updatedMask)
+		{
+			const U32 slot = U32(__builtin_ctzll(updatedMask));
+			updatedMask &= updatedMask - 1;
+			chunk.m_prevWorldTransforms[slot] = chunk.m_worldTransforms[slot];
+		}
+	}
+
+	// Update from the top to the bottom. The children of a level depend on it so the levels are processed in order
+	for(const DynamicArray<U32>& level : m_levels)
+	{
+		const U32 taskCount = (hive) ? min(hive->getThreadCount(), level.getSize() / TRANSFORMS_PER_UPDATE_TASK) : 0;
+		if(taskCount <= 1)
+		{
+			updateLevelRange(level);
+			continue;
+		}
+
+		UpdateCtx ctx;
+		ctx.m_self = this;
+		ctx.m_level = level;
+
+		Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+		for(U32 i = 0; i < taskCount; ++i)
+		{
+			tasks[i] = ANKI_THREAD_HIVE_TASK(
+				{
+					const U32 count = self->m_level.getSize();
+					U32 begin;
+					while((begin = self->m_crntTransform.fetchAdd(TRANSFORMS_PER_UPDATE_TASK)) < count)
+					{
+						const U32 end = min(count, begin + TRANSFORMS_PER_UPDATE_TASK);
+						self->m_self->updateLevelRange(
+							ConstWeakArray<U32>(&self->m_level[begin], end - begin));
+					}
+				},
+				&ctx, nullptr, nullptr);
+		}
+
+		hive->submitTasks(&tasks[0], taskCount);
+		hive->waitAllTasks();
+	}
+}
+
+void TransformHierarchy::updateLevelRange(ConstWeakArray<U32> transforms)
+{
+	U32 updatedCount = 0;
+
+	for(const U32 idx : transforms)
+	{
+		Chunk& chunk = *m_chunks[idx / TRANSFORMS_PER_CHUNK];
+		const U32 slot = idx % TRANSFORMS_PER_CHUNK;
+		const U64 mask = getMask(idx);
+		const U32 parentIdx = chunk.m_parents[slot];
+
+		// Needs update if it's dirty or if the parent changed
+		const Chunk* parentChunk = (parentIdx != MAX_U32) ? m_chunks[parentIdx / TRANSFORMS_PER_CHUNK] : nullptr;
+		const Bool parentUpdated = parentChunk && (parentChunk->m_updatedMask.load() & getMask(parentIdx));
+		if(!parentUpdated && !(chunk.m_dirtyMask.load() & mask))
+		{
+			continue;
+		}
+
+		chunk.m_dirtyMask.fetchAnd(~mask);
+
+		const U8 flags = chunk.m_flags[slot];
+		const Transform& local = chunk.m_localTransforms[slot];
+		Transform& world = chunk.m_worldTransforms[slot];
+		if(parentChunk == nullptr || (flags & FLAG_IGNORE_PARENT))
+		{
+			world = local;
+		}
+		else
+		{
+			const Transform& parentWorld = parentChunk->m_worldTransforms[parentIdx % TRANSFORMS_PER_CHUNK];
+			world = (flags & FLAG_IGNORE_LOCAL) ? parentWorld : parentWorld.combineTransformations(local);
+		}
+
+		chunk.m_updatedMask.fetchOr(mask);
+		++updatedCount;
+	}
+
+	ANKI_TRACE_INC_COUNTER(SCENE_TRANSFORMS_UPDATED, updatedCount);
+}
+
+} // end namespace anki
@@ -0,0 +1,205 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Scene/Common.h>
+#include <AnKi/Math.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Thread.h>
+
+namespace anki {
+
+// Forward
+class ThreadHive;
+
+/// @addtogroup scene
+/// @{
+
+/// Holds the local, world and previous world transforms of all the movable objects of the scene. The transforms are
+/// stored in chunks of structures of arrays and they are grouped by their depth in the hierarchy. update() computes the
+/// world transforms one level at a time so the transforms of the same level can be computed in parallel.
+class TransformHierarchy
+{
+public:
+	static constexpr U32 TRANSFORMS_PER_CHUNK = 64;
+	static constexpr U32 MAX_CHUNKS = 16 * 1024;
+	static constexpr U32 MAX_DEPTH = 255;
+
+	TransformHierarchy(SceneAllocator<U8> alloc)
+		: m_alloc(alloc)
+	{
+	}
+
+	TransformHierarchy(const TransformHierarchy&) = delete; // Non-copyable
+
+	~TransformHierarchy();
+
+	TransformHierarchy& operator=(const TransformHierarchy&) = delete; // Non-copyable
+
+	/// Allocate a new transform. It starts as an identity without a parent and it's marked for update.
+	/// @param userData Something to pass to iterateUpdatedTransforms().
+	/// @note It's thread-safe against the other newTransform, deleteTransform and setParent.
+	U32 newTransform(void* userData = nullptr);
+
+	/// @note It's thread-safe against the other newTransform, deleteTransform and setParent.
+	void deleteTransform(U32 idx);
+
+	/// Set the parent of a transform. It doesn't update the depth of the children of @a idx so the caller should call
+	/// it for the children as well, from the top of the hierarchy to the bottom.
+	/// @param parentIdx The parent transform or MAX_U32 for none.
+	/// @note It's thread-safe against the other newTransform, deleteTransform and setParent.
+	void setParent(U32 idx, U32 parentIdx);
+
+	const Transform& getLocalTransform(U32 idx) const
+	{
+		return getChunk(idx).m_localTransforms[idx % TRANSFORMS_PER_CHUNK];
+	}
+
+	/// Get the local transform in order to change it. It marks the transform for update.
+	/// @note It's thread-safe as long as no other thread changes the same transform.
+	Transform& getLocalTransformForUpdate(U32 idx)
+	{
+		markForUpdate(idx);
+		return getChunk(idx).m_localTransforms[idx % TRANSFORMS_PER_CHUNK];
+	}
+
+	const Transform& getWorldTransform(U32 idx) const
+	{
+		return getChunk(idx).m_worldTransforms[idx % TRANSFORMS_PER_CHUNK];
+	}
+
+	/// The world transform of the previous frame. Useful for motion vectors.
+	const Transform& getPreviousWorldTransform(U32 idx) const
+	{
+		return getChunk(idx).m_prevWorldTransforms[idx % TRANSFORMS_PER_CHUNK];
+	}
+
+	void setIgnoreLocalTransform(U32 idx, Bool ignore)
+	{
+		setFlag(idx, FLAG_IGNORE_LOCAL, ignore);
+	}
+
+	void setIgnoreParentTransform(U32 idx, Bool ignore)
+	{
+		setFlag(idx, FLAG_IGNORE_PARENT, ignore);
+	}
+
+	/// Check if the world transform changed in the last update().
+	Bool getUpdatedThisFrame(U32 idx) const
+	{
+		return (getChunk(idx).m_updatedMask.load() & getMask(idx)) != 0;
+	}
+
+	/// Compute the world transforms that need update.
+	/// @param hive If it's not nullptr it will be used to update the big levels in parallel.
+	void update(ThreadHive* hive);
+
+	/// Iterate the transforms that changed in the last update().
+	/// @param func A functor with signature void(U32 idx, void* userData).
+	template<typename TFunc>
+	void iterateUpdatedTransforms(TFunc func) const
+	{
+		for(U32 i = 0; i < m_chunkCount; ++i)
+		{
+			const Chunk& chunk = *m_chunks[i];
+			U64 updatedMask = chunk.m_updatedMask.load();
+			while(updatedMask)
+			{
+				const U32 slot = U32(__builtin_ctzll(updatedMask));
+				updatedMask &= updatedMask - 1;
+				func(i * TRANSFORMS_PER_CHUNK + slot, chunk.m_userData[slot]);
+			}
+		}
+	}
+
+	U32 getTransformCount() const
+	{
+		return m_transformCount;
+	}
+
+	U32 getDepthCount() const
+	{
+		return m_levels.getSize();
+	}
+
+private:
+	enum : U8
+	{
+		FLAG_IGNORE_LOCAL = 1 << 0,
+		FLAG_IGNORE_PARENT = 1 << 1
+	};
+
+	class Chunk
+	{
+	public:
+		Array<Transform, TRANSFORMS_PER_CHUNK> m_localTransforms;
+		Array<Transform, TRANSFORMS_PER_CHUNK> m_worldTransforms;
+		Array<Transform, TRANSFORMS_PER_CHUNK> m_prevWorldTransforms;
+		Array<void*, TRANSFORMS_PER_CHUNK> m_userData;
+		Array<U32, TRANSFORMS_PER_CHUNK> m_parents;
+		Array<U32, TRANSFORMS_PER_CHUNK> m_levelPositions; ///< Where the transform is in its level.
+		Array<U8, TRANSFORMS_PER_CHUNK> m_depths;
+		Array<U8, TRANSFORMS_PER_CHUNK> m_flags;
+		Atomic<U64> m_dirtyMask = {0}; ///< The transforms that need update.
+		Atomic<U64> m_updatedMask = {0}; ///< The transforms whose world transform changed in the last update.
+		U64 m_aliveMask = 0;
+	};
+
+	class UpdateCtx;
+
+	SceneAllocator<U8> m_alloc;
+
+	Array<Chunk*, MAX_CHUNKS> m_chunks = {}; ///< Fixed size to keep the chunk addresses stable without locking.
+	U32 m_chunkCount = 0;
+	DynamicArray<U32> m_freeTransforms;
+	U32 m_transformCount = 0;
+
+	/// The transforms of each depth. The 1st level has the transforms without parents.
+	DynamicArray<DynamicArray<U32>> m_levels;
+
+	Mutex m_mtx;
+
+	Chunk& getChunk(U32 idx)
+	{
+		ANKI_ASSERT(idx / TRANSFORMS_PER_CHUNK < m_chunkCount);
+		ANKI_ASSERT(m_chunks[idx / TRANSFORMS_PER_CHUNK]->m_aliveMask & getMask(idx));
+		return *m_chunks[idx / TRANSFORMS_PER_CHUNK];
+	}
+
+	const Chunk& getChunk(U32 idx) const
+	{
+		ANKI_ASSERT(idx / TRANSFORMS_PER_CHUNK < m_chunkCount);
+		ANKI_ASSERT(m_chunks[idx / TRANSFORMS_PER_CHUNK]->m_aliveMask & getMask(idx));
+		return *m_chunks[idx / TRANSFORMS_PER_CHUNK];
+	}
+
+	static U64 getMask(U32 idx)
+	{
+		return U64(1) << U64(idx % TRANSFORMS_PER_CHUNK);
+	}
+
+	void markForUpdate(U32 idx)
+	{
+		getChunk(idx).m_dirtyMask.fetchOr(getMask(idx));
+	}
+
+	void setFlag(U32 idx, U8 flag, Bool set)
+	{
+		U8& flags = getChunk(idx).m_flags[idx % TRANSFORMS_PER_CHUNK];
+		flags = (set) ? (flags | flag) : (flags & ~flag);
+		markForUpdate(idx);
+	}
+
+	void addToLevel(U32 idx, U32 depth);
+	void removeFromLevel(U32 idx);
+
+	/// Update a range of transforms of a level.
+	void updateLevelRange(ConstWeakArray<U32> transforms);
+};
+/// @}
+
+} // end namespace anki
@@ -159,7 +159,7 @@ void VisibilityContext::submitNewWork(const FrustumComponent& frc, const Frustum
 	// Combind results task
 	ANKI_ASSERT(frcCtx->m_visTestsSignalSem);
 	ThreadHiveTask combineTask = ANKI_THREAD_HIVE_TASK(
-		{ self->combine(); }, alloc.newInstance<CombineResultsTask>(frcCtx), frcCtx->m_visTestsSignalSem, nullptr);
+		{ self->combine(hive); }, alloc.newInstance<CombineResultsTask>(frcCtx), frcCtx->m_visTestsSignalSem, nullptr);
 	hive.submitTasks(&combineTask, 1);
 }
 
@@ -264,6 +264,12 @@ void VisibilityTestTask::test(ThreadHive& hive, U32 taskId)
 
 	Timestamp& timestamp = m_frcCtx->m_queueViews[taskId].m_timestamp;
 	timestamp = testedNode.getComponentMaxTimestamp();
+	Timestamp& staticTimestamp = m_frcCtx->m_queueViews[taskId].m_staticTimestamp;
+	staticTimestamp = timestamp;
+	U64& staticHash = m_frcCtx->m_queueViews[taskId].m_staticHash;
+	staticHash = 0;
+
+	const Bool isShadowFrustum = !!(enabledVisibilityTests & FrustumComponentVisibilityTestFlag::SHADOW_CASTERS);
 
 	const Bool wantsEarlyZ = !!(enabledVisibilityTests & FrustumComponentVisibilityTestFlag::EARLY_Z)
 							 && m_frcCtx->m_visCtx->m_earlyZDist > 0.0f;
@@ -350,12 +356,18 @@ void VisibilityTestTask::test(ThreadHive& hive, U32 taskId)
 		WeakArray<RenderQueue> nextQueues;
 		WeakArray<FrustumComponent> nextQueueFrustumComponents; // Optional
 
+		const Bool staticShadowCaster = isShadowFrustum && spatialc->getStatic();
+
 		node.iterateComponentsOfType<RenderComponent>([&](const RenderComponent& rc) {
 			RenderableQueueElement* el;
 			if(!!(rc.getFlags() & RenderComponentFlag::FORWARD_SHADING))
 			{
 				el = result.m_forwardShadingRenderables.newElement(alloc);
 			}
+			else if(staticShadowCaster)
+			{
+				el = result.m_staticShadowRenderables.newElement(alloc);
+			}
 			else
 			{
 				el = result.m_renderables.newElement(alloc);
@@ -619,10 +631,17 @@ void VisibilityTestTask::test(ThreadHive& hive, U32 taskId)
 
 		// Update timestamp
 		timestamp = max(timestamp, node.getComponentMaxTimestamp());
+		if(staticShadowCaster)
+		{
+			staticTimestamp = max(staticTimestamp, node.getComponentMaxTimestamp());
+
+			const U64 uuid = node.getUuid();
+			staticHash += computeHash(&uuid, sizeof(uuid));
+		}
 	} // end for
 }
 
-void CombineResultsTask::combine()
+void CombineResultsTask::combine(ThreadHive& hive)
 {
 	ANKI_TRACE_SCOPED_EVENT(SCENE_VIS_COMBINE_RESULTS);
 
@@ -632,13 +651,33 @@ void CombineResultsTask::combine()
 	// Compute the timestamp
 	const U32 threadCount = m_frcCtx->m_queueViews.getSize();
 	results.m_shadowRenderablesLastUpdateTimestamp = 0;
+	results.m_staticShadowRenderablesLastUpdateTimestamp = 0;
+	results.m_staticShadowRenderablesHash = 0;
+	results.m_staticShadowRenderableCount = 0;
 	for(U32 i = 0; i < threadCount; ++i)
 	{
 		results.m_shadowRenderablesLastUpdateTimestamp =
 			max(results.m_shadowRenderablesLastUpdateTimestamp, m_frcCtx->m_queueViews[i].m_timestamp);
+		results.m_staticShadowRenderablesLastUpdateTimestamp =
+			max(results.m_staticShadowRenderablesLastUpdateTimestamp, m_frcCtx->m_queueViews[i].m_staticTimestamp);
+		results.m_staticShadowRenderablesHash += m_frcCtx->m_queueViews[i].m_staticHash;
+		results.m_staticShadowRenderableCount += m_frcCtx->m_queueViews[i].m_staticShadowRenderables.m_elementCount;
 	}
 	ANKI_ASSERT(results.m_shadowRenderablesLastUpdateTimestamp);
 
+	// Combine the per-thread storages. The elements of firstMember_ go first
+#define ANKI_VIS_COMBINE2(t_, firstMember_, member_) \
+	{ \
+		Array<TRenderQueueElementStorage<t_>, 64 * 2> subStorages; \
+		for(U32 i = 0; i < threadCount; ++i) \
+		{ \
+			subStorages[i] = m_frcCtx->m_queueViews[i].firstMember_; \
+			subStorages[threadCount + i] = m_frcCtx->m_queueViews[i].member_; \
+		} \
+		combineQueueElements<t_>(alloc, WeakArray<TRenderQueueElementStorage<t_>>(&subStorages[0], threadCount * 2), \
+								 nullptr, results.member_, nullptr, true); \
+	}
+
 #define ANKI_VIS_COMBINE(t_, member_) \
 	{ \
 		Array<TRenderQueueElementStorage<t_>, 64> subStorages; \
@@ -650,7 +689,8 @@ void CombineResultsTask::combine()
 								 nullptr, results.member_, nullptr); \
 	}
 
-	ANKI_VIS_COMBINE(RenderableQueueElement, m_renderables);
+	// The static shadow casters go first so the renderer can draw them separately
+	ANKI_VIS_COMBINE2(RenderableQueueElement, m_staticShadowRenderables, m_renderables);
 	ANKI_VIS_COMBINE(RenderableQueueElement, m_earlyZRenderables);
 	ANKI_VIS_COMBINE(RenderableQueueElement, m_forwardShadingRenderables);
 	ANKI_VIS_COMBINE(PointLightQueueElement, m_pointLights);
@@ -673,6 +713,7 @@ void CombineResultsTask::combine()
 	}
 
 #undef ANKI_VIS_COMBINE
+#undef ANKI_VIS_COMBINE2
 
 	const Bool isShadowFrustum =
 		!!(m_frcCtx->m_frc->getEnabledVisibilityTests() & FrustumComponentVisibilityTestFlag::SHADOW_CASTERS);
@@ -680,13 +721,9 @@ void CombineResultsTask::combine()
 	// Sort some of the arrays
 	if(!isShadowFrustum)
 	{
-		std::sort(results.m_renderables.getBegin(), results.m_renderables.getEnd(), MaterialDistanceSortFunctor());
-
-		std::sort(results.m_earlyZRenderables.getBegin(), results.m_earlyZRenderables.getEnd(),
-				  DistanceSortFunctor<RenderableQueueElement>());
-
-		std::sort(results.m_forwardShadingRenderables.getBegin(), results.m_forwardShadingRenderables.getEnd(),
-				  RevDistanceSortFunctor<RenderableQueueElement>());
+		sortRenderables(results.m_renderables, computeStateSortKey, hive);
+		sortRenderables(results.m_earlyZRenderables, computeFrontToBackSortKey, hive);
+		sortRenderables(results.m_forwardShadingRenderables, computeBackToFrontSortKey, hive);
 	}
 
 	std::sort(results.m_giProbes.getBegin(), results.m_giProbes.getEnd());
@@ -723,11 +760,101 @@ void CombineResultsTask::combine()
 	}
 }
 
+void CombineResultsTask::sortRenderables(WeakArray<RenderableQueueElement> elements,
+										 ComputeRenderableSortKeyCallback computeKey, ThreadHive& hive)
+{
+	const U32 count = elements.getSize();
+	if(count < 2)
+	{
+		return;
+	}
+
+	ANKI_TRACE_SCOPED_EVENT(SCENE_VIS_SORT);
+	ANKI_TRACE_INC_COUNTER(SCENE_VIS_SORTED_RENDERABLES, count);
+
+	auto alloc = m_frcCtx->m_visCtx->m_scene->getFrameAllocator();
+
+	// Compute the keys
+	WeakArray<RadixSortPair> pairs(alloc.newArray<RadixSortPair>(count), count);
+	WeakArray<RadixSortPair> tmpPairs(alloc.newArray<RadixSortPair>(count), count);
+	for(U32 i = 0; i < count; ++i)
+	{
+		pairs[i].m_key = computeKey(elements[i]);
+		pairs[i].m_value = i;
+	}
+
+	RenderableQueueElement* unsortedElements = alloc.newArray<RenderableQueueElement>(count);
+	memcpy(unsortedElements, &elements[0], elements.getSizeInBytes());
+
+	if(count < PARALLEL_SORT_THRESHOLD || hive.getThreadCount() == 1)
+	{
+		SortRenderablesTask task;
+		task.m_pairs = pairs;
+		task.m_tmpPairs = tmpPairs;
+		task.m_unsortedElements = unsortedElements;
+		task.m_sortedElements = &elements[0];
+		task.sort();
+		return;
+	}
+
+	// Partition on the most significant byte and then sort the buckets in parallel. No need to wait for the tasks,
+	// doVisibilityTests() waits for everything
+	Array<U32, RADIX_SORT_BUCKET_COUNT + 1> bucketOffsets;
+	radixSortPartition(pairs, tmpPairs, bucketOffsets);
+
+	const U32 pairsPerTask = (count + hive.getThreadCount() - 1) / hive.getThreadCount();
+	Array<ThreadHiveTask, ThreadHive::MAX_THREADS + 1> tasks;
+	U32 taskCount = 0;
+	U32 firstBucket = 0;
+	while(firstBucket < RADIX_SORT_BUCKET_COUNT)
+	{
+		// Gather buckets until the task has enough work
+		U32 lastBucket = firstBucket + 1;
+		while(lastBucket < RADIX_SORT_BUCKET_COUNT
+			  && bucketOffsets[lastBucket] - bucketOffsets[firstBucket] < pairsPerTask)
+		{
+			++lastBucket;
+		}
+
+		const U32 begin = bucketOffsets[firstBucket];
+		const U32 end = bucketOffsets[lastBucket];
+		firstBucket = lastBucket;
+		if(begin == end)
+		{
+			continue;
+		}
+
+		ANKI_ASSERT(taskCount < tasks.getSize());
+		SortRenderablesTask* task = alloc.newInstance<SortRenderablesTask>();
+		task->m_pairs = WeakArray<RadixSortPair>(&tmpPairs[begin], end - begin);
+		task->m_tmpPairs = WeakArray<RadixSortPair>(&pairs[begin], end - begin);
+		task->m_unsortedElements = unsortedElements;
+		task->m_sortedElements = &elements[begin];
+
+		tasks[taskCount++] = ANKI_THREAD_HIVE_TASK({ self->sort(); }, task, nullptr, nullptr);
+	}
+
+	hive.submitTasks(&tasks[0], taskCount);
+}
+
+void SortRenderablesTask::sort()
+{
+	ANKI_TRACE_SCOPED_EVENT(SCENE_VIS_SORT);
+
+	// The most significant byte is the same for all the pairs of the range if they came from a partition
+	radixSort(m_pairs, m_tmpPairs);
+
+	for(U32 i = 0; i < m_pairs.getSize(); ++i)
+	{
+		m_sortedElements[i] = m_unsortedElements[m_pairs[i].m_value];
+	}
+}
+
 template<typename T>
 void CombineResultsTask::combineQueueElements(SceneFrameAllocator<U8>& alloc,
 											  WeakArray<TRenderQueueElementStorage<T>> subStorages,
 											  WeakArray<TRenderQueueElementStorage<U32>>* ptrSubStorages,
-											  WeakArray<T>& combined, WeakArray<T*>* ptrCombined)
+											  WeakArray<T>& combined, WeakArray<T*>* ptrCombined, Bool keepOrder)
 {
 	U32 totalElCount = subStorages[0].m_elementCount;
 	U32 biggestSubStorageIdx = 0;
@@ -735,7 +862,8 @@ void CombineResultsTask::combineQueueElements(SceneFrameAllocator<U8>& alloc,
 	{
 		totalElCount += subStorages[i].m_elementCount;
 
-		if(subStorages[i].m_elementStorage > subStorages[biggestSubStorageIdx].m_elementStorage)
+		// The reused storage ends up first so only the 1st can be reused if the order matters
+		if(!keepOrder && subStorages[i].m_elementStorage > subStorages[biggestSubStorageIdx].m_elementStorage)
 		{
 			biggestSubStorageIdx = i;
 		}
@@ -11,6 +11,7 @@
 #include <AnKi/Scene/Octree.h>
 #include <AnKi/Util/Thread.h>
 #include <AnKi/Util/Tracer.h>
+#include <AnKi/Util/RadixSort.h>
 #include <AnKi/Renderer/RenderQueue.h>
 
 namespace anki {
@@ -22,43 +23,43 @@ static const U32 MAX_SPATIALS_PER_VIS_TEST = 48; ///< Num of spatials to test in
 static const U32 SW_RASTERIZER_WIDTH = 80;
 static const U32 SW_RASTERIZER_HEIGHT = 50;
 
-/// Sort objects on distance
-template<typename T>
-class DistanceSortFunctor
-{
-public:
-	Bool operator()(const T& a, const T& b)
-	{
-		return a.m_distanceFromCamera < b.m_distanceFromCamera;
-	}
-};
+/// Renderable arrays with more elements than that will be sorted in parallel.
+static const U32 PARALLEL_SORT_THRESHOLD = 2048;
+
+/// Computes the sort key of a renderable.
+using ComputeRenderableSortKeyCallback = U64 (*)(const RenderableQueueElement& el);
 
-template<typename T>
-class RevDistanceSortFunctor
+/// Get the bits of a positive float in a way that they sort the same as the float.
+inline U32 getSortableFloatBits(F32 f)
 {
-public:
-	Bool operator()(const T& a, const T& b)
-	{
-		return a.m_distanceFromCamera > b.m_distanceFromCamera;
-	}
-};
+	ANKI_ASSERT(f >= 0.0f);
+	U32 bits;
+	memcpy(&bits, &f, sizeof(bits));
+	return bits;
+}
+
+/// Sort key that sorts first by LOD, then by state (material and geometry bits of the merge key) and then front to
+/// back.
+inline U64 computeStateSortKey(const RenderableQueueElement& el)
+{
+	ANKI_ASSERT(el.m_lod < MAX_LOD_COUNT);
+	const U64 lod = el.m_lod;
+	const U64 state = el.m_mergeKey >> 18u;
+	const U64 depth = getSortableFloatBits(el.m_distanceFromCamera) >> 16u;
+	return (lod << 62u) | (state << 16u) | depth;
+}
+
+/// Sort key that sorts front to back and then by state.
+inline U64 computeFrontToBackSortKey(const RenderableQueueElement& el)
+{
+	return (U64(getSortableFloatBits(el.m_distanceFromCamera)) << 32u) | (el.m_mergeKey >> 32u);
+}
 
-/// Sorts first by LOD and then by material (merge key).
-class MaterialDistanceSortFunctor
+/// Sort key that sorts back to front and then by state.
+inline U64 computeBackToFrontSortKey(const RenderableQueueElement& el)
 {
-public:
-	Bool operator()(const RenderableQueueElement& a, const RenderableQueueElement& b)
-	{
-		if(a.m_lod == b.m_lod)
-		{
-			return a.m_mergeKey < b.m_mergeKey;
-		}
-		else
-		{
-			return a.m_lod < b.m_lod;
-		}
-	}
-};
+	return (U64(~getSortableFloatBits(el.m_distanceFromCamera)) << 32u) | (el.m_mergeKey >> 32u);
+}
 
 /// Storage for a single element type.
 template<typename T, U32 INITIAL_STORAGE_SIZE = 32, U32 STORAGE_GROW_RATE = 4>
@@ -105,8 +106,11 @@ public:
 	TRenderQueueElementStorage<GenericGpuComputeJobQueueElement> m_genericGpuComputeJobs;
 	TRenderQueueElementStorage<RayTracingInstanceQueueElement> m_rayTracingInstances;
 	TRenderQueueElementStorage<UiQueueElement> m_uis;
+	TRenderQueueElementStorage<RenderableQueueElement> m_staticShadowRenderables; ///< Shadow casters that are static.
 
 	Timestamp m_timestamp = 0;
+	Timestamp m_staticTimestamp = 0; ///< Max timestamp of the static shadow casters.
+	U64 m_staticHash = 0; ///< Sum of the hashes of the static shadow caster UUIDs. Doesn't depend on the order.
 
 	RenderQueueView()
 	{
@@ -221,6 +225,20 @@ private:
 };
 static_assert(std::is_trivially_destructible<VisibilityTestTask>::value == true, "Should be trivially destructible");
 
+/// ThreadHive task that sorts a range of the renderables. The pairs are already partitioned by their most significant
+/// byte so every range can be sorted independently.
+class SortRenderablesTask
+{
+public:
+	WeakArray<RadixSortPair> m_pairs;
+	WeakArray<RadixSortPair> m_tmpPairs;
+	const RenderableQueueElement* m_unsortedElements = nullptr;
+	RenderableQueueElement* m_sortedElements = nullptr; ///< Points to the 1st element of the range.
+
+	void sort();
+};
+static_assert(std::is_trivially_destructible<SortRenderablesTask>::value == true, "Should be trivially destructible");
+
 /// Task that combines and sorts the results.
 class CombineResultsTask
 {
@@ -233,14 +251,19 @@ public:
 		ANKI_ASSERT(m_frcCtx);
 	}
 
-	void combine();
+	void combine(ThreadHive& hive);
 
 private:
+	/// Sort using a radix sort on compact keys. Big arrays will spawn new tasks to do the sorting.
+	void sortRenderables(WeakArray<RenderableQueueElement> elements, ComputeRenderableSortKeyCallback computeKey,
+						 ThreadHive& hive);
+
+	/// @param keepOrder If true the elements keep the order of the sub storages.
 	template<typename T>
 	static void combineQueueElements(SceneFrameAllocator<U8>& alloc,
 									 WeakArray<TRenderQueueElementStorage<T>> subStorages,
 									 WeakArray<TRenderQueueElementStorage<U32>>* ptrSubStorage, WeakArray<T>& combined,
-									 WeakArray<T*>* ptrCombined);
+									 WeakArray<T*>* ptrCombined, Bool keepOrder = false);
 };
 static_assert(std::is_trivially_destructible<CombineResultsTask>::value == true, "Should be trivially destructible");
 /// @}
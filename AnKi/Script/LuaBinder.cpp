@@ -33,6 +33,15 @@ static int luaPanic(lua_State* l)
 	return 0;
 }
 
+static int writeBytecode(lua_State* l, const void* data, size_t size, void* userData)
+{
+	DynamicArrayAuto<U8>& bytecode = *static_cast<DynamicArrayAuto<U8>*>(userData);
+	const U32 offset = bytecode.getSize();
+	bytecode.resize(offset + U32(size));
+	memcpy(&bytecode[offset], data, size);
+	return 0;
+}
+
 LuaBinder::LuaBinder()
 {
 }
@@ -44,6 +53,16 @@ LuaBinder::~LuaBinder()
 		lua_close(m_l);
 	}
 	m_userDataSigToDataInfo.destroy(m_alloc);
+
+	for(CachedBlock* block : m_blockCache)
+	{
+		while(block)
+		{
+			CachedBlock* next = block->m_next;
+			m_alloc.getMemoryPool().free(block);
+			block = next;
+		}
+	}
 }
 
 Error LuaBinder::init(ScriptAllocator alloc, LuaBinderOtherSystems* otherSystems)
@@ -64,16 +83,70 @@ Error LuaBinder::init(ScriptAllocator alloc, LuaBinderOtherSystems* otherSystems
 void* LuaBinder::luaAllocCallback(void* userData, void* ptr, PtrSize osize, PtrSize nsize)
 {
 	ANKI_ASSERT(userData);
-
-#if 1
 	LuaBinder& binder = *reinterpret_cast<LuaBinder*>(userData);
+
+	// If the ptr is null the osize is the type of the object and not a size
+	if(ptr == nullptr)
+	{
+		osize = 0;
+	}
+	binder.m_vmAllocatedSize = binder.m_vmAllocatedSize + nsize - osize;
+
+	if(nsize == 0)
+	{
+		// Free. Keep the small blocks for later
+		const U32 sizeClass = U32((osize + BLOCK_CACHE_SIZE_CLASS_STEP - 1) / BLOCK_CACHE_SIZE_CLASS_STEP) - 1;
+		if(ptr && osize > 0 && sizeClass < BLOCK_CACHE_SIZE_CLASS_COUNT
+		   && binder.m_cachedBlockCounts[sizeClass] < MAX_CACHED_BLOCKS_PER_SIZE_CLASS)
+		{
+			// The size might have shrunk since the allocation so the block might be bigger than its class. That's fine
+			CachedBlock* block = static_cast<CachedBlock*>(ptr);
+			block->m_next = binder.m_blockCache[sizeClass];
+			binder.m_blockCache[sizeClass] = block;
+			++binder.m_cachedBlockCounts[sizeClass];
+			return nullptr;
+		}
+
+		return reallocate(binder.m_alloc, ptr, osize, nsize);
+	}
+
+	if(ptr && nsize <= osize)
+	{
+		// Shrinking doesn't allocate
+		return ptr;
+	}
+
+	++binder.m_vmAllocationCount;
+
+	// Allocate or grow. Small blocks are rounded up to their class since they might go to the cache when they are freed
+	// and the cache assumes that a block is at least as big as its class
+	const U32 sizeClass = U32((nsize + BLOCK_CACHE_SIZE_CLASS_STEP - 1) / BLOCK_CACHE_SIZE_CLASS_STEP) - 1;
+	if(sizeClass < BLOCK_CACHE_SIZE_CLASS_COUNT)
+	{
+		CachedBlock* block = (ptr == nullptr) ? binder.m_blockCache[sizeClass] : nullptr;
+		if(block)
+		{
+			binder.m_blockCache[sizeClass] = block->m_next;
+			--binder.m_cachedBlockCounts[sizeClass];
+			return block;
+		}
+
+		nsize = (sizeClass + 1) * BLOCK_CACHE_SIZE_CLASS_STEP;
+	}
+
+	++binder.m_poolAllocationCount;
+	return reallocate(binder.m_alloc, ptr, osize, nsize);
+}
+
+void* LuaBinder::reallocate(ScriptAllocator& alloc, void* ptr, PtrSize osize, PtrSize nsize)
+{
 	void* out = nullptr;
 
 	if(nsize == 0)
 	{
 		if(ptr != nullptr)
 		{
-			binder.m_alloc.getMemoryPool().free(ptr);
+			alloc.getMemoryPool().free(ptr);
 		}
 	}
 	else
@@ -82,7 +155,7 @@ void* LuaBinder::luaAllocCallback(void* userData, void* ptr, PtrSize osize, PtrS
 
 		if(ptr == nullptr)
 		{
-			out = binder.m_alloc.getMemoryPool().allocate(nsize, 16);
+			out = alloc.getMemoryPool().allocate(nsize, 16);
 		}
 		else if(nsize <= osize)
 		{
@@ -92,24 +165,30 @@ void* LuaBinder::luaAllocCallback(void* userData, void* ptr, PtrSize osize, PtrS
 		{
 			// realloc
 
-			out = binder.m_alloc.getMemoryPool().allocate(nsize, 16);
+			out = alloc.getMemoryPool().allocate(nsize, 16);
 			memcpy(out, ptr, osize);
-			binder.m_alloc.getMemoryPool().free(ptr);
+			alloc.getMemoryPool().free(ptr);
 		}
 	}
-#else
-	void* out = nullptr;
-	if(nsize == 0)
+
+	return out;
+}
+
+void LuaBinder::setGarbageCollectorConfig(const LuaGarbageCollectorConfig& config)
+{
+	ANKI_ASSERT(m_l);
+
+	if(config.m_mode == LuaGarbageCollectorMode::GENERATIONAL)
 	{
-		free(ptr);
+		lua_gc(m_l, LUA_GCGEN, 0);
 	}
 	else
 	{
-		out = realloc(ptr, nsize);
+		lua_gc(m_l, LUA_GCINC, 0);
 	}
-#endif
 
-	return out;
+	lua_gc(m_l, LUA_GCSETPAUSE, I32(config.m_pause));
+	lua_gc(m_l, LUA_GCSETSTEPMUL, I32(config.m_stepMultiplier));
 }
 
 Error LuaBinder::evalString(lua_State* state, const CString& str)
@@ -129,6 +208,32 @@ Error LuaBinder::evalString(lua_State* state, const CString& str)
 	return err;
 }
 
+Error LuaBinder::compileString(ScriptAllocator alloc, const CString& str, const CString& chunkName,
+							   DynamicArrayAuto<U8>& bytecode)
+{
+	// Use a bare state, the bindings are not needed to compile
+	lua_State* l = lua_newstate(
+		[](void* userData, void* ptr, PtrSize osize, PtrSize nsize) -> void* {
+			return reallocate(*static_cast<ScriptAllocator*>(userData), ptr, osize, nsize);
+		},
+		&alloc);
+	lua_atpanic(l, &luaPanic);
+
+	Error err = Error::NONE;
+	if(luaL_loadbuffer(l, str.cstr(), str.getLength(), chunkName.cstr()))
+	{
+		ANKI_SCRIPT_LOGE("%s", lua_tostring(l, -1));
+		err = Error::USER_DATA;
+	}
+	else
+	{
+		lua_dump(l, writeBytecode, &bytecode);
+	}
+
+	lua_close(l);
+	return err;
+}
+
 void LuaBinder::createClass(lua_State* l, const LuaUserDataTypeInfo* typeInfo)
 {
 	ANKI_ASSERT(typeInfo);
@@ -273,11 +378,11 @@ void LuaBinder::luaFree(lua_State* l, void* ptr)
 	binder->m_alloc.getMemoryPool().free(ptr);
 }
 
-void LuaBinder::serializeGlobals(lua_State* l, LuaBinderSerializeGlobalsCallback& callback)
+void LuaBinder::serializeTable(lua_State* l, LuaBinderSerializeGlobalsCallback& callback)
 {
 	ANKI_ASSERT(l);
+	ANKI_ASSERT(lua_istable(l, -1));
 
-	lua_pushglobaltable(l);
 	lua_pushnil(l);
 
 	while(lua_next(l, -2) != 0)
@@ -379,9 +484,10 @@ void LuaBinder::serializeGlobals(lua_State* l, LuaBinderSerializeGlobalsCallback
 	}
 }
 
-void LuaBinder::deserializeGlobals(lua_State* l, const void* data, PtrSize dataSize)
+void LuaBinder::deserializeTable(lua_State* l, const void* data, PtrSize dataSize)
 {
 	ANKI_ASSERT(dataSize > 0 && data);
+	ANKI_ASSERT(lua_istable(l, -1));
 	const U8* ptr = static_cast<const U8*>(data);
 	const U8* end = ptr + dataSize;
 
@@ -404,7 +510,7 @@ void LuaBinder::deserializeGlobals(lua_State* l, const void* data, PtrSize dataS
 			const F64 val = *reinterpret_cast<const F64*>(ptr);
 			ptr += sizeof(F64);
 			lua_pushnumber(l, val);
-			lua_setglobal(l, name.cstr());
+			lua_setfield(l, -2, name.cstr());
 			break;
 		}
 		case LUA_TSTRING:
@@ -414,7 +520,7 @@ void LuaBinder::deserializeGlobals(lua_State* l, const void* data, PtrSize dataS
 			ptr += len + 1;
 			ANKI_ASSERT(len > 0);
 			lua_pushstring(l, val.cstr());
-			lua_setglobal(l, name.cstr());
+			lua_setfield(l, -2, name.cstr());
 			break;
 		}
 		case LUA_TUSERDATA:
@@ -443,7 +549,7 @@ void LuaBinder::deserializeGlobals(lua_State* l, const void* data, PtrSize dataS
 			typeInfo->m_deserializeCallback(ptr, *userData);
 			ptr += dataSize;
 			luaL_setmetatable(l, typeInfo->m_typeName);
-			lua_setglobal(l, name.cstr());
+			lua_setfield(l, -2, name.cstr());
 
 			break;
 		}
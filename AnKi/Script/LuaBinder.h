@@ -12,6 +12,8 @@
 #include <AnKi/Util/String.h>
 #include <AnKi/Util/Functions.h>
 #include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/Array.h>
 #include <Lua/lua.hpp>
 #ifndef ANKI_LUA_HPP
 #	error "Wrong LUA header included"
@@ -147,6 +149,39 @@ public:
 	MainRenderer* m_renderer;
 };
 
+/// The modes of the LUA garbage collector.
+/// @memberof LuaGarbageCollectorConfig
+enum class LuaGarbageCollectorMode : U8
+{
+	INCREMENTAL, ///< Collect everything in small steps.
+	GENERATIONAL, ///< Collect the young objects more often. Good for the many short-lived temporaries of the scripts.
+};
+
+/// The configuration of the LUA garbage collector. See the LUA manual (lua_gc) for the meaning of the values.
+/// @memberof LuaBinder
+class LuaGarbageCollectorConfig
+{
+public:
+	LuaGarbageCollectorMode m_mode = LuaGarbageCollectorMode::INCREMENTAL;
+
+	/// How long the collector waits before starting a new cycle. It's a percentage of the memory that is in use after
+	/// the previous cycle. The default is LUA's.
+	U32 m_pause = 200;
+
+	/// The speed of the collector relative to the allocations. It's a percentage. The default is LUA's.
+	U32 m_stepMultiplier = 200;
+};
+
+/// The allocations of a LUA VM.
+/// @memberof LuaBinder
+class LuaBinderAllocationStats
+{
+public:
+	U64 m_vmAllocationCount = 0; ///< The number of blocks that LUA allocated.
+	U64 m_poolAllocationCount = 0; ///< The number of those blocks that didn't come from the cache of freed blocks.
+	PtrSize m_vmAllocatedSize = 0; ///< The memory that LUA holds now.
+};
+
 /// Lua binder class. A wrapper on top of LUA
 class LuaBinder
 {
@@ -178,6 +213,19 @@ public:
 		return *m_otherSystems;
 	}
 
+	/// Change the mode and the parameters of the garbage collector.
+	void setGarbageCollectorConfig(const LuaGarbageCollectorConfig& config);
+
+	/// Get the allocation statistics. Take the difference of two calls to find the allocations of a frame.
+	LuaBinderAllocationStats getAllocationStats() const
+	{
+		LuaBinderAllocationStats stats;
+		stats.m_vmAllocationCount = m_vmAllocationCount;
+		stats.m_poolAllocationCount = m_poolAllocationCount;
+		stats.m_vmAllocatedSize = m_vmAllocatedSize;
+		return stats;
+	}
+
 	/// Expose a variable to the lua state
 	template<typename T>
 	static void exposeVariable(lua_State* state, CString name, T* y)
@@ -201,6 +249,11 @@ public:
 	/// Evaluate a string
 	static Error evalString(lua_State* state, const CString& str);
 
+	/// Compile a string to bytecode. Loading the bytecode skips the parsing.
+	/// @param chunkName The name of the chunk that will appear in the error messages.
+	static ANKI_USE_RESULT Error compileString(ScriptAllocator alloc, const CString& str, const CString& chunkName,
+											   DynamicArrayAuto<U8>& bytecode);
+
 	static void garbageCollect(lua_State* state)
 	{
 		lua_gc(state, LUA_GCCOLLECT, 0);
@@ -222,10 +275,26 @@ public:
 	static void pushLuaCFunc(lua_State* l, const char* name, lua_CFunction luafunc);
 
 	/// Dump global variables.
-	static void serializeGlobals(lua_State* l, LuaBinderSerializeGlobalsCallback& callback);
+	static void serializeGlobals(lua_State* l, LuaBinderSerializeGlobalsCallback& callback)
+	{
+		lua_pushglobaltable(l);
+		serializeTable(l, callback);
+		lua_pop(l, 1);
+	}
 
 	/// Deserialize global variables.
-	static void deserializeGlobals(lua_State* l, const void* data, PtrSize dataSize);
+	static void deserializeGlobals(lua_State* l, const void* data, PtrSize dataSize)
+	{
+		lua_pushglobaltable(l);
+		deserializeTable(l, data, dataSize);
+		lua_pop(l, 1);
+	}
+
+	/// Dump the variables of the table that is in the top of the stack.
+	static void serializeTable(lua_State* l, LuaBinderSerializeGlobalsCallback& callback);
+
+	/// Deserialize variables to the table that is in the top of the stack.
+	static void deserializeTable(lua_State* l, const void* data, PtrSize dataSize);
 
 	/// Make sure that the arguments match the argsCount number
 	static ANKI_USE_RESULT Error checkArgsCount(lua_State* l, I argsCount);
@@ -259,13 +328,37 @@ public:
 	static void luaFree(lua_State* l, void* ptr);
 
 private:
+	/// The size of the blocks that the cache keeps is up to BLOCK_CACHE_SIZE_CLASS_COUNT * BLOCK_CACHE_SIZE_CLASS_STEP.
+	static constexpr PtrSize BLOCK_CACHE_SIZE_CLASS_STEP = 16;
+	static constexpr U32 BLOCK_CACHE_SIZE_CLASS_COUNT = 8;
+	static constexpr U32 MAX_CACHED_BLOCKS_PER_SIZE_CLASS = 2048;
+
+	/// A block in the cache.
+	class CachedBlock
+	{
+	public:
+		CachedBlock* m_next;
+	};
+
 	LuaBinderOtherSystems* m_otherSystems;
 	ScriptAllocator m_alloc;
 	lua_State* m_l = nullptr;
 	HashMap<I64, const LuaUserDataTypeInfo*> m_userDataSigToDataInfo;
 
+	/// Lists of the small blocks that LUA freed. LUA frees and allocates the same sizes all the time (the userdata of
+	/// the math types for example) so they are given back without going to the allocator. The VM is not thread-safe
+	/// so the cache doesn't need to be either.
+	Array<CachedBlock*, BLOCK_CACHE_SIZE_CLASS_COUNT> m_blockCache = {};
+	Array<U32, BLOCK_CACHE_SIZE_CLASS_COUNT> m_cachedBlockCounts = {};
+
+	U64 m_vmAllocationCount = 0;
+	U64 m_poolAllocationCount = 0;
+	PtrSize m_vmAllocatedSize = 0;
+
 	static void* luaAllocCallback(void* userData, void* ptr, PtrSize osize, PtrSize nsize);
 
+	static void* reallocate(ScriptAllocator& alloc, void* ptr, PtrSize osize, PtrSize nsize);
+
 	static ANKI_USE_RESULT Error checkNumberInternal(lua_State* l, I32 stackIdx, lua_Number& number);
 };
 /// @}
@@ -12,6 +12,7 @@ import xml.etree.ElementTree as et
 # Globals
 identation_level = 0
 out_file = None
+unpack_accessors = {}  # The class name and the accessors of its components. See the "unpack" attribute of classes
 
 
 def parse_commandline():
@@ -307,21 +308,31 @@ def write_local_vars():
     wglue("")
 
 
-def method(class_name, meth_el):
-    """ Handle a method """
+def wrapper(comment, name):
+    """ Write the function that calls the pre-wrap function and raises the LUA error """
 
-    meth_name = meth_el.get("name")
-    meth_alias = get_meth_alias(meth_el)
-
-    wglue("/// Pre-wrap method %s::%s." % (class_name, meth_name))
-    wglue("static inline int pwrap%s%s(lua_State* l)" % (class_name, meth_alias))
+    wglue("/// %s" % comment)
+    wglue("static int wrap%s(lua_State* l)" % name)
     wglue("{")
     ident(1)
-    write_local_vars()
+    wglue("int res = pwrap%s(l);" % name)
+    wglue("if(res >= 0)")
+    wglue("{")
+    ident(1)
+    wglue("return res;")
+    ident(-1)
+    wglue("}")
+    wglue("")
+    wglue("lua_error(l);")
+    wglue("return 0;")
+    ident(-1)
+    wglue("}")
+    wglue("")
 
-    check_args(meth_el.find("args"), 1)
 
-    # Get this pointer
+def self_arg(class_name):
+    """ Get "this" from the 1st argument """
+
     wglue("// Get \"this\" as \"self\"")
     wglue("if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfo%s, ud))" % class_name)
     wglue("{")
@@ -333,6 +344,77 @@ def method(class_name, meth_el):
     wglue("%s* self = ud->getData<%s>();" % (class_name, class_name))
     wglue("")
 
+
+def ret_out(ret_el, stack_index):
+    """ Copy the return value to the "out" argument and push that instead of creating new userdata """
+
+    (type, is_ref, is_ptr, is_const) = parse_type_decl(ret_el.text)
+    if is_ref or is_ptr or type_is_bool(type) or type_is_number(type):
+        raise Exception("Only methods that return a class by value can have an \"out\" variant: %s" % type)
+
+    wglue("// Write the return value to the \"out\" argument")
+    wglue("extern LuaUserDataTypeInfo luaUserDataTypeInfo%s;" % type)
+    wglue("if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, %d, luaUserDataTypeInfo%s, ud)))" % (stack_index, type))
+    wglue("{")
+    ident(1)
+    wglue("return -1;")
+    ident(-1)
+    wglue("}")
+    wglue("")
+    wglue("*ud->getData<%s>() = ret;" % type)
+    wglue("lua_pushvalue(l, %d);" % stack_index)
+    wglue("")
+    wglue("return 1;")
+
+
+def push_unpacked(type, obj):
+    """ Push the components of a class as numbers """
+
+    if type not in unpack_accessors:
+        raise Exception("Class %s doesn't have the \"unpack\" attribute" % type)
+
+    accessors = unpack_accessors[type]
+    for accessor in accessors:
+        wglue("lua_pushnumber(l, lua_Number(%s.%s()));" % (obj, accessor))
+    wglue("")
+    wglue("return %d;" % len(accessors))
+
+
+def ret_unpacked(ret_el):
+    """ Push the components of the return value as multiple return values """
+
+    (type, is_ref, is_ptr, is_const) = parse_type_decl(ret_el.text)
+    if is_ptr:
+        raise Exception("Can't unpack pointers: %s" % type)
+
+    wglue("// Push the components of the return value")
+    push_unpacked(type, "ret")
+
+
+def method(class_name, meth_el, variant=None):
+    """ Handle a method. The variant can be None, "out" or "unpack". The "out" variant takes one more argument and
+    writes the return value there. The "unpack" variant returns the components of the return value as numbers. Both
+    don't create userdata so they don't allocate """
+
+    meth_name = meth_el.get("name")
+    if variant is None:
+        meth_alias = get_meth_alias(meth_el)
+        variant_txt = ""
+    else:
+        meth_alias = meth_el.get(variant + "Alias")
+        variant_txt = " (%s variant)" % variant
+
+    wglue("/// Pre-wrap method %s::%s%s." % (class_name, meth_name, variant_txt))
+    wglue("static inline int pwrap%s%s(lua_State* l)" % (class_name, meth_alias))
+    wglue("{")
+    ident(1)
+    write_local_vars()
+
+    check_args(meth_el.find("args"), 2 if variant == "out" else 1)
+
+    # Get this pointer
+    self_arg(class_name)
+
     args_str = args(meth_el.find("args"), 2)
 
     # Return value
@@ -341,6 +423,9 @@ def method(class_name, meth_el):
     if ret_el is not None:
         ret_txt = ret_el.text
 
+    if variant is not None and ret_el is None:
+        raise Exception("Method %s::%s has a variant but it doesn't return anything" % (class_name, meth_name))
+
     # Method call
     wglue("// Call the method")
     call = meth_el.find("overrideCall")
@@ -356,31 +441,43 @@ def method(class_name, meth_el):
             wglue("%s ret = self->%s(%s);" % (ret_txt, meth_name, args_str))
 
     wglue("")
-    ret(ret_el)
+    if variant == "out":
+        ret_out(ret_el, 2 + count_args(meth_el.find("args")))
+    elif variant == "unpack":
+        ret_unpacked(ret_el)
+    else:
+        ret(ret_el)
 
     ident(-1)
     wglue("}")
     wglue("")
 
     # Write the actual function
-    wglue("/// Wrap method %s::%s." % (class_name, meth_name))
-    wglue("static int wrap%s%s(lua_State* l)" % (class_name, meth_alias))
-    wglue("{")
-    ident(1)
-    wglue("int res = pwrap%s%s(l);" % (class_name, meth_alias))
-    wglue("if(res >= 0)")
+    wrapper("Wrap method %s::%s%s." % (class_name, meth_name, variant_txt), "%s%s" % (class_name, meth_alias))
+
+
+def unpack_method(class_name):
+    """ Create a method that returns the components of the class as numbers """
+
+    wglue("/// Pre-wrap method %s::unpack." % class_name)
+    wglue("static inline int pwrap%sunpack(lua_State* l)" % class_name)
     wglue("{")
     ident(1)
-    wglue("return res;")
-    ident(-1)
-    wglue("}")
-    wglue("")
-    wglue("lua_error(l);")
-    wglue("return 0;")
+    write_local_vars()
+
+    check_args(None, 1)
+
+    self_arg(class_name)
+
+    wglue("// Push the components")
+    push_unpacked(class_name, "(*self)")
+
     ident(-1)
     wglue("}")
     wglue("")
 
+    wrapper("Wrap method %s::unpack." % class_name, "%sunpack" % class_name)
+
 
 def static_method(class_name, meth_el):
     """ Handle a static method """
@@ -420,23 +517,7 @@ def static_method(class_name, meth_el):
     wglue("")
 
     # Write the actual function
-    wglue("/// Wrap static method %s::%s." % (class_name, meth_name))
-    wglue("static int wrap%s%s(lua_State* l)" % (class_name, meth_alias))
-    wglue("{")
-    ident(1)
-    wglue("int res = pwrap%s%s(l);" % (class_name, meth_alias))
-    wglue("if(res >= 0)")
-    wglue("{")
-    ident(1)
-    wglue("return res;")
-    ident(-1)
-    wglue("}")
-    wglue("")
-    wglue("lua_error(l);")
-    wglue("return 0;")
-    ident(-1)
-    wglue("}")
-    wglue("")
+    wrapper("Wrap static method %s::%s." % (class_name, meth_name), "%s%s" % (class_name, meth_alias))
 
 
 def constructor(constr_el, class_name, constructor_idx):
@@ -631,8 +712,17 @@ def class_(class_el):
         has_constructor = True
         constructors(constructors_el, class_name)
 
+    # Value types are trivially destructible so they don't need a __gc. LUA frees the userdata without a finalizer
+    # and that is faster and works better with the generational collector
+    is_value_type = class_el.get("valueType")
+    is_value_type = is_value_type is not None and is_value_type == "true"
+    if is_value_type:
+        wglue("static_assert(std::is_trivially_destructible<%s>::value, \"Value types shouldn't need a destructor\");"
+              % class_name)
+        wglue("")
+
     # Destructor declarations
-    if has_constructor:
+    if has_constructor and not is_value_type:
         destructor(class_name)
 
     # Methods LUA C functions declarations
@@ -652,6 +742,22 @@ def class_(class_el):
             meth_alias = get_meth_alias(meth_el)
             meth_names_aliases.append([meth_name, meth_alias, is_static])
 
+            # The variants that don't allocate
+            for variant in ["out", "unpack"]:
+                variant_alias = meth_el.get(variant + "Alias")
+                if variant_alias is None:
+                    continue
+
+                if is_static:
+                    raise Exception("Static methods can't have variants: %s::%s" % (class_name, meth_name))
+
+                method(class_name, meth_el, variant)
+                meth_names_aliases.append([meth_name, variant_alias, False])
+
+    if class_name in unpack_accessors:
+        unpack_method(class_name)
+        meth_names_aliases.append(["unpack", "unpack", False])
+
     # Start class declaration
     wglue("/// Wrap class %s." % class_name)
     wglue("static inline void wrap%s(lua_State* l)" % class_name)
@@ -665,7 +771,7 @@ def class_(class_el):
               (class_name, class_name))
 
     # Register destructor
-    if has_constructor:
+    if has_constructor and not is_value_type:
         wglue("LuaBinder::pushLuaCFuncMethod(l, \"__gc\", wrap%sDtor);" % class_name)
 
     # Register methods
@@ -731,23 +837,7 @@ def function(func_el):
     wglue("")
 
     # Write the actual function
-    wglue("/// Wrap function %s." % func_name)
-    wglue("static int wrap%s(lua_State* l)" % func_alias)
-    wglue("{")
-    ident(1)
-    wglue("int res = pwrap%s(l);" % func_alias)
-    wglue("if(res >= 0)")
-    wglue("{")
-    ident(1)
-    wglue("return res;")
-    ident(-1)
-    wglue("}")
-    wglue("")
-    wglue("lua_error(l);")
-    wglue("return 0;")
-    ident(-1)
-    wglue("}")
-    wglue("")
+    wrapper("Wrap function %s." % func_name, func_alias)
 
 
 def main():
@@ -763,6 +853,14 @@ def main():
         tree = et.parse(filename)
         root = tree.getroot()
 
+        # Gather the classes that can be unpacked first since the methods of other classes might return them
+        unpack_accessors.clear()
+        for cls in root.iter("classes"):
+            for cl in cls.iter("class"):
+                unpack = cl.get("unpack")
+                if unpack is not None:
+                    unpack_accessors[cl.get("name")] = unpack.split(" ")
+
         # Head
         head = root.find("head")
         if head is not None:
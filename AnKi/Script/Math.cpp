@@ -130,34 +130,7 @@ static int wrapVec2Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Vec2.
-static int wrapVec2Dtor(lua_State* l)
-{
-	LuaUserData* ud;
-	(void)ud;
-	void* voidp;
-	(void)voidp;
-	PtrSize size;
-	(void)size;
-
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
-	{
-		return -1;
-	}
-
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud)))
-	{
-		return -1;
-	}
-
-	if(ud->isGarbageCollected())
-	{
-		Vec2* inst = ud->getData<Vec2>();
-		inst->~Vec2();
-	}
-
-	return 0;
-}
+static_assert(std::is_trivially_destructible<Vec2>::value, "Value types shouldn't need a destructor");
 
 /// Pre-wrap method Vec2::getX.
 static inline int pwrapVec2getX(lua_State* l)
@@ -622,8 +595,8 @@ static int wrapVec2__add(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator-.
-static inline int pwrapVec2__sub(lua_State* l)
+/// Pre-wrap method Vec2::operator+ (out variant).
+static inline int pwrapVec2addOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -632,7 +605,7 @@ static inline int pwrapVec2__sub(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -656,24 +629,25 @@ static inline int pwrapVec2__sub(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Vec2 ret = self->operator-(arg0);
+	Vec2 ret = self->operator+(arg0);
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
+	// Write the return value to the "out" argument
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
-	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec2>() = ret;
+	lua_pushvalue(l, 3);
 
 	return 1;
 }
 
-/// Wrap method Vec2::operator-.
-static int wrapVec2__sub(lua_State* l)
+/// Wrap method Vec2::operator+ (out variant).
+static int wrapVec2addOut(lua_State* l)
 {
-	int res = pwrapVec2__sub(l);
+	int res = pwrapVec2addOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -683,8 +657,8 @@ static int wrapVec2__sub(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator*.
-static inline int pwrapVec2__mul(lua_State* l)
+/// Pre-wrap method Vec2::operator+ (unpack variant).
+static inline int pwrapVec2addUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -717,24 +691,19 @@ static inline int pwrapVec2__mul(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Vec2 ret = self->operator*(arg0);
+	Vec2 ret = self->operator+(arg0);
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec2");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
-	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
 
-	return 1;
+	return 2;
 }
 
-/// Wrap method Vec2::operator*.
-static int wrapVec2__mul(lua_State* l)
+/// Wrap method Vec2::operator+ (unpack variant).
+static int wrapVec2addUnpack(lua_State* l)
 {
-	int res = pwrapVec2__mul(l);
+	int res = pwrapVec2addUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -744,8 +713,8 @@ static int wrapVec2__mul(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator/.
-static inline int pwrapVec2__div(lua_State* l)
+/// Pre-wrap method Vec2::operator-.
+static inline int pwrapVec2__sub(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -778,7 +747,7 @@ static inline int pwrapVec2__div(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Vec2 ret = self->operator/(arg0);
+	Vec2 ret = self->operator-(arg0);
 
 	// Push return value
 	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
@@ -792,10 +761,10 @@ static inline int pwrapVec2__div(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec2::operator/.
-static int wrapVec2__div(lua_State* l)
+/// Wrap method Vec2::operator-.
+static int wrapVec2__sub(lua_State* l)
 {
-	int res = pwrapVec2__div(l);
+	int res = pwrapVec2__sub(l);
 	if(res >= 0)
 	{
 		return res;
@@ -805,8 +774,8 @@ static int wrapVec2__div(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::operator==.
-static inline int pwrapVec2__eq(lua_State* l)
+/// Pre-wrap method Vec2::operator- (out variant).
+static inline int pwrapVec2subOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -815,7 +784,7 @@ static inline int pwrapVec2__eq(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -839,18 +808,25 @@ static inline int pwrapVec2__eq(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	Bool ret = self->operator==(arg0);
+	Vec2 ret = self->operator-(arg0);
 
-	// Push return value
-	lua_pushboolean(l, ret);
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec2>() = ret;
+	lua_pushvalue(l, 3);
 
 	return 1;
 }
 
-/// Wrap method Vec2::operator==.
-static int wrapVec2__eq(lua_State* l)
+/// Wrap method Vec2::operator- (out variant).
+static int wrapVec2subOut(lua_State* l)
 {
-	int res = pwrapVec2__eq(l);
+	int res = pwrapVec2subOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -860,8 +836,8 @@ static int wrapVec2__eq(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::getLength.
-static inline int pwrapVec2getLength(lua_State* l)
+/// Pre-wrap method Vec2::operator- (unpack variant).
+static inline int pwrapVec2subUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -870,7 +846,7 @@ static inline int pwrapVec2getLength(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
@@ -883,19 +859,30 @@ static inline int pwrapVec2getLength(lua_State* l)
 
 	Vec2* self = ud->getData<Vec2>();
 
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
 	// Call the method
-	F32 ret = self->getLength();
+	Vec2 ret = self->operator-(arg0);
 
-	// Push return value
-	lua_pushnumber(l, ret);
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
 
-	return 1;
+	return 2;
 }
 
-/// Wrap method Vec2::getLength.
-static int wrapVec2getLength(lua_State* l)
+/// Wrap method Vec2::operator- (unpack variant).
+static int wrapVec2subUnpack(lua_State* l)
 {
-	int res = pwrapVec2getLength(l);
+	int res = pwrapVec2subUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -905,8 +892,8 @@ static int wrapVec2getLength(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::getNormalized.
-static inline int pwrapVec2getNormalized(lua_State* l)
+/// Pre-wrap method Vec2::operator*.
+static inline int pwrapVec2__mul(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -915,7 +902,7 @@ static inline int pwrapVec2getNormalized(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
@@ -928,8 +915,18 @@ static inline int pwrapVec2getNormalized(lua_State* l)
 
 	Vec2* self = ud->getData<Vec2>();
 
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
 	// Call the method
-	Vec2 ret = self->getNormalized();
+	Vec2 ret = self->operator*(arg0);
 
 	// Push return value
 	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
@@ -943,10 +940,10 @@ static inline int pwrapVec2getNormalized(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec2::getNormalized.
-static int wrapVec2getNormalized(lua_State* l)
+/// Wrap method Vec2::operator*.
+static int wrapVec2__mul(lua_State* l)
 {
-	int res = pwrapVec2getNormalized(l);
+	int res = pwrapVec2__mul(l);
 	if(res >= 0)
 	{
 		return res;
@@ -956,8 +953,8 @@ static int wrapVec2getNormalized(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::normalize.
-static inline int pwrapVec2normalize(lua_State* l)
+/// Pre-wrap method Vec2::operator* (out variant).
+static inline int pwrapVec2mulOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -966,7 +963,7 @@ static inline int pwrapVec2normalize(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -979,16 +976,36 @@ static inline int pwrapVec2normalize(lua_State* l)
 
 	Vec2* self = ud->getData<Vec2>();
 
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
 	// Call the method
-	self->normalize();
+	Vec2 ret = self->operator*(arg0);
 
-	return 0;
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec2>() = ret;
+	lua_pushvalue(l, 3);
+
+	return 1;
 }
 
-/// Wrap method Vec2::normalize.
-static int wrapVec2normalize(lua_State* l)
+/// Wrap method Vec2::operator* (out variant).
+static int wrapVec2mulOut(lua_State* l)
 {
-	int res = pwrapVec2normalize(l);
+	int res = pwrapVec2mulOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -998,8 +1015,8 @@ static int wrapVec2normalize(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec2::dot.
-static inline int pwrapVec2dot(lua_State* l)
+/// Pre-wrap method Vec2::operator* (unpack variant).
+static inline int pwrapVec2mulUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1032,18 +1049,19 @@ static inline int pwrapVec2dot(lua_State* l)
 	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	F32 ret = self->dot(arg0);
+	Vec2 ret = self->operator*(arg0);
 
-	// Push return value
-	lua_pushnumber(l, ret);
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
 
-	return 1;
+	return 2;
 }
 
-/// Wrap method Vec2::dot.
-static int wrapVec2dot(lua_State* l)
+/// Wrap method Vec2::operator* (unpack variant).
+static int wrapVec2mulUnpack(lua_State* l)
 {
-	int res = pwrapVec2dot(l);
+	int res = pwrapVec2mulUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1053,59 +1071,8 @@ static int wrapVec2dot(lua_State* l)
 	return 0;
 }
 
-/// Wrap class Vec2.
-static inline void wrapVec2(lua_State* l)
-{
-	LuaBinder::createClass(l, &luaUserDataTypeInfoVec2);
-	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec2.m_typeName, "new", wrapVec2Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec2Dtor);
-	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec2getX);
-	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec2getY);
-	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec2setX);
-	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec2setY);
-	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec2setAll);
-	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec2getAt);
-	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec2setAt);
-	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec2copy);
-	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec2__add);
-	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec2__sub);
-	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec2__mul);
-	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec2__div);
-	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec2__eq);
-	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec2getLength);
-	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec2getNormalized);
-	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec2normalize);
-	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec2dot);
-	lua_settop(l, 0);
-}
-
-/// Serialize Vec3
-static void serializeVec3(LuaUserData& self, void* data, PtrSize& size)
-{
-	Vec3* obj = self.getData<Vec3>();
-	obj->serialize(data, size);
-}
-
-/// De-serialize Vec3
-static void deserializeVec3(const void* data, LuaUserData& self)
-{
-	ANKI_ASSERT(data);
-	Vec3* obj = self.getData<Vec3>();
-	::new(obj) Vec3();
-	obj->deserialize(data);
-}
-
-LuaUserDataTypeInfo luaUserDataTypeInfoVec3 = {
-	6804478823655046389, "Vec3", LuaUserData::computeSizeForGarbageCollected<Vec3>(), serializeVec3, deserializeVec3};
-
-template<>
-const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec3>()
-{
-	return luaUserDataTypeInfoVec3;
-}
-
-/// Pre-wrap constructor for Vec3.
-static inline int pwrapVec3Ctor0(lua_State* l)
+/// Pre-wrap method Vec2::operator/.
+static inline int pwrapVec2__div(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1114,59 +1081,59 @@ static inline int pwrapVec3Ctor0(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 0)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3();
-
-	return 1;
-}
-
-/// Pre-wrap constructor for Vec3.
-static inline int pwrapVec3Ctor1(lua_State* l)
-{
-	LuaUserData* ud;
-	(void)ud;
-	void* voidp;
-	(void)voidp;
-	PtrSize size;
-	(void)size;
-
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
+	Vec2* self = ud->getData<Vec2>();
+
 	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Call the method
+	Vec2 ret = self->operator/(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
 	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
+	luaL_setmetatable(l, "Vec2");
 	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(arg0);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
 
 	return 1;
 }
 
-/// Pre-wrap constructor for Vec3.
-static inline int pwrapVec3Ctor2(lua_State* l)
+/// Wrap method Vec2::operator/.
+static int wrapVec2__div(lua_State* l)
+{
+	int res = pwrapVec2__div(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec2::operator/ (out variant).
+static inline int pwrapVec2divOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1180,59 +1147,44 @@ static inline int pwrapVec3Ctor2(lua_State* l)
 		return -1;
 	}
 
-	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg1)))
+	Vec2* self = ud->getData<Vec2>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
 	{
 		return -1;
 	}
 
-	F32 arg2;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg2)))
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Call the method
+	Vec2 ret = self->operator/(arg0);
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec2, ud)))
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(arg0, arg1, arg2);
+	*ud->getData<Vec2>() = ret;
+	lua_pushvalue(l, 3);
 
 	return 1;
 }
 
-/// Wrap constructors for Vec3.
-static int wrapVec3Ctor(lua_State* l)
+/// Wrap method Vec2::operator/ (out variant).
+static int wrapVec2divOut(lua_State* l)
 {
-	// Chose the right overload
-	const int argCount = lua_gettop(l);
-	int res = 0;
-	switch(argCount)
-	{
-	case 0:
-		res = pwrapVec3Ctor0(l);
-		break;
-	case 1:
-		res = pwrapVec3Ctor1(l);
-		break;
-	case 3:
-		res = pwrapVec3Ctor2(l);
-		break;
-	default:
-		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
-		res = -1;
-	}
-
+	int res = pwrapVec2divOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1242,8 +1194,8 @@ static int wrapVec3Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Vec3.
-static int wrapVec3Dtor(lua_State* l)
+/// Pre-wrap method Vec2::operator/ (unpack variant).
+static inline int pwrapVec2divUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1252,27 +1204,54 @@ static int wrapVec3Dtor(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud)))
+	Vec2* self = ud->getData<Vec2>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
 	{
 		return -1;
 	}
 
-	if(ud->isGarbageCollected())
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Call the method
+	Vec2 ret = self->operator/(arg0);
+
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+
+	return 2;
+}
+
+/// Wrap method Vec2::operator/ (unpack variant).
+static int wrapVec2divUnpack(lua_State* l)
+{
+	int res = pwrapVec2divUnpack(l);
+	if(res >= 0)
 	{
-		Vec3* inst = ud->getData<Vec3>();
-		inst->~Vec3();
+		return res;
 	}
 
+	lua_error(l);
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getX.
-static inline int pwrapVec3getX(lua_State* l)
+/// Pre-wrap method Vec2::operator==.
+static inline int pwrapVec2__eq(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1281,32 +1260,42 @@ static inline int pwrapVec3getX(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
 
 	// Call the method
-	F32 ret = (*self).x();
+	Bool ret = self->operator==(arg0);
 
 	// Push return value
-	lua_pushnumber(l, ret);
+	lua_pushboolean(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::getX.
-static int wrapVec3getX(lua_State* l)
+/// Wrap method Vec2::operator==.
+static int wrapVec2__eq(lua_State* l)
 {
-	int res = pwrapVec3getX(l);
+	int res = pwrapVec2__eq(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1316,8 +1305,8 @@ static int wrapVec3getX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getY.
-static inline int pwrapVec3getY(lua_State* l)
+/// Pre-wrap method Vec2::getLength.
+static inline int pwrapVec2getLength(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1332,15 +1321,15 @@ static inline int pwrapVec3getY(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	F32 ret = (*self).y();
+	F32 ret = self->getLength();
 
 	// Push return value
 	lua_pushnumber(l, ret);
@@ -1348,10 +1337,10 @@ static inline int pwrapVec3getY(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec3::getY.
-static int wrapVec3getY(lua_State* l)
+/// Wrap method Vec2::getLength.
+static int wrapVec2getLength(lua_State* l)
 {
-	int res = pwrapVec3getY(l);
+	int res = pwrapVec2getLength(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1361,8 +1350,8 @@ static int wrapVec3getY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getZ.
-static inline int pwrapVec3getZ(lua_State* l)
+/// Pre-wrap method Vec2::getNormalized.
+static inline int pwrapVec2getNormalized(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1377,26 +1366,32 @@ static inline int pwrapVec3getZ(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	F32 ret = (*self).z();
+	Vec2 ret = self->getNormalized();
 
 	// Push return value
-	lua_pushnumber(l, ret);
+	size = LuaUserData::computeSizeForGarbageCollected<Vec2>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec2");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec2);
+	::new(ud->getData<Vec2>()) Vec2(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec3::getZ.
-static int wrapVec3getZ(lua_State* l)
+/// Wrap method Vec2::getNormalized.
+static int wrapVec2getNormalized(lua_State* l)
 {
-	int res = pwrapVec3getZ(l);
+	int res = pwrapVec2getNormalized(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1406,8 +1401,8 @@ static int wrapVec3getZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setX.
-static inline int pwrapVec3setX(lua_State* l)
+/// Pre-wrap method Vec2::getNormalized (out variant).
+static inline int pwrapVec2getNormalizedOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1422,30 +1417,33 @@ static inline int pwrapVec3setX(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
 
-	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	// Call the method
+	Vec2 ret = self->getNormalized();
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
 	{
 		return -1;
 	}
 
-	// Call the method
-	(*self).x() = arg0;
+	*ud->getData<Vec2>() = ret;
+	lua_pushvalue(l, 2);
 
-	return 0;
+	return 1;
 }
 
-/// Wrap method Vec3::setX.
-static int wrapVec3setX(lua_State* l)
+/// Wrap method Vec2::getNormalized (out variant).
+static int wrapVec2getNormalizedOut(lua_State* l)
 {
-	int res = pwrapVec3setX(l);
+	int res = pwrapVec2getNormalizedOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1455,8 +1453,8 @@ static int wrapVec3setX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setY.
-static inline int pwrapVec3setY(lua_State* l)
+/// Pre-wrap method Vec2::getNormalized (unpack variant).
+static inline int pwrapVec2getNormalizedUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1465,36 +1463,33 @@ static inline int pwrapVec3setY(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
-	{
-		return -1;
-	}
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	(*self).y() = arg0;
+	Vec2 ret = self->getNormalized();
 
-	return 0;
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+
+	return 2;
 }
 
-/// Wrap method Vec3::setY.
-static int wrapVec3setY(lua_State* l)
+/// Wrap method Vec2::getNormalized (unpack variant).
+static int wrapVec2getNormalizedUnpack(lua_State* l)
 {
-	int res = pwrapVec3setY(l);
+	int res = pwrapVec2getNormalizedUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1504,8 +1499,8 @@ static int wrapVec3setY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setZ.
-static inline int pwrapVec3setZ(lua_State* l)
+/// Pre-wrap method Vec2::normalize.
+static inline int pwrapVec2normalize(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1514,36 +1509,29 @@ static inline int pwrapVec3setZ(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
-	{
-		return -1;
-	}
+	Vec2* self = ud->getData<Vec2>();
 
 	// Call the method
-	(*self).z() = arg0;
+	self->normalize();
 
 	return 0;
 }
 
-/// Wrap method Vec3::setZ.
-static int wrapVec3setZ(lua_State* l)
+/// Wrap method Vec2::normalize.
+static int wrapVec2normalize(lua_State* l)
 {
-	int res = pwrapVec3setZ(l);
+	int res = pwrapVec2normalize(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1553,8 +1541,8 @@ static int wrapVec3setZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setAll.
-static inline int pwrapVec3setAll(lua_State* l)
+/// Pre-wrap method Vec2::dot.
+static inline int pwrapVec2dot(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1563,48 +1551,1508 @@ static inline int pwrapVec3setAll(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 4)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec2* self = ud->getData<Vec2>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec2;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec2, ud)))
+	{
+		return -1;
+	}
+
+	Vec2* iarg0 = ud->getData<Vec2>();
+	const Vec2& arg0(*iarg0);
+
+	// Call the method
+	F32 ret = self->dot(arg0);
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec2::dot.
+static int wrapVec2dot(lua_State* l)
+{
+	int res = pwrapVec2dot(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec2::unpack.
+static inline int pwrapVec2unpack(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec2, ud))
+	{
+		return -1;
+	}
+
+	Vec2* self = ud->getData<Vec2>();
+
+	// Push the components
+	lua_pushnumber(l, lua_Number((*self).x()));
+	lua_pushnumber(l, lua_Number((*self).y()));
+
+	return 2;
+}
+
+/// Wrap method Vec2::unpack.
+static int wrapVec2unpack(lua_State* l)
+{
+	int res = pwrapVec2unpack(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Wrap class Vec2.
+static inline void wrapVec2(lua_State* l)
+{
+	LuaBinder::createClass(l, &luaUserDataTypeInfoVec2);
+	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec2.m_typeName, "new", wrapVec2Ctor);
+	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec2getX);
+	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec2getY);
+	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec2setX);
+	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec2setY);
+	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec2setAll);
+	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec2getAt);
+	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec2setAt);
+	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec2copy);
+	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec2__add);
+	LuaBinder::pushLuaCFuncMethod(l, "addOut", wrapVec2addOut);
+	LuaBinder::pushLuaCFuncMethod(l, "addUnpack", wrapVec2addUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec2__sub);
+	LuaBinder::pushLuaCFuncMethod(l, "subOut", wrapVec2subOut);
+	LuaBinder::pushLuaCFuncMethod(l, "subUnpack", wrapVec2subUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec2__mul);
+	LuaBinder::pushLuaCFuncMethod(l, "mulOut", wrapVec2mulOut);
+	LuaBinder::pushLuaCFuncMethod(l, "mulUnpack", wrapVec2mulUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec2__div);
+	LuaBinder::pushLuaCFuncMethod(l, "divOut", wrapVec2divOut);
+	LuaBinder::pushLuaCFuncMethod(l, "divUnpack", wrapVec2divUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec2__eq);
+	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec2getLength);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec2getNormalized);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedOut", wrapVec2getNormalizedOut);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedUnpack", wrapVec2getNormalizedUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec2normalize);
+	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec2dot);
+	LuaBinder::pushLuaCFuncMethod(l, "unpack", wrapVec2unpack);
+	lua_settop(l, 0);
+}
+
+/// Serialize Vec3
+static void serializeVec3(LuaUserData& self, void* data, PtrSize& size)
+{
+	Vec3* obj = self.getData<Vec3>();
+	obj->serialize(data, size);
+}
+
+/// De-serialize Vec3
+static void deserializeVec3(const void* data, LuaUserData& self)
+{
+	ANKI_ASSERT(data);
+	Vec3* obj = self.getData<Vec3>();
+	::new(obj) Vec3();
+	obj->deserialize(data);
+}
+
+LuaUserDataTypeInfo luaUserDataTypeInfoVec3 = {
+	6804478823655046389, "Vec3", LuaUserData::computeSizeForGarbageCollected<Vec3>(), serializeVec3, deserializeVec3};
+
+template<>
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec3>()
+{
+	return luaUserDataTypeInfoVec3;
+}
+
+/// Pre-wrap constructor for Vec3.
+static inline int pwrapVec3Ctor0(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 0)))
+	{
+		return -1;
+	}
+
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3();
+
+	return 1;
+}
+
+/// Pre-wrap constructor for Vec3.
+static inline int pwrapVec3Ctor1(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	{
+		return -1;
+	}
+
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(arg0);
+
+	return 1;
+}
+
+/// Pre-wrap constructor for Vec3.
+static inline int pwrapVec3Ctor2(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
+	{
+		return -1;
+	}
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	{
+		return -1;
+	}
+
+	F32 arg1;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg1)))
+	{
+		return -1;
+	}
+
+	F32 arg2;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg2)))
+	{
+		return -1;
+	}
+
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, luaUserDataTypeInfoVec3.m_typeName);
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(arg0, arg1, arg2);
+
+	return 1;
+}
+
+/// Wrap constructors for Vec3.
+static int wrapVec3Ctor(lua_State* l)
+{
+	// Chose the right overload
+	const int argCount = lua_gettop(l);
+	int res = 0;
+	switch(argCount)
+	{
+	case 0:
+		res = pwrapVec3Ctor0(l);
+		break;
+	case 1:
+		res = pwrapVec3Ctor1(l);
+		break;
+	case 3:
+		res = pwrapVec3Ctor2(l);
+		break;
+	default:
+		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
+		res = -1;
+	}
+
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+static_assert(std::is_trivially_destructible<Vec3>::value, "Value types shouldn't need a destructor");
+
+/// Pre-wrap method Vec3::getX.
+static inline int pwrapVec3getX(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	F32 ret = (*self).x();
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec3::getX.
+static int wrapVec3getX(lua_State* l)
+{
+	int res = pwrapVec3getX(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getY.
+static inline int pwrapVec3getY(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	F32 ret = (*self).y();
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec3::getY.
+static int wrapVec3getY(lua_State* l)
+{
+	int res = pwrapVec3getY(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getZ.
+static inline int pwrapVec3getZ(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	F32 ret = (*self).z();
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec3::getZ.
+static int wrapVec3getZ(lua_State* l)
+{
+	int res = pwrapVec3getZ(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::setX.
+static inline int pwrapVec3setX(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self).x() = arg0;
+
+	return 0;
+}
+
+/// Wrap method Vec3::setX.
+static int wrapVec3setX(lua_State* l)
+{
+	int res = pwrapVec3setX(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::setY.
+static inline int pwrapVec3setY(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self).y() = arg0;
+
+	return 0;
+}
+
+/// Wrap method Vec3::setY.
+static int wrapVec3setY(lua_State* l)
+{
+	int res = pwrapVec3setY(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::setZ.
+static inline int pwrapVec3setZ(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self).z() = arg0;
+
+	return 0;
+}
+
+/// Wrap method Vec3::setZ.
+static int wrapVec3setZ(lua_State* l)
+{
+	int res = pwrapVec3setZ(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::setAll.
+static inline int pwrapVec3setAll(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 4)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	F32 arg1;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
+	{
+		return -1;
+	}
+
+	F32 arg2;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg2)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self) = Vec3(arg0, arg1, arg2);
+
+	return 0;
+}
+
+/// Wrap method Vec3::setAll.
+static int wrapVec3setAll(lua_State* l)
+{
+	int res = pwrapVec3setAll(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getAt.
+static inline int pwrapVec3getAt(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	U arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	F32 ret = (*self)[arg0];
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec3::getAt.
+static int wrapVec3getAt(lua_State* l)
+{
+	int res = pwrapVec3getAt(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::setAt.
+static inline int pwrapVec3setAt(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	U arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	F32 arg1;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self)[arg0] = arg1;
+
+	return 0;
+}
+
+/// Wrap method Vec3::setAt.
+static int wrapVec3setAt(lua_State* l)
+{
+	int res = pwrapVec3setAt(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator=.
+static inline int pwrapVec3copy(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	self->operator=(arg0);
+
+	return 0;
+}
+
+/// Wrap method Vec3::operator=.
+static int wrapVec3copy(lua_State* l)
+{
+	int res = pwrapVec3copy(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator+.
+static inline int pwrapVec3__add(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator+(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator+.
+static int wrapVec3__add(lua_State* l)
+{
+	int res = pwrapVec3__add(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator+ (out variant).
+static inline int pwrapVec3addOut(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator+(arg0);
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec3>() = ret;
+	lua_pushvalue(l, 3);
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator+ (out variant).
+static int wrapVec3addOut(lua_State* l)
+{
+	int res = pwrapVec3addOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator+ (unpack variant).
+static inline int pwrapVec3addUnpack(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator+(arg0);
+
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+
+	return 3;
+}
+
+/// Wrap method Vec3::operator+ (unpack variant).
+static int wrapVec3addUnpack(lua_State* l)
+{
+	int res = pwrapVec3addUnpack(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator-.
+static inline int pwrapVec3__sub(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator-(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator-.
+static int wrapVec3__sub(lua_State* l)
+{
+	int res = pwrapVec3__sub(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator- (out variant).
+static inline int pwrapVec3subOut(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator-(arg0);
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec3>() = ret;
+	lua_pushvalue(l, 3);
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator- (out variant).
+static int wrapVec3subOut(lua_State* l)
+{
+	int res = pwrapVec3subOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator- (unpack variant).
+static inline int pwrapVec3subUnpack(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator-(arg0);
+
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+
+	return 3;
+}
+
+/// Wrap method Vec3::operator- (unpack variant).
+static int wrapVec3subUnpack(lua_State* l)
+{
+	int res = pwrapVec3subUnpack(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator*.
+static inline int pwrapVec3__mul(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator*(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator*.
+static int wrapVec3__mul(lua_State* l)
+{
+	int res = pwrapVec3__mul(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator* (out variant).
+static inline int pwrapVec3mulOut(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator*(arg0);
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec3>() = ret;
+	lua_pushvalue(l, 3);
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator* (out variant).
+static int wrapVec3mulOut(lua_State* l)
+{
+	int res = pwrapVec3mulOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator* (unpack variant).
+static inline int pwrapVec3mulUnpack(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator*(arg0);
+
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+
+	return 3;
+}
+
+/// Wrap method Vec3::operator* (unpack variant).
+static int wrapVec3mulUnpack(lua_State* l)
+{
+	int res = pwrapVec3mulUnpack(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator/.
+static inline int pwrapVec3__div(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator/(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method Vec3::operator/.
+static int wrapVec3__div(lua_State* l)
+{
+	int res = pwrapVec3__div(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::operator/ (out variant).
+static inline int pwrapVec3divOut(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
 
-	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
 	{
 		return -1;
 	}
 
-	F32 arg2;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg2)))
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
 	{
 		return -1;
 	}
 
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
 	// Call the method
-	(*self) = Vec3(arg0, arg1, arg2);
+	Vec3 ret = self->operator/(arg0);
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec3>() = ret;
+	lua_pushvalue(l, 3);
 
+	return 1;
+}
+
+/// Wrap method Vec3::operator/ (out variant).
+static int wrapVec3divOut(lua_State* l)
+{
+	int res = pwrapVec3divOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
 	return 0;
 }
 
-/// Wrap method Vec3::setAll.
-static int wrapVec3setAll(lua_State* l)
+/// Pre-wrap method Vec3::operator/ (unpack variant).
+static inline int pwrapVec3divUnpack(lua_State* l)
 {
-	int res = pwrapVec3setAll(l);
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
+
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	// Call the method
+	Vec3 ret = self->operator/(arg0);
+
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+
+	return 3;
+}
+
+/// Wrap method Vec3::operator/ (unpack variant).
+static int wrapVec3divUnpack(lua_State* l)
+{
+	int res = pwrapVec3divUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1614,8 +3062,8 @@ static int wrapVec3setAll(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getAt.
-static inline int pwrapVec3getAt(lua_State* l)
+/// Pre-wrap method Vec3::operator==.
+static inline int pwrapVec3__eq(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1638,25 +3086,28 @@ static inline int pwrapVec3getAt(lua_State* l)
 	Vec3* self = ud->getData<Vec3>();
 
 	// Pop arguments
-	U arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
 	{
 		return -1;
 	}
 
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
 	// Call the method
-	F32 ret = (*self)[arg0];
+	Bool ret = self->operator==(arg0);
 
 	// Push return value
-	lua_pushnumber(l, ret);
+	lua_pushboolean(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::getAt.
-static int wrapVec3getAt(lua_State* l)
+/// Wrap method Vec3::operator==.
+static int wrapVec3__eq(lua_State* l)
 {
-	int res = pwrapVec3getAt(l);
+	int res = pwrapVec3__eq(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1666,8 +3117,8 @@ static int wrapVec3getAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::setAt.
-static inline int pwrapVec3setAt(lua_State* l)
+/// Pre-wrap method Vec3::getLength.
+static inline int pwrapVec3getLength(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1676,7 +3127,7 @@ static inline int pwrapVec3setAt(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
@@ -1689,29 +3140,70 @@ static inline int pwrapVec3setAt(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
-	// Pop arguments
-	U arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	// Call the method
+	F32 ret = self->getLength();
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec3::getLength.
+static int wrapVec3getLength(lua_State* l)
+{
+	int res = pwrapVec3getLength(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getNormalized.
+static inline int pwrapVec3getNormalized(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
 	{
 		return -1;
 	}
 
+	Vec3* self = ud->getData<Vec3>();
+
 	// Call the method
-	(*self)[arg0] = arg1;
+	Vec3 ret = self->getNormalized();
 
-	return 0;
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec3::setAt.
-static int wrapVec3setAt(lua_State* l)
+/// Wrap method Vec3::getNormalized.
+static int wrapVec3getNormalized(lua_State* l)
 {
-	int res = pwrapVec3setAt(l);
+	int res = pwrapVec3getNormalized(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1721,8 +3213,8 @@ static int wrapVec3setAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator=.
-static inline int pwrapVec3copy(lua_State* l)
+/// Pre-wrap method Vec3::getNormalized (out variant).
+static inline int pwrapVec3getNormalizedOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1744,26 +3236,115 @@ static inline int pwrapVec3copy(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
-	// Pop arguments
+	// Call the method
+	Vec3 ret = self->getNormalized();
+
+	// Write the return value to the "out" argument
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
 	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
+	*ud->getData<Vec3>() = ret;
+	lua_pushvalue(l, 2);
+
+	return 1;
+}
+
+/// Wrap method Vec3::getNormalized (out variant).
+static int wrapVec3getNormalizedOut(lua_State* l)
+{
+	int res = pwrapVec3getNormalizedOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::getNormalized (unpack variant).
+static inline int pwrapVec3getNormalizedUnpack(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
 
 	// Call the method
-	self->operator=(arg0);
+	Vec3 ret = self->getNormalized();
+
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+
+	return 3;
+}
+
+/// Wrap method Vec3::getNormalized (unpack variant).
+static int wrapVec3getNormalizedUnpack(lua_State* l)
+{
+	int res = pwrapVec3getNormalizedUnpack(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec3::normalize.
+static inline int pwrapVec3normalize(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	{
+		return -1;
+	}
+
+	Vec3* self = ud->getData<Vec3>();
+
+	// Call the method
+	self->normalize();
 
 	return 0;
 }
 
-/// Wrap method Vec3::operator=.
-static int wrapVec3copy(lua_State* l)
+/// Wrap method Vec3::normalize.
+static int wrapVec3normalize(lua_State* l)
 {
-	int res = pwrapVec3copy(l);
+	int res = pwrapVec3normalize(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1773,8 +3354,8 @@ static int wrapVec3copy(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator+.
-static inline int pwrapVec3__add(lua_State* l)
+/// Pre-wrap method Vec3::dot.
+static inline int pwrapVec3dot(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1807,24 +3388,18 @@ static inline int pwrapVec3__add(lua_State* l)
 	const Vec3& arg0(*iarg0);
 
 	// Call the method
-	Vec3 ret = self->operator+(arg0);
+	F32 ret = self->dot(arg0);
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	lua_pushnumber(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator+.
-static int wrapVec3__add(lua_State* l)
+/// Wrap method Vec3::dot.
+static int wrapVec3dot(lua_State* l)
 {
-	int res = pwrapVec3__add(l);
+	int res = pwrapVec3dot(l);
 	if(res >= 0)
 	{
 		return res;
@@ -1834,8 +3409,8 @@ static int wrapVec3__add(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator-.
-static inline int pwrapVec3__sub(lua_State* l)
+/// Pre-wrap method Vec3::unpack.
+static inline int pwrapVec3unpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1844,7 +3419,7 @@ static inline int pwrapVec3__sub(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
@@ -1857,46 +3432,153 @@ static inline int pwrapVec3__sub(lua_State* l)
 
 	Vec3* self = ud->getData<Vec3>();
 
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	// Push the components
+	lua_pushnumber(l, lua_Number((*self).x()));
+	lua_pushnumber(l, lua_Number((*self).y()));
+	lua_pushnumber(l, lua_Number((*self).z()));
+
+	return 3;
+}
+
+/// Wrap method Vec3::unpack.
+static int wrapVec3unpack(lua_State* l)
+{
+	int res = pwrapVec3unpack(l);
+	if(res >= 0)
 	{
-		return -1;
+		return res;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
+	lua_error(l);
+	return 0;
+}
 
-	// Call the method
-	Vec3 ret = self->operator-(arg0);
+/// Wrap class Vec3.
+static inline void wrapVec3(lua_State* l)
+{
+	LuaBinder::createClass(l, &luaUserDataTypeInfoVec3);
+	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec3.m_typeName, "new", wrapVec3Ctor);
+	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec3getX);
+	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec3getY);
+	LuaBinder::pushLuaCFuncMethod(l, "getZ", wrapVec3getZ);
+	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec3setX);
+	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec3setY);
+	LuaBinder::pushLuaCFuncMethod(l, "setZ", wrapVec3setZ);
+	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec3setAll);
+	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec3getAt);
+	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec3setAt);
+	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec3copy);
+	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec3__add);
+	LuaBinder::pushLuaCFuncMethod(l, "addOut", wrapVec3addOut);
+	LuaBinder::pushLuaCFuncMethod(l, "addUnpack", wrapVec3addUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec3__sub);
+	LuaBinder::pushLuaCFuncMethod(l, "subOut", wrapVec3subOut);
+	LuaBinder::pushLuaCFuncMethod(l, "subUnpack", wrapVec3subUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec3__mul);
+	LuaBinder::pushLuaCFuncMethod(l, "mulOut", wrapVec3mulOut);
+	LuaBinder::pushLuaCFuncMethod(l, "mulUnpack", wrapVec3mulUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec3__div);
+	LuaBinder::pushLuaCFuncMethod(l, "divOut", wrapVec3divOut);
+	LuaBinder::pushLuaCFuncMethod(l, "divUnpack", wrapVec3divUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec3__eq);
+	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec3getLength);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec3getNormalized);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedOut", wrapVec3getNormalizedOut);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedUnpack", wrapVec3getNormalizedUnpack);
+	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec3normalize);
+	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec3dot);
+	LuaBinder::pushLuaCFuncMethod(l, "unpack", wrapVec3unpack);
+	lua_settop(l, 0);
+}
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+/// Serialize Vec4
+static void serializeVec4(LuaUserData& self, void* data, PtrSize& size)
+{
+	Vec4* obj = self.getData<Vec4>();
+	obj->serialize(data, size);
+}
+
+/// De-serialize Vec4
+static void deserializeVec4(const void* data, LuaUserData& self)
+{
+	ANKI_ASSERT(data);
+	Vec4* obj = self.getData<Vec4>();
+	::new(obj) Vec4();
+	obj->deserialize(data);
+}
+
+LuaUserDataTypeInfo luaUserDataTypeInfoVec4 = {
+	6804478823655046386, "Vec4", LuaUserData::computeSizeForGarbageCollected<Vec4>(), serializeVec4, deserializeVec4};
+
+template<>
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec4>()
+{
+	return luaUserDataTypeInfoVec4;
+}
+
+/// Pre-wrap constructor for Vec4.
+static inline int pwrapVec4Ctor0(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 0)))
+	{
+		return -1;
+	}
+
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
 	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
+	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
 	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4();
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator-.
-static int wrapVec3__sub(lua_State* l)
+/// Pre-wrap constructor for Vec4.
+static inline int pwrapVec4Ctor1(lua_State* l)
 {
-	int res = pwrapVec3__sub(l);
-	if(res >= 0)
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
-		return res;
+		return -1;
 	}
 
-	lua_error(l);
-	return 0;
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	{
+		return -1;
+	}
+
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(arg0);
+
+	return 1;
 }
 
-/// Pre-wrap method Vec3::operator*.
-static inline int pwrapVec3__mul(lua_State* l)
+/// Pre-wrap constructor for Vec4.
+static inline int pwrapVec4Ctor2(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1905,48 +3587,70 @@ static inline int pwrapVec3__mul(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 4)))
 	{
 		return -1;
 	}
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	F32 arg1;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg1)))
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
+	F32 arg2;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg2)))
+	{
+		return -1;
+	}
 
-	// Call the method
-	Vec3 ret = self->operator*(arg0);
+	F32 arg3;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg3)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
 	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
+	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
 	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(arg0, arg1, arg2, arg3);
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator*.
-static int wrapVec3__mul(lua_State* l)
+/// Wrap constructors for Vec4.
+static int wrapVec4Ctor(lua_State* l)
 {
-	int res = pwrapVec3__mul(l);
+	// Chose the right overload
+	const int argCount = lua_gettop(l);
+	int res = 0;
+	switch(argCount)
+	{
+	case 0:
+		res = pwrapVec4Ctor0(l);
+		break;
+	case 1:
+		res = pwrapVec4Ctor1(l);
+		break;
+	case 4:
+		res = pwrapVec4Ctor2(l);
+		break;
+	default:
+		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
+		res = -1;
+	}
+
 	if(res >= 0)
 	{
 		return res;
@@ -1956,8 +3660,10 @@ static int wrapVec3__mul(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator/.
-static inline int pwrapVec3__div(lua_State* l)
+static_assert(std::is_trivially_destructible<Vec4>::value, "Value types shouldn't need a destructor");
+
+/// Pre-wrap method Vec4::getX.
+static inline int pwrapVec4getX(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -1966,48 +3672,32 @@ static inline int pwrapVec3__div(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
-	{
-		return -1;
-	}
-
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
+	Vec4* self = ud->getData<Vec4>();
 
 	// Call the method
-	Vec3 ret = self->operator/(arg0);
+	F32 ret = (*self).x();
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	// Push return value
+	lua_pushnumber(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator/.
-static int wrapVec3__div(lua_State* l)
+/// Wrap method Vec4::getX.
+static int wrapVec4getX(lua_State* l)
 {
-	int res = pwrapVec3__div(l);
+	int res = pwrapVec4getX(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2017,8 +3707,8 @@ static int wrapVec3__div(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::operator==.
-static inline int pwrapVec3__eq(lua_State* l)
+/// Pre-wrap method Vec4::getY.
+static inline int pwrapVec4getY(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2027,42 +3717,32 @@ static inline int pwrapVec3__eq(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
-	{
-		return -1;
-	}
-
-	Vec3* self = ud->getData<Vec3>();
-
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
+	Vec4* self = ud->getData<Vec4>();
 
 	// Call the method
-	Bool ret = self->operator==(arg0);
+	F32 ret = (*self).y();
 
 	// Push return value
-	lua_pushboolean(l, ret);
+	lua_pushnumber(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::operator==.
-static int wrapVec3__eq(lua_State* l)
+/// Wrap method Vec4::getY.
+static int wrapVec4getY(lua_State* l)
 {
-	int res = pwrapVec3__eq(l);
+	int res = pwrapVec4getY(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2072,8 +3752,8 @@ static int wrapVec3__eq(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getLength.
-static inline int pwrapVec3getLength(lua_State* l)
+/// Pre-wrap method Vec4::getZ.
+static inline int pwrapVec4getZ(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2088,15 +3768,15 @@ static inline int pwrapVec3getLength(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec4* self = ud->getData<Vec4>();
 
 	// Call the method
-	F32 ret = self->getLength();
+	F32 ret = (*self).z();
 
 	// Push return value
 	lua_pushnumber(l, ret);
@@ -2104,10 +3784,10 @@ static inline int pwrapVec3getLength(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec3::getLength.
-static int wrapVec3getLength(lua_State* l)
+/// Wrap method Vec4::getZ.
+static int wrapVec4getZ(lua_State* l)
 {
-	int res = pwrapVec3getLength(l);
+	int res = pwrapVec4getZ(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2117,8 +3797,8 @@ static int wrapVec3getLength(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::getNormalized.
-static inline int pwrapVec3getNormalized(lua_State* l)
+/// Pre-wrap method Vec4::getW.
+static inline int pwrapVec4getW(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2133,32 +3813,26 @@ static inline int pwrapVec3getNormalized(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec4* self = ud->getData<Vec4>();
 
 	// Call the method
-	Vec3 ret = self->getNormalized();
+	F32 ret = (*self).w();
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec3");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
-	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+	lua_pushnumber(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec3::getNormalized.
-static int wrapVec3getNormalized(lua_State* l)
+/// Wrap method Vec4::getW.
+static int wrapVec4getW(lua_State* l)
 {
-	int res = pwrapVec3getNormalized(l);
+	int res = pwrapVec4getW(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2168,8 +3842,8 @@ static int wrapVec3getNormalized(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::normalize.
-static inline int pwrapVec3normalize(lua_State* l)
+/// Pre-wrap method Vec4::setX.
+static inline int pwrapVec4setX(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2178,29 +3852,36 @@ static inline int pwrapVec3normalize(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec4* self = ud->getData<Vec4>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
 
 	// Call the method
-	self->normalize();
+	(*self).x() = arg0;
 
 	return 0;
 }
 
-/// Wrap method Vec3::normalize.
-static int wrapVec3normalize(lua_State* l)
+/// Wrap method Vec4::setX.
+static int wrapVec4setX(lua_State* l)
 {
-	int res = pwrapVec3normalize(l);
+	int res = pwrapVec4setX(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2210,8 +3891,8 @@ static int wrapVec3normalize(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec3::dot.
-static inline int pwrapVec3dot(lua_State* l)
+/// Pre-wrap method Vec4::setY.
+static inline int pwrapVec4setY(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2226,36 +3907,30 @@ static inline int pwrapVec3dot(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec3, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	Vec3* self = ud->getData<Vec3>();
+	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
 	{
 		return -1;
 	}
 
-	Vec3* iarg0 = ud->getData<Vec3>();
-	const Vec3& arg0(*iarg0);
-
 	// Call the method
-	F32 ret = self->dot(arg0);
-
-	// Push return value
-	lua_pushnumber(l, ret);
+	(*self).y() = arg0;
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method Vec3::dot.
-static int wrapVec3dot(lua_State* l)
+/// Wrap method Vec4::setY.
+static int wrapVec4setY(lua_State* l)
 {
-	int res = pwrapVec3dot(l);
+	int res = pwrapVec4setY(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2265,61 +3940,8 @@ static int wrapVec3dot(lua_State* l)
 	return 0;
 }
 
-/// Wrap class Vec3.
-static inline void wrapVec3(lua_State* l)
-{
-	LuaBinder::createClass(l, &luaUserDataTypeInfoVec3);
-	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec3.m_typeName, "new", wrapVec3Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec3Dtor);
-	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec3getX);
-	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec3getY);
-	LuaBinder::pushLuaCFuncMethod(l, "getZ", wrapVec3getZ);
-	LuaBinder::pushLuaCFuncMethod(l, "setX", wrapVec3setX);
-	LuaBinder::pushLuaCFuncMethod(l, "setY", wrapVec3setY);
-	LuaBinder::pushLuaCFuncMethod(l, "setZ", wrapVec3setZ);
-	LuaBinder::pushLuaCFuncMethod(l, "setAll", wrapVec3setAll);
-	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapVec3getAt);
-	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec3setAt);
-	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec3copy);
-	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec3__add);
-	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec3__sub);
-	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec3__mul);
-	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec3__div);
-	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec3__eq);
-	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec3getLength);
-	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec3getNormalized);
-	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec3normalize);
-	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec3dot);
-	lua_settop(l, 0);
-}
-
-/// Serialize Vec4
-static void serializeVec4(LuaUserData& self, void* data, PtrSize& size)
-{
-	Vec4* obj = self.getData<Vec4>();
-	obj->serialize(data, size);
-}
-
-/// De-serialize Vec4
-static void deserializeVec4(const void* data, LuaUserData& self)
-{
-	ANKI_ASSERT(data);
-	Vec4* obj = self.getData<Vec4>();
-	::new(obj) Vec4();
-	obj->deserialize(data);
-}
-
-LuaUserDataTypeInfo luaUserDataTypeInfoVec4 = {
-	6804478823655046386, "Vec4", LuaUserData::computeSizeForGarbageCollected<Vec4>(), serializeVec4, deserializeVec4};
-
-template<>
-const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<Vec4>()
-{
-	return luaUserDataTypeInfoVec4;
-}
-
-/// Pre-wrap constructor for Vec4.
-static inline int pwrapVec4Ctor0(lua_State* l)
+/// Pre-wrap method Vec4::setZ.
+static inline int pwrapVec4setZ(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2328,25 +3950,47 @@ static inline int pwrapVec4Ctor0(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 0)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4();
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
 
-	return 1;
+	Vec4* self = ud->getData<Vec4>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	(*self).z() = arg0;
+
+	return 0;
 }
 
-/// Pre-wrap constructor for Vec4.
-static inline int pwrapVec4Ctor1(lua_State* l)
+/// Wrap method Vec4::setZ.
+static int wrapVec4setZ(lua_State* l)
+{
+	int res = pwrapVec4setZ(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::setW.
+static inline int pwrapVec4setW(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2355,32 +3999,47 @@ static inline int pwrapVec4Ctor1(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Pop arguments
+	F32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
 	{
 		return -1;
 	}
 
-	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	// Call the method
+	(*self).w() = arg0;
+
+	return 0;
+}
+
+/// Wrap method Vec4::setW.
+static int wrapVec4setW(lua_State* l)
+{
+	int res = pwrapVec4setW(l);
+	if(res >= 0)
 	{
-		return -1;
+		return res;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(arg0);
-
-	return 1;
+	lua_error(l);
+	return 0;
 }
 
-/// Pre-wrap constructor for Vec4.
-static inline int pwrapVec4Ctor2(lua_State* l)
+/// Pre-wrap method Vec4::setAll.
+static inline int pwrapVec4setAll(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2389,70 +4048,54 @@ static inline int pwrapVec4Ctor2(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 4)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 5)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
+	Vec4* self = ud->getData<Vec4>();
+
 	// Pop arguments
 	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 1, arg0)))
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
 	{
 		return -1;
 	}
 
 	F32 arg1;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
 	{
 		return -1;
 	}
 
 	F32 arg2;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg2)))
 	{
 		return -1;
 	}
 
 	F32 arg3;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg3)))
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 5, arg3)))
 	{
 		return -1;
 	}
 
-	// Create user data
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, luaUserDataTypeInfoVec4.m_typeName);
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(arg0, arg1, arg2, arg3);
+	// Call the method
+	(*self) = Vec4(arg0, arg1, arg2, arg3);
 
-	return 1;
+	return 0;
 }
 
-/// Wrap constructors for Vec4.
-static int wrapVec4Ctor(lua_State* l)
+/// Wrap method Vec4::setAll.
+static int wrapVec4setAll(lua_State* l)
 {
-	// Chose the right overload
-	const int argCount = lua_gettop(l);
-	int res = 0;
-	switch(argCount)
-	{
-	case 0:
-		res = pwrapVec4Ctor0(l);
-		break;
-	case 1:
-		res = pwrapVec4Ctor1(l);
-		break;
-	case 4:
-		res = pwrapVec4Ctor2(l);
-		break;
-	default:
-		lua_pushfstring(l, "Wrong overloaded new. Wrong number of arguments: %d", argCount);
-		res = -1;
-	}
-
+	int res = pwrapVec4setAll(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2462,8 +4105,8 @@ static int wrapVec4Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Vec4.
-static int wrapVec4Dtor(lua_State* l)
+/// Pre-wrap method Vec4::getAt.
+static inline int pwrapVec4getAt(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2472,50 +4115,28 @@ static int wrapVec4Dtor(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud)))
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
 	{
 		return -1;
 	}
 
-	if(ud->isGarbageCollected())
-	{
-		Vec4* inst = ud->getData<Vec4>();
-		inst->~Vec4();
-	}
-
-	return 0;
-}
-
-/// Pre-wrap method Vec4::getX.
-static inline int pwrapVec4getX(lua_State* l)
-{
-	LuaUserData* ud;
-	(void)ud;
-	void* voidp;
-	(void)voidp;
-	PtrSize size;
-	(void)size;
-
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
-	{
-		return -1;
-	}
+	Vec4* self = ud->getData<Vec4>();
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	// Pop arguments
+	U arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
 	{
 		return -1;
 	}
 
-	Vec4* self = ud->getData<Vec4>();
-
 	// Call the method
-	F32 ret = (*self).x();
+	F32 ret = (*self)[arg0];
 
 	// Push return value
 	lua_pushnumber(l, ret);
@@ -2523,10 +4144,10 @@ static inline int pwrapVec4getX(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec4::getX.
-static int wrapVec4getX(lua_State* l)
+/// Wrap method Vec4::getAt.
+static int wrapVec4getAt(lua_State* l)
 {
-	int res = pwrapVec4getX(l);
+	int res = pwrapVec4getAt(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2536,8 +4157,8 @@ static int wrapVec4getX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getY.
-static inline int pwrapVec4getY(lua_State* l)
+/// Pre-wrap method Vec4::setAt.
+static inline int pwrapVec4setAt(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2546,7 +4167,7 @@ static inline int pwrapVec4getY(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -2559,19 +4180,29 @@ static inline int pwrapVec4getY(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
-	// Call the method
-	F32 ret = (*self).y();
+	// Pop arguments
+	U arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, ret);
+	F32 arg1;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
+	{
+		return -1;
+	}
 
-	return 1;
+	// Call the method
+	(*self)[arg0] = arg1;
+
+	return 0;
 }
 
-/// Wrap method Vec4::getY.
-static int wrapVec4getY(lua_State* l)
+/// Wrap method Vec4::setAt.
+static int wrapVec4setAt(lua_State* l)
 {
-	int res = pwrapVec4getY(l);
+	int res = pwrapVec4setAt(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2581,8 +4212,8 @@ static int wrapVec4getY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getZ.
-static inline int pwrapVec4getZ(lua_State* l)
+/// Pre-wrap method Vec4::operator=.
+static inline int pwrapVec4copy(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2591,7 +4222,7 @@ static inline int pwrapVec4getZ(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
@@ -2604,19 +4235,26 @@ static inline int pwrapVec4getZ(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
-	// Call the method
-	F32 ret = (*self).z();
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushnumber(l, ret);
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
 
-	return 1;
+	// Call the method
+	self->operator=(arg0);
+
+	return 0;
 }
 
-/// Wrap method Vec4::getZ.
-static int wrapVec4getZ(lua_State* l)
+/// Wrap method Vec4::operator=.
+static int wrapVec4copy(lua_State* l)
 {
-	int res = pwrapVec4getZ(l);
+	int res = pwrapVec4copy(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2626,8 +4264,8 @@ static int wrapVec4getZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getW.
-static inline int pwrapVec4getW(lua_State* l)
+/// Pre-wrap method Vec4::operator+.
+static inline int pwrapVec4__add(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2636,7 +4274,7 @@ static inline int pwrapVec4getW(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
@@ -2649,19 +4287,35 @@ static inline int pwrapVec4getW(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
+
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	F32 ret = (*self).w();
+	Vec4 ret = self->operator+(arg0);
 
 	// Push return value
-	lua_pushnumber(l, ret);
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec4");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec4::getW.
-static int wrapVec4getW(lua_State* l)
+/// Wrap method Vec4::operator+.
+static int wrapVec4__add(lua_State* l)
 {
-	int res = pwrapVec4getW(l);
+	int res = pwrapVec4__add(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2671,8 +4325,8 @@ static int wrapVec4getW(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setX.
-static inline int pwrapVec4setX(lua_State* l)
+/// Pre-wrap method Vec4::operator+ (out variant).
+static inline int pwrapVec4addOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2681,7 +4335,7 @@ static inline int pwrapVec4setX(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -2695,22 +4349,35 @@ static inline int pwrapVec4setX(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).x() = arg0;
+	Vec4 ret = self->operator+(arg0);
 
-	return 0;
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec4>() = ret;
+	lua_pushvalue(l, 3);
+
+	return 1;
 }
 
-/// Wrap method Vec4::setX.
-static int wrapVec4setX(lua_State* l)
+/// Wrap method Vec4::operator+ (out variant).
+static int wrapVec4addOut(lua_State* l)
 {
-	int res = pwrapVec4setX(l);
+	int res = pwrapVec4addOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2720,8 +4387,8 @@ static int wrapVec4setX(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setY.
-static inline int pwrapVec4setY(lua_State* l)
+/// Pre-wrap method Vec4::operator+ (unpack variant).
+static inline int pwrapVec4addUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2744,22 +4411,31 @@ static inline int pwrapVec4setY(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).y() = arg0;
+	Vec4 ret = self->operator+(arg0);
 
-	return 0;
-}
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+	lua_pushnumber(l, lua_Number(ret.w()));
 
-/// Wrap method Vec4::setY.
-static int wrapVec4setY(lua_State* l)
+	return 4;
+}
+
+/// Wrap method Vec4::operator+ (unpack variant).
+static int wrapVec4addUnpack(lua_State* l)
 {
-	int res = pwrapVec4setY(l);
+	int res = pwrapVec4addUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2769,8 +4445,8 @@ static int wrapVec4setY(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setZ.
-static inline int pwrapVec4setZ(lua_State* l)
+/// Pre-wrap method Vec4::operator-.
+static inline int pwrapVec4__sub(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2793,22 +4469,34 @@ static inline int pwrapVec4setZ(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).z() = arg0;
+	Vec4 ret = self->operator-(arg0);
 
-	return 0;
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec4");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+
+	return 1;
 }
 
-/// Wrap method Vec4::setZ.
-static int wrapVec4setZ(lua_State* l)
+/// Wrap method Vec4::operator-.
+static int wrapVec4__sub(lua_State* l)
 {
-	int res = pwrapVec4setZ(l);
+	int res = pwrapVec4__sub(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2818,8 +4506,8 @@ static int wrapVec4setZ(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setW.
-static inline int pwrapVec4setW(lua_State* l)
+/// Pre-wrap method Vec4::operator- (out variant).
+static inline int pwrapVec4subOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2828,7 +4516,7 @@ static inline int pwrapVec4setW(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -2842,22 +4530,35 @@ static inline int pwrapVec4setW(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	(*self).w() = arg0;
+	Vec4 ret = self->operator-(arg0);
 
-	return 0;
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec4>() = ret;
+	lua_pushvalue(l, 3);
+
+	return 1;
 }
 
-/// Wrap method Vec4::setW.
-static int wrapVec4setW(lua_State* l)
+/// Wrap method Vec4::operator- (out variant).
+static int wrapVec4subOut(lua_State* l)
 {
-	int res = pwrapVec4setW(l);
+	int res = pwrapVec4subOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2867,8 +4568,8 @@ static int wrapVec4setW(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setAll.
-static inline int pwrapVec4setAll(lua_State* l)
+/// Pre-wrap method Vec4::operator- (unpack variant).
+static inline int pwrapVec4subUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2877,7 +4578,7 @@ static inline int pwrapVec4setAll(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 5)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
@@ -2891,40 +4592,31 @@ static inline int pwrapVec4setAll(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	F32 arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
-	{
-		return -1;
-	}
-
-	F32 arg1;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
-	{
-		return -1;
-	}
-
-	F32 arg2;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg2)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
-	F32 arg3;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 5, arg3)))
-	{
-		return -1;
-	}
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	(*self) = Vec4(arg0, arg1, arg2, arg3);
+	Vec4 ret = self->operator-(arg0);
 
-	return 0;
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+	lua_pushnumber(l, lua_Number(ret.w()));
+
+	return 4;
 }
 
-/// Wrap method Vec4::setAll.
-static int wrapVec4setAll(lua_State* l)
+/// Wrap method Vec4::operator- (unpack variant).
+static int wrapVec4subUnpack(lua_State* l)
 {
-	int res = pwrapVec4setAll(l);
+	int res = pwrapVec4subUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2934,8 +4626,8 @@ static int wrapVec4setAll(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getAt.
-static inline int pwrapVec4getAt(lua_State* l)
+/// Pre-wrap method Vec4::operator*.
+static inline int pwrapVec4__mul(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -2958,25 +4650,34 @@ static inline int pwrapVec4getAt(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	U arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
 	// Call the method
-	F32 ret = (*self)[arg0];
+	Vec4 ret = self->operator*(arg0);
 
 	// Push return value
-	lua_pushnumber(l, ret);
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec4");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec4::getAt.
-static int wrapVec4getAt(lua_State* l)
+/// Wrap method Vec4::operator*.
+static int wrapVec4__mul(lua_State* l)
 {
-	int res = pwrapVec4getAt(l);
+	int res = pwrapVec4__mul(l);
 	if(res >= 0)
 	{
 		return res;
@@ -2986,8 +4687,8 @@ static int wrapVec4getAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::setAt.
-static inline int pwrapVec4setAt(lua_State* l)
+/// Pre-wrap method Vec4::operator* (out variant).
+static inline int pwrapVec4mulOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3010,28 +4711,35 @@ static inline int pwrapVec4setAt(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Pop arguments
-	U arg0;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
-	F32 arg1;
-	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
+	Vec4* iarg0 = ud->getData<Vec4>();
+	const Vec4& arg0(*iarg0);
+
+	// Call the method
+	Vec4 ret = self->operator*(arg0);
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)))
 	{
 		return -1;
 	}
 
-	// Call the method
-	(*self)[arg0] = arg1;
+	*ud->getData<Vec4>() = ret;
+	lua_pushvalue(l, 3);
 
-	return 0;
+	return 1;
 }
 
-/// Wrap method Vec4::setAt.
-static int wrapVec4setAt(lua_State* l)
+/// Wrap method Vec4::operator* (out variant).
+static int wrapVec4mulOut(lua_State* l)
 {
-	int res = pwrapVec4setAt(l);
+	int res = pwrapVec4mulOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3041,8 +4749,8 @@ static int wrapVec4setAt(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator=.
-static inline int pwrapVec4copy(lua_State* l)
+/// Pre-wrap method Vec4::operator* (unpack variant).
+static inline int pwrapVec4mulUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3075,15 +4783,21 @@ static inline int pwrapVec4copy(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	self->operator=(arg0);
+	Vec4 ret = self->operator*(arg0);
 
-	return 0;
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+	lua_pushnumber(l, lua_Number(ret.w()));
+
+	return 4;
 }
 
-/// Wrap method Vec4::operator=.
-static int wrapVec4copy(lua_State* l)
+/// Wrap method Vec4::operator* (unpack variant).
+static int wrapVec4mulUnpack(lua_State* l)
 {
-	int res = pwrapVec4copy(l);
+	int res = pwrapVec4mulUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3093,8 +4807,8 @@ static int wrapVec4copy(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator+.
-static inline int pwrapVec4__add(lua_State* l)
+/// Pre-wrap method Vec4::operator/.
+static inline int pwrapVec4__div(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3127,7 +4841,7 @@ static inline int pwrapVec4__add(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	Vec4 ret = self->operator+(arg0);
+	Vec4 ret = self->operator/(arg0);
 
 	// Push return value
 	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
@@ -3141,10 +4855,10 @@ static inline int pwrapVec4__add(lua_State* l)
 	return 1;
 }
 
-/// Wrap method Vec4::operator+.
-static int wrapVec4__add(lua_State* l)
+/// Wrap method Vec4::operator/.
+static int wrapVec4__div(lua_State* l)
 {
-	int res = pwrapVec4__add(l);
+	int res = pwrapVec4__div(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3154,8 +4868,8 @@ static int wrapVec4__add(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator-.
-static inline int pwrapVec4__sub(lua_State* l)
+/// Pre-wrap method Vec4::operator/ (out variant).
+static inline int pwrapVec4divOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3164,7 +4878,7 @@ static inline int pwrapVec4__sub(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
@@ -3188,24 +4902,25 @@ static inline int pwrapVec4__sub(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	Vec4 ret = self->operator-(arg0);
+	Vec4 ret = self->operator/(arg0);
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
+	// Write the return value to the "out" argument
 	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec4>() = ret;
+	lua_pushvalue(l, 3);
 
 	return 1;
 }
 
-/// Wrap method Vec4::operator-.
-static int wrapVec4__sub(lua_State* l)
+/// Wrap method Vec4::operator/ (out variant).
+static int wrapVec4divOut(lua_State* l)
 {
-	int res = pwrapVec4__sub(l);
+	int res = pwrapVec4divOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3215,8 +4930,8 @@ static int wrapVec4__sub(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator*.
-static inline int pwrapVec4__mul(lua_State* l)
+/// Pre-wrap method Vec4::operator/ (unpack variant).
+static inline int pwrapVec4divUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3249,24 +4964,21 @@ static inline int pwrapVec4__mul(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	Vec4 ret = self->operator*(arg0);
+	Vec4 ret = self->operator/(arg0);
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+	lua_pushnumber(l, lua_Number(ret.w()));
 
-	return 1;
+	return 4;
 }
 
-/// Wrap method Vec4::operator*.
-static int wrapVec4__mul(lua_State* l)
+/// Wrap method Vec4::operator/ (unpack variant).
+static int wrapVec4divUnpack(lua_State* l)
 {
-	int res = pwrapVec4__mul(l);
+	int res = pwrapVec4divUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3276,8 +4988,8 @@ static int wrapVec4__mul(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator/.
-static inline int pwrapVec4__div(lua_State* l)
+/// Pre-wrap method Vec4::operator==.
+static inline int pwrapVec4__eq(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3310,24 +5022,63 @@ static inline int pwrapVec4__div(lua_State* l)
 	const Vec4& arg0(*iarg0);
 
 	// Call the method
-	Vec4 ret = self->operator/(arg0);
+	Bool ret = self->operator==(arg0);
 
 	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	lua_pushboolean(l, ret);
 
 	return 1;
 }
 
-/// Wrap method Vec4::operator/.
-static int wrapVec4__div(lua_State* l)
+/// Wrap method Vec4::operator==.
+static int wrapVec4__eq(lua_State* l)
+{
+	int res = pwrapVec4__eq(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method Vec4::getLength.
+static inline int pwrapVec4getLength(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Call the method
+	F32 ret = self->getLength();
+
+	// Push return value
+	lua_pushnumber(l, ret);
+
+	return 1;
+}
+
+/// Wrap method Vec4::getLength.
+static int wrapVec4getLength(lua_State* l)
 {
-	int res = pwrapVec4__div(l);
+	int res = pwrapVec4getLength(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3337,8 +5088,8 @@ static int wrapVec4__div(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::operator==.
-static inline int pwrapVec4__eq(lua_State* l)
+/// Pre-wrap method Vec4::getNormalized.
+static inline int pwrapVec4getNormalized(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3347,7 +5098,7 @@ static inline int pwrapVec4__eq(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
@@ -3360,29 +5111,25 @@ static inline int pwrapVec4__eq(lua_State* l)
 
 	Vec4* self = ud->getData<Vec4>();
 
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
-	{
-		return -1;
-	}
-
-	Vec4* iarg0 = ud->getData<Vec4>();
-	const Vec4& arg0(*iarg0);
-
 	// Call the method
-	Bool ret = self->operator==(arg0);
+	Vec4 ret = self->getNormalized();
 
 	// Push return value
-	lua_pushboolean(l, ret);
+	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec4");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
+	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
 
 	return 1;
 }
 
-/// Wrap method Vec4::operator==.
-static int wrapVec4__eq(lua_State* l)
+/// Wrap method Vec4::getNormalized.
+static int wrapVec4getNormalized(lua_State* l)
 {
-	int res = pwrapVec4__eq(l);
+	int res = pwrapVec4getNormalized(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3392,8 +5139,8 @@ static int wrapVec4__eq(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getLength.
-static inline int pwrapVec4getLength(lua_State* l)
+/// Pre-wrap method Vec4::getNormalized (out variant).
+static inline int pwrapVec4getNormalizedOut(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3402,7 +5149,7 @@ static inline int pwrapVec4getLength(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
@@ -3416,18 +5163,25 @@ static inline int pwrapVec4getLength(lua_State* l)
 	Vec4* self = ud->getData<Vec4>();
 
 	// Call the method
-	F32 ret = self->getLength();
+	Vec4 ret = self->getNormalized();
 
-	// Push return value
-	lua_pushnumber(l, ret);
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec4>() = ret;
+	lua_pushvalue(l, 2);
 
 	return 1;
 }
 
-/// Wrap method Vec4::getLength.
-static int wrapVec4getLength(lua_State* l)
+/// Wrap method Vec4::getNormalized (out variant).
+static int wrapVec4getNormalizedOut(lua_State* l)
 {
-	int res = pwrapVec4getLength(l);
+	int res = pwrapVec4getNormalizedOut(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3437,8 +5191,8 @@ static int wrapVec4getLength(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method Vec4::getNormalized.
-static inline int pwrapVec4getNormalized(lua_State* l)
+/// Pre-wrap method Vec4::getNormalized (unpack variant).
+static inline int pwrapVec4getNormalizedUnpack(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3463,22 +5217,19 @@ static inline int pwrapVec4getNormalized(lua_State* l)
 	// Call the method
 	Vec4 ret = self->getNormalized();
 
-	// Push return value
-	size = LuaUserData::computeSizeForGarbageCollected<Vec4>();
-	voidp = lua_newuserdata(l, size);
-	luaL_setmetatable(l, "Vec4");
-	ud = static_cast<LuaUserData*>(voidp);
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
-	ud->initGarbageCollected(&luaUserDataTypeInfoVec4);
-	::new(ud->getData<Vec4>()) Vec4(std::move(ret));
+	// Push the components of the return value
+	lua_pushnumber(l, lua_Number(ret.x()));
+	lua_pushnumber(l, lua_Number(ret.y()));
+	lua_pushnumber(l, lua_Number(ret.z()));
+	lua_pushnumber(l, lua_Number(ret.w()));
 
-	return 1;
+	return 4;
 }
 
-/// Wrap method Vec4::getNormalized.
-static int wrapVec4getNormalized(lua_State* l)
+/// Wrap method Vec4::getNormalized (unpack variant).
+static int wrapVec4getNormalizedUnpack(lua_State* l)
 {
-	int res = pwrapVec4getNormalized(l);
+	int res = pwrapVec4getNormalizedUnpack(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3585,12 +5336,56 @@ static int wrapVec4dot(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Vec4::unpack.
+static inline int pwrapVec4unpack(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoVec4, ud))
+	{
+		return -1;
+	}
+
+	Vec4* self = ud->getData<Vec4>();
+
+	// Push the components
+	lua_pushnumber(l, lua_Number((*self).x()));
+	lua_pushnumber(l, lua_Number((*self).y()));
+	lua_pushnumber(l, lua_Number((*self).z()));
+	lua_pushnumber(l, lua_Number((*self).w()));
+
+	return 4;
+}
+
+/// Wrap method Vec4::unpack.
+static int wrapVec4unpack(lua_State* l)
+{
+	int res = pwrapVec4unpack(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Wrap class Vec4.
 static inline void wrapVec4(lua_State* l)
 {
 	LuaBinder::createClass(l, &luaUserDataTypeInfoVec4);
 	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoVec4.m_typeName, "new", wrapVec4Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapVec4Dtor);
 	LuaBinder::pushLuaCFuncMethod(l, "getX", wrapVec4getX);
 	LuaBinder::pushLuaCFuncMethod(l, "getY", wrapVec4getY);
 	LuaBinder::pushLuaCFuncMethod(l, "getZ", wrapVec4getZ);
@@ -3604,14 +5399,25 @@ static inline void wrapVec4(lua_State* l)
 	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapVec4setAt);
 	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapVec4copy);
 	LuaBinder::pushLuaCFuncMethod(l, "__add", wrapVec4__add);
+	LuaBinder::pushLuaCFuncMethod(l, "addOut", wrapVec4addOut);
+	LuaBinder::pushLuaCFuncMethod(l, "addUnpack", wrapVec4addUnpack);
 	LuaBinder::pushLuaCFuncMethod(l, "__sub", wrapVec4__sub);
+	LuaBinder::pushLuaCFuncMethod(l, "subOut", wrapVec4subOut);
+	LuaBinder::pushLuaCFuncMethod(l, "subUnpack", wrapVec4subUnpack);
 	LuaBinder::pushLuaCFuncMethod(l, "__mul", wrapVec4__mul);
+	LuaBinder::pushLuaCFuncMethod(l, "mulOut", wrapVec4mulOut);
+	LuaBinder::pushLuaCFuncMethod(l, "mulUnpack", wrapVec4mulUnpack);
 	LuaBinder::pushLuaCFuncMethod(l, "__div", wrapVec4__div);
+	LuaBinder::pushLuaCFuncMethod(l, "divOut", wrapVec4divOut);
+	LuaBinder::pushLuaCFuncMethod(l, "divUnpack", wrapVec4divUnpack);
 	LuaBinder::pushLuaCFuncMethod(l, "__eq", wrapVec4__eq);
 	LuaBinder::pushLuaCFuncMethod(l, "getLength", wrapVec4getLength);
 	LuaBinder::pushLuaCFuncMethod(l, "getNormalized", wrapVec4getNormalized);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedOut", wrapVec4getNormalizedOut);
+	LuaBinder::pushLuaCFuncMethod(l, "getNormalizedUnpack", wrapVec4getNormalizedUnpack);
 	LuaBinder::pushLuaCFuncMethod(l, "normalize", wrapVec4normalize);
 	LuaBinder::pushLuaCFuncMethod(l, "dot", wrapVec4dot);
+	LuaBinder::pushLuaCFuncMethod(l, "unpack", wrapVec4unpack);
 	lua_settop(l, 0);
 }
 
@@ -3713,34 +5519,7 @@ static int wrapMat3Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Mat3.
-static int wrapMat3Dtor(lua_State* l)
-{
-	LuaUserData* ud;
-	(void)ud;
-	void* voidp;
-	(void)voidp;
-	PtrSize size;
-	(void)size;
-
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
-	{
-		return -1;
-	}
-
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoMat3, ud)))
-	{
-		return -1;
-	}
-
-	if(ud->isGarbageCollected())
-	{
-		Mat3* inst = ud->getData<Mat3>();
-		inst->~Mat3();
-	}
-
-	return 0;
-}
+static_assert(std::is_trivially_destructible<Mat3>::value, "Value types shouldn't need a destructor");
 
 /// Pre-wrap method Mat3::operator=.
 static inline int pwrapMat3copy(lua_State* l)
@@ -4015,7 +5794,6 @@ static inline void wrapMat3(lua_State* l)
 {
 	LuaBinder::createClass(l, &luaUserDataTypeInfoMat3);
 	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoMat3.m_typeName, "new", wrapMat3Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapMat3Dtor);
 	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapMat3copy);
 	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapMat3getAt);
 	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapMat3setAt);
@@ -4121,34 +5899,7 @@ static int wrapMat3x4Ctor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Mat3x4.
-static int wrapMat3x4Dtor(lua_State* l)
-{
-	LuaUserData* ud;
-	(void)ud;
-	void* voidp;
-	(void)voidp;
-	PtrSize size;
-	(void)size;
-
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
-	{
-		return -1;
-	}
-
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoMat3x4, ud)))
-	{
-		return -1;
-	}
-
-	if(ud->isGarbageCollected())
-	{
-		Mat3x4* inst = ud->getData<Mat3x4>();
-		inst->~Mat3x4();
-	}
-
-	return 0;
-}
+static_assert(std::is_trivially_destructible<Mat3x4>::value, "Value types shouldn't need a destructor");
 
 /// Pre-wrap method Mat3x4::operator=.
 static inline int pwrapMat3x4copy(lua_State* l)
@@ -4441,7 +6192,6 @@ static inline void wrapMat3x4(lua_State* l)
 {
 	LuaBinder::createClass(l, &luaUserDataTypeInfoMat3x4);
 	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoMat3x4.m_typeName, "new", wrapMat3x4Ctor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapMat3x4Dtor);
 	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapMat3x4copy);
 	LuaBinder::pushLuaCFuncMethod(l, "getAt", wrapMat3x4getAt);
 	LuaBinder::pushLuaCFuncMethod(l, "setAt", wrapMat3x4setAt);
@@ -4565,34 +6315,7 @@ static int wrapTransformCtor(lua_State* l)
 	return 0;
 }
 
-/// Wrap destructor for Transform.
-static int wrapTransformDtor(lua_State* l)
-{
-	LuaUserData* ud;
-	(void)ud;
-	void* voidp;
-	(void)voidp;
-	PtrSize size;
-	(void)size;
-
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
-	{
-		return -1;
-	}
-
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoTransform, ud)))
-	{
-		return -1;
-	}
-
-	if(ud->isGarbageCollected())
-	{
-		Transform* inst = ud->getData<Transform>();
-		inst->~Transform();
-	}
-
-	return 0;
-}
+static_assert(std::is_trivially_destructible<Transform>::value, "Value types shouldn't need a destructor");
 
 /// Pre-wrap method Transform::operator=.
 static inline int pwrapTransformcopy(lua_State* l)
@@ -4697,6 +6420,58 @@ static int wrapTransformgetOrigin(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Transform::getOrigin (out variant).
+static inline int pwrapTransformgetOriginOut(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoTransform, ud))
+	{
+		return -1;
+	}
+
+	Transform* self = ud->getData<Transform>();
+
+	// Call the method
+	Vec4 ret = self->getOrigin();
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec4, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Vec4>() = ret;
+	lua_pushvalue(l, 2);
+
+	return 1;
+}
+
+/// Wrap method Transform::getOrigin (out variant).
+static int wrapTransformgetOriginOut(lua_State* l)
+{
+	int res = pwrapTransformgetOriginOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Pre-wrap method Transform::setOrigin.
 static inline int pwrapTransformsetOrigin(lua_State* l)
 {
@@ -4800,6 +6575,58 @@ static int wrapTransformgetRotation(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method Transform::getRotation (out variant).
+static inline int pwrapTransformgetRotationOut(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoTransform, ud))
+	{
+		return -1;
+	}
+
+	Transform* self = ud->getData<Transform>();
+
+	// Call the method
+	Mat3x4 ret = self->getRotation();
+
+	// Write the return value to the "out" argument
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoMat3x4;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoMat3x4, ud)))
+	{
+		return -1;
+	}
+
+	*ud->getData<Mat3x4>() = ret;
+	lua_pushvalue(l, 2);
+
+	return 1;
+}
+
+/// Wrap method Transform::getRotation (out variant).
+static int wrapTransformgetRotationOut(lua_State* l)
+{
+	int res = pwrapTransformgetRotationOut(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Pre-wrap method Transform::setRotation.
 static inline int pwrapTransformsetRotation(lua_State* l)
 {
@@ -4951,11 +6778,12 @@ static inline void wrapTransform(lua_State* l)
 {
 	LuaBinder::createClass(l, &luaUserDataTypeInfoTransform);
 	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoTransform.m_typeName, "new", wrapTransformCtor);
-	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapTransformDtor);
 	LuaBinder::pushLuaCFuncMethod(l, "copy", wrapTransformcopy);
 	LuaBinder::pushLuaCFuncMethod(l, "getOrigin", wrapTransformgetOrigin);
+	LuaBinder::pushLuaCFuncMethod(l, "getOriginOut", wrapTransformgetOriginOut);
 	LuaBinder::pushLuaCFuncMethod(l, "setOrigin", wrapTransformsetOrigin);
 	LuaBinder::pushLuaCFuncMethod(l, "getRotation", wrapTransformgetRotation);
+	LuaBinder::pushLuaCFuncMethod(l, "getRotationOut", wrapTransformgetRotationOut);
 	LuaBinder::pushLuaCFuncMethod(l, "setRotation", wrapTransformsetRotation);
 	LuaBinder::pushLuaCFuncMethod(l, "getScale", wrapTransformgetScale);
 	LuaBinder::pushLuaCFuncMethod(l, "setScale", wrapTransformsetScale);
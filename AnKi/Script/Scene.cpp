@@ -8,6 +8,7 @@
 #include <AnKi/Script/LuaBinder.h>
 #include <AnKi/Script/ScriptManager.h>
 #include <AnKi/Scene.h>
+#include <AnKi/Physics/PhysicsWorld.h>
 
 namespace anki {
 
@@ -58,6 +59,18 @@ static EventManager* getEventManager(lua_State* l)
 	return &getSceneGraph(l)->getEventManager();
 }
 
+/// The query batch only asserts on the index so check it before it reaches the batch.
+static ANKI_USE_RESULT Error checkQueryIndex(lua_State* l, const PhysicsWorldQueryBatch& batch, U32 idx)
+{
+	if(idx >= batch.getQueryCount())
+	{
+		lua_pushfstring(l, "Query index out of range: %d (query count %d)", I32(idx), I32(batch.getQueryCount()));
+		return Error::USER_DATA;
+	}
+
+	return Error::NONE;
+}
+
 using WeakArraySceneNodePtr = WeakArray<SceneNode*>;
 using WeakArrayBodyComponentPtr = WeakArray<BodyComponent*>;
 
@@ -3175,17 +3188,18 @@ static inline void wrapSkinComponent(lua_State* l)
 	lua_settop(l, 0);
 }
 
-LuaUserDataTypeInfo luaUserDataTypeInfoSceneNode = {
-	7330223484305934319, "SceneNode", LuaUserData::computeSizeForGarbageCollected<SceneNode>(), nullptr, nullptr};
+LuaUserDataTypeInfo luaUserDataTypeInfoSpatialComponent = {
+	-793600193818500070, "SpatialComponent", LuaUserData::computeSizeForGarbageCollected<SpatialComponent>(), nullptr,
+	nullptr};
 
 template<>
-const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<SceneNode>()
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<SpatialComponent>()
 {
-	return luaUserDataTypeInfoSceneNode;
+	return luaUserDataTypeInfoSpatialComponent;
 }
 
-/// Pre-wrap method SceneNode::getName.
-static inline int pwrapSceneNodegetName(lua_State* l)
+/// Pre-wrap method SpatialComponent::setStatic.
+static inline int pwrapSpatialComponentsetStatic(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3194,32 +3208,36 @@ static inline int pwrapSceneNodegetName(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSpatialComponent, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
+	SpatialComponent* self = ud->getData<SpatialComponent>();
 
-	// Call the method
-	CString ret = self->getName();
+	// Pop arguments
+	Bool arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	lua_pushstring(l, &ret[0]);
+	// Call the method
+	self->setStatic(arg0);
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method SceneNode::getName.
-static int wrapSceneNodegetName(lua_State* l)
+/// Wrap method SpatialComponent::setStatic.
+static int wrapSpatialComponentsetStatic(lua_State* l)
 {
-	int res = pwrapSceneNodegetName(l);
+	int res = pwrapSpatialComponentsetStatic(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3229,8 +3247,8 @@ static int wrapSceneNodegetName(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::addChild.
-static inline int pwrapSceneNodeaddChild(lua_State* l)
+/// Pre-wrap method SpatialComponent::getStatic.
+static inline int pwrapSpatialComponentgetStatic(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3239,39 +3257,32 @@ static inline int pwrapSceneNodeaddChild(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
-	{
-		return -1;
-	}
-
-	SceneNode* self = ud->getData<SceneNode>();
-
-	// Pop arguments
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoSceneNode;
-	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoSceneNode, ud)))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSpatialComponent, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* iarg0 = ud->getData<SceneNode>();
-	SceneNode* arg0(iarg0);
+	SpatialComponent* self = ud->getData<SpatialComponent>();
 
 	// Call the method
-	self->addChild(arg0);
+	Bool ret = self->getStatic();
 
-	return 0;
+	// Push return value
+	lua_pushboolean(l, ret);
+
+	return 1;
 }
 
-/// Wrap method SceneNode::addChild.
-static int wrapSceneNodeaddChild(lua_State* l)
+/// Wrap method SpatialComponent::getStatic.
+static int wrapSpatialComponentgetStatic(lua_State* l)
 {
-	int res = pwrapSceneNodeaddChild(l);
+	int res = pwrapSpatialComponentgetStatic(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3281,8 +3292,27 @@ static int wrapSceneNodeaddChild(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::setMarkedForDeletion.
-static inline int pwrapSceneNodesetMarkedForDeletion(lua_State* l)
+/// Wrap class SpatialComponent.
+static inline void wrapSpatialComponent(lua_State* l)
+{
+	LuaBinder::createClass(l, &luaUserDataTypeInfoSpatialComponent);
+	LuaBinder::pushLuaCFuncMethod(l, "setStatic", wrapSpatialComponentsetStatic);
+	LuaBinder::pushLuaCFuncMethod(l, "getStatic", wrapSpatialComponentgetStatic);
+	lua_settop(l, 0);
+}
+
+LuaUserDataTypeInfo luaUserDataTypeInfoPhysicsWorldQueryBatch = {
+	-5653702490726324149, "PhysicsWorldQueryBatch",
+	LuaUserData::computeSizeForGarbageCollected<PhysicsWorldQueryBatch>(), nullptr, nullptr};
+
+template<>
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<PhysicsWorldQueryBatch>()
+{
+	return luaUserDataTypeInfoPhysicsWorldQueryBatch;
+}
+
+/// Pre-wrap constructor for PhysicsWorldQueryBatch.
+static inline int pwrapPhysicsWorldQueryBatchCtor0(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3291,29 +3321,28 @@ static inline int pwrapSceneNodesetMarkedForDeletion(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
-	{
-		return -1;
-	}
-
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 0)))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
-
-	// Call the method
-	self->setMarkedForDeletion();
+	// Create user data
+	size = LuaUserData::computeSizeForGarbageCollected<PhysicsWorldQueryBatch>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, luaUserDataTypeInfoPhysicsWorldQueryBatch.m_typeName);
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoPhysicsWorldQueryBatch;
+	ud->initGarbageCollected(&luaUserDataTypeInfoPhysicsWorldQueryBatch);
+	::new(ud->getData<PhysicsWorldQueryBatch>()) PhysicsWorldQueryBatch();
 
-	return 0;
+	return 1;
 }
 
-/// Wrap method SceneNode::setMarkedForDeletion.
-static int wrapSceneNodesetMarkedForDeletion(lua_State* l)
+/// Wrap constructors for PhysicsWorldQueryBatch.
+static int wrapPhysicsWorldQueryBatchCtor(lua_State* l)
 {
-	int res = pwrapSceneNodesetMarkedForDeletion(l);
+	int res = pwrapPhysicsWorldQueryBatchCtor0(l);
+
 	if(res >= 0)
 	{
 		return res;
@@ -3323,8 +3352,8 @@ static int wrapSceneNodesetMarkedForDeletion(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<MoveComponent>.
-static inline int pwrapSceneNodegetMoveComponent(lua_State* l)
+/// Wrap destructor for PhysicsWorldQueryBatch.
+static int wrapPhysicsWorldQueryBatchDtor(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3338,48 +3367,22 @@ static inline int pwrapSceneNodegetMoveComponent(lua_State* l)
 		return -1;
 	}
 
-	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
-	{
-		return -1;
-	}
-
-	SceneNode* self = ud->getData<SceneNode>();
-
-	// Call the method
-	MoveComponent* ret = self->tryGetFirstComponentOfType<MoveComponent>();
-
-	// Push return value
-	if(ANKI_UNLIKELY(ret == nullptr))
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud)))
 	{
-		lua_pushstring(l, "Glue code returned nullptr");
 		return -1;
 	}
 
-	voidp = lua_newuserdata(l, sizeof(LuaUserData));
-	ud = static_cast<LuaUserData*>(voidp);
-	luaL_setmetatable(l, "MoveComponent");
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoMoveComponent;
-	ud->initPointed(&luaUserDataTypeInfoMoveComponent, ret);
-
-	return 1;
-}
-
-/// Wrap method SceneNode::tryGetFirstComponentOfType<MoveComponent>.
-static int wrapSceneNodegetMoveComponent(lua_State* l)
-{
-	int res = pwrapSceneNodegetMoveComponent(l);
-	if(res >= 0)
+	if(ud->isGarbageCollected())
 	{
-		return res;
+		PhysicsWorldQueryBatch* inst = ud->getData<PhysicsWorldQueryBatch>();
+		inst->~PhysicsWorldQueryBatch();
 	}
 
-	lua_error(l);
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<LightComponent>.
-static inline int pwrapSceneNodegetLightComponent(lua_State* l)
+/// Pre-wrap method PhysicsWorldQueryBatch::addRay.
+static inline int pwrapPhysicsWorldQueryBatchaddRay(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3388,42 +3391,51 @@ static inline int pwrapSceneNodegetLightComponent(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
 
-	// Call the method
-	LightComponent* ret = self->tryGetFirstComponentOfType<LightComponent>();
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	if(ANKI_UNLIKELY(ret == nullptr))
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)))
 	{
-		lua_pushstring(l, "Glue code returned nullptr");
 		return -1;
 	}
 
-	voidp = lua_newuserdata(l, sizeof(LuaUserData));
-	ud = static_cast<LuaUserData*>(voidp);
-	luaL_setmetatable(l, "LightComponent");
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoLightComponent;
-	ud->initPointed(&luaUserDataTypeInfoLightComponent, ret);
+	Vec3* iarg1 = ud->getData<Vec3>();
+	const Vec3& arg1(*iarg1);
+
+	// Call the method
+	U32 ret = self->addRay(arg0, arg1);
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
 
 	return 1;
 }
 
-/// Wrap method SceneNode::tryGetFirstComponentOfType<LightComponent>.
-static int wrapSceneNodegetLightComponent(lua_State* l)
+/// Wrap method PhysicsWorldQueryBatch::addRay.
+static int wrapPhysicsWorldQueryBatchaddRay(lua_State* l)
 {
-	int res = pwrapSceneNodegetLightComponent(l);
+	int res = pwrapPhysicsWorldQueryBatchaddRay(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3433,8 +3445,8 @@ static int wrapSceneNodegetLightComponent(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<LensFlareComponent>.
-static inline int pwrapSceneNodegetLensFlareComponent(lua_State* l)
+/// Pre-wrap method PhysicsWorldQueryBatch::addSphereSweep.
+static inline int pwrapPhysicsWorldQueryBatchaddSphereSweep(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3443,42 +3455,57 @@ static inline int pwrapSceneNodegetLensFlareComponent(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 4)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
 
-	// Call the method
-	LensFlareComponent* ret = self->tryGetFirstComponentOfType<LensFlareComponent>();
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	if(ANKI_UNLIKELY(ret == nullptr))
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 3, luaUserDataTypeInfoVec3, ud)))
 	{
-		lua_pushstring(l, "Glue code returned nullptr");
 		return -1;
 	}
 
-	voidp = lua_newuserdata(l, sizeof(LuaUserData));
-	ud = static_cast<LuaUserData*>(voidp);
-	luaL_setmetatable(l, "LensFlareComponent");
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoLensFlareComponent;
-	ud->initPointed(&luaUserDataTypeInfoLensFlareComponent, ret);
+	Vec3* iarg1 = ud->getData<Vec3>();
+	const Vec3& arg1(*iarg1);
+
+	F32 arg2;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 4, arg2)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	U32 ret = self->addSphereSweep(arg0, arg1, arg2);
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
 
 	return 1;
 }
 
-/// Wrap method SceneNode::tryGetFirstComponentOfType<LensFlareComponent>.
-static int wrapSceneNodegetLensFlareComponent(lua_State* l)
+/// Wrap method PhysicsWorldQueryBatch::addSphereSweep.
+static int wrapPhysicsWorldQueryBatchaddSphereSweep(lua_State* l)
 {
-	int res = pwrapSceneNodegetLensFlareComponent(l);
+	int res = pwrapPhysicsWorldQueryBatchaddSphereSweep(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3488,8 +3515,8 @@ static int wrapSceneNodegetLensFlareComponent(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<DecalComponent>.
-static inline int pwrapSceneNodegetDecalComponent(lua_State* l)
+/// Pre-wrap method PhysicsWorldQueryBatch::addSphereOverlap.
+static inline int pwrapPhysicsWorldQueryBatchaddSphereOverlap(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3498,42 +3525,48 @@ static inline int pwrapSceneNodegetDecalComponent(lua_State* l)
 	PtrSize size;
 	(void)size;
 
-	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 3)))
 	{
 		return -1;
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
 
-	// Call the method
-	DecalComponent* ret = self->tryGetFirstComponentOfType<DecalComponent>();
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoVec3, ud)))
+	{
+		return -1;
+	}
 
-	// Push return value
-	if(ANKI_UNLIKELY(ret == nullptr))
+	Vec3* iarg0 = ud->getData<Vec3>();
+	const Vec3& arg0(*iarg0);
+
+	F32 arg1;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 3, arg1)))
 	{
-		lua_pushstring(l, "Glue code returned nullptr");
 		return -1;
 	}
 
-	voidp = lua_newuserdata(l, sizeof(LuaUserData));
-	ud = static_cast<LuaUserData*>(voidp);
-	luaL_setmetatable(l, "DecalComponent");
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoDecalComponent;
-	ud->initPointed(&luaUserDataTypeInfoDecalComponent, ret);
+	// Call the method
+	U32 ret = self->addSphereOverlap(arg0, arg1);
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
 
 	return 1;
 }
 
-/// Wrap method SceneNode::tryGetFirstComponentOfType<DecalComponent>.
-static int wrapSceneNodegetDecalComponent(lua_State* l)
+/// Wrap method PhysicsWorldQueryBatch::addSphereOverlap.
+static int wrapPhysicsWorldQueryBatchaddSphereOverlap(lua_State* l)
 {
-	int res = pwrapSceneNodegetDecalComponent(l);
+	int res = pwrapPhysicsWorldQueryBatchaddSphereOverlap(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3543,8 +3576,8 @@ static int wrapSceneNodegetDecalComponent(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<TriggerComponent>.
-static inline int pwrapSceneNodegetTriggerComponent(lua_State* l)
+/// Pre-wrap method PhysicsWorldQueryBatch::run.
+static inline int pwrapPhysicsWorldQueryBatchrun(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3559,36 +3592,23 @@ static inline int pwrapSceneNodegetTriggerComponent(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
 
 	// Call the method
-	TriggerComponent* ret = self->tryGetFirstComponentOfType<TriggerComponent>();
-
-	// Push return value
-	if(ANKI_UNLIKELY(ret == nullptr))
-	{
-		lua_pushstring(l, "Glue code returned nullptr");
-		return -1;
-	}
-
-	voidp = lua_newuserdata(l, sizeof(LuaUserData));
-	ud = static_cast<LuaUserData*>(voidp);
-	luaL_setmetatable(l, "TriggerComponent");
-	extern LuaUserDataTypeInfo luaUserDataTypeInfoTriggerComponent;
-	ud->initPointed(&luaUserDataTypeInfoTriggerComponent, ret);
+	self->run(getSceneGraph(l)->getPhysicsWorld());
 
-	return 1;
+	return 0;
 }
 
-/// Wrap method SceneNode::tryGetFirstComponentOfType<TriggerComponent>.
-static int wrapSceneNodegetTriggerComponent(lua_State* l)
+/// Wrap method PhysicsWorldQueryBatch::run.
+static int wrapPhysicsWorldQueryBatchrun(lua_State* l)
 {
-	int res = pwrapSceneNodegetTriggerComponent(l);
+	int res = pwrapPhysicsWorldQueryBatchrun(l);
 	if(res >= 0)
 	{
 		return res;
@@ -3598,8 +3618,8 @@ static int wrapSceneNodegetTriggerComponent(lua_State* l)
 	return 0;
 }
 
-/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<FogDensityComponent>.
-static inline int pwrapSceneNodegetFogDensityComponent(lua_State* l)
+/// Pre-wrap method PhysicsWorldQueryBatch::reset.
+static inline int pwrapPhysicsWorldQueryBatchreset(lua_State* l)
 {
 	LuaUserData* ud;
 	(void)ud;
@@ -3614,12 +3634,782 @@ static inline int pwrapSceneNodegetFogDensityComponent(lua_State* l)
 	}
 
 	// Get "this" as "self"
-	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
 	{
 		return -1;
 	}
 
-	SceneNode* self = ud->getData<SceneNode>();
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
+
+	// Call the method
+	self->reset();
+
+	return 0;
+}
+
+/// Wrap method PhysicsWorldQueryBatch::reset.
+static int wrapPhysicsWorldQueryBatchreset(lua_State* l)
+{
+	int res = pwrapPhysicsWorldQueryBatchreset(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method PhysicsWorldQueryBatch::getQueryCount.
+static inline int pwrapPhysicsWorldQueryBatchgetQueryCount(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
+	{
+		return -1;
+	}
+
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
+
+	// Call the method
+	U32 ret = self->getQueryCount();
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method PhysicsWorldQueryBatch::getQueryCount.
+static int wrapPhysicsWorldQueryBatchgetQueryCount(lua_State* l)
+{
+	int res = pwrapPhysicsWorldQueryBatchgetQueryCount(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method PhysicsWorldQueryBatch::isHit.
+static inline int pwrapPhysicsWorldQueryBatchisHit(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
+	{
+		return -1;
+	}
+
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
+
+	// Pop arguments
+	U32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	if(ANKI_UNLIKELY(checkQueryIndex(l, *self, arg0)))
+	{
+		return -1;
+	}
+
+	Bool ret = self->isHit(arg0);
+
+	// Push return value
+	lua_pushboolean(l, ret);
+
+	return 1;
+}
+
+/// Wrap method PhysicsWorldQueryBatch::isHit.
+static int wrapPhysicsWorldQueryBatchisHit(lua_State* l)
+{
+	int res = pwrapPhysicsWorldQueryBatchisHit(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method PhysicsWorldQueryBatch::getHitPosition.
+static inline int pwrapPhysicsWorldQueryBatchgetHitPosition(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
+	{
+		return -1;
+	}
+
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
+
+	// Pop arguments
+	U32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	if(ANKI_UNLIKELY(checkQueryIndex(l, *self, arg0)))
+	{
+		return -1;
+	}
+
+	Vec3 ret = self->getHitPosition(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method PhysicsWorldQueryBatch::getHitPosition.
+static int wrapPhysicsWorldQueryBatchgetHitPosition(lua_State* l)
+{
+	int res = pwrapPhysicsWorldQueryBatchgetHitPosition(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method PhysicsWorldQueryBatch::getHitNormal.
+static inline int pwrapPhysicsWorldQueryBatchgetHitNormal(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
+	{
+		return -1;
+	}
+
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
+
+	// Pop arguments
+	U32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	if(ANKI_UNLIKELY(checkQueryIndex(l, *self, arg0)))
+	{
+		return -1;
+	}
+
+	Vec3 ret = self->getHitNormal(arg0);
+
+	// Push return value
+	size = LuaUserData::computeSizeForGarbageCollected<Vec3>();
+	voidp = lua_newuserdata(l, size);
+	luaL_setmetatable(l, "Vec3");
+	ud = static_cast<LuaUserData*>(voidp);
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoVec3;
+	ud->initGarbageCollected(&luaUserDataTypeInfoVec3);
+	::new(ud->getData<Vec3>()) Vec3(std::move(ret));
+
+	return 1;
+}
+
+/// Wrap method PhysicsWorldQueryBatch::getHitNormal.
+static int wrapPhysicsWorldQueryBatchgetHitNormal(lua_State* l)
+{
+	int res = pwrapPhysicsWorldQueryBatchgetHitNormal(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method PhysicsWorldQueryBatch::getHitFraction.
+static inline int pwrapPhysicsWorldQueryBatchgetHitFraction(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoPhysicsWorldQueryBatch, ud))
+	{
+		return -1;
+	}
+
+	PhysicsWorldQueryBatch* self = ud->getData<PhysicsWorldQueryBatch>();
+
+	// Pop arguments
+	U32 arg0;
+	if(ANKI_UNLIKELY(LuaBinder::checkNumber(l, 2, arg0)))
+	{
+		return -1;
+	}
+
+	// Call the method
+	if(ANKI_UNLIKELY(checkQueryIndex(l, *self, arg0)))
+	{
+		return -1;
+	}
+
+	F32 ret = self->getHitFraction(arg0);
+
+	// Push return value
+	lua_pushnumber(l, lua_Number(ret));
+
+	return 1;
+}
+
+/// Wrap method PhysicsWorldQueryBatch::getHitFraction.
+static int wrapPhysicsWorldQueryBatchgetHitFraction(lua_State* l)
+{
+	int res = pwrapPhysicsWorldQueryBatchgetHitFraction(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Wrap class PhysicsWorldQueryBatch.
+static inline void wrapPhysicsWorldQueryBatch(lua_State* l)
+{
+	LuaBinder::createClass(l, &luaUserDataTypeInfoPhysicsWorldQueryBatch);
+	LuaBinder::pushLuaCFuncStaticMethod(l, luaUserDataTypeInfoPhysicsWorldQueryBatch.m_typeName, "new",
+										wrapPhysicsWorldQueryBatchCtor);
+	LuaBinder::pushLuaCFuncMethod(l, "__gc", wrapPhysicsWorldQueryBatchDtor);
+	LuaBinder::pushLuaCFuncMethod(l, "addRay", wrapPhysicsWorldQueryBatchaddRay);
+	LuaBinder::pushLuaCFuncMethod(l, "addSphereSweep", wrapPhysicsWorldQueryBatchaddSphereSweep);
+	LuaBinder::pushLuaCFuncMethod(l, "addSphereOverlap", wrapPhysicsWorldQueryBatchaddSphereOverlap);
+	LuaBinder::pushLuaCFuncMethod(l, "run", wrapPhysicsWorldQueryBatchrun);
+	LuaBinder::pushLuaCFuncMethod(l, "reset", wrapPhysicsWorldQueryBatchreset);
+	LuaBinder::pushLuaCFuncMethod(l, "getQueryCount", wrapPhysicsWorldQueryBatchgetQueryCount);
+	LuaBinder::pushLuaCFuncMethod(l, "isHit", wrapPhysicsWorldQueryBatchisHit);
+	LuaBinder::pushLuaCFuncMethod(l, "getHitPosition", wrapPhysicsWorldQueryBatchgetHitPosition);
+	LuaBinder::pushLuaCFuncMethod(l, "getHitNormal", wrapPhysicsWorldQueryBatchgetHitNormal);
+	LuaBinder::pushLuaCFuncMethod(l, "getHitFraction", wrapPhysicsWorldQueryBatchgetHitFraction);
+	lua_settop(l, 0);
+}
+
+LuaUserDataTypeInfo luaUserDataTypeInfoSceneNode = {
+	7330223484305934319, "SceneNode", LuaUserData::computeSizeForGarbageCollected<SceneNode>(), nullptr, nullptr};
+
+template<>
+const LuaUserDataTypeInfo& LuaUserData::getDataTypeInfoFor<SceneNode>()
+{
+	return luaUserDataTypeInfoSceneNode;
+}
+
+/// Pre-wrap method SceneNode::getName.
+static inline int pwrapSceneNodegetName(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	CString ret = self->getName();
+
+	// Push return value
+	lua_pushstring(l, &ret[0]);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::getName.
+static int wrapSceneNodegetName(lua_State* l)
+{
+	int res = pwrapSceneNodegetName(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::addChild.
+static inline int pwrapSceneNodeaddChild(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 2)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Pop arguments
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoSceneNode;
+	if(ANKI_UNLIKELY(LuaBinder::checkUserData(l, 2, luaUserDataTypeInfoSceneNode, ud)))
+	{
+		return -1;
+	}
+
+	SceneNode* iarg0 = ud->getData<SceneNode>();
+	SceneNode* arg0(iarg0);
+
+	// Call the method
+	self->addChild(arg0);
+
+	return 0;
+}
+
+/// Wrap method SceneNode::addChild.
+static int wrapSceneNodeaddChild(lua_State* l)
+{
+	int res = pwrapSceneNodeaddChild(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::setMarkedForDeletion.
+static inline int pwrapSceneNodesetMarkedForDeletion(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	self->setMarkedForDeletion();
+
+	return 0;
+}
+
+/// Wrap method SceneNode::setMarkedForDeletion.
+static int wrapSceneNodesetMarkedForDeletion(lua_State* l)
+{
+	int res = pwrapSceneNodesetMarkedForDeletion(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<MoveComponent>.
+static inline int pwrapSceneNodegetMoveComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	MoveComponent* ret = self->tryGetFirstComponentOfType<MoveComponent>();
+
+	// Push return value
+	if(ANKI_UNLIKELY(ret == nullptr))
+	{
+		lua_pushstring(l, "Glue code returned nullptr");
+		return -1;
+	}
+
+	voidp = lua_newuserdata(l, sizeof(LuaUserData));
+	ud = static_cast<LuaUserData*>(voidp);
+	luaL_setmetatable(l, "MoveComponent");
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoMoveComponent;
+	ud->initPointed(&luaUserDataTypeInfoMoveComponent, ret);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::tryGetFirstComponentOfType<MoveComponent>.
+static int wrapSceneNodegetMoveComponent(lua_State* l)
+{
+	int res = pwrapSceneNodegetMoveComponent(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<LightComponent>.
+static inline int pwrapSceneNodegetLightComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	LightComponent* ret = self->tryGetFirstComponentOfType<LightComponent>();
+
+	// Push return value
+	if(ANKI_UNLIKELY(ret == nullptr))
+	{
+		lua_pushstring(l, "Glue code returned nullptr");
+		return -1;
+	}
+
+	voidp = lua_newuserdata(l, sizeof(LuaUserData));
+	ud = static_cast<LuaUserData*>(voidp);
+	luaL_setmetatable(l, "LightComponent");
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoLightComponent;
+	ud->initPointed(&luaUserDataTypeInfoLightComponent, ret);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::tryGetFirstComponentOfType<LightComponent>.
+static int wrapSceneNodegetLightComponent(lua_State* l)
+{
+	int res = pwrapSceneNodegetLightComponent(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<LensFlareComponent>.
+static inline int pwrapSceneNodegetLensFlareComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	LensFlareComponent* ret = self->tryGetFirstComponentOfType<LensFlareComponent>();
+
+	// Push return value
+	if(ANKI_UNLIKELY(ret == nullptr))
+	{
+		lua_pushstring(l, "Glue code returned nullptr");
+		return -1;
+	}
+
+	voidp = lua_newuserdata(l, sizeof(LuaUserData));
+	ud = static_cast<LuaUserData*>(voidp);
+	luaL_setmetatable(l, "LensFlareComponent");
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoLensFlareComponent;
+	ud->initPointed(&luaUserDataTypeInfoLensFlareComponent, ret);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::tryGetFirstComponentOfType<LensFlareComponent>.
+static int wrapSceneNodegetLensFlareComponent(lua_State* l)
+{
+	int res = pwrapSceneNodegetLensFlareComponent(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<DecalComponent>.
+static inline int pwrapSceneNodegetDecalComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	DecalComponent* ret = self->tryGetFirstComponentOfType<DecalComponent>();
+
+	// Push return value
+	if(ANKI_UNLIKELY(ret == nullptr))
+	{
+		lua_pushstring(l, "Glue code returned nullptr");
+		return -1;
+	}
+
+	voidp = lua_newuserdata(l, sizeof(LuaUserData));
+	ud = static_cast<LuaUserData*>(voidp);
+	luaL_setmetatable(l, "DecalComponent");
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoDecalComponent;
+	ud->initPointed(&luaUserDataTypeInfoDecalComponent, ret);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::tryGetFirstComponentOfType<DecalComponent>.
+static int wrapSceneNodegetDecalComponent(lua_State* l)
+{
+	int res = pwrapSceneNodegetDecalComponent(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<TriggerComponent>.
+static inline int pwrapSceneNodegetTriggerComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	TriggerComponent* ret = self->tryGetFirstComponentOfType<TriggerComponent>();
+
+	// Push return value
+	if(ANKI_UNLIKELY(ret == nullptr))
+	{
+		lua_pushstring(l, "Glue code returned nullptr");
+		return -1;
+	}
+
+	voidp = lua_newuserdata(l, sizeof(LuaUserData));
+	ud = static_cast<LuaUserData*>(voidp);
+	luaL_setmetatable(l, "TriggerComponent");
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoTriggerComponent;
+	ud->initPointed(&luaUserDataTypeInfoTriggerComponent, ret);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::tryGetFirstComponentOfType<TriggerComponent>.
+static int wrapSceneNodegetTriggerComponent(lua_State* l)
+{
+	int res = pwrapSceneNodegetTriggerComponent(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<FogDensityComponent>.
+static inline int pwrapSceneNodegetFogDensityComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
 
 	// Call the method
 	FogDensityComponent* ret = self->tryGetFirstComponentOfType<FogDensityComponent>();
@@ -4093,6 +4883,61 @@ static int wrapSceneNodegetSkinComponent(lua_State* l)
 	return 0;
 }
 
+/// Pre-wrap method SceneNode::tryGetFirstComponentOfType<SpatialComponent>.
+static inline int pwrapSceneNodegetSpatialComponent(lua_State* l)
+{
+	LuaUserData* ud;
+	(void)ud;
+	void* voidp;
+	(void)voidp;
+	PtrSize size;
+	(void)size;
+
+	if(ANKI_UNLIKELY(LuaBinder::checkArgsCount(l, 1)))
+	{
+		return -1;
+	}
+
+	// Get "this" as "self"
+	if(LuaBinder::checkUserData(l, 1, luaUserDataTypeInfoSceneNode, ud))
+	{
+		return -1;
+	}
+
+	SceneNode* self = ud->getData<SceneNode>();
+
+	// Call the method
+	SpatialComponent* ret = self->tryGetFirstComponentOfType<SpatialComponent>();
+
+	// Push return value
+	if(ANKI_UNLIKELY(ret == nullptr))
+	{
+		lua_pushstring(l, "Glue code returned nullptr");
+		return -1;
+	}
+
+	voidp = lua_newuserdata(l, sizeof(LuaUserData));
+	ud = static_cast<LuaUserData*>(voidp);
+	luaL_setmetatable(l, "SpatialComponent");
+	extern LuaUserDataTypeInfo luaUserDataTypeInfoSpatialComponent;
+	ud->initPointed(&luaUserDataTypeInfoSpatialComponent, ret);
+
+	return 1;
+}
+
+/// Wrap method SceneNode::tryGetFirstComponentOfType<SpatialComponent>.
+static int wrapSceneNodegetSpatialComponent(lua_State* l)
+{
+	int res = pwrapSceneNodegetSpatialComponent(l);
+	if(res >= 0)
+	{
+		return res;
+	}
+
+	lua_error(l);
+	return 0;
+}
+
 /// Wrap class SceneNode.
 static inline void wrapSceneNode(lua_State* l)
 {
@@ -4115,6 +4960,7 @@ static inline void wrapSceneNode(lua_State* l)
 	LuaBinder::pushLuaCFuncMethod(l, "getGpuParticleEmitterComponent", wrapSceneNodegetGpuParticleEmitterComponent);
 	LuaBinder::pushLuaCFuncMethod(l, "getModelComponent", wrapSceneNodegetModelComponent);
 	LuaBinder::pushLuaCFuncMethod(l, "getSkinComponent", wrapSceneNodegetSkinComponent);
+	LuaBinder::pushLuaCFuncMethod(l, "getSpatialComponent", wrapSceneNodegetSpatialComponent);
 	lua_settop(l, 0);
 }
 
@@ -6211,6 +7057,8 @@ void wrapModuleScene(lua_State* l)
 	wrapGpuParticleEmitterComponent(l);
 	wrapModelComponent(l);
 	wrapSkinComponent(l);
+	wrapSpatialComponent(l);
+	wrapPhysicsWorldQueryBatch(l);
 	wrapSceneNode(l);
 	wrapModelNode(l);
 	wrapPerspectiveCameraNode(l);
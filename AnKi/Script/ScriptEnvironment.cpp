@@ -5,15 +5,96 @@
 
 #include <AnKi/Script/ScriptEnvironment.h>
 #include <AnKi/Script/ScriptManager.h>
+#include <AnKi/Util/Tracer.h>
 
 namespace anki {
 
+ScriptEnvironment::~ScriptEnvironment()
+{
+	if(m_globalsRef != LUA_NOREF)
+	{
+		LockGuard<Mutex> lock(*m_mtx);
+		luaL_unref(m_lua->getLuaState(), LUA_REGISTRYINDEX, m_globalsRef);
+	}
+}
+
 Error ScriptEnvironment::init(ScriptManager* manager)
 {
 	ANKI_ASSERT(!isInitialized());
 	ANKI_ASSERT(manager);
 	m_manager = manager;
-	return m_thread.init(m_manager->getAllocator(), &m_manager->getOtherSystems());
+
+	ScriptManager::EnvironmentVm& vm = manager->chooseEnvironmentVm();
+	m_lua = &vm.m_lua;
+	m_mtx = &vm.m_mtx;
+
+	LockGuard<Mutex> lock(*m_mtx);
+	lua_State* l = m_lua->getLuaState();
+
+	// The globals are a table that falls back to the globals of the VM for the bindings and the libraries
+	lua_newtable(l);
+	if(luaL_newmetatable(l, "anki_ScriptEnvironment"))
+	{
+		lua_pushglobaltable(l);
+		lua_setfield(l, -2, "__index");
+	}
+	lua_setmetatable(l, -2);
+	m_globalsRef = luaL_ref(l, LUA_REGISTRYINDEX);
+
+	return Error::NONE;
+}
+
+Error ScriptEnvironment::evalChunk(const void* chunk, PtrSize chunkSize, const CString& chunkName)
+{
+	ANKI_ASSERT(isInitialized());
+	ANKI_TRACE_SCOPED_EVENT(LUA_EXEC);
+	LockGuard<Mutex> lock(*m_mtx);
+	lua_State* l = m_lua->getLuaState();
+
+	I32 e = luaL_loadbuffer(l, static_cast<const char*>(chunk), chunkSize, chunkName.cstr());
+	if(!e)
+	{
+		// The 1st upvalue of a chunk is its globals (_ENV)
+		pushGlobalsTable();
+		lua_setupvalue(l, -2, 1);
+		e = lua_pcall(l, 0, 0, 0);
+	}
+
+	if(e)
+	{
+		ANKI_SCRIPT_LOGE("%s", lua_tostring(l, -1));
+		lua_pop(l, 1);
+		return Error::USER_DATA;
+	}
+
+	return Error::NONE;
+}
+
+void ScriptEnvironment::serializeGlobals(LuaBinderSerializeGlobalsCallback& callback)
+{
+	ANKI_ASSERT(isInitialized());
+	LockGuard<Mutex> lock(*m_mtx);
+	pushGlobalsTable();
+	LuaBinder::serializeTable(m_lua->getLuaState(), callback);
+	lua_pop(m_lua->getLuaState(), 1);
+}
+
+void ScriptEnvironment::deserializeGlobals(const void* data, PtrSize dataSize)
+{
+	ANKI_ASSERT(isInitialized());
+	LockGuard<Mutex> lock(*m_mtx);
+	pushGlobalsTable();
+	LuaBinder::deserializeTable(m_lua->getLuaState(), data, dataSize);
+	lua_pop(m_lua->getLuaState(), 1);
+}
+
+void ScriptEnvironment::pushGlobal(CString name)
+{
+	ANKI_ASSERT(isInitialized());
+	lua_State* l = m_lua->getLuaState();
+	pushGlobalsTable();
+	lua_getfield(l, -1, name.cstr());
+	lua_remove(l, -2);
 }
 
 } // end namespace anki
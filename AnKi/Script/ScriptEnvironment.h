@@ -6,13 +6,16 @@
 #pragma once
 
 #include <AnKi/Script/LuaBinder.h>
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Thread.h>
 
 namespace anki {
 
 /// @addtogroup script
 /// @{
 
-/// A sandboxed LUA environment.
+/// A sandboxed LUA environment. The environments share a few VMs of the ScriptManager. The globals that the scripts of
+/// an environment create live in a table of the VM and the bindings and the LUA libraries are shared.
 class ScriptEnvironment
 {
 public:
@@ -20,10 +23,13 @@ public:
 	{
 	}
 
-	~ScriptEnvironment()
-	{
-	}
+	ScriptEnvironment(const ScriptEnvironment&) = delete; // Non-copyable
+
+	~ScriptEnvironment();
 
+	ScriptEnvironment& operator=(const ScriptEnvironment&) = delete; // Non-copyable
+
+	/// @note Don't call it while running a script since the VM might be the same.
 	Error init(ScriptManager* manager);
 
 	Bool isInitialized() const
@@ -36,37 +42,79 @@ public:
 	void exposeVariable(const char* name, T* y)
 	{
 		ANKI_ASSERT(isInitialized());
-		LuaBinder::exposeVariable<T>(m_thread.getLuaState(), name, y);
+		LockGuard<Mutex> lock(*m_mtx);
+		lua_State* l = m_lua->getLuaState();
+		pushGlobalsTable();
+		LuaBinder::pushVariableToTheStack(l, y);
+		lua_setfield(l, -2, name);
+		lua_pop(l, 1);
 	}
 
 	/// Evaluate a string
 	ANKI_USE_RESULT Error evalString(const CString& str)
+	{
+		return evalChunk(str.cstr(), str.getLength(), str);
+	}
+
+	/// Evaluate a string that was compiled with LuaBinder::compileString().
+	ANKI_USE_RESULT Error evalBytecode(ConstWeakArray<U8> bytecode)
+	{
+		ANKI_ASSERT(bytecode.getSize() > 0);
+		return evalChunk(&bytecode[0], bytecode.getSize(), "=bytecode");
+	}
+
+	void serializeGlobals(LuaBinderSerializeGlobalsCallback& callback);
+
+	void deserializeGlobals(const void* data, PtrSize dataSize);
+
+	/// Push a global variable of the environment to the stack.
+	/// @note Lock getLuaStateMutex() before calling it.
+	void pushGlobal(CString name);
+
+	/// The lua_State is shared with other environments and possibly other threads.
+	/// @note Lock getLuaStateMutex() before using it.
+	lua_State& getLuaState()
 	{
 		ANKI_ASSERT(isInitialized());
-		return LuaBinder::evalString(m_thread.getLuaState(), str);
+		return *m_lua->getLuaState();
 	}
 
-	void serializeGlobals(LuaBinderSerializeGlobalsCallback& callback)
+	Mutex& getLuaStateMutex()
 	{
 		ANKI_ASSERT(isInitialized());
-		LuaBinder::serializeGlobals(m_thread.getLuaState(), callback);
+		return *m_mtx;
 	}
 
-	void deserializeGlobals(const void* data, PtrSize dataSize)
+	/// Configure the garbage collector.
+	/// @note The environments that share the VM share the collector too so it changes theirs as well.
+	void setGarbageCollectorConfig(const LuaGarbageCollectorConfig& config)
 	{
 		ANKI_ASSERT(isInitialized());
-		LuaBinder::deserializeGlobals(m_thread.getLuaState(), data, dataSize);
+		LockGuard<Mutex> lock(*m_mtx);
+		m_lua->setGarbageCollectorConfig(config);
 	}
 
-	lua_State& getLuaState()
+	/// Get the allocation statistics of the VM. They include the allocations of the environments that share the VM.
+	LuaBinderAllocationStats getAllocationStats() const
 	{
 		ANKI_ASSERT(isInitialized());
-		return *m_thread.getLuaState();
+		LockGuard<Mutex> lock(*m_mtx);
+		return m_lua->getAllocationStats();
 	}
 
 private:
 	ScriptManager* m_manager = nullptr;
-	LuaBinder m_thread;
+	LuaBinder* m_lua = nullptr;
+	Mutex* m_mtx = nullptr;
+	I32 m_globalsRef = LUA_NOREF; ///< A reference to the table with the globals in the registry of the VM.
+
+	ANKI_USE_RESULT Error evalChunk(const void* chunk, PtrSize chunkSize, const CString& chunkName);
+
+	/// Push the table with the globals to the stack.
+	void pushGlobalsTable()
+	{
+		lua_rawgeti(m_lua->getLuaState(), LUA_REGISTRYINDEX, m_globalsRef);
+	}
 };
 /// @}
 
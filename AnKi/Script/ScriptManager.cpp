@@ -16,16 +16,24 @@ ScriptManager::ScriptManager()
 ScriptManager::~ScriptManager()
 {
 	ANKI_SCRIPT_LOGI("Destroying scripting engine...");
+	m_environmentVms.destroy(m_alloc);
 }
 
-Error ScriptManager::init(AllocAlignedCallback allocCb, void* allocCbData)
+Error ScriptManager::init(AllocAlignedCallback allocCb, void* allocCbData, U32 environmentVmCount)
 {
 	ANKI_SCRIPT_LOGI("Initializing scripting engine...");
+	ANKI_ASSERT(environmentVmCount > 0);
 
-	m_alloc = ScriptAllocator(allocCb, allocCbData);
+	m_alloc = ScriptAllocator(allocCb, allocCbData, "Script");
 
 	ANKI_CHECK(m_lua.init(m_alloc, &m_otherSystems));
 
+	m_environmentVms.create(m_alloc, environmentVmCount);
+	for(EnvironmentVm& vm : m_environmentVms)
+	{
+		ANKI_CHECK(vm.m_lua.init(m_alloc, &m_otherSystems));
+	}
+
 	return Error::NONE;
 }
 
@@ -24,7 +24,9 @@ public:
 	~ScriptManager();
 
 	/// Create the script manager.
-	ANKI_USE_RESULT Error init(AllocAlignedCallback allocCb, void* allocCbData);
+	/// @param environmentVmCount The number of VMs that the ScriptEnvironments share. Ideally one per thread that runs
+	///                           scripts.
+	ANKI_USE_RESULT Error init(AllocAlignedCallback allocCb, void* allocCbData, U32 environmentVmCount = 1);
 
 	void setRenderer(MainRenderer* renderer)
 	{
@@ -67,10 +69,29 @@ public:
 	}
 
 private:
+	friend class ScriptEnvironment;
+
+	/// A VM with all the bindings registered that is shared by many ScriptEnvironments.
+	class EnvironmentVm
+	{
+	public:
+		LuaBinder m_lua;
+		Mutex m_mtx;
+	};
+
 	LuaBinderOtherSystems m_otherSystems;
 	ScriptAllocator m_alloc;
 	LuaBinder m_lua;
 	Mutex n_luaMtx;
+
+	DynamicArray<EnvironmentVm> m_environmentVms;
+	Atomic<U32> m_nextEnvironmentVm = {0};
+
+	/// Spread the environments to the VMs.
+	EnvironmentVm& chooseEnvironmentVm()
+	{
+		return m_environmentVms[m_nextEnvironmentVm.fetchAdd(1) % m_environmentVms.getSize()];
+	}
 };
 /// @}
 
@@ -74,7 +74,7 @@ class ShaderProgramBinaryBlock
 {
 public:
 	Array<char, MAX_SHADER_BINARY_NAME_LENGTH + 1> m_name = {};
-	WeakArray<ShaderProgramBinaryVariable> m_variables;
+	RelativeWeakArray<ShaderProgramBinaryVariable> m_variables;
 	U32 m_binding = MAX_U32;
 	U32 m_set = MAX_U32;
 
@@ -107,7 +107,7 @@ public:
 	/// Points to ShaderProgramBinary::m_uniformBlocks or m_storageBlocks.
 	U32 m_index = MAX_U32;
 
-	WeakArray<ShaderProgramBinaryVariableInstance> m_variableInstances;
+	RelativeWeakArray<ShaderProgramBinaryVariableInstance> m_variableInstances;
 	U32 m_size = MAX_U32;
 
 	template<typename TSerializer, typename TClass>
@@ -318,7 +318,7 @@ class ShaderProgramBinaryStruct
 {
 public:
 	Array<char, MAX_SHADER_BINARY_NAME_LENGTH + 1> m_name;
-	WeakArray<ShaderProgramBinaryStructMember> m_members;
+	RelativeWeakArray<ShaderProgramBinaryStructMember> m_members;
 
 	template<typename TSerializer, typename TClass>
 	static void serializeCommon(TSerializer& s, TClass self)
@@ -347,7 +347,7 @@ public:
 	/// Points to ShaderProgramBinary::m_structs.
 	U32 m_index;
 
-	WeakArray<ShaderProgramBinaryStructMemberInstance> m_memberInstances;
+	RelativeWeakArray<ShaderProgramBinaryStructMemberInstance> m_memberInstances;
 	U32 m_size = MAX_U32;
 
 	template<typename TSerializer, typename TClass>
@@ -379,12 +379,12 @@ public:
 	/// Index in ShaderProgramBinary::m_codeBlocks. MAX_U32 means no shader.
 	Array<U32, U32(ShaderType::COUNT)> m_codeBlockIndices = {};
 
-	WeakArray<ShaderProgramBinaryBlockInstance> m_uniformBlocks;
-	WeakArray<ShaderProgramBinaryBlockInstance> m_storageBlocks;
-	ShaderProgramBinaryBlockInstance* m_pushConstantBlock = nullptr;
-	WeakArray<ShaderProgramBinaryOpaqueInstance> m_opaques;
-	WeakArray<ShaderProgramBinaryConstantInstance> m_constants;
-	WeakArray<ShaderProgramBinaryStructInstance> m_structs;
+	RelativeWeakArray<ShaderProgramBinaryBlockInstance> m_uniformBlocks;
+	RelativeWeakArray<ShaderProgramBinaryBlockInstance> m_storageBlocks;
+	RelativePtr<ShaderProgramBinaryBlockInstance> m_pushConstantBlock = nullptr;
+	RelativeWeakArray<ShaderProgramBinaryOpaqueInstance> m_opaques;
+	RelativeWeakArray<ShaderProgramBinaryConstantInstance> m_constants;
+	RelativeWeakArray<ShaderProgramBinaryStructInstance> m_structs;
 	Array<U32, 3> m_workgroupSizes = {MAX_U32, MAX_U32, MAX_U32};
 
 	/// Indices to ShaderProgramBinary::m_constants.
@@ -397,8 +397,8 @@ public:
 				  &self.m_codeBlockIndices[0], self.m_codeBlockIndices.getSize());
 		s.doValue("m_uniformBlocks", offsetof(ShaderProgramBinaryVariant, m_uniformBlocks), self.m_uniformBlocks);
 		s.doValue("m_storageBlocks", offsetof(ShaderProgramBinaryVariant, m_storageBlocks), self.m_storageBlocks);
-		s.doPointer("m_pushConstantBlock", offsetof(ShaderProgramBinaryVariant, m_pushConstantBlock),
-					self.m_pushConstantBlock);
+		s.doRelativePointer("m_pushConstantBlock", offsetof(ShaderProgramBinaryVariant, m_pushConstantBlock),
+						   self.m_pushConstantBlock.get());
 		s.doValue("m_opaques", offsetof(ShaderProgramBinaryVariant, m_opaques), self.m_opaques);
 		s.doValue("m_constants", offsetof(ShaderProgramBinaryVariant, m_constants), self.m_constants);
 		s.doValue("m_structs", offsetof(ShaderProgramBinaryVariant, m_structs), self.m_structs);
@@ -426,7 +426,7 @@ class ShaderProgramBinaryMutator
 {
 public:
 	Array<char, MAX_SHADER_BINARY_NAME_LENGTH + 1> m_name = {};
-	WeakArray<MutatorValue> m_values;
+	RelativeWeakArray<MutatorValue> m_values;
 
 	template<typename TSerializer, typename TClass>
 	static void serializeCommon(TSerializer& s, TClass self)
@@ -452,7 +452,7 @@ public:
 class ShaderProgramBinaryCodeBlock
 {
 public:
-	WeakArray<U8> m_binary;
+	RelativeWeakArray<U8> m_binary;
 	U64 m_hash = 0;
 
 	template<typename TSerializer, typename TClass>
@@ -479,7 +479,7 @@ public:
 class ShaderProgramBinaryMutation
 {
 public:
-	WeakArray<MutatorValue> m_values;
+	RelativeWeakArray<MutatorValue> m_values;
 
 	/// Points to ShaderProgramBinary::m_variants.
 	U32 m_variantIndex = MAX_U32;
@@ -513,19 +513,19 @@ class ShaderProgramBinary
 {
 public:
 	Array<U8, 8> m_magic = {};
-	WeakArray<ShaderProgramBinaryMutator> m_mutators;
-	WeakArray<ShaderProgramBinaryCodeBlock> m_codeBlocks;
-	WeakArray<ShaderProgramBinaryVariant> m_variants;
+	RelativeWeakArray<ShaderProgramBinaryMutator> m_mutators;
+	RelativeWeakArray<ShaderProgramBinaryCodeBlock> m_codeBlocks;
+	RelativeWeakArray<ShaderProgramBinaryVariant> m_variants;
 
 	/// It's sorted using the mutation's hash.
-	WeakArray<ShaderProgramBinaryMutation> m_mutations;
-
-	WeakArray<ShaderProgramBinaryBlock> m_uniformBlocks;
-	WeakArray<ShaderProgramBinaryBlock> m_storageBlocks;
-	ShaderProgramBinaryBlock* m_pushConstantBlock = nullptr;
-	WeakArray<ShaderProgramBinaryOpaque> m_opaques;
-	WeakArray<ShaderProgramBinaryConstant> m_constants;
-	WeakArray<ShaderProgramBinaryStruct> m_structs;
+	RelativeWeakArray<ShaderProgramBinaryMutation> m_mutations;
+
+	RelativeWeakArray<ShaderProgramBinaryBlock> m_uniformBlocks;
+	RelativeWeakArray<ShaderProgramBinaryBlock> m_storageBlocks;
+	RelativePtr<ShaderProgramBinaryBlock> m_pushConstantBlock = nullptr;
+	RelativeWeakArray<ShaderProgramBinaryOpaque> m_opaques;
+	RelativeWeakArray<ShaderProgramBinaryConstant> m_constants;
+	RelativeWeakArray<ShaderProgramBinaryStruct> m_structs;
 	ShaderTypeBit m_presentShaderTypes = ShaderTypeBit::NONE;
 
 	/// The name of the shader library. Mainly for RT shaders.
@@ -544,8 +544,8 @@ public:
 		s.doValue("m_mutations", offsetof(ShaderProgramBinary, m_mutations), self.m_mutations);
 		s.doValue("m_uniformBlocks", offsetof(ShaderProgramBinary, m_uniformBlocks), self.m_uniformBlocks);
 		s.doValue("m_storageBlocks", offsetof(ShaderProgramBinary, m_storageBlocks), self.m_storageBlocks);
-		s.doPointer("m_pushConstantBlock", offsetof(ShaderProgramBinary, m_pushConstantBlock),
-					self.m_pushConstantBlock);
+		s.doRelativePointer("m_pushConstantBlock", offsetof(ShaderProgramBinary, m_pushConstantBlock),
+						   self.m_pushConstantBlock.get());
 		s.doValue("m_opaques", offsetof(ShaderProgramBinary, m_opaques), self.m_opaques);
 		s.doValue("m_constants", offsetof(ShaderProgramBinary, m_constants), self.m_constants);
 		s.doValue("m_structs", offsetof(ShaderProgramBinary, m_structs), self.m_structs);
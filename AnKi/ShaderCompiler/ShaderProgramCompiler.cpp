@@ -32,13 +32,15 @@ Error ShaderProgramBinaryWrapper::deserializeFromFile(CString fname)
 {
 	cleanup();
 
-	File file;
-	ANKI_CHECK(file.open(fname, FileOpenFlag::READ | FileOpenFlag::BINARY));
+	// The binary has only relative pointers so use the file in place. It saves reading and copying the whole file
+	ANKI_CHECK(m_file.open(fname));
 
-	BinaryDeserializer deserializer;
-	ANKI_CHECK(deserializer.deserialize(m_binary, m_alloc, file));
+	const ShaderProgramBinary* binary;
+	ANKI_CHECK(BinaryDeserializer::deserializeInPlace(binary,
+													  ConstWeakArray<U8, PtrSize>(m_file.getData(), m_file.getSize())));
 
-	m_singleAllocation = true;
+	// The mapping is read-only but the binary won't be written after the deserialization
+	m_binary = const_cast<ShaderProgramBinary*>(binary);
 
 	if(memcmp(SHADER_BINARY_MAGIC, &m_binary->m_magic[0], strlen(SHADER_BINARY_MAGIC)) != 0)
 	{
@@ -52,6 +54,13 @@ Error ShaderProgramBinaryWrapper::deserializeFromFile(CString fname)
 
 void ShaderProgramBinaryWrapper::cleanup()
 {
+	if(m_file.isOpen())
+	{
+		m_file.close();
+		m_binary = nullptr;
+		return;
+	}
+
 	if(m_binary == nullptr)
 	{
 		return;
@@ -59,89 +68,85 @@ void ShaderProgramBinaryWrapper::cleanup()
 
 	BaseMemoryPool& mempool = m_alloc.getMemoryPool();
 
-	if(!m_singleAllocation)
+	for(ShaderProgramBinaryMutator& mutator : m_binary->m_mutators)
 	{
-		for(ShaderProgramBinaryMutator& mutator : m_binary->m_mutators)
-		{
-			mempool.free(mutator.m_values.getBegin());
-		}
-		mempool.free(m_binary->m_mutators.getBegin());
+		mempool.free(mutator.m_values.getBegin());
+	}
+	mempool.free(m_binary->m_mutators.getBegin());
 
-		for(ShaderProgramBinaryCodeBlock& code : m_binary->m_codeBlocks)
-		{
-			mempool.free(code.m_binary.getBegin());
-		}
-		mempool.free(m_binary->m_codeBlocks.getBegin());
+	for(ShaderProgramBinaryCodeBlock& code : m_binary->m_codeBlocks)
+	{
+		mempool.free(code.m_binary.getBegin());
+	}
+	mempool.free(m_binary->m_codeBlocks.getBegin());
 
-		for(ShaderProgramBinaryMutation& m : m_binary->m_mutations)
-		{
-			mempool.free(m.m_values.getBegin());
-		}
-		mempool.free(m_binary->m_mutations.getBegin());
+	for(ShaderProgramBinaryMutation& m : m_binary->m_mutations)
+	{
+		mempool.free(m.m_values.getBegin());
+	}
+	mempool.free(m_binary->m_mutations.getBegin());
 
-		for(ShaderProgramBinaryBlock& block : m_binary->m_uniformBlocks)
-		{
-			mempool.free(block.m_variables.getBegin());
-		}
-		mempool.free(m_binary->m_uniformBlocks.getBegin());
+	for(ShaderProgramBinaryBlock& block : m_binary->m_uniformBlocks)
+	{
+		mempool.free(block.m_variables.getBegin());
+	}
+	mempool.free(m_binary->m_uniformBlocks.getBegin());
+
+	for(ShaderProgramBinaryBlock& block : m_binary->m_storageBlocks)
+	{
+		mempool.free(block.m_variables.getBegin());
+	}
+	mempool.free(m_binary->m_storageBlocks.getBegin());
 
-		for(ShaderProgramBinaryBlock& block : m_binary->m_storageBlocks)
+	if(m_binary->m_pushConstantBlock)
+	{
+		mempool.free(m_binary->m_pushConstantBlock->m_variables.getBegin());
+		mempool.free(m_binary->m_pushConstantBlock);
+	}
+
+	mempool.free(m_binary->m_opaques.getBegin());
+	mempool.free(m_binary->m_constants.getBegin());
+
+	for(ShaderProgramBinaryStruct& s : m_binary->m_structs)
+	{
+		mempool.free(s.m_members.getBegin());
+	}
+
+	mempool.free(m_binary->m_structs.getBegin());
+
+	for(ShaderProgramBinaryVariant& variant : m_binary->m_variants)
+	{
+		for(ShaderProgramBinaryBlockInstance& block : variant.m_uniformBlocks)
 		{
-			mempool.free(block.m_variables.getBegin());
+			mempool.free(block.m_variableInstances.getBegin());
 		}
-		mempool.free(m_binary->m_storageBlocks.getBegin());
 
-		if(m_binary->m_pushConstantBlock)
+		for(ShaderProgramBinaryBlockInstance& block : variant.m_storageBlocks)
 		{
-			mempool.free(m_binary->m_pushConstantBlock->m_variables.getBegin());
-			mempool.free(m_binary->m_pushConstantBlock);
+			mempool.free(block.m_variableInstances.getBegin());
 		}
 
-		mempool.free(m_binary->m_opaques.getBegin());
-		mempool.free(m_binary->m_constants.getBegin());
-
-		for(ShaderProgramBinaryStruct& s : m_binary->m_structs)
+		if(variant.m_pushConstantBlock)
 		{
-			mempool.free(s.m_members.getBegin());
+			mempool.free(variant.m_pushConstantBlock->m_variableInstances.getBegin());
 		}
 
-		mempool.free(m_binary->m_structs.getBegin());
-
-		for(ShaderProgramBinaryVariant& variant : m_binary->m_variants)
+		for(ShaderProgramBinaryStructInstance& struct_ : variant.m_structs)
 		{
-			for(ShaderProgramBinaryBlockInstance& block : variant.m_uniformBlocks)
-			{
-				mempool.free(block.m_variableInstances.getBegin());
-			}
-
-			for(ShaderProgramBinaryBlockInstance& block : variant.m_storageBlocks)
-			{
-				mempool.free(block.m_variableInstances.getBegin());
-			}
-
-			if(variant.m_pushConstantBlock)
-			{
-				mempool.free(variant.m_pushConstantBlock->m_variableInstances.getBegin());
-			}
-
-			for(ShaderProgramBinaryStructInstance& struct_ : variant.m_structs)
-			{
-				mempool.free(struct_.m_memberInstances.getBegin());
-			}
-
-			mempool.free(variant.m_uniformBlocks.getBegin());
-			mempool.free(variant.m_storageBlocks.getBegin());
-			mempool.free(variant.m_pushConstantBlock);
-			mempool.free(variant.m_constants.getBegin());
-			mempool.free(variant.m_opaques.getBegin());
-			mempool.free(variant.m_structs.getBegin());
+			mempool.free(struct_.m_memberInstances.getBegin());
 		}
-		mempool.free(m_binary->m_variants.getBegin());
+
+		mempool.free(variant.m_uniformBlocks.getBegin());
+		mempool.free(variant.m_storageBlocks.getBegin());
+		mempool.free(variant.m_pushConstantBlock);
+		mempool.free(variant.m_constants.getBegin());
+		mempool.free(variant.m_opaques.getBegin());
+		mempool.free(variant.m_structs.getBegin());
 	}
+	mempool.free(m_binary->m_variants.getBegin());
 
 	mempool.free(m_binary);
 	m_binary = nullptr;
-	m_singleAllocation = false;
 }
 
 /// Spin the dials. Used to compute all mutator combinations.
@@ -787,7 +792,8 @@ static Error doReflection(const StringList& symbolsToReflect, ShaderProgramBinar
 		{
 			if(variant.m_codeBlockIndices[stage] != MAX_U32)
 			{
-				spirvs[stage] = binary.m_codeBlocks[variant.m_codeBlockIndices[stage]].m_binary;
+				const ShaderProgramBinaryCodeBlock& codeBlock = binary.m_codeBlocks[variant.m_codeBlockIndices[stage]];
+				spirvs[stage] = ConstWeakArray<U8>(codeBlock.m_binary.getBegin(), codeBlock.m_binary.getSize());
 			}
 		}
 
@@ -945,7 +951,6 @@ Error compileShaderProgramInternal(CString fname, ShaderProgramFilesystemInterfa
 {
 	// Initialize the binary
 	binaryW.cleanup();
-	binaryW.m_singleAllocation = false;
 	GenericMemoryPoolAllocator<U8> binaryAllocator = binaryW.m_alloc;
 	binaryW.m_binary = binaryAllocator.newInstance<ShaderProgramBinary>();
 	ShaderProgramBinary& binary = *binaryW.m_binary;
@@ -7,6 +7,7 @@
 
 #include <AnKi/ShaderCompiler/ShaderProgramDump.h>
 #include <AnKi/Util/String.h>
+#include <AnKi/Util/File.h>
 #include <AnKi/Gr/Common.h>
 
 namespace anki {
@@ -14,8 +15,8 @@ namespace anki {
 /// @addtogroup shader_compiler
 /// @{
 
-constexpr const char* SHADER_BINARY_MAGIC = "ANKISDR7"; ///< WARNING: If changed change SHADER_BINARY_VERSION
-constexpr U32 SHADER_BINARY_VERSION = 7;
+constexpr const char* SHADER_BINARY_MAGIC = "ANKISDR8"; ///< WARNING: If changed change SHADER_BINARY_VERSION
+constexpr U32 SHADER_BINARY_VERSION = 8;
 
 /// A wrapper over the POD ShaderProgramBinary class.
 /// @memberof ShaderProgramCompiler
@@ -56,7 +57,7 @@ public:
 private:
 	GenericMemoryPoolAllocator<U8> m_alloc;
 	ShaderProgramBinary* m_binary = nullptr;
-	Bool m_singleAllocation = false;
+	MemoryMappedFile m_file; ///< The binary points inside the file when it's deserialized.
 
 	void cleanup();
 };
@@ -0,0 +1,46 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Shaders/Include/Common.h>
+
+ANKI_BEGIN_NAMESPACE
+
+const U32 GPU_SCENE_INVALID_DRAW_BUCKET = 0xFFFFFFFFu;
+const U32 GPU_SCENE_UPDATE_WORKGROUP_SIZE = 64u;
+
+/// A renderable instance that lives in the persistent GPU scene buffer. It only gets uploaded when it changes.
+struct GpuSceneInstance
+{
+	Mat3x4 m_worldTransform;
+	Mat3x4 m_previousWorldTransform;
+
+	Vec3 m_aabbMin;
+	/// The 1st of the MAX_LOD_COUNT consecutive buckets (program and geometry) it belongs to. One bucket per
+	/// LOD. GPU_SCENE_INVALID_DRAW_BUCKET if the instance is free.
+	U32 m_drawBucket;
+
+	Vec3 m_aabbMax;
+	U32 m_lodCount;
+
+	UVec4 m_indexCounts; ///< One per LOD. The w is unused.
+	UVec4 m_firstIndices; ///< One per LOD. The w is unused.
+};
+
+const U32 _ANKI_SIZEOF_GpuSceneInstance = 2u * 12u * 4u + 4u * 4u * 4u;
+const U32 _ANKI_ALIGNOF_GpuSceneInstance = 16u;
+ANKI_SHADER_STATIC_ASSERT(_ANKI_SIZEOF_GpuSceneInstance == sizeof(GpuSceneInstance));
+
+/// Uniforms of the pass that scatters the updated instances to the GPU scene.
+struct GpuSceneUpdateUniforms
+{
+	U32 m_updateCount;
+	U32 m_padding0;
+	U32 m_padding1;
+	U32 m_padding2;
+};
+
+ANKI_END_NAMESPACE
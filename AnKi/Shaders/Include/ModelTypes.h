@@ -67,10 +67,10 @@ struct MainVertex
 {
 	U32 m_normal; ///< Packed in a custom R11G11B10_SNorm
 	U32 m_tangent; ///< Packed in a custom R10G10B11A1_SNorm format
-	Vec2 m_uv0;
+	U32 m_uv0; ///< Packed in R16G16_SFLOAT. Use unpackHalf2x16
 };
 
-const U32 _ANKI_SIZEOF_MainVertex = 4u * 4u;
+const U32 _ANKI_SIZEOF_MainVertex = 3u * 4u;
 const U32 _ANKI_ALIGNOF_MainVertex = 4u;
 ANKI_SHADER_STATIC_ASSERT(_ANKI_SIZEOF_MainVertex == sizeof(MainVertex));
 
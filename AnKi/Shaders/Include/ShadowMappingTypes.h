@@ -17,10 +17,18 @@ struct ShadowMappingUniforms
 	Vec2 m_uvTranslation;
 	Vec2 m_uvMin;
 	Vec2 m_uvMax;
+	Vec2 m_staticCacheUvScale; ///< Maps the [m_uvMin, m_uvMax] range to the tile in the static cache.
+	Vec2 m_staticCacheUvTranslation;
 	U32 m_blur;
+	U32 m_staticCache; ///< If not zero the static casters are in the static cache.
 	U32 m_padding0;
 	U32 m_padding1;
-	U32 m_padding2;
+};
+
+struct ShadowMappingStaticCacheCopyUniforms
+{
+	IVec2 m_inOffset;
+	IVec2 m_outOffset;
 };
 
 ANKI_END_NAMESPACE
@@ -25,7 +25,7 @@ Error UiManager::init(AllocAlignedCallback allocCallback, void* allocCallbackUse
 	ANKI_ASSERT(gpuMem);
 	ANKI_ASSERT(input);
 
-	m_alloc = UiAllocator(allocCallback, allocCallbackUserData);
+	m_alloc = UiAllocator(allocCallback, allocCallbackUserData, "Ui");
 	m_resources = resources;
 	m_gr = gr;
 	m_gpuMem = gpuMem;
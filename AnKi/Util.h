@@ -13,6 +13,7 @@
 #include <AnKi/Util/BitMask.h>
 #include <AnKi/Util/DynamicArray.h>
 #include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/RelativePtr.h>
 #include <AnKi/Util/Enum.h>
 #include <AnKi/Util/File.h>
 #include <AnKi/Util/Filesystem.h>
@@ -44,6 +45,11 @@
 #include <AnKi/Util/BuddyAllocatorBuilder.h>
 #include <AnKi/Util/StackAllocatorBuilder.h>
 #include <AnKi/Util/ClassAllocatorBuilder.h>
+#include <AnKi/Util/RadixSort.h>
+#include <AnKi/Util/AllocationSiteProfiler.h>
+#include <AnKi/Util/FlatHashMap.h>
+#include <AnKi/Util/ShardedHashMap.h>
+#include <AnKi/Util/StringTable.h>
 
 /// @defgroup util Utilities (like STL)
 
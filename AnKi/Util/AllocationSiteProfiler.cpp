@@ -0,0 +1,114 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Util/AllocationSiteProfiler.h>
+#include <AnKi/Util/System.h>
+#include <AnKi/Util/Logger.h>
+#include <algorithm>
+
+namespace anki {
+
+/// Don't keep the whole callstack, the outermost frames are the same for all allocations.
+static constexpr U32 MAX_CALLSTACK_FRAMES = 12;
+
+/// Return true if the frame belongs to the profiler or the memory pools and not to the code that allocates.
+static Bool isProfilerFrame(CString symbol)
+{
+	const Array<CString, 3> tokens = {"backtrace", "AllocationSiteProfiler", "MemoryPool"};
+	for(CString token : tokens)
+	{
+		if(symbol.find(token) != CString::NPOS)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+AllocationSiteProfiler::~AllocationSiteProfiler()
+{
+	for(AllocationSite& site : m_sites)
+	{
+		site.m_callstack.destroy(m_alloc);
+	}
+
+	m_sites.destroy(m_alloc);
+}
+
+void AllocationSiteProfiler::sampleCallback(void* userData, const BaseMemoryPool& pool, PtrSize size)
+{
+	ANKI_ASSERT(userData);
+	AllocationSiteProfiler& self = *static_cast<AllocationSiteProfiler*>(userData);
+	(void)pool;
+
+	// Get the callstack. Skip the innermost frames of the profiler and the pool
+	StringAuto callstack(self.m_alloc);
+	U32 frameCount = 0;
+	backtrace(self.m_alloc, [&](CString symbol) {
+		if((frameCount == 0 && isProfilerFrame(symbol)) || frameCount >= MAX_CALLSTACK_FRAMES)
+		{
+			return;
+		}
+
+		callstack.append(symbol);
+		callstack.append("\n");
+		++frameCount;
+	});
+
+	if(callstack.isEmpty())
+	{
+		callstack.create("<unknown>");
+	}
+
+	const U64 hash = computeHash(callstack.cstr(), callstack.getLength());
+
+	LockGuard<Mutex> lock(self.m_mtx);
+
+	auto it = self.m_sites.find(hash);
+	if(it == self.m_sites.getEnd())
+	{
+		it = self.m_sites.emplace(self.m_alloc, hash);
+		it->m_callstack.create(self.m_alloc, callstack);
+	}
+
+	++it->m_sampleCount;
+	it->m_sampledBytes += size;
+}
+
+void AllocationSiteProfiler::gatherHotspots(U32 maxSiteCount, DynamicArrayAuto<const AllocationSite*>& sites) const
+{
+	if(m_sites.isEmpty())
+	{
+		return;
+	}
+
+	sites.create(U32(m_sites.getSize()));
+	U32 count = 0;
+	for(const AllocationSite& site : m_sites)
+	{
+		sites[count++] = &site;
+	}
+
+	std::sort(sites.getBegin(), sites.getEnd(), [](const AllocationSite* a, const AllocationSite* b) {
+		return a->m_sampledBytes > b->m_sampledBytes;
+	});
+
+	if(sites.getSize() > maxSiteCount)
+	{
+		sites.resize(maxSiteCount);
+	}
+}
+
+void AllocationSiteProfiler::logHotspots(U32 maxSiteCount) const
+{
+	U32 count = 0;
+	visitHotspots(maxSiteCount, [&count](const AllocationSite& site) {
+		ANKI_UTIL_LOGI("Allocation hotspot #%u: %" PRIu64 " samples, %zu bytes sampled. Callstack:\n%s", count++,
+					   site.m_sampleCount, site.m_sampledBytes, site.m_callstack.cstr());
+	});
+}
+
+} // end namespace anki
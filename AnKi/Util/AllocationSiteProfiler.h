@@ -0,0 +1,96 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/Memory.h>
+#include <AnKi/Util/Allocator.h>
+#include <AnKi/Util/Hash.h>
+#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/String.h>
+#include <AnKi/Util/DynamicArray.h>
+
+namespace anki {
+
+/// @addtogroup util_memory
+/// @{
+
+/// A callstack that allocated from a memory pool. See AllocationSiteProfiler.
+class AllocationSite
+{
+public:
+	String m_callstack; ///< The symbols of the callstack, one per line.
+	U64 m_sampleCount = 0;
+	PtrSize m_sampledBytes = 0;
+};
+
+/// Samples the allocations of some memory pools and groups them by callstack to find the code that allocates the most.
+/// It's slow since it gets a backtrace on every sample so use a big sample period.
+class AllocationSiteProfiler
+{
+public:
+	/// @param alloc The allocator for the internal structures. It shouldn't allocate from a pool that is sampled.
+	AllocationSiteProfiler(GenericMemoryPoolAllocator<U8> alloc)
+		: m_alloc(alloc)
+	{
+	}
+
+	AllocationSiteProfiler(const AllocationSiteProfiler&) = delete; // Non-copyable
+
+	~AllocationSiteProfiler();
+
+	AllocationSiteProfiler& operator=(const AllocationSiteProfiler&) = delete; // Non-copyable
+
+	/// Start sampling a pool. Call stopSampling() before the profiler gets destroyed.
+	/// @note It's not thread-safe. See BaseMemoryPool::setAllocationSampling().
+	void startSampling(BaseMemoryPool& pool, U32 samplePeriod)
+	{
+		ANKI_ASSERT(samplePeriod > 0);
+		pool.setAllocationSampling(samplePeriod, sampleCallback, this);
+	}
+
+	void stopSampling(BaseMemoryPool& pool)
+	{
+		pool.setAllocationSampling(0, nullptr, nullptr);
+	}
+
+	/// Get the number of the different callstacks that were sampled.
+	U32 getSiteCount() const
+	{
+		LockGuard<Mutex> lock(m_mtx);
+		return U32(m_sites.getSize());
+	}
+
+	/// Visit the sites that allocated the most bytes, the worst first.
+	/// @param maxSiteCount Visit up to that many sites.
+	/// @param func A functor with signature void(const AllocationSite&).
+	/// @note Don't allocate from a sampled pool inside the functor.
+	template<typename TFunc>
+	void visitHotspots(U32 maxSiteCount, TFunc func) const
+	{
+		LockGuard<Mutex> lock(m_mtx);
+		DynamicArrayAuto<const AllocationSite*> sites(m_alloc);
+		gatherHotspots(maxSiteCount, sites);
+		for(const AllocationSite* site : sites)
+		{
+			func(*site);
+		}
+	}
+
+	/// Log the sites that allocated the most bytes.
+	void logHotspots(U32 maxSiteCount) const;
+
+private:
+	GenericMemoryPoolAllocator<U8> m_alloc;
+	mutable Mutex m_mtx;
+	HashMap<U64, AllocationSite> m_sites; ///< The key is the hash of the callstack.
+
+	static void sampleCallback(void* userData, const BaseMemoryPool& pool, PtrSize size);
+
+	void gatherHotspots(U32 maxSiteCount, DynamicArrayAuto<const AllocationSite*>& sites) const;
+};
+/// @}
+
+} // end namespace anki
@@ -264,6 +264,22 @@ public:
 		return MAX_U32;
 	}
 
+	/// Get the least significant bit that is enabled. Or MAX_U32 if all is zero.
+	U32 getLeastSignificantBit() const
+	{
+		for(U32 i = 0; i < CHUNK_COUNT; ++i)
+		{
+			const U64 bits = m_chunks[i];
+			if(bits != 0)
+			{
+				const U32 lsb = U32(__builtin_ctzll(bits));
+				return lsb + (i * CHUNK_BIT_COUNT);
+			}
+		}
+
+		return MAX_U32;
+	}
+
 	Array<TChunkType, CHUNK_COUNT> getData() const
 	{
 		return m_chunks;
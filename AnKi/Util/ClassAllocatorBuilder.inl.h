@@ -96,18 +96,10 @@ Error ClassAllocatorBuilder<TChunk, TInterface, TLock>::allocate(PtrSize size, P
 
 	LockGuard<TLock> lock(cl->m_mtx);
 
-	// Find chunk with free suballocation
-	auto it = cl->m_chunkList.getBegin();
-	const auto end = cl->m_chunkList.getEnd();
-	while(it != end)
+	// Find chunk with free suballocation. The full chunks are kept at the back of the list so only check the front
+	if(!cl->m_chunkList.isEmpty() && cl->m_chunkList.getFront().m_suballocationCount < maxSuballocationCount)
 	{
-		if(it->m_suballocationCount < maxSuballocationCount)
-		{
-			chunk = &(*it);
-			break;
-		}
-
-		++it;
+		chunk = &cl->m_chunkList.getFront();
 	}
 
 	// Create a new chunk if needed
@@ -119,22 +111,21 @@ Error ClassAllocatorBuilder<TChunk, TInterface, TLock>::allocate(PtrSize size, P
 		chunk->m_suballocationCount = 0;
 		chunk->m_class = cl;
 
-		cl->m_chunkList.pushBack(chunk);
+		cl->m_chunkList.pushFront(chunk);
 	}
 
 	// Allocate from chunk
-	const U32 bitCount = U32(maxSuballocationCount);
-	for(U32 i = 0; i < bitCount; ++i)
+	const U32 suballocationIdx = (~chunk->m_inUseSuballocations).getLeastSignificantBit();
+	ANKI_ASSERT(suballocationIdx < maxSuballocationCount);
+	chunk->m_inUseSuballocations.set(suballocationIdx);
+	++chunk->m_suballocationCount;
+	offset = suballocationIdx * cl->m_suballocationSize;
+
+	// Move the chunk out of the way if it's full
+	if(chunk->m_suballocationCount == maxSuballocationCount)
 	{
-		if(!chunk->m_inUseSuballocations.get(i))
-		{
-			// Found an empty slot, allocate from it
-			chunk->m_inUseSuballocations.set(i);
-			++chunk->m_suballocationCount;
-
-			offset = i * cl->m_suballocationSize;
-			break;
-		}
+		cl->m_chunkList.erase(chunk);
+		cl->m_chunkList.pushBack(chunk);
 	}
 
 	ANKI_ASSERT(chunk);
@@ -156,6 +147,7 @@ void ClassAllocatorBuilder<TChunk, TInterface, TLock>::free(TChunk* chunk, PtrSi
 	LockGuard<TLock> lock(cl.m_mtx);
 
 	const U32 suballocationIdx = U32(offset / cl.m_suballocationSize);
+	const Bool wasFull = chunk->m_suballocationCount == cl.m_chunkSize / cl.m_suballocationSize;
 
 	ANKI_ASSERT(chunk->m_inUseSuballocations.get(suballocationIdx));
 	ANKI_ASSERT(chunk->m_suballocationCount > 0);
@@ -167,6 +159,12 @@ void ClassAllocatorBuilder<TChunk, TInterface, TLock>::free(TChunk* chunk, PtrSi
 		cl.m_chunkList.erase(chunk);
 		m_interface.freeChunk(chunk);
 	}
+	else if(wasFull)
+	{
+		// Has free suballocations again, move it to the front
+		cl.m_chunkList.erase(chunk);
+		cl.m_chunkList.pushFront(chunk);
+	}
 }
 
 } // end namespace anki
@@ -142,6 +142,56 @@ private:
 		m_size = 0;
 	}
 };
+
+/// A read-only file that is mapped to memory. Nothing is copied, the OS loads the pages when they are touched and
+/// shares them with its file cache. Only regular files can be mapped.
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile() = default;
+
+	MemoryMappedFile(const MemoryMappedFile&) = delete; // Non-copyable
+
+	/// Unmaps the file.
+	~MemoryMappedFile()
+	{
+		close();
+	}
+
+	MemoryMappedFile& operator=(const MemoryMappedFile&) = delete; // Non-copyable
+
+	/// Map a file. The file shouldn't be empty.
+	ANKI_USE_RESULT Error open(const CString& filename);
+
+	/// Unmap the file.
+	void close();
+
+	Bool isOpen() const
+	{
+		return m_data != nullptr;
+	}
+
+	/// Get the contents. They are aligned to the page size.
+	const U8* getData() const
+	{
+		ANKI_ASSERT(isOpen());
+		return static_cast<const U8*>(m_data);
+	}
+
+	PtrSize getSize() const
+	{
+		ANKI_ASSERT(isOpen());
+		return m_size;
+	}
+
+private:
+	void* m_data = nullptr;
+	PtrSize m_size = 0;
+#if ANKI_OS_WINDOWS
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
 /// @}
 
 } // end namespace anki
@@ -9,11 +9,15 @@
 #define _FILE_OFFSET_BITS 64
 
 #include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/File.h>
 #include <AnKi/Util/Assert.h>
 #include <AnKi/Util/Thread.h>
 #include <cstring>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <dirent.h>
 #include <cerrno>
 #include <ftw.h> // For walkDirectoryTree
@@ -243,4 +247,47 @@ Error getFileModificationTime(CString filename, U32& year, U32& month, U32& day,
 	return Error::NONE;
 }
 
+Error MemoryMappedFile::open(const CString& filename)
+{
+	ANKI_ASSERT(!isOpen());
+
+	const int fd = ::open(filename.cstr(), O_RDONLY);
+	if(fd < 0)
+	{
+		ANKI_UTIL_LOGE("%s : %s", strerror(errno), filename.cstr());
+		return Error::FILE_ACCESS;
+	}
+
+	struct stat info;
+	if(fstat(fd, &info) != 0 || info.st_size == 0)
+	{
+		ANKI_UTIL_LOGE("Can't get the size of the file or the file is empty: %s", filename.cstr());
+		::close(fd);
+		return Error::FILE_ACCESS;
+	}
+
+	void* data = mmap(nullptr, PtrSize(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps the file alive
+	::close(fd);
+	if(data == MAP_FAILED)
+	{
+		ANKI_UTIL_LOGE("mmap() failed: %s : %s", strerror(errno), filename.cstr());
+		return Error::FILE_ACCESS;
+	}
+
+	m_data = data;
+	m_size = PtrSize(info.st_size);
+	return Error::NONE;
+}
+
+void MemoryMappedFile::close()
+{
+	if(m_data)
+	{
+		munmap(m_data, m_size);
+		m_data = nullptr;
+		m_size = 0;
+	}
+}
+
 } // end namespace anki
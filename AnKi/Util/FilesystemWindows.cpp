@@ -4,6 +4,7 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/File.h>
 #include <AnKi/Util/Assert.h>
 #include <AnKi/Util/Logger.h>
 #include <AnKi/Util/Win32Minimal.h>
@@ -197,4 +198,62 @@ Error walkDirectoryTreeInternal(const CString& dir, const Function<Error(const C
 	return walkDirectoryTreeRecursive(dir, callback, baseDirLen);
 }
 
+Error MemoryMappedFile::open(const CString& filename)
+{
+	ANKI_ASSERT(!isOpen());
+
+	HANDLE file = CreateFileA(filename.cstr(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+							  FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		ANKI_UTIL_LOGE("CreateFileA() failed: %s", filename.cstr());
+		return Error::FILE_ACCESS;
+	}
+
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+	{
+		ANKI_UTIL_LOGE("Can't get the size of the file or the file is empty: %s", filename.cstr());
+		CloseHandle(file);
+		return Error::FILE_ACCESS;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if(mapping == nullptr)
+	{
+		ANKI_UTIL_LOGE("CreateFileMappingA() failed: %s", filename.cstr());
+		CloseHandle(file);
+		return Error::FILE_ACCESS;
+	}
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if(data == nullptr)
+	{
+		ANKI_UTIL_LOGE("MapViewOfFile() failed: %s", filename.cstr());
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return Error::FILE_ACCESS;
+	}
+
+	m_data = data;
+	m_size = PtrSize(size.QuadPart);
+	m_file = file;
+	m_mapping = mapping;
+	return Error::NONE;
+}
+
+void MemoryMappedFile::close()
+{
+	if(m_data)
+	{
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping);
+		CloseHandle(m_file);
+		m_data = nullptr;
+		m_size = 0;
+		m_file = nullptr;
+		m_mapping = nullptr;
+	}
+}
+
 } // end namespace anki
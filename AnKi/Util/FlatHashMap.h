@@ -0,0 +1,409 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/HashMap.h>
+#include <AnKi/Math/Simd.h>
+#include <utility>
+#include <cstring>
+
+namespace anki {
+
+/// @addtogroup util_containers
+/// @{
+
+/// The control bytes of FlatHashMap. Every slot of the map has one control byte that is either EMPTY or holds 7 bits
+/// of the hash of the key. A group is 16 consecutive control bytes that are compared in one go.
+class FlatHashMapGroup
+{
+public:
+	static constexpr U32 SIZE = 16;
+	static constexpr U8 EMPTY = 0x80;
+
+	/// A mask of the slots of a group that matched.
+	class Mask
+	{
+	public:
+		Mask(U64 bits)
+			: m_bits(bits)
+		{
+		}
+
+		explicit operator Bool() const
+		{
+			return m_bits != 0;
+		}
+
+		/// Get the index inside the group of the first slot that matched.
+		U32 getFirst() const
+		{
+			ANKI_ASSERT(m_bits);
+			return U32(__builtin_ctzll(m_bits)) >> BIT_SHIFT;
+		}
+
+		/// Remove the first slot from the mask.
+		void removeFirst()
+		{
+			m_bits &= m_bits - 1;
+		}
+
+	private:
+		/// NEON doesn't have movemask so it uses 4 bits per slot.
+		static constexpr U32 BIT_SHIFT = ANKI_SIMD_NEON ? 2 : 0;
+
+		U64 m_bits;
+	};
+
+	/// Find the slots of a group that have a specific control byte.
+	/// @param ctrl The control bytes of the group. It doesn't need to be aligned.
+	static Mask match(const U8* ctrl, U8 value)
+	{
+#if ANKI_SIMD_SSE
+		const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+		return Mask(U32(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(I8(value))))));
+#elif ANKI_SIMD_NEON
+		const uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(value));
+		const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+		return Mask(vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull);
+#else
+		U64 bits = 0;
+		for(U32 i = 0; i < SIZE; ++i)
+		{
+			bits |= U64(ctrl[i] == value) << i;
+		}
+		return Mask(bits);
+#endif
+	}
+};
+
+/// FlatHashMap iterator.
+template<typename TValuePointer, typename TValueReference, typename TMapPointer>
+class FlatHashMapIterator
+{
+	template<typename, typename, typename>
+	friend class FlatHashMapIterator;
+
+	template<typename, typename, typename>
+	friend class FlatHashMap;
+
+public:
+	FlatHashMapIterator()
+		: m_map(nullptr)
+		, m_slotIdx(MAX_U32)
+	{
+	}
+
+	/// Allow conversion from iterator to const iterator.
+	template<typename YValuePointer, typename YValueReference, typename YMapPointer>
+	FlatHashMapIterator(const FlatHashMapIterator<YValuePointer, YValueReference, YMapPointer>& b)
+		: m_map(b.m_map)
+		, m_slotIdx(b.m_slotIdx)
+	{
+	}
+
+	TValueReference operator*() const
+	{
+		check();
+		return m_map->m_slots[m_slotIdx].m_value;
+	}
+
+	TValuePointer operator->() const
+	{
+		check();
+		return &m_map->m_slots[m_slotIdx].m_value;
+	}
+
+	FlatHashMapIterator& operator++()
+	{
+		check();
+		m_slotIdx = m_map->findNextFullSlot(m_slotIdx + 1);
+		return *this;
+	}
+
+	FlatHashMapIterator operator++(int)
+	{
+		FlatHashMapIterator out = *this;
+		++(*this);
+		return out;
+	}
+
+	Bool operator==(const FlatHashMapIterator& b) const
+	{
+		ANKI_ASSERT(m_map == b.m_map);
+		return m_slotIdx == b.m_slotIdx;
+	}
+
+	Bool operator!=(const FlatHashMapIterator& b) const
+	{
+		return !(*this == b);
+	}
+
+	const auto& getKey() const
+	{
+		check();
+		return m_map->m_slots[m_slotIdx].m_key;
+	}
+
+private:
+	TMapPointer m_map;
+	U32 m_slotIdx;
+
+	FlatHashMapIterator(TMapPointer map, U32 slotIdx)
+		: m_map(map)
+		, m_slotIdx(slotIdx)
+	{
+	}
+
+	void check() const
+	{
+		ANKI_ASSERT(m_map && m_slotIdx < m_map->m_capacity);
+		ANKI_ASSERT(m_map->m_ctrl[m_slotIdx] != FlatHashMapGroup::EMPTY);
+	}
+};
+
+/// An open addressing hash map in the style of the "Swiss tables". It keeps the keys and the values in a flat array and
+/// has an array of control bytes (see FlatHashMapGroup) that are searched 16 at a time with SIMD. It's faster than
+/// HashMap and unlike HashMap it compares the keys and not only their hashes. It uses linear probing and erasing shifts
+/// the next elements back so there are no tombstones and lookups never get slower over time.
+/// @note Emplacing and erasing invalidate the iterators.
+template<typename TKey, typename TValue, typename THasher = DefaultHasher<TKey>>
+class FlatHashMap
+{
+	template<typename, typename, typename>
+	friend class FlatHashMapIterator;
+
+public:
+	// Typedefs
+	using Key = TKey;
+	using Value = TValue;
+	using Hasher = THasher;
+	using Iterator = FlatHashMapIterator<TValue*, TValue&, FlatHashMap*>;
+	using ConstIterator = FlatHashMapIterator<const TValue*, const TValue&, const FlatHashMap*>;
+
+	// Consts
+	static constexpr U32 INITIAL_STORAGE_SIZE = 64; ///< The initial number of slots.
+	static constexpr F32 MAX_LOAD_FACTOR = 0.8f;
+
+	/// Default constructor.
+	/// @param initialStorageSize The initial number of slots. Should be a power of two and at least 16.
+	/// @param maxLoadFactor If the map gets more loaded than that then grow it.
+	FlatHashMap(U32 initialStorageSize = INITIAL_STORAGE_SIZE, F32 maxLoadFactor = MAX_LOAD_FACTOR)
+		: m_initialStorageSize(initialStorageSize)
+		, m_maxLoadFactor(maxLoadFactor)
+	{
+		ANKI_ASSERT(isPowerOfTwo(initialStorageSize) && initialStorageSize >= FlatHashMapGroup::SIZE);
+		ANKI_ASSERT(maxLoadFactor > 0.0f && maxLoadFactor < 1.0f);
+	}
+
+	/// Non-copyable.
+	FlatHashMap(const FlatHashMap&) = delete;
+
+	/// Move.
+	FlatHashMap(FlatHashMap&& b)
+	{
+		*this = std::move(b);
+	}
+
+	/// You need to manually destroy the map.
+	/// @see FlatHashMap::destroy
+	~FlatHashMap()
+	{
+		ANKI_ASSERT(m_slots == nullptr && "Forgot to call destroy");
+	}
+
+	/// Non-copyable.
+	FlatHashMap& operator=(const FlatHashMap&) = delete;
+
+	/// Move.
+	FlatHashMap& operator=(FlatHashMap&& b)
+	{
+		ANKI_ASSERT(m_slots == nullptr && "Forgot to call destroy");
+		m_slots = b.m_slots;
+		m_ctrl = b.m_ctrl;
+		m_capacity = b.m_capacity;
+		m_elementCount = b.m_elementCount;
+		m_initialStorageSize = b.m_initialStorageSize;
+		m_maxLoadFactor = b.m_maxLoadFactor;
+
+		b.m_slots = nullptr;
+		b.m_ctrl = nullptr;
+		b.m_capacity = 0;
+		b.m_elementCount = 0;
+		return *this;
+	}
+
+	/// Get begin.
+	Iterator getBegin()
+	{
+		return Iterator(this, findNextFullSlot(0));
+	}
+
+	/// Get begin.
+	ConstIterator getBegin() const
+	{
+		return ConstIterator(this, findNextFullSlot(0));
+	}
+
+	/// Get end.
+	Iterator getEnd()
+	{
+		return Iterator(this, MAX_U32);
+	}
+
+	/// Get end.
+	ConstIterator getEnd() const
+	{
+		return ConstIterator(this, MAX_U32);
+	}
+
+	/// Get begin.
+	Iterator begin()
+	{
+		return getBegin();
+	}
+
+	/// Get begin.
+	ConstIterator begin() const
+	{
+		return getBegin();
+	}
+
+	/// Get end.
+	Iterator end()
+	{
+		return getEnd();
+	}
+
+	/// Get end.
+	ConstIterator end() const
+	{
+		return getEnd();
+	}
+
+	/// Return true if map is empty.
+	Bool isEmpty() const
+	{
+		return m_elementCount == 0;
+	}
+
+	PtrSize getSize() const
+	{
+		return m_elementCount;
+	}
+
+	/// Destroy the map.
+	template<typename TAllocator>
+	void destroy(TAllocator alloc);
+
+	/// Construct an element inside the map. The key shouldn't be in the map.
+	template<typename TAllocator, typename... TArgs>
+	Iterator emplace(TAllocator alloc, const TKey& key, TArgs&&... args);
+
+	/// Erase element.
+	template<typename TAllocator>
+	void erase(TAllocator alloc, Iterator it);
+
+	/// Find a value using a key.
+	Iterator find(const Key& key)
+	{
+		return Iterator(this, findSlot(key));
+	}
+
+	/// Find a value using a key.
+	ConstIterator find(const Key& key) const
+	{
+		return ConstIterator(this, findSlot(key));
+	}
+
+private:
+	class Slot
+	{
+	public:
+		TKey m_key;
+		TValue m_value;
+
+		template<typename... TArgs>
+		Slot(const TKey& key, TArgs&&... args)
+			: m_key(key)
+			, m_value(std::forward<TArgs>(args)...)
+		{
+		}
+
+		Slot(Slot&& b)
+			: m_key(std::move(b.m_key))
+			, m_value(std::move(b.m_value))
+		{
+		}
+	};
+
+	Slot* m_slots = nullptr;
+
+	/// The control bytes. It has m_capacity + FlatHashMapGroup::SIZE - 1 bytes. The last bytes are a copy of the first
+	/// so the groups that start close to the end don't need to wrap around.
+	U8* m_ctrl = nullptr;
+
+	U32 m_capacity = 0;
+	U32 m_elementCount = 0;
+	U32 m_initialStorageSize = 0;
+	F32 m_maxLoadFactor = 0.0f;
+
+	/// Scramble the hash since the hashers of the integers return the integer itself.
+	static U64 computeHash(const TKey& key)
+	{
+		U64 hash = THasher()(key);
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	/// The 7 bits of the hash that go to the control byte.
+	static U8 getHashControl(U64 hash)
+	{
+		return U8(hash & 0x7F);
+	}
+
+	/// The slot where the search starts.
+	U32 getHomeSlot(U64 hash) const
+	{
+		return U32(hash >> 7) & (m_capacity - 1);
+	}
+
+	void setControl(U32 slotIdx, U8 ctrl)
+	{
+		m_ctrl[slotIdx] = ctrl;
+		if(slotIdx < FlatHashMapGroup::SIZE - 1)
+		{
+			m_ctrl[m_capacity + slotIdx] = ctrl;
+		}
+	}
+
+	U32 findSlot(const TKey& key) const;
+
+	U32 findNextFullSlot(U32 slotIdx) const
+	{
+		for(; slotIdx < m_capacity; ++slotIdx)
+		{
+			if(m_ctrl[slotIdx] != FlatHashMapGroup::EMPTY)
+			{
+				return slotIdx;
+			}
+		}
+
+		return MAX_U32;
+	}
+
+	/// Find where a new key should go.
+	U32 findEmptySlot(U64 hash, const TKey& key) const;
+
+	template<typename TAllocator>
+	void grow(TAllocator& alloc);
+};
+/// @}
+
+} // end namespace anki
+
+#include <AnKi/Util/FlatHashMap.inl.h>
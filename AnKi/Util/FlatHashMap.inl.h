@@ -0,0 +1,190 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Util/FlatHashMap.h>
+
+namespace anki {
+
+template<typename TKey, typename TValue, typename THasher>
+template<typename TAllocator>
+void FlatHashMap<TKey, TValue, THasher>::destroy(TAllocator alloc)
+{
+	if(m_slots)
+	{
+		for(U32 i = 0; i < m_capacity; ++i)
+		{
+			if(m_ctrl[i] != FlatHashMapGroup::EMPTY)
+			{
+				m_slots[i].~Slot();
+			}
+		}
+
+		alloc.getMemoryPool().free(m_slots);
+		alloc.getMemoryPool().free(m_ctrl);
+	}
+
+	m_slots = nullptr;
+	m_ctrl = nullptr;
+	m_capacity = 0;
+	m_elementCount = 0;
+}
+
+template<typename TKey, typename TValue, typename THasher>
+U32 FlatHashMap<TKey, TValue, THasher>::findSlot(const TKey& key) const
+{
+	if(ANKI_UNLIKELY(m_elementCount == 0))
+	{
+		return MAX_U32;
+	}
+
+	const U64 hash = computeHash(key);
+	const U8 hashCtrl = getHashControl(hash);
+	const U32 mask = m_capacity - 1;
+	U32 groupStart = getHomeSlot(hash);
+	while(true)
+	{
+		FlatHashMapGroup::Mask matches = FlatHashMapGroup::match(&m_ctrl[groupStart], hashCtrl);
+		while(matches)
+		{
+			const U32 slotIdx = (groupStart + matches.getFirst()) & mask;
+			if(m_slots[slotIdx].m_key == key)
+			{
+				return slotIdx;
+			}
+
+			matches.removeFirst();
+		}
+
+		// The elements are never after an empty slot so stop at the first group that has one
+		if(FlatHashMapGroup::match(&m_ctrl[groupStart], FlatHashMapGroup::EMPTY))
+		{
+			return MAX_U32;
+		}
+
+		groupStart = (groupStart + FlatHashMapGroup::SIZE) & mask;
+	}
+}
+
+template<typename TKey, typename TValue, typename THasher>
+U32 FlatHashMap<TKey, TValue, THasher>::findEmptySlot(U64 hash, const TKey& key) const
+{
+	const U32 mask = m_capacity - 1;
+	U32 groupStart = getHomeSlot(hash);
+	while(true)
+	{
+#if ANKI_EXTRA_CHECKS
+		FlatHashMapGroup::Mask matches = FlatHashMapGroup::match(&m_ctrl[groupStart], getHashControl(hash));
+		while(matches)
+		{
+			ANKI_ASSERT(!(m_slots[(groupStart + matches.getFirst()) & mask].m_key == key) && "Key already in the map");
+			matches.removeFirst();
+		}
+#else
+		(void)key;
+#endif
+
+		const FlatHashMapGroup::Mask empty = FlatHashMapGroup::match(&m_ctrl[groupStart], FlatHashMapGroup::EMPTY);
+		if(empty)
+		{
+			return (groupStart + empty.getFirst()) & mask;
+		}
+
+		groupStart = (groupStart + FlatHashMapGroup::SIZE) & mask;
+	}
+}
+
+template<typename TKey, typename TValue, typename THasher>
+template<typename TAllocator, typename... TArgs>
+typename FlatHashMap<TKey, TValue, THasher>::Iterator
+FlatHashMap<TKey, TValue, THasher>::emplace(TAllocator alloc, const TKey& key, TArgs&&... args)
+{
+	if(m_capacity == 0 || F32(m_elementCount + 1) > F32(m_capacity) * m_maxLoadFactor)
+	{
+		grow(alloc);
+	}
+
+	const U64 hash = computeHash(key);
+	const U32 slotIdx = findEmptySlot(hash, key);
+	::new(&m_slots[slotIdx]) Slot(key, std::forward<TArgs>(args)...);
+	setControl(slotIdx, getHashControl(hash));
+	++m_elementCount;
+
+	return Iterator(this, slotIdx);
+}
+
+template<typename TKey, typename TValue, typename THasher>
+template<typename TAllocator>
+void FlatHashMap<TKey, TValue, THasher>::erase(TAllocator alloc, Iterator it)
+{
+	(void)alloc;
+	it.check();
+	ANKI_ASSERT(it.m_map == this);
+
+	U32 holeIdx = it.m_slotIdx;
+	m_slots[holeIdx].~Slot();
+	--m_elementCount;
+
+	// Move back the elements that come after the hole and can be closer to their home slot. That keeps all elements
+	// reachable from their home slot without empty slots in between
+	const U32 mask = m_capacity - 1;
+	U32 slotIdx = holeIdx;
+	while(true)
+	{
+		slotIdx = (slotIdx + 1) & mask;
+		if(m_ctrl[slotIdx] == FlatHashMapGroup::EMPTY)
+		{
+			break;
+		}
+
+		const U32 homeIdx = getHomeSlot(computeHash(m_slots[slotIdx].m_key));
+		if(((slotIdx - homeIdx) & mask) >= ((slotIdx - holeIdx) & mask))
+		{
+			::new(&m_slots[holeIdx]) Slot(std::move(m_slots[slotIdx]));
+			m_slots[slotIdx].~Slot();
+			setControl(holeIdx, m_ctrl[slotIdx]);
+			holeIdx = slotIdx;
+		}
+	}
+
+	setControl(holeIdx, FlatHashMapGroup::EMPTY);
+}
+
+template<typename TKey, typename TValue, typename THasher>
+template<typename TAllocator>
+void FlatHashMap<TKey, TValue, THasher>::grow(TAllocator& alloc)
+{
+	const U32 newCapacity = (m_capacity) ? m_capacity * 2 : m_initialStorageSize;
+	ANKI_ASSERT(newCapacity > m_capacity);
+
+	Slot* oldSlots = m_slots;
+	U8* oldCtrl = m_ctrl;
+	const U32 oldCapacity = m_capacity;
+
+	m_slots = static_cast<Slot*>(alloc.getMemoryPool().allocate(newCapacity * sizeof(Slot), alignof(Slot)));
+	m_ctrl = static_cast<U8*>(alloc.getMemoryPool().allocate(newCapacity + FlatHashMapGroup::SIZE - 1, 1));
+	memset(m_ctrl, FlatHashMapGroup::EMPTY, newCapacity + FlatHashMapGroup::SIZE - 1);
+	m_capacity = newCapacity;
+
+	// Re-insert the old elements
+	for(U32 i = 0; i < oldCapacity; ++i)
+	{
+		if(oldCtrl[i] != FlatHashMapGroup::EMPTY)
+		{
+			const U64 hash = computeHash(oldSlots[i].m_key);
+			const U32 slotIdx = findEmptySlot(hash, oldSlots[i].m_key);
+			::new(&m_slots[slotIdx]) Slot(std::move(oldSlots[i]));
+			setControl(slotIdx, getHashControl(hash));
+			oldSlots[i].~Slot();
+		}
+	}
+
+	if(oldSlots)
+	{
+		alloc.getMemoryPool().free(oldSlots);
+		alloc.getMemoryPool().free(oldCtrl);
+	}
+}
+
+} // end namespace anki
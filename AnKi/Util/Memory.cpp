@@ -9,9 +9,13 @@
 #include <AnKi/Util/Thread.h>
 #include <AnKi/Util/Atomic.h>
 #include <AnKi/Util/Logger.h>
+#include <AnKi/Util/Allocator.h>
+#include <AnKi/Util/ClassAllocatorBuilder.h>
+#include <AnKi/Util/BitSet.h>
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <cinttypes>
 
 namespace anki {
 
@@ -27,15 +31,6 @@ static PoolSignature computePoolSignature(void* ptr)
 	return sig;
 }
 
-class AllocationHeader
-{
-public:
-	PtrSize m_allocationSize;
-	PoolSignature m_signature;
-};
-
-constexpr U32 MAX_ALIGNMENT = 64;
-constexpr U32 ALLOCATION_HEADER_SIZE = getAlignedRoundUp(MAX_ALIGNMENT, sizeof(AllocationHeader));
 #endif
 
 #define ANKI_CREATION_OOM_ACTION() ANKI_UTIL_LOGF("Out of memory")
@@ -49,6 +44,291 @@ static void invalidateMemory(TPtr ptr, TSize size)
 #endif
 }
 
+/// Precedes the allocations of the HeapMemoryPool that don't go through the small object allocator.
+class LargeAllocationHeader
+{
+public:
+	PtrSize m_allocationSize; ///< The size of the whole memory block.
+
+#if ANKI_MEM_EXTRA_CHECKS
+	PoolSignature m_signature;
+#endif
+
+	/// The offset of the allocation from the start of the memory block with the 1st bit set. It's the last member
+	/// because the small allocations store their chunk at the same place.
+	PtrSize m_tag;
+};
+
+/// The payload sizes of the small object classes. Allocations bigger than the last class go to the allocation callback.
+constexpr Array<U32, 20> SMALL_OBJECT_CLASS_SIZES = {
+	{16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 288, 320, 352, 384, 416, 448, 480, 512}};
+
+constexpr PtrSize MAX_SMALL_OBJECT_SIZE = 512;
+
+/// Every small allocation is preceded by a pointer to its chunk. Keep the payload aligned.
+constexpr PtrSize SMALL_OBJECT_TAG_SIZE = ANKI_SAFE_ALIGNMENT;
+
+/// The max size of the memory of a chunk of small objects.
+constexpr PtrSize SMALL_OBJECT_CHUNK_SIZE = 16_KB;
+
+constexpr U32 MAX_SMALL_OBJECTS_PER_CHUNK = SMALL_OBJECT_CHUNK_SIZE / (16 + SMALL_OBJECT_TAG_SIZE);
+
+/// The number of thread caches of every pool. If there are more threads they share caches.
+constexpr U32 THREAD_CACHE_COUNT = 16;
+
+/// The number of small objects that move between a thread cache and the chunks at once.
+constexpr U32 THREAD_CACHE_BATCH_SIZE = 32;
+
+static U32 computeSmallObjectClass(PtrSize size)
+{
+	ANKI_ASSERT(size > 0 && size <= MAX_SMALL_OBJECT_SIZE);
+	const U32 classIdx = (size <= 128) ? U32(size - 1) / 16 : 8 + U32(size - 129) / 32;
+	ANKI_ASSERT(size <= SMALL_OBJECT_CLASS_SIZES[classIdx]);
+	ANKI_ASSERT(classIdx == 0 || size > SMALL_OBJECT_CLASS_SIZES[classIdx - 1]);
+	return classIdx;
+}
+
+/// The index of the thread cache of the current thread.
+static thread_local U32 g_threadCacheIdx = MAX_U32;
+static Atomic<U32> g_threadCacheCount = {0};
+
+static U32 getThreadCacheIndex()
+{
+	if(ANKI_UNLIKELY(g_threadCacheIdx == MAX_U32))
+	{
+		g_threadCacheIdx = g_threadCacheCount.fetchAdd(1) % THREAD_CACHE_COUNT;
+	}
+
+	return g_threadCacheIdx;
+}
+
+/// A chunk of small objects. The memory of the objects follows the chunk.
+class SmallObjectChunk : public IntrusiveListEnabled<SmallObjectChunk>
+{
+public:
+	/// Required by ClassAllocatorBuilder.
+	BitSet<MAX_SMALL_OBJECTS_PER_CHUNK, U64> m_inUseSuballocations = {false};
+
+	/// Required by ClassAllocatorBuilder.
+	U32 m_suballocationCount = 0;
+
+	/// Required by ClassAllocatorBuilder.
+	void* m_class = nullptr;
+
+	HeapMemoryPool* m_pool = nullptr;
+
+	U32 m_classIdx = MAX_U32;
+
+	/// The start of the memory of the small objects.
+	U8* getMemoryStart()
+	{
+		return reinterpret_cast<U8*>(this) + getAlignedRoundUp(ANKI_SAFE_ALIGNMENT, sizeof(SmallObjectChunk));
+	}
+};
+
+/// The small object allocator of a HeapMemoryPool. The chunks are managed by a ClassAllocatorBuilder and on top of
+/// that there are a few thread caches with free lists of small objects per class. A thread allocates from and frees to
+/// its own cache. The objects that a thread frees are re-used by that thread no matter which thread allocated them and
+/// when a free list grows too much half of it goes back to the chunks.
+class HeapMemoryPool::SmallObjectAllocator
+{
+public:
+	/// Implements the ClassAllocatorBuilder TInterface.
+	class ClassInterface
+	{
+	public:
+		HeapMemoryPool* m_pool = nullptr;
+
+		// The rest of the functions implement the ClassAllocatorBuilder TInterface.
+
+		constexpr U32 getClassCount() const
+		{
+			return SMALL_OBJECT_CLASS_SIZES.getSize();
+		}
+
+		void getClassInfo(U32 classIdx, PtrSize& chunkSize, PtrSize& suballocationSize) const
+		{
+			suballocationSize = SMALL_OBJECT_CLASS_SIZES[classIdx] + SMALL_OBJECT_TAG_SIZE;
+			chunkSize = (SMALL_OBJECT_CHUNK_SIZE / suballocationSize) * suballocationSize;
+		}
+
+		ANKI_USE_RESULT Error allocateChunk(U32 classIdx, SmallObjectChunk*& chunk)
+		{
+			void* mem = m_pool->allocateFromCallback(getFullChunkSize(classIdx), ANKI_SAFE_ALIGNMENT);
+			if(ANKI_UNLIKELY(mem == nullptr))
+			{
+				ANKI_OOM_ACTION();
+				return Error::OUT_OF_MEMORY;
+			}
+
+			chunk = ::new(mem) SmallObjectChunk();
+			chunk->m_pool = m_pool;
+			chunk->m_classIdx = classIdx;
+			return Error::NONE;
+		}
+
+		void freeChunk(SmallObjectChunk* chunk)
+		{
+			ANKI_ASSERT(chunk);
+			const U32 classIdx = chunk->m_classIdx;
+			chunk->~SmallObjectChunk();
+			m_pool->freeToCallback(chunk, getFullChunkSize(classIdx));
+		}
+
+	private:
+		PtrSize getFullChunkSize(U32 classIdx) const
+		{
+			PtrSize chunkSize, suballocationSize;
+			getClassInfo(classIdx, chunkSize, suballocationSize);
+			return getAlignedRoundUp(ANKI_SAFE_ALIGNMENT, sizeof(SmallObjectChunk)) + chunkSize;
+		}
+	};
+
+	class alignas(ANKI_CACHE_LINE_SIZE) ThreadCache
+	{
+	public:
+		/// Almost always uncontended.
+		SpinLock m_lock;
+
+		/// Allocations minus frees of this cache.
+		I32 m_allocationCount = 0;
+
+		U64 m_totalAllocationCount = 0;
+
+		Array<void*, SMALL_OBJECT_CLASS_SIZES.getSize()> m_freeLists = {};
+		Array<U32, SMALL_OBJECT_CLASS_SIZES.getSize()> m_freeListSizes = {};
+	};
+
+	HeapAllocator<U8> m_alloc; ///< For the internal structures of the m_builder.
+	ClassAllocatorBuilder<SmallObjectChunk, ClassInterface, SpinLock> m_builder;
+	Array<ThreadCache, THREAD_CACHE_COUNT> m_threadCaches;
+
+	SmallObjectAllocator(HeapMemoryPool* pool)
+		: m_alloc(pool->getAllocationCallback(), pool->getAllocationCallbackUserData(), nullptr, false)
+	{
+		m_builder.getInterface().m_pool = pool;
+		m_builder.init(m_alloc);
+	}
+
+	~SmallObjectAllocator()
+	{
+		for(ThreadCache& cache : m_threadCaches)
+		{
+			for(U32 classIdx = 0; classIdx < cache.m_freeLists.getSize(); ++classIdx)
+			{
+				releaseObjects(cache, classIdx, cache.m_freeListSizes[classIdx]);
+			}
+		}
+	}
+
+	void* allocate(U32 classIdx)
+	{
+		ThreadCache& cache = m_threadCaches[getThreadCacheIndex()];
+		LockGuard<SpinLock> lock(cache.m_lock);
+
+		if(ANKI_UNLIKELY(cache.m_freeListSizes[classIdx] == 0))
+		{
+			acquireObjects(cache, classIdx);
+			if(ANKI_UNLIKELY(cache.m_freeListSizes[classIdx] == 0))
+			{
+				return nullptr;
+			}
+		}
+
+		void* out = cache.m_freeLists[classIdx];
+		cache.m_freeLists[classIdx] = *static_cast<void**>(out);
+		--cache.m_freeListSizes[classIdx];
+		++cache.m_allocationCount;
+		++cache.m_totalAllocationCount;
+		return out;
+	}
+
+	void free(U32 classIdx, void* ptr)
+	{
+		invalidateMemory(ptr, SMALL_OBJECT_CLASS_SIZES[classIdx]);
+
+		ThreadCache& cache = m_threadCaches[getThreadCacheIndex()];
+		LockGuard<SpinLock> lock(cache.m_lock);
+
+		*static_cast<void**>(ptr) = cache.m_freeLists[classIdx];
+		cache.m_freeLists[classIdx] = ptr;
+		++cache.m_freeListSizes[classIdx];
+		--cache.m_allocationCount;
+
+		if(ANKI_UNLIKELY(cache.m_freeListSizes[classIdx] >= THREAD_CACHE_BATCH_SIZE * 2))
+		{
+			releaseObjects(cache, classIdx, THREAD_CACHE_BATCH_SIZE);
+		}
+	}
+
+	I32 getAllocationCount() const
+	{
+		// No locking, it's just statistics
+		I32 count = 0;
+		for(const ThreadCache& cache : m_threadCaches)
+		{
+			count += cache.m_allocationCount;
+		}
+		return count;
+	}
+
+	U64 getTotalAllocationCount() const
+	{
+		U64 count = 0;
+		for(const ThreadCache& cache : m_threadCaches)
+		{
+			count += cache.m_totalAllocationCount;
+		}
+		return count;
+	}
+
+	static SmallObjectChunk& getChunk(void* ptr)
+	{
+		const PtrSize tag = *reinterpret_cast<const PtrSize*>(static_cast<U8*>(ptr) - sizeof(PtrSize));
+		ANKI_ASSERT((tag & 1) == 0);
+		return *numberToPtr<SmallObjectChunk*>(tag);
+	}
+
+private:
+	/// Move a batch of objects from the chunks to a cache.
+	void acquireObjects(ThreadCache& cache, U32 classIdx)
+	{
+		const PtrSize suballocationSize = SMALL_OBJECT_CLASS_SIZES[classIdx] + SMALL_OBJECT_TAG_SIZE;
+		for(U32 i = 0; i < THREAD_CACHE_BATCH_SIZE; ++i)
+		{
+			SmallObjectChunk* chunk;
+			PtrSize offset;
+			if(m_builder.allocate(suballocationSize, SMALL_OBJECT_TAG_SIZE, chunk, offset))
+			{
+				break;
+			}
+
+			U8* ptr = chunk->getMemoryStart() + offset + SMALL_OBJECT_TAG_SIZE;
+			*reinterpret_cast<PtrSize*>(ptr - sizeof(PtrSize)) = ptrToNumber(chunk);
+
+			*reinterpret_cast<void**>(ptr) = cache.m_freeLists[classIdx];
+			cache.m_freeLists[classIdx] = ptr;
+			++cache.m_freeListSizes[classIdx];
+		}
+	}
+
+	/// Move some objects of a cache back to their chunks.
+	void releaseObjects(ThreadCache& cache, U32 classIdx, U32 count)
+	{
+		ANKI_ASSERT(count <= cache.m_freeListSizes[classIdx]);
+		for(U32 i = 0; i < count; ++i)
+		{
+			U8* ptr = static_cast<U8*>(cache.m_freeLists[classIdx]);
+			cache.m_freeLists[classIdx] = *reinterpret_cast<void**>(ptr);
+
+			SmallObjectChunk& chunk = getChunk(ptr);
+			m_builder.free(&chunk, ptr - SMALL_OBJECT_TAG_SIZE - chunk.getMemoryStart());
+		}
+
+		cache.m_freeListSizes[classIdx] -= count;
+	}
+};
+
 void* mallocAligned(PtrSize size, PtrSize alignmentBytes)
 {
 	ANKI_ASSERT(size > 0);
@@ -141,6 +421,9 @@ void* allocAligned(void* userData, void* ptr, PtrSize size, PtrSize alignment)
 	return out;
 }
 
+BaseMemoryPool* BaseMemoryPool::m_namedPoolsHead = nullptr;
+SpinLock BaseMemoryPool::m_namedPoolsLock;
+
 BaseMemoryPool::BaseMemoryPool(Type type, AllocAlignedCallback allocCb, void* allocCbUserData, const char* name)
 	: m_allocCb(allocCb)
 	, m_allocCbUserData(allocCbUserData)
@@ -153,16 +436,109 @@ BaseMemoryPool::BaseMemoryPool(Type type, AllocAlignedCallback allocCb, void* al
 	{
 		m_name = static_cast<char*>(malloc(len + 1));
 		memcpy(m_name, name, len + 1);
+
+		LockGuard<SpinLock> lock(m_namedPoolsLock);
+		m_nextNamedPool = m_namedPoolsHead;
+		if(m_namedPoolsHead)
+		{
+			m_namedPoolsHead->m_prevNamedPool = this;
+		}
+		m_namedPoolsHead = this;
 	}
 }
 
 BaseMemoryPool::~BaseMemoryPool()
 {
 	ANKI_ASSERT(m_refcount.load() == 0 && "Refcount should be zero");
+
+	// The derived classes should have unlinked it already but do it anyway
+	unlinkNamedPool();
+	::free(m_name);
+}
+
+void BaseMemoryPool::unlinkNamedPool()
+{
+	if(!m_name)
+	{
+		return;
+	}
+
+	LockGuard<SpinLock> lock(m_namedPoolsLock);
+
+	if(!m_prevNamedPool && m_namedPoolsHead != this)
+	{
+		// Already unlinked
+		return;
+	}
+
+	if(m_prevNamedPool)
+	{
+		m_prevNamedPool->m_nextNamedPool = m_nextNamedPool;
+	}
+	else
+	{
+		m_namedPoolsHead = m_nextNamedPool;
+	}
+
+	if(m_nextNamedPool)
+	{
+		m_nextNamedPool->m_prevNamedPool = m_prevNamedPool;
+	}
+
+	m_prevNamedPool = nullptr;
+	m_nextNamedPool = nullptr;
 }
 
-HeapMemoryPool::HeapMemoryPool(AllocAlignedCallback allocCb, void* allocCbUserDataconst, const char* name)
+void* BaseMemoryPool::allocateFromCallback(PtrSize size, PtrSize alignment)
+{
+	void* mem = m_allocCb(m_allocCbUserData, nullptr, size, alignment);
+	if(ANKI_LIKELY(mem))
+	{
+		const PtrSize liveBytes = m_liveBytes.fetchAdd(size, AtomicMemoryOrder::RELAXED) + size;
+		m_peakLiveBytes.max(liveBytes);
+	}
+
+	return mem;
+}
+
+void BaseMemoryPool::freeToCallback(void* ptr, PtrSize size)
+{
+	ANKI_ASSERT(ptr);
+	m_liveBytes.fetchSub(size, AtomicMemoryOrder::RELAXED);
+	m_allocCb(m_allocCbUserData, ptr, 0, 0);
+}
+
+MemoryPoolStats BaseMemoryPool::getStats() const
+{
+	MemoryPoolStats stats;
+	stats.m_liveBytes = m_liveBytes.load(AtomicMemoryOrder::RELAXED);
+	stats.m_peakLiveBytes = m_peakLiveBytes.load(AtomicMemoryOrder::RELAXED);
+	if(m_type == Type::HEAP)
+	{
+		stats.m_totalAllocationCount = static_cast<const HeapMemoryPool*>(this)->getTotalAllocationCount();
+	}
+	else
+	{
+		stats.m_totalAllocationCount = m_totalAllocationCount.load(AtomicMemoryOrder::RELAXED);
+	}
+	stats.m_allocationCount = getAllocationCount();
+	return stats;
+}
+
+MemoryPoolAllocationBudget::~MemoryPoolAllocationBudget()
+{
+	if(!isWithinBudget())
+	{
+		ANKI_UTIL_LOGE("Allocation budget exceeded. Budget %s of pool %s allows %" PRIu64 " allocations, got %" PRIu64,
+					   m_name, m_pool.getName(), m_maxAllocationCount, getAllocationCount());
+		ANKI_ASSERT(!"Allocation budget exceeded");
+	}
+}
+
+HeapMemoryPool::HeapMemoryPool(AllocAlignedCallback allocCb, void* allocCbUserDataconst, const char* name,
+							   Bool smallObjectCaching)
 	: BaseMemoryPool(Type::HEAP, allocCb, allocCbUserDataconst, name)
+	, m_smallObjectCaching(smallObjectCaching)
 {
 #if ANKI_MEM_EXTRA_CHECKS
 	m_signature = computePoolSignature(this);
@@ -171,34 +547,91 @@ HeapMemoryPool::HeapMemoryPool(AllocAlignedCallback allocCb, void* allocCbUserDa
 
 HeapMemoryPool::~HeapMemoryPool()
 {
-	const U32 count = m_allocationCount.load();
+	unlinkNamedPool();
+
+	const U32 count = getAllocationCount();
 	if(count != 0)
 	{
 		ANKI_UTIL_LOGW("Memory pool destroyed before all memory being released (%u deallocations missed): %s", count,
 					   getName());
 	}
+
+	// If some small objects are still in use leak their chunks
+	SmallObjectAllocator* smallObjects = m_smallObjects.load();
+	if(smallObjects && smallObjects->getAllocationCount() == 0)
+	{
+		smallObjects->~SmallObjectAllocator();
+		freeToCallback(smallObjects, sizeof(SmallObjectAllocator));
+	}
+}
+
+HeapMemoryPool::SmallObjectAllocator* HeapMemoryPool::getOrCreateSmallObjectAllocator()
+{
+	SmallObjectAllocator* smallObjects = m_smallObjects.load(AtomicMemoryOrder::ACQUIRE);
+	if(ANKI_LIKELY(smallObjects))
+	{
+		return smallObjects;
+	}
+
+	void* mem = allocateFromCallback(sizeof(SmallObjectAllocator), alignof(SmallObjectAllocator));
+	if(ANKI_UNLIKELY(mem == nullptr))
+	{
+		ANKI_OOM_ACTION();
+		return nullptr;
+	}
+
+	SmallObjectAllocator* newSmallObjects = ::new(mem) SmallObjectAllocator(this);
+	if(m_smallObjects.compareExchange(smallObjects, newSmallObjects))
+	{
+		smallObjects = newSmallObjects;
+	}
+	else
+	{
+		// Some other thread created it first
+		newSmallObjects->~SmallObjectAllocator();
+		freeToCallback(newSmallObjects, sizeof(SmallObjectAllocator));
+	}
+
+	return smallObjects;
 }
 
 void* HeapMemoryPool::allocate(PtrSize size, PtrSize alignment)
 {
-#if ANKI_MEM_EXTRA_CHECKS
-	ANKI_ASSERT(alignment <= MAX_ALIGNMENT && "Wrong assumption");
-	size += ALLOCATION_HEADER_SIZE;
-#endif
+	ANKI_ASSERT(size > 0 && alignment > 0);
 
-	void* mem = m_allocCb(m_allocCbUserData, nullptr, size, alignment);
+	if(m_smallObjectCaching && size <= MAX_SMALL_OBJECT_SIZE && alignment <= SMALL_OBJECT_TAG_SIZE)
+	{
+		SmallObjectAllocator* smallObjects = getOrCreateSmallObjectAllocator();
+		void* mem = (smallObjects) ? smallObjects->allocate(computeSmallObjectClass(size)) : nullptr;
+		if(ANKI_UNLIKELY(mem == nullptr))
+		{
+			ANKI_OOM_ACTION();
+		}
+		else
+		{
+			sampleAllocation(size);
+		}
+
+		return mem;
+	}
+
+	// The header should be right before the returned memory and the returned memory should be aligned
+	const PtrSize headerSize = getAlignedRoundUp(alignment, sizeof(LargeAllocationHeader));
+
+	void* mem = allocateFromCallback(size + headerSize, alignment);
 
 	if(mem != nullptr)
 	{
 		m_allocationCount.fetchAdd(1);
+		m_totalAllocationCount.fetchAdd(1, AtomicMemoryOrder::RELAXED);
+		sampleAllocation(size);
 
+		mem = static_cast<void*>(static_cast<U8*>(mem) + headerSize);
+		LargeAllocationHeader& header = *(static_cast<LargeAllocationHeader*>(mem) - 1);
+		header.m_tag = headerSize | 1;
+		header.m_allocationSize = size + headerSize;
 #if ANKI_MEM_EXTRA_CHECKS
-		memset(mem, 0, ALLOCATION_HEADER_SIZE);
-		AllocationHeader& header = *static_cast<AllocationHeader*>(mem);
 		header.m_signature = m_signature;
-		header.m_allocationSize = size;
-
-		mem = static_cast<void*>(static_cast<U8*>(mem) + ALLOCATION_HEADER_SIZE);
 #endif
 	}
 	else
@@ -216,19 +649,55 @@ void HeapMemoryPool::free(void* ptr)
 		return;
 	}
 
+	const PtrSize tag = *reinterpret_cast<const PtrSize*>(static_cast<U8*>(ptr) - sizeof(PtrSize));
+	if((tag & 1) == 0)
+	{
+		// Small allocation
+		SmallObjectChunk& chunk = SmallObjectAllocator::getChunk(ptr);
+		ANKI_ASSERT(chunk.m_pool == this && "Freeing from the wrong pool");
+		m_smallObjects.load()->free(chunk.m_classIdx, ptr);
+		return;
+	}
+
+	const PtrSize headerSize = tag & ~PtrSize(1);
+	const LargeAllocationHeader& header = *(static_cast<LargeAllocationHeader*>(ptr) - 1);
+	const PtrSize allocationSize = header.m_allocationSize;
+
 #if ANKI_MEM_EXTRA_CHECKS
-	U8* memU8 = static_cast<U8*>(ptr) - ALLOCATION_HEADER_SIZE;
-	AllocationHeader& header = *reinterpret_cast<AllocationHeader*>(memU8);
 	if(header.m_signature != m_signature)
 	{
 		ANKI_UTIL_LOGE("Signature missmatch on free");
 	}
 
-	ptr = static_cast<void*>(memU8);
-	invalidateMemory(ptr, header.m_allocationSize);
+	invalidateMemory(ptr, allocationSize - headerSize);
 #endif
+
 	m_allocationCount.fetchSub(1);
-	m_allocCb(m_allocCbUserData, ptr, 0, 0);
+	freeToCallback(static_cast<U8*>(ptr) - headerSize, allocationSize);
+}
+
+U32 HeapMemoryPool::getAllocationCount() const
+{
+	I64 count = m_allocationCount.load();
+	const SmallObjectAllocator* smallObjects = m_smallObjects.load();
+	if(smallObjects)
+	{
+		count += smallObjects->getAllocationCount();
+	}
+
+	return U32(count);
+}
+
+U64 HeapMemoryPool::getTotalAllocationCount() const
+{
+	U64 count = m_totalAllocationCount.load(AtomicMemoryOrder::RELAXED);
+	const SmallObjectAllocator* smallObjects = m_smallObjects.load();
+	if(smallObjects)
+	{
+		count += smallObjects->getTotalAllocationCount();
+	}
+
+	return count;
 }
 
 Error StackMemoryPool::StackAllocatorBuilderInterface::allocateChunk(PtrSize size, Chunk*& out)
@@ -237,7 +706,7 @@ Error StackMemoryPool::StackAllocatorBuilderInterface::allocateChunk(PtrSize siz
 
 	const PtrSize fullChunkSize = offsetof(Chunk, m_memoryStart) + size;
 
-	void* mem = m_parent->m_allocCb(m_parent->m_allocCbUserData, nullptr, fullChunkSize, MAX_ALIGNMENT);
+	void* mem = m_parent->allocateFromCallback(fullChunkSize, MAX_ALIGNMENT);
 
 	if(ANKI_LIKELY(mem))
 	{
@@ -256,7 +725,7 @@ Error StackMemoryPool::StackAllocatorBuilderInterface::allocateChunk(PtrSize siz
 void StackMemoryPool::StackAllocatorBuilderInterface::freeChunk(Chunk* chunk)
 {
 	ANKI_ASSERT(chunk);
-	m_parent->m_allocCb(m_parent->m_allocCbUserData, chunk, 0, 0);
+	m_parent->freeToCallback(chunk, offsetof(Chunk, m_memoryStart) + chunk->m_chunkSize);
 }
 
 void StackMemoryPool::StackAllocatorBuilderInterface::recycleChunk(Chunk& chunk)
@@ -284,6 +753,7 @@ StackMemoryPool::StackMemoryPool(AllocAlignedCallback allocCb, void* allocCbUser
 
 StackMemoryPool::~StackMemoryPool()
 {
+	unlinkNamedPool();
 }
 
 void* StackMemoryPool::allocate(PtrSize size, PtrSize alignment)
@@ -295,7 +765,9 @@ void* StackMemoryPool::allocate(PtrSize size, PtrSize alignment)
 		return nullptr;
 	}
 
-	m_allocationCount.fetchAdd(1);
+	// The builder updates the m_allocationCount
+	m_totalAllocationCount.fetchAdd(1, AtomicMemoryOrder::RELAXED);
+	sampleAllocation(size);
 	const PtrSize address = ptrToNumber(&chunk->m_memoryStart[0]) + offset;
 	return numberToPtr<void*>(address);
 }
@@ -307,16 +779,12 @@ void StackMemoryPool::free(void* ptr)
 		return;
 	}
 
-	const U32 count = m_allocationCount.fetchSub(1);
-	ANKI_ASSERT(count > 0);
-	(void)count;
 	m_builder.free();
 }
 
 void StackMemoryPool::reset()
 {
 	m_builder.reset();
-	m_allocationCount.store(0);
 }
 
 ChainMemoryPool::ChainMemoryPool(AllocAlignedCallback allocCb, void* allocCbUserData, PtrSize initialChunkSize,
@@ -346,6 +814,8 @@ ChainMemoryPool::ChainMemoryPool(AllocAlignedCallback allocCb, void* allocCbUser
 
 ChainMemoryPool::~ChainMemoryPool()
 {
+	unlinkNamedPool();
+
 	if(m_allocationCount.load() != 0)
 	{
 		ANKI_UTIL_LOGW("Memory pool destroyed before all memory being released");
@@ -391,6 +861,8 @@ void* ChainMemoryPool::allocate(PtrSize size, PtrSize alignment)
 	}
 
 	m_allocationCount.fetchAdd(1);
+	m_totalAllocationCount.fetchAdd(1, AtomicMemoryOrder::RELAXED);
+	sampleAllocation(size);
 
 	return mem;
 }
@@ -485,7 +957,7 @@ ChainMemoryPool::Chunk* ChainMemoryPool::createNewChunk(PtrSize size)
 	PtrSize memAllocSize = getAlignedRoundUp(m_alignmentBytes, size);
 	PtrSize allocationSize = chunkAllocSize + memAllocSize;
 
-	Chunk* chunk = reinterpret_cast<Chunk*>(m_allocCb(m_allocCbUserData, nullptr, allocationSize, m_alignmentBytes));
+	Chunk* chunk = reinterpret_cast<Chunk*>(allocateFromCallback(allocationSize, m_alignmentBytes));
 
 	if(chunk)
 	{
@@ -575,8 +1047,9 @@ void ChainMemoryPool::destroyChunk(Chunk* ch)
 		ch->m_next->m_prev = ch->m_prev;
 	}
 
-	invalidateMemory(ch, getAlignedRoundUp(m_alignmentBytes, sizeof(Chunk)) + ch->m_memsize);
-	m_allocCb(m_allocCbUserData, ch, 0, 0);
+	const PtrSize allocationSize = getAlignedRoundUp(m_alignmentBytes, sizeof(Chunk)) + ch->m_memsize;
+	invalidateMemory(ch, allocationSize);
+	freeToCallback(ch, allocationSize);
 }
 
 } // end namespace anki
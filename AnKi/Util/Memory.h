@@ -45,6 +45,28 @@ using PoolSignature = U32;
 ///         returns nullptr
 void* allocAligned(void* userData, void* ptr, PtrSize size, PtrSize alignment);
 
+/// The statistics of a memory pool. See BaseMemoryPool::getStats().
+class MemoryPoolStats
+{
+public:
+	/// The memory that the pool got from the allocation callback and hasn't given back yet.
+	PtrSize m_liveBytes = 0;
+
+	/// The max value m_liveBytes ever had.
+	PtrSize m_peakLiveBytes = 0;
+
+	/// The number of allocations since the creation of the pool.
+	U64 m_totalAllocationCount = 0;
+
+	/// The number of allocations that haven't been freed.
+	U32 m_allocationCount = 0;
+};
+
+class BaseMemoryPool;
+
+/// Gets called every few allocations of a memory pool. See BaseMemoryPool::setAllocationSampling().
+using MemoryPoolSampleCallback = void (*)(void* userData, const BaseMemoryPool& pool, PtrSize size);
+
 /// Generic memory pool. The base of HeapMemoryPool or StackMemoryPool or ChainMemoryPool.
 class BaseMemoryPool
 {
@@ -90,10 +112,7 @@ public:
 	}
 
 	/// Return number of allocations
-	U32 getAllocationCount() const
-	{
-		return m_allocationCount.load();
-	}
+	U32 getAllocationCount() const;
 
 	/// Get the name of the pool.
 	const char* getName() const
@@ -101,6 +120,35 @@ public:
 		return (m_name) ? m_name : "Unamed";
 	}
 
+	/// Get the statistics of the pool.
+	/// @note It's thread-safe but the values of the different members might be a bit out of sync.
+	MemoryPoolStats getStats() const;
+
+	/// Call a callback every few allocations. It's a cheap way to find who allocates the most.
+	/// @param period Call the callback every that many allocations. Zero disables the sampling.
+	/// @param callback The callback. It may be called by many threads at the same time.
+	/// @param callbackUserData The user data to pass to the callback.
+	/// @note It's not thread-safe. Set it before the pool is used.
+	void setAllocationSampling(U32 period, MemoryPoolSampleCallback callback, void* callbackUserData)
+	{
+		ANKI_ASSERT(period == 0 || callback);
+		m_samplePeriod = period;
+		m_sampleCallback = callback;
+		m_sampleCallbackUserData = callbackUserData;
+	}
+
+	/// Visit all the pools that have a name. Use it to gather the statistics of the different subsystems.
+	/// @note It's thread-safe. Don't create or destroy named pools inside the callback.
+	template<typename TFunc>
+	static void visitNamedPools(TFunc func)
+	{
+		LockGuard<SpinLock> lock(m_namedPoolsLock);
+		for(BaseMemoryPool* pool = m_namedPoolsHead; pool; pool = pool->m_nextNamedPool)
+		{
+			func(*pool);
+		}
+	}
+
 protected:
 	/// Pool type.
 	enum class Type : U8
@@ -120,9 +168,36 @@ protected:
 	/// Allocations count.
 	Atomic<U32> m_allocationCount = {0};
 
+	/// Allocations since the creation of the pool.
+	Atomic<U64> m_totalAllocationCount = {0};
+
 	/// Construct it.
 	BaseMemoryPool(Type type, AllocAlignedCallback allocCb, void* allocCbUserData, const char* name);
 
+	/// Allocate from the allocation callback and keep track of the memory.
+	void* allocateFromCallback(PtrSize size, PtrSize alignment);
+
+	/// Remove the pool from the list of named pools. The derived classes call it first thing in their destructor so
+	/// visitNamedPools() can't reach a pool that is half destroyed.
+	void unlinkNamedPool();
+
+	/// Free memory that came from allocateFromCallback().
+	/// @param ptr The memory to free.
+	/// @param size The size given to allocateFromCallback().
+	void freeToCallback(void* ptr, PtrSize size);
+
+	/// Call it on every allocation.
+	void sampleAllocation(PtrSize size)
+	{
+		if(ANKI_UNLIKELY(m_samplePeriod))
+		{
+			if((m_sampleCounter.fetchAdd(1) % m_samplePeriod) == 0)
+			{
+				m_sampleCallback(m_sampleCallbackUserData, *this, size);
+			}
+		}
+	}
+
 private:
 	/// Refcount.
 	Atomic<U32> m_refcount = {0};
@@ -132,10 +207,65 @@ private:
 
 	/// Type.
 	Type m_type = Type::NONE;
+
+	Atomic<PtrSize> m_liveBytes = {0};
+	Atomic<PtrSize> m_peakLiveBytes = {0};
+
+	U32 m_samplePeriod = 0;
+	Atomic<U32> m_sampleCounter = {0};
+	MemoryPoolSampleCallback m_sampleCallback = nullptr;
+	void* m_sampleCallbackUserData = nullptr;
+
+	/// @name The named pools are in a list
+	/// @{
+	BaseMemoryPool* m_prevNamedPool = nullptr;
+	BaseMemoryPool* m_nextNamedPool = nullptr;
+	static BaseMemoryPool* m_namedPoolsHead;
+	static SpinLock m_namedPoolsLock;
+	/// @}
+};
+
+/// Checks that the allocations of a memory pool during its lifetime stay inside a budget. Use it to make sure that
+/// some hot path doesn't allocate or that it allocates a known number of times. The allocations of other threads
+/// count as well.
+class MemoryPoolAllocationBudget
+{
+public:
+	/// @param pool The pool to watch.
+	/// @param maxAllocationCount The max number of allocations allowed.
+	/// @param name A name for the error message.
+	MemoryPoolAllocationBudget(const BaseMemoryPool& pool, U64 maxAllocationCount, const char* name)
+		: m_pool(pool)
+		, m_name(name)
+		, m_maxAllocationCount(maxAllocationCount)
+		, m_startAllocationCount(pool.getStats().m_totalAllocationCount)
+	{
+	}
+
+	/// Logs an error and asserts if the budget was exceeded.
+	~MemoryPoolAllocationBudget();
+
+	/// Get the number of allocations since the budget was created.
+	U64 getAllocationCount() const
+	{
+		return m_pool.getStats().m_totalAllocationCount - m_startAllocationCount;
+	}
+
+	Bool isWithinBudget() const
+	{
+		return getAllocationCount() <= m_maxAllocationCount;
+	}
+
+private:
+	const BaseMemoryPool& m_pool;
+	const char* m_name;
+	U64 m_maxAllocationCount;
+	U64 m_startAllocationCount;
 };
 
-/// A dummy interface to match the StackMemoryPool and ChainMemoryPool interfaces in order to be used by the same
-/// allocator template.
+/// A memory pool that allocates from the heap. Small allocations are served from size classes that are carved from
+/// bigger chunks. The freed small allocations are cached in a few thread caches and they are re-used without going
+/// through the allocation callback or touching atomics that are shared between threads.
 class HeapMemoryPool final : public BaseMemoryPool
 {
 public:
@@ -143,7 +273,9 @@ public:
 	/// @param allocCb The allocation function callback.
 	/// @param allocCbUserData The user data to pass to the allocation function.
 	/// @param name An optional name.
-	HeapMemoryPool(AllocAlignedCallback allocCb, void* allocCbUserDataconst, const char* name = nullptr);
+	/// @param smallObjectCaching If false all allocations will go to the allocation callback.
+	HeapMemoryPool(AllocAlignedCallback allocCb, void* allocCbUserDataconst, const char* name = nullptr,
+				   Bool smallObjectCaching = true);
 
 	/// Destroy
 	~HeapMemoryPool();
@@ -160,10 +292,25 @@ public:
 	/// @param[in, out] ptr Memory block to deallocate.
 	void free(void* ptr);
 
+	/// Return number of allocations. It sums the counters of the thread caches so it's not that cheap.
+	U32 getAllocationCount() const;
+
+	/// Return the number of allocations since the creation of the pool. It sums the counters of the thread caches.
+	U64 getTotalAllocationCount() const;
+
 private:
+	class SmallObjectAllocator;
+
+	/// It's created on the first small allocation.
+	Atomic<SmallObjectAllocator*> m_smallObjects = {nullptr};
+
+	Bool m_smallObjectCaching = true;
+
 #if ANKI_MEM_EXTRA_CHECKS
 	PoolSignature m_signature = 0;
 #endif
+
+	SmallObjectAllocator* getOrCreateSmallObjectAllocator();
 };
 
 /// Thread safe memory pool. It's a preallocated memory pool that is used for memory allocations on top of that
@@ -412,6 +559,16 @@ inline void* BaseMemoryPool::allocate(PtrSize size, PtrSize alignmentBytes)
 	return out;
 }
 
+inline U32 BaseMemoryPool::getAllocationCount() const
+{
+	if(m_type == Type::HEAP)
+	{
+		return static_cast<const HeapMemoryPool*>(this)->getAllocationCount();
+	}
+
+	return m_allocationCount.load();
+}
+
 inline void BaseMemoryPool::free(void* ptr)
 {
 	switch(m_type)
@@ -0,0 +1,101 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Util/RadixSort.h>
+
+namespace anki {
+
+void radixSort(WeakArray<RadixSortPair> pairs, WeakArray<RadixSortPair> tmpPairs, U32 digitCount)
+{
+	ANKI_ASSERT(pairs.getSize() == tmpPairs.getSize());
+	ANKI_ASSERT(digitCount > 0 && digitCount <= 8);
+
+	const U32 count = pairs.getSize();
+	if(count < 2)
+	{
+		return;
+	}
+
+	// Compute the histograms of all digits in one go
+	Array2d<U32, 8, RADIX_SORT_BUCKET_COUNT> histograms;
+	memset(&histograms[0][0], 0, sizeof(histograms));
+	for(const RadixSortPair& pair : pairs)
+	{
+		U64 key = pair.m_key;
+		for(U32 digit = 0; digit < digitCount; ++digit)
+		{
+			++histograms[digit][key & 0xFFu];
+			key >>= 8u;
+		}
+	}
+
+	RadixSortPair* src = &pairs[0];
+	RadixSortPair* dst = &tmpPairs[0];
+	for(U32 digit = 0; digit < digitCount; ++digit)
+	{
+		Array<U32, RADIX_SORT_BUCKET_COUNT>& histogram = histograms[digit];
+
+		// Skip the digit if all keys fall in the same bucket
+		const U32 firstBucket = U32((src[0].m_key >> (digit * 8u)) & 0xFFu);
+		if(histogram[firstBucket] == count)
+		{
+			continue;
+		}
+
+		// Prefix sum
+		U32 offset = 0;
+		for(U32& bucket : histogram)
+		{
+			const U32 bucketCount = bucket;
+			bucket = offset;
+			offset += bucketCount;
+		}
+
+		// Scatter
+		const U32 shift = digit * 8u;
+		for(U32 i = 0; i < count; ++i)
+		{
+			const U32 bucket = U32((src[i].m_key >> shift) & 0xFFu);
+			dst[histogram[bucket]++] = src[i];
+		}
+
+		std::swap(src, dst);
+	}
+
+	if(src != &pairs[0])
+	{
+		memcpy(&pairs[0], src, pairs.getSizeInBytes());
+	}
+}
+
+void radixSortPartition(ConstWeakArray<RadixSortPair> in, WeakArray<RadixSortPair> out,
+						Array<U32, RADIX_SORT_BUCKET_COUNT + 1>& bucketOffsets)
+{
+	ANKI_ASSERT(in.getSize() == out.getSize());
+
+	Array<U32, RADIX_SORT_BUCKET_COUNT> histogram;
+	memset(&histogram[0], 0, sizeof(histogram));
+	for(const RadixSortPair& pair : in)
+	{
+		++histogram[pair.m_key >> 56u];
+	}
+
+	U32 offset = 0;
+	for(U32 bucket = 0; bucket < RADIX_SORT_BUCKET_COUNT; ++bucket)
+	{
+		bucketOffsets[bucket] = offset;
+		const U32 bucketCount = histogram[bucket];
+		histogram[bucket] = offset;
+		offset += bucketCount;
+	}
+	bucketOffsets[RADIX_SORT_BUCKET_COUNT] = offset;
+
+	for(const RadixSortPair& pair : in)
+	{
+		out[histogram[pair.m_key >> 56u]++] = pair;
+	}
+}
+
+} // end namespace anki
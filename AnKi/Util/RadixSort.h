@@ -0,0 +1,43 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/Array.h>
+
+namespace anki {
+
+/// @addtogroup util_other
+/// @{
+
+/// A 64bit sort key and a payload (usually an index to the array that will be sorted).
+class RadixSortPair
+{
+public:
+	U64 m_key;
+	U32 m_value;
+};
+
+/// The number of buckets of a radix sort digit.
+constexpr U32 RADIX_SORT_BUCKET_COUNT = 256;
+
+/// Sort pairs on their keys using a least significant digit radix sort with 8bit digits. The sort is stable. Digits
+/// that are the same for all keys are skipped so keys with few significant bits cost less.
+/// @param[in,out] pairs The pairs to sort.
+/// @param[in,out] tmpPairs Scratch memory. Same size as pairs.
+/// @param digitCount Sort on the digitCount least significant bytes of the keys.
+void radixSort(WeakArray<RadixSortPair> pairs, WeakArray<RadixSortPair> tmpPairs, U32 digitCount = 8);
+
+/// Partition the pairs on the most significant byte of their keys. After that every bucket can be sorted independently
+/// (possibly in parallel) with radixSort() and a digitCount of 7.
+/// @param[in] in The pairs to partition.
+/// @param[out] out The partitioned pairs. Same size as in.
+/// @param[out] bucketOffsets The start of each bucket in the out array. The last element is the number of pairs.
+void radixSortPartition(ConstWeakArray<RadixSortPair> in, WeakArray<RadixSortPair> out,
+						Array<U32, RADIX_SORT_BUCKET_COUNT + 1>& bucketOffsets);
+/// @}
+
+} // end namespace anki
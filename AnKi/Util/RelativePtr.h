@@ -0,0 +1,256 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/WeakArray.h>
+
+namespace anki {
+
+/// @addtogroup util_containers
+/// @{
+
+/// A pointer that stores the distance from itself to the object it points to. It stays valid when the object and the
+/// pointer move together (a memory-mapped file for example). Copying it recomputes the distance so it behaves like a
+/// regular pointer.
+template<typename T>
+class RelativePtr
+{
+public:
+	RelativePtr() = default;
+
+	RelativePtr(T* ptr)
+	{
+		set(ptr);
+	}
+
+	RelativePtr(const RelativePtr& b)
+	{
+		set(b.get());
+	}
+
+	RelativePtr& operator=(const RelativePtr& b)
+	{
+		set(b.get());
+		return *this;
+	}
+
+	RelativePtr& operator=(T* ptr)
+	{
+		set(ptr);
+		return *this;
+	}
+
+	T* get() const
+	{
+		return (m_offset) ? numberToPtr<T*>(ptrToNumber(this) + m_offset) : nullptr;
+	}
+
+	operator T*() const
+	{
+		return get();
+	}
+
+	T* operator->() const
+	{
+		ANKI_ASSERT(m_offset);
+		return get();
+	}
+
+	T& operator*() const
+	{
+		ANKI_ASSERT(m_offset);
+		return *get();
+	}
+
+private:
+	I64 m_offset = 0; ///< Zero is null since nothing points to the pointer itself.
+
+	void set(T* ptr)
+	{
+		m_offset = (ptr) ? I64(ptrToNumber(ptr) - ptrToNumber(this)) : 0;
+	}
+};
+
+/// A WeakArray that uses a RelativePtr. See RelativePtr.
+template<typename T, typename TSize = U32>
+class RelativeWeakArray
+{
+public:
+	using Value = T;
+	using Iterator = Value*;
+	using ConstIterator = const Value*;
+	using Reference = Value&;
+	using ConstReference = const Value&;
+	using Size = TSize;
+
+	RelativeWeakArray() = default;
+
+	RelativeWeakArray(T* mem, Size size)
+	{
+		setArray(mem, size);
+	}
+
+	RelativeWeakArray(WeakArray<T, TSize> b)
+	{
+		setArray(b.getBegin(), b.getSize());
+	}
+
+	template<PtrSize TSIZE>
+	RelativeWeakArray(Array<T, TSIZE>& arr)
+	{
+		setArray(&arr[0], arr.getSize());
+	}
+
+	RelativeWeakArray(const RelativeWeakArray& b)
+	{
+		setArray(b.getData(), b.m_size);
+	}
+
+	RelativeWeakArray& operator=(const RelativeWeakArray& b)
+	{
+		setArray(b.getData(), b.m_size);
+		return *this;
+	}
+
+	RelativeWeakArray& operator=(WeakArray<T, TSize> b)
+	{
+		setArray(b.getBegin(), b.getSize());
+		return *this;
+	}
+
+	template<PtrSize TSIZE>
+	RelativeWeakArray& operator=(Array<T, TSIZE>& arr)
+	{
+		setArray(&arr[0], arr.getSize());
+		return *this;
+	}
+
+	operator WeakArray<T, TSize>()
+	{
+		return WeakArray<T, TSize>(getData(), m_size);
+	}
+
+	operator ConstWeakArray<T, TSize>() const
+	{
+		return ConstWeakArray<T, TSize>(getData(), m_size);
+	}
+
+	Reference operator[](const Size n)
+	{
+		ANKI_ASSERT(n < m_size);
+		return getData()[n];
+	}
+
+	ConstReference operator[](const Size n) const
+	{
+		ANKI_ASSERT(n < m_size);
+		return getData()[n];
+	}
+
+	Iterator getBegin()
+	{
+		return getData();
+	}
+
+	ConstIterator getBegin() const
+	{
+		return getData();
+	}
+
+	Iterator getEnd()
+	{
+		return getData() + m_size;
+	}
+
+	ConstIterator getEnd() const
+	{
+		return getData() + m_size;
+	}
+
+	/// Make it compatible with the C++11 range based for loop.
+	Iterator begin()
+	{
+		return getBegin();
+	}
+
+	/// Make it compatible with the C++11 range based for loop.
+	ConstIterator begin() const
+	{
+		return getBegin();
+	}
+
+	/// Make it compatible with the C++11 range based for loop.
+	Iterator end()
+	{
+		return getEnd();
+	}
+
+	/// Make it compatible with the C++11 range based for loop.
+	ConstIterator end() const
+	{
+		return getEnd();
+	}
+
+	Reference getFront()
+	{
+		ANKI_ASSERT(!isEmpty());
+		return getData()[0];
+	}
+
+	ConstReference getFront() const
+	{
+		ANKI_ASSERT(!isEmpty());
+		return getData()[0];
+	}
+
+	Reference getBack()
+	{
+		ANKI_ASSERT(!isEmpty());
+		return getData()[m_size - 1];
+	}
+
+	ConstReference getBack() const
+	{
+		ANKI_ASSERT(!isEmpty());
+		return getData()[m_size - 1];
+	}
+
+	/// Set the array pointer and its size.
+	void setArray(Value* array, Size size)
+	{
+		ANKI_ASSERT(array || size == 0);
+		// Empty arrays are always null so there are no dangling offsets in the files
+		m_offset = (size) ? I64(ptrToNumber(array) - ptrToNumber(this)) : 0;
+		m_size = size;
+	}
+
+	Size getSize() const
+	{
+		return m_size;
+	}
+
+	Bool isEmpty() const
+	{
+		return m_size == 0;
+	}
+
+	PtrSize getSizeInBytes() const
+	{
+		return m_size * sizeof(Value);
+	}
+
+private:
+	I64 m_offset = 0;
+	Size m_size = 0;
+
+	Value* getData() const
+	{
+		return (m_offset) ? numberToPtr<Value*>(ptrToNumber(this) + m_offset) : nullptr;
+	}
+};
+/// @}
+
+} // end namespace anki
@@ -7,7 +7,8 @@
 
 namespace anki {
 
-Error BinarySerializer::doDynamicArrayBasicType(const void* arr, PtrSize size, U32 alignment, PtrSize memberOffset)
+Error BinarySerializer::doDynamicArrayBasicType(const void* arr, PtrSize size, U32 alignment, PtrSize memberOffset,
+												Bool relative)
 {
 	check();
 
@@ -29,6 +30,8 @@ Error BinarySerializer::doDynamicArrayBasicType(const void* arr, PtrSize size, U
 		PointerInfo pinfo;
 		pinfo.m_filePos = structFilePos + memberOffset;
 		pinfo.m_value = arrayFilePos - m_beginOfDataFilePos;
+		pinfo.m_targetSize = size;
+		pinfo.m_relative = relative;
 		m_pointerFilePositions.emplaceBack(m_alloc, pinfo);
 
 		// Write the array
@@ -40,4 +43,52 @@ Error BinarySerializer::doDynamicArrayBasicType(const void* arr, PtrSize size, U
 	return Error::NONE;
 }
 
+Error BinaryDeserializer::checkHeader(const detail::BinarySerializerHeader& header, PtrSize rootStructSize,
+									  PtrSize sizeAfterHeader)
+{
+	if(memcmp(&header.m_magic[0], detail::BINARY_SERIALIZER_MAGIC, 8) != 0)
+	{
+		ANKI_UTIL_LOGE("Wrong magic work in header");
+		return Error::USER_DATA;
+	}
+
+	if(header.m_dataSize < rootStructSize)
+	{
+		ANKI_UTIL_LOGE("Wrong data size");
+		return Error::USER_DATA;
+	}
+
+	const PtrSize expectedSizeAfterHeader = header.m_dataSize + header.m_pointerCount * sizeof(void*)
+											+ header.m_relativePointerCount
+												  * sizeof(detail::BinarySerializerRelativePointer);
+	if(expectedSizeAfterHeader > sizeAfterHeader)
+	{
+		ANKI_UTIL_LOGE("File size doesn't match expectations");
+		return Error::USER_DATA;
+	}
+
+	return Error::NONE;
+}
+
+Error BinaryDeserializer::validateRelativePointer(const U8* data, PtrSize dataSize, PtrSize pointerOffset,
+												  PtrSize targetSize)
+{
+	if(pointerOffset + sizeof(I64) > dataSize || !isAligned(alignof(I64), pointerOffset))
+	{
+		ANKI_UTIL_LOGE("Corrupt relative pointer");
+		return Error::USER_DATA;
+	}
+
+	I64 value;
+	memcpy(&value, data + pointerOffset, sizeof(value));
+	const I64 targetOffset = I64(pointerOffset) + value;
+	if(value == 0 || targetOffset < 0 || PtrSize(targetOffset) + targetSize > dataSize)
+	{
+		ANKI_UTIL_LOGE("Corrupt relative pointer");
+		return Error::USER_DATA;
+	}
+
+	return Error::NONE;
+}
+
 } // end namespace anki
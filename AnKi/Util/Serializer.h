@@ -5,11 +5,17 @@
 
 #include <AnKi/Util/File.h>
 #include <AnKi/Util/WeakArray.h>
+#include <AnKi/Util/RelativePtr.h>
 
 #pragma once
 
 namespace anki {
 
+// Forward
+namespace detail {
+class BinarySerializerHeader;
+} // end namespace detail
+
 /// @addtogroup util_file
 /// @{
 
@@ -72,7 +78,35 @@ public:
 	}
 };
 
-/// Serializes to binary files.
+/// Specialization for RelativeWeakArray.
+template<typename T, typename TSize>
+class SerializeFunctor<RelativeWeakArray<T, TSize>>
+{
+public:
+	template<typename TSerializer>
+	void operator()(const RelativeWeakArray<T, TSize>& x, TSerializer& serializer)
+	{
+		const TSize size = x.getSize();
+		serializer.doRelativeDynamicArray("m_array", 0, (x.getSize()) ? &x[0] : nullptr, size);
+		serializer.doValue("m_size", sizeof(I64), size);
+	}
+};
+
+/// Specialization for RelativeWeakArray.
+template<typename T, typename TSize>
+class DeserializeFunctor<RelativeWeakArray<T, TSize>>
+{
+public:
+	template<typename TDeserializer>
+	void operator()(RelativeWeakArray<T, TSize>& x, TDeserializer& deserializer)
+	{
+		// Nothing to do, the relative pointers don't need patching
+	}
+};
+
+/// Serializes to binary files. The pointers (WeakArray for example) are patched when the file is read. The relative
+/// pointers (RelativePtr and RelativeWeakArray) are stored as they are so a file that has only relative pointers can
+/// be used in place without reading it. See BinaryDeserializer::deserializeInPlace.
 class BinarySerializer
 {
 public:
@@ -134,7 +168,7 @@ public:
 	{
 		if(!m_err)
 		{
-			m_err = doDynamicArrayComplexType(arr, size, memberOffset);
+			m_err = doDynamicArrayComplexType(arr, size, memberOffset, false);
 		}
 	}
 
@@ -144,7 +178,34 @@ public:
 	{
 		if(!m_err)
 		{
-			m_err = doDynamicArrayBasicType(arr, size * sizeof(T), alignof(T), memberOffset);
+			m_err = doDynamicArrayBasicType(arr, size * sizeof(T), alignof(T), memberOffset, false);
+		}
+	}
+
+	/// Write a RelativePtr. Can't call this directly.
+	template<typename T>
+	void doRelativePointer(CString varName, PtrSize memberOffset, const T* ptr)
+	{
+		doRelativeDynamicArray(varName, memberOffset, ptr, (ptr) ? 1 : 0);
+	}
+
+	/// Write a dynamic array of complex types that is pointed by a RelativePtr. Can't call this directly.
+	template<typename T, ANKI_ENABLE(!_ANKI_SIMPLE_TYPE)>
+	void doRelativeDynamicArray(CString varName, PtrSize memberOffset, const T* arr, PtrSize size)
+	{
+		if(!m_err)
+		{
+			m_err = doDynamicArrayComplexType(arr, size, memberOffset, true);
+		}
+	}
+
+	/// Write a dynamic array of int and float values that is pointed by a RelativePtr. Can't call this directly.
+	template<typename T, ANKI_ENABLE(_ANKI_SIMPLE_TYPE)>
+	void doRelativeDynamicArray(CString varName, PtrSize memberOffset, const T* arr, PtrSize size)
+	{
+		if(!m_err)
+		{
+			m_err = doDynamicArrayBasicType(arr, size * sizeof(T), alignof(T), memberOffset, true);
 		}
 	}
 
@@ -154,6 +215,8 @@ private:
 	public:
 		PtrSize m_filePos; ///< Pointer location inside the file.
 		PtrSize m_value; ///< Where it points to. It's an offset after the header.
+		PtrSize m_targetSize; ///< The size of what it points to.
+		Bool m_relative;
 	};
 
 	File* m_file = nullptr;
@@ -168,9 +231,10 @@ private:
 	ANKI_USE_RESULT Error doArrayComplexType(const T* arr, PtrSize size, PtrSize memberOffset);
 
 	template<typename T>
-	ANKI_USE_RESULT Error doDynamicArrayComplexType(const T* arr, PtrSize size, PtrSize memberOffset);
+	ANKI_USE_RESULT Error doDynamicArrayComplexType(const T* arr, PtrSize size, PtrSize memberOffset, Bool relative);
 
-	ANKI_USE_RESULT Error doDynamicArrayBasicType(const void* arr, PtrSize size, U32 alignment, PtrSize memberOffset);
+	ANKI_USE_RESULT Error doDynamicArrayBasicType(const void* arr, PtrSize size, U32 alignment, PtrSize memberOffset,
+												  Bool relative);
 
 	template<typename T>
 	ANKI_USE_RESULT Error serializeInternal(const T& x, GenericMemoryPoolAllocator<U8> tmpAllocator, File& file);
@@ -189,6 +253,104 @@ private:
 	}
 };
 
+namespace detail {
+
+/// Walks a struct that is used in place (see BinaryDeserializer::deserializeInPlace) the same way the BinarySerializer
+/// does and checks that every relative pointer and relative array points inside the data.
+class BinaryInPlaceValidator
+{
+public:
+	Error m_err = Error::NONE;
+
+	BinaryInPlaceValidator(const U8* data, PtrSize dataSize)
+		: m_data(data)
+		, m_dataSize(dataSize)
+	{
+	}
+
+	template<typename T>
+	void doValue(CString varName, PtrSize memberOffset, const T& x)
+	{
+		doArray(varName, memberOffset, &x, 1);
+	}
+
+	template<typename T, ANKI_ENABLE(!_ANKI_SIMPLE_TYPE)>
+	void doArray(CString varName, PtrSize memberOffset, const T* arr, PtrSize size)
+	{
+		if(m_depth >= MAX_DEPTH)
+		{
+			// Only a corrupt file has a cycle
+			ANKI_UTIL_LOGE("Structures are nested too deep");
+			m_err = Error::USER_DATA;
+		}
+
+		++m_depth;
+		for(PtrSize i = 0; i < size && !m_err; ++i)
+		{
+			SerializeFunctor<T>()(arr[i], *this);
+		}
+		--m_depth;
+	}
+
+	template<typename T, ANKI_ENABLE(_ANKI_SIMPLE_TYPE)>
+	void doArray(CString varName, PtrSize memberOffset, const T* arr, PtrSize size)
+	{
+		// Nothing to validate
+	}
+
+	template<typename T>
+	void doPointer(CString varName, PtrSize memberOffset, const T* ptr)
+	{
+		doDynamicArray(varName, memberOffset, ptr, (ptr) ? 1 : 0);
+	}
+
+	template<typename T>
+	void doDynamicArray(CString varName, PtrSize memberOffset, const T* arr, PtrSize size)
+	{
+		if(size > 0 && !m_err)
+		{
+			ANKI_UTIL_LOGE("Found a pointer that needs patching: %s", varName.cstr());
+			m_err = Error::USER_DATA;
+		}
+	}
+
+	template<typename T>
+	void doRelativePointer(CString varName, PtrSize memberOffset, const T* ptr)
+	{
+		doRelativeDynamicArray(varName, memberOffset, ptr, (ptr) ? 1 : 0);
+	}
+
+	template<typename T>
+	void doRelativeDynamicArray(CString varName, PtrSize memberOffset, const T* arr, PtrSize size)
+	{
+		if(size == 0 || m_err)
+		{
+			return;
+		}
+
+		// Compare the addresses as numbers and divide instead of multiplying the size to avoid overflows
+		const PtrSize offset = ptrToNumber(arr) - ptrToNumber(m_data);
+		if(ptrToNumber(arr) < ptrToNumber(m_data) || offset >= m_dataSize || !isAligned(alignof(T), offset)
+		   || size > (m_dataSize - offset) / sizeof(T))
+		{
+			ANKI_UTIL_LOGE("Corrupt relative pointer: %s", varName.cstr());
+			m_err = Error::USER_DATA;
+			return;
+		}
+
+		doArray(varName, memberOffset, arr, size);
+	}
+
+private:
+	static constexpr U32 MAX_DEPTH = 128;
+
+	const U8* m_data;
+	PtrSize m_dataSize;
+	U32 m_depth = 0;
+};
+
+} // end namespace detail
+
 /// Deserializes binary files.
 class BinaryDeserializer
 {
@@ -206,6 +368,14 @@ public:
 	template<typename T>
 	static ANKI_USE_RESULT Error deserialize(T*& x, GenericMemoryPoolAllocator<U8> allocator, File& file);
 
+	/// Use the contents of a file without copying them. It works only if the file has nothing but relative pointers.
+	/// It walks the struct and checks that every relative pointer and array points inside the data.
+	/// @param[out] x The struct. It points inside the data.
+	/// @param data The whole file (a memory-mapped file for example). It should be aligned to ANKI_SAFE_ALIGNMENT and
+	///             it should be alive while x is used.
+	template<typename T>
+	static ANKI_USE_RESULT Error deserializeInPlace(const T*& x, ConstWeakArray<U8, PtrSize> data);
+
 	/// Read a single value. Can't call this directly.
 	template<typename T>
 	void doValue(CString varName, PtrSize memberOffset, T& x)
@@ -233,6 +403,31 @@ public:
 	{
 		// Do nothing
 	}
+
+	/// Read a RelativePtr. Can't call this directly.
+	template<typename T>
+	void doRelativePointer(CString varName, PtrSize memberOffset, T* ptr)
+	{
+		// Do nothing
+	}
+
+	/// Read a dynamic array that is pointed by a RelativePtr. Can't call this directly.
+	template<typename T>
+	void doRelativeDynamicArray(CString varName, PtrSize memberOffset, T* arr, PtrSize size)
+	{
+		// Do nothing
+	}
+
+private:
+	/// Check the header of a file.
+	/// @param rootStructSize The size of the struct that is serialized.
+	/// @param sizeAfterHeader The size of the file minus the header.
+	static ANKI_USE_RESULT Error checkHeader(const detail::BinarySerializerHeader& header, PtrSize rootStructSize,
+											 PtrSize sizeAfterHeader);
+
+	/// Check that a relative pointer points inside the data.
+	static ANKI_USE_RESULT Error validateRelativePointer(const U8* data, PtrSize dataSize, PtrSize pointerOffset,
+														 PtrSize targetSize);
 };
 /// @}
 
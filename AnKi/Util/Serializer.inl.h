@@ -16,9 +16,20 @@ public:
 	PtrSize m_dataSize;
 	PtrSize m_pointerArrayFilePosition; ///< Points to an array of file positions that contain pointers.
 	PtrSize m_pointerCount; ///< The size of the above.
+
+	/// Points to an array of BinarySerializerRelativePointer. They are used only for validation.
+	PtrSize m_relativePointerArrayFilePosition;
+	PtrSize m_relativePointerCount; ///< The size of the above.
+};
+
+class BinarySerializerRelativePointer
+{
+public:
+	PtrSize m_pointerOffset; ///< The location of the relative pointer. It's an offset after the header.
+	PtrSize m_targetSize; ///< The size of what the pointer points to.
 };
 
-static constexpr const char* BINARY_SERIALIZER_MAGIC = "ANKIBIN1";
+static constexpr const char* BINARY_SERIALIZER_MAGIC = "ANKIBIN2";
 
 } // end namespace detail
 
@@ -56,23 +67,49 @@ Error BinarySerializer::serializeInternal(const T& x, GenericMemoryPoolAllocator
 
 	// Write all pointers. Do that now and not while writing the actual shader in order to avoid the file seeks
 	DynamicArrayAuto<PtrSize> pointerFilePositions(m_alloc);
+	DynamicArrayAuto<detail::BinarySerializerRelativePointer> relativePointers(m_alloc);
 	for(const PointerInfo& pointer : m_pointerFilePositions)
 	{
-		ANKI_CHECK(m_file->seek(pointer.m_filePos, FileSeekOrigin::BEGINNING));
-		ANKI_CHECK(m_file->write(&pointer.m_value, sizeof(pointer.m_value)));
-
 		const PtrSize offsetAfterHeader = pointer.m_filePos - m_beginOfDataFilePos;
 		ANKI_ASSERT(offsetAfterHeader + sizeof(void*) <= m_eofPos - m_beginOfDataFilePos);
-		pointerFilePositions.emplaceBack(offsetAfterHeader);
+
+		ANKI_CHECK(m_file->seek(pointer.m_filePos, FileSeekOrigin::BEGINNING));
+		if(pointer.m_relative)
+		{
+			// The distance from the pointer to the target
+			const I64 value = I64(pointer.m_value) - I64(offsetAfterHeader);
+			ANKI_CHECK(m_file->write(&value, sizeof(value)));
+
+			detail::BinarySerializerRelativePointer& relativePointer = *relativePointers.emplaceBack();
+			relativePointer.m_pointerOffset = offsetAfterHeader;
+			relativePointer.m_targetSize = pointer.m_targetSize;
+		}
+		else
+		{
+			ANKI_CHECK(m_file->write(&pointer.m_value, sizeof(pointer.m_value)));
+			pointerFilePositions.emplaceBack(offsetAfterHeader);
+		}
 	}
 
 	// Write the pointer offsets
+	PtrSize tablesFilePos = m_eofPos;
 	if(pointerFilePositions.getSize() > 0)
 	{
-		ANKI_CHECK(m_file->seek(m_eofPos, FileSeekOrigin::BEGINNING));
+		ANKI_CHECK(m_file->seek(tablesFilePos, FileSeekOrigin::BEGINNING));
 		ANKI_CHECK(m_file->write(&pointerFilePositions[0], pointerFilePositions.getSizeInBytes()));
 		header.m_pointerCount = pointerFilePositions.getSize();
-		header.m_pointerArrayFilePosition = m_eofPos;
+		header.m_pointerArrayFilePosition = tablesFilePos;
+		tablesFilePos += pointerFilePositions.getSizeInBytes();
+	}
+
+	// Write the relative pointers. Align them since they are accessed in place
+	if(relativePointers.getSize() > 0)
+	{
+		tablesFilePos = getAlignedRoundUp(alignof(detail::BinarySerializerRelativePointer), tablesFilePos);
+		ANKI_CHECK(m_file->seek(tablesFilePos, FileSeekOrigin::BEGINNING));
+		ANKI_CHECK(m_file->write(&relativePointers[0], relativePointers.getSizeInBytes()));
+		header.m_relativePointerCount = relativePointers.getSize();
+		header.m_relativePointerArrayFilePosition = tablesFilePos;
 	}
 
 	// Write the header
@@ -115,7 +152,7 @@ Error BinarySerializer::doArrayComplexType(const T* arr, PtrSize size, PtrSize m
 }
 
 template<typename T>
-Error BinarySerializer::doDynamicArrayComplexType(const T* arr, PtrSize size, PtrSize memberOffset)
+Error BinarySerializer::doDynamicArrayComplexType(const T* arr, PtrSize size, PtrSize memberOffset, Bool relative)
 {
 	check();
 	checkStruct<T>();
@@ -138,6 +175,8 @@ Error BinarySerializer::doDynamicArrayComplexType(const T* arr, PtrSize size, Pt
 		PointerInfo pinfo;
 		pinfo.m_filePos = structFilePos + memberOffset;
 		pinfo.m_value = arrayFilePos - m_beginOfDataFilePos;
+		pinfo.m_targetSize = size * sizeof(T);
+		pinfo.m_relative = relative;
 		m_pointerFilePositions.emplaceBack(m_alloc, pinfo);
 
 		// Write the structures
@@ -171,27 +210,7 @@ Error BinaryDeserializer::deserialize(T*& x, GenericMemoryPoolAllocator<U8> allo
 	const PtrSize dataFilePos = file.tell();
 
 	// Sanity checks
-	{
-		if(memcmp(&header.m_magic[0], detail::BINARY_SERIALIZER_MAGIC, 8) != 0)
-		{
-			ANKI_UTIL_LOGE("Wrong magic work in header");
-			return Error::USER_DATA;
-		}
-
-		if(header.m_dataSize < sizeof(T))
-		{
-			ANKI_UTIL_LOGE("Wrong data size");
-			return Error::USER_DATA;
-		}
-
-		const PtrSize expectedSizeAfterHeader = header.m_dataSize + header.m_pointerCount * sizeof(void*);
-		const PtrSize actualSizeAfterHeader = file.getSize() - dataFilePos;
-		if(expectedSizeAfterHeader > actualSizeAfterHeader)
-		{
-			ANKI_UTIL_LOGE("File size doesn't match expectations");
-			return Error::USER_DATA;
-		}
-	}
+	ANKI_CHECK(checkHeader(header, sizeof(T), file.getSize() - dataFilePos));
 
 	// Allocate & read data
 	U8* const baseAddress =
@@ -226,9 +245,82 @@ Error BinaryDeserializer::deserialize(T*& x, GenericMemoryPoolAllocator<U8> allo
 		}
 	}
 
+	// Validate the relative pointers
+	if(header.m_relativePointerCount)
+	{
+		ANKI_CHECK(file.seek(header.m_relativePointerArrayFilePosition, FileSeekOrigin::BEGINNING));
+		for(PtrSize i = 0; i < header.m_relativePointerCount; ++i)
+		{
+			detail::BinarySerializerRelativePointer relativePointer;
+			ANKI_CHECK(file.read(&relativePointer, sizeof(relativePointer)));
+			const Error err = validateRelativePointer(baseAddress, header.m_dataSize, relativePointer.m_pointerOffset,
+													  relativePointer.m_targetSize);
+			if(err)
+			{
+				allocator.getMemoryPool().free(baseAddress);
+				return err;
+			}
+		}
+	}
+
 	// Done
 	x = reinterpret_cast<T*>(baseAddress);
 	return Error::NONE;
 }
 
+template<typename T>
+Error BinaryDeserializer::deserializeInPlace(const T*& x, ConstWeakArray<U8, PtrSize> data)
+{
+	x = nullptr;
+
+	detail::BinarySerializerHeader header;
+	if(data.getSize() < sizeof(header))
+	{
+		ANKI_UTIL_LOGE("File too small");
+		return Error::USER_DATA;
+	}
+
+	ANKI_ASSERT(isAligned(ANKI_SAFE_ALIGNMENT, ptrToNumber(&data[0])));
+	memcpy(&header, &data[0], sizeof(header));
+	ANKI_CHECK(checkHeader(header, sizeof(T), data.getSize() - sizeof(header)));
+
+	if(header.m_pointerCount)
+	{
+		ANKI_UTIL_LOGE("The file has pointers that need patching. It can't be used in place");
+		return Error::USER_DATA;
+	}
+
+	// Validate the relative pointers
+	const U8* baseAddress = &data[sizeof(header)];
+	if(header.m_relativePointerCount)
+	{
+		const PtrSize tableFilePos = header.m_relativePointerArrayFilePosition;
+		const PtrSize tableSize = header.m_relativePointerCount * sizeof(detail::BinarySerializerRelativePointer);
+		if(tableFilePos < sizeof(header) + header.m_dataSize || tableFilePos + tableSize > data.getSize()
+		   || !isAligned(alignof(detail::BinarySerializerRelativePointer), tableFilePos))
+		{
+			ANKI_UTIL_LOGE("Corrupt relative pointer table");
+			return Error::USER_DATA;
+		}
+
+		const detail::BinarySerializerRelativePointer* relativePointers =
+			reinterpret_cast<const detail::BinarySerializerRelativePointer*>(&data[tableFilePos]);
+		for(PtrSize i = 0; i < header.m_relativePointerCount; ++i)
+		{
+			ANKI_CHECK(validateRelativePointer(baseAddress, header.m_dataSize, relativePointers[i].m_pointerOffset,
+											   relativePointers[i].m_targetSize));
+		}
+	}
+
+	// The table doesn't know about the sizes of the arrays so walk the structures and check every relative pointer
+	const T& root = *reinterpret_cast<const T*>(baseAddress);
+	detail::BinaryInPlaceValidator validator(baseAddress, header.m_dataSize);
+	validator.doValue("root", 0, root);
+	ANKI_CHECK(validator.m_err);
+
+	// Done
+	x = &root;
+	return Error::NONE;
+}
+
 } // end namespace anki
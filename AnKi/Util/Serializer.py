@@ -12,13 +12,14 @@ import copy
 
 
 class Context:
-    __slots__ = ["input_filenames", "output_filename", "output_file", "identation_level"]
+    __slots__ = ["input_filenames", "output_filename", "output_file", "identation_level", "relative_pointers"]
 
     def __init__(self):
         self.input_filenames = None
         self.output_filename = None
         self.output_file = None
         self.identation_level = 0
+        self.relative_pointers = False
 
 
 ctx = Context()
@@ -109,6 +110,10 @@ def gen_class(root_el):
         member.name = member_el.get("name")
         member.base_type = member_el.get("type")
 
+        # With relative pointers the files can be used without patching pointers (see BinarySerializer)
+        if ctx.relative_pointers and member.base_type.startswith("WeakArray<"):
+            member.base_type = "Relative" + member.base_type
+
         member.array_size = member_el.get("array_size")
         if not member.array_size:
             member.array_size = "1"
@@ -138,7 +143,9 @@ def gen_class(root_el):
         else:
             constructor = ""
 
-        if member.pointer:
+        if member.pointer and ctx.relative_pointers:
+            writeln("RelativePtr<%s> %s%s;" % (member.base_type, member.name, constructor))
+        elif member.pointer:
             writeln("%s* %s%s;" % (member.base_type, member.name, constructor))
         elif member.array_size != "1":
             writeln("Array<%s, %s> %s%s;" % (member.base_type, member.array_size, member.name, constructor))
@@ -162,8 +169,14 @@ def gen_class(root_el):
     ident(1)
 
     for member in member_arr:
-        if member.is_pointer(member_arr_copy):
+        if member.is_pointer(member_arr_copy) and ctx.relative_pointers:
+            writeln("s.doRelativePointer(\"%s\", offsetof(%s, %s), self.%s.get());" %
+                    (member.name, name, member.name, member.name))
+        elif member.is_pointer(member_arr_copy):
             writeln("s.doPointer(\"%s\", offsetof(%s, %s), self.%s);" % (member.name, name, member.name, member.name))
+        elif member.is_dynamic_array(member_arr_copy) and ctx.relative_pointers:
+            writeln("s.doRelativeDynamicArray(\"%s\", offsetof(%s, %s), self.%s.get(), self.%s);" %
+                    (member.name, name, member.name, member.name, member.array_size))
         elif member.is_dynamic_array(member_arr_copy):
             writeln("s.doDynamicArray(\"%s\", offsetof(%s, %s), self.%s, self.%s);" %
                     (member.name, name, member.name, member.name, member.array_size))
@@ -209,6 +222,9 @@ def gen_file(filename):
     tree = et.parse(filename)
     root = tree.getroot()
 
+    # Use RelativePtr and RelativeWeakArray instead of pointers and WeakArray
+    ctx.relative_pointers = root.get("relative_pointers") == "true"
+
     for incs in root.iter("includes"):
         for inc in incs.iter("include"):
             writeln("#include %s" % inc.get("file"))
@@ -0,0 +1,191 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/FlatHashMap.h>
+#include <AnKi/Util/Thread.h>
+
+namespace anki {
+
+/// @addtogroup util_containers
+/// @{
+
+/// A hash map for caches that many threads read and write at the same time. The keys are spread to a few FlatHashMaps
+/// (the shards) and each shard has its own lock so the threads that touch different shards don't wait for each other.
+/// The values are returned by copy since a reference might get invalidated by another thread.
+/// @tparam SHARD_COUNT The number of shards. Should be a power of two.
+template<typename TKey, typename TValue, typename THasher = DefaultHasher<TKey>, U32 SHARD_COUNT = 16>
+class ShardedHashMap
+{
+	static_assert(SHARD_COUNT > 0 && (SHARD_COUNT & (SHARD_COUNT - 1)) == 0, "Should be power of two");
+
+public:
+	ShardedHashMap()
+	{
+	}
+
+	ShardedHashMap(const ShardedHashMap&) = delete; // Non-copyable
+
+	/// You need to manually destroy the map.
+	/// @see ShardedHashMap::destroy
+	~ShardedHashMap()
+	{
+	}
+
+	ShardedHashMap& operator=(const ShardedHashMap&) = delete; // Non-copyable
+
+	/// Destroy the map.
+	/// @note It's not thread-safe.
+	template<typename TAllocator>
+	void destroy(TAllocator alloc)
+	{
+		for(Shard& shard : m_shards)
+		{
+			shard.m_map.destroy(alloc);
+		}
+	}
+
+	/// Find a value.
+	/// @param key The key to search for.
+	/// @param[out] value The value if the key was found.
+	/// @return True if the key was found.
+	Bool find(const TKey& key, TValue& value) const
+	{
+		const Shard& shard = getShard(key);
+		RLockGuard<RWMutex> lock(shard.m_mtx);
+		auto it = shard.m_map.find(key);
+		if(it != shard.m_map.getEnd())
+		{
+			value = *it;
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Construct an element if the key is not in the map.
+	/// @return True if the element was constructed and false if the key was already in the map.
+	template<typename TAllocator, typename... TArgs>
+	Bool emplace(TAllocator alloc, const TKey& key, TArgs&&... args)
+	{
+		Shard& shard = getShard(key);
+		WLockGuard<RWMutex> lock(shard.m_mtx);
+		if(shard.m_map.find(key) != shard.m_map.getEnd())
+		{
+			return false;
+		}
+
+		shard.m_map.emplace(alloc, key, std::forward<TArgs>(args)...);
+		return true;
+	}
+
+	/// Get the value of a key or create it if the key is not in the map. Only one thread will call the createFunc for a
+	/// key. The others will wait for it to finish.
+	/// @param alloc The allocator of the map.
+	/// @param key The key.
+	/// @param createFunc A functor with signature TValue() that gets called with the shard locked.
+	template<typename TAllocator, typename TCreateFunc>
+	TValue getOrCreate(TAllocator alloc, const TKey& key, TCreateFunc createFunc)
+	{
+		Shard& shard = getShard(key);
+
+		// Fast path, it's there
+		{
+			RLockGuard<RWMutex> lock(shard.m_mtx);
+			auto it = shard.m_map.find(key);
+			if(it != shard.m_map.getEnd())
+			{
+				return *it;
+			}
+		}
+
+		// Slow path. Check again since some other thread might have created it in the meantime
+		WLockGuard<RWMutex> lock(shard.m_mtx);
+		auto it = shard.m_map.find(key);
+		if(it == shard.m_map.getEnd())
+		{
+			it = shard.m_map.emplace(alloc, key, createFunc());
+		}
+
+		return *it;
+	}
+
+	/// Erase an element.
+	/// @return True if the key was found and erased.
+	template<typename TAllocator>
+	Bool erase(TAllocator alloc, const TKey& key)
+	{
+		Shard& shard = getShard(key);
+		WLockGuard<RWMutex> lock(shard.m_mtx);
+		auto it = shard.m_map.find(key);
+		if(it != shard.m_map.getEnd())
+		{
+			shard.m_map.erase(alloc, it);
+			return true;
+		}
+
+		return false;
+	}
+
+	/// Iterate all the elements. It locks one shard at a time.
+	/// @param func A functor with signature void(const TKey&, const TValue&). Don't touch the map inside the functor.
+	template<typename TFunc>
+	void iterate(TFunc func) const
+	{
+		for(const Shard& shard : m_shards)
+		{
+			RLockGuard<RWMutex> lock(shard.m_mtx);
+			for(auto it = shard.m_map.getBegin(); it != shard.m_map.getEnd(); ++it)
+			{
+				func(it.getKey(), *it);
+			}
+		}
+	}
+
+	/// Get the number of elements. Other threads might change it at any time.
+	PtrSize getSize() const
+	{
+		PtrSize size = 0;
+		for(const Shard& shard : m_shards)
+		{
+			RLockGuard<RWMutex> lock(shard.m_mtx);
+			size += shard.m_map.getSize();
+		}
+
+		return size;
+	}
+
+private:
+	/// Aligned to the cache line so that the threads that lock different shards don't fight for the same line.
+	class alignas(ANKI_CACHE_LINE_SIZE) Shard
+	{
+	public:
+		mutable RWMutex m_mtx;
+		FlatHashMap<TKey, TValue, THasher> m_map;
+	};
+
+	Array<Shard, SHARD_COUNT> m_shards;
+
+	/// Use the top bits of a scrambled hash. FlatHashMap uses different bits so the keys of a shard are still spread.
+	static U32 getShardIndex(const TKey& key)
+	{
+		const U64 hash = THasher()(key) * 0x9E3779B97F4A7C15ull;
+		return U32(hash >> 32) & (SHARD_COUNT - 1);
+	}
+
+	Shard& getShard(const TKey& key)
+	{
+		return m_shards[getShardIndex(key)];
+	}
+
+	const Shard& getShard(const TKey& key) const
+	{
+		return m_shards[getShardIndex(key)];
+	}
+};
+/// @}
+
+} // end namespace anki
@@ -0,0 +1,170 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <AnKi/Util/StringTable.h>
+#include <AnKi/Util/Logger.h>
+#include <cstring>
+
+namespace anki {
+
+StringTable::StringTable(AllocAlignedCallback allocCb, void* allocCbUserData)
+	: m_pool(allocCb, allocCbUserData, 64_KB, 2.0, 0, true, ANKI_SAFE_ALIGNMENT, "StringTable")
+{
+	for(Entry**& chunk : m_chunks)
+	{
+		chunk = nullptr;
+	}
+
+	m_index.setNonAtomically(newIndex(INITIAL_INDEX_CAPACITY));
+}
+
+StringTable::~StringTable()
+{
+	// Everything is in the pool
+}
+
+StringTable& StringTable::getSingleton()
+{
+	// Create it on first use so the globals of other translation units can use it. The initialization of the local
+	// statics is thread-safe
+	static StringTable table(allocAligned, nullptr);
+	return table;
+}
+
+StringTable::Index* StringTable::newIndex(U32 capacity)
+{
+	ANKI_ASSERT(isPowerOfTwo(capacity));
+	Index* index = static_cast<Index*>(m_pool.allocate(sizeof(Index), alignof(Index)));
+	index->m_slots = static_cast<Atomic<U64>*>(m_pool.allocate(sizeof(Atomic<U64>) * capacity, alignof(Atomic<U64>)));
+	index->m_capacity = capacity;
+
+	for(U32 i = 0; i < capacity; ++i)
+	{
+		::new(&index->m_slots[i]) Atomic<U64>(0);
+	}
+
+	return index;
+}
+
+void StringTable::insertToIndex(Index& index, U32 id, U64 hash)
+{
+	const U32 mask = index.m_capacity - 1;
+	U32 slotIdx = U32(hash) & mask;
+	while(index.m_slots[slotIdx].load(AtomicMemoryOrder::RELAXED) != 0)
+	{
+		slotIdx = (slotIdx + 1) & mask;
+	}
+
+	// Release so the readers that see the slot also see the entry
+	index.m_slots[slotIdx].store((U64(U32(hash >> 32)) << 32) | id, AtomicMemoryOrder::RELEASE);
+}
+
+U32 StringTable::findInIndex(const Index& index, CString str, U32 length, U64 hash) const
+{
+	const U32 mask = index.m_capacity - 1;
+	const U32 hashHigh = U32(hash >> 32);
+	U32 slotIdx = U32(hash) & mask;
+	while(true)
+	{
+		const U64 slot = index.m_slots[slotIdx].load(AtomicMemoryOrder::ACQUIRE);
+		if(slot == 0)
+		{
+			return 0;
+		}
+
+		if(U32(slot >> 32) == hashHigh)
+		{
+			const U32 id = U32(slot);
+			const Entry& entry = getEntry(id);
+			if(entry.m_length == length && memcmp(&entry.m_str[0], str.cstr(), length) == 0)
+			{
+				return id;
+			}
+		}
+
+		slotIdx = (slotIdx + 1) & mask;
+	}
+}
+
+U32 StringTable::tryFind(CString str) const
+{
+	if(str.isEmpty())
+	{
+		return 0;
+	}
+
+	const U32 length = str.getLength();
+	const U64 hash = computeHash(str.cstr(), length);
+	return findInIndex(*m_index.load(AtomicMemoryOrder::ACQUIRE), str, length, hash);
+}
+
+U32 StringTable::intern(CString str)
+{
+	if(str.isEmpty())
+	{
+		return 0;
+	}
+
+	const U32 length = str.getLength();
+	const U64 hash = computeHash(str.cstr(), length);
+
+	// Fast path, it's already there
+	U32 id = findInIndex(*m_index.load(AtomicMemoryOrder::ACQUIRE), str, length, hash);
+	if(id)
+	{
+		return id;
+	}
+
+	// Slow path. Search again since some other thread might have added it in the meantime
+	LockGuard<Mutex> lock(m_mtx);
+
+	Index* index = m_index.load(AtomicMemoryOrder::RELAXED);
+	id = findInIndex(*index, str, length, hash);
+	if(id)
+	{
+		return id;
+	}
+
+	// Create the entry
+	const U32 entryIdx = m_entryCount.load(AtomicMemoryOrder::RELAXED);
+	const U32 chunkIdx = entryIdx >> ENTRIES_PER_CHUNK_LOG2;
+	if(ANKI_UNLIKELY(chunkIdx >= MAX_CHUNK_COUNT))
+	{
+		ANKI_UTIL_LOGF("Reached the max number of interned strings");
+	}
+
+	if(m_chunks[chunkIdx] == nullptr)
+	{
+		m_chunks[chunkIdx] = static_cast<Entry**>(m_pool.allocate(sizeof(Entry*) * ENTRIES_PER_CHUNK, alignof(Entry*)));
+	}
+
+	Entry* entry = static_cast<Entry*>(m_pool.allocate(sizeof(Entry) + length, alignof(Entry)));
+	entry->m_hash = hash;
+	entry->m_length = length;
+	memcpy(&entry->m_str[0], str.cstr(), length + 1);
+
+	m_chunks[chunkIdx][entryIdx & (ENTRIES_PER_CHUNK - 1)] = entry;
+	id = entryIdx + 1;
+
+	// Keep the load factor of the index under 0.5. The new index is visible to the readers only after it's filled
+	if(id * 2 > index->m_capacity)
+	{
+		Index* newIdx = newIndex(index->m_capacity * 2);
+		for(U32 oldId = 1; oldId < id; ++oldId)
+		{
+			insertToIndex(*newIdx, oldId, getEntry(oldId).m_hash);
+		}
+
+		m_index.store(newIdx, AtomicMemoryOrder::RELEASE);
+		index = newIdx;
+	}
+
+	m_entryCount.store(id, AtomicMemoryOrder::RELEASE);
+	insertToIndex(*index, id, hash);
+
+	return id;
+}
+
+} // end namespace anki
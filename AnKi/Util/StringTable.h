@@ -0,0 +1,194 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#pragma once
+
+#include <AnKi/Util/String.h>
+#include <AnKi/Util/Memory.h>
+#include <AnKi/Util/Thread.h>
+#include <AnKi/Util/Array.h>
+
+namespace anki {
+
+/// @addtogroup util_containers
+/// @{
+
+/// A table of interned strings. Every string that goes in gets a 32-bit ID and it's stored once together with its hash.
+/// The strings are never removed. Finding a string or the string of an ID doesn't lock and only the insertion of new
+/// strings locks. See StringId.
+class StringTable
+{
+public:
+	StringTable(AllocAlignedCallback allocCb, void* allocCbUserData);
+
+	StringTable(const StringTable&) = delete; // Non-copyable
+
+	~StringTable();
+
+	StringTable& operator=(const StringTable&) = delete; // Non-copyable
+
+	/// Get the table that StringId uses.
+	static StringTable& getSingleton();
+
+	/// Intern a string and get its ID. Empty strings get zero.
+	/// @note It's thread-safe.
+	U32 intern(CString str);
+
+	/// Get the ID of a string that is already interned.
+	/// @return The ID or zero if the string is not interned.
+	/// @note It's thread-safe and it doesn't lock.
+	U32 tryFind(CString str) const;
+
+	/// Get the string of an ID. Zero gives a null CString.
+	/// @note It's thread-safe and it doesn't lock.
+	CString getString(U32 id) const
+	{
+		return (id) ? CString(&getEntry(id).m_str[0]) : CString();
+	}
+
+	/// Get the hash of the string of an ID. It's the same as CString::computeHash().
+	/// @note It's thread-safe and it doesn't lock.
+	U64 getHash(U32 id) const
+	{
+		return (id) ? getEntry(id).m_hash : 0;
+	}
+
+	/// Get the number of strings in the table.
+	U32 getSize() const
+	{
+		return m_entryCount.load();
+	}
+
+private:
+	static constexpr U32 ENTRIES_PER_CHUNK_LOG2 = 12;
+	static constexpr U32 ENTRIES_PER_CHUNK = 1u << ENTRIES_PER_CHUNK_LOG2;
+	static constexpr U32 MAX_CHUNK_COUNT = 1024;
+	static constexpr U32 INITIAL_INDEX_CAPACITY = 1024;
+
+	/// The string is stored right after the entry.
+	class Entry
+	{
+	public:
+		U64 m_hash;
+		U32 m_length;
+		Char m_str[1];
+	};
+
+	/// Open addressing hash table that maps strings to IDs. Every slot holds the top 32 bits of the hash of the string
+	/// and the ID. Zero means empty. When it grows the old index is not freed since some thread might still read it.
+	class Index
+	{
+	public:
+		Atomic<U64>* m_slots;
+		U32 m_capacity;
+	};
+
+	/// Holds all the memory. Nothing gets freed until the table is destroyed.
+	StackMemoryPool m_pool;
+
+	Mutex m_mtx; ///< Serializes the insertions.
+	Atomic<Index*> m_index = {nullptr};
+
+	/// The entries. The ID is the index of the entry plus one. The chunks never move so the reads don't lock.
+	Array<Entry**, MAX_CHUNK_COUNT> m_chunks;
+	Atomic<U32> m_entryCount = {0};
+
+	const Entry& getEntry(U32 id) const
+	{
+		ANKI_ASSERT(id > 0 && id <= m_entryCount.load());
+		const U32 idx = id - 1;
+		return *m_chunks[idx >> ENTRIES_PER_CHUNK_LOG2][idx & (ENTRIES_PER_CHUNK - 1)];
+	}
+
+	U32 findInIndex(const Index& index, CString str, U32 length, U64 hash) const;
+
+	Index* newIndex(U32 capacity);
+
+	static void insertToIndex(Index& index, U32 id, U64 hash);
+};
+
+/// An interned string. It's a 32-bit ID to the global StringTable so copying it and comparing it is an integer
+/// operation. The string it points to never dies. Don't intern strings that are generated without bounds.
+class StringId
+{
+public:
+	StringId() = default;
+
+	/// Intern a string.
+	/// @note It's thread-safe.
+	explicit StringId(CString str)
+		: m_id(StringTable::getSingleton().intern(str))
+	{
+	}
+
+	/// Find a string that was already interned. It doesn't intern the string.
+	/// @return An empty StringId if the string was never interned.
+	static StringId tryFind(CString str)
+	{
+		StringId out;
+		out.m_id = StringTable::getSingleton().tryFind(str);
+		return out;
+	}
+
+	explicit operator Bool() const
+	{
+		return m_id != 0;
+	}
+
+	Bool operator==(const StringId& b) const
+	{
+		return m_id == b.m_id;
+	}
+
+	Bool operator!=(const StringId& b) const
+	{
+		return m_id != b.m_id;
+	}
+
+	/// Order by ID. It's not the alphabetical order.
+	Bool operator<(const StringId& b) const
+	{
+		return m_id < b.m_id;
+	}
+
+	Bool isEmpty() const
+	{
+		return m_id == 0;
+	}
+
+	U32 getId() const
+	{
+		return m_id;
+	}
+
+	CString toCString() const
+	{
+		return StringTable::getSingleton().getString(m_id);
+	}
+
+	const Char* cstr() const
+	{
+		ANKI_ASSERT(m_id);
+		return toCString().cstr();
+	}
+
+	/// Get the precomputed hash of the string. It's the same as CString::computeHash().
+	U64 getStringHash() const
+	{
+		return StringTable::getSingleton().getHash(m_id);
+	}
+
+	/// The hash for the hash maps. The IDs are unique so there are no collisions even in HashMap.
+	U64 computeHash() const
+	{
+		return m_id;
+	}
+
+private:
+	U32 m_id = 0;
+};
+/// @}
+
+} // end namespace anki
@@ -28,9 +28,30 @@ public:
 	Chunk* m_currentChunk = nullptr;
 	IntrusiveList<Chunk> m_allChunks;
 	SpinLock m_currentChunkLock;
+
+	/// The values of the registered counters. Only the owning thread writes to them so they start at a new cache line.
+	alignas(ANKI_CACHE_LINE_SIZE) Array<Atomic<U64>, MAX_REGISTERED_COUNTERS> m_counterValues;
+
+	/// The values of m_counterValues at the last flush. Protected by Tracer::m_allThreadLocalMtx.
+	Array<U64, MAX_REGISTERED_COUNTERS> m_flushedCounterValues;
+
+	ThreadLocal()
+	{
+		for(U32 i = 0; i < MAX_REGISTERED_COUNTERS; ++i)
+		{
+			m_counterValues[i].setNonAtomically(0);
+			m_flushedCounterValues[i] = 0;
+		}
+	}
 };
 
 thread_local Tracer::ThreadLocal* Tracer::m_threadLocal = nullptr;
+thread_local Atomic<U64>* Tracer::m_threadLocalCounters = nullptr;
+thread_local U32 Tracer::m_threadLocalTracerId = 0;
+Atomic<U32> Tracer::m_tracerCount = {0};
+Array<const char*, Tracer::MAX_REGISTERED_COUNTERS> Tracer::m_registeredCounterNames = {};
+Atomic<U32> Tracer::m_registeredCounterCount = {0};
+SpinLock Tracer::m_registeredCounterLock;
 
 Tracer::~Tracer()
 {
@@ -42,21 +63,60 @@ Tracer::~Tracer()
 	m_allThreadLocal.destroy(m_alloc);
 }
 
-Tracer::ThreadLocal& Tracer::getThreadLocal()
+Tracer::ThreadLocal& Tracer::getThreadLocalSlow()
 {
-	ThreadLocal* out = m_threadLocal;
-	if(ANKI_UNLIKELY(out == nullptr))
+	ThreadLocal* out = m_alloc.newInstance<ThreadLocal>();
+	out->m_tid = Thread::getCurrentThreadId();
+	m_threadLocal = out;
+	m_threadLocalCounters = &out->m_counterValues[0];
+	m_threadLocalTracerId = m_id;
+
+	// Store it
+	LockGuard<Mutex> lock(m_allThreadLocalMtx);
+	m_allThreadLocal.emplaceBack(m_alloc, out);
+
+	return *out;
+}
+
+TracerCounterId Tracer::registerCounter(const char* counterName)
+{
+	ANKI_ASSERT(counterName);
+
+	auto find = [](const char* counterName, U32 counterCount) -> U32 {
+		for(U32 i = 0; i < counterCount; ++i)
+		{
+			if(m_registeredCounterNames[i] == counterName || strcmp(m_registeredCounterNames[i], counterName) == 0)
+			{
+				return i;
+			}
+		}
+		return MAX_U32;
+	};
+
+	// Search without locking first
+	U32 id = find(counterName, m_registeredCounterCount.load(AtomicMemoryOrder::ACQUIRE));
+	if(id != MAX_U32)
+	{
+		return id;
+	}
+
+	// Search again with the lock held and if not found register it
+	LockGuard<SpinLock> lock(m_registeredCounterLock);
+	const U32 counterCount = m_registeredCounterCount.load(AtomicMemoryOrder::ACQUIRE);
+	id = find(counterName, counterCount);
+	if(id == MAX_U32)
 	{
-		out = m_alloc.newInstance<ThreadLocal>();
-		out->m_tid = Thread::getCurrentThreadId();
-		m_threadLocal = out;
+		if(ANKI_UNLIKELY(counterCount >= MAX_REGISTERED_COUNTERS))
+		{
+			ANKI_UTIL_LOGF("Reached the max number of tracer counters. Increase MAX_REGISTERED_COUNTERS");
+		}
 
-		// Store it
-		LockGuard<Mutex> lock(m_allThreadLocalMtx);
-		m_allThreadLocal.emplaceBack(m_alloc, out);
+		id = counterCount;
+		m_registeredCounterNames[id] = counterName;
+		m_registeredCounterCount.store(counterCount + 1, AtomicMemoryOrder::RELEASE);
 	}
 
-	return *out;
+	return id;
 }
 
 Tracer::Chunk& Tracer::getOrCreateChunk(ThreadLocal& tlocal)
@@ -152,23 +212,6 @@ void Tracer::addCustomEvent(const char* eventName, Second start, Second duration
 	writeCounter.m_value = U64(duration * 1000000000.0);
 }
 
-void Tracer::incrementCounter(const char* counterName, U64 value)
-{
-	if(!m_enabled)
-	{
-		return;
-	}
-
-	ThreadLocal& tlocal = getThreadLocal();
-
-	LockGuard<SpinLock> lock(tlocal.m_currentChunkLock);
-	Chunk& chunk = getOrCreateChunk(tlocal);
-
-	TracerCounter& writeTo = chunk.m_counters[chunk.m_counterCount++];
-	writeTo.m_name = counterName;
-	writeTo.m_value = value;
-}
-
 void Tracer::flush(TracerFlushCallback callback, void* callbackUserData)
 {
 	ANKI_ASSERT(callback);
@@ -190,6 +233,38 @@ void Tracer::flush(TracerFlushCallback callback, void* callbackUserData)
 
 		tlocal->m_currentChunk = nullptr;
 	}
+
+	// Sum the registered counters of all threads. Only the difference since the last flush is reported
+	const U32 registeredCounterCount = m_registeredCounterCount.load(AtomicMemoryOrder::ACQUIRE);
+	Array<U64, MAX_REGISTERED_COUNTERS> counterValues;
+	for(U32 i = 0; i < registeredCounterCount; ++i)
+	{
+		counterValues[i] = 0;
+		for(ThreadLocal* tlocal : m_allThreadLocal)
+		{
+			const U64 value = tlocal->m_counterValues[i].load();
+			counterValues[i] += value - tlocal->m_flushedCounterValues[i];
+			tlocal->m_flushedCounterValues[i] = value;
+		}
+	}
+
+	Array<TracerCounter, MAX_REGISTERED_COUNTERS> counters;
+	U32 counterCount = 0;
+	for(U32 i = 0; i < registeredCounterCount; ++i)
+	{
+		if(counterValues[i] > 0)
+		{
+			counters[counterCount].m_name = m_registeredCounterNames[i];
+			counters[counterCount].m_value = counterValues[i];
+			++counterCount;
+		}
+	}
+
+	if(counterCount > 0)
+	{
+		callback(callbackUserData, Thread::getCurrentThreadId(), ConstWeakArray<TracerEvent>(),
+				 ConstWeakArray<TracerCounter>(&counters[0], counterCount));
+	}
 }
 
 } // end namespace anki
@@ -52,6 +52,10 @@ public:
 	}
 };
 
+/// The ID of a registered counter. See Tracer::registerCounter.
+/// @memberof Tracer
+using TracerCounterId = U32;
+
 /// Tracer flush callback.
 /// @memberof Tracer
 using TracerFlushCallback = void (*)(void* userData, ThreadId tid, ConstWeakArray<TracerEvent> events,
@@ -63,6 +67,7 @@ class Tracer
 public:
 	Tracer(GenericMemoryPoolAllocator<U8> alloc)
 		: m_alloc(alloc)
+		, m_id(m_tracerCount.fetchAdd(1) + 1)
 	{
 	}
 
@@ -84,9 +89,39 @@ public:
 	/// @note It's thread-safe.
 	void addCustomEvent(const char* eventName, Second start, Second duration);
 
-	/// Increment a counter.
+	/// Register a counter once and get an ID that can be used in incrementCounter(). Registering the same name more
+	/// than once returns the same ID. The IDs are global and outlive the tracer.
+	/// @param counterName The name of the counter. It should have static lifetime (like a string literal).
+	/// @note It's thread-safe.
+	static TracerCounterId registerCounter(const char* counterName);
+
+	/// Increment a registered counter. It only touches the calling thread's slot and the slots are summed at flush().
+	/// @note It's thread-safe.
+	void incrementCounter(TracerCounterId counterId, U64 value)
+	{
+		ANKI_ASSERT(counterId < m_registeredCounterCount.load());
+		if(m_enabled)
+		{
+			if(ANKI_UNLIKELY(m_threadLocalTracerId != m_id))
+			{
+				getThreadLocalSlow();
+			}
+
+			// Only this thread writes to its slot so there is no need for an atomic RMW
+			Atomic<U64>& slot = m_threadLocalCounters[counterId];
+			slot.store(slot.load() + value);
+		}
+	}
+
+	/// Increment a counter. Slower than the other incrementCounter() since it has to find the counter by name.
 	/// @note It's thread-safe.
-	void incrementCounter(const char* counterName, U64 value);
+	void incrementCounter(const char* counterName, U64 value)
+	{
+		if(m_enabled)
+		{
+			incrementCounter(registerCounter(counterName), value);
+		}
+	}
 
 	/// Flush all counters and events and start clean. The callback will be called multiple times.
 	/// @note It's thread-safe.
@@ -105,21 +140,39 @@ public:
 private:
 	static constexpr U32 EVENTS_PER_CHUNK = 256;
 	static constexpr U32 COUNTERS_PER_CHUNK = 512;
+	static constexpr U32 MAX_REGISTERED_COUNTERS = 128;
 
 	class ThreadLocal;
 	class Chunk;
 
 	GenericMemoryPoolAllocator<U8> m_alloc;
 
+	/// The thread local data. They point to the data of the tracer with m_threadLocalTracerId.
 	static thread_local ThreadLocal* m_threadLocal;
+	static thread_local Atomic<U64>* m_threadLocalCounters;
+	static thread_local U32 m_threadLocalTracerId;
+
 	DynamicArray<ThreadLocal*> m_allThreadLocal; ///< The Tracer should know about all the ThreadLocal.
 	Mutex m_allThreadLocalMtx;
 
+	static Atomic<U32> m_tracerCount;
+	U32 m_id; ///< Unique ID of this tracer. Used to invalidate the thread locals of older tracers.
+
 	Bool m_enabled = false;
 
+	static Array<const char*, MAX_REGISTERED_COUNTERS> m_registeredCounterNames;
+	static Atomic<U32> m_registeredCounterCount;
+	static SpinLock m_registeredCounterLock;
+
 	/// Get the thread local ThreadLocal structure.
 	/// @note Thread-safe.
-	ThreadLocal& getThreadLocal();
+	ThreadLocal& getThreadLocal()
+	{
+		return (ANKI_LIKELY(m_threadLocalTracerId == m_id)) ? *m_threadLocal : getThreadLocalSlow();
+	}
+
+	/// Create the ThreadLocal of this thread.
+	ThreadLocal& getThreadLocalSlow();
 
 	/// Get or create a new chunk.
 	Chunk& getOrCreateChunk(ThreadLocal& tlocal);
@@ -154,7 +207,12 @@ private:
 #	define ANKI_TRACE_SCOPED_EVENT(name_) TracerScopedEvent _tse##name_(#    name_)
 #	define ANKI_TRACE_CUSTOM_EVENT(name_, start_, duration_) \
 		TracerSingleton::get().addCustomEvent(#name_, start_, duration_)
-#	define ANKI_TRACE_INC_COUNTER(name_, val_) TracerSingleton::get().incrementCounter(#    name_, val_)
+#	define ANKI_TRACE_INC_COUNTER(name_, val_) \
+		do \
+		{ \
+			static const TracerCounterId _tcid##name_ = Tracer::registerCounter(#name_); \
+			TracerSingleton::get().incrementCounter(_tcid##name_, val_); \
+		} while(0)
 #else
 #	define ANKI_TRACE_SCOPED_EVENT(name_) ((void)0)
 #	define ANKI_TRACE_CUSTOM_EVENT(name_, start_, duration_) ((void)0)
@@ -22,6 +22,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.912920)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Icosphere.001_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/Icosphere.ankimesh")
@@ -36,6 +37,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.264235)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Icosphere_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/Icosphere.ankimesh")
@@ -50,6 +52,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.019_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -64,6 +67,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.018_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -78,6 +82,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.017_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -92,6 +97,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.016_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -106,6 +112,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.015_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -120,6 +127,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.014_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -134,6 +142,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.013_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -148,6 +157,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.012_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -162,6 +172,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.011_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -176,6 +187,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.010_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -190,6 +202,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.009_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -204,6 +217,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.008_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -218,6 +232,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.007_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -232,6 +247,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.006_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -246,6 +262,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.005_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -260,6 +277,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.004_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -274,6 +292,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.003_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -288,6 +307,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.002_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -302,6 +322,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Suzanne_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/Suzanne.ankimesh")
@@ -326,6 +347,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/floor.ankimesh")
@@ -366,6 +388,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.021_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -380,6 +403,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.022_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -394,6 +418,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.023_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -408,6 +433,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.024_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -422,6 +448,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.025_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -436,6 +463,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.026_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -450,6 +478,7 @@ rot:setAll(0.000000, 0.000000, 1.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.027_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -464,6 +493,7 @@ rot:setAll(0.000000, 0.000000, 1.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.028_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -478,6 +508,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.029_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -492,6 +523,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.030_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -506,6 +538,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.031_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -520,6 +553,7 @@ rot:setAll(1.000000, 0.000000, 0.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.032_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -534,6 +568,7 @@ rot:setAll(0.000000, 0.000000, 1.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.033_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -548,6 +583,7 @@ rot:setAll(0.000000, 0.000000, 1.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.034_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -562,6 +598,7 @@ rot:setAll(0.000000, 0.000000, 1.000000, 0.000000, 0.000000, 1.000000, 0.000000,
 trf:setRotation(rot)
 trf:setScale(0.995130)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.035_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -576,6 +613,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.036_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -590,6 +628,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.038_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -604,6 +643,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.039_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -618,6 +658,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.037_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -632,6 +673,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.040_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -646,6 +688,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.041_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -660,6 +703,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.042_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -674,6 +718,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.043_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -688,6 +733,7 @@ rot:setAll(0.000000, 1.000000, 0.000000, 0.000000, -1.000000, 0.000000, 0.000000
 trf:setRotation(rot)
 trf:setScale(1.000000)
 node:getSceneNodeBase():getMoveComponent():setLocalTransform(trf)
+node:getSceneNodeBase():getSpatialComponent():setStatic(true)
 node2 = scene:newStaticCollisionNode("Cube.044_cl")
 comp = node2:getSceneNodeBase():getBodyComponent()
 comp:loadMeshResource("Assets/wall.ankimesh")
@@ -0,0 +1,318 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Collision.h>
+#include <AnKi/Collision/GjkEpa.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+using namespace anki;
+
+template<typename T, typename Y>
+static Bool testCollisionGjk(const T& a, const Y& b)
+{
+	auto callbackA = [](const void* shape, const Vec4& dir) {
+		return static_cast<const T*>(shape)->computeSupport(dir);
+	};
+	auto callbackB = [](const void* shape, const Vec4& dir) {
+		return static_cast<const Y*>(shape)->computeSupport(dir);
+	};
+	return gjkIntersection(&a, callbackA, &b, callbackB);
+}
+
+static Vec4 randomPoint(F32 range)
+{
+	return Vec4(getRandomRange(-range, range), getRandomRange(-range, range), getRandomRange(-range, range), 0.0f);
+}
+
+static Aabb randomAabb()
+{
+	const Vec4 min = randomPoint(10.0f);
+	const Vec4 size(getRandomRange(0.1f, 5.0f), getRandomRange(0.1f, 5.0f), getRandomRange(0.1f, 5.0f), 0.0f);
+	return Aabb(min, min + size);
+}
+
+static Obb randomObb()
+{
+	const Euler euler(getRandomRange(-PI, PI), getRandomRange(-PI, PI), getRandomRange(-PI, PI));
+	const Vec4 extend(getRandomRange(0.1f, 3.0f), getRandomRange(0.1f, 3.0f), getRandomRange(0.1f, 3.0f), 0.0f);
+	return Obb(randomPoint(10.0f), Mat3x4(Vec3(0.0f), euler), extend);
+}
+
+static Sphere randomSphere()
+{
+	return Sphere(randomPoint(10.0f), getRandomRange(0.1f, 4.0f));
+}
+
+/// The angles are up to 90 degrees since GJK gives false collisions with wider cones.
+static Cone randomCone()
+{
+	const Vec4 dir = Vec4(randomPoint(1.0f).xyz() + Vec3(0.01f), 0.0f).getNormalized();
+	return Cone(randomPoint(10.0f), dir, getRandomRange(1.0f, 10.0f), getRandomRange(0.1f, PI / 2.0f));
+}
+
+/// Count the tests that disagree with GJK.
+template<typename T, typename Y, typename TFuncA, typename TFuncB>
+static U32 countGjkMismatches(U32 count, TFuncA randomA, TFuncB randomB, U32& collisionCount)
+{
+	U32 mismatches = 0;
+	for(U32 i = 0; i < count; ++i)
+	{
+		const T a = randomA();
+		const Y b = randomB();
+		const Bool collide = testCollision(a, b);
+		mismatches += collide != testCollisionGjk(a, b);
+		collisionCount += collide;
+	}
+
+	return mismatches;
+}
+
+ANKI_TEST(Collision, CollisionVsGjk)
+{
+	constexpr U32 COUNT = 20000;
+
+	// GJK isn't exact when the shapes touch so allow a few to disagree
+	constexpr U32 MAX_MISMATCHES = COUNT / 1000;
+
+	U32 collisionCount = 0;
+	const U32 obbObb = countGjkMismatches<Obb, Obb>(COUNT, randomObb, randomObb, collisionCount);
+	const U32 aabbObb = countGjkMismatches<Aabb, Obb>(COUNT, randomAabb, randomObb, collisionCount);
+	const U32 sphereObb = countGjkMismatches<Sphere, Obb>(COUNT, randomSphere, randomObb, collisionCount);
+	const U32 aabbCone = countGjkMismatches<Aabb, Cone>(COUNT, randomAabb, randomCone, collisionCount);
+	const U32 obbCone = countGjkMismatches<Obb, Cone>(COUNT, randomObb, randomCone, collisionCount);
+	ANKI_TEST_LOGI("Mismatches: OBB-OBB %u, AABB-OBB %u, sphere-OBB %u, AABB-cone %u, OBB-cone %u (%u collisions)",
+				   obbObb, aabbObb, sphereObb, aabbCone, obbCone, collisionCount);
+
+	ANKI_TEST_EXPECT_LEQ(obbObb, MAX_MISMATCHES);
+	ANKI_TEST_EXPECT_LEQ(aabbObb, MAX_MISMATCHES);
+	ANKI_TEST_EXPECT_LEQ(sphereObb, MAX_MISMATCHES);
+	ANKI_TEST_EXPECT_LEQ(aabbCone, MAX_MISMATCHES);
+	ANKI_TEST_EXPECT_LEQ(obbCone, MAX_MISMATCHES);
+
+	// The sphere-cone test is conservative. It shouldn't miss any collision
+	U32 missed = 0;
+	for(U32 i = 0; i < COUNT; ++i)
+	{
+		const Sphere sphere = randomSphere();
+		const Cone cone = randomCone();
+		missed += testCollisionGjk(sphere, cone) && !testCollision(sphere, cone);
+	}
+	ANKI_TEST_EXPECT_LEQ(missed, MAX_MISMATCHES);
+
+	// Boxes that are rotated copies of the same box
+	{
+		const Obb a(Vec4(0.0f), Mat3x4::getIdentity(), Vec4(1.0f, 1.0f, 1.0f, 0.0f));
+		const Obb b(Vec4(2.3f, 0.0f, 0.0f, 0.0f), Mat3x4(Vec3(0.0f), Euler(0.0f, 0.0f, PI / 4.0f)),
+					Vec4(1.0f, 1.0f, 1.0f, 0.0f));
+		ANKI_TEST_EXPECT_EQ(testCollision(a, b), true);
+
+		const Obb c(Vec4(2.5f, 0.0f, 0.0f, 0.0f), b.getRotation(), b.getExtend());
+		ANKI_TEST_EXPECT_EQ(testCollision(a, c), false);
+	}
+}
+
+ANKI_TEST(Collision, CollisionBatch)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	constexpr U32 COUNT = 4003; // Not a multiple of 4 on purpose
+
+	DynamicArrayAuto<Aabb> aabbs(alloc);
+	aabbs.create(COUNT);
+	DynamicArrayAuto<Sphere> spheres(alloc);
+	spheres.create(COUNT);
+	for(U32 i = 0; i < COUNT; ++i)
+	{
+		aabbs[i] = randomAabb();
+		spheres[i] = randomSphere();
+	}
+
+	DynamicArrayAuto<Bool> results(alloc);
+	results.create(COUNT);
+
+	for(U32 iteration = 0; iteration < 20; ++iteration)
+	{
+		const Aabb aabb = randomAabb();
+		testCollision(aabb, aabbs, WeakArray<Bool>(results));
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(results[i], testCollision(aabb, aabbs[i]));
+		}
+
+		const Sphere sphere = randomSphere();
+		testCollision(sphere, aabbs, WeakArray<Bool>(results));
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(results[i], testCollision(sphere, aabbs[i]));
+		}
+
+		const Obb obb = randomObb();
+		testCollision(obb, aabbs, WeakArray<Bool>(results));
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(results[i], testCollision(obb, aabbs[i]));
+		}
+
+		const Cone cone = randomCone();
+		testCollision(cone, spheres, WeakArray<Bool>(results));
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(results[i], testCollision(spheres[i], cone));
+		}
+	}
+}
+
+ANKI_TEST(Collision, CollisionBenchmark)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	constexpr U32 COUNT = 4096;
+	constexpr U32 ITERATIONS = 20;
+
+	DynamicArrayAuto<Aabb> aabbs(alloc);
+	aabbs.create(COUNT);
+	DynamicArrayAuto<Obb> obbs(alloc);
+	obbs.create(COUNT);
+	DynamicArrayAuto<Sphere> spheres(alloc);
+	spheres.create(COUNT);
+	for(U32 i = 0; i < COUNT; ++i)
+	{
+		aabbs[i] = randomAabb();
+		obbs[i] = randomObb();
+		spheres[i] = randomSphere();
+	}
+
+	DynamicArrayAuto<Bool> results(alloc);
+	results.create(COUNT);
+
+	HighRezTimer timer;
+	U32 collisionCount = 0; // To avoid compiler opts
+	auto log = [&](const char* name) {
+		ANKI_TEST_LOGI("%s: %fns per test", name, timer.getElapsedTime() * 1000000000.0 / F64(COUNT * ITERATIONS));
+	};
+
+	// OBB-OBB
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollisionGjk(obbs[it], obbs[i]);
+		}
+	}
+	timer.stop();
+	log("OBB-OBB GJK");
+
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollision(obbs[it], obbs[i]);
+		}
+	}
+	timer.stop();
+	log("OBB-OBB SAT");
+
+	// Sphere-OBB
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollisionGjk(spheres[it], obbs[i]);
+		}
+	}
+	timer.stop();
+	log("Sphere-OBB GJK");
+
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollision(spheres[it], obbs[i]);
+		}
+	}
+	timer.stop();
+	log("Sphere-OBB closed form");
+
+	// OBB-AABB
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollisionGjk(obbs[it], aabbs[i]);
+		}
+	}
+	timer.stop();
+	log("OBB-AABB GJK");
+
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollision(obbs[it], aabbs[i]);
+		}
+	}
+	timer.stop();
+	log("OBB-AABB SAT");
+
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		testCollision(obbs[it], aabbs, WeakArray<Bool>(results));
+		collisionCount += results[it];
+	}
+	timer.stop();
+	log("OBB-AABB SAT batched");
+
+	// Sphere-AABB
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollision(spheres[it], aabbs[i]);
+		}
+	}
+	timer.stop();
+	log("Sphere-AABB");
+
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		testCollision(spheres[it], aabbs, WeakArray<Bool>(results));
+		collisionCount += results[it];
+	}
+	timer.stop();
+	log("Sphere-AABB batched");
+
+	// Cone-sphere
+	const Cone cone(Vec4(0.0f), Vec4(0.0f, 0.0f, -1.0f, 0.0f), 10.0f, PI / 3.0f);
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			collisionCount += testCollision(spheres[i], cone);
+		}
+	}
+	timer.stop();
+	log("Cone-sphere");
+
+	timer.start();
+	for(U32 it = 0; it < ITERATIONS; ++it)
+	{
+		testCollision(cone, spheres, WeakArray<Bool>(results));
+		collisionCount += results[it];
+	}
+	timer.stop();
+	log("Cone-sphere batched");
+
+	ANKI_TEST_LOGI("Collision count %u", collisionCount);
+}
@@ -0,0 +1,450 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Physics/PhysicsWorld.h>
+#include <AnKi/Physics/PhysicsBody.h>
+#include <AnKi/Physics/PhysicsCollisionShape.h>
+#include <AnKi/Physics/PhysicsTrigger.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+
+namespace anki {
+
+/// Create a world with towers of boxes on top of a ground box and step it.
+/// @return The time spent in PhysicsWorld::update.
+static Second runStackedBoxes(ThreadHive* hive, U32 towerCount, U32 boxesPerTower, U32 frameCount, F32& minY)
+{
+	PhysicsWorld* world = new PhysicsWorld();
+	ANKI_TEST_EXPECT_NO_ERR(world->init(allocAligned, nullptr, hive));
+	world->setMaxSubSteps(1);
+
+	Second updateTime = 0.0;
+	{
+		PhysicsCollisionShapePtr groundShape = world->newInstance<PhysicsBox>(Vec3(100.0f, 1.0f, 100.0f));
+		PhysicsBodyInitInfo groundInit;
+		groundInit.m_shape = groundShape;
+		groundInit.m_transform.setOrigin(Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+		PhysicsBodyPtr ground = world->newInstance<PhysicsBody>(groundInit);
+
+		PhysicsCollisionShapePtr boxShape = world->newInstance<PhysicsBox>(Vec3(0.5f));
+		DynamicArrayAuto<PhysicsBodyPtr> boxes(world->getAllocator(), towerCount * boxesPerTower);
+		const U32 towersPerRow = U32(ceil(sqrt(F32(towerCount))));
+		for(U32 tower = 0; tower < towerCount; ++tower)
+		{
+			for(U32 i = 0; i < boxesPerTower; ++i)
+			{
+				PhysicsBodyInitInfo init;
+				init.m_shape = boxShape;
+				init.m_mass = 1.0f;
+				init.m_transform.setOrigin(Vec4(F32(tower % towersPerRow) * 3.0f, 0.5f + F32(i) * 1.01f,
+												F32(tower / towersPerRow) * 3.0f, 0.0f));
+				boxes[tower * boxesPerTower + i] = world->newInstance<PhysicsBody>(init);
+			}
+		}
+
+		for(U32 frame = 0; frame < frameCount; ++frame)
+		{
+			const Second begin = HighRezTimer::getCurrentTime();
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			updateTime += HighRezTimer::getCurrentTime() - begin;
+		}
+
+		minY = MAX_F32;
+		for(const PhysicsBodyPtr& box : boxes)
+		{
+			minY = min(minY, box->getTransform().getOrigin().y());
+		}
+	}
+
+	delete world;
+	return updateTime;
+}
+
+/// Counts the trigger events. The triggers are processed in parallel so it uses atomics.
+class TriggerEventCounter : public PhysicsTriggerProcessContactCallback
+{
+public:
+	Atomic<U32> m_enterCount = {0};
+	Atomic<U32> m_insideCount = {0};
+	Atomic<U32> m_exitCount = {0};
+
+	void onTriggerEnter(PhysicsTrigger& trigger, PhysicsFilteredObject& obj) override
+	{
+		m_enterCount.fetchAdd(1);
+	}
+
+	void onTriggerInside(PhysicsTrigger& trigger, PhysicsFilteredObject& obj) override
+	{
+		m_insideCount.fetchAdd(1);
+	}
+
+	void onTriggerExit(PhysicsTrigger& trigger, PhysicsFilteredObject& obj) override
+	{
+		m_exitCount.fetchAdd(1);
+	}
+};
+
+/// Create a grid of triggers on top of a grid of boxes and step the world.
+/// @return The time spent in PhysicsWorld::update.
+static Second runTriggers(ThreadHive* hive, U32 triggerGridSize, U32 boxGridSize, U32 frameCount,
+						  TriggerEventCounter& counter)
+{
+	PhysicsWorld* world = new PhysicsWorld();
+	ANKI_TEST_EXPECT_NO_ERR(world->init(allocAligned, nullptr, hive));
+	world->setMaxSubSteps(1);
+
+	constexpr F32 BOX_SPACING = 1.5f;
+	const F32 groundSize = F32(boxGridSize) * BOX_SPACING;
+
+	Second updateTime = 0.0;
+	{
+		PhysicsCollisionShapePtr groundShape = world->newInstance<PhysicsBox>(Vec3(groundSize, 1.0f, groundSize));
+		PhysicsBodyInitInfo groundInit;
+		groundInit.m_shape = groundShape;
+		groundInit.m_transform.setOrigin(Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+		PhysicsBodyPtr ground = world->newInstance<PhysicsBody>(groundInit);
+
+		PhysicsCollisionShapePtr boxShape = world->newInstance<PhysicsBox>(Vec3(0.5f));
+		DynamicArrayAuto<PhysicsBodyPtr> boxes(world->getAllocator(), boxGridSize * boxGridSize);
+		for(U32 i = 0; i < boxGridSize * boxGridSize; ++i)
+		{
+			PhysicsBodyInitInfo init;
+			init.m_shape = boxShape;
+			init.m_mass = 1.0f;
+			init.m_transform.setOrigin(
+				Vec4(F32(i % boxGridSize) * BOX_SPACING, 0.5f, F32(i / boxGridSize) * BOX_SPACING, 0.0f));
+			boxes[i] = world->newInstance<PhysicsBody>(init);
+		}
+
+		const F32 triggerSpacing = groundSize / F32(triggerGridSize);
+		PhysicsCollisionShapePtr triggerShape = world->newInstance<PhysicsSphere>(triggerSpacing);
+		DynamicArrayAuto<PhysicsTriggerPtr> triggers(world->getAllocator(), triggerGridSize * triggerGridSize);
+		for(U32 i = 0; i < triggerGridSize * triggerGridSize; ++i)
+		{
+			triggers[i] = world->newInstance<PhysicsTrigger>(triggerShape);
+			triggers[i]->setTransform(Transform(Vec4(F32(i % triggerGridSize) * triggerSpacing, 0.5f,
+													 F32(i / triggerGridSize) * triggerSpacing, 0.0f),
+												Mat3x4::getIdentity(), 1.0f));
+			triggers[i]->setMaterialMask(PhysicsMaterialBit::DYNAMIC_GEOMETRY);
+			triggers[i]->setContactProcessCallback(&counter);
+		}
+
+		for(U32 frame = 0; frame < frameCount; ++frame)
+		{
+			const Second begin = HighRezTimer::getCurrentTime();
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			updateTime += HighRezTimer::getCurrentTime() - begin;
+		}
+	}
+
+	delete world;
+	return updateTime;
+}
+
+ANKI_TEST(Physics, PhysicsWorld)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// A box falls on the ground. The fixed time step is bigger than the update's dt so some updates only interpolate
+	{
+		PhysicsWorld* world = new PhysicsWorld();
+		ANKI_TEST_EXPECT_NO_ERR(world->init(allocAligned, nullptr, nullptr));
+		world->setFixedTimeStep(1.0 / 30.0);
+
+		{
+			PhysicsCollisionShapePtr groundShape = world->newInstance<PhysicsBox>(Vec3(10.0f, 1.0f, 10.0f));
+			PhysicsBodyInitInfo groundInit;
+			groundInit.m_shape = groundShape;
+			groundInit.m_transform.setOrigin(Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+			PhysicsBodyPtr ground = world->newInstance<PhysicsBody>(groundInit);
+
+			PhysicsCollisionShapePtr boxShape = world->newInstance<PhysicsBox>(Vec3(0.5f));
+			PhysicsBodyInitInfo boxInit;
+			boxInit.m_shape = boxShape;
+			boxInit.m_mass = 1.0f;
+			boxInit.m_transform.setOrigin(Vec4(0.0f, 5.0f, 0.0f, 0.0f));
+			PhysicsBodyPtr box = world->newInstance<PhysicsBody>(boxInit);
+
+			// While it falls it moves every frame even if the world does a step every 2 frames. Skip the 1st frames
+			// because there is nothing to interpolate before the 1st step
+			F32 prevY = 5.0f;
+			for(U32 frame = 0; frame < 50; ++frame)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+				const F32 y = box->getTransform().getOrigin().y();
+				if(frame > 3)
+				{
+					ANKI_TEST_EXPECT_LT(y, prevY);
+				}
+				prevY = y;
+			}
+
+			// Then it rests on the ground
+			for(U32 frame = 0; frame < 60; ++frame)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			}
+			prevY = box->getTransform().getOrigin().y();
+			ANKI_TEST_EXPECT_NEAR(prevY, 0.5f, 0.1f);
+		}
+
+		delete world;
+	}
+
+	// Benchmark. Stacks of boxes without threads and then with the threads of a ThreadHive
+	{
+		constexpr U32 TOWER_COUNT = 64;
+		constexpr U32 BOXES_PER_TOWER = 16;
+		constexpr U32 FRAME_COUNT = 120;
+
+		F32 minY;
+		const Second serialTime = runStackedBoxes(nullptr, TOWER_COUNT, BOXES_PER_TOWER, FRAME_COUNT, minY);
+		ANKI_TEST_EXPECT_GT(minY, 0.0f);
+
+		const U32 threadCount = min(getCpuCoresCount(), ThreadHive::MAX_THREADS);
+		ThreadHive hive(threadCount, alloc);
+		const Second parallelTime = runStackedBoxes(&hive, TOWER_COUNT, BOXES_PER_TOWER, FRAME_COUNT, minY);
+		ANKI_TEST_EXPECT_GT(minY, 0.0f);
+
+		ANKI_TEST_LOGI("Physics bench (%u boxes, %u frames): no threads %fsec, %u threads %fsec",
+					   TOWER_COUNT * BOXES_PER_TOWER, FRAME_COUNT, serialTime, threadCount + 1, parallelTime);
+	}
+}
+
+ANKI_TEST(Physics, PhysicsWorldQueries)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	const U32 threadCount = min(getCpuCoresCount(), ThreadHive::MAX_THREADS);
+	ThreadHive hive(threadCount, alloc);
+
+	PhysicsWorld* world = new PhysicsWorld();
+	ANKI_TEST_EXPECT_NO_ERR(world->init(allocAligned, nullptr, &hive));
+
+	{
+		// A ground with a grid of boxes on top
+		constexpr U32 GRID_SIZE = 32;
+		constexpr F32 GRID_SPACING = 4.0f;
+		constexpr F32 GROUND_SIZE = F32(GRID_SIZE) * GRID_SPACING;
+
+		PhysicsCollisionShapePtr groundShape = world->newInstance<PhysicsBox>(Vec3(GROUND_SIZE, 1.0f, GROUND_SIZE));
+		PhysicsBodyInitInfo groundInit;
+		groundInit.m_shape = groundShape;
+		groundInit.m_transform.setOrigin(Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+		PhysicsBodyPtr ground = world->newInstance<PhysicsBody>(groundInit);
+
+		PhysicsCollisionShapePtr boxShape = world->newInstance<PhysicsBox>(Vec3(1.0f));
+		DynamicArrayAuto<PhysicsBodyPtr> boxes(alloc, GRID_SIZE * GRID_SIZE);
+		for(U32 i = 0; i < GRID_SIZE * GRID_SIZE; ++i)
+		{
+			PhysicsBodyInitInfo init;
+			init.m_shape = boxShape;
+			init.m_transform.setOrigin(Vec4((F32(i % GRID_SIZE) + 0.5f) * GRID_SPACING, 1.0f,
+											(F32(i / GRID_SIZE) + 0.5f) * GRID_SPACING, 0.0f));
+			boxes[i] = world->newInstance<PhysicsBody>(init);
+		}
+
+		// Register the objects
+		ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+
+		// Basic
+		{
+			PhysicsWorldQueryBatch batch;
+			const Vec3 boxTop(2.0f, 2.0f, 2.0f);
+			const U32 ray = batch.addRay(boxTop + Vec3(0.0f, 8.0f, 0.0f), boxTop - Vec3(0.0f, 8.0f, 0.0f));
+			const U32 missRay = batch.addRay(Vec3(-10.0f, 10.0f, -10.0f), Vec3(-10.0f, 5.0f, -10.0f));
+			const U32 sweep = batch.addSphereSweep(Vec3(-1.0f, 1.0f, 2.0f), Vec3(5.0f, 1.0f, 2.0f), 0.5f);
+			const U32 overlap = batch.addSphereOverlap(Vec3(2.0f, 3.0f, 2.0f), 1.5f);
+			const U32 missOverlap = batch.addSphereOverlap(Vec3(0.0f, 3.0f, 0.0f), 1.5f);
+
+			PhysicsWorldQuery maskedQuery;
+			maskedQuery.m_from = boxTop + Vec3(0.0f, 8.0f, 0.0f);
+			maskedQuery.m_to = boxTop - Vec3(0.0f, 8.0f, 0.0f);
+			maskedQuery.m_materialMask = PhysicsMaterialBit::DYNAMIC_GEOMETRY;
+			const U32 masked = batch.addQuery(maskedQuery);
+
+			batch.run(*world);
+
+			ANKI_TEST_EXPECT_EQ(batch.isHit(ray), true);
+			ANKI_TEST_EXPECT_NEAR(batch.getHitPosition(ray).y(), 2.0f, 0.01f);
+			ANKI_TEST_EXPECT_NEAR(batch.getHitNormal(ray).y(), 1.0f, 0.01f);
+			ANKI_TEST_EXPECT_NEAR(batch.getHitFraction(ray), 0.5f, 0.01f);
+			ANKI_TEST_EXPECT_EQ(batch.getResult(ray).m_object, boxes[0].get());
+
+			ANKI_TEST_EXPECT_EQ(batch.isHit(missRay), false);
+
+			ANKI_TEST_EXPECT_EQ(batch.isHit(sweep), true);
+			ANKI_TEST_EXPECT_NEAR(batch.getHitPosition(sweep).x(), 1.0f, 0.05f);
+			ANKI_TEST_EXPECT_NEAR(batch.getHitFraction(sweep), 1.5f / 6.0f, 0.01f);
+
+			ANKI_TEST_EXPECT_EQ(batch.isHit(overlap), true);
+			ANKI_TEST_EXPECT_EQ(batch.getResult(overlap).m_object, boxes[0].get());
+			ANKI_TEST_EXPECT_EQ(batch.isHit(missOverlap), false);
+
+			ANKI_TEST_EXPECT_EQ(batch.isHit(masked), false);
+		}
+
+		// Benchmark. Cast rays with the PhysicsWorld::rayCast() one by one and then as a batch
+		{
+			constexpr U32 RAY_COUNT = 100 * 1000;
+			DynamicArrayAuto<PhysicsWorldQuery> queries(alloc, RAY_COUNT);
+			DynamicArrayAuto<PhysicsWorldQueryResult> results(alloc, RAY_COUNT);
+			for(PhysicsWorldQuery& q : queries)
+			{
+				q.m_from = Vec3(getRandomRange(0.0f, GROUND_SIZE), 10.0f, getRandomRange(0.0f, GROUND_SIZE));
+				q.m_to = Vec3(getRandomRange(0.0f, GROUND_SIZE), -10.0f, getRandomRange(0.0f, GROUND_SIZE));
+			}
+
+			class CountHits : public PhysicsWorldRayCastCallback
+			{
+			public:
+				U32 m_hitCount = 0;
+
+				CountHits()
+					: PhysicsWorldRayCastCallback(Vec3(0.0f), Vec3(0.0f), PhysicsMaterialBit::ALL)
+				{
+				}
+
+				void processResult(PhysicsFilteredObject& obj, const Vec3& worldNormal,
+								   const Vec3& worldPosition) override
+				{
+					(void)obj;
+					(void)worldNormal;
+					(void)worldPosition;
+					++m_hitCount;
+				}
+			};
+
+			HighRezTimer timer;
+			timer.start();
+			U32 hitCount = 0;
+			for(const PhysicsWorldQuery& q : queries)
+			{
+				CountHits callback;
+				callback.m_from = q.m_from;
+				callback.m_to = q.m_to;
+				world->rayCast(callback);
+				hitCount += callback.m_hitCount > 0;
+			}
+			timer.stop();
+			const Second oneByOneTime = timer.getElapsedTime();
+
+			timer.start();
+			world->query(queries, WeakArray<PhysicsWorldQueryResult>(results));
+			timer.stop();
+			const Second batchTime = timer.getElapsedTime();
+			hive.waitAllTasks();
+
+			U32 batchHitCount = 0;
+			for(const PhysicsWorldQueryResult& result : results)
+			{
+				batchHitCount += result.m_object != nullptr;
+			}
+			ANKI_TEST_EXPECT_EQ(batchHitCount, hitCount);
+
+			ANKI_TEST_LOGI("Physics queries bench (%u rays): one by one %fsec, batched in %u threads %fsec",
+						   RAY_COUNT, oneByOneTime, threadCount + 1, batchTime);
+		}
+	}
+
+	delete world;
+}
+
+ANKI_TEST(Physics, PhysicsTrigger)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	const U32 threadCount = min(getCpuCoresCount(), ThreadHive::MAX_THREADS);
+	ThreadHive hive(threadCount, alloc);
+
+	// Basic. Use enough triggers to process them in parallel and to have the box inside more than a few of them
+	{
+		constexpr U32 TRIGGER_COUNT = 40;
+
+		PhysicsWorld* world = new PhysicsWorld();
+		ANKI_TEST_EXPECT_NO_ERR(world->init(allocAligned, nullptr, &hive));
+
+		{
+			PhysicsCollisionShapePtr groundShape = world->newInstance<PhysicsBox>(Vec3(10.0f, 1.0f, 10.0f));
+			PhysicsBodyInitInfo groundInit;
+			groundInit.m_shape = groundShape;
+			groundInit.m_transform.setOrigin(Vec4(0.0f, -1.0f, 0.0f, 0.0f));
+			PhysicsBodyPtr ground = world->newInstance<PhysicsBody>(groundInit);
+
+			PhysicsCollisionShapePtr boxShape = world->newInstance<PhysicsBox>(Vec3(0.5f));
+			PhysicsBodyInitInfo boxInit;
+			boxInit.m_shape = boxShape;
+			boxInit.m_mass = 1.0f;
+			boxInit.m_transform.setOrigin(Vec4(0.0f, 0.5f, 0.0f, 0.0f));
+			PhysicsBodyPtr box = world->newInstance<PhysicsBody>(boxInit);
+
+			TriggerEventCounter counter;
+			PhysicsCollisionShapePtr triggerShape = world->newInstance<PhysicsSphere>(1.0f);
+			DynamicArrayAuto<PhysicsTriggerPtr> triggers(alloc, TRIGGER_COUNT);
+			for(U32 i = 0; i < TRIGGER_COUNT; ++i)
+			{
+				triggers[i] = world->newInstance<PhysicsTrigger>(triggerShape);
+				triggers[i]->setTransform(
+					Transform(Vec4(F32(i) * 0.01f, 0.5f, 0.0f, 0.0f), Mat3x4::getIdentity(), 1.0f));
+				triggers[i]->setMaterialMask(PhysicsMaterialBit::DYNAMIC_GEOMETRY);
+				triggers[i]->setContactProcessCallback(&counter);
+			}
+
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			ANKI_TEST_EXPECT_EQ(counter.m_enterCount.load(), TRIGGER_COUNT);
+			ANKI_TEST_EXPECT_EQ(counter.m_insideCount.load(), 0);
+
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			ANKI_TEST_EXPECT_EQ(counter.m_enterCount.load(), TRIGGER_COUNT);
+			ANKI_TEST_EXPECT_EQ(counter.m_insideCount.load(), TRIGGER_COUNT);
+			ANKI_TEST_EXPECT_EQ(counter.m_exitCount.load(), 0);
+
+			// Move it away. The broadphase removes the pairs that stopped overlapping gradually so step a few times
+			box->setTransform(Transform(Vec4(8.0f, 0.5f, 8.0f, 0.0f), Mat3x4::getIdentity(), 1.0f));
+			for(U32 i = 0; i < 60; ++i)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			}
+			ANKI_TEST_EXPECT_EQ(counter.m_exitCount.load(), TRIGGER_COUNT);
+
+			// Move it back and delete it while it's inside. The triggers should forget it without an exit event
+			box->setTransform(Transform(Vec4(0.0f, 0.5f, 0.0f, 0.0f), Mat3x4::getIdentity(), 1.0f));
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			ANKI_TEST_EXPECT_EQ(counter.m_enterCount.load(), 2 * TRIGGER_COUNT);
+
+			const U32 insideCount = counter.m_insideCount.load();
+			box.reset(nullptr);
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			ANKI_TEST_EXPECT_NO_ERR(world->update(1.0 / 60.0));
+			ANKI_TEST_EXPECT_EQ(counter.m_exitCount.load(), TRIGGER_COUNT);
+			ANKI_TEST_EXPECT_EQ(counter.m_insideCount.load(), insideCount);
+		}
+
+		delete world;
+	}
+
+	// Benchmark. N triggers over M boxes without and with threads
+	{
+		constexpr U32 TRIGGER_GRID_SIZE = 16;
+		constexpr U32 BOX_GRID_SIZE = 48;
+		constexpr U32 FRAME_COUNT = 60;
+
+		TriggerEventCounter serialCounter;
+		const Second serialTime = runTriggers(nullptr, TRIGGER_GRID_SIZE, BOX_GRID_SIZE, FRAME_COUNT, serialCounter);
+
+		TriggerEventCounter parallelCounter;
+		const Second parallelTime = runTriggers(&hive, TRIGGER_GRID_SIZE, BOX_GRID_SIZE, FRAME_COUNT, parallelCounter);
+
+		ANKI_TEST_EXPECT_GT(serialCounter.m_enterCount.load(), 0);
+		ANKI_TEST_EXPECT_EQ(serialCounter.m_enterCount.load(), parallelCounter.m_enterCount.load());
+		ANKI_TEST_EXPECT_EQ(serialCounter.m_insideCount.load(), parallelCounter.m_insideCount.load());
+
+		ANKI_TEST_LOGI("Physics triggers bench (%u triggers, %u boxes, %u frames): no threads %fsec, %u threads %fsec",
+					   TRIGGER_GRID_SIZE * TRIGGER_GRID_SIZE, BOX_GRID_SIZE * BOX_GRID_SIZE, FRAME_COUNT, serialTime,
+					   threadCount, parallelTime);
+	}
+}
+
+} // end namespace anki
@@ -0,0 +1,335 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Resource/MeshBinaryLoader.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <MeshOptimizer/meshoptimizer.h>
+
+namespace anki {
+
+/// The buffers of a mesh the way MeshBinaryLoader stores them.
+class MeshBinaryTestBuffers
+{
+public:
+	DynamicArrayAuto<U8, PtrSize> m_indices;
+	DynamicArrayAuto<U8, PtrSize> m_positions;
+	DynamicArrayAuto<U8, PtrSize> m_mainVerts;
+	DynamicArrayAuto<U8, PtrSize> m_boneVerts;
+
+	MeshBinaryTestBuffers(GenericMemoryPoolAllocator<U8> alloc)
+		: m_indices(alloc)
+		, m_positions(alloc)
+		, m_mainVerts(alloc)
+		, m_boneVerts(alloc)
+	{
+	}
+
+	DynamicArrayAuto<U8, PtrSize>& getVertexBuffer(U32 bufferIdx)
+	{
+		return (bufferIdx == 0) ? m_positions : ((bufferIdx == 1) ? m_mainVerts : m_boneVerts);
+	}
+
+	PtrSize getSize() const
+	{
+		return m_indices.getSize() + m_positions.getSize() + m_mainVerts.getSize() + m_boneVerts.getSize();
+	}
+};
+
+static Error loadMesh(ResourceFilesystem& fs, CString fname, MeshBinaryTestBuffers& out, MeshBinaryHeader& header,
+					  DynamicArrayAuto<MeshBinarySubMesh>& submeshes, Bool dequantizePositions = false)
+{
+	MeshBinaryLoader loader(&fs, out.m_indices.getAllocator());
+	loader.setDequantizePositions(dequantizePositions);
+	ANKI_CHECK(loader.load(fname));
+	header = loader.getHeader();
+
+	submeshes.create(loader.getSubMeshes().getSize());
+	for(U32 i = 0; i < submeshes.getSize(); ++i)
+	{
+		submeshes[i] = loader.getSubMeshes()[i];
+	}
+
+	out.m_indices.create(PtrSize(header.m_totalIndexCount) * sizeof(U16));
+	ANKI_CHECK(loader.storeIndexBuffer(&out.m_indices[0], out.m_indices.getSize()));
+
+	for(U32 i = 0; i < header.m_vertexBufferCount; ++i)
+	{
+		DynamicArrayAuto<U8, PtrSize>& buff = out.getVertexBuffer(i);
+		buff.create(loader.getStoredVertexBufferSize(i));
+		ANKI_CHECK(loader.storeVertexBuffer(i, &buff[0], buff.getSize()));
+	}
+
+	return Error::NONE;
+}
+
+static Error writeBuffer(const DynamicArrayAuto<U8, PtrSize>& buff, File& file)
+{
+	ANKI_CHECK(file.write(&buff[0], buff.getSize()));
+
+	const Array<U8, MESH_BINARY_BUFFER_ALIGNMENT> zeros = {};
+	return file.write(&zeros[0], getAlignedRoundUp(MESH_BINARY_BUFFER_ALIGNMENT, buff.getSize()) - buff.getSize());
+}
+
+/// Write a mesh with quantized positions the same way the GltfImporter does.
+static Error writeQuantizedMesh(const MeshBinaryHeader& inHeader, ConstWeakArray<MeshBinarySubMesh> submeshes,
+								const MeshBinaryTestBuffers& in, Bool compress, CString fname)
+{
+	GenericMemoryPoolAllocator<U8> alloc = in.m_indices.getAllocator();
+	MeshBinaryHeader header = inHeader;
+	memcpy(&header.m_magic[0], MESH_MAGIC, 8);
+	header.m_compressedIndexBufferSize = 0;
+	zeroMemory(header.m_compressedVertexBufferSizes);
+
+	// Quantize the positions
+	MeshBinaryVertexAttribute& pos = header.m_vertexAttributes[VertexAttributeId::POSITION];
+	const Vec3 extent = header.m_aabbMax - header.m_aabbMin;
+	pos.m_format = Format::R16G16B16A16_UNORM;
+	pos.m_scale = max(extent.x(), max(extent.y(), extent.z()));
+	header.m_vertexBuffers[0].m_vertexStride = sizeof(U16Vec4);
+
+	DynamicArrayAuto<U8, PtrSize> quantizedPositions(alloc);
+	quantizedPositions.create(PtrSize(header.m_totalVertexCount) * sizeof(U16Vec4));
+	for(U32 v = 0; v < header.m_totalVertexCount; ++v)
+	{
+		Vec3 p;
+		memcpy(&p, &in.m_positions[PtrSize(v) * sizeof(Vec3)], sizeof(p));
+		const Vec3 normalized =
+			((p - header.m_aabbMin) * (F32(MAX_U16) / pos.m_scale)).max(Vec3(0.0f)).min(Vec3(F32(MAX_U16)));
+		const U16Vec4 q(U16(round(normalized.x())), U16(round(normalized.y())), U16(round(normalized.z())), 0);
+		memcpy(&quantizedPositions[PtrSize(v) * sizeof(U16Vec4)], &q, sizeof(q));
+	}
+
+	// The UVs are already in halfs
+	header.m_vertexAttributes[VertexAttributeId::UV0].m_format = Format::R16G16_SFLOAT;
+	header.m_vertexBuffers[1].m_vertexStride = sizeof(MainVertex);
+
+	auto copyOrEncode = [&](const DynamicArrayAuto<U8, PtrSize>& src, U32 stride, DynamicArrayAuto<U8, PtrSize>& dst) {
+		const U32 vertCount = header.m_totalVertexCount;
+		if(compress)
+		{
+			dst.create(meshopt_encodeVertexBufferBound(vertCount, stride));
+			dst.resize(meshopt_encodeVertexBuffer(&dst[0], dst.getSize(), &src[0], vertCount, stride));
+		}
+		else
+		{
+			dst.create(src.getSize());
+			memcpy(&dst[0], &src[0], src.getSize());
+		}
+	};
+
+	MeshBinaryTestBuffers out(alloc);
+	copyOrEncode(quantizedPositions, sizeof(U16Vec4), out.m_positions);
+	copyOrEncode(in.m_mainVerts, sizeof(MainVertex), out.m_mainVerts);
+	if(header.m_vertexBufferCount > 2)
+	{
+		copyOrEncode(in.m_boneVerts, sizeof(BoneInfoVertex), out.m_boneVerts);
+	}
+
+	if(compress)
+	{
+		DynamicArrayAuto<U32> indices(alloc);
+		indices.create(header.m_totalIndexCount);
+		for(U32 i = 0; i < header.m_totalIndexCount; ++i)
+		{
+			U16 idx;
+			memcpy(&idx, &in.m_indices[PtrSize(i) * sizeof(U16)], sizeof(idx));
+			indices[i] = idx;
+		}
+
+		out.m_indices.create(meshopt_encodeIndexBufferBound(indices.getSize(), header.m_totalVertexCount));
+		out.m_indices.resize(
+			meshopt_encodeIndexBuffer(&out.m_indices[0], out.m_indices.getSize(), &indices[0], indices.getSize()));
+
+		header.m_flags |= MeshBinaryFlag::COMPRESSED;
+		header.m_compressedIndexBufferSize = U32(out.m_indices.getSize());
+		for(U32 i = 0; i < header.m_vertexBufferCount; ++i)
+		{
+			header.m_compressedVertexBufferSizes[i] = U32(out.getVertexBuffer(i).getSize());
+		}
+	}
+	else
+	{
+		out.m_indices.create(in.m_indices.getSize());
+		memcpy(&out.m_indices[0], &in.m_indices[0], in.m_indices.getSize());
+	}
+
+	File file;
+	ANKI_CHECK(file.open(fname, FileOpenFlag::WRITE | FileOpenFlag::BINARY));
+	ANKI_CHECK(file.write(&header, sizeof(header)));
+	ANKI_CHECK(file.write(&submeshes[0], submeshes.getSizeInBytes()));
+	ANKI_CHECK(writeBuffer(out.m_indices, file));
+	for(U32 i = 0; i < header.m_vertexBufferCount; ++i)
+	{
+		ANKI_CHECK(writeBuffer(out.getVertexBuffer(i), file));
+	}
+
+	return Error::NONE;
+}
+
+ANKI_TEST(Resource, MeshBinary)
+{
+	printf("Test requires the Samples dir\n");
+
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	StringAuto outDir(alloc);
+	ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(outDir));
+	outDir.append("/AnKiMeshBinaryTest");
+	if(directoryExists(outDir))
+	{
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(outDir, alloc));
+	}
+	ANKI_TEST_EXPECT_NO_ERR(createDirectory(outDir));
+
+	ResourceFilesystem sponzaFs(alloc);
+	ANKI_TEST_EXPECT_NO_ERR(sponzaFs.addNewPath("Samples/Sponza/Assets", StringListAuto(alloc)));
+
+	// Load the v5 meshes of Sponza and re-write them quantized and quantized+compressed
+	StringListAuto meshFnames(alloc);
+	ANKI_TEST_EXPECT_NO_ERR(walkDirectoryTree("Samples/Sponza/Assets", alloc, [&](CString fname, Bool isDir) {
+		if(!isDir && fname.find(".ankimesh") != CString::NPOS)
+		{
+			meshFnames.pushBack(fname);
+		}
+		return Error::NONE;
+	}));
+	ANKI_TEST_EXPECT_GT(meshFnames.getSize(), 0);
+
+	constexpr U32 VARIANT_COUNT = 3;
+	const Array<CString, VARIANT_COUNT> variantNames = {"F32", "quantized", "quantized+compressed"};
+	Array<PtrSize, VARIANT_COUNT> fileSizes = {};
+	Array<PtrSize, 2> storedSizes = {};
+
+	for(const String& fname : meshFnames)
+	{
+		MeshBinaryTestBuffers buffers(alloc);
+		MeshBinaryHeader header;
+		DynamicArrayAuto<MeshBinarySubMesh> submeshes(alloc);
+		ANKI_TEST_EXPECT_NO_ERR(loadMesh(sponzaFs, fname, buffers, header, submeshes));
+		storedSizes[0] += buffers.getSize();
+
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(
+			file.open(StringAuto(alloc).sprintf("Samples/Sponza/Assets/%s", fname.cstr()), FileOpenFlag::READ));
+		fileSizes[0] += file.getSize();
+
+		for(U32 compress = 0; compress < 2; ++compress)
+		{
+			ANKI_TEST_EXPECT_NO_ERR(
+				writeQuantizedMesh(header, submeshes, buffers, compress,
+								   StringAuto(alloc).sprintf("%s/%u_%s", outDir.cstr(), compress, fname.cstr())));
+		}
+	}
+
+	// Load them back and compare with the original
+	ResourceFilesystem outFs(alloc);
+	ANKI_TEST_EXPECT_NO_ERR(outFs.addNewPath(outDir, StringListAuto(alloc)));
+	Array<Second, VARIANT_COUNT> loadTimes = {};
+	HighRezTimer timer;
+
+	for(const String& fname : meshFnames)
+	{
+		MeshBinaryTestBuffers reference(alloc);
+		MeshBinaryHeader header;
+		DynamicArrayAuto<MeshBinarySubMesh> submeshes(alloc);
+		timer.start();
+		ANKI_TEST_EXPECT_NO_ERR(loadMesh(sponzaFs, fname, reference, header, submeshes));
+		timer.stop();
+		loadTimes[0] += timer.getElapsedTime();
+
+		for(U32 compress = 0; compress < 2; ++compress)
+		{
+			const StringAuto variantFname = StringAuto(alloc).sprintf("%u_%s", compress, fname.cstr());
+			MeshBinaryTestBuffers buffers(alloc);
+			MeshBinaryHeader variantHeader;
+			DynamicArrayAuto<MeshBinarySubMesh> variantSubmeshes(alloc);
+			timer.start();
+			ANKI_TEST_EXPECT_NO_ERR(loadMesh(outFs, variantFname, buffers, variantHeader, variantSubmeshes));
+			timer.stop();
+			loadTimes[compress + 1] += timer.getElapsedTime();
+
+			File file;
+			ANKI_TEST_EXPECT_NO_ERR(
+				file.open(StringAuto(alloc).sprintf("%s/%s", outDir.cstr(), variantFname.cstr()), FileOpenFlag::READ));
+			fileSizes[compress + 1] += file.getSize();
+
+			if(compress == 0)
+			{
+				storedSizes[1] += buffers.getSize();
+			}
+
+			// Everything but the positions should be identical. The index codec might rotate the triangles
+			ANKI_TEST_EXPECT_EQ(buffers.getSize() - buffers.m_positions.getSize(),
+								reference.getSize() - reference.m_positions.getSize());
+			const U16* indices = reinterpret_cast<const U16*>(&buffers.m_indices[0]);
+			const U16* refIndices = reinterpret_cast<const U16*>(&reference.m_indices[0]);
+			for(U32 i = 0; i < header.m_totalIndexCount; i += 3)
+			{
+				U32 rotation = 0;
+				while(rotation < 3 && indices[i + rotation] != refIndices[i])
+				{
+					++rotation;
+				}
+
+				ANKI_TEST_EXPECT_LT(rotation, 3);
+				ANKI_TEST_EXPECT_EQ(indices[i + (rotation + 1) % 3], refIndices[i + 1]);
+				ANKI_TEST_EXPECT_EQ(indices[i + (rotation + 2) % 3], refIndices[i + 2]);
+			}
+
+			ANKI_TEST_EXPECT_EQ(
+				memcmp(&buffers.m_mainVerts[0], &reference.m_mainVerts[0], reference.m_mainVerts.getSize()), 0);
+			if(header.m_vertexBufferCount > 2)
+			{
+				ANKI_TEST_EXPECT_EQ(
+					memcmp(&buffers.m_boneVerts[0], &reference.m_boneVerts[0], reference.m_boneVerts.getSize()), 0);
+			}
+
+			// The positions stay quantized. Dequantize them like the vertex shader does. They are off by half a
+			// quantization step at most
+			const F32 scale = variantHeader.m_vertexAttributes[VertexAttributeId::POSITION].m_scale;
+			const F32 epsilon = scale / F32(MAX_U16);
+			ANKI_TEST_EXPECT_EQ(buffers.m_positions.getSize(), PtrSize(header.m_totalVertexCount) * sizeof(U16Vec4));
+			const U16Vec4* positions = reinterpret_cast<const U16Vec4*>(&buffers.m_positions[0]);
+			const Vec3* refPositions = reinterpret_cast<const Vec3*>(&reference.m_positions[0]);
+			for(U32 v = 0; v < header.m_totalVertexCount; ++v)
+			{
+				const Vec3 unorm = Vec3(positions[v].xyz()) / F32(MAX_U16);
+				const Vec3 diff = (variantHeader.m_aabbMin + unorm * scale - refPositions[v]).abs();
+				ANKI_TEST_EXPECT_LEQ(max(diff.x(), max(diff.y(), diff.z())), epsilon);
+			}
+
+			// Same for the loader's dequantization
+			MeshBinaryTestBuffers dequantized(alloc);
+			MeshBinaryHeader dequantizedHeader;
+			DynamicArrayAuto<MeshBinarySubMesh> dequantizedSubmeshes(alloc);
+			ANKI_TEST_EXPECT_NO_ERR(
+				loadMesh(outFs, variantFname, dequantized, dequantizedHeader, dequantizedSubmeshes, true));
+			ANKI_TEST_EXPECT_EQ(dequantized.getSize(), reference.getSize());
+			const Vec3* dequantizedPositions = reinterpret_cast<const Vec3*>(&dequantized.m_positions[0]);
+			for(U32 v = 0; v < header.m_totalVertexCount; ++v)
+			{
+				const Vec3 diff = (dequantizedPositions[v] - refPositions[v]).abs();
+				ANKI_TEST_EXPECT_LEQ(max(diff.x(), max(diff.y(), diff.z())), epsilon);
+			}
+		}
+	}
+
+	ANKI_TEST_EXPECT_NO_ERR(removeDirectory(outDir, alloc));
+
+	// Print the numbers
+	ANKI_TEST_LOGI("Sponza has %u meshes that take %uKB (F32) and %uKB (quantized) in memory after loading",
+				   U32(meshFnames.getSize()), U32(storedSizes[0] / 1024), U32(storedSizes[1] / 1024));
+	for(U32 i = 0; i < VARIANT_COUNT; ++i)
+	{
+		const PtrSize storedSize = storedSizes[min(i, 1u)];
+		ANKI_TEST_LOGI("%s: %uKB on disk, loaded in %fms (%fMB/s)", variantNames[i].cstr(), U32(fileSizes[i] / 1024),
+					   loadTimes[i] * 1000.0, F64(storedSize) / (1024.0 * 1024.0) / loadTimes[i]);
+	}
+}
+
+} // end namespace anki
@@ -0,0 +1,392 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Importer/GltfImporter.h>
+#include <AnKi/Resource/MeshBinaryLoader.h>
+#include <AnKi/Resource/MeshResource.h>
+#include <AnKi/Collision/Functions.h>
+#include <AnKi/Util/Filesystem.h>
+#include <AnKi/Util/File.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+namespace anki {
+
+/// A primitive of the glTF that the test imports.
+class MeshletTestPrimitive
+{
+public:
+	DynamicArrayAuto<Vec3> m_positions;
+	DynamicArrayAuto<Vec3> m_normals;
+	DynamicArrayAuto<Vec2> m_uvs;
+	DynamicArrayAuto<U16> m_indices;
+
+	MeshletTestPrimitive(GenericMemoryPoolAllocator<U8> alloc)
+		: m_positions(alloc)
+		, m_normals(alloc)
+		, m_uvs(alloc)
+		, m_indices(alloc)
+	{
+	}
+
+	void addVertex(const Vec3& pos, const Vec3& normal, const Vec2& uv)
+	{
+		m_positions.emplaceBack(pos);
+		m_normals.emplaceBack(normal);
+		m_uvs.emplaceBack(uv);
+	}
+
+	void addTriangle(U32 a, U32 b, U32 c)
+	{
+		m_indices.emplaceBack(U16(a));
+		m_indices.emplaceBack(U16(b));
+		m_indices.emplaceBack(U16(c));
+	}
+};
+
+/// A UV sphere. The triangles are counter-clockwise when seen from the outside.
+static void createSphere(const Vec3& center, F32 radius, MeshletTestPrimitive& out)
+{
+	constexpr U32 RINGS = 16;
+	constexpr U32 SEGMENTS = 32;
+
+	for(U32 i = 0; i <= RINGS; ++i)
+	{
+		const F32 theta = PI * F32(i) / F32(RINGS);
+		for(U32 j = 0; j <= SEGMENTS; ++j)
+		{
+			const F32 phi = 2.0f * PI * F32(j) / F32(SEGMENTS);
+			const Vec3 normal(sin(theta) * cos(phi), cos(theta), sin(theta) * sin(phi));
+			out.addVertex(center + normal * radius, normal, Vec2(F32(j) / F32(SEGMENTS), F32(i) / F32(RINGS)));
+		}
+	}
+
+	for(U32 i = 0; i < RINGS; ++i)
+	{
+		for(U32 j = 0; j < SEGMENTS; ++j)
+		{
+			const U32 a = i * (SEGMENTS + 1) + j;
+			const U32 b = a + SEGMENTS + 1;
+
+			// Skip the degenerate triangles of the poles
+			if(i != 0)
+			{
+				out.addTriangle(a, a + 1, b);
+			}
+
+			if(i != RINGS - 1)
+			{
+				out.addTriangle(a + 1, b + 1, b);
+			}
+		}
+	}
+}
+
+/// A grid on the XZ plane that faces up.
+static void createGround(F32 y, F32 size, MeshletTestPrimitive& out)
+{
+	constexpr U32 CELLS = 24;
+
+	for(U32 j = 0; j <= CELLS; ++j)
+	{
+		for(U32 i = 0; i <= CELLS; ++i)
+		{
+			const Vec2 uv(F32(i) / F32(CELLS), F32(j) / F32(CELLS));
+			out.addVertex(Vec3((uv.x() - 0.5f) * size, y, (uv.y() - 0.5f) * size), Vec3(0.0f, 1.0f, 0.0f), uv);
+		}
+	}
+
+	for(U32 j = 0; j < CELLS; ++j)
+	{
+		for(U32 i = 0; i < CELLS; ++i)
+		{
+			const U32 a = j * (CELLS + 1) + i;
+			out.addTriangle(a, a + CELLS + 1, a + 1);
+			out.addTriangle(a + 1, a + CELLS + 1, a + CELLS + 2);
+		}
+	}
+}
+
+/// Write a glTF with one mesh that has a sub mesh per primitive.
+static Error writeGltf(CString dir, ConstWeakArray<MeshletTestPrimitive> primitives,
+					   GenericMemoryPoolAllocator<U8> alloc)
+{
+	StringAuto accessors(alloc);
+	StringAuto bufferViews(alloc);
+	StringAuto meshPrimitives(alloc);
+	File binFile;
+	ANKI_CHECK(binFile.open(StringAuto(alloc).sprintf("%s/MeshletTest.bin", dir.cstr()), FileOpenFlag::WRITE));
+	PtrSize binSize = 0;
+	U32 viewCount = 0;
+
+	auto addView = [&](const void* data, PtrSize size, U32 count, CString componentType, CString type) -> Error {
+		ANKI_CHECK(binFile.write(data, size));
+		bufferViews.append(StringAuto(alloc).sprintf("%s{\"buffer\": 0, \"byteOffset\": %lu, \"byteLength\": %lu}",
+													 (viewCount) ? ", " : "", binSize, size));
+		accessors.append(StringAuto(alloc).sprintf(
+			"%s{\"bufferView\": %u, \"componentType\": %s, \"count\": %u, \"type\": \"%s\"}", (viewCount) ? ", " : "",
+			viewCount, componentType.cstr(), count, type.cstr()));
+		++viewCount;
+
+		// Keep the views aligned
+		binSize += size;
+		while(binSize % 4)
+		{
+			const U8 zero = 0;
+			ANKI_CHECK(binFile.write(&zero, 1));
+			++binSize;
+		}
+
+		return Error::NONE;
+	};
+
+	for(const MeshletTestPrimitive& prim : primitives)
+	{
+		const U32 vertCount = prim.m_positions.getSize();
+		const U32 firstView = viewCount;
+		ANKI_CHECK(addView(&prim.m_positions[0], prim.m_positions.getSizeInBytes(), vertCount, "5126", "VEC3"));
+		ANKI_CHECK(addView(&prim.m_normals[0], prim.m_normals.getSizeInBytes(), vertCount, "5126", "VEC3"));
+		ANKI_CHECK(addView(&prim.m_uvs[0], prim.m_uvs.getSizeInBytes(), vertCount, "5126", "VEC2"));
+		ANKI_CHECK(addView(&prim.m_indices[0], prim.m_indices.getSizeInBytes(), prim.m_indices.getSize(), "5123",
+						   "SCALAR"));
+
+		meshPrimitives.append(StringAuto(alloc).sprintf(
+			"%s{\"attributes\": {\"POSITION\": %u, \"NORMAL\": %u, \"TEXCOORD_0\": %u}, \"indices\": %u, "
+			"\"material\": 0}",
+			(firstView) ? ", " : "", firstView, firstView + 1, firstView + 2, firstView + 3));
+	}
+
+	binFile.close();
+
+	File file;
+	ANKI_CHECK(file.open(StringAuto(alloc).sprintf("%s/MeshletTest.gltf", dir.cstr()), FileOpenFlag::WRITE));
+	ANKI_CHECK(file.writeText("{\"asset\": {\"version\": \"2.0\"}, \"scene\": 0, \"scenes\": [{\"nodes\": [0]}], "
+							  "\"nodes\": [{\"name\": \"MeshletTest\", \"mesh\": 0}], "
+							  "\"meshes\": [{\"name\": \"MeshletTest\", \"primitives\": [%s]}], "
+							  "\"materials\": [{\"name\": \"MeshletTest\", \"pbrMetallicRoughness\": {}}], "
+							  "\"accessors\": [%s], \"bufferViews\": [%s], "
+							  "\"buffers\": [{\"uri\": \"MeshletTest.bin\", \"byteLength\": %lu}]}\n",
+							  meshPrimitives.cstr(), accessors.cstr(), bufferViews.cstr(), binSize));
+
+	return Error::NONE;
+}
+
+/// The frustum planes of a camera in world space. The normals point inside the frustum.
+static void computeFrustumPlanes(const Vec3& eye, const Vec3& dir, F32 fovX, F32 fovY, F32 near, F32 far,
+								 Array<Plane, 6>& planes)
+{
+	const Vec3 front = dir.getNormalized();
+	const Vec3 right = front.cross(Vec3(0.0f, 1.0f, 0.0f)).getNormalized();
+	const Vec3 up = right.cross(front);
+	auto plane = [](const Vec3& normal, const Vec3& point) {
+		return Plane(normal.xyz0(), normal.dot(point));
+	};
+
+	planes[FrustumPlaneType::NEAR] = plane(front, eye + front * near);
+	planes[FrustumPlaneType::FAR] = plane(-front, eye + front * far);
+	planes[FrustumPlaneType::LEFT] = plane(right * cos(fovX / 2.0f) + front * sin(fovX / 2.0f), eye);
+	planes[FrustumPlaneType::RIGHT] = plane(-right * cos(fovX / 2.0f) + front * sin(fovX / 2.0f), eye);
+	planes[FrustumPlaneType::BOTTOM] = plane(up * cos(fovY / 2.0f) + front * sin(fovY / 2.0f), eye);
+	planes[FrustumPlaneType::TOP] = plane(-up * cos(fovY / 2.0f) + front * sin(fovY / 2.0f), eye);
+}
+
+/// Check that a culled meshlet is really invisible. Either all its vertices are behind a plane or all its triangles
+/// face away from the camera.
+static Bool meshletIsInvisible(ConstWeakArray<U32> indices, ConstWeakArray<Vec3> positions, const Meshlet& meshlet,
+							   ConstWeakArray<Plane> planes, const Vec4& cameraPos)
+{
+	for(const Plane& plane : planes)
+	{
+		Bool allBehind = true;
+		for(U32 i = meshlet.m_firstIndex; i < meshlet.m_firstIndex + meshlet.m_indexCount && allBehind; ++i)
+		{
+			allBehind = testPlane(plane, positions[indices[i]].xyz0()) < 0.0f;
+		}
+
+		if(allBehind)
+		{
+			return true;
+		}
+	}
+
+	for(U32 i = meshlet.m_firstIndex; i < meshlet.m_firstIndex + meshlet.m_indexCount; i += 3)
+	{
+		const Vec3 a = positions[indices[i + 0]];
+		const Vec3 b = positions[indices[i + 1]];
+		const Vec3 c = positions[indices[i + 2]];
+		const Vec3 n = (b - a).cross(c - a);
+		const Vec3 dir = a - cameraPos.xyz();
+		if(n.dot(dir) < -1e-3f * n.getLength() * dir.getLength())
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+ANKI_TEST(Resource, MeshletCulling)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	StringAuto outDir(alloc);
+	ANKI_TEST_EXPECT_NO_ERR(getTempDirectory(outDir));
+	outDir.append("/AnKiMeshletTest");
+	if(directoryExists(outDir))
+	{
+		ANKI_TEST_EXPECT_NO_ERR(removeDirectory(outDir, alloc));
+	}
+	ANKI_TEST_EXPECT_NO_ERR(createDirectory(outDir));
+
+	// A grid of spheres on top of a ground plane
+	constexpr U32 SPHERE_GRID_SIZE = 3;
+	constexpr F32 SPHERE_SPACING = 4.0f;
+	DynamicArrayAuto<MeshletTestPrimitive> primitives(alloc);
+	primitives.create(SPHERE_GRID_SIZE * SPHERE_GRID_SIZE + 1, MeshletTestPrimitive(alloc));
+	for(U32 i = 0; i < SPHERE_GRID_SIZE * SPHERE_GRID_SIZE; ++i)
+	{
+		const Vec3 center((F32(i % SPHERE_GRID_SIZE) - 1.0f) * SPHERE_SPACING, 0.0f,
+						  (F32(i / SPHERE_GRID_SIZE) - 1.0f) * SPHERE_SPACING);
+		createSphere(center, 1.0f, primitives[i]);
+	}
+	createGround(-1.5f, SPHERE_SPACING * F32(SPHERE_GRID_SIZE + 1), primitives.getBack());
+	ANKI_TEST_EXPECT_NO_ERR(writeGltf(outDir, ConstWeakArray<MeshletTestPrimitive>(primitives), alloc));
+
+	// Place a few cameras around the spheres. Half look at the spheres and half away from them
+	constexpr U32 CAMERA_COUNT = 8;
+	Array<Array<Plane, 6>, CAMERA_COUNT> cameraPlanes;
+	Array<Vec4, CAMERA_COUNT> cameraPositions;
+	for(U32 i = 0; i < CAMERA_COUNT; ++i)
+	{
+		const F32 angle = F32(i) / F32(CAMERA_COUNT) * 2.0f * PI;
+		const Vec3 eye = Vec3(sin(angle), 0.25f, cos(angle)) * SPHERE_SPACING * 2.0f;
+		const Vec3 dir = (i & 1) ? eye : -eye;
+		computeFrustumPlanes(eye, dir, toRad(90.0f), toRad(60.0f), 0.1f, 1000.0f, cameraPlanes[i]);
+		cameraPositions[i] = eye.xyz0();
+	}
+
+	// Import it with and without quantization
+	for(U32 quantize = 0; quantize < 2; ++quantize)
+	{
+		StringAuto variantDir(alloc);
+		variantDir.sprintf("%s/%s/", outDir.cstr(), (quantize) ? "Quantized" : "F32");
+		ANKI_TEST_EXPECT_NO_ERR(createDirectory(variantDir));
+
+		GltfImporterInitInfo initInfo;
+		StringAuto gltfFname(alloc);
+		gltfFname.sprintf("%s/MeshletTest.gltf", outDir.cstr());
+		initInfo.m_inputFilename = gltfFname;
+		initInfo.m_outDirectory = variantDir;
+		initInfo.m_rpath = variantDir;
+		initInfo.m_texrpath = variantDir;
+		initInfo.m_comment = "Resource.MeshletCulling";
+		initInfo.m_quantizeMeshes = quantize;
+		initInfo.m_incrementalImport = false;
+		GltfImporter importer(alloc);
+		ANKI_TEST_EXPECT_NO_ERR(importer.init(initInfo));
+		ANKI_TEST_EXPECT_NO_ERR(importer.writeAll());
+
+		// Load the mesh the way MeshResource does
+		ResourceFilesystem fs(alloc);
+		ANKI_TEST_EXPECT_NO_ERR(fs.addNewPath(variantDir, StringListAuto(alloc)));
+		MeshBinaryLoader loader(&fs, alloc);
+		ANKI_TEST_EXPECT_NO_ERR(loader.load("MeshletTest.ankimesh"));
+		ANKI_TEST_EXPECT_EQ(memcmp(&loader.getHeader().m_magic[0], MESH_MAGIC, 8), 0);
+		ANKI_TEST_EXPECT_EQ(loader.getSubMeshes().getSize(), primitives.getSize());
+		ANKI_TEST_EXPECT_GT(loader.getMeshlets().getSize(), loader.getSubMeshes().getSize());
+
+		DynamicArrayAuto<U32> indices(alloc);
+		DynamicArrayAuto<Vec3> positions(alloc);
+		ANKI_TEST_EXPECT_NO_ERR(loader.storeIndicesAndPosition(indices, positions));
+
+		DynamicArrayAuto<Meshlet> meshlets(alloc);
+		meshlets.create(loader.getMeshlets().getSize());
+		DynamicArrayAuto<UVec2> subMeshMeshlets(alloc);
+		subMeshMeshlets.create(loader.getSubMeshes().getSize());
+		unpackMeshlets(loader.getMeshlets(), loader.getSubMeshes(), WeakArray<Meshlet>(meshlets),
+					   WeakArray<UVec2>(subMeshMeshlets));
+
+		// Every sub mesh has its own meshlets and they tile its indices
+		U32 meshletCount = 0;
+		for(U32 i = 0; i < subMeshMeshlets.getSize(); ++i)
+		{
+			const MeshBinarySubMesh& sm = loader.getSubMeshes()[i];
+			const UVec2 range = subMeshMeshlets[i];
+			ANKI_TEST_EXPECT_EQ(range.x(), meshletCount);
+			ANKI_TEST_EXPECT_GT(range.y(), 0);
+			ANKI_TEST_EXPECT_EQ(meshlets[range.x()].m_firstIndex, sm.m_firstIndex);
+
+			const Meshlet& last = meshlets[range.x() + range.y() - 1];
+			ANKI_TEST_EXPECT_EQ(last.m_firstIndex + last.m_indexCount, sm.m_firstIndex + sm.m_indexCount);
+			meshletCount += range.y();
+		}
+		ANKI_TEST_EXPECT_EQ(meshletCount, meshlets.getSize());
+
+		// The spheres bound the positions of the file, quantized or not
+		for(const Meshlet& meshlet : meshlets)
+		{
+			for(U32 i = meshlet.m_firstIndex; i < meshlet.m_firstIndex + meshlet.m_indexCount; ++i)
+			{
+				const F32 dist = (positions[indices[i]] - meshlet.m_sphere.xyz()).getLength();
+				ANKI_TEST_EXPECT_LEQ(dist, meshlet.m_sphere.w() * 1.0001f);
+			}
+		}
+
+		// Cull
+		DynamicArrayAuto<U32> visibleMeshlets(alloc);
+		visibleMeshlets.create(meshlets.getSize());
+		U32 visibleMeshletCount = 0;
+		U32 frontFacingMeshletCount = 0;
+		Second cullTime = 0.0;
+		HighRezTimer timer;
+		for(U32 cam = 0; cam < CAMERA_COUNT; ++cam)
+		{
+			const ConstWeakArray<Plane> planes(cameraPlanes[cam]);
+
+			timer.start();
+			const U32 visibleCount =
+				cullMeshlets(meshlets, planes, cameraPositions[cam], WeakArray<U32>(visibleMeshlets));
+			timer.stop();
+			cullTime += timer.getElapsedTime();
+			visibleMeshletCount += visibleCount;
+
+			// Check that the culled ones are really invisible
+			U32 visibleIdx = 0;
+			for(U32 i = 0; i < meshlets.getSize(); ++i)
+			{
+				if(visibleIdx < visibleCount && visibleMeshlets[visibleIdx] == i)
+				{
+					++visibleIdx;
+				}
+				else
+				{
+					const Bool invisible =
+						meshletIsInvisible(indices, positions, meshlets[i], planes, cameraPositions[cam]);
+					ANKI_TEST_EXPECT_EQ(invisible, true);
+				}
+			}
+			ANKI_TEST_EXPECT_EQ(visibleIdx, visibleCount);
+
+			// Without planes only the cones cull
+			frontFacingMeshletCount += cullMeshlets(meshlets, ConstWeakArray<Plane>(), cameraPositions[cam],
+													WeakArray<U32>(visibleMeshlets));
+		}
+
+		// Both the frustum and the cones should have culled something
+		ANKI_TEST_EXPECT_GT(visibleMeshletCount, 0);
+		ANKI_TEST_EXPECT_LT(visibleMeshletCount, frontFacingMeshletCount);
+		ANKI_TEST_EXPECT_LT(frontFacingMeshletCount, meshlets.getSize() * CAMERA_COUNT);
+
+		const F64 totalCount = F64(meshlets.getSize() * CAMERA_COUNT);
+		ANKI_TEST_LOGI("%s: %u meshlets. Culled them for %u cameras in %fms. Visible %f%% (%f%% front facing)",
+					   (quantize) ? "Quantized" : "F32", meshlets.getSize(), CAMERA_COUNT, cullTime * 1000.0,
+					   F64(visibleMeshletCount) * 100.0 / totalCount,
+					   F64(frontFacingMeshletCount) * 100.0 / totalCount);
+	}
+
+	ANKI_TEST_EXPECT_NO_ERR(removeDirectory(outDir, alloc));
+}
+
+} // end namespace anki
@@ -0,0 +1,107 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/GpuSceneInstances.h>
+#include <AnKi/Renderer/RenderQueue.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+namespace anki {
+
+ANKI_TEST(Scene, GpuSceneInstances)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	StackAllocator<U8> frameAlloc(allocAligned, nullptr, 1_MB);
+
+	// Basic
+	{
+		GpuSceneInstances instances(alloc);
+
+		const U32 a = instances.newInstance(10);
+		const U32 b = instances.newInstance(20);
+		const U32 c = instances.newInstance(10);
+		ANKI_TEST_EXPECT_EQ(instances.getDirtyInstanceCount(), 3);
+
+		GpuSceneQueueElement el;
+		instances.flush(frameAlloc, el);
+		ANKI_TEST_EXPECT_EQ(el.m_instances.getSize(), 3);
+		ANKI_TEST_EXPECT_EQ(el.m_dirtyInstances.getSize(), 3);
+		ANKI_TEST_EXPECT_EQ(el.m_instances[a].m_drawBucket, el.m_instances[c].m_drawBucket);
+		ANKI_TEST_EXPECT_EQ(el.m_instances[b].m_drawBucket, MAX_LOD_COUNT);
+
+		// Nothing changed
+		instances.flush(frameAlloc, el);
+		ANKI_TEST_EXPECT_EQ(el.m_dirtyInstances.getSize(), 0);
+
+		// Update twice, upload once
+		GpuSceneInstance data;
+		zeroMemory(data);
+		data.m_lodCount = 2;
+		data.m_drawBucket = 123;
+		instances.updateInstance(b, data);
+		instances.updateInstance(b, data);
+		instances.flush(frameAlloc, el);
+		ANKI_TEST_EXPECT_EQ(el.m_dirtyInstances.getSize(), 1);
+		ANKI_TEST_EXPECT_EQ(el.m_dirtyInstances[0], b);
+		ANKI_TEST_EXPECT_EQ(el.m_instances[b].m_lodCount, 2);
+		ANKI_TEST_EXPECT_EQ(el.m_instances[b].m_drawBucket, MAX_LOD_COUNT);
+
+		// Delete and re-use
+		instances.deleteInstance(a);
+		instances.flush(frameAlloc, el);
+		ANKI_TEST_EXPECT_EQ(el.m_instances[a].m_drawBucket, GPU_SCENE_INVALID_DRAW_BUCKET);
+
+		const U32 d = instances.newInstance(20);
+		ANKI_TEST_EXPECT_EQ(d, a);
+		ANKI_TEST_EXPECT_EQ(instances.getInstanceCount(), 3);
+	}
+
+	// Benchmark. Update a fraction of the instances every frame
+	{
+		GpuSceneInstances instances(alloc);
+
+		const U32 INSTANCE_COUNT = 50000;
+		const U32 BUCKET_COUNT = 64;
+		const U32 FRAME_COUNT = 100;
+		const U32 UPDATES_PER_FRAME = INSTANCE_COUNT / 10;
+
+		for(U32 i = 0; i < INSTANCE_COUNT; ++i)
+		{
+			instances.newInstance(i % BUCKET_COUNT);
+		}
+
+		GpuSceneInstance data;
+		zeroMemory(data);
+		data.m_lodCount = 1;
+
+		GpuSceneQueueElement el;
+		instances.flush(frameAlloc, el);
+		frameAlloc.getMemoryPool().reset();
+
+		HighRezTimer timer;
+		timer.start();
+		U32 uploaded = 0;
+		for(U32 frame = 0; frame < FRAME_COUNT; ++frame)
+		{
+			for(U32 i = 0; i < UPDATES_PER_FRAME; ++i)
+			{
+				data.m_aabbMin = Vec3(F32(frame));
+				instances.updateInstance((i * 7 + frame * 13) % INSTANCE_COUNT, data);
+			}
+
+			instances.flush(frameAlloc, el);
+			uploaded += el.m_dirtyInstances.getSize();
+			frameAlloc.getMemoryPool().reset();
+		}
+		timer.stop();
+
+		ANKI_TEST_EXPECT_LEQ(uploaded, FRAME_COUNT * UPDATES_PER_FRAME);
+		ANKI_TEST_LOGI("GPU scene: %u instances, %u updates/frame. %f ms/frame. Uploaded %f%% of the instances",
+					   INSTANCE_COUNT, UPDATES_PER_FRAME, timer.getElapsedTime() * 1000.0 / F64(FRAME_COUNT),
+					   F64(uploaded) / F64(FRAME_COUNT * INSTANCE_COUNT) * 100.0);
+	}
+}
+
+} // end namespace anki
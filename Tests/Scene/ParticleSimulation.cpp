@@ -0,0 +1,189 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/ParticleSimulation.h>
+#include <AnKi/Resource/ParticleEmitterResource.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+
+namespace anki {
+
+namespace {
+
+/// A particle stored like the particles of the ParticleEmitterComponent used to be. Used as a reference.
+class NaiveParticle
+{
+public:
+	Second m_timeOfBirth;
+	Second m_timeOfDeath;
+	F32 m_initialSize;
+	F32 m_finalSize;
+	F32 m_initialAlpha;
+	F32 m_finalAlpha;
+	Vec3 m_position;
+	Vec3 m_velocity;
+	Vec3 m_acceleration;
+};
+
+} // end namespace
+
+ANKI_TEST(Scene, ParticleSimulation)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	ParticleEmitterProperties props;
+	props.m_particle.m_minLife = props.m_particle.m_maxLife = 1.0;
+	props.m_particle.m_minGravity = props.m_particle.m_maxGravity = Vec3(0.0f, -10.0f, 0.0f);
+	props.m_particle.m_minInitialSize = props.m_particle.m_maxInitialSize = 1.0f;
+	props.m_particle.m_minFinalSize = props.m_particle.m_maxFinalSize = 3.0f;
+	props.m_particle.m_minInitialAlpha = props.m_particle.m_maxInitialAlpha = 1.0f;
+	props.m_particle.m_minFinalAlpha = props.m_particle.m_maxFinalAlpha = 0.0f;
+
+	// Basic. Use a count that is not a multiple of 4 to test the SIMD and the scalar paths
+	{
+		constexpr U32 PARTICLE_COUNT = 10;
+		ParticleSimulation sim;
+		sim.init(alloc, PARTICLE_COUNT);
+
+		const Transform emitterTrf(Vec4(1.0f, 2.0f, 3.0f, 0.0f), Mat3x4::getIdentity(), 1.0f);
+		sim.emit(props, emitterTrf, PARTICLE_COUNT);
+		sim.emit(props, emitterTrf, PARTICLE_COUNT);
+		ANKI_TEST_EXPECT_EQ(sim.getAliveParticleCount(), PARTICLE_COUNT);
+
+		Array<F32, PARTICLE_COUNT * ParticleSimulation::VERTEX_FLOAT_COUNT> verts;
+		Vec3 aabbMin, aabbMax;
+		F32 maxParticleSize;
+		sim.simulate(0.5f, &verts[0], aabbMin, aabbMax, maxParticleSize, nullptr);
+		ANKI_TEST_EXPECT_EQ(sim.getAliveParticleCount(), PARTICLE_COUNT);
+		ANKI_TEST_EXPECT_NEAR(aabbMin.y(), -0.5f, EPSILON);
+		ANKI_TEST_EXPECT_NEAR(aabbMax.y(), -0.5f, EPSILON);
+		ANKI_TEST_EXPECT_NEAR(aabbMax.z(), 3.0f, EPSILON);
+		ANKI_TEST_EXPECT_NEAR(maxParticleSize, 2.0f, EPSILON);
+		for(U32 i = 0; i < PARTICLE_COUNT; ++i)
+		{
+			const F32* vert = &verts[i * ParticleSimulation::VERTEX_FLOAT_COUNT];
+			ANKI_TEST_EXPECT_NEAR(vert[1], -0.5f, EPSILON);
+			ANKI_TEST_EXPECT_NEAR(vert[3], 2.0f, EPSILON);
+			ANKI_TEST_EXPECT_NEAR(vert[4], 0.5f, EPSILON);
+		}
+
+		// Past their life time
+		sim.simulate(0.6f, &verts[0], aabbMin, aabbMax, maxParticleSize, nullptr);
+		ANKI_TEST_EXPECT_EQ(sim.getAliveParticleCount(), 0);
+	}
+
+	// Benchmark. Simulate 1M particles stored like the ParticleEmitterComponent used to store them (array of
+	// structures) and then with the ParticleSimulation serially and in parallel
+	{
+		constexpr U32 PARTICLE_COUNT = 1000 * 1000;
+		constexpr U32 ITERATIONS = 10;
+		constexpr F32 DT = 1.0f / 60.0f;
+		HighRezTimer timer;
+
+		// Long lived so the work is the same for all
+		props.m_particle.m_minLife = 100.0;
+		props.m_particle.m_maxLife = 200.0;
+
+		DynamicArrayAuto<F32> verts(alloc, PARTICLE_COUNT * ParticleSimulation::VERTEX_FLOAT_COUNT);
+
+		// Naive
+		DynamicArrayAuto<NaiveParticle> naiveParticles(alloc, PARTICLE_COUNT);
+		for(NaiveParticle& particle : naiveParticles)
+		{
+			particle.m_timeOfBirth = 0.0;
+			particle.m_timeOfDeath = getRandomRange(props.m_particle.m_minLife, props.m_particle.m_maxLife);
+			particle.m_initialSize = props.m_particle.m_minInitialSize;
+			particle.m_finalSize = props.m_particle.m_minFinalSize;
+			particle.m_initialAlpha = props.m_particle.m_minInitialAlpha;
+			particle.m_finalAlpha = props.m_particle.m_minFinalAlpha;
+			particle.m_position = Vec3(0.0f);
+			particle.m_velocity = Vec3(0.0f);
+			particle.m_acceleration = props.m_particle.m_minGravity;
+		}
+
+		timer.start();
+		Second crntTime = 0.0;
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			crntTime += DT;
+			Vec3 aabbMin(MAX_F32);
+			Vec3 aabbMax(MIN_F32);
+			F32 maxParticleSize = MIN_F32;
+			F32* vert = &verts[0];
+			for(NaiveParticle& particle : naiveParticles)
+			{
+				if(particle.m_timeOfDeath < crntTime)
+				{
+					continue;
+				}
+
+				const F32 lifeFactor = F32((crntTime - particle.m_timeOfBirth)
+										   / (particle.m_timeOfDeath - particle.m_timeOfBirth));
+				const F32 size = mix(particle.m_initialSize, particle.m_finalSize, lifeFactor);
+				const F32 alpha = mix(particle.m_initialAlpha, particle.m_finalAlpha, lifeFactor);
+
+				particle.m_position += particle.m_acceleration * (DT * DT) + particle.m_velocity * DT;
+				particle.m_velocity += particle.m_acceleration * DT;
+
+				aabbMin = aabbMin.min(particle.m_position);
+				aabbMax = aabbMax.max(particle.m_position);
+				maxParticleSize = max(maxParticleSize, size);
+
+				vert[0] = particle.m_position.x();
+				vert[1] = particle.m_position.y();
+				vert[2] = particle.m_position.z();
+				vert[3] = size;
+				vert[4] = clamp(alpha, 0.0f, 1.0f);
+				vert += ParticleSimulation::VERTEX_FLOAT_COUNT;
+			}
+
+			ANKI_TEST_EXPECT_EQ(aabbMin.y() <= aabbMax.y() && maxParticleSize > 0.0f, true);
+		}
+		timer.stop();
+		const Second naiveTime = timer.getElapsedTime();
+
+		// Serial
+		ParticleSimulation sim;
+		sim.init(alloc, PARTICLE_COUNT);
+		sim.emit(props, Transform::getIdentity(), PARTICLE_COUNT);
+
+		Vec3 serialAabbMin, serialAabbMax;
+		F32 maxParticleSize;
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			sim.simulate(DT, &verts[0], serialAabbMin, serialAabbMax, maxParticleSize, nullptr);
+		}
+		timer.stop();
+		const Second serialTime = timer.getElapsedTime();
+		ANKI_TEST_EXPECT_EQ(sim.getAliveParticleCount(), PARTICLE_COUNT);
+
+		// Parallel. Start from the same state
+		const U32 threadCount = min(getCpuCoresCount(), ThreadHive::MAX_THREADS);
+		ThreadHive hive(threadCount, alloc);
+		sim.init(alloc, PARTICLE_COUNT);
+		sim.emit(props, Transform::getIdentity(), PARTICLE_COUNT);
+
+		Vec3 parallelAabbMin, parallelAabbMax;
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			sim.simulate(DT, &verts[0], parallelAabbMin, parallelAabbMax, maxParticleSize, &hive);
+			hive.waitAllTasks();
+		}
+		timer.stop();
+		const Second parallelTime = timer.getElapsedTime();
+		ANKI_TEST_EXPECT_EQ(sim.getAliveParticleCount(), PARTICLE_COUNT);
+		ANKI_TEST_EXPECT_EQ(serialAabbMin == parallelAabbMin && serialAabbMax == parallelAabbMax, true);
+
+		ANKI_TEST_LOGI("Particle simulation bench (%u particles): array of structures %fsec, SoA %fsec, SoA & %u "
+					   "threads %fsec",
+					   PARTICLE_COUNT, naiveTime, serialTime, threadCount, parallelTime);
+	}
+}
+
+} // end namespace anki
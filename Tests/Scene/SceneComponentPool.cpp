@@ -0,0 +1,331 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/SceneComponentPool.h>
+#include <AnKi/Scene/Components/SceneComponent.h>
+#include <AnKi/Math.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+
+namespace anki {
+
+namespace {
+
+class TestComponentBase : public SceneComponent
+{
+public:
+	Vec4 m_position = Vec4(0.0f);
+	Vec4 m_velocity = Vec4(1.0f);
+
+	TestComponentBase(U8 classId)
+		: SceneComponent(nullptr, classId)
+	{
+	}
+
+	virtual void simulate(F32 dt) = 0;
+};
+
+class TestMoveComponent : public TestComponentBase
+{
+	ANKI_SCENE_COMPONENT(TestMoveComponent)
+
+public:
+	TestMoveComponent(SceneNode* node)
+		: TestComponentBase(getStaticClassId())
+	{
+	}
+
+	void simulate(F32 dt) override
+	{
+		m_position += m_velocity * dt;
+	}
+};
+
+ANKI_SCENE_COMPONENT_STATICS(TestMoveComponent)
+
+class TestSpatialComponent : public TestComponentBase
+{
+	ANKI_SCENE_COMPONENT(TestSpatialComponent)
+
+public:
+	TestSpatialComponent(SceneNode* node)
+		: TestComponentBase(getStaticClassId())
+	{
+	}
+
+	void simulate(F32 dt) override
+	{
+		m_velocity *= 1.0f - dt;
+	}
+};
+
+ANKI_SCENE_COMPONENT_STATICS(TestSpatialComponent)
+
+} // end namespace
+
+ANKI_TEST(Scene, SceneComponentPool)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// Basic
+	{
+		SceneComponentPool pool;
+		pool.init(alloc, SceneComponent::findClassRtti(TestMoveComponent::getStaticClassId()));
+
+		Array<TestMoveComponent*, SceneComponentPool::COMPONENTS_PER_CHUNK + 10> comps;
+		for(TestMoveComponent*& comp : comps)
+		{
+			U32 poolIndex;
+			comp = ::new(pool.allocate(poolIndex)) TestMoveComponent(nullptr);
+			comp->m_position.x() = F32(poolIndex);
+			ANKI_TEST_EXPECT_EQ(&pool.getComponent(poolIndex) == comp, true);
+		}
+
+		ANKI_TEST_EXPECT_EQ(pool.getComponentCount(), comps.getSize());
+		ANKI_TEST_EXPECT_EQ(pool.getChunkCount(), 2);
+
+		// Free one and re-allocate. It should re-use the slot
+		const U32 poolIndex = U32(comps[3]->m_position.x());
+		comps[3]->~TestMoveComponent();
+		pool.free(comps[3], poolIndex);
+
+		U32 newPoolIndex;
+		void* mem = pool.allocate(newPoolIndex);
+		ANKI_TEST_EXPECT_EQ(newPoolIndex, poolIndex);
+		ANKI_TEST_EXPECT_EQ(mem == comps[3], true);
+		comps[3] = ::new(mem) TestMoveComponent(nullptr);
+		comps[3]->m_position.x() = F32(newPoolIndex);
+
+		// Iterate
+		U32 count = 0;
+		for(U32 chunk = 0; chunk < pool.getChunkCount(); ++chunk)
+		{
+			pool.iterateChunk(chunk, [&](SceneComponent& comp) {
+				ANKI_TEST_EXPECT_EQ(comp.getClassId(), TestMoveComponent::getStaticClassId());
+				++count;
+			});
+		}
+		ANKI_TEST_EXPECT_EQ(count, comps.getSize());
+
+		// Put some to sleep
+		ANKI_TEST_EXPECT_EQ(pool.getActiveComponentCount(), comps.getSize());
+		for(U32 i = 0; i < comps.getSize(); i += 2)
+		{
+			ANKI_TEST_EXPECT_EQ(pool.setComponentActive(U32(comps[i]->m_position.x()), false), true);
+		}
+		ANKI_TEST_EXPECT_EQ(pool.setComponentActive(U32(comps[0]->m_position.x()), false), false);
+		ANKI_TEST_EXPECT_EQ(pool.getActiveComponentCount(), comps.getSize() / 2);
+
+		count = 0;
+		for(U32 chunk = 0; chunk < pool.getChunkCount(); ++chunk)
+		{
+			pool.iterateActiveChunk(chunk, [&](SceneComponent& comp) {
+				ANKI_TEST_EXPECT_EQ(U32(static_cast<TestMoveComponent&>(comp).m_position.x()) % 2, 1);
+				++count;
+			});
+		}
+		ANKI_TEST_EXPECT_EQ(count, comps.getSize() / 2);
+
+		// Wake up one
+		ANKI_TEST_EXPECT_EQ(pool.setComponentActive(U32(comps[0]->m_position.x()), true), true);
+		ANKI_TEST_EXPECT_EQ(pool.getActiveComponentCount(), comps.getSize() / 2 + 1);
+
+		for(TestMoveComponent* comp : comps)
+		{
+			const U32 idx = U32(comp->m_position.x());
+			comp->~TestMoveComponent();
+			pool.free(comp, idx);
+		}
+
+		ANKI_TEST_EXPECT_EQ(pool.getComponentCount(), 0);
+	}
+
+	// Toggle the components from many threads. The threads share the active mask words of the chunks
+	{
+		SceneComponentPool pool;
+		pool.init(alloc, SceneComponent::findClassRtti(TestMoveComponent::getStaticClassId()));
+
+		constexpr U32 THREAD_COUNT = 4;
+		constexpr U32 COMPONENTS_PER_THREAD = SceneComponentPool::COMPONENTS_PER_CHUNK / 2;
+		Array<TestMoveComponent*, THREAD_COUNT * COMPONENTS_PER_THREAD> comps;
+		Array<U32, THREAD_COUNT * COMPONENTS_PER_THREAD> poolIndices;
+		for(U32 i = 0; i < comps.getSize(); ++i)
+		{
+			comps[i] = ::new(pool.allocate(poolIndices[i])) TestMoveComponent(nullptr);
+		}
+
+		class Ctx
+		{
+		public:
+			SceneComponentPool* m_pool;
+			const U32* m_poolIndices;
+			Atomic<U32> m_threadIdx = {0};
+			Atomic<U32> m_stateChanges = {0};
+		} ctx;
+		ctx.m_pool = &pool;
+		ctx.m_poolIndices = &poolIndices[0];
+
+		ThreadHive hive(THREAD_COUNT, alloc);
+		Array<ThreadHiveTask, THREAD_COUNT> tasks;
+		for(ThreadHiveTask& task : tasks)
+		{
+			task = ANKI_THREAD_HIVE_TASK(
+				{
+					// Every thread owns the slots that are THREAD_COUNT apart. In the end the odd ones stay inactive
+					const U32 firstComp = self->m_threadIdx.fetchAdd(1);
+					for(U32 it = 0; it < 1000; ++it)
+					{
+						for(U32 i = firstComp; i < THREAD_COUNT * COMPONENTS_PER_THREAD; i += THREAD_COUNT)
+						{
+							const Bool active = (it & 1) == 0 || (i & 1) == 0;
+							if(self->m_pool->setComponentActive(self->m_poolIndices[i], active))
+							{
+								self->m_stateChanges.fetchAdd(1);
+							}
+						}
+					}
+				},
+				&ctx, nullptr, nullptr);
+		}
+
+		hive.submitTasks(&tasks[0], THREAD_COUNT);
+		hive.waitAllTasks();
+
+		ANKI_TEST_EXPECT_EQ(pool.getActiveComponentCount(), comps.getSize() / 2);
+		ANKI_TEST_EXPECT_EQ(ctx.m_stateChanges.load(), 999 * comps.getSize() / 2);
+		for(U32 i = 0; i < comps.getSize(); ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(pool.setComponentActive(poolIndices[i], (i & 1) == 0), false);
+			comps[i]->~TestMoveComponent();
+			pool.free(comps[i], poolIndices[i]);
+		}
+	}
+
+	// Benchmark. Update the 2 components of 100K synthetic nodes. First with the components allocated per node and
+	// updated per node and then with the components pooled and updated per class
+	{
+		constexpr U32 NODE_COUNT = 100 * 1000;
+		constexpr U32 ITERATIONS = 10;
+		constexpr F32 DT = 1.0f / 60.0f;
+		HighRezTimer timer;
+
+		// Per node
+		DynamicArrayAuto<TestComponentBase*> nodeComponents(alloc, NODE_COUNT * 2);
+		for(U32 i = 0; i < NODE_COUNT; ++i)
+		{
+			nodeComponents[i * 2 + 0] = alloc.newInstance<TestMoveComponent>(nullptr);
+			nodeComponents[i * 2 + 1] = alloc.newInstance<TestSpatialComponent>(nullptr);
+		}
+
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			for(TestComponentBase* comp : nodeComponents)
+			{
+				comp->simulate(DT);
+			}
+		}
+		timer.stop();
+		const Second perNodeTime = timer.getElapsedTime();
+
+		for(TestComponentBase* comp : nodeComponents)
+		{
+			alloc.deleteInstance(comp);
+		}
+
+		// Pooled
+		SceneComponentPool movePool;
+		movePool.init(alloc, SceneComponent::findClassRtti(TestMoveComponent::getStaticClassId()));
+		SceneComponentPool spatialPool;
+		spatialPool.init(alloc, SceneComponent::findClassRtti(TestSpatialComponent::getStaticClassId()));
+		DynamicArrayAuto<U32> poolIndices(alloc, NODE_COUNT * 2);
+		for(U32 i = 0; i < NODE_COUNT; ++i)
+		{
+			nodeComponents[i * 2 + 0] = ::new(movePool.allocate(poolIndices[i * 2 + 0])) TestMoveComponent(nullptr);
+			nodeComponents[i * 2 + 1] =
+				::new(spatialPool.allocate(poolIndices[i * 2 + 1])) TestSpatialComponent(nullptr);
+		}
+
+		auto updatePool = [](SceneComponentPool& pool, U32 firstChunk, U32 chunkCount) {
+			for(U32 chunk = firstChunk; chunk < firstChunk + chunkCount; ++chunk)
+			{
+				pool.iterateChunk(chunk, [](SceneComponent& comp) {
+					static_cast<TestComponentBase&>(comp).simulate(DT);
+				});
+			}
+		};
+
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			updatePool(movePool, 0, movePool.getChunkCount());
+			updatePool(spatialPool, 0, spatialPool.getChunkCount());
+		}
+		timer.stop();
+		const Second pooledTime = timer.getElapsedTime();
+
+		// Pooled and in parallel
+		const U32 threadCount = min(getCpuCoresCount(), ThreadHive::MAX_THREADS);
+		ThreadHive hive(threadCount, alloc);
+
+		class Ctx
+		{
+		public:
+			SceneComponentPool* m_pool;
+			Atomic<U32> m_crntChunk;
+			decltype(updatePool)* m_updatePool;
+		} ctx;
+		ctx.m_updatePool = &updatePool;
+
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			for(SceneComponentPool* pool : {&movePool, &spatialPool})
+			{
+				ctx.m_pool = pool;
+				ctx.m_crntChunk.setNonAtomically(0);
+
+				Array<ThreadHiveTask, ThreadHive::MAX_THREADS> tasks;
+				for(U32 i = 0; i < threadCount; ++i)
+				{
+					tasks[i] = ANKI_THREAD_HIVE_TASK(
+						{
+							U32 chunk;
+							while((chunk = self->m_crntChunk.fetchAdd(1)) < self->m_pool->getChunkCount())
+							{
+								(*self->m_updatePool)(*self->m_pool, chunk, 1);
+							}
+						},
+						&ctx, nullptr, nullptr);
+				}
+
+				hive.submitTasks(&tasks[0], threadCount);
+				hive.waitAllTasks();
+			}
+		}
+		timer.stop();
+		const Second parallelTime = timer.getElapsedTime();
+
+		for(U32 i = 0; i < NODE_COUNT; ++i)
+		{
+			TestComponentBase* move = nodeComponents[i * 2 + 0];
+			TestComponentBase* spatial = nodeComponents[i * 2 + 1];
+			ANKI_TEST_EXPECT_EQ(move->m_position.x(), nodeComponents[0]->m_position.x());
+
+			move->~TestComponentBase();
+			spatial->~TestComponentBase();
+			movePool.free(move, poolIndices[i * 2 + 0]);
+			spatialPool.free(spatial, poolIndices[i * 2 + 1]);
+		}
+
+		ANKI_TEST_LOGI("Scene component update bench (%u nodes): per node %fsec, pooled %fsec, pooled & %u threads "
+					   "%fsec",
+					   NODE_COUNT, perNodeTime, pooledTime, threadCount, parallelTime);
+	}
+}
+
+} // end namespace anki
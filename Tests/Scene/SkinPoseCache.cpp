@@ -0,0 +1,63 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/SkinPoseCache.h>
+
+namespace anki {
+
+ANKI_TEST(Scene, SkinPoseCache)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	SkinPoseCache cache(alloc);
+
+	constexpr U32 KEY_COUNT = 100;
+	const Array<Mat4, 2> boneTrfs = {Mat4::getIdentity(), Mat4::getIdentity()};
+	const I32 dummy = 0;
+
+	auto makeKey = [&](U32 i) {
+		SkinPoseKey key;
+		key.m_skeleton = &dummy;
+		key.m_trackCount = 1;
+		key.m_tracks[0].m_animation = &boneTrfs;
+		key.m_tracks[0].m_time = Second(i) / 10.0;
+		return key;
+	};
+
+	// 1st time the caller computes them. Use enough keys to grow the cache
+	for(U32 i = 0; i < KEY_COUNT; ++i)
+	{
+		SkinPose pose;
+		Bool storePose;
+		ANKI_TEST_EXPECT_EQ(cache.tryGetPose(makeKey(i), pose, storePose), false);
+		ANKI_TEST_EXPECT_EQ(storePose, true);
+
+		// Someone else asks for it before it's stored
+		ANKI_TEST_EXPECT_EQ(cache.tryGetPose(makeKey(i), pose, storePose), false);
+		ANKI_TEST_EXPECT_EQ(storePose, false);
+
+		pose.m_boneTransforms = boneTrfs;
+		pose.m_boneBoundingVolume = Aabb(Vec3(-F32(i)), Vec3(F32(i)));
+		cache.storePose(makeKey(i), pose);
+	}
+
+	for(U32 i = 0; i < KEY_COUNT; ++i)
+	{
+		SkinPose pose;
+		Bool storePose;
+		ANKI_TEST_EXPECT_EQ(cache.tryGetPose(makeKey(i), pose, storePose), true);
+		ANKI_TEST_EXPECT_EQ(pose.m_boneTransforms.getSize(), boneTrfs.getSize());
+		ANKI_TEST_EXPECT_EQ(pose.m_boneBoundingVolume.getMax().x(), F32(i));
+	}
+
+	// Next frame they are gone
+	cache.newFrame();
+	SkinPose pose;
+	Bool storePose;
+	ANKI_TEST_EXPECT_EQ(cache.tryGetPose(makeKey(0), pose, storePose), false);
+	ANKI_TEST_EXPECT_EQ(storePose, true);
+}
+
+} // end namespace anki
@@ -0,0 +1,242 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Scene/TransformHierarchy.h>
+#include <AnKi/Util/ThreadHive.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/System.h>
+
+namespace anki {
+
+namespace {
+
+/// A node of a pointer based hierarchy. Used as a reference.
+class NaiveNode
+{
+public:
+	Transform m_local = Transform::getIdentity();
+	Transform m_world = Transform::getIdentity();
+	NaiveNode* m_firstChild = nullptr;
+	NaiveNode* m_nextSibling = nullptr;
+
+	void update(const Transform* parentWorld)
+	{
+		m_world = (parentWorld) ? parentWorld->combineTransformations(m_local) : m_local;
+		for(NaiveNode* child = m_firstChild; child; child = child->m_nextSibling)
+		{
+			child->update(&m_world);
+		}
+	}
+};
+
+Transform randomTransform()
+{
+	const Vec3 origin(getRandomRange(-1.0f, 1.0f), getRandomRange(-1.0f, 1.0f), getRandomRange(-1.0f, 1.0f));
+	return Transform(origin.xyz0(), Mat3x4::getIdentity(), 1.0f);
+}
+
+} // end namespace
+
+ANKI_TEST(Scene, TransformHierarchy)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// Basic
+	{
+		TransformHierarchy transforms(alloc);
+
+		const U32 root = transforms.newTransform();
+		const U32 child = transforms.newTransform();
+		const U32 grandChild = transforms.newTransform();
+		transforms.setParent(child, root);
+		transforms.setParent(grandChild, child);
+		ANKI_TEST_EXPECT_EQ(transforms.getDepthCount(), 3);
+
+		transforms.getLocalTransformForUpdate(root).setOrigin(Vec4(1.0f, 0.0f, 0.0f, 0.0f));
+		transforms.getLocalTransformForUpdate(child).setOrigin(Vec4(0.0f, 2.0f, 0.0f, 0.0f));
+		transforms.getLocalTransformForUpdate(grandChild).setOrigin(Vec4(0.0f, 0.0f, 3.0f, 0.0f));
+		transforms.update(nullptr);
+
+		ANKI_TEST_EXPECT_EQ(transforms.getWorldTransform(grandChild).getOrigin() == Vec4(1.0f, 2.0f, 3.0f, 0.0f),
+							true);
+		ANKI_TEST_EXPECT_EQ(transforms.getUpdatedThisFrame(grandChild), true);
+
+		// Nothing changed
+		transforms.update(nullptr);
+		ANKI_TEST_EXPECT_EQ(transforms.getUpdatedThisFrame(root), false);
+		ANKI_TEST_EXPECT_EQ(transforms.getUpdatedThisFrame(grandChild), false);
+		ANKI_TEST_EXPECT_EQ(transforms.getPreviousWorldTransform(grandChild).getOrigin()
+								== Vec4(1.0f, 2.0f, 3.0f, 0.0f),
+							true);
+
+		// Move the root only. The children should follow
+		transforms.getLocalTransformForUpdate(root).setOrigin(Vec4(2.0f, 0.0f, 0.0f, 0.0f));
+		transforms.update(nullptr);
+		ANKI_TEST_EXPECT_EQ(transforms.getUpdatedThisFrame(grandChild), true);
+		ANKI_TEST_EXPECT_EQ(transforms.getWorldTransform(grandChild).getOrigin() == Vec4(2.0f, 2.0f, 3.0f, 0.0f),
+							true);
+
+		// Detach
+		transforms.setParent(child, MAX_U32);
+		transforms.setParent(grandChild, child);
+		transforms.update(nullptr);
+		ANKI_TEST_EXPECT_EQ(transforms.getWorldTransform(grandChild).getOrigin() == Vec4(0.0f, 2.0f, 3.0f, 0.0f),
+							true);
+
+		transforms.deleteTransform(grandChild);
+		transforms.deleteTransform(child);
+		transforms.deleteTransform(root);
+		ANKI_TEST_EXPECT_EQ(transforms.getTransformCount(), 0);
+	}
+
+	// Benchmark. A wide forest (a few levels with many transforms each) and some deep chains. Compare against a pointer
+	// based hierarchy that is updated recursively
+	{
+		constexpr U32 ROOT_COUNT = 4 * 1024;
+		constexpr U32 CHILDREN_PER_NODE = 4;
+		constexpr U32 WIDE_DEPTH = 3;
+		constexpr U32 CHAIN_COUNT = 64;
+		constexpr U32 CHAIN_DEPTH = 128;
+		constexpr U32 ITERATIONS = 10;
+		HighRezTimer timer;
+
+		TransformHierarchy transforms(alloc);
+		DynamicArrayAuto<NaiveNode*> naiveNodes(alloc);
+		DynamicArrayAuto<U32> transformIndices(alloc);
+		DynamicArrayAuto<NaiveNode*> naiveRoots(alloc);
+		DynamicArrayAuto<U32> rootTransforms(alloc);
+
+		auto newNode = [&](U32 parent) -> U32 {
+			const U32 idx = naiveNodes.getSize();
+			NaiveNode* node = alloc.newInstance<NaiveNode>();
+			node->m_local = randomTransform();
+			naiveNodes.emplaceBack(node);
+
+			const U32 transformIdx = transforms.newTransform();
+			transforms.getLocalTransformForUpdate(transformIdx) = node->m_local;
+			transformIndices.emplaceBack(transformIdx);
+
+			if(parent != MAX_U32)
+			{
+				NaiveNode* parentNode = naiveNodes[parent];
+				node->m_nextSibling = parentNode->m_firstChild;
+				parentNode->m_firstChild = node;
+				transforms.setParent(transformIdx, transformIndices[parent]);
+			}
+			else
+			{
+				naiveRoots.emplaceBack(node);
+				rootTransforms.emplaceBack(transformIdx);
+			}
+
+			return idx;
+		};
+
+		// Wide
+		for(U32 r = 0; r < ROOT_COUNT; ++r)
+		{
+			U32 levelBegin = newNode(MAX_U32);
+			U32 levelEnd = levelBegin + 1;
+			for(U32 d = 1; d < WIDE_DEPTH; ++d)
+			{
+				const U32 nextLevelBegin = naiveNodes.getSize();
+				for(U32 parent = levelBegin; parent < levelEnd; ++parent)
+				{
+					for(U32 c = 0; c < CHILDREN_PER_NODE; ++c)
+					{
+						newNode(parent);
+					}
+				}
+				levelBegin = nextLevelBegin;
+				levelEnd = naiveNodes.getSize();
+			}
+		}
+
+		// Deep
+		for(U32 c = 0; c < CHAIN_COUNT; ++c)
+		{
+			U32 parent = MAX_U32;
+			for(U32 d = 0; d < CHAIN_DEPTH; ++d)
+			{
+				parent = newNode(parent);
+			}
+		}
+
+		// Naive
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			for(NaiveNode* root : naiveRoots)
+			{
+				root->m_local.getOrigin().x() += 0.1f;
+				root->update(nullptr);
+			}
+		}
+		timer.stop();
+		const Second naiveTime = timer.getElapsedTime();
+
+		// Serial. The roots move every iteration so all transforms need update
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			for(U32 root : rootTransforms)
+			{
+				transforms.getLocalTransformForUpdate(root).getOrigin().x() += 0.1f;
+			}
+			transforms.update(nullptr);
+		}
+		timer.stop();
+		const Second serialTime = timer.getElapsedTime();
+
+		// Parallel
+		const U32 threadCount = min(getCpuCoresCount(), ThreadHive::MAX_THREADS);
+		ThreadHive hive(threadCount, alloc);
+
+		timer.start();
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			for(U32 root : rootTransforms)
+			{
+				transforms.getLocalTransformForUpdate(root).getOrigin().x() += 0.1f;
+			}
+			transforms.update(&hive);
+		}
+		timer.stop();
+		const Second parallelTime = timer.getElapsedTime();
+
+		// Bring the naive to the same state and compare
+		for(U32 it = 0; it < ITERATIONS; ++it)
+		{
+			for(NaiveNode* root : naiveRoots)
+			{
+				root->m_local.getOrigin().x() += 0.1f;
+				root->update(nullptr);
+			}
+		}
+
+		U32 mismatches = 0;
+		for(U32 i = 0; i < naiveNodes.getSize(); ++i)
+		{
+			const Vec4 diff =
+				naiveNodes[i]->m_world.getOrigin() - transforms.getWorldTransform(transformIndices[i]).getOrigin();
+			mismatches += (diff.getLength() > 0.001f) ? 1 : 0;
+		}
+		ANKI_TEST_EXPECT_EQ(mismatches, 0);
+
+		ANKI_TEST_LOGI("Transform hierarchy bench (%u transforms, %u levels): naive %fsec, serial %fsec, %u threads "
+					   "%fsec",
+					   transforms.getTransformCount(), transforms.getDepthCount(), naiveTime, serialTime, threadCount,
+					   parallelTime);
+
+		for(U32 i = 0; i < naiveNodes.getSize(); ++i)
+		{
+			transforms.deleteTransform(transformIndices[i]);
+			alloc.deleteInstance(naiveNodes[i]);
+		}
+	}
+}
+
+} // end namespace anki
@@ -110,3 +110,103 @@ print(vec:getX(), vec:getY(), vec:getZ())
 
 	ANKI_TEST_EXPECT_NO_ERR(env2.evalString(script2));
 }
+
+ANKI_TEST(Script, LuaBinderValueTypes)
+{
+	ScriptManager sm;
+	ANKI_TEST_EXPECT_NO_ERR(sm.init(allocAligned, nullptr));
+
+	Vec3 v3(0.0f);
+	Vec4 v4(0.0f);
+	sm.exposeVariable("v3", &v3);
+	sm.exposeVariable("v4", &v4);
+
+	static const char* script = R"(
+a = Vec3.new(1, 2, 3)
+b = Vec3.new(4, 5, 6)
+
+-- The "out" variants write to the last argument and return it
+r = a:addOut(b, v3)
+if r:getX() ~= 5 or r:getY() ~= 7 or r:getZ() ~= 9 then
+	error("addOut")
+end
+
+-- The "out" argument can be one of the operands
+a:mulOut(b, a)
+if a:getX() ~= 4 or a:getY() ~= 10 or a:getZ() ~= 18 then
+	error("mulOut")
+end
+
+-- The "unpack" variants return numbers
+x, y, z = b:subUnpack(Vec3.new(1, 1, 1))
+if x ~= 3 or y ~= 4 or z ~= 5 then
+	error("subUnpack")
+end
+
+x, y, z, w = Vec4.new(1, 2, 3, 4):unpack()
+if x ~= 1 or y ~= 2 or z ~= 3 or w ~= 4 then
+	error("unpack")
+end
+
+Vec4.new(0, 3, 0, 4):getNormalizedOut(v4)
+)";
+
+	ANKI_TEST_EXPECT_NO_ERR(sm.evalString(script));
+	ANKI_TEST_EXPECT_EQ(v3, Vec3(5.0f, 7.0f, 9.0f));
+	ANKI_TEST_EXPECT_EQ(v4, Vec4(0.0f, 3.0f, 0.0f, 4.0f).getNormalized());
+
+	// Wrong type of "out" argument
+	ANKI_TEST_EXPECT_ERR(sm.evalString("Vec3.new(1, 2, 3):addOut(Vec3.new(1, 2, 3), v4)"), Error::USER_DATA);
+}
+
+ANKI_TEST(Script, LuaBinderQueryBatchIndex)
+{
+	ScriptManager sm;
+	ANKI_TEST_EXPECT_NO_ERR(sm.init(allocAligned, nullptr));
+
+	static const char* script = R"(
+batch = PhysicsWorldQueryBatch.new()
+batch:addRay(Vec3.new(0, 0, 0), Vec3.new(0, -1, 0))
+if batch:isHit(0) then
+	error("isHit")
+end
+)";
+
+	ANKI_TEST_EXPECT_NO_ERR(sm.evalString(script));
+
+	// Indices past the query count are errors and not asserts
+	ANKI_TEST_EXPECT_ERR(sm.evalString("batch:isHit(1)"), Error::USER_DATA);
+	ANKI_TEST_EXPECT_ERR(sm.evalString("batch:getHitPosition(1)"), Error::USER_DATA);
+	ANKI_TEST_EXPECT_ERR(sm.evalString("batch:getHitNormal(64)"), Error::USER_DATA);
+	ANKI_TEST_EXPECT_ERR(sm.evalString("batch:getHitFraction(1000)"), Error::USER_DATA);
+}
+
+ANKI_TEST(Script, LuaBinderBlockCache)
+{
+	ScriptManager sm;
+	ANKI_TEST_EXPECT_NO_ERR(sm.init(allocAligned, nullptr));
+
+	// The parser and the tables grow their small arrays with realloc. Free them and then fill the cache's classes with
+	// new objects to catch grown blocks that are smaller than the class they are cached in
+	static const char* script = R"(
+for i = 1, 64 do
+	local f = load("local t = {} for j = 1, " .. i .. " do t[j] = j * 2 end return t")
+	local t = f()
+	t = nil
+	f = nil
+	collectgarbage()
+
+	local objs = {}
+	for j = 1, 256 do
+		objs[j] = {j, j + 1, j + 2, j + 3}
+	end
+	for j = 1, 256 do
+		local o = objs[j]
+		if o[1] ~= j or o[2] ~= j + 1 or o[3] ~= j + 2 or o[4] ~= j + 3 then
+			error("Corrupted table")
+		end
+	end
+end
+)";
+	ANKI_TEST_EXPECT_NO_ERR(sm.evalString(script));
+}
@@ -0,0 +1,261 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Script.h>
+#include <AnKi/Math.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+namespace anki {
+
+/// Wraps allocAligned and counts the bytes that are allocated.
+class CountingAllocator
+{
+public:
+	static constexpr PtrSize HEADER_SIZE = 16;
+
+	Atomic<PtrSize> m_allocatedSize = {0};
+
+	static void* allocCallback(void* userData, void* ptr, PtrSize size, PtrSize alignment)
+	{
+		CountingAllocator& self = *static_cast<CountingAllocator*>(userData);
+
+		// Store the size and the offset right before the allocation to know how much is freed
+		if(ptr == nullptr)
+		{
+			const PtrSize offset = max(alignment, HEADER_SIZE);
+			U8* mem = static_cast<U8*>(allocAligned(nullptr, nullptr, size + offset, offset));
+			reinterpret_cast<PtrSize*>(mem + offset)[-2] = size;
+			reinterpret_cast<PtrSize*>(mem + offset)[-1] = offset;
+			self.m_allocatedSize.fetchAdd(size);
+			return mem + offset;
+		}
+		else
+		{
+			const PtrSize size = static_cast<PtrSize*>(ptr)[-2];
+			const PtrSize offset = static_cast<PtrSize*>(ptr)[-1];
+			self.m_allocatedSize.fetchSub(size);
+			allocAligned(nullptr, static_cast<U8*>(ptr) - offset, 0, 0);
+			return nullptr;
+		}
+	}
+};
+
+static const char* SPAWN_SCRIPT = R"(
+speed = 1.5
+target = Vec3.new(1, 2, 3)
+
+function update(prevTime, crntTime)
+	target:setY(target:getY() + speed * (crntTime - prevTime))
+	return 1
+end
+)";
+
+/// Call the update() of an environment.
+static Error callUpdate(ScriptEnvironment& env)
+{
+	LockGuard<Mutex> lock(env.getLuaStateMutex());
+	lua_State* l = &env.getLuaState();
+	env.pushGlobal("update");
+	lua_pushnumber(l, 0.0);
+	lua_pushnumber(l, 1.0);
+	if(lua_pcall(l, 2, 1, 0) != 0)
+	{
+		lua_pop(l, 1);
+		return Error::USER_DATA;
+	}
+
+	lua_pop(l, 1);
+	return Error::NONE;
+}
+
+ANKI_TEST(Script, ScriptEnvironment)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// The environments don't see each other's globals even if they share the VM
+	{
+		ScriptManager sm;
+		ANKI_TEST_EXPECT_NO_ERR(sm.init(allocAligned, nullptr, 1));
+
+		ScriptEnvironment envA;
+		ANKI_TEST_EXPECT_NO_ERR(envA.init(&sm));
+		ScriptEnvironment envB;
+		ANKI_TEST_EXPECT_NO_ERR(envB.init(&sm));
+
+		Vec4 a(0.0f);
+		Vec4 b(0.0f);
+		envA.exposeVariable("out", &a);
+		envB.exposeVariable("out", &b);
+
+		ANKI_TEST_EXPECT_NO_ERR(envA.evalString("num = 1"));
+		ANKI_TEST_EXPECT_NO_ERR(envB.evalString("num = 2"));
+		ANKI_TEST_EXPECT_NO_ERR(envA.evalString("out:setX(num)"));
+		ANKI_TEST_EXPECT_NO_ERR(envB.evalString("out:setX(num)"));
+		ANKI_TEST_EXPECT_EQ(a.x(), 1.0f);
+		ANKI_TEST_EXPECT_EQ(b.x(), 2.0f);
+
+		// Errors don't break the VM
+		ANKI_TEST_EXPECT_ERR(envA.evalString("error(\"oh no\")"), Error::USER_DATA);
+		ANKI_TEST_EXPECT_NO_ERR(envB.evalString("out:setY(num)"));
+		ANKI_TEST_EXPECT_EQ(b.y(), 2.0f);
+
+		// Bytecode
+		DynamicArrayAuto<U8> bytecode(alloc);
+		ANKI_TEST_EXPECT_NO_ERR(LuaBinder::compileString(alloc, "out:setZ(num * 10)", "=test", bytecode));
+		ANKI_TEST_EXPECT_NO_ERR(envA.evalBytecode(bytecode));
+		ANKI_TEST_EXPECT_NO_ERR(envB.evalBytecode(bytecode));
+		ANKI_TEST_EXPECT_EQ(a.z(), 10.0f);
+		ANKI_TEST_EXPECT_EQ(b.z(), 20.0f);
+
+		DynamicArrayAuto<U8> badBytecode(alloc);
+		ANKI_TEST_EXPECT_ERR(LuaBinder::compileString(alloc, "out:setZ(", "=test", badBytecode), Error::USER_DATA);
+	}
+
+	// Benchmark. Spawn many scripted objects the old way with a VM each and then with environments that share VMs
+	{
+		constexpr U32 OBJECT_COUNT = 10 * 1000;
+		constexpr U32 VM_COUNT = 4;
+		HighRezTimer timer;
+
+		// VM per object
+		CountingAllocator vmCounter;
+		timer.start();
+		{
+			HeapAllocator<U8> vmAlloc(CountingAllocator::allocCallback, &vmCounter);
+			LuaBinderOtherSystems otherSystems = {};
+			DynamicArrayAuto<LuaBinder> vms(vmAlloc);
+			vms.create(OBJECT_COUNT);
+			for(LuaBinder& vm : vms)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(vm.init(vmAlloc, &otherSystems));
+				ANKI_TEST_EXPECT_NO_ERR(LuaBinder::evalString(vm.getLuaState(), SPAWN_SCRIPT));
+			}
+			timer.stop();
+
+			ANKI_TEST_LOGI("Spawned %u scripted objects with a VM each in %fsec using %uMB", OBJECT_COUNT,
+						   timer.getElapsedTime(), U32(vmCounter.m_allocatedSize.load() / (1024 * 1024)));
+		}
+
+		// Environments
+		CountingAllocator envCounter;
+		timer.start();
+		{
+			ScriptManager sm;
+			ANKI_TEST_EXPECT_NO_ERR(sm.init(CountingAllocator::allocCallback, &envCounter, VM_COUNT));
+
+			DynamicArrayAuto<U8> bytecode(alloc);
+			ANKI_TEST_EXPECT_NO_ERR(LuaBinder::compileString(alloc, SPAWN_SCRIPT, "=spawn", bytecode));
+
+			DynamicArrayAuto<ScriptEnvironment> envs(alloc);
+			envs.create(OBJECT_COUNT);
+			for(ScriptEnvironment& env : envs)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(env.init(&sm));
+				ANKI_TEST_EXPECT_NO_ERR(env.evalBytecode(bytecode));
+			}
+			timer.stop();
+
+			for(ScriptEnvironment& env : envs)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(callUpdate(env));
+			}
+
+			ANKI_TEST_LOGI("Spawned %u scripted objects with environments in %u VMs in %fsec using %uMB",
+						   OBJECT_COUNT, VM_COUNT, timer.getElapsedTime(),
+						   U32(envCounter.m_allocatedSize.load() / (1024 * 1024)));
+		}
+	}
+}
+
+/// Vector math per frame that creates temporaries.
+static const char* MATH_SCRIPT_TEMPORARIES = R"(
+pos = Vec3.new(0, 0, 0)
+vel = Vec3.new(1, 0.5, 0.25)
+dt = Vec3.new(0.016, 0.016, 0.016)
+
+function update(prevTime, crntTime)
+	pos = pos + vel * dt
+	local dir = (vel - pos):getNormalized()
+	return dir:getX()
+end
+)";
+
+/// The same math with the "out" and "unpack" variants of the methods.
+static const char* MATH_SCRIPT_NO_TEMPORARIES = R"(
+pos = Vec3.new(0, 0, 0)
+vel = Vec3.new(1, 0.5, 0.25)
+dt = Vec3.new(0.016, 0.016, 0.016)
+tmp = Vec3.new(0, 0, 0)
+
+function update(prevTime, crntTime)
+	vel:mulOut(dt, tmp)
+	pos:addOut(tmp, pos)
+	vel:subOut(pos, tmp)
+	local x, y, z = tmp:getNormalizedUnpack()
+	return x
+end
+)";
+
+ANKI_TEST(Script, LuaMathAllocationsBenchmark)
+{
+	constexpr U32 FRAME_COUNT = 2000;
+	constexpr U32 OBJECT_COUNT = 100;
+
+	class Case
+	{
+	public:
+		const char* m_name;
+		const char* m_script;
+		LuaGarbageCollectorMode m_mode;
+	};
+
+	const Array<Case, 4> cases = {
+		{{"Temporaries, incremental GC", MATH_SCRIPT_TEMPORARIES, LuaGarbageCollectorMode::INCREMENTAL},
+		 {"Temporaries, generational GC", MATH_SCRIPT_TEMPORARIES, LuaGarbageCollectorMode::GENERATIONAL},
+		 {"Out & unpack, incremental GC", MATH_SCRIPT_NO_TEMPORARIES, LuaGarbageCollectorMode::INCREMENTAL},
+		 {"Out & unpack, generational GC", MATH_SCRIPT_NO_TEMPORARIES, LuaGarbageCollectorMode::GENERATIONAL}}};
+
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	HighRezTimer timer;
+
+	for(const Case& c : cases)
+	{
+		ScriptManager sm;
+		ANKI_TEST_EXPECT_NO_ERR(sm.init(allocAligned, nullptr, 1));
+
+		DynamicArrayAuto<ScriptEnvironment> envs(alloc);
+		envs.create(OBJECT_COUNT);
+		for(ScriptEnvironment& env : envs)
+		{
+			ANKI_TEST_EXPECT_NO_ERR(env.init(&sm));
+			ANKI_TEST_EXPECT_NO_ERR(env.evalString(c.m_script));
+		}
+
+		LuaGarbageCollectorConfig gcConfig;
+		gcConfig.m_mode = c.m_mode;
+		envs[0].setGarbageCollectorConfig(gcConfig);
+
+		const LuaBinderAllocationStats begin = envs[0].getAllocationStats();
+		timer.start();
+		for(U32 frame = 0; frame < FRAME_COUNT; ++frame)
+		{
+			for(ScriptEnvironment& env : envs)
+			{
+				ANKI_TEST_EXPECT_NO_ERR(callUpdate(env));
+			}
+		}
+		timer.stop();
+		const LuaBinderAllocationStats end = envs[0].getAllocationStats();
+
+		ANKI_TEST_LOGI("%s: %f LUA allocations per frame, %f allocator allocations per frame, %fms per frame, "
+					   "%uKB in use",
+					   c.m_name, F64(end.m_vmAllocationCount - begin.m_vmAllocationCount) / F64(FRAME_COUNT),
+					   F64(end.m_poolAllocationCount - begin.m_poolAllocationCount) / F64(FRAME_COUNT),
+					   timer.getElapsedTime() * 1000.0 / F64(FRAME_COUNT), U32(end.m_vmAllocatedSize / 1024));
+	}
+}
+
+} // end namespace anki
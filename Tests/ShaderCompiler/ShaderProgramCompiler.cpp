@@ -146,6 +146,19 @@ void main()
 	dumpShaderProgramBinary(binary.getBinary(), dis);
 	ANKI_LOGI("Binary disassembly:\n%s\n", dis.cstr());
 #endif
+
+	// Write it and use it in place
+	ANKI_TEST_EXPECT_NO_ERR(binary.serializeToFile("test.ankiprogbin"));
+	{
+		ShaderProgramBinaryWrapper binary2(alloc);
+		ANKI_TEST_EXPECT_NO_ERR(binary2.deserializeFromFile("test.ankiprogbin"));
+
+		StringAuto dis1(alloc);
+		dumpShaderProgramBinary(binary.getBinary(), dis1);
+		StringAuto dis2(alloc);
+		dumpShaderProgramBinary(binary2.getBinary(), dis2);
+		ANKI_TEST_EXPECT_EQ(dis1, dis2);
+	}
 }
 
 ANKI_TEST(ShaderCompiler, ShaderProgramCompiler)
@@ -6,6 +6,9 @@
 #include <Tests/Framework/Framework.h>
 #include <Tests/Util/Foo.h>
 #include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/FlatHashMap.h>
+#include <AnKi/Util/ShardedHashMap.h>
+#include <AnKi/Util/ThreadPool.h>
 #include <AnKi/Util/DynamicArray.h>
 #include <AnKi/Util/HighRezTimer.h>
 #include <unordered_map>
@@ -254,3 +257,336 @@ ANKI_TEST(Util, HashMap)
 		akMap.destroy(alloc);
 	}
 }
+
+/// Puts all keys to a few home slots to test the probing and the erasing.
+class BadHasher
+{
+public:
+	U64 operator()(int x)
+	{
+		return x % 4;
+	}
+};
+
+ANKI_TEST(Util, FlatHashMap)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// Simple
+	{
+		FlatHashMap<int, int, Hasher> map;
+		ANKI_TEST_EXPECT_EQ(map.find(20), map.getEnd());
+		map.emplace(alloc, 20, 1);
+		map.emplace(alloc, 21, 2);
+		ANKI_TEST_EXPECT_EQ(*map.find(20), 1);
+		ANKI_TEST_EXPECT_EQ(*map.find(21), 2);
+		ANKI_TEST_EXPECT_EQ(map.find(21).getKey(), 21);
+		ANKI_TEST_EXPECT_EQ(map.find(22), map.getEnd());
+		ANKI_TEST_EXPECT_EQ(map.getSize(), 2);
+		map.destroy(alloc);
+	}
+
+	// Fuzzy test against the STL with good and bad hashers
+	auto fuzzyTest = [&](auto& map) {
+		std::unordered_map<int, int> stlMap;
+		U32 seed = 1;
+		for(U32 i = 0; i < 20000; ++i)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			const int key = int((seed >> 8) % 1000);
+			const Bool erase = (seed >> 28) < 6;
+
+			auto it = map.find(key);
+			auto stlIt = stlMap.find(key);
+			ANKI_TEST_EXPECT_EQ(it != map.getEnd(), stlIt != stlMap.end());
+
+			if(stlIt != stlMap.end())
+			{
+				ANKI_TEST_EXPECT_EQ(*it, stlIt->second);
+				if(erase)
+				{
+					map.erase(alloc, it);
+					stlMap.erase(stlIt);
+				}
+			}
+			else if(!erase)
+			{
+				map.emplace(alloc, key, int(i));
+				stlMap[key] = int(i);
+			}
+
+			ANKI_TEST_EXPECT_EQ(map.getSize(), stlMap.size());
+		}
+
+		// Iterate
+		PtrSize count = 0;
+		for(auto it = map.getBegin(); it != map.getEnd(); ++it)
+		{
+			ANKI_TEST_EXPECT_EQ(stlMap[it.getKey()], *it);
+			++count;
+		}
+		ANKI_TEST_EXPECT_EQ(count, stlMap.size());
+
+		// Erase all
+		while(!map.isEmpty())
+		{
+			map.erase(alloc, map.getBegin());
+		}
+
+		map.destroy(alloc);
+	};
+
+	{
+		FlatHashMap<int, int, Hasher> map;
+		fuzzyTest(map);
+	}
+
+	{
+		FlatHashMap<int, int, BadHasher> map(16);
+		fuzzyTest(map);
+	}
+
+	// Values that need destruction
+	{
+		FlatHashMap<int, Foo, Hasher> map;
+		for(int i = 0; i < 1000; ++i)
+		{
+			map.emplace(alloc, i, i);
+		}
+
+		for(int i = 0; i < 1000; i += 2)
+		{
+			map.erase(alloc, map.find(i));
+		}
+
+		ANKI_TEST_EXPECT_EQ(map.find(999)->x, 999);
+		map.destroy(alloc);
+		ANKI_TEST_EXPECT_EQ(Foo::constructorCallCount, Foo::destructorCallCount);
+		Foo::reset();
+	}
+}
+
+ANKI_TEST(Util, FlatHashMapBenchmark)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	HighRezTimer timer;
+
+	// Random unique U64 keys like the hashes that are used as keys throughout the engine
+	const U32 COUNT = 1024 * 1024;
+	DynamicArrayAuto<U64> keys(alloc);
+	keys.create(COUNT);
+	U64 seed = 1;
+	for(U32 i = 0; i < COUNT; ++i)
+	{
+		seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+		keys[i] = seed;
+	}
+
+	auto bench = [&](auto& map, const char* name) {
+		U64 sum = 0; // To avoid compiler opts
+
+		timer.start();
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			map.emplace(alloc, keys[i], keys[i]);
+		}
+		timer.stop();
+		const Second insertTime = timer.getElapsedTime();
+
+		timer.start();
+		for(U32 j = 0; j < 4; ++j)
+		{
+			for(U32 i = 0; i < COUNT; ++i)
+			{
+				sum += *map.find(keys[i]);
+			}
+		}
+		timer.stop();
+		const Second findTime = timer.getElapsedTime() / 4.0;
+
+		// Search for keys that are not there
+		timer.start();
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			sum += map.find(keys[i] + 1) == map.getEnd();
+		}
+		timer.stop();
+		const Second missTime = timer.getElapsedTime();
+
+		timer.start();
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			map.erase(alloc, map.find(keys[i]));
+		}
+		timer.stop();
+		const Second eraseTime = timer.getElapsedTime();
+
+		map.destroy(alloc);
+
+		ANKI_TEST_LOGI("%s: insert %fns, find %fns, find missing %fns, erase %fns (%lu)", name,
+					   insertTime * 1000000000.0 / F64(COUNT), findTime * 1000000000.0 / F64(COUNT),
+					   missTime * 1000000000.0 / F64(COUNT), eraseTime * 1000000000.0 / F64(COUNT), sum);
+	};
+
+	{
+		HashMap<U64, U64> map;
+		bench(map, "HashMap");
+	}
+
+	{
+		FlatHashMap<U64, U64> map;
+		bench(map, "FlatHashMap");
+	}
+}
+
+/// Hammers a cache with lookups and a few insertions.
+template<typename TCache>
+class HashMapCacheTask : public ThreadPoolTask
+{
+public:
+	static constexpr U32 KEY_COUNT = 4096;
+	static constexpr U32 ITERATION_COUNT = 500000;
+
+	TCache* m_cache = nullptr;
+	U64 m_sum = 0;
+
+	Error operator()(U32 taskId, PtrSize threadsCount)
+	{
+		U32 seed = taskId + 1;
+		for(U32 i = 0; i < ITERATION_COUNT; ++i)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			const U64 key = (seed >> 8) % KEY_COUNT;
+			m_sum += m_cache->getOrCreate(key);
+		}
+
+		return Error::NONE;
+	}
+};
+
+/// The cache the engine used to have. A HashMap and a single lock.
+class LockedHashMapCache
+{
+public:
+	HeapAllocator<U8> m_alloc;
+	HashMap<U64, U64> m_map;
+	RWMutex m_mtx;
+
+	U64 getOrCreate(U64 key)
+	{
+		{
+			RLockGuard<RWMutex> lock(m_mtx);
+			auto it = m_map.find(key);
+			if(it != m_map.getEnd())
+			{
+				return *it;
+			}
+		}
+
+		WLockGuard<RWMutex> lock(m_mtx);
+		auto it = m_map.find(key);
+		if(it == m_map.getEnd())
+		{
+			it = m_map.emplace(m_alloc, key, key * 2);
+		}
+
+		return *it;
+	}
+};
+
+class ShardedHashMapCache
+{
+public:
+	HeapAllocator<U8> m_alloc;
+	ShardedHashMap<U64, U64> m_map;
+
+	U64 getOrCreate(U64 key)
+	{
+		return m_map.getOrCreate(m_alloc, key, [key]() {
+			return key * 2;
+		});
+	}
+};
+
+ANKI_TEST(Util, ShardedHashMap)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// Basic
+	{
+		ShardedHashMap<U64, U64> map;
+		ANKI_TEST_EXPECT_EQ(map.emplace(alloc, 1, 10), true);
+		ANKI_TEST_EXPECT_EQ(map.emplace(alloc, 1, 20), false);
+		ANKI_TEST_EXPECT_EQ(map.emplace(alloc, 2, 20), true);
+
+		U64 value = 0;
+		ANKI_TEST_EXPECT_EQ(map.find(1, value), true);
+		ANKI_TEST_EXPECT_EQ(value, 10);
+		ANKI_TEST_EXPECT_EQ(map.find(3, value), false);
+
+		U32 createCount = 0;
+		auto create = [&]() {
+			++createCount;
+			return U64(30);
+		};
+		ANKI_TEST_EXPECT_EQ(map.getOrCreate(alloc, 3, create), 30);
+		ANKI_TEST_EXPECT_EQ(map.getOrCreate(alloc, 3, create), 30);
+		ANKI_TEST_EXPECT_EQ(createCount, 1);
+		ANKI_TEST_EXPECT_EQ(map.getSize(), 3);
+
+		ANKI_TEST_EXPECT_EQ(map.erase(alloc, 2), true);
+		ANKI_TEST_EXPECT_EQ(map.erase(alloc, 2), false);
+
+		U64 sum = 0;
+		map.iterate([&](U64 key, U64 value) {
+			sum += value;
+		});
+		ANKI_TEST_EXPECT_EQ(sum, 40);
+
+		map.destroy(alloc);
+	}
+
+	// Many threads using it as a cache. Compare it with a HashMap that has one lock
+	{
+		constexpr U32 THREAD_COUNT = 8;
+		ThreadPool threadPool(THREAD_COUNT);
+		HighRezTimer timer;
+
+		auto bench = [&](auto& cache, const char* name) {
+			using Task = HashMapCacheTask<std::remove_reference_t<decltype(cache)>>;
+			Array<Task, THREAD_COUNT> tasks;
+			timer.start();
+			for(U32 i = 0; i < THREAD_COUNT; ++i)
+			{
+				tasks[i].m_cache = &cache;
+				threadPool.assignNewTask(i, &tasks[i]);
+			}
+			ANKI_TEST_EXPECT_NO_ERR(threadPool.waitForAllThreadsToFinish());
+			timer.stop();
+
+			// All the threads should see the same values
+			for(U64 key = 0; key < Task::KEY_COUNT; ++key)
+			{
+				ANKI_TEST_EXPECT_EQ(cache.getOrCreate(key), key * 2);
+			}
+
+			const U32 opCount = THREAD_COUNT * Task::ITERATION_COUNT;
+			ANKI_TEST_LOGI("%s: %u threads did %u lookups in %fms (%fns per lookup)", name, THREAD_COUNT, opCount,
+						   timer.getElapsedTime() * 1000.0, timer.getElapsedTime() * 1000000000.0 / F64(opCount));
+		};
+
+		{
+			LockedHashMapCache cache;
+			cache.m_alloc = alloc;
+			bench(cache, "HashMap with a RWMutex");
+			cache.m_map.destroy(alloc);
+		}
+
+		{
+			ShardedHashMapCache cache;
+			cache.m_alloc = alloc;
+			bench(cache, "ShardedHashMap");
+			cache.m_map.destroy(alloc);
+		}
+	}
+}
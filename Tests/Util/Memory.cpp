@@ -6,7 +6,9 @@
 #include <Tests/Framework/Framework.h>
 #include <Tests/Util/Foo.h>
 #include <AnKi/Util/Memory.h>
+#include <AnKi/Util/AllocationSiteProfiler.h>
 #include <AnKi/Util/ThreadPool.h>
+#include <AnKi/Util/HighRezTimer.h>
 #include <type_traits>
 #include <cstring>
 
@@ -31,6 +33,139 @@ ANKI_TEST(Util, HeapMemoryPool)
 
 		pool.free(ptr);
 	}
+
+	// Small and big allocations with various alignments
+	{
+		HeapMemoryPool pool(allocAligned, nullptr);
+		const Array<PtrSize, 8> sizes = {{1, 16, 17, 100, 512, 513, 4000, 100000}};
+		const Array<PtrSize, 5> alignments = {{1, 8, 16, 64, 4096}};
+		Array<void*, sizes.getSize() * alignments.getSize() * 10> ptrs;
+
+		U32 count = 0;
+		for(U32 i = 0; i < 10; ++i)
+		{
+			for(PtrSize size : sizes)
+			{
+				for(PtrSize alignment : alignments)
+				{
+					void* ptr = pool.allocate(size, alignment);
+					ANKI_TEST_EXPECT_NEQ(ptr, nullptr);
+					ANKI_TEST_EXPECT_EQ(isAligned(alignment, ptr), true);
+					memset(ptr, U8(count), size);
+					ptrs[count++] = ptr;
+				}
+			}
+		}
+
+		ANKI_TEST_EXPECT_EQ(pool.getAllocationCount(), count);
+
+		count = 0;
+		for(U32 i = 0; i < 10; ++i)
+		{
+			for(PtrSize size : sizes)
+			{
+				for(PtrSize alignment : alignments)
+				{
+					(void)alignment;
+					const U8* ptr = static_cast<const U8*>(ptrs[count]);
+					ANKI_TEST_EXPECT_EQ(ptr[0], U8(count));
+					ANKI_TEST_EXPECT_EQ(ptr[size - 1], U8(count));
+					pool.free(ptrs[count++]);
+				}
+			}
+		}
+
+		ANKI_TEST_EXPECT_EQ(pool.getAllocationCount(), 0);
+	}
+}
+
+/// Allocates and frees small objects randomly and at the end it frees the objects of another task.
+class HeapMemoryPoolChurnTask : public ThreadPoolTask
+{
+public:
+	static constexpr U32 LIVE_OBJECT_COUNT = 512;
+	static constexpr U32 ITERATION_COUNT = 200000;
+
+	HeapMemoryPool* m_pool = nullptr;
+	Array<void*, LIVE_OBJECT_COUNT> m_objects = {};
+	HeapMemoryPoolChurnTask* m_otherTask = nullptr;
+	Bool m_freeOtherTaskObjects = false;
+
+	Error operator()(U32 taskId, PtrSize threadsCount)
+	{
+		if(m_freeOtherTaskObjects)
+		{
+			for(void*& ptr : m_otherTask->m_objects)
+			{
+				m_pool->free(ptr);
+				ptr = nullptr;
+			}
+
+			return Error::NONE;
+		}
+
+		U32 seed = taskId + 1;
+		for(U32 i = 0; i < ITERATION_COUNT; ++i)
+		{
+			seed = seed * 1664525u + 1013904223u;
+			void*& ptr = m_objects[(seed >> 8) % LIVE_OBJECT_COUNT];
+			m_pool->free(ptr);
+
+			const PtrSize size = 8 + (seed >> 20) % 256;
+			ptr = m_pool->allocate(size, 8);
+			if(ptr == nullptr)
+			{
+				return Error::OUT_OF_MEMORY;
+			}
+
+			static_cast<U8*>(ptr)[0] = U8(i);
+			static_cast<U8*>(ptr)[size - 1] = U8(i);
+		}
+
+		return Error::NONE;
+	}
+};
+
+ANKI_TEST(Util, HeapMemoryPoolBenchmark)
+{
+	constexpr U32 THREAD_COUNT = 8;
+	ThreadPool threadPool(THREAD_COUNT);
+	HighRezTimer timer;
+
+	for(Bool smallObjectCaching : {false, true})
+	{
+		HeapMemoryPool pool(allocAligned, nullptr, "Benchmark", smallObjectCaching);
+
+		Array<HeapMemoryPoolChurnTask, THREAD_COUNT> tasks;
+		for(U32 i = 0; i < THREAD_COUNT; ++i)
+		{
+			tasks[i].m_pool = &pool;
+			tasks[i].m_otherTask = &tasks[(i + 1) % THREAD_COUNT];
+		}
+
+		timer.start();
+		for(U32 i = 0; i < THREAD_COUNT; ++i)
+		{
+			threadPool.assignNewTask(i, &tasks[i]);
+		}
+		ANKI_TEST_EXPECT_NO_ERR(threadPool.waitForAllThreadsToFinish());
+
+		// Free the objects from other threads
+		for(U32 i = 0; i < THREAD_COUNT; ++i)
+		{
+			tasks[i].m_freeOtherTaskObjects = true;
+			threadPool.assignNewTask(i, &tasks[i]);
+		}
+		ANKI_TEST_EXPECT_NO_ERR(threadPool.waitForAllThreadsToFinish());
+		timer.stop();
+
+		ANKI_TEST_EXPECT_EQ(pool.getAllocationCount(), 0);
+
+		const U32 opCount = THREAD_COUNT * HeapMemoryPoolChurnTask::ITERATION_COUNT * 2;
+		ANKI_TEST_LOGI("%u threads did %u small allocations and frees %s small object caching in %fms (%fns per op)",
+					   THREAD_COUNT, opCount, (smallObjectCaching) ? "with" : "without",
+					   timer.getElapsedTime() * 1000.0, timer.getElapsedTime() * 1000000000.0 / F64(opCount));
+	}
 }
 
 ANKI_TEST(Util, StackMemoryPool)
@@ -202,3 +337,164 @@ ANKI_TEST(Util, ChainMemoryPool)
 		ANKI_TEST_EXPECT_EQ(pool.getChunksCount(), 0);
 	}
 }
+
+ANKI_TEST(Util, MemoryPoolStats)
+{
+	HeapMemoryPool heapPool(allocAligned, nullptr, "TestHeap");
+	StackMemoryPool stackPool(allocAligned, nullptr, 1_KB, 2.0, 0, true, ANKI_SAFE_ALIGNMENT, "TestStack");
+	ChainMemoryPool chainPool(allocAligned, nullptr, 1_KB, 2.0f, 0, 16, "TestChain");
+	HeapMemoryPool unnamedPool(allocAligned, nullptr);
+
+	// Allocate small and big chunks
+	Array<BaseMemoryPool*, 3> pools = {&heapPool, &stackPool, &chainPool};
+	for(BaseMemoryPool* pool : pools)
+	{
+		Array<void*, 10> ptrs;
+		for(U32 i = 0; i < ptrs.getSize(); ++i)
+		{
+			ptrs[i] = pool->allocate((i % 2) ? 16 : 4_KB, 16);
+		}
+
+		MemoryPoolStats stats = pool->getStats();
+		ANKI_TEST_EXPECT_EQ(stats.m_totalAllocationCount, ptrs.getSize());
+		ANKI_TEST_EXPECT_EQ(stats.m_allocationCount, ptrs.getSize());
+		ANKI_TEST_EXPECT_GEQ(stats.m_liveBytes, 5 * 4_KB + 5 * 16);
+		ANKI_TEST_EXPECT_EQ(stats.m_peakLiveBytes, stats.m_liveBytes);
+
+		for(void* ptr : ptrs)
+		{
+			pool->free(ptr);
+		}
+
+		stats = pool->getStats();
+		ANKI_TEST_EXPECT_EQ(stats.m_totalAllocationCount, ptrs.getSize());
+		ANKI_TEST_EXPECT_EQ(stats.m_allocationCount, 0);
+		ANKI_TEST_EXPECT_GEQ(stats.m_peakLiveBytes, 5 * 4_KB + 5 * 16);
+		if(pool != &stackPool) // The stack pool keeps its chunks
+		{
+			ANKI_TEST_EXPECT_LT(stats.m_liveBytes, stats.m_peakLiveBytes);
+		}
+	}
+
+	// Only the named pools are visited
+	U32 visitedCount = 0;
+	BaseMemoryPool::visitNamedPools([&](BaseMemoryPool& pool) {
+		ANKI_TEST_EXPECT_NEQ(&pool, &unnamedPool);
+		for(BaseMemoryPool* p : pools)
+		{
+			visitedCount += p == &pool;
+		}
+	});
+	ANKI_TEST_EXPECT_EQ(visitedCount, pools.getSize());
+
+	// Visit while another thread destroys named pools. The visitor shouldn't see the pools that are being destroyed
+	{
+		class PoolVisitTask : public ThreadPoolTask
+		{
+		public:
+			Atomic<U32>* m_pendingCreators = nullptr;
+			U64 m_visitedAllocationCount = 0;
+
+			Error operator()(U32 taskId, PtrSize threadsCount)
+			{
+				if(taskId == 0)
+				{
+					while(m_pendingCreators->load() > 0)
+					{
+						BaseMemoryPool::visitNamedPools([&](BaseMemoryPool& pool) {
+							m_visitedAllocationCount += pool.getStats().m_allocationCount;
+						});
+					}
+				}
+				else
+				{
+					for(U32 i = 0; i < 200; ++i)
+					{
+						HeapMemoryPool pool(allocAligned, nullptr, "Short lived");
+						pool.free(pool.allocate(32, 8));
+					}
+
+					m_pendingCreators->fetchSub(1);
+				}
+
+				return Error::NONE;
+			}
+		};
+
+		constexpr U32 THREAD_COUNT = 3;
+		ThreadPool threadPool(THREAD_COUNT);
+		Atomic<U32> pendingCreators = {THREAD_COUNT - 1};
+		Array<PoolVisitTask, THREAD_COUNT> tasks;
+		for(U32 i = 0; i < THREAD_COUNT; ++i)
+		{
+			tasks[i].m_pendingCreators = &pendingCreators;
+			threadPool.assignNewTask(i, &tasks[i]);
+		}
+		ANKI_TEST_EXPECT_NO_ERR(threadPool.waitForAllThreadsToFinish());
+	}
+
+	// Sampling
+	U32 sampleCount = 0;
+	heapPool.setAllocationSampling(
+		4,
+		[](void* userData, const BaseMemoryPool& pool, PtrSize size) {
+			++*static_cast<U32*>(userData);
+		},
+		&sampleCount);
+	for(U32 i = 0; i < 20; ++i)
+	{
+		heapPool.free(heapPool.allocate(32, 8));
+	}
+	heapPool.setAllocationSampling(0, nullptr, nullptr);
+	ANKI_TEST_EXPECT_EQ(sampleCount, 5);
+
+	// Budget
+	{
+		MemoryPoolAllocationBudget budget(heapPool, 2, "Test");
+		heapPool.free(heapPool.allocate(32, 8));
+		heapPool.free(heapPool.allocate(1_KB, 8));
+		ANKI_TEST_EXPECT_EQ(budget.getAllocationCount(), 2);
+		ANKI_TEST_EXPECT_EQ(budget.isWithinBudget(), true);
+	}
+
+	{
+		MemoryPoolAllocationBudget budget(chainPool, 0, "Test");
+		ANKI_TEST_EXPECT_EQ(budget.isWithinBudget(), true);
+	}
+}
+
+static ANKI_DONT_INLINE void allocationSiteA(HeapMemoryPool& pool)
+{
+	pool.free(pool.allocate(64, 8));
+}
+
+static ANKI_DONT_INLINE void allocationSiteB(HeapMemoryPool& pool)
+{
+	pool.free(pool.allocate(1_KB, 8));
+}
+
+ANKI_TEST(Util, AllocationSiteProfiler)
+{
+	HeapMemoryPool pool(allocAligned, nullptr, "Test");
+	AllocationSiteProfiler profiler(HeapAllocator<U8>(allocAligned, nullptr));
+	profiler.startSampling(pool, 1);
+
+	for(U32 i = 0; i < 10; ++i)
+	{
+		allocationSiteA(pool);
+		allocationSiteB(pool);
+	}
+
+	profiler.stopSampling(pool);
+	allocationSiteA(pool);
+
+	ANKI_TEST_EXPECT_EQ(profiler.getSiteCount(), 2);
+
+	U32 count = 0;
+	profiler.visitHotspots(1, [&](const AllocationSite& site) {
+		ANKI_TEST_EXPECT_EQ(site.m_sampleCount, 10);
+		ANKI_TEST_EXPECT_EQ(site.m_sampledBytes, 10 * 1_KB);
+		++count;
+	});
+	ANKI_TEST_EXPECT_EQ(count, 1);
+}
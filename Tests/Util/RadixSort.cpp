@@ -0,0 +1,123 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Util/RadixSort.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <algorithm>
+
+namespace anki {
+
+static U64 randU64()
+{
+	return (U64(rand()) << 48u) ^ (U64(rand()) << 32u) ^ (U64(rand()) << 16u) ^ U64(rand());
+}
+
+ANKI_TEST(Util, RadixSort)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+
+	// Compare with std::stable_sort
+	for(U32 mode = 0; mode < 3; ++mode)
+	{
+		const U32 COUNT = 10000;
+		DynamicArrayAuto<RadixSortPair> pairs(alloc, COUNT);
+		DynamicArrayAuto<RadixSortPair> tmpPairs(alloc, COUNT);
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			switch(mode)
+			{
+			case 0:
+				pairs[i].m_key = randU64();
+				break;
+			case 1:
+				// Few significant bits and lots of duplicates
+				pairs[i].m_key = U64(rand() % 64) << 20u;
+				break;
+			default:
+				// Same key
+				pairs[i].m_key = 123;
+			}
+			pairs[i].m_value = i;
+		}
+
+		std::vector<RadixSortPair> stlPairs(pairs.getBegin(), pairs.getEnd());
+		std::stable_sort(stlPairs.begin(), stlPairs.end(), [](const RadixSortPair& a, const RadixSortPair& b) {
+			return a.m_key < b.m_key;
+		});
+
+		radixSort(WeakArray<RadixSortPair>(pairs), WeakArray<RadixSortPair>(tmpPairs));
+
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			ANKI_TEST_EXPECT_EQ(pairs[i].m_key, stlPairs[i].m_key);
+			ANKI_TEST_EXPECT_EQ(pairs[i].m_value, stlPairs[i].m_value);
+		}
+	}
+
+	// Partition and then sort the buckets
+	{
+		const U32 COUNT = 10000;
+		DynamicArrayAuto<RadixSortPair> pairs(alloc, COUNT);
+		DynamicArrayAuto<RadixSortPair> tmpPairs(alloc, COUNT);
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			pairs[i].m_key = randU64();
+			pairs[i].m_value = i;
+		}
+
+		Array<U32, RADIX_SORT_BUCKET_COUNT + 1> bucketOffsets;
+		radixSortPartition(pairs, WeakArray<RadixSortPair>(tmpPairs), bucketOffsets);
+		ANKI_TEST_EXPECT_EQ(bucketOffsets[0], 0);
+		ANKI_TEST_EXPECT_EQ(bucketOffsets[RADIX_SORT_BUCKET_COUNT], COUNT);
+
+		for(U32 bucket = 0; bucket < RADIX_SORT_BUCKET_COUNT; ++bucket)
+		{
+			const U32 begin = bucketOffsets[bucket];
+			const U32 count = bucketOffsets[bucket + 1] - begin;
+			if(count)
+			{
+				radixSort(WeakArray<RadixSortPair>(&tmpPairs[begin], count),
+						  WeakArray<RadixSortPair>(&pairs[begin], count), 7);
+			}
+		}
+
+		for(U32 i = 1; i < COUNT; ++i)
+		{
+			ANKI_TEST_EXPECT_LEQ(tmpPairs[i - 1].m_key, tmpPairs[i].m_key);
+		}
+	}
+
+	// Bench against std::sort
+	{
+		const U32 COUNT = 1024 * 1024;
+		DynamicArrayAuto<RadixSortPair> pairs(alloc, COUNT);
+		DynamicArrayAuto<RadixSortPair> tmpPairs(alloc, COUNT);
+		for(U32 i = 0; i < COUNT; ++i)
+		{
+			pairs[i].m_key = randU64();
+			pairs[i].m_value = i;
+		}
+		std::vector<RadixSortPair> stlPairs(pairs.getBegin(), pairs.getEnd());
+
+		HighRezTimer timer;
+		timer.start();
+		radixSort(WeakArray<RadixSortPair>(pairs), WeakArray<RadixSortPair>(tmpPairs));
+		timer.stop();
+		const Second akTime = timer.getElapsedTime();
+
+		timer.start();
+		std::sort(stlPairs.begin(), stlPairs.end(), [](const RadixSortPair& a, const RadixSortPair& b) {
+			return a.m_key < b.m_key;
+		});
+		timer.stop();
+		const Second stlTime = timer.getElapsedTime();
+
+		ANKI_TEST_LOGI("Sort bench: STL %f AnKi %f | %f%%", stlTime, akTime, stlTime / akTime * 100.0);
+	}
+}
+
+} // end namespace anki
@@ -6,6 +6,9 @@
 #include <Tests/Framework/Framework.h>
 #include <AnKi/Util/Serializer.h>
 #include <Tests/Util/SerializerTest.h>
+#include <Tests/Util/SerializerRelativeTest.h>
+#include <AnKi/Util/HighRezTimer.h>
+#include <AnKi/Util/DynamicArray.h>
 
 ANKI_TEST(Util, BinarySerializer)
 {
@@ -67,3 +70,246 @@ ANKI_TEST(Util, BinarySerializer)
 		alloc.deleteInstance(pa);
 	}
 }
+
+static void fillRelativeTestClasses(ClassC& c, DynamicArrayAuto<ClassD>& ds, DynamicArrayAuto<U32>& values, U32 dCount,
+									U32 valuesPerD)
+{
+	values.create(dCount * valuesPerD);
+	for(U32 i = 0; i < values.getSize(); ++i)
+	{
+		values[i] = i * 3 + 1;
+	}
+
+	ds.create(dCount);
+	for(U32 i = 0; i < dCount; ++i)
+	{
+		ds[i].m_array[0] = U8(i);
+		ds[i].m_array[1] = U8(i + 1);
+		ds[i].m_array[2] = U8(i + 2);
+		ds[i].m_darray = WeakArray<U32>(&values[i * valuesPerD], valuesPerD);
+	}
+
+	c.m_u32 = 321;
+	c.m_darray = WeakArray<ClassD>(ds);
+	c.m_pointer = &ds[dCount - 1];
+	c.m_u64 = 0x123456789ABCDEFF;
+}
+
+static void checkRelativeTestClasses(const ClassC& c, U32 dCount, U32 valuesPerD)
+{
+	ANKI_TEST_EXPECT_EQ(c.m_u32, 321);
+	ANKI_TEST_EXPECT_EQ(c.m_u64, 0x123456789ABCDEFF);
+	ANKI_TEST_EXPECT_EQ(c.m_darray.getSize(), dCount);
+	ANKI_TEST_EXPECT_EQ(c.m_pointer->m_array[0], U8(dCount - 1));
+
+	for(U32 i = 0; i < dCount; ++i)
+	{
+		const ClassD& d = c.m_darray[i];
+		ANKI_TEST_EXPECT_EQ(d.m_array[2], U8(i + 2));
+		ANKI_TEST_EXPECT_EQ(d.m_darray.getSize(), valuesPerD);
+		for(U32 j = 0; j < valuesPerD; ++j)
+		{
+			ANKI_TEST_EXPECT_EQ(d.m_darray[j], (i * valuesPerD + j) * 3 + 1);
+		}
+	}
+}
+
+ANKI_TEST(Util, BinarySerializerRelativePointers)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	constexpr U32 D_COUNT = 4;
+	constexpr U32 VALUES_PER_D = 3;
+
+	ClassC c;
+	DynamicArrayAuto<ClassD> ds(alloc);
+	DynamicArrayAuto<U32> values(alloc);
+	fillRelativeTestClasses(c, ds, values, D_COUNT, VALUES_PER_D);
+
+	// Copying recomputes the offsets
+	{
+		const ClassC copy = c;
+		ANKI_TEST_EXPECT_EQ(copy.m_darray.getBegin(), c.m_darray.getBegin());
+		ANKI_TEST_EXPECT_EQ(copy.m_pointer.get(), c.m_pointer.get());
+	}
+
+	// Serialize
+	{
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin", FileOpenFlag::WRITE | FileOpenFlag::BINARY));
+		BinarySerializer serializer;
+		ANKI_TEST_EXPECT_NO_ERR(serializer.serialize(c, alloc, file));
+	}
+
+	// Deserialize with a copy
+	{
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin", FileOpenFlag::READ | FileOpenFlag::BINARY));
+
+		BinaryDeserializer deserializer;
+		ClassC* pc;
+		ANKI_TEST_EXPECT_NO_ERR(deserializer.deserialize(pc, alloc, file));
+		checkRelativeTestClasses(*pc, D_COUNT, VALUES_PER_D);
+		alloc.deleteInstance(pc);
+	}
+
+	// Use the memory-mapped file in place
+	{
+		MemoryMappedFile file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin"));
+
+		const ClassC* pc;
+		ANKI_TEST_EXPECT_NO_ERR(
+			BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(file.getData(), file.getSize())));
+		ANKI_TEST_EXPECT_GEQ(ptrToNumber(pc), ptrToNumber(file.getData()));
+		ANKI_TEST_EXPECT_LEQ(ptrToNumber(pc->m_pointer.get()), ptrToNumber(file.getData() + file.getSize()));
+		checkRelativeTestClasses(*pc, D_COUNT, VALUES_PER_D);
+	}
+
+	// Corrupt files
+	{
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin", FileOpenFlag::READ | FileOpenFlag::BINARY));
+		const PtrSize size = file.getSize();
+		U8* data = static_cast<U8*>(alloc.getMemoryPool().allocate(size, ANKI_SAFE_ALIGNMENT));
+		ANKI_TEST_EXPECT_NO_ERR(file.read(data, size));
+
+		detail::BinarySerializerHeader header;
+		memcpy(&header, data, sizeof(header));
+		ANKI_TEST_EXPECT_EQ(header.m_pointerCount, 0);
+		// The ClassD of the m_pointer is written again with its own array
+		ANKI_TEST_EXPECT_EQ(header.m_relativePointerCount, 1 + D_COUNT + 1 + 1);
+
+		const ClassC* pc;
+		ANKI_TEST_EXPECT_NO_ERR(BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size)));
+
+		// Truncated
+		ANKI_TEST_EXPECT_ERR(BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size - 1)),
+							 Error::USER_DATA);
+		ANKI_TEST_EXPECT_EQ(pc == nullptr, true);
+
+		// Every relative pointer that points outside the data should be caught
+		using RelativePointer = detail::BinarySerializerRelativePointer;
+		RelativePointer* relativePointers =
+			reinterpret_cast<RelativePointer*>(data + header.m_relativePointerArrayFilePosition);
+		for(U32 i = 0; i < header.m_relativePointerCount; ++i)
+		{
+			I64& value = *reinterpret_cast<I64*>(data + sizeof(header) + relativePointers[i].m_pointerOffset);
+			const I64 originalValue = value;
+
+			value = I64(header.m_dataSize);
+			ANKI_TEST_EXPECT_ERR(BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size)),
+								 Error::USER_DATA);
+
+			value = -I64(relativePointers[i].m_pointerOffset) - 1;
+			ANKI_TEST_EXPECT_ERR(BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size)),
+								 Error::USER_DATA);
+
+			value = originalValue;
+		}
+
+		// Array sizes that go past the end of the data. The table doesn't catch them since it knows only the original
+		// sizes
+		ANKI_TEST_EXPECT_NO_ERR(BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size)));
+		Array<U32*, 2> arraySizes;
+		arraySizes[0] = reinterpret_cast<U32*>(data + sizeof(header) + offsetof(ClassC, m_darray) + sizeof(I64));
+		arraySizes[1] = reinterpret_cast<U32*>(ptrToNumber(&pc->m_darray[D_COUNT - 1].m_darray) + sizeof(I64));
+		for(U32* arraySize : arraySizes)
+		{
+			const U32 originalSize = *arraySize;
+
+			for(U32 newSize : {originalSize + U32(header.m_dataSize), MAX_U32})
+			{
+				*arraySize = newSize;
+				ANKI_TEST_EXPECT_ERR(
+					BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size)),
+					Error::USER_DATA);
+				ANKI_TEST_EXPECT_EQ(pc == nullptr, true);
+			}
+
+			*arraySize = originalSize;
+		}
+
+		// Broken table
+		relativePointers[0].m_pointerOffset = header.m_dataSize;
+		ANKI_TEST_EXPECT_ERR(BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(data, size)),
+							 Error::USER_DATA);
+
+		alloc.getMemoryPool().free(data);
+	}
+
+	// Files with regular pointers can't be used in place
+	{
+		Array<U32, 2> arr = {{1, 2}};
+		ClassB b = {};
+		b.m_darray = arr;
+
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin", FileOpenFlag::WRITE | FileOpenFlag::BINARY));
+		BinarySerializer serializer;
+		ANKI_TEST_EXPECT_NO_ERR(serializer.serialize(b, alloc, file));
+		file.close();
+
+		MemoryMappedFile mappedFile;
+		ANKI_TEST_EXPECT_NO_ERR(mappedFile.open("serialized.bin"));
+		const ClassB* pb;
+		ANKI_TEST_EXPECT_ERR(BinaryDeserializer::deserializeInPlace(
+								 pb, ConstWeakArray<U8, PtrSize>(mappedFile.getData(), mappedFile.getSize())),
+							 Error::USER_DATA);
+	}
+}
+
+ANKI_TEST(Util, BinarySerializerInPlaceBenchmark)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	constexpr U32 D_COUNT = 2000;
+	constexpr U32 VALUES_PER_D = 256;
+	constexpr U32 ITERATIONS = 20;
+
+	{
+		ClassC c;
+		DynamicArrayAuto<ClassD> ds(alloc);
+		DynamicArrayAuto<U32> values(alloc);
+		fillRelativeTestClasses(c, ds, values, D_COUNT, VALUES_PER_D);
+
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin", FileOpenFlag::WRITE | FileOpenFlag::BINARY));
+		BinarySerializer serializer;
+		ANKI_TEST_EXPECT_NO_ERR(serializer.serialize(c, alloc, file));
+	}
+
+	HighRezTimer timer;
+	U64 sum = 0; // To avoid compiler opts
+
+	// Read and copy the file
+	timer.start();
+	for(U32 i = 0; i < ITERATIONS; ++i)
+	{
+		File file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin", FileOpenFlag::READ | FileOpenFlag::BINARY));
+		BinaryDeserializer deserializer;
+		ClassC* pc;
+		ANKI_TEST_EXPECT_NO_ERR(deserializer.deserialize(pc, alloc, file));
+		sum += pc->m_darray[i].m_darray[i];
+		alloc.deleteInstance(pc);
+	}
+	timer.stop();
+	const Second copyTime = timer.getElapsedTime() / ITERATIONS;
+
+	// Map the file and use it in place
+	timer.start();
+	for(U32 i = 0; i < ITERATIONS; ++i)
+	{
+		MemoryMappedFile file;
+		ANKI_TEST_EXPECT_NO_ERR(file.open("serialized.bin"));
+		const ClassC* pc;
+		ANKI_TEST_EXPECT_NO_ERR(
+			BinaryDeserializer::deserializeInPlace(pc, ConstWeakArray<U8, PtrSize>(file.getData(), file.getSize())));
+		sum += pc->m_darray[i].m_darray[i];
+	}
+	timer.stop();
+	const Second inPlaceTime = timer.getElapsedTime() / ITERATIONS;
+
+	ANKI_TEST_LOGI("Loading a %uKB file. Read and copy: %fms, in place: %fms (checksum %lu)",
+				   U32(D_COUNT * (sizeof(ClassD) + VALUES_PER_D * sizeof(U32)) / 1024), copyTime * 1000.0,
+				   inPlaceTime * 1000.0, sum);
+}
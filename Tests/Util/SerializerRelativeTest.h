@@ -0,0 +1,72 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+// WARNING: This file is auto generated.
+
+#pragma once
+
+#include <AnKi/Util/RelativePtr.h>
+
+namespace anki {
+
+/// ClassD class.
+class ClassD
+{
+public:
+	Array<U8, 3> m_array;
+	RelativeWeakArray<U32> m_darray;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doArray("m_array", offsetof(ClassD, m_array), &self.m_array[0], self.m_array.getSize());
+		s.doValue("m_darray", offsetof(ClassD, m_darray), self.m_darray);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ClassD&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ClassD&>(serializer, *this);
+	}
+};
+
+/// ClassC class.
+class ClassC
+{
+public:
+	U32 m_u32;
+	RelativeWeakArray<ClassD> m_darray;
+	RelativePtr<ClassD> m_pointer = nullptr;
+	U64 m_u64;
+
+	template<typename TSerializer, typename TClass>
+	static void serializeCommon(TSerializer& s, TClass self)
+	{
+		s.doValue("m_u32", offsetof(ClassC, m_u32), self.m_u32);
+		s.doValue("m_darray", offsetof(ClassC, m_darray), self.m_darray);
+		s.doRelativePointer("m_pointer", offsetof(ClassC, m_pointer), self.m_pointer.get());
+		s.doValue("m_u64", offsetof(ClassC, m_u64), self.m_u64);
+	}
+
+	template<typename TDeserializer>
+	void deserialize(TDeserializer& deserializer)
+	{
+		serializeCommon<TDeserializer, ClassC&>(deserializer, *this);
+	}
+
+	template<typename TSerializer>
+	void serialize(TSerializer& serializer) const
+	{
+		serializeCommon<TSerializer, const ClassC&>(serializer, *this);
+	}
+};
+
+} // end namespace anki
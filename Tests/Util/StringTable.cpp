@@ -0,0 +1,241 @@
+// Copyright (C) 2009-2021, Panagiotis Christopoulos Charitos and contributors.
+// All rights reserved.
+// Code licensed under the BSD License.
+// http://www.anki3d.org/LICENSE
+
+#include <Tests/Framework/Framework.h>
+#include <AnKi/Util/StringTable.h>
+#include <AnKi/Util/FlatHashMap.h>
+#include <AnKi/Util/HashMap.h>
+#include <AnKi/Util/DynamicArray.h>
+#include <AnKi/Util/ThreadPool.h>
+#include <AnKi/Util/HighRezTimer.h>
+
+using namespace anki;
+
+ANKI_TEST(Util, StringTable)
+{
+	// Basic
+	{
+		StringTable table(allocAligned, nullptr);
+
+		ANKI_TEST_EXPECT_EQ(table.intern(""), 0);
+		ANKI_TEST_EXPECT_EQ(table.intern(CString()), 0);
+		ANKI_TEST_EXPECT_EQ(table.tryFind("foo"), 0);
+
+		const U32 foo = table.intern("foo");
+		const U32 bar = table.intern("bar");
+		ANKI_TEST_EXPECT_NEQ(foo, 0);
+		ANKI_TEST_EXPECT_NEQ(foo, bar);
+		ANKI_TEST_EXPECT_EQ(table.intern("foo"), foo);
+		ANKI_TEST_EXPECT_EQ(table.tryFind("foo"), foo);
+		ANKI_TEST_EXPECT_EQ(table.tryFind("fo"), 0);
+		ANKI_TEST_EXPECT_EQ(table.tryFind("fooo"), 0);
+		ANKI_TEST_EXPECT_EQ(table.getString(foo), "foo");
+		ANKI_TEST_EXPECT_EQ(table.getHash(bar), CString("bar").computeHash());
+		ANKI_TEST_EXPECT_EQ(table.getSize(), 2);
+	}
+
+	// Many strings so the index grows and the entries go to more than one chunk
+	{
+		StringTable table(allocAligned, nullptr);
+		const U32 count = 20000;
+		for(U32 i = 0; i < count; ++i)
+		{
+			StringAuto str(HeapAllocator<U8>(allocAligned, nullptr));
+			str.sprintf("string_%u", i);
+			ANKI_TEST_EXPECT_EQ(table.intern(str), i + 1);
+		}
+
+		for(U32 i = 0; i < count; ++i)
+		{
+			StringAuto str(HeapAllocator<U8>(allocAligned, nullptr));
+			str.sprintf("string_%u", i);
+			ANKI_TEST_EXPECT_EQ(table.tryFind(str), i + 1);
+			ANKI_TEST_EXPECT_EQ(table.getString(i + 1), str);
+		}
+
+		ANKI_TEST_EXPECT_EQ(table.getSize(), count);
+	}
+
+	// StringId
+	{
+		const StringId a("StringIdTest_a");
+		const StringId b("StringIdTest_b");
+		ANKI_TEST_EXPECT_EQ(a == StringId("StringIdTest_a"), true);
+		ANKI_TEST_EXPECT_EQ(a != b, true);
+		ANKI_TEST_EXPECT_EQ(a.toCString(), "StringIdTest_a");
+		ANKI_TEST_EXPECT_EQ(a.getStringHash(), CString("StringIdTest_a").computeHash());
+		ANKI_TEST_EXPECT_EQ(StringId::tryFind("StringIdTest_b") == b, true);
+		ANKI_TEST_EXPECT_EQ(StringId::tryFind("StringIdTest_c").isEmpty(), true);
+		ANKI_TEST_EXPECT_EQ(StringId().toCString(), CString());
+		ANKI_TEST_EXPECT_EQ(StringId("").isEmpty(), true);
+	}
+}
+
+/// Interns the same strings from many threads.
+class StringTableInternTask : public ThreadPoolTask
+{
+public:
+	static constexpr U32 STRING_COUNT = 5000;
+
+	StringTable* m_table = nullptr;
+	Array<U32, STRING_COUNT> m_ids;
+
+	Error operator()(U32 taskId, PtrSize threadsCount)
+	{
+		// Every thread goes in a different order
+		for(U32 i = 0; i < STRING_COUNT; ++i)
+		{
+			const U32 idx = (i * 7919 + taskId * 131) % STRING_COUNT;
+			Array<char, 32> str;
+			snprintf(&str[0], sizeof(str), "concurrent_%u", idx);
+			m_ids[idx] = m_table->intern(&str[0]);
+
+			if(m_table->getString(m_ids[idx]) != &str[0])
+			{
+				return Error::FUNCTION_FAILED;
+			}
+		}
+
+		return Error::NONE;
+	}
+};
+
+ANKI_TEST(Util, StringTableMultithreaded)
+{
+	constexpr U32 THREAD_COUNT = 8;
+	StringTable table(allocAligned, nullptr);
+	ThreadPool threadPool(THREAD_COUNT);
+
+	Array<StringTableInternTask, THREAD_COUNT> tasks;
+	for(U32 i = 0; i < THREAD_COUNT; ++i)
+	{
+		tasks[i].m_table = &table;
+		threadPool.assignNewTask(i, &tasks[i]);
+	}
+	ANKI_TEST_EXPECT_NO_ERR(threadPool.waitForAllThreadsToFinish());
+
+	// All threads should have gotten the same IDs and every string should be interned once
+	ANKI_TEST_EXPECT_EQ(table.getSize(), StringTableInternTask::STRING_COUNT);
+	for(U32 i = 1; i < THREAD_COUNT; ++i)
+	{
+		for(U32 j = 0; j < StringTableInternTask::STRING_COUNT; ++j)
+		{
+			ANKI_TEST_EXPECT_EQ(tasks[i].m_ids[j], tasks[0].m_ids[j]);
+		}
+	}
+}
+
+ANKI_TEST(Util, StringTableBenchmark)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	HighRezTimer timer;
+
+	// Names that look like config options
+	const U32 NAME_COUNT = 256;
+	const U32 LOOKUP_COUNT = 1000000;
+	DynamicArrayAuto<StringAuto> names(alloc);
+	names.create(NAME_COUNT, StringAuto(alloc));
+	DynamicArrayAuto<StringId> ids(alloc);
+	ids.create(NAME_COUNT);
+	for(U32 i = 0; i < NAME_COUNT; ++i)
+	{
+		names[i].sprintf("r_benchmarkOption%uValue", i);
+		ids[i] = StringId(names[i]);
+	}
+
+	// The order of the lookups
+	DynamicArrayAuto<U32> lookups(alloc);
+	lookups.create(LOOKUP_COUNT);
+	U32 seed = 1;
+	for(U32& idx : lookups)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		idx = (seed >> 8) % NAME_COUNT;
+	}
+
+	U64 sum = 0; // To avoid compiler opts
+	auto log = [&](const char* name) {
+		ANKI_TEST_LOGI("%s: %fns per lookup", name, timer.getElapsedTime() * 1000000000.0 / F64(LOOKUP_COUNT));
+	};
+
+	// Linear search with string compares
+	timer.start();
+	for(U32 idx : lookups)
+	{
+		const CString name = names[idx];
+		for(U32 i = 0; i < NAME_COUNT; ++i)
+		{
+			if(names[i] == name)
+			{
+				sum += i;
+				break;
+			}
+		}
+	}
+	timer.stop();
+	log("Linear search with string compares");
+
+	// HashMap with CString keys
+	{
+		HashMap<CString, U32> map;
+		for(U32 i = 0; i < NAME_COUNT; ++i)
+		{
+			map.emplace(alloc, names[i], i);
+		}
+
+		timer.start();
+		for(U32 idx : lookups)
+		{
+			sum += *map.find(names[idx]);
+		}
+		timer.stop();
+		log("HashMap with CString keys");
+		map.destroy(alloc);
+	}
+
+	FlatHashMap<StringId, U32> map;
+	for(U32 i = 0; i < NAME_COUNT; ++i)
+	{
+		map.emplace(alloc, ids[i], i);
+	}
+
+	// Find the StringId of the string and then search
+	timer.start();
+	for(U32 idx : lookups)
+	{
+		sum += *map.find(StringId::tryFind(names[idx]));
+	}
+	timer.stop();
+	log("StringId::tryFind() and FlatHashMap with StringId keys");
+
+	// Search with an already interned string
+	timer.start();
+	for(U32 idx : lookups)
+	{
+		sum += *map.find(ids[idx]);
+	}
+	timer.stop();
+	log("FlatHashMap with StringId keys");
+
+	// Linear search with integer compares
+	timer.start();
+	for(U32 idx : lookups)
+	{
+		const StringId id = ids[idx];
+		for(U32 i = 0; i < NAME_COUNT; ++i)
+		{
+			if(ids[i] == id)
+			{
+				sum += i;
+				break;
+			}
+		}
+	}
+	timer.stop();
+	log("Linear search with StringId compares");
+
+	map.destroy(alloc);
+	ANKI_TEST_LOGI("Checksum %lu", sum);
+}
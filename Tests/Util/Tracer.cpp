@@ -54,3 +54,109 @@ ANKI_TEST(Util, Tracer)
 	tracer.flushFrame(4);
 }
 #endif
+
+ANKI_TEST(Util, TracerCounters)
+{
+	HeapAllocator<U8> alloc(allocAligned, nullptr);
+	Tracer tracer(alloc);
+	tracer.setEnabled(true);
+
+	const TracerCounterId counterA = Tracer::registerCounter("TEST_COUNTER_A");
+	const TracerCounterId counterB = Tracer::registerCounter("TEST_COUNTER_B");
+	ANKI_TEST_EXPECT_NEQ(counterA, counterB);
+	ANKI_TEST_EXPECT_EQ(Tracer::registerCounter("TEST_COUNTER_A"), counterA);
+
+	constexpr U32 THREAD_COUNT = 4;
+	constexpr U32 ITERATIONS = 1024 * 1024;
+
+	class Ctx
+	{
+	public:
+		Tracer* m_tracer;
+		TracerCounterId m_counterA;
+		TracerCounterId m_counterB;
+	} ctx = {&tracer, counterA, counterB};
+
+	auto flushAndCheck = [&](U64 expectedA, U64 expectedB) {
+		Array<U64, 2> values = {};
+		tracer.flush(
+			[](void* ud, ThreadId tid, ConstWeakArray<TracerEvent> events, ConstWeakArray<TracerCounter> counters) {
+				Array<U64, 2>& values = *static_cast<Array<U64, 2>*>(ud);
+				for(const TracerCounter& counter : counters)
+				{
+					if(counter.m_name == "TEST_COUNTER_A")
+					{
+						values[0] += counter.m_value;
+					}
+					else if(counter.m_name == "TEST_COUNTER_B")
+					{
+						values[1] += counter.m_value;
+					}
+				}
+			},
+			&values);
+
+		ANKI_TEST_EXPECT_EQ(values[0], expectedA);
+		ANKI_TEST_EXPECT_EQ(values[1], expectedB);
+	};
+
+	// Registered counters from many threads
+	{
+		HighRezTimer timer;
+		timer.start();
+
+		Array<Thread*, THREAD_COUNT> threads;
+		for(Thread*& thread : threads)
+		{
+			thread = alloc.newInstance<Thread>("Tracer");
+			thread->start(&ctx, [](ThreadCallbackInfo& info) -> Error {
+				Ctx& ctx = *static_cast<Ctx*>(info.m_userData);
+				for(U32 i = 0; i < ITERATIONS; ++i)
+				{
+					ctx.m_tracer->incrementCounter(ctx.m_counterA, 1);
+					ctx.m_tracer->incrementCounter(ctx.m_counterB, 2);
+				}
+				return Error::NONE;
+			});
+		}
+
+		for(Thread* thread : threads)
+		{
+			ANKI_TEST_EXPECT_NO_ERR(thread->join());
+			alloc.deleteInstance(thread);
+		}
+
+		timer.stop();
+		const Second registeredTime = timer.getElapsedTime();
+
+		flushAndCheck(THREAD_COUNT * ITERATIONS, 2 * THREAD_COUNT * ITERATIONS);
+
+		// Nothing changed since the last flush
+		flushAndCheck(0, 0);
+
+		// Same thing but find the counters by name
+		timer.start();
+		for(U32 i = 0; i < ITERATIONS; ++i)
+		{
+			tracer.incrementCounter("TEST_COUNTER_A", 1);
+			tracer.incrementCounter("TEST_COUNTER_B", 2);
+		}
+		timer.stop();
+		const Second byNameTime = timer.getElapsedTime();
+
+		timer.start();
+		for(U32 i = 0; i < ITERATIONS; ++i)
+		{
+			tracer.incrementCounter(counterA, 1);
+			tracer.incrementCounter(counterB, 2);
+		}
+		timer.stop();
+		const Second singleThreadRegisteredTime = timer.getElapsedTime();
+
+		flushAndCheck(2 * ITERATIONS, 4 * ITERATIONS);
+
+		ANKI_TEST_LOGI("Tracer counter bench: %u threads x %u increments %fsec. Single thread: by name %fsec, "
+					   "registered %fsec",
+					   THREAD_COUNT, 2 * ITERATIONS, registeredTime, byNameTime, singleThreadRegisteredTime);
+	}
+}
@@ -4,6 +4,7 @@
 // http://www.anki3d.org/LICENSE
 
 #include <AnKi/Importer/GltfImporter.h>
+#include <AnKi/Util/Filesystem.h>
 
 using namespace anki;
 
@@ -12,10 +13,14 @@ Options:
 -rpath <string>        : Replace all absolute paths of assets with that path
 -texrpath <string>     : Same as rpath but for textures
 -optimize-meshes <0|1> : Optimize meshes. Default is 1
+-quantize-meshes <0|1> : Store the positions in 16bit. Default is 1
+-compress-meshes <0|1> : Compress the mesh buffers. Default is 0
 -j <thread_count>      : Number of threads. Defaults to system's max
 -lod-count <1|2|3>     : The number of geometry LODs to generate. Default: 1
 -lod-factor <float>    : The decimate factor for each LOD. Default 0.25
 -light-scale <float>   : Multiply the light intensity with this number. Default 1.0
+-incremental <0|1>     : Skip the outputs whose inputs didn't change since the last import. Default is 1
+-import-textures <0|1> : Convert the textures of the materials to AnKi images. Default is 0
 )";
 
 class CmdLineArgs
@@ -27,10 +32,14 @@ public:
 	StringAuto m_rpath = {m_alloc};
 	StringAuto m_texRpath = {m_alloc};
 	Bool m_optimizeMeshes = true;
+	Bool m_quantizeMeshes = true;
+	Bool m_compressMeshes = false;
 	U32 m_threadCount = MAX_U32;
 	U32 m_lodCount = 1;
 	F32 m_lodFactor = 0.25f;
 	F32 m_lightIntensityScale = 1.0f;
+	Bool m_incrementalImport = true;
+	Bool m_importTextures = false;
 };
 
 static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
@@ -106,6 +115,36 @@ static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
 				return Error::USER_DATA;
 			}
 		}
+		else if(strcmp(argv[i], "-quantize-meshes") == 0)
+		{
+			++i;
+
+			if(i < argc)
+			{
+				I quantize = 1;
+				ANKI_CHECK(CString(argv[i]).toNumber(quantize));
+				info.m_quantizeMeshes = quantize != 0;
+			}
+			else
+			{
+				return Error::USER_DATA;
+			}
+		}
+		else if(strcmp(argv[i], "-compress-meshes") == 0)
+		{
+			++i;
+
+			if(i < argc)
+			{
+				I compress = 0;
+				ANKI_CHECK(CString(argv[i]).toNumber(compress));
+				info.m_compressMeshes = compress != 0;
+			}
+			else
+			{
+				return Error::USER_DATA;
+			}
+		}
 		else if(strcmp(argv[i], "-j") == 0)
 		{
 			++i;
@@ -160,6 +199,36 @@ static Error parseCommandLineArgs(int argc, char** argv, CmdLineArgs& info)
 				return Error::USER_DATA;
 			}
 		}
+		else if(strcmp(argv[i], "-incremental") == 0)
+		{
+			++i;
+
+			if(i < argc)
+			{
+				I incremental = 1;
+				ANKI_CHECK(CString(argv[i]).toNumber(incremental));
+				info.m_incrementalImport = incremental != 0;
+			}
+			else
+			{
+				return Error::USER_DATA;
+			}
+		}
+		else if(strcmp(argv[i], "-import-textures") == 0)
+		{
+			++i;
+
+			if(i < argc)
+			{
+				I importTextures = 0;
+				ANKI_CHECK(CString(argv[i]).toNumber(importTextures));
+				info.m_importTextures = importTextures != 0;
+			}
+			else
+			{
+				return Error::USER_DATA;
+			}
+		}
 		else
 		{
 			return Error::USER_DATA;
@@ -206,11 +275,37 @@ int main(int argc, char** argv)
 	initInfo.m_rpath = cmdArgs.m_rpath;
 	initInfo.m_texrpath = cmdArgs.m_texRpath;
 	initInfo.m_optimizeMeshes = cmdArgs.m_optimizeMeshes;
+	initInfo.m_quantizeMeshes = cmdArgs.m_quantizeMeshes;
+	initInfo.m_compressMeshes = cmdArgs.m_compressMeshes;
 	initInfo.m_lodFactor = cmdArgs.m_lodFactor;
 	initInfo.m_lodCount = cmdArgs.m_lodCount;
 	initInfo.m_lightIntensityScale = cmdArgs.m_lightIntensityScale;
 	initInfo.m_threadCount = cmdArgs.m_threadCount;
 	initInfo.m_comment = comment;
+	initInfo.m_incrementalImport = cmdArgs.m_incrementalImport;
+	initInfo.m_importTextures = cmdArgs.m_importTextures;
+
+	// Same as the image importer
+	StringAuto tmp(alloc);
+	StringAuto compressonatorPath(alloc);
+	StringAuto astcencPath(alloc);
+	if(cmdArgs.m_importTextures)
+	{
+		if(getTempDirectory(tmp))
+		{
+			ANKI_IMPORTER_LOGE("getTempDirectory() failed");
+			return 1;
+		}
+		initInfo.m_tempDirectory = tmp;
+
+		StringAuto p(alloc);
+		getParentFilepath(argv[0], p);
+		compressonatorPath.sprintf("%s/../../ThirdParty/Bin/Compressonator:%s", p.cstr(), getenv("PATH"));
+		initInfo.m_compressonatorPath = compressonatorPath;
+
+		astcencPath.sprintf("%s/../../ThirdParty/Bin:%s", p.cstr(), getenv("PATH"));
+		initInfo.m_astcencPath = astcencPath;
+	}
 
 	GltfImporter importer(alloc);
 	if(importer.init(initInfo))
@@ -15,6 +15,8 @@ public:
 	TextureViewerUiNode(SceneGraph* scene, CString name)
 		: SceneNode(scene, name)
 	{
+		setNeedsFrameUpdate(true);
+
 		SpatialComponent* spatialc = newComponent<SpatialComponent>();
 		spatialc->setAlwaysVisible(true);
 